@@ -337,6 +337,8 @@ static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packe
     UNUSED(channel);
     UNUSED(size);
     int i;
+    uint32_t bytes_received;
+    uint32_t bytes_per_second;
     switch (packet_type){
         case HCI_EVENT_PACKET:
             switch (hci_event_packet_get_type(packet)) {
@@ -360,6 +362,8 @@ static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packe
                         case PBAP_SUBEVENT_OPERATION_COMPLETED:
                             printf("[+] Operation complete\n");
                             printf("[+] Pull Phonebook complete\n");
+                            pbap_get_transfer_statistics(pbap_cid, &bytes_received, &bytes_per_second);
+                            printf("[+] %u bytes received, %u bytes/s\n", (unsigned int) bytes_received, (unsigned int) bytes_per_second);
                             pbap_disconnect(pbap_cid);
                             break;
                         default:
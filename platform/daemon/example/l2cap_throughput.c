@@ -59,6 +59,7 @@
 
 #define PSM_TEST 0xdead
 #define PACKET_SIZE 1000
+#define REPORT_INTERVAL_MS 3000
 
 int serverMode = 1;
 bd_addr_t addr = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00}; 
@@ -67,6 +68,28 @@ uint32_t counter = 0;
 
 btstack_timer_source_t timer;
 
+// data rate measurement
+uint32_t test_data_start_ms;
+uint32_t test_data_bytes;
+uint32_t test_data_packets;
+
+void test_data_reset(void){
+    test_data_start_ms = btstack_run_loop_get_time_ms();
+    test_data_bytes = 0;
+    test_data_packets = 0;
+}
+
+void test_data_received(uint16_t size){
+    test_data_bytes += size;
+    test_data_packets++;
+    uint32_t now = btstack_run_loop_get_time_ms();
+    uint32_t delta_ms = now - test_data_start_ms;
+    if (delta_ms < REPORT_INTERVAL_MS) return;
+    printf("%u packets, %u bytes in %u ms -> %u kB/s via %s\n", test_data_packets, test_data_bytes, delta_ms,
+           test_data_bytes / delta_ms, bt_uses_shared_memory() ? "shared memory" : "socket");
+    test_data_reset();
+}
+
 void update_packet(void){
     big_endian_store_32( packet, 0, counter++);
 }
@@ -97,6 +120,7 @@ void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint
 			
 		case L2CAP_DATA_PACKET:
 			// measure data rate
+			test_data_received(size);
 			break;
 			
 		case HCI_EVENT_PACKET:
@@ -178,6 +202,7 @@ void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint
 					con_handle = little_endian_read_16(packet, 9);
 					printf("Channel successfully opened: %s, handle 0x%02x, psm 0x%02x, local cid 0x%02x, remote cid 0x%02x\n",
 						   bd_addr_to_str(event_addr), con_handle, psm, local_cid,  l2cap_event_channel_opened_get_remote_cid(packet));
+					test_data_reset();
 					
 					break;
 				
@@ -206,9 +231,12 @@ void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint
 	}
 }
 int main (int argc, const char * argv[]){
-    // handle remote addr
-    if (argc > 1){
-        if (sscanf_bd_addr(argv[1], addr)){
+    // handle remote addr and option to compare socket with shared memory transport
+    int arg;
+    for (arg = 1; arg < argc; arg++){
+        if (strcmp(argv[arg], "--no-shared-memory") == 0){
+            bt_disable_shared_memory();
+        } else if (sscanf_bd_addr(argv[arg], addr)){
             serverMode = 0;
             prepare_packet();
         }
@@ -233,6 +261,7 @@ int main (int argc, const char * argv[]){
 	if (serverMode) {
 	   printf(" * Running in Server mode. For client mode, specify remote addr 11:22:33:44:55:66\n");
     }
+    printf(" * Received data rate is reported every %u ms, use --no-shared-memory to receive packets via socket\n", REPORT_INTERVAL_MS);
     printf(" * MTU: 1000 bytes\n");
 	
 	btstack_run_loop_execute();
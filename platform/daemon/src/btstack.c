@@ -70,6 +70,7 @@ static void (*client_packet_handler)(uint8_t packet_type, uint16_t channel, uint
 
 static const char * daemon_tcp_address = NULL;
 static uint16_t     daemon_tcp_port    = BTSTACK_PORT;
+static int          daemon_shared_memory = 1;
 
 // optional: if called before bt_open, TCP socket is used instead of local unix socket
 //           note: address is not copied and must be valid during bt_open
@@ -78,6 +79,16 @@ void bt_use_tcp(const char * address, uint16_t port){
     daemon_tcp_port    = port;
 }
 
+// optional: if called before bt_open, packets from daemon are received over the socket instead of shared memory
+void bt_disable_shared_memory(void){
+    daemon_shared_memory = 0;
+}
+
+int bt_uses_shared_memory(void){
+    if (!btstack_connection) return 0;
+    return socket_connection_shared_memory_active(btstack_connection);
+}
+
 static int socket_packet_handler(connection_t *connection, uint16_t packet_type, uint16_t channel, uint8_t *data, uint16_t size){
     // log_info("BTstack client handler: packet type %u, data[0] %x", packet_type, data[0]);
     (*client_packet_handler)(packet_type, channel, data, size);
@@ -111,6 +122,11 @@ int bt_open(void){
     }
     if (!btstack_connection) return -1;
 
+    // local clients receive packets via shared memory if supported, fall back to socket otherwise
+    if (!daemon_tcp_address && daemon_shared_memory){
+        socket_connection_enable_shared_memory(btstack_connection);
+    }
+
     return 0;
 }
 
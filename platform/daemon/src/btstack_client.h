@@ -77,6 +77,12 @@ extern "C" {
 //           note: address is not copied and must be valid during bt_open
 void bt_use_tcp(const char * address, uint16_t port); 
 
+// optional: if called before bt_open, packets from daemon are received over the socket instead of shared memory
+void bt_disable_shared_memory(void);
+
+// @return 1 if packets from daemon are received via shared memory
+int bt_uses_shared_memory(void);
+
 // init BTstack library
 int bt_open(void);
 
@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "shared_memory_ring.c"
+
+/*
+ *  shared_memory_ring.c
+ *
+ *  Packets are stored as records: 16-bit length + data, padded to 4 bytes.
+ *  If a record doesn't fit before the end of the data area, a wrap marker is stored
+ *  and the record starts at the beginning. The consumer can process packets in place.
+ *
+ *  The producer only signals the eventfd if the consumer has read all previous packets,
+ *  i.e. if it might be waiting for a notification.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "shared_memory_ring.h"
+
+#include "btstack_debug.h"
+#include "btstack_util.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SHARED_MEMORY_RING_MIN_SIZE      1024
+#define SHARED_MEMORY_RING_RECORD_HEADER 2
+#define SHARED_MEMORY_RING_WRAP_MARKER   0xffffu
+
+// size of the memfd must not change while it is mapped by the producer
+#define SHARED_MEMORY_RING_REQUIRED_SEALS (F_SEAL_SHRINK | F_SEAL_GROW)
+
+static uint32_t shared_memory_ring_record_len(uint32_t packet_len){
+    return (SHARED_MEMORY_RING_RECORD_HEADER + packet_len + 3u) & ~3u;
+}
+
+static bool shared_memory_ring_size_valid(uint32_t size){
+    return (size >= SHARED_MEMORY_RING_MIN_SIZE) && ((size & (size - 1u)) == 0u);
+}
+
+static int shared_memory_ring_map(shared_memory_ring_t * ring, uint32_t size){
+    void * memory = mmap(NULL, sizeof(shared_memory_ring_header_t) + size, PROT_READ | PROT_WRITE, MAP_SHARED, ring->memfd, 0);
+    if (memory == MAP_FAILED) {
+        log_error("shared_memory_ring: mmap failed, %s", strerror(errno));
+        return -1;
+    }
+    ring->header = (shared_memory_ring_header_t *) memory;
+    ring->data   = ((uint8_t *) memory) + sizeof(shared_memory_ring_header_t);
+    ring->size   = size;
+    return 0;
+}
+
+int shared_memory_ring_create(shared_memory_ring_t * ring, uint32_t size){
+    memset(ring, 0, sizeof(shared_memory_ring_t));
+    ring->memfd = -1;
+    ring->eventfd = -1;
+    if (!shared_memory_ring_size_valid(size)) return -1;
+
+    ring->memfd = memfd_create("btstack_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (ring->memfd < 0){
+        log_error("shared_memory_ring: memfd_create failed, %s", strerror(errno));
+        return -1;
+    }
+    if (ftruncate(ring->memfd, sizeof(shared_memory_ring_header_t) + size) < 0){
+        log_error("shared_memory_ring: ftruncate failed, %s", strerror(errno));
+        shared_memory_ring_close(ring);
+        return -1;
+    }
+    if (fcntl(ring->memfd, F_ADD_SEALS, SHARED_MEMORY_RING_REQUIRED_SEALS | F_SEAL_SEAL) < 0){
+        log_error("shared_memory_ring: adding seals failed, %s", strerror(errno));
+        shared_memory_ring_close(ring);
+        return -1;
+    }
+    ring->eventfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ring->eventfd < 0){
+        log_error("shared_memory_ring: eventfd failed, %s", strerror(errno));
+        shared_memory_ring_close(ring);
+        return -1;
+    }
+    if (shared_memory_ring_map(ring, size) < 0){
+        shared_memory_ring_close(ring);
+        return -1;
+    }
+    ring->header->write_pos = 0;
+    ring->header->read_pos  = 0;
+    ring->header->size      = size;
+    return 0;
+}
+
+int shared_memory_ring_attach(shared_memory_ring_t * ring, int memfd, int eventfd){
+    memset(ring, 0, sizeof(shared_memory_ring_t));
+    ring->memfd = memfd;
+    ring->eventfd = eventfd;
+
+    // a consumer that could shrink the memfd after mmap would crash the producer with SIGBUS
+    int seals = fcntl(memfd, F_GET_SEALS);
+    if ((seals < 0) || ((seals & SHARED_MEMORY_RING_REQUIRED_SEALS) != SHARED_MEMORY_RING_REQUIRED_SEALS)){
+        log_error("shared_memory_ring: memfd not sealed against resize");
+        shared_memory_ring_close(ring);
+        return -1;
+    }
+
+    // size is derived from the memfd, header content is not trusted
+    struct stat memfd_stat;
+    if ((fstat(memfd, &memfd_stat) < 0) || (memfd_stat.st_size <= (off_t) sizeof(shared_memory_ring_header_t))){
+        shared_memory_ring_close(ring);
+        return -1;
+    }
+    uint32_t size = (uint32_t) (memfd_stat.st_size - sizeof(shared_memory_ring_header_t));
+    if (!shared_memory_ring_size_valid(size)){
+        log_error("shared_memory_ring: invalid size %u", (unsigned int) size);
+        shared_memory_ring_close(ring);
+        return -1;
+    }
+    if (shared_memory_ring_map(ring, size) < 0){
+        shared_memory_ring_close(ring);
+        return -1;
+    }
+    return 0;
+}
+
+void shared_memory_ring_close(shared_memory_ring_t * ring){
+    if (ring->header != NULL){
+        munmap(ring->header, sizeof(shared_memory_ring_header_t) + ring->size);
+        ring->header = NULL;
+        ring->data   = NULL;
+    }
+    if (ring->memfd >= 0){
+        close(ring->memfd);
+        ring->memfd = -1;
+    }
+    if (ring->eventfd >= 0){
+        close(ring->eventfd);
+        ring->eventfd = -1;
+    }
+}
+
+uint32_t shared_memory_ring_bytes_used(const shared_memory_ring_t * ring){
+    uint32_t write_pos = __atomic_load_n(&ring->header->write_pos, __ATOMIC_ACQUIRE);
+    uint32_t read_pos  = __atomic_load_n(&ring->header->read_pos,  __ATOMIC_ACQUIRE);
+    return btstack_min(write_pos - read_pos, ring->size);
+}
+
+bool shared_memory_ring_write_packet(shared_memory_ring_t * ring, const uint8_t * header, uint16_t header_len, const uint8_t * payload, uint16_t payload_len){
+    uint32_t packet_len = (uint32_t) header_len + payload_len;
+    uint32_t record_len = shared_memory_ring_record_len(packet_len);
+    if ((packet_len >= SHARED_MEMORY_RING_WRAP_MARKER) || (record_len > ring->size)) return false;
+
+    uint32_t write_pos_start = ring->header->write_pos;
+    uint32_t read_pos  = __atomic_load_n(&ring->header->read_pos, __ATOMIC_ACQUIRE);
+    uint32_t bytes_used = write_pos_start - read_pos;
+    if (bytes_used > ring->size) return false;
+
+    uint32_t offset = write_pos_start & (ring->size - 1u);
+    uint32_t bytes_till_end = ring->size - offset;
+    uint32_t bytes_needed = record_len;
+    if (bytes_till_end < record_len){
+        bytes_needed += bytes_till_end;
+    }
+    if ((ring->size - bytes_used) < bytes_needed) return false;
+
+    uint32_t write_pos = write_pos_start;
+    if (bytes_till_end < record_len){
+        little_endian_store_16(&ring->data[offset], 0, SHARED_MEMORY_RING_WRAP_MARKER);
+        write_pos += bytes_till_end;
+        offset = 0;
+    }
+    little_endian_store_16(&ring->data[offset], 0, (uint16_t) packet_len);
+    offset += SHARED_MEMORY_RING_RECORD_HEADER;
+    memcpy(&ring->data[offset], header, header_len);
+    if (payload_len > 0){
+        memcpy(&ring->data[offset + header_len], payload, payload_len);
+    }
+    __atomic_store_n(&ring->header->write_pos, write_pos + record_len, __ATOMIC_RELEASE);
+
+    // signal consumer if it has processed all previous packets and might be waiting
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ring->header->read_pos, __ATOMIC_ACQUIRE) == write_pos_start){
+        uint64_t value = 1;
+        ssize_t res = write(ring->eventfd, &value, sizeof(value));
+        UNUSED(res);
+    }
+    return true;
+}
+
+void shared_memory_ring_clear_notification(shared_memory_ring_t * ring){
+    uint64_t value;
+    ssize_t res = read(ring->eventfd, &value, sizeof(value));
+    UNUSED(res);
+}
+
+const uint8_t * shared_memory_ring_peek_packet(shared_memory_ring_t * ring, uint16_t * len){
+    // pairs with fence in shared_memory_ring_write_packet
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint32_t write_pos = __atomic_load_n(&ring->header->write_pos, __ATOMIC_ACQUIRE);
+    uint32_t read_pos  = ring->header->read_pos;
+    while (read_pos != write_pos){
+        uint32_t offset = read_pos & (ring->size - 1u);
+        uint16_t packet_len = little_endian_read_16(&ring->data[offset], 0);
+        if (packet_len != SHARED_MEMORY_RING_WRAP_MARKER){
+            *len = packet_len;
+            return &ring->data[offset + SHARED_MEMORY_RING_RECORD_HEADER];
+        }
+        read_pos += ring->size - offset;
+        __atomic_store_n(&ring->header->read_pos, read_pos, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+void shared_memory_ring_consume_packet(shared_memory_ring_t * ring){
+    uint32_t read_pos = ring->header->read_pos;
+    uint16_t packet_len = little_endian_read_16(&ring->data[read_pos & (ring->size - 1u)], 0);
+    __atomic_store_n(&ring->header->read_pos, read_pos + shared_memory_ring_record_len(packet_len), __ATOMIC_RELEASE);
+}
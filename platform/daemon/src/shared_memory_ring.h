@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+/*
+ *  shared_memory_ring.h
+ *
+ *  Single producer / single consumer packet ring in shared memory (memfd) with eventfd notification
+ */
+
+#ifndef SHARED_MEMORY_RING_H
+#define SHARED_MEMORY_RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/** ring header at start of shared memory, positions are free running */
+typedef struct {
+    uint32_t write_pos;     // updated by producer
+    uint32_t read_pos;      // updated by consumer
+    uint32_t size;          // size of data area, power of two
+    uint32_t reserved;
+} shared_memory_ring_header_t;
+
+typedef struct {
+    shared_memory_ring_header_t * header;
+    uint8_t * data;
+    uint32_t  size;
+    int       memfd;
+    int       eventfd;
+} shared_memory_ring_t;
+
+/**
+ * @brief Create ring for consumer. Allocates memfd sealed against resize and eventfd that can be passed to producer
+ * @param ring
+ * @param size of data area, must be power of two
+ * @return 0 on success
+ */
+int shared_memory_ring_create(shared_memory_ring_t * ring, uint32_t size);
+
+/**
+ * @brief Attach to ring created by consumer
+ * @note memfd must be sealed with F_SEAL_SHRINK and F_SEAL_GROW, otherwise it is rejected
+ * @param ring
+ * @param memfd
+ * @param eventfd
+ * @return 0 on success
+ */
+int shared_memory_ring_attach(shared_memory_ring_t * ring, int memfd, int eventfd);
+
+/**
+ * @brief Unmap shared memory and close file descriptors
+ * @param ring
+ */
+void shared_memory_ring_close(shared_memory_ring_t * ring);
+
+/**
+ * @brief Get number of bytes used by packets in ring
+ * @param ring
+ * @return bytes used
+ */
+uint32_t shared_memory_ring_bytes_used(const shared_memory_ring_t * ring);
+
+/**
+ * @brief Store packet consisting of header and payload, signal consumer if it might be waiting
+ * @param ring
+ * @param header
+ * @param header_len
+ * @param payload
+ * @param payload_len
+ * @return false if ring is full
+ */
+bool shared_memory_ring_write_packet(shared_memory_ring_t * ring, const uint8_t * header, uint16_t header_len, const uint8_t * payload, uint16_t payload_len);
+
+/**
+ * @brief Clear eventfd notification before draining the ring
+ * @param ring
+ */
+void shared_memory_ring_clear_notification(shared_memory_ring_t * ring);
+
+/**
+ * @brief Get next packet without copying it
+ * @param ring
+ * @param len of packet
+ * @return packet in shared memory or NULL if ring is empty
+ */
+const uint8_t * shared_memory_ring_peek_packet(shared_memory_ring_t * ring, uint16_t * len);
+
+/**
+ * @brief Release packet returned by shared_memory_ring_peek_packet
+ * @param ring
+ */
+void shared_memory_ring_consume_packet(shared_memory_ring_t * ring);
+
+#if defined __cplusplus
+}
+#endif
+
+#endif // SHARED_MEMORY_RING_H
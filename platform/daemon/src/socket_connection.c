@@ -70,6 +70,7 @@
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #endif
  
@@ -98,8 +99,40 @@ struct sockaddr_un {
 #include "../port/ios/3rdparty/launch.h"
 #endif
 
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+#include "shared_memory_ring.h"
+#include <poll.h>
+#include <stddef.h>
+#endif
+
 #define MAX_PENDING_CONNECTIONS 10
 
+// outgoing buffer per connection, allows to queue a few max size packets
+#ifndef SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE
+#define SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE (8 * (6 + HCI_ACL_BUFFER_SIZE))
+#endif
+
+#if SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE < (6 + HCI_ACL_BUFFER_SIZE)
+#error "SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE must be able to hold at least a single packet"
+#endif
+
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+// size of ring for packets from daemon to client, power of two
+#ifndef SOCKET_CONNECTION_SHARED_MEMORY_SIZE
+#define SOCKET_CONNECTION_SHARED_MEMORY_SIZE (256 * 1024)
+#endif
+// internal packet: request from client with memfd + eventfd, response from daemon with status
+#define SOCKET_CONNECTION_SHARED_MEMORY_PACKET 0xfdu
+// check if parked client has caught up
+#define SOCKET_CONNECTION_SHARED_MEMORY_POLL_MS 10
+#endif
+
+#ifdef _WIN32
+typedef WSABUF socket_connection_buffer_t;
+#else
+typedef struct iovec socket_connection_buffer_t;
+#endif
+
 /** prototypes */
 static void socket_connection_hci_process(btstack_data_source_t *ds, btstack_data_source_callback_type_t callback_type);
 static int socket_connection_dummy_handler(connection_t *connection, uint16_t packet_type, uint16_t channel, uint8_t *data, uint16_t length);
@@ -127,17 +160,40 @@ typedef struct linked_connection {
 struct connection {
     btstack_data_source_t ds;                // used for run loop
     linked_connection_t linked_connection;   // used for connection list
+    linked_connection_t parked_connection;   // used for parked list
     int socket_fd;                           // ds only stores event handle in win32
     SOCKET_STATE state;
     uint16_t bytes_read;
     uint16_t bytes_to_read;
     uint8_t  buffer[6+HCI_ACL_BUFFER_SIZE]; // packet_header(6) + max packet: 3-DH5 = header(6) + payload (1021)
+
+    // reading paused as packet could not be dispatched or client doesn't read its packets
+    bool dispatch_parked;
+    bool output_parked;
+
+    // outgoing ring buffer, flushed on write ready
+    uint32_t outgoing_read_pos;
+    socket_connection_stats_t stats;
+    uint8_t  outgoing_buffer[SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE];
+
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+    // packets from daemon to client are sent via shared memory ring after setup
+    shared_memory_ring_t shm_ring;
+    bool shm_send;                          // daemon
+    bool shm_receive;                       // client
+    btstack_data_source_t shm_ds;           // client: eventfd of ring
+    btstack_timer_source_t shm_timer;       // daemon: poll ring while client is parked
+    int received_fds[2];
+    int num_received_fds;
+#endif
 };
 
 /** list of socket connections */
 static btstack_linked_list_t connections = NULL;
 static btstack_linked_list_t parked = NULL;
 
+static socket_connection_slow_consumer_policy_t slow_consumer_policy = SOCKET_CONNECTION_SLOW_CONSUMER_PARK;
+
 #ifdef _WIN32
 // workaround as btstack_data_source_t only stores windows event (instead of fd)
 static int tcp_socket_fd;
@@ -157,11 +213,28 @@ static int socket_connection_dummy_handler(connection_t *connection, uint16_t pa
 }
 
 static void socket_connection_free_connection(connection_t *conn){
+    log_info("socket_connection_free_connection %p: packets sent %u, dropped %u, max queued %u bytes, parked %u times", conn,
+             (unsigned int) conn->stats.num_packets_sent, (unsigned int) conn->stats.num_packets_dropped,
+             (unsigned int) conn->stats.max_bytes_queued, (unsigned int) conn->stats.num_parked);
+
     // remove from run_loop 
     btstack_run_loop_remove_data_source(&conn->ds);
     
     // and from connection list
     btstack_linked_list_remove(&connections, &conn->linked_connection.item);
+    btstack_linked_list_remove(&parked, &conn->parked_connection.item);
+
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+    if (conn->shm_receive){
+        btstack_run_loop_remove_data_source(&conn->shm_ds);
+    }
+    btstack_run_loop_remove_timer(&conn->shm_timer);
+    shared_memory_ring_close(&conn->shm_ring);
+    while (conn->num_received_fds > 0){
+        conn->num_received_fds--;
+        close(conn->received_fds[conn->num_received_fds]);
+    }
+#endif
     
 #ifdef _WIN32
     if (conn->ds.source.handle){
@@ -187,10 +260,24 @@ static connection_t * socket_connection_register_new_connection(int fd){
     memset(conn, 0, sizeof(connection_t));
     // store reference from linked item to base object
     conn->linked_connection.connection = conn;
+    conn->parked_connection.connection = conn;
 
     // keep fd around
     conn->socket_fd = fd;
 
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+    conn->shm_ring.memfd = -1;
+    conn->shm_ring.eventfd = -1;
+#endif
+
+#ifndef _WIN32
+    // don't block run loop on slow clients. on win32, WSAEventSelect sets socket to non-blocking mode
+    int flags = fcntl(fd, F_GETFL, 0);
+    if ((flags < 0) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)){
+        log_error("Error setting socket %d to non-blocking mode", fd);
+    }
+#endif
+
 #ifdef _WIN32
     // wrap fd in windows event and configure for accept and close
     WSAEVENT event = WSACreateEvent();
@@ -238,35 +325,274 @@ void static socket_connection_emit_connection_closed(connection_t *connection){
     (*socket_connection_packet_callback)(connection, DAEMON_EVENT_PACKET, 0, (uint8_t *) &event, 1);
 }
 
-void socket_connection_hci_process(btstack_data_source_t *socket_ds, btstack_data_source_callback_type_t callback_type) {
+static bool socket_connection_would_block(void){
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return (errno == EAGAIN) || (errno == EWOULDBLOCK);
+#endif
+}
+
+static void socket_connection_buffer_set(socket_connection_buffer_t * buffer, const uint8_t * data, uint32_t len){
+#ifdef _WIN32
+    buffer->buf = (char *) data;
+    buffer->len = len;
+#else
+    buffer->iov_base = (void *) data;
+    buffer->iov_len  = len;
+#endif
+}
+
+// @return number of bytes written, 0 if socket would block, -1 on error
+static int socket_connection_write_buffers(connection_t * conn, socket_connection_buffer_t * buffers, int num_buffers){
+    conn->stats.num_writes++;
+#ifdef _WIN32
+    DWORD bytes_sent = 0;
+    int res = WSASend(conn->socket_fd, buffers, num_buffers, &bytes_sent, 0, NULL, NULL);
+    if (res == 0) return (int) bytes_sent;
+#else
+    ssize_t res = writev(conn->socket_fd, buffers, num_buffers);
+    if (res >= 0) return (int) res;
+#endif
+    if (socket_connection_would_block()) return 0;
+    return -1;
+}
+
+static void socket_connection_update_read_callback(connection_t * conn){
+    if (conn->dispatch_parked || conn->output_parked){
+        btstack_run_loop_disable_data_source_callbacks(&conn->ds, DATA_SOURCE_CALLBACK_READ);
+    } else {
+        btstack_run_loop_enable_data_source_callbacks(&conn->ds, DATA_SOURCE_CALLBACK_READ);
+    }
+}
+
+static void socket_connection_queue_store(connection_t * conn, const uint8_t * data, uint32_t len){
+    if (len == 0) return;
+    uint32_t write_pos = (conn->outgoing_read_pos + conn->stats.bytes_queued) % SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE;
+    uint32_t bytes_first = btstack_min(len, SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE - write_pos);
+    memcpy(&conn->outgoing_buffer[write_pos], data, bytes_first);
+    memcpy(&conn->outgoing_buffer[0], &data[bytes_first], len - bytes_first);
+    conn->stats.bytes_queued += len;
+    conn->stats.max_bytes_queued = btstack_max(conn->stats.max_bytes_queued, conn->stats.bytes_queued);
+}
+
+// write as much of the outgoing buffer as possible with a single system call
+static void socket_connection_flush(connection_t * conn){
+    if (conn->stats.bytes_queued > 0){
+        socket_connection_buffer_t buffers[2];
+        int num_buffers = 1;
+        uint32_t bytes_first = btstack_min(conn->stats.bytes_queued, SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE - conn->outgoing_read_pos);
+        socket_connection_buffer_set(&buffers[0], &conn->outgoing_buffer[conn->outgoing_read_pos], bytes_first);
+        if (bytes_first < conn->stats.bytes_queued){
+            socket_connection_buffer_set(&buffers[1], &conn->outgoing_buffer[0], conn->stats.bytes_queued - bytes_first);
+            num_buffers = 2;
+        }
+        int res = socket_connection_write_buffers(conn, buffers, num_buffers);
+        if (res < 0){
+            // connection broken, read handler will close it
+            log_info("socket_connection_flush: write failed, drop %u queued bytes", (unsigned int) conn->stats.bytes_queued);
+            conn->stats.bytes_queued = 0;
+        } else {
+            conn->outgoing_read_pos = (conn->outgoing_read_pos + (uint32_t) res) % SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE;
+            conn->stats.bytes_queued -= (uint32_t) res;
+        }
+    }
+
+    if (conn->stats.bytes_queued == 0){
+        conn->outgoing_read_pos = 0;
+        btstack_run_loop_disable_data_source_callbacks(&conn->ds, DATA_SOURCE_CALLBACK_WRITE);
+    }
+
+    // resume reading from client when most of its packets have been delivered
+    if (conn->output_parked && (conn->stats.bytes_queued <= (SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE / 4))){
+        log_info("socket_connection_flush: outgoing buffer drained -> un-park connection %p", conn);
+        conn->output_parked = false;
+        socket_connection_update_read_callback(conn);
+    }
+}
+
+static int socket_connection_read(connection_t * conn, uint8_t * buffer, uint16_t len){
+#if defined(_WIN32)
+    int flags = 0;
+    return recv(conn->socket_fd, (char*) buffer, len, flags);
+#elif defined(HAVE_SHARED_MEMORY_TRANSPORT)
+    // collect file descriptors sent along with shared memory setup request
+    struct iovec iov;
+    socket_connection_buffer_set(&iov, buffer, len);
+    union {
+        struct cmsghdr align;
+        uint8_t buffer[CMSG_SPACE(2 * sizeof(int))];
+    } control;
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+    int bytes_read = (int) recvmsg(conn->socket_fd, &msg, MSG_CMSG_CLOEXEC);
+    if (bytes_read <= 0) return bytes_read;
+    struct cmsghdr * cmsg;
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)){
+        if ((cmsg->cmsg_level != SOL_SOCKET) || (cmsg->cmsg_type != SCM_RIGHTS)) continue;
+        int num_fds = (int) ((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+        int i;
+        for (i = 0; i < num_fds; i++){
+            int fd;
+            memcpy(&fd, CMSG_DATA(cmsg) + (i * sizeof(int)), sizeof(int));
+            if (conn->num_received_fds < 2){
+                conn->received_fds[conn->num_received_fds++] = fd;
+            } else {
+                close(fd);
+            }
+        }
+    }
+    return bytes_read;
+#else
+    return read(conn->socket_fd, buffer, len);
+#endif
+}
+
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+
+// client: dispatch all packets from shared memory ring
+static void socket_connection_shm_process(btstack_data_source_t * ds, btstack_data_source_callback_type_t callback_type){
     UNUSED(callback_type);
+    connection_t * conn = (connection_t *) (((uint8_t *) ds) - offsetof(connection_t, shm_ds));
+    shared_memory_ring_clear_notification(&conn->shm_ring);
+    while (true){
+        uint16_t len;
+        const uint8_t * packet = shared_memory_ring_peek_packet(&conn->shm_ring, &len);
+        if (packet == NULL) break;
+        uint16_t size = little_endian_read_16(packet, 4);
+        if ((len >= sizeof(packet_header_t)) && ((sizeof(packet_header_t) + size) <= len)){
+            (*socket_connection_packet_callback)(conn, little_endian_read_16(packet, 0), little_endian_read_16(packet, 2),
+                                                 (uint8_t *) &packet[sizeof(packet_header_t)], size);
+        }
+        shared_memory_ring_consume_packet(&conn->shm_ring);
+    }
+}
+
+// daemon: reading from socket is disabled while parked, check for hangup or error directly
+static bool socket_connection_shm_client_closed(connection_t * conn){
+    struct pollfd poll_fd;
+    poll_fd.fd = conn->socket_fd;
+    poll_fd.events = 0;
+    poll_fd.revents = 0;
+    if (poll(&poll_fd, 1, 0) < 0) return false;
+    return (poll_fd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+}
+
+// daemon: unpark client when it has read most of its packets, close connection if client died while parked
+static void socket_connection_shm_timer_handler(btstack_timer_source_t * ts){
+    connection_t * conn = (connection_t *) btstack_run_loop_get_timer_context(ts);
+    if (socket_connection_shm_client_closed(conn)){
+        log_info("socket_connection_shm_timer_handler: parked connection %p closed", conn);
+        socket_connection_emit_connection_closed(conn);
+        socket_connection_free_connection(conn);
+        return;
+    }
+    conn->stats.bytes_queued = shared_memory_ring_bytes_used(&conn->shm_ring);
+    if (conn->stats.bytes_queued <= (conn->shm_ring.size / 4)){
+        log_info("socket_connection_shm_timer_handler: shared memory drained -> un-park connection %p", conn);
+        conn->output_parked = false;
+        socket_connection_update_read_callback(conn);
+        return;
+    }
+    btstack_run_loop_set_timer(ts, SOCKET_CONNECTION_SHARED_MEMORY_POLL_MS);
+    btstack_run_loop_add_timer(ts);
+}
+
+static void socket_connection_shm_send_packet(connection_t *conn, const uint8_t * header, const uint8_t * packet, uint16_t size){
+    if (!shared_memory_ring_write_packet(&conn->shm_ring, header, sizeof(packet_header_t), packet, size)){
+        conn->stats.num_packets_dropped++;
+        log_error("socket_connection_shm_send_packet: shared memory full, drop packet type %u, len %u", little_endian_read_16(header, 0), size);
+        return;
+    }
+    conn->stats.num_packets_sent++;
+    conn->stats.bytes_queued = shared_memory_ring_bytes_used(&conn->shm_ring);
+    conn->stats.max_bytes_queued = btstack_max(conn->stats.max_bytes_queued, conn->stats.bytes_queued);
+
+    // stop reading requests from slow client
+    if ((slow_consumer_policy == SOCKET_CONNECTION_SLOW_CONSUMER_PARK) && (conn->output_parked == false) &&
+        (conn->stats.bytes_queued > (conn->shm_ring.size / 2))){
+        log_info("socket_connection_shm_send_packet: shared memory more than half full -> park connection %p", conn);
+        conn->output_parked = true;
+        conn->stats.num_parked++;
+        socket_connection_update_read_callback(conn);
+        btstack_run_loop_set_timer_handler(&conn->shm_timer, &socket_connection_shm_timer_handler);
+        btstack_run_loop_set_timer_context(&conn->shm_timer, conn);
+        btstack_run_loop_set_timer(&conn->shm_timer, SOCKET_CONNECTION_SHARED_MEMORY_POLL_MS);
+        btstack_run_loop_add_timer(&conn->shm_timer);
+    }
+}
+
+static void socket_connection_shm_handle_packet(connection_t *conn, const uint8_t * data, uint16_t size){
+    if (size == 0){
+        // daemon: setup request with memfd and eventfd
+        uint8_t status = 1;
+        if ((conn->num_received_fds == 2) && (conn->shm_ring.header == NULL)){
+            conn->num_received_fds = 0;
+            if (shared_memory_ring_attach(&conn->shm_ring, conn->received_fds[0], conn->received_fds[1]) == 0){
+                status = 0;
+            }
+        }
+        while (conn->num_received_fds > 0){
+            conn->num_received_fds--;
+            close(conn->received_fds[conn->num_received_fds]);
+        }
+        // response is last packet sent over socket
+        socket_connection_send_packet(conn, SOCKET_CONNECTION_SHARED_MEMORY_PACKET, 0, &status, 1);
+        conn->shm_send = status == 0;
+        log_info("socket_connection_shm_handle_packet: setup for connection %p, status %u", conn, status);
+    } else {
+        // client: response, all further packets from daemon are received via shared memory
+        if ((data[0] == 0) && (conn->shm_ring.header != NULL)){
+            btstack_run_loop_set_data_source_fd(&conn->shm_ds, conn->shm_ring.eventfd);
+            btstack_run_loop_set_data_source_handler(&conn->shm_ds, &socket_connection_shm_process);
+            btstack_run_loop_enable_data_source_callbacks(&conn->shm_ds, DATA_SOURCE_CALLBACK_READ);
+            btstack_run_loop_add_data_source(&conn->shm_ds);
+            conn->shm_receive = true;
+        } else {
+            shared_memory_ring_close(&conn->shm_ring);
+        }
+        log_info("socket_connection_shm_handle_packet: daemon response for connection %p, status %u", conn, data[0]);
+    }
+}
+#endif
+
+void socket_connection_hci_process(btstack_data_source_t *socket_ds, btstack_data_source_callback_type_t callback_type) {
     connection_t *conn = (connection_t *) socket_ds;
 
     log_debug("socket_connection_hci_process, callback %x", callback_type);
 
-    // get socket_fd
-    int socket_fd = conn->socket_fd;
-
 #ifdef _WIN32
     // sync state
     WSANETWORKEVENTS network_events;
-    if (WSAEnumNetworkEvents(socket_fd, socket_ds->source.handle, &network_events) == SOCKET_ERROR){
+    if (WSAEnumNetworkEvents(conn->socket_fd, socket_ds->source.handle, &network_events) == SOCKET_ERROR){
         log_error("WSAEnumNetworkEvents() failed with error %d\n", WSAGetLastError());
         return;
     }
+    // send queued packets
+    if ((network_events.lNetworkEvents & FD_WRITE) != 0){
+        socket_connection_flush(conn);
+    }
     // check if read possible
     if ((network_events.lNetworkEvents & FD_READ) == 0) return;
+#else
+    if (callback_type == DATA_SOURCE_CALLBACK_WRITE){
+        socket_connection_flush(conn);
+        return;
+    }
 #endif
 
+    // don't accept new requests while parked
+    if (conn->dispatch_parked || conn->output_parked) return;
+
     // read from socket
-#ifdef _WIN32
-    int flags = 0;
-    int bytes_read = recv(socket_fd, (char*) &conn->buffer[conn->bytes_read], conn->bytes_to_read, flags);
-#else
-    int bytes_read = read(socket_fd, &conn->buffer[conn->bytes_read], conn->bytes_to_read);
-#endif
+    int bytes_read = socket_connection_read(conn, &conn->buffer[conn->bytes_read], conn->bytes_to_read);
 
-    log_debug("socket_connection_hci_process fd %x, bytes read %d", socket_fd, bytes_read);
+    log_debug("socket_connection_hci_process fd %x, bytes read %d", conn->socket_fd, bytes_read);
+    if ((bytes_read < 0) && socket_connection_would_block()) return;
     if (bytes_read <= 0){
         // connection broken (no particular channel, no date yet)
         socket_connection_emit_connection_closed(conn);
@@ -296,6 +622,14 @@ void socket_connection_hci_process(btstack_data_source_t *socket_ds, btstack_dat
             break;
     }
     
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+    if (dispatch && (little_endian_read_16(conn->buffer, 0) == SOCKET_CONNECTION_SHARED_MEMORY_PACKET)){
+        socket_connection_shm_handle_packet(conn, &conn->buffer[sizeof(packet_header_t)], little_endian_read_16(conn->buffer, 4));
+        socket_connection_init_statemachine(conn);
+        return;
+    }
+#endif
+
     if (dispatch){
         // dispatch packet !!! connection, type, channel, data, size
         int dispatch_err = (*socket_connection_packet_callback)(conn, little_endian_read_16( conn->buffer, 0), little_endian_read_16( conn->buffer, 2),
@@ -304,11 +638,12 @@ void socket_connection_hci_process(btstack_data_source_t *socket_ds, btstack_dat
         // reset state machine
         socket_connection_init_statemachine(conn);
         
-        // "park" if dispatch failed
+        // "park" if dispatch failed, keep flushing outgoing packets
         if (dispatch_err) {
             log_info("socket_connection_hci_process dispatch failed -> park connection");
-            btstack_run_loop_remove_data_source(socket_ds);
-            btstack_linked_list_add_tail(&parked, (btstack_linked_item_t *) socket_ds);
+            conn->dispatch_parked = true;
+            socket_connection_update_read_callback(conn);
+            btstack_linked_list_add_tail(&parked, &conn->parked_connection.item);
         }
     }
 }
@@ -322,7 +657,7 @@ void socket_connection_retry_parked(void){
     // log_info("socket_connection_hci_process retry parked");
     btstack_linked_item_t *it = (btstack_linked_item_t *) &parked;
     while (it->next) {
-        connection_t * conn = (connection_t *) it->next;
+        connection_t * conn = ((linked_connection_t *) it->next)->connection;
         
         // dispatch packet !!! connection, type, channel, data, size
         uint16_t packet_type = little_endian_read_16( conn->buffer, 0);
@@ -334,7 +669,8 @@ void socket_connection_retry_parked(void){
         if (!dispatch_err) {
             log_info("socket_connection_hci_process dispatch succeeded -> un-park connection %p", conn);
             it->next = it->next->next;
-            btstack_run_loop_add_data_source( (btstack_data_source_t *) conn);
+            conn->dispatch_parked = false;
+            socket_connection_update_read_callback(conn);
         } else {
             it = it->next;
         }
@@ -555,25 +891,144 @@ void socket_connection_register_packet_callback( int (*packet_callback)(connecti
     socket_connection_packet_callback = packet_callback;
 }
 
+/**
+ * set policy for clients that don't read packets fast enough
+ */
+void socket_connection_set_slow_consumer_policy(socket_connection_slow_consumer_policy_t policy){
+    slow_consumer_policy = policy;
+}
+
+/**
+ * get statistics for outgoing packets of connection
+ */
+void socket_connection_get_stats(connection_t *connection, socket_connection_stats_t * stats){
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+    if (connection->shm_send){
+        connection->stats.bytes_queued = shared_memory_ring_bytes_used(&connection->shm_ring);
+    }
+#endif
+    *stats = connection->stats;
+}
+
+/**
+ * client: request to receive packets from daemon via shared memory
+ */
+int socket_connection_enable_shared_memory(connection_t *connection){
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+    // setup request has to be sent directly
+    if ((connection->stats.bytes_queued > 0) || (connection->shm_ring.header != NULL)) return -1;
+    if (shared_memory_ring_create(&connection->shm_ring, SOCKET_CONNECTION_SHARED_MEMORY_SIZE) < 0) return -1;
+
+    uint8_t header[sizeof(packet_header_t)];
+    little_endian_store_16(header, 0, SOCKET_CONNECTION_SHARED_MEMORY_PACKET);
+    little_endian_store_16(header, 2, 0);
+    little_endian_store_16(header, 4, 0);
+    struct iovec iov;
+    socket_connection_buffer_set(&iov, header, sizeof(header));
+
+    // pass memfd and eventfd
+    union {
+        struct cmsghdr align;
+        uint8_t buffer[CMSG_SPACE(2 * sizeof(int))];
+    } control;
+    memset(&control, 0, sizeof(control));
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+    struct cmsghdr * cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type  = SCM_RIGHTS;
+    cmsg->cmsg_len   = CMSG_LEN(2 * sizeof(int));
+    int fds[2] = { connection->shm_ring.memfd, connection->shm_ring.eventfd };
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    if (sendmsg(connection->socket_fd, &msg, 0) != (ssize_t) sizeof(header)){
+        log_error("socket_connection_enable_shared_memory: sendmsg failed, %s", strerror(errno));
+        shared_memory_ring_close(&connection->shm_ring);
+        return -1;
+    }
+    return 0;
+#else
+    UNUSED(connection);
+    return -1;
+#endif
+}
+
+/**
+ * query if packets are exchanged via shared memory
+ */
+int socket_connection_shared_memory_active(connection_t *connection){
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+    return (connection->shm_send || connection->shm_receive) ? 1 : 0;
+#else
+    UNUSED(connection);
+    return 0;
+#endif
+}
+
 /**
  * send HCI packet to single connection
+ * - packet is written directly if no other packets are queued, otherwise appended to outgoing buffer
  */
 void socket_connection_send_packet(connection_t *conn, uint16_t type, uint16_t channel, uint8_t *packet, uint16_t size){
     uint8_t header[sizeof(packet_header_t)];
     little_endian_store_16(header, 0, type);
     little_endian_store_16(header, 2, channel);
     little_endian_store_16(header, 4, size);
-    // avoid -Wunused-result
-    int res;
-#ifdef _WIN32
-    int flags = 0;
-    res = send(conn->socket_fd, (const char *) header, 6, flags);
-    res = send(conn->socket_fd, (const char *) packet, size, flags);
-#else
-    res = write(conn->socket_fd, header, 6);
-    res = write(conn->socket_fd, packet, size);
+
+#ifdef HAVE_SHARED_MEMORY_TRANSPORT
+    if (conn->shm_send){
+        socket_connection_shm_send_packet(conn, header, packet, size);
+        return;
+    }
 #endif
-    UNUSED(res);
+
+    uint32_t packet_len = sizeof(header) + size;
+    uint32_t bytes_free = SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE - conn->stats.bytes_queued;
+    if (packet_len > bytes_free){
+        conn->stats.num_packets_dropped++;
+        log_error("socket_connection_send_packet: outgoing buffer full, drop packet type %u, channel %04x, len %u", type, channel, size);
+        return;
+    }
+
+    uint32_t bytes_written = 0;
+    if (conn->stats.bytes_queued == 0){
+        // send header and payload with single system call
+        socket_connection_buffer_t buffers[2];
+        socket_connection_buffer_set(&buffers[0], header, sizeof(header));
+        socket_connection_buffer_set(&buffers[1], packet, size);
+        int res = socket_connection_write_buffers(conn, buffers, 2);
+        if (res < 0){
+            // connection broken, read handler will close it
+            conn->stats.num_packets_dropped++;
+            return;
+        }
+        bytes_written = (uint32_t) res;
+    }
+
+    conn->stats.num_packets_sent++;
+    if (bytes_written == packet_len) return;
+
+    // queue remaining part of packet and wait for socket to become writable
+    if (bytes_written < sizeof(header)){
+        socket_connection_queue_store(conn, &header[bytes_written], sizeof(header) - bytes_written);
+        socket_connection_queue_store(conn, packet, size);
+    } else {
+        socket_connection_queue_store(conn, &packet[bytes_written - sizeof(header)], packet_len - bytes_written);
+    }
+    btstack_run_loop_enable_data_source_callbacks(&conn->ds, DATA_SOURCE_CALLBACK_WRITE);
+
+    // stop reading requests from slow client
+    if ((slow_consumer_policy == SOCKET_CONNECTION_SLOW_CONSUMER_PARK) && (conn->output_parked == false) &&
+        (conn->stats.bytes_queued > (SOCKET_CONNECTION_OUTGOING_BUFFER_SIZE / 2))){
+        log_info("socket_connection_send_packet: outgoing buffer more than half full -> park connection %p", conn);
+        conn->output_parked = true;
+        conn->stats.num_parked++;
+        socket_connection_update_read_callback(conn);
+    }
 }
 
 /**
@@ -56,6 +56,24 @@ extern "C" {
 /** opaque connection type */
 typedef struct connection connection_t;
 
+/** handling of clients that don't read their packets fast enough */
+typedef enum {
+    // drop packets that don't fit into the outgoing buffer
+    SOCKET_CONNECTION_SLOW_CONSUMER_DROP = 0,
+    // stop reading requests from client while outgoing buffer is more than half full, drop if full
+    SOCKET_CONNECTION_SLOW_CONSUMER_PARK,
+} socket_connection_slow_consumer_policy_t;
+
+/** statistics for outgoing packets of a single connection */
+typedef struct {
+    uint32_t bytes_queued;          // current queue depth
+    uint32_t max_bytes_queued;      // max queue depth since connection was opened
+    uint32_t num_packets_sent;      // packets written to socket or queued
+    uint32_t num_packets_dropped;   // packets dropped as outgoing buffer was full
+    uint32_t num_writes;            // number of write system calls
+    uint32_t num_parked;            // how often the client was parked due to slow reads
+} socket_connection_stats_t;
+
 /**
  * Init socket connection module
  */
@@ -129,6 +147,27 @@ void socket_connection_retry_parked(void);
  */
 int  socket_connection_has_parked_connections(void);
 
+/**
+ * set policy for clients that don't read packets fast enough, default: SOCKET_CONNECTION_SLOW_CONSUMER_PARK
+ */
+void socket_connection_set_slow_consumer_policy(socket_connection_slow_consumer_policy_t policy);
+
+/**
+ * get statistics for outgoing packets of connection
+ */
+void socket_connection_get_stats(connection_t *connection, socket_connection_stats_t * stats);
+
+/**
+ * request to receive packets from BTdaemon via shared memory ring, requires unix socket connection
+ * @return 0 if request was sent
+ */
+int socket_connection_enable_shared_memory(connection_t *connection);
+
+/**
+ * query if packets are exchanged via shared memory
+ */
+int socket_connection_shared_memory_active(connection_t *connection);
+
 #if defined __cplusplus
 }
 #endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "btstack_crypto_ecc_worker_posix.c"
+
+// enable POSIX functions (needed for -std=c99)
+#define _POSIX_C_SOURCE 200809
+
+#include "btstack_crypto_ecc_worker_posix.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+
+#include "btstack_crypto.h"
+#include "btstack_debug.h"
+#include "btstack_linked_list.h"
+#include "btstack_run_loop.h"
+
+#ifdef ENABLE_ECC_P256
+
+#ifndef BTSTACK_CRYPTO_ECC_WORKER_POSIX_MAX_WORKERS
+#define BTSTACK_CRYPTO_ECC_WORKER_POSIX_MAX_WORKERS 8
+#endif
+
+static pthread_t btstack_crypto_ecc_worker_posix_threads[BTSTACK_CRYPTO_ECC_WORKER_POSIX_MAX_WORKERS];
+static uint8_t   btstack_crypto_ecc_worker_posix_num_workers;
+
+static pthread_mutex_t btstack_crypto_ecc_worker_posix_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  btstack_crypto_ecc_worker_posix_cond  = PTHREAD_COND_INITIALIZER;
+
+// queued requests linked via worker_completion item, protected by mutex
+static btstack_linked_list_t btstack_crypto_ecc_worker_posix_requests;
+static bool                  btstack_crypto_ecc_worker_posix_exit_requested;
+
+static void * btstack_crypto_ecc_worker_posix_thread(void * arg){
+    UNUSED(arg);
+    while (true){
+        pthread_mutex_lock(&btstack_crypto_ecc_worker_posix_mutex);
+        while (btstack_linked_list_empty(&btstack_crypto_ecc_worker_posix_requests) && (btstack_crypto_ecc_worker_posix_exit_requested == false)){
+            pthread_cond_wait(&btstack_crypto_ecc_worker_posix_cond, &btstack_crypto_ecc_worker_posix_mutex);
+        }
+        btstack_linked_item_t * item = btstack_linked_list_pop(&btstack_crypto_ecc_worker_posix_requests);
+        pthread_mutex_unlock(&btstack_crypto_ecc_worker_posix_mutex);
+        if (item == NULL){
+            // exit requested and all requests processed
+            break;
+        }
+
+        // completion context is the request
+        btstack_context_callback_registration_t * completion = (btstack_context_callback_registration_t *) item;
+        btstack_crypto_ecc_p256_worker_calculate_dhkey((btstack_crypto_ecc_p256_t *) completion->context);
+
+        // registration must not be marked as queued
+        completion->item = NULL;
+        btstack_run_loop_execute_on_main_thread(completion);
+    }
+    return NULL;
+}
+
+static void btstack_crypto_ecc_worker_posix_execute(btstack_crypto_ecc_p256_t * request){
+    pthread_mutex_lock(&btstack_crypto_ecc_worker_posix_mutex);
+    btstack_linked_list_add_tail(&btstack_crypto_ecc_worker_posix_requests, (btstack_linked_item_t *) &request->worker_completion);
+    pthread_cond_signal(&btstack_crypto_ecc_worker_posix_cond);
+    pthread_mutex_unlock(&btstack_crypto_ecc_worker_posix_mutex);
+}
+
+int btstack_crypto_ecc_worker_posix_init(uint8_t num_workers){
+    btstack_assert(btstack_crypto_ecc_worker_posix_num_workers == 0);
+    if (num_workers > BTSTACK_CRYPTO_ECC_WORKER_POSIX_MAX_WORKERS){
+        num_workers = BTSTACK_CRYPTO_ECC_WORKER_POSIX_MAX_WORKERS;
+    }
+    btstack_crypto_ecc_worker_posix_exit_requested = false;
+    uint8_t i;
+    for (i = 0; i < num_workers; i++){
+        int err = pthread_create(&btstack_crypto_ecc_worker_posix_threads[i], NULL, &btstack_crypto_ecc_worker_posix_thread, NULL);
+        if (err != 0){
+            log_error("pthread_create failed, err %d", err);
+            btstack_crypto_ecc_worker_posix_deinit();
+            return err;
+        }
+        btstack_crypto_ecc_worker_posix_num_workers++;
+    }
+    if (num_workers > 0){
+        btstack_crypto_ecc_p256_set_worker(&btstack_crypto_ecc_worker_posix_execute);
+    }
+    return 0;
+}
+
+void btstack_crypto_ecc_worker_posix_deinit(void){
+    btstack_crypto_ecc_p256_set_worker(NULL);
+    pthread_mutex_lock(&btstack_crypto_ecc_worker_posix_mutex);
+    btstack_crypto_ecc_worker_posix_exit_requested = true;
+    pthread_cond_broadcast(&btstack_crypto_ecc_worker_posix_cond);
+    pthread_mutex_unlock(&btstack_crypto_ecc_worker_posix_mutex);
+    uint8_t i;
+    for (i = 0; i < btstack_crypto_ecc_worker_posix_num_workers; i++){
+        pthread_join(btstack_crypto_ecc_worker_posix_threads[i], NULL);
+    }
+    btstack_crypto_ecc_worker_posix_num_workers = 0;
+}
+
+#endif
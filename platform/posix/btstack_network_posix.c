@@ -61,6 +61,8 @@
 #include <fcntl.h>
 #include <ifaddrs.h>
 #include <net/if_arp.h>
+#include <poll.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -79,11 +81,21 @@
 #include <linux/if_tun.h>
 #endif
 
+// number of network packets read from TAP that can be queued while waiting for BNEP
+#ifndef BTSTACK_NETWORK_QUEUE_DEPTH
+#define BTSTACK_NETWORK_QUEUE_DEPTH 8
+#endif
+
 static int  tap_fd = -1;
-static uint8_t network_buffer[BNEP_MTU_MIN];
-static size_t  network_buffer_len = 0;
 static char tap_dev_name[16];
 
+// queue of network packets, packet at head has been passed to client if network_queue_head_delivered is set
+static uint8_t  network_queue_buffer[BTSTACK_NETWORK_QUEUE_DEPTH][BNEP_MTU_MIN];
+static uint16_t network_queue_len[BTSTACK_NETWORK_QUEUE_DEPTH];
+static uint16_t network_queue_head;
+static uint16_t network_queue_count;
+static bool     network_queue_head_delivered;
+
 #if defined(__APPLE__) || defined(__FreeBSD__)
 // tuntaposx provides fixed set of tapX devices
 static const char * tap_dev = "/dev/tap0";
@@ -100,38 +112,61 @@ static btstack_data_source_t tap_dev_ds;
 
 static void (*btstack_network_send_packet_callback)(const uint8_t * packet, uint16_t size);
 
+static void network_queue_reset(void){
+    network_queue_head = 0;
+    network_queue_count = 0;
+    network_queue_head_delivered = false;
+}
+
+static void network_queue_deliver_head(void){
+    if (network_queue_head_delivered) return;
+    if (network_queue_count == 0) return;
+    network_queue_head_delivered = true;
+    (*btstack_network_send_packet_callback)(network_queue_buffer[network_queue_head], network_queue_len[network_queue_head]);
+}
+
 /*
- * @text Listing processTapData shows how a packet is received from the TAP network interface
+ * @text Listing processTapData shows how packets are received from the TAP network interface
  * and forwarded over the BNEP connection.
  * 
- * After successfully reading a network packet, the call to
- * the *bnep_can_send_packet_now* function checks, if BTstack can forward
- * a network packet now. If that's not possible, the received data stays
- * in the network buffer and the data source elements is removed from the
- * run loop. The *process_tap_dev_data* function will not be called until
- * the data source is registered again. This provides a basic flow control.
+ * All network packets that are available are read into a queue of BTSTACK_NETWORK_QUEUE_DEPTH packets.
+ * The oldest packet is passed to the client, which forwards it over BNEP and calls
+ * *btstack_network_packet_sent*. Then, the next queued packet is passed on without
+ * waiting for the TAP interface. If the queue is full, the data source callback is disabled
+ * until a packet was sent. This provides a basic flow control.
  */
 
 /* LISTING_START(processTapData): Process incoming network packets */
 static void process_tap_dev_data(btstack_data_source_t *ds, btstack_data_source_callback_type_t callback_type) 
 {
-    UNUSED(ds);
     UNUSED(callback_type);
 
-    ssize_t len;
-    len = read(ds->source.fd, network_buffer, sizeof(network_buffer));
-    if (len <= 0){
-        fprintf(stderr, "TAP: Error while reading: %s\n", strerror(errno));
-        return;
+    while (network_queue_count < BTSTACK_NETWORK_QUEUE_DEPTH){
+        // after first packet, only read if next packet is available
+        if (network_queue_count > 0){
+            struct pollfd tap_poll;
+            tap_poll.fd = ds->source.fd;
+            tap_poll.events = POLLIN;
+            tap_poll.revents = 0;
+            if (poll(&tap_poll, 1, 0) <= 0) break;
+        }
+        uint16_t index = (network_queue_head + network_queue_count) % BTSTACK_NETWORK_QUEUE_DEPTH;
+        ssize_t len = read(ds->source.fd, network_queue_buffer[index], BNEP_MTU_MIN);
+        if (len <= 0){
+            fprintf(stderr, "TAP: Error while reading: %s\n", strerror(errno));
+            break;
+        }
+        network_queue_len[index] = (uint16_t) len;
+        network_queue_count++;
     }
 
-    network_buffer_len = len;
-
-    // disable reading from netif
-    btstack_run_loop_disable_data_source_callbacks(&tap_dev_ds, DATA_SOURCE_CALLBACK_READ);
+    // disable reading from netif if queue is full
+    if (network_queue_count == BTSTACK_NETWORK_QUEUE_DEPTH){
+        btstack_run_loop_disable_data_source_callbacks(&tap_dev_ds, DATA_SOURCE_CALLBACK_READ);
+    }
 
     // let client now
-    (*btstack_network_send_packet_callback)(network_buffer, network_buffer_len);
+    network_queue_deliver_head();
 }
 
 /**
@@ -242,6 +277,7 @@ int btstack_network_up(bd_addr_t network_address){
     close(fd_socket);
 
     tap_fd = fd_dev;
+    network_queue_reset();
     log_info("BNEP device \"%s\" allocated", tap_dev_name);
 
     /* Create and register a new runloop data source */
@@ -274,6 +310,7 @@ int btstack_network_down(void){
         close(tap_fd);
     }
     tap_fd = -1;
+    network_queue_reset();
     return 0;
 }
 
@@ -301,8 +338,16 @@ void btstack_network_process_packet(const uint8_t * packet, uint16_t size){
  */
 void btstack_network_packet_sent(void){
 
-    network_buffer_len = 0;
+    if (!network_queue_head_delivered) return;
+
+    // release packet
+    network_queue_head_delivered = false;
+    network_queue_head = (network_queue_head + 1) % BTSTACK_NETWORK_QUEUE_DEPTH;
+    network_queue_count--;
 
     // Re-enable the tap device data source
     btstack_run_loop_enable_data_source_callbacks(&tap_dev_ds, DATA_SOURCE_CALLBACK_READ);
+
+    // pass on next queued packet
+    network_queue_deliver_head();
 }
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "btstack_parallel_posix.c"
+
+// enable POSIX functions (needed for -std=c99)
+#define _POSIX_C_SOURCE 200809
+
+#include "btstack_parallel_posix.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+
+#include "btstack_debug.h"
+
+#ifndef BTSTACK_PARALLEL_POSIX_MAX_WORKERS
+#define BTSTACK_PARALLEL_POSIX_MAX_WORKERS 16
+#endif
+
+typedef struct {
+    pthread_t thread;
+    uint8_t   index;
+    // last job processed, set before thread start as generation is kept across deinit/init
+    uint32_t  job_generation;
+} btstack_parallel_posix_worker_t;
+
+static btstack_parallel_posix_worker_t btstack_parallel_posix_workers[BTSTACK_PARALLEL_POSIX_MAX_WORKERS];
+static uint8_t btstack_parallel_posix_num_workers;
+
+static pthread_mutex_t btstack_parallel_posix_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  btstack_parallel_posix_cond_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  btstack_parallel_posix_cond_done  = PTHREAD_COND_INITIALIZER;
+
+// current job, protected by mutex
+static uint32_t btstack_parallel_posix_job_generation;
+static uint8_t  btstack_parallel_posix_workers_pending;
+static bool     btstack_parallel_posix_exit_requested;
+static uint16_t btstack_parallel_posix_num_items;
+static void   (*btstack_parallel_posix_work)(void * context, uint16_t first_item, uint16_t num_items);
+static void *   btstack_parallel_posix_context;
+
+// range for share: 0 = calling thread, 1..num_workers = worker threads
+static void btstack_parallel_posix_run_share(uint8_t share, uint16_t num_items,
+                                             void (*work)(void * context, uint16_t first_item, uint16_t num_items), void * context){
+    uint16_t num_shares = btstack_parallel_posix_num_workers + 1;
+    uint16_t first_item = (uint16_t) (((uint32_t) num_items * share) / num_shares);
+    uint16_t end_item   = (uint16_t) (((uint32_t) num_items * (share + 1)) / num_shares);
+    if (end_item > first_item){
+        (*work)(context, first_item, end_item - first_item);
+    }
+}
+
+static void * btstack_parallel_posix_worker_thread(void * arg){
+    btstack_parallel_posix_worker_t * worker = (btstack_parallel_posix_worker_t *) arg;
+    while (true){
+        pthread_mutex_lock(&btstack_parallel_posix_mutex);
+        while ((btstack_parallel_posix_job_generation == worker->job_generation) && (btstack_parallel_posix_exit_requested == false)){
+            pthread_cond_wait(&btstack_parallel_posix_cond_start, &btstack_parallel_posix_mutex);
+        }
+        if (btstack_parallel_posix_exit_requested){
+            pthread_mutex_unlock(&btstack_parallel_posix_mutex);
+            break;
+        }
+        worker->job_generation = btstack_parallel_posix_job_generation;
+        uint16_t num_items = btstack_parallel_posix_num_items;
+        void (*work)(void * context, uint16_t first_item, uint16_t num_items) = btstack_parallel_posix_work;
+        void * context = btstack_parallel_posix_context;
+        pthread_mutex_unlock(&btstack_parallel_posix_mutex);
+
+        btstack_parallel_posix_run_share(worker->index, num_items, work, context);
+
+        pthread_mutex_lock(&btstack_parallel_posix_mutex);
+        btstack_parallel_posix_workers_pending--;
+        if (btstack_parallel_posix_workers_pending == 0){
+            pthread_cond_signal(&btstack_parallel_posix_cond_done);
+        }
+        pthread_mutex_unlock(&btstack_parallel_posix_mutex);
+    }
+    return NULL;
+}
+
+int btstack_parallel_posix_init(uint8_t num_workers){
+    btstack_assert(btstack_parallel_posix_num_workers == 0);
+    if (num_workers > BTSTACK_PARALLEL_POSIX_MAX_WORKERS){
+        num_workers = BTSTACK_PARALLEL_POSIX_MAX_WORKERS;
+    }
+    btstack_parallel_posix_exit_requested = false;
+    uint8_t i;
+    for (i = 0; i < num_workers; i++){
+        btstack_parallel_posix_worker_t * worker = &btstack_parallel_posix_workers[i];
+        worker->index = i + 1;
+        worker->job_generation = btstack_parallel_posix_job_generation;
+        int err = pthread_create(&worker->thread, NULL, &btstack_parallel_posix_worker_thread, worker);
+        if (err != 0){
+            log_error("pthread_create failed, err %d", err);
+            btstack_parallel_posix_deinit();
+            return err;
+        }
+        btstack_parallel_posix_num_workers++;
+    }
+    return 0;
+}
+
+void btstack_parallel_posix_for(uint16_t num_items, void (*work)(void * context, uint16_t first_item, uint16_t num_items), void * context){
+    if ((btstack_parallel_posix_num_workers == 0) || (num_items < 2)){
+        (*work)(context, 0, num_items);
+        return;
+    }
+
+    // start workers
+    pthread_mutex_lock(&btstack_parallel_posix_mutex);
+    btstack_parallel_posix_num_items = num_items;
+    btstack_parallel_posix_work = work;
+    btstack_parallel_posix_context = context;
+    btstack_parallel_posix_workers_pending = btstack_parallel_posix_num_workers;
+    btstack_parallel_posix_job_generation++;
+    pthread_cond_broadcast(&btstack_parallel_posix_cond_start);
+    pthread_mutex_unlock(&btstack_parallel_posix_mutex);
+
+    // process own share
+    btstack_parallel_posix_run_share(0, num_items, work, context);
+
+    // wait for workers
+    pthread_mutex_lock(&btstack_parallel_posix_mutex);
+    while (btstack_parallel_posix_workers_pending > 0){
+        pthread_cond_wait(&btstack_parallel_posix_cond_done, &btstack_parallel_posix_mutex);
+    }
+    pthread_mutex_unlock(&btstack_parallel_posix_mutex);
+}
+
+void btstack_parallel_posix_deinit(void){
+    pthread_mutex_lock(&btstack_parallel_posix_mutex);
+    btstack_parallel_posix_exit_requested = true;
+    pthread_cond_broadcast(&btstack_parallel_posix_cond_start);
+    pthread_mutex_unlock(&btstack_parallel_posix_mutex);
+    uint8_t i;
+    for (i = 0; i < btstack_parallel_posix_num_workers; i++){
+        pthread_join(btstack_parallel_posix_workers[i].thread, NULL);
+    }
+    btstack_parallel_posix_num_workers = 0;
+}
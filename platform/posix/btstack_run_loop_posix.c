@@ -53,6 +53,7 @@
 #include "btstack_linked_list.h"
 #include "btstack_debug.h"
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/errno.h>
@@ -60,7 +61,11 @@
 #include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
-#include <pthread.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#define BTSTACK_RUN_LOOP_POSIX_USE_EVENTFD
+#endif
 
 // the run loop
 static int btstack_run_loop_posix_data_sources_modified;
@@ -68,10 +73,30 @@ static int btstack_run_loop_posix_data_sources_modified;
 static bool btstack_run_loop_posix_exit_requested;
 
 // to trigger process callbacks other thread
-static pthread_mutex_t       btstack_run_loop_posix_callbacks_mutex = PTHREAD_MUTEX_INITIALIZER;
 static int                   btstack_run_loop_posix_process_callbacks_fd;
 static btstack_data_source_t btstack_run_loop_posix_process_callbacks_ds;
 
+// lock-free multi-producer / single-consumer callback queue
+// - producers push registrations onto a stack with compare-and-swap, the main thread takes the whole stack at once
+// - a queued registration has the queued flag set in bit 0 of item, the last element points to the end marker instead of NULL
+// - a stale item from previous use has bit 0 cleared and does not prevent queueing
+// - only the producer that finds the stack empty triggers the run loop, further submissions are coalesced
+#define BTSTACK_RUN_LOOP_POSIX_CALLBACK_QUEUED ((uintptr_t) 1u)
+static btstack_linked_item_t   btstack_run_loop_posix_callbacks_end;
+static btstack_linked_item_t * btstack_run_loop_posix_callbacks_head;
+
+static inline btstack_linked_item_t * btstack_run_loop_posix_callback_mark_queued(btstack_linked_item_t * item){
+    return (btstack_linked_item_t *) ((uintptr_t) item | BTSTACK_RUN_LOOP_POSIX_CALLBACK_QUEUED);
+}
+
+static inline btstack_linked_item_t * btstack_run_loop_posix_callback_next(btstack_linked_item_t * item){
+    return (btstack_linked_item_t *) ((uintptr_t) item->next & ~BTSTACK_RUN_LOOP_POSIX_CALLBACK_QUEUED);
+}
+
+static inline bool btstack_run_loop_posix_callback_is_queued(btstack_linked_item_t * item){
+    return ((uintptr_t) item & BTSTACK_RUN_LOOP_POSIX_CALLBACK_QUEUED) != 0u;
+}
+
 // to trigger poll data sources from irq
 static int                   btstack_run_loop_posix_poll_data_sources_fd;
 static btstack_data_source_t btstack_run_loop_posix_poll_data_sources_ds;
@@ -249,73 +274,125 @@ static void btstack_run_loop_posix_set_timer(btstack_timer_source_t *a, uint32_t
     log_debug("btstack_run_loop_posix_set_timer to %u ms (now %u, timeout %u)", a->timeout, time_ms, timeout_in_ms);
 }
 
-// trigger pipe
-static void btstack_run_loop_posix_trigger_pipe(int fd){
+// trigger wakeup fd
+static void btstack_run_loop_posix_trigger_wakeup(int fd){
     if (fd < 0) return;
+#ifdef BTSTACK_RUN_LOOP_POSIX_USE_EVENTFD
+    const uint64_t x = 1;
+#else
     const uint8_t x = (uint8_t) 'x';
-    ssize_t bytes_written = write(fd, &x, 1);
+#endif
+    ssize_t bytes_written = write(fd, &x, sizeof(x));
     UNUSED(bytes_written);
 }
 
+// consume all pending wakeups, fd is non-blocking
+static void btstack_run_loop_posix_drain_wakeup(int fd){
+#ifdef BTSTACK_RUN_LOOP_POSIX_USE_EVENTFD
+    uint64_t counter;
+    ssize_t bytes_read = read(fd, &counter, sizeof(counter));
+    UNUSED(bytes_read);
+#else
+    uint8_t buffer[16];
+    while (read(fd, buffer, sizeof(buffer)) == (ssize_t) sizeof(buffer)){}
+#endif
+}
+
 // poll data sources from irq
 
 static void btstack_run_loop_posix_poll_data_sources_handler(btstack_data_source_t * ds, btstack_data_source_callback_type_t callback_type){
     UNUSED(callback_type);
-    uint8_t buffer[1];
-    ssize_t bytes_read = read(ds->source.fd, buffer, 1);
-    UNUSED(bytes_read);
+    btstack_run_loop_posix_drain_wakeup(ds->source.fd);
     // poll data sources
     btstack_run_loop_base_poll_data_sources();
 }
 
 static void btstack_run_loop_posix_poll_data_sources_from_irq(void){
     // trigger run loop
-    btstack_run_loop_posix_trigger_pipe(btstack_run_loop_posix_poll_data_sources_fd);
+    btstack_run_loop_posix_trigger_wakeup(btstack_run_loop_posix_poll_data_sources_fd);
 }
 
 // execute on main thread from same or different thread
 
 static void btstack_run_loop_posix_process_callbacks_handler(btstack_data_source_t * ds, btstack_data_source_callback_type_t callback_type){
     UNUSED(callback_type);
-    uint8_t buffer[1];
-    ssize_t bytes_read = read(ds->source.fd, buffer, 1);
-    UNUSED(bytes_read);
-    // execute callbacks - protect list with mutex
+    btstack_run_loop_posix_drain_wakeup(ds->source.fd);
     while (1){
-        pthread_mutex_lock(&btstack_run_loop_posix_callbacks_mutex);
-        btstack_context_callback_registration_t * callback_registration = (btstack_context_callback_registration_t *) btstack_linked_list_pop(&btstack_run_loop_base_callbacks);
-        pthread_mutex_unlock(&btstack_run_loop_posix_callbacks_mutex);
-        if (callback_registration == NULL){
+        // take all queued registrations at once
+        btstack_linked_item_t * stack = __atomic_exchange_n(&btstack_run_loop_posix_callbacks_head, NULL, __ATOMIC_ACQUIRE);
+        if (stack == NULL){
             break;
         }
-        (*callback_registration->callback)(callback_registration->context);
+        // reverse to get submission order
+        btstack_linked_item_t * queue = &btstack_run_loop_posix_callbacks_end;
+        while (stack != &btstack_run_loop_posix_callbacks_end){
+            btstack_linked_item_t * next = btstack_run_loop_posix_callback_next(stack);
+            stack->next = btstack_run_loop_posix_callback_mark_queued(queue);
+            queue = stack;
+            stack = next;
+        }
+        // execute callbacks, registration can be queued again from within its callback
+        while (queue != &btstack_run_loop_posix_callbacks_end){
+            btstack_context_callback_registration_t * callback_registration = (btstack_context_callback_registration_t *) queue;
+            queue = btstack_run_loop_posix_callback_next(queue);
+            __atomic_store_n(&callback_registration->item, NULL, __ATOMIC_RELEASE);
+            (*callback_registration->callback)(callback_registration->context);
+        }
     }
 }
 
 static void btstack_run_loop_posix_execute_on_main_thread(btstack_context_callback_registration_t * callback_registration){
-    // protect list with mutex
-    pthread_mutex_lock(&btstack_run_loop_posix_callbacks_mutex);
-    btstack_run_loop_base_add_callback(callback_registration);
-    pthread_mutex_unlock(&btstack_run_loop_posix_callbacks_mutex);
-    // trigger run loop
-    btstack_run_loop_posix_trigger_pipe(btstack_run_loop_posix_process_callbacks_fd);
+    // mark as queued, ignore if already queued
+    btstack_linked_item_t * expected = __atomic_load_n(&callback_registration->item, __ATOMIC_RELAXED);
+    do {
+        if (btstack_run_loop_posix_callback_is_queued(expected)){
+            return;
+        }
+    } while (__atomic_compare_exchange_n(&callback_registration->item, &expected,
+                                         btstack_run_loop_posix_callback_mark_queued(&btstack_run_loop_posix_callbacks_end),
+                                         false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) == false);
+    // push onto stack
+    btstack_linked_item_t * head = __atomic_load_n(&btstack_run_loop_posix_callbacks_head, __ATOMIC_RELAXED);
+    do {
+        callback_registration->item = btstack_run_loop_posix_callback_mark_queued((head != NULL) ? head : &btstack_run_loop_posix_callbacks_end);
+    } while (__atomic_compare_exchange_n(&btstack_run_loop_posix_callbacks_head, &head, (btstack_linked_item_t *) callback_registration,
+                                         true, __ATOMIC_RELEASE, __ATOMIC_RELAXED) == false);
+    // trigger run loop only if queue was empty
+    if (head == NULL){
+        btstack_run_loop_posix_trigger_wakeup(btstack_run_loop_posix_process_callbacks_fd);
+    }
 }
 
 //init
 
-// @return fd >= 0 on success
-static int btstack_run_loop_posix_register_pipe_datasource(btstack_data_source_t * data_source){
+// @return fd for trigger >= 0 on success
+static int btstack_run_loop_posix_register_wakeup_datasource(btstack_data_source_t * data_source){
+#ifdef BTSTACK_RUN_LOOP_POSIX_USE_EVENTFD
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0){
+        log_error("eventfd() failed");
+        return -1;
+    }
+    data_source->source.fd = fd;
+    data_source->flags = DATA_SOURCE_CALLBACK_READ;
+    btstack_run_loop_base_add_data_source(data_source);
+    log_info("Eventfd: %u", fd);
+    return fd;
+#else
     int fildes[2]; // 0 = read,  1 = write
     int status = pipe(fildes);
     if (status != 0){
         log_error("pipe() failed");
         return -1;
     }
+    // non-blocking read end to drain all pending wakeups
+    fcntl(fildes[0], F_SETFL, fcntl(fildes[0], F_GETFL) | O_NONBLOCK);
     data_source->source.fd = fildes[0];
     data_source->flags = DATA_SOURCE_CALLBACK_READ;
     btstack_run_loop_base_add_data_source(data_source);
     log_info("Pipe: in %u, out %u", fildes[1], fildes[0]);
     return fildes[1];
+#endif
 }
 
 static void btstack_run_loop_posix_init(void){
@@ -330,13 +407,14 @@ static void btstack_run_loop_posix_init(void){
     init_tv.tv_usec = 0;
 #endif
 
-    // setup pipe to trigger process callbacks
+    // setup wakeup to trigger process callbacks
+    btstack_run_loop_posix_callbacks_head = NULL;
     btstack_run_loop_posix_process_callbacks_ds.process = &btstack_run_loop_posix_process_callbacks_handler;
-    btstack_run_loop_posix_process_callbacks_fd = btstack_run_loop_posix_register_pipe_datasource(&btstack_run_loop_posix_process_callbacks_ds);
+    btstack_run_loop_posix_process_callbacks_fd = btstack_run_loop_posix_register_wakeup_datasource(&btstack_run_loop_posix_process_callbacks_ds);
 
-    // setup pipe to poll data sources
+    // setup wakeup to poll data sources
     btstack_run_loop_posix_poll_data_sources_ds.process = &btstack_run_loop_posix_poll_data_sources_handler;
-    btstack_run_loop_posix_poll_data_sources_fd = btstack_run_loop_posix_register_pipe_datasource(&btstack_run_loop_posix_poll_data_sources_ds);
+    btstack_run_loop_posix_poll_data_sources_fd = btstack_run_loop_posix_register_wakeup_datasource(&btstack_run_loop_posix_poll_data_sources_ds);
 }
 
 static const btstack_run_loop_t btstack_run_loop_posix = {
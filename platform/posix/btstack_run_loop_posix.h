@@ -51,6 +51,8 @@ extern "C" {
 	
 /**
  * Provide btstack_run_loop_posix instance
+ * @note btstack_run_loop_execute_on_main_thread uses a lock-free queue: the item field of a
+ *       btstack_context_callback_registration_t must be NULL (zero-initialized) when not queued
  */
 const btstack_run_loop_t * btstack_run_loop_posix_get_instance(void);
 
@@ -98,6 +98,9 @@ typedef struct att_iterator {
 static void att_persistent_ccc_cache(att_iterator_t * it);
 
 static uint8_t const * att_database = NULL;
+#ifdef ENABLE_ATT_DB_INDEX
+static uint16_t const * att_database_index = NULL;
+#endif
 static att_read_callback_t  att_read_callback  = NULL;
 static att_write_callback_t att_write_callback = NULL;
 static int      att_prepare_write_error_code   = 0;
@@ -111,6 +114,33 @@ static void att_iterator_init(att_iterator_t *it){
     it->att_ptr = att_database;
 }
 
+// init iterator at first attribute with handle >= start_handle
+static void att_iterator_init_at_handle(att_iterator_t *it, uint16_t start_handle){
+    it->att_ptr = att_database;
+#ifdef ENABLE_ATT_DB_INDEX
+    if (att_database_index == NULL){
+        return;
+    }
+    // binary search over attribute offsets sorted by handle, last offset points to END marker
+    uint16_t num_attributes = att_database_index[0];
+    const uint16_t * offsets = &att_database_index[1];
+    uint16_t left = 0;
+    uint16_t right = num_attributes;
+    while (left < right){
+        uint16_t middle = left + ((right - left) / 2u);
+        uint16_t handle = little_endian_read_16(att_database, offsets[middle] + 4u);
+        if (handle < start_handle){
+            left = middle + 1u;
+        } else {
+            right = middle;
+        }
+    }
+    it->att_ptr = &att_database[offsets[left]];
+#else
+    UNUSED(start_handle);
+#endif
+}
+
 static bool att_iterator_has_next(att_iterator_t *it){
     return it->att_ptr != NULL;
 }
@@ -178,7 +208,7 @@ static bool att_find_handle(att_iterator_t *it, uint16_t handle){
     if (handle == 0u){
         return false;
     }
-    att_iterator_init(it);
+    att_iterator_init_at_handle(it, handle);
     while (att_iterator_has_next(it)){
         att_iterator_fetch_next(it);
         if (it->handle == handle){
@@ -250,7 +280,18 @@ void att_set_db(uint8_t const * db){
     log_info("att_set_db %p", db);
     // ignore db version
     att_database = &db[1];
+#ifdef ENABLE_ATT_DB_INDEX
+    // index belongs to previous db
+    att_database_index = NULL;
+#endif
+}
+
+#ifdef ENABLE_ATT_DB_INDEX
+void att_set_db_index(uint16_t const * index){
+    log_info("att_set_db_index %p", index);
+    att_database_index = index;
 }
+#endif
 
 void att_set_read_callback(att_read_callback_t callback){
     att_read_callback = callback;
@@ -454,7 +495,7 @@ static uint16_t handle_find_information_request2(att_connection_t * att_connecti
     uint16_t uuid_len = 0;
     
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         if (!it.handle){
@@ -559,7 +600,7 @@ static uint16_t handle_find_by_type_value_request(att_connection_t * att_connect
     uint16_t prev_handle = 0;
 
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
 
@@ -624,7 +665,7 @@ static uint16_t handle_read_by_type_request2(att_connection_t * att_connection,
     uint16_t pair_len = 0;
 
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     uint8_t error_code = 0;
     uint16_t first_matching_but_unreadable_handle = 0;
 
@@ -1013,7 +1054,7 @@ static uint16_t handle_read_by_group_type_request2(att_connection_t * att_connec
     uint16_t prev_handle = 0;
 
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         
@@ -1457,7 +1498,7 @@ bool gatt_server_get_handle_range_for_service_with_uuid16(uint16_t uuid16, uint1
 // returns false if not found
 uint16_t gatt_server_get_value_handle_for_characteristic_with_uuid16(uint16_t start_handle, uint16_t end_handle, uint16_t uuid16){
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         if ((it.handle != 0u) && (it.handle < start_handle)){
@@ -1478,7 +1519,7 @@ uint16_t gatt_server_get_value_handle_for_characteristic_with_uuid16(uint16_t st
 
 uint16_t gatt_server_get_descriptor_handle_for_characteristic_with_uuid16(uint16_t start_handle, uint16_t end_handle, uint16_t characteristic_uuid16, uint16_t descriptor_uuid16){
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     bool characteristic_found = false;
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
@@ -1559,7 +1600,7 @@ uint16_t gatt_server_get_value_handle_for_characteristic_with_uuid128(uint16_t s
     uint8_t attribute_value[16];
     reverse_128(uuid128, attribute_value);
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         if ((it.handle != 0u) && (it.handle < start_handle)){
@@ -1583,7 +1624,7 @@ uint16_t gatt_server_get_client_configuration_handle_for_characteristic_with_uui
     uint8_t attribute_value[16];
     reverse_128(uuid128, attribute_value);
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     bool characteristic_found = false;
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
@@ -1620,7 +1661,7 @@ bool gatt_server_get_included_service_with_uuid16(uint16_t start_handle, uint16_
     uint16_t * out_included_service_handle, uint16_t * out_included_service_start_handle, uint16_t * out_included_service_end_handle){
 
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         if ((it.handle != 0u) && (it.handle < start_handle)){
@@ -1805,7 +1846,7 @@ uint16_t btp_att_get_attributes_by_uuid128(uint16_t start_handle, uint16_t end_h
     uint8_t num_attributes = 0;
     uint16_t pos = 1;
     att_iterator_t  it;
-    att_iterator_init(&it);
+    att_iterator_init_at_handle(&it, start_handle);
     while (att_iterator_has_next(&it) && ((pos + 20) < response_buffer_size)){
         att_iterator_fetch_next(&it);
         if (it.handle == 0){
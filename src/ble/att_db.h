@@ -118,6 +118,18 @@ typedef struct att_connection {
     uint8_t  secure_connection;
 } att_connection_t;
 
+// statistics for aggregated notifications, see att_server_notify_aggregated
+typedef struct {
+    // values queued with att_server_notify_aggregated
+    uint32_t num_values_queued;
+    // queued values replaced by a newer value for the same attribute before they were sent
+    uint32_t num_values_coalesced;
+    // ATT PDUs sent
+    uint32_t num_pdus_sent;
+    // ATT PDU bytes sent
+    uint32_t num_bytes_sent;
+} att_server_notification_stats_t;
+
 /* API_START */
 
 // map ATT ERROR CODES on to att_read_callback length
@@ -181,6 +193,15 @@ typedef struct att_service_handler {
  */
 void att_set_db(uint8_t const * db);
 
+#ifdef ENABLE_ATT_DB_INDEX
+/**
+ * @brief set index for ATT database to find attributes by handle with binary search
+ * @note the index is generated by compile_gatt.py as profile_data_index and needs to be set after att_set_db
+ * @param index number of attributes followed by attribute offsets incl. END marker, sorted by handle, or NULL
+ */
+void att_set_db_index(uint16_t const * index);
+#endif
+
 /*
  * @brief set callback for read of dynamic attributes
  * @param callback
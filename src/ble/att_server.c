@@ -112,6 +112,10 @@ static att_write_callback_t                   att_server_client_write_callback;
 // round robin
 static hci_con_handle_t att_server_last_can_send_now = HCI_CON_HANDLE_INVALID;
 
+#ifdef ENABLE_ATT_SERVER_NOTIFICATION_AGGREGATION
+static btstack_context_callback_registration_t att_server_notification_aggregation_registration;
+#endif
+
 #ifdef ENABLE_GATT_OVER_EATT
 typedef struct {
     btstack_linked_item_t item;
@@ -386,6 +390,10 @@ static void att_server_event_packet_handler (uint8_t packet_type, uint16_t chann
                     att_connection->con_handle = 0;
                     att_server->pairing_active = false;
                     att_server->state = ATT_SERVER_IDLE;
+#ifdef ENABLE_ATT_SERVER_NOTIFICATION_AGGREGATION
+                    att_server->notification_aggregation_size = 0;
+                    att_server->notification_aggregation_scheduled = false;
+#endif
                     if (att_server->value_indication_handle != 0u){
                         btstack_run_loop_remove_timer(&att_server->value_indication_timer);
                         uint16_t att_handle = att_server->value_indication_handle;
@@ -1423,6 +1431,144 @@ uint8_t att_server_multiple_notify(hci_con_handle_t con_handle, uint8_t num_attr
     return att_server_send_prepared(att_server, att_connection, packet_buffer, size);
 }
 
+#ifdef ENABLE_ATT_SERVER_NOTIFICATION_AGGREGATION
+
+// find tuple for attribute handle in queued notifications
+static uint16_t att_server_notification_aggregation_find(const att_server_t * att_server, uint16_t attribute_handle, uint16_t * out_offset){
+    uint16_t offset = 0;
+    while (offset < att_server->notification_aggregation_size){
+        uint16_t tuple_size = 4u + little_endian_read_16(att_server->notification_aggregation_buffer, offset + 2u);
+        if (little_endian_read_16(att_server->notification_aggregation_buffer, offset) == attribute_handle){
+            *out_offset = offset;
+            return tuple_size;
+        }
+        offset += tuple_size;
+    }
+    return 0;
+}
+
+static void att_server_notification_aggregation_drop(att_server_t * att_server, uint16_t offset, uint16_t size){
+    uint16_t bytes_following = att_server->notification_aggregation_size - offset - size;
+    (void) memmove(&att_server->notification_aggregation_buffer[offset], &att_server->notification_aggregation_buffer[offset + size], bytes_following);
+    att_server->notification_aggregation_size -= size;
+}
+
+static void att_server_notification_aggregation_send(void * context){
+    hci_con_handle_t con_handle = (hci_con_handle_t) (uintptr_t) context;
+    hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
+    if (hci_connection == NULL) return;
+    att_server_t * queue = &hci_connection->att_server;
+
+    while (queue->notification_aggregation_size > 0){
+        att_server_t * att_server = NULL;
+        att_connection_t * att_connection = NULL;
+        uint8_t * packet_buffer = NULL;
+        uint8_t status = att_server_prepare_server_message(con_handle, &att_server, &att_connection, &packet_buffer);
+        if (status != ERROR_CODE_SUCCESS){
+            break;
+        }
+
+        // collect tuples that fit into a single Multiple Handle Value Notification
+        uint16_t num_bytes = 0;
+        uint8_t  num_tuples = 0;
+        if (queue->notification_aggregation_multiple_supported){
+            uint16_t max_size = att_connection->mtu - 1u;
+            while ((num_bytes < queue->notification_aggregation_size) && (num_tuples < 255u)){
+                uint16_t tuple_size = 4u + little_endian_read_16(queue->notification_aggregation_buffer, num_bytes + 2u);
+                if ((num_bytes + tuple_size) > max_size) break;
+                num_bytes += tuple_size;
+                num_tuples++;
+            }
+        }
+
+        uint16_t pdu_size;
+        if (num_tuples >= 2u){
+            // Multiple Handle Value Notification contains Handle Length Value Tuple List
+            packet_buffer[0] = ATT_MULTIPLE_HANDLE_VALUE_NTF;
+            (void) memcpy(&packet_buffer[1], queue->notification_aggregation_buffer, num_bytes);
+            pdu_size = 1u + num_bytes;
+        } else {
+            // single Handle Value Notification
+            uint16_t attribute_handle = little_endian_read_16(queue->notification_aggregation_buffer, 0);
+            uint16_t value_len        = little_endian_read_16(queue->notification_aggregation_buffer, 2);
+            pdu_size = att_prepare_handle_value_notification(att_connection, attribute_handle, &queue->notification_aggregation_buffer[4], value_len, packet_buffer);
+            num_bytes = 4u + value_len;
+        }
+
+        queue->notification_aggregation_stats.num_pdus_sent++;
+        queue->notification_aggregation_stats.num_bytes_sent += pdu_size;
+        att_server_notification_aggregation_drop(queue, 0, num_bytes);
+
+        (void) att_server_send_prepared(att_server, att_connection, packet_buffer, pdu_size);
+    }
+
+    // request to send remaining notifications
+    if (queue->notification_aggregation_size > 0){
+        (void) att_server_request_to_send_notification(&queue->notification_aggregation_request, con_handle);
+    }
+}
+
+// called from run loop after all updates of current iteration have been queued
+static void att_server_notification_aggregation_schedule(void * context){
+    UNUSED(context);
+    btstack_linked_list_iterator_t it;
+    hci_connections_get_iterator(&it);
+    while(btstack_linked_list_iterator_has_next(&it)){
+        hci_connection_t * hci_connection = (hci_connection_t *) btstack_linked_list_iterator_next(&it);
+        att_server_t * att_server = &hci_connection->att_server;
+        if (att_server->notification_aggregation_scheduled == false) continue;
+        att_server->notification_aggregation_scheduled = false;
+        att_server->notification_aggregation_request.callback = &att_server_notification_aggregation_send;
+        att_server->notification_aggregation_request.context  = (void *) (uintptr_t) hci_connection->con_handle;
+        (void) att_server_request_to_send_notification(&att_server->notification_aggregation_request, hci_connection->con_handle);
+    }
+}
+
+uint8_t att_server_notify_aggregated(hci_con_handle_t con_handle, uint16_t attribute_handle, const uint8_t *value, uint16_t value_len){
+    hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
+    if (hci_connection == NULL) return ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER;
+    att_server_t * att_server = &hci_connection->att_server;
+
+    // queued value for same attribute gets replaced, check for space first to keep it on error
+    uint16_t offset = 0;
+    uint16_t tuple_size = att_server_notification_aggregation_find(att_server, attribute_handle, &offset);
+    if ((att_server->notification_aggregation_size - tuple_size + 4u + value_len) > ATT_SERVER_NOTIFICATION_AGGREGATION_BUFFER_SIZE){
+        return ERROR_CODE_MEMORY_CAPACITY_EXCEEDED;
+    }
+    if (tuple_size > 0){
+        att_server_notification_aggregation_drop(att_server, offset, tuple_size);
+        att_server->notification_aggregation_stats.num_values_coalesced++;
+    }
+
+    uint16_t pos = att_server->notification_aggregation_size;
+    little_endian_store_16(att_server->notification_aggregation_buffer, pos, attribute_handle);
+    little_endian_store_16(att_server->notification_aggregation_buffer, pos + 2u, value_len);
+    (void) memcpy(&att_server->notification_aggregation_buffer[pos + 4u], value, value_len);
+    att_server->notification_aggregation_size += 4u + value_len;
+    att_server->notification_aggregation_stats.num_values_queued++;
+
+    // defer sending until current run loop iteration is complete
+    att_server->notification_aggregation_scheduled = true;
+    att_server_notification_aggregation_registration.callback = &att_server_notification_aggregation_schedule;
+    btstack_run_loop_execute_on_main_thread(&att_server_notification_aggregation_registration);
+    return ERROR_CODE_SUCCESS;
+}
+
+uint8_t att_server_set_multiple_notifications_supported(hci_con_handle_t con_handle, bool supported){
+    hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
+    if (hci_connection == NULL) return ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER;
+    hci_connection->att_server.notification_aggregation_multiple_supported = supported;
+    return ERROR_CODE_SUCCESS;
+}
+
+uint8_t att_server_get_notification_stats(hci_con_handle_t con_handle, att_server_notification_stats_t * stats){
+    hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
+    if (hci_connection == NULL) return ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER;
+    *stats = hci_connection->att_server.notification_aggregation_stats;
+    return ERROR_CODE_SUCCESS;
+}
+#endif
+
 uint8_t att_server_indicate(hci_con_handle_t con_handle, uint16_t attribute_handle, const uint8_t *value, uint16_t value_len){
 
     att_server_t * att_server = NULL;
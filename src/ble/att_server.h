@@ -142,6 +142,38 @@ uint8_t att_server_notify(hci_con_handle_t con_handle, uint16_t attribute_handle
 uint8_t att_server_multiple_notify(hci_con_handle_t con_handle, uint8_t num_attributes,
                                    const uint16_t * attribute_handles, const uint8_t ** values_data, const uint16_t * values_len);
 
+#ifdef ENABLE_ATT_SERVER_NOTIFICATION_AGGREGATION
+/**
+ * @brief queue notification for attribute value change. Notifications queued while the current run loop iteration
+ * is processed and while the connection cannot send are collected and sent together: as Multiple Handle Value
+ * Notifications if supported by the client, or as back-to-back Handle Value Notifications otherwise.
+ * A queued value is replaced if the same attribute is notified again before it was sent.
+ * @param con_handle
+ * @param attribute_handle
+ * @param value
+ * @param value_len
+ * @return 0 if ok, ERROR_CODE_MEMORY_CAPACITY_EXCEEDED if queue is full, error otherwise
+ */
+uint8_t att_server_notify_aggregated(hci_con_handle_t con_handle, uint16_t attribute_handle, const uint8_t *value, uint16_t value_len);
+
+/**
+ * @brief Allow to use ATT Multiple Handle Value Notifications for aggregated notifications.
+ * @note Only enable if the client has set the 'Multiple Handle Value Notifications' bit in its Client Supported Features
+ * @param con_handle
+ * @param supported
+ * @return 0 if ok, error otherwise
+ */
+uint8_t att_server_set_multiple_notifications_supported(hci_con_handle_t con_handle, bool supported);
+
+/**
+ * @brief Get statistics for aggregated notifications
+ * @param con_handle
+ * @param stats
+ * @return 0 if ok, error otherwise
+ */
+uint8_t att_server_get_notification_stats(hci_con_handle_t con_handle, att_server_notification_stats_t * stats);
+#endif
+
 /**
  * @brief indicate value change to client. client is supposed to reply with an indication_response
  * @param con_handle
@@ -2860,6 +2860,7 @@ uint8_t gatt_client_request_can_write_without_response_event(btstack_packet_hand
 
 #if defined(ENABLE_GATT_OVER_CLASSIC) || defined(ENABLE_GATT_OVER_EATT)
 
+#include "bluetooth_psm.h"
 #include "hci_event.h"
 
 static const hci_event_t gatt_client_connected = {
@@ -2881,8 +2882,6 @@ static void gatt_client_emit_connected(btstack_packet_handler_t callback, uint8_
 
 #ifdef ENABLE_GATT_OVER_CLASSIC
 
-#include "bluetooth_psm.h"
-
 // single active SDP query
 static gatt_client_t * gatt_client_classic_active_sdp_query;
 
@@ -3163,7 +3162,7 @@ static void gatt_client_le_enhanced_handle_connected(gatt_client_t * gatt_client
         gatt_client->eatt_state = GATT_CLIENT_EATT_IDLE;
     }
 
-    gatt_client_emit_connected(gatt_client->callback, status,  gatt_client->addr, gatt_client->con_handle);
+    gatt_client_emit_connected(gatt_client->eatt_callback, status,  gatt_client->addr, gatt_client->con_handle);
 }
 
 // single channel disconnected
@@ -3185,7 +3184,7 @@ static void gatt_client_le_enhanced_handle_ecbm_disconnected(gatt_client_t * gat
             // report disconnected if last channel closed
             uint8_t buffer[20];
             uint16_t len = hci_event_create_from_template_and_arguments(buffer, sizeof(buffer), &gatt_client_disconnected, gatt_client->con_handle);
-            (*gatt_client->callback)(HCI_EVENT_PACKET, 0, buffer, len);
+            (*gatt_client->eatt_callback)(HCI_EVENT_PACKET, 0, buffer, len);
         }
     }
 }
@@ -3350,7 +3349,7 @@ static void gatt_client_le_enhanced_packet_handler(uint8_t packet_type, uint16_t
                     status = l2cap_event_channel_opened_get_status(packet);
                     if (status == ERROR_CODE_SUCCESS){
                         eatt_client->state = P_READY;
-                        eatt_client->mtu = l2cap_event_channel_opened_get_remote_mtu(packet);
+                        eatt_client->mtu = l2cap_event_ecbm_channel_opened_get_remote_mtu(packet);
                     } else {
                         eatt_client->state = P_L2CAP_CLOSED;
                     }
@@ -3472,7 +3471,7 @@ uint8_t gatt_client_le_enhanced_connect(btstack_packet_handler_t callback, hci_c
     hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
     hci_connection->att_server.eatt_outgoing_active = true;
 
-    gatt_client->callback = callback;
+    gatt_client->eatt_callback = callback;
     gatt_client->eatt_num_clients   = num_channels;
     gatt_client->eatt_storage_buffer = storage_buffer;
     gatt_client->eatt_storage_size   = storage_size;
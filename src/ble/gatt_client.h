@@ -190,15 +190,20 @@ typedef struct gatt_client{
 
     att_bearer_type_t bearer_type;
 
-#ifdef ENABLE_GATT_OVER_CLASSIC
+#if defined(ENABLE_GATT_OVER_CLASSIC) || defined(ENABLE_GATT_OVER_EATT)
     bd_addr_t addr;
-    uint16_t  l2cap_psm;
     uint16_t  l2cap_cid;
+#endif
+
+#ifdef ENABLE_GATT_OVER_CLASSIC
+    uint16_t  l2cap_psm;
     btstack_context_callback_registration_t callback_request;
 #endif
 
 #ifdef ENABLE_GATT_OVER_EATT
     gatt_client_eatt_state_t eatt_state;
+    // callback for GATT_EVENT_CONNECTED/DISCONNECTED, callback is used for EATT setup queries
+    btstack_packet_handler_t eatt_callback;
     btstack_linked_list_t eatt_clients;
     uint8_t * eatt_storage_buffer;
     uint16_t eatt_storage_size;
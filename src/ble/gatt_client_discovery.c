@@ -0,0 +1,721 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "gatt_client_discovery.c"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "btstack_config.h"
+
+#include "ble/gatt_client_discovery.h"
+#include "ble/gatt_client.h"
+#include "ble/le_device_db.h"
+#include "ble/sm.h"
+#include "bluetooth_gatt.h"
+#include "btstack_debug.h"
+#include "btstack_event.h"
+#include "btstack_tlv.h"
+#include "btstack_util.h"
+#include "hci_event.h"
+
+// cached database: header and tables for services, characteristics, and descriptors, split into chunks
+#define GATT_CLIENT_DISCOVERY_CACHE_CHUNK_SIZE           192
+#define GATT_CLIENT_DISCOVERY_CACHE_MAX_CHUNKS           256
+#define GATT_CLIENT_DISCOVERY_CACHE_TYPE_HEADER          'H'
+#define GATT_CLIENT_DISCOVERY_CACHE_TYPE_SERVICES        'S'
+#define GATT_CLIENT_DISCOVERY_CACHE_TYPE_CHARACTERISTICS 'C'
+#define GATT_CLIENT_DISCOVERY_CACHE_TYPE_DESCRIPTORS     'D'
+
+typedef struct {
+    // identity of bonded device
+    bd_addr_t identity_address;
+    uint8_t   identity_address_type;
+    uint8_t   database_hash[16];
+    // value handle of Service Changed characteristic or 0
+    uint16_t  service_changed_value_handle;
+    uint16_t  services_num;
+    uint16_t  characteristics_num;
+    uint16_t  descriptors_num;
+} gatt_client_discovery_cache_header_t;
+
+static btstack_linked_list_t gatt_client_discovery_contexts;
+
+static bool gatt_client_discovery_cache_enabled;
+static gatt_client_notification_t gatt_client_discovery_service_changed_listener;
+static btstack_packet_handler_t gatt_client_discovery_cache_callback;
+
+// Client Characteristic Configuration for Service Changed, not copied by GATT Client
+static uint8_t gatt_client_discovery_service_changed_configuration[] = { 0x02, 0x00 };
+
+static const hci_event_t gatt_client_discovery_complete = {
+    GATT_EVENT_DISCOVERY_COMPLETE, 0, "H12221"
+};
+
+static const hci_event_t gatt_client_discovery_database_changed = {
+    GATT_EVENT_DATABASE_CHANGED, 0, "H22"
+};
+
+static void gatt_client_discovery_run(gatt_client_discovery_t * context);
+static void gatt_client_discovery_handle_event(uint8_t request_index, uint8_t packet_type, uint8_t *packet, uint16_t size);
+
+// GATT Client events don't identify the bearer used for a query, use separate packet handler for each request slot
+static void gatt_client_discovery_handler_0(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    gatt_client_discovery_handle_event(0, packet_type, packet, size);
+}
+static void gatt_client_discovery_handler_1(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    gatt_client_discovery_handle_event(1, packet_type, packet, size);
+}
+static void gatt_client_discovery_handler_2(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    gatt_client_discovery_handle_event(2, packet_type, packet, size);
+}
+static void gatt_client_discovery_handler_3(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    gatt_client_discovery_handle_event(3, packet_type, packet, size);
+}
+static void gatt_client_discovery_handler_4(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    gatt_client_discovery_handle_event(4, packet_type, packet, size);
+}
+
+static const btstack_packet_handler_t gatt_client_discovery_handlers[] = {
+    &gatt_client_discovery_handler_0,
+    &gatt_client_discovery_handler_1,
+    &gatt_client_discovery_handler_2,
+    &gatt_client_discovery_handler_3,
+    &gatt_client_discovery_handler_4,
+};
+
+void gatt_client_database_init(gatt_client_database_t * database,
+                               gatt_client_service_t * services, uint16_t services_max,
+                               gatt_client_characteristic_t * characteristics, uint16_t characteristics_max,
+                               gatt_client_characteristic_descriptor_t * descriptors, uint16_t descriptors_max){
+    memset(database, 0, sizeof(gatt_client_database_t));
+    database->services = services;
+    database->services_max = services_max;
+    database->characteristics = characteristics;
+    database->characteristics_max = characteristics_max;
+    database->descriptors = descriptors;
+    database->descriptors_max = descriptors_max;
+}
+
+const gatt_client_characteristic_t * gatt_client_database_get_characteristics_for_service(const gatt_client_database_t * database,
+        const gatt_client_service_t * service, uint16_t * out_num_characteristics){
+    // find first characteristic within service
+    uint16_t low  = 0;
+    uint16_t high = database->characteristics_num;
+    while (low < high){
+        uint16_t mid = (low + high) / 2u;
+        if (database->characteristics[mid].start_handle < service->start_group_handle){
+            low = mid + 1u;
+        } else {
+            high = mid;
+        }
+    }
+    uint16_t num_characteristics = 0;
+    while (((low + num_characteristics) < database->characteristics_num) &&
+           (database->characteristics[low + num_characteristics].start_handle <= service->end_group_handle)){
+        num_characteristics++;
+    }
+    *out_num_characteristics = num_characteristics;
+    return &database->characteristics[low];
+}
+
+const gatt_client_characteristic_descriptor_t * gatt_client_database_get_descriptors_for_characteristic(const gatt_client_database_t * database,
+        const gatt_client_characteristic_t * characteristic, uint16_t * out_num_descriptors){
+    // find first descriptor after characteristic value
+    uint16_t low  = 0;
+    uint16_t high = database->descriptors_num;
+    while (low < high){
+        uint16_t mid = (low + high) / 2u;
+        if (database->descriptors[mid].handle <= characteristic->value_handle){
+            low = mid + 1u;
+        } else {
+            high = mid;
+        }
+    }
+    uint16_t num_descriptors = 0;
+    while (((low + num_descriptors) < database->descriptors_num) &&
+           (database->descriptors[low + num_descriptors].handle <= characteristic->end_handle)){
+        num_descriptors++;
+    }
+    *out_num_descriptors = num_descriptors;
+    return &database->descriptors[low];
+}
+
+// ---------------------
+// cache for bonded devices
+static uint32_t gatt_client_discovery_cache_tag(char type, uint16_t chunk, int le_device_db_index){
+    return ('G' << 24u) | (((uint32_t) type) << 16u) | (((uint32_t) chunk) << 8u) | (uint8_t) le_device_db_index;
+}
+
+static const btstack_tlv_t * gatt_client_discovery_cache_tlv(void ** tlv_context){
+    const btstack_tlv_t * tlv_impl = NULL;
+    btstack_tlv_get_instance(&tlv_impl, tlv_context);
+    return tlv_impl;
+}
+
+static bool gatt_client_discovery_cache_get(int le_device_db_index, char type, void * data, uint32_t size){
+    void * tlv_context;
+    const btstack_tlv_t * tlv_impl = gatt_client_discovery_cache_tlv(&tlv_context);
+    if (tlv_impl == NULL) return false;
+    uint8_t * buffer = (uint8_t *) data;
+    uint16_t chunk = 0;
+    uint32_t offset = 0;
+    while (offset < size){
+        uint32_t chunk_size = btstack_min(size - offset, GATT_CLIENT_DISCOVERY_CACHE_CHUNK_SIZE);
+        uint32_t tag = gatt_client_discovery_cache_tag(type, chunk, le_device_db_index);
+        int len = tlv_impl->get_tag(tlv_context, tag, &buffer[offset], chunk_size);
+        if (len != (int) chunk_size) return false;
+        offset += chunk_size;
+        chunk++;
+    }
+    return true;
+}
+
+static bool gatt_client_discovery_cache_store(int le_device_db_index, char type, const void * data, uint32_t size){
+    void * tlv_context;
+    const btstack_tlv_t * tlv_impl = gatt_client_discovery_cache_tlv(&tlv_context);
+    if (tlv_impl == NULL) return false;
+    if (size > (GATT_CLIENT_DISCOVERY_CACHE_MAX_CHUNKS * GATT_CLIENT_DISCOVERY_CACHE_CHUNK_SIZE)) return false;
+    const uint8_t * buffer = (const uint8_t *) data;
+    uint16_t chunk = 0;
+    uint32_t offset = 0;
+    while (offset < size){
+        uint32_t chunk_size = btstack_min(size - offset, GATT_CLIENT_DISCOVERY_CACHE_CHUNK_SIZE);
+        uint32_t tag = gatt_client_discovery_cache_tag(type, chunk, le_device_db_index);
+        if (tlv_impl->store_tag(tlv_context, tag, &buffer[offset], chunk_size) != 0) return false;
+        offset += chunk_size;
+        chunk++;
+    }
+    return true;
+}
+
+void gatt_client_discovery_cache_delete(int le_device_db_index){
+    void * tlv_context;
+    const btstack_tlv_t * tlv_impl = gatt_client_discovery_cache_tlv(&tlv_context);
+    if (tlv_impl == NULL) return;
+    log_info("GATT Client Discovery, delete cache for le device db index %d", le_device_db_index);
+    // delete header first
+    static const char types[] = {
+        GATT_CLIENT_DISCOVERY_CACHE_TYPE_HEADER,
+        GATT_CLIENT_DISCOVERY_CACHE_TYPE_SERVICES,
+        GATT_CLIENT_DISCOVERY_CACHE_TYPE_CHARACTERISTICS,
+        GATT_CLIENT_DISCOVERY_CACHE_TYPE_DESCRIPTORS,
+    };
+    uint8_t i;
+    for (i = 0; i < sizeof(types); i++){
+        uint16_t chunk;
+        for (chunk = 0; chunk < GATT_CLIENT_DISCOVERY_CACHE_MAX_CHUNKS; chunk++){
+            uint32_t tag = gatt_client_discovery_cache_tag(types[i], chunk, le_device_db_index);
+            if (tlv_impl->get_tag(tlv_context, tag, NULL, 0) <= 0) break;
+            tlv_impl->delete_tag(tlv_context, tag);
+        }
+    }
+}
+
+// header is only valid if stored for the current bonding of this le device db entry
+static bool gatt_client_discovery_cache_get_header(int le_device_db_index, gatt_client_discovery_cache_header_t * header){
+    if (gatt_client_discovery_cache_get(le_device_db_index, GATT_CLIENT_DISCOVERY_CACHE_TYPE_HEADER, header, sizeof(gatt_client_discovery_cache_header_t)) == false){
+        return false;
+    }
+    int identity_address_type = BD_ADDR_TYPE_UNKNOWN;
+    bd_addr_t identity_address;
+    le_device_db_info(le_device_db_index, &identity_address_type, identity_address, NULL);
+    if (identity_address_type != (int) header->identity_address_type) return false;
+    return bd_addr_cmp(identity_address, header->identity_address) == 0;
+}
+
+static bool gatt_client_discovery_cache_load(gatt_client_discovery_t * context){
+    gatt_client_discovery_cache_header_t header;
+    if (gatt_client_discovery_cache_get_header(context->le_device_db_index, &header) == false) return false;
+    if (memcmp(header.database_hash, context->database_hash, 16) != 0) {
+        log_info("GATT Client Discovery, database hash changed");
+        return false;
+    }
+
+    gatt_client_database_t * database = context->database;
+    if (header.services_num        > database->services_max)        return false;
+    if (header.characteristics_num > database->characteristics_max) return false;
+    if (header.descriptors_num     > database->descriptors_max)     return false;
+
+    bool ok = gatt_client_discovery_cache_get(context->le_device_db_index, GATT_CLIENT_DISCOVERY_CACHE_TYPE_SERVICES,
+                                              database->services, header.services_num * sizeof(gatt_client_service_t));
+    ok = ok && gatt_client_discovery_cache_get(context->le_device_db_index, GATT_CLIENT_DISCOVERY_CACHE_TYPE_CHARACTERISTICS,
+                                               database->characteristics, header.characteristics_num * sizeof(gatt_client_characteristic_t));
+    ok = ok && gatt_client_discovery_cache_get(context->le_device_db_index, GATT_CLIENT_DISCOVERY_CACHE_TYPE_DESCRIPTORS,
+                                               database->descriptors, header.descriptors_num * sizeof(gatt_client_characteristic_descriptor_t));
+    if (ok == false) return false;
+
+    database->services_num        = header.services_num;
+    database->characteristics_num = header.characteristics_num;
+    database->descriptors_num     = header.descriptors_num;
+    return true;
+}
+
+static void gatt_client_discovery_cache_store_database(const gatt_client_discovery_t * context){
+    const gatt_client_database_t * database = context->database;
+    gatt_client_discovery_cache_header_t header;
+    memset(&header, 0, sizeof(header));
+    int identity_address_type = BD_ADDR_TYPE_UNKNOWN;
+    le_device_db_info(context->le_device_db_index, &identity_address_type, header.identity_address, NULL);
+    header.identity_address_type = (uint8_t) identity_address_type;
+    (void)memcpy(header.database_hash, context->database_hash, 16);
+    header.services_num        = database->services_num;
+    header.characteristics_num = database->characteristics_num;
+    header.descriptors_num     = database->descriptors_num;
+    uint16_t i;
+    for (i = 0; i < database->characteristics_num; i++){
+        if (database->characteristics[i].uuid16 == ORG_BLUETOOTH_CHARACTERISTIC_GATT_SERVICE_CHANGED){
+            header.service_changed_value_handle = database->characteristics[i].value_handle;
+            break;
+        }
+    }
+
+    // invalidate header first, so that an interrupted update is not used
+    gatt_client_discovery_cache_delete(context->le_device_db_index);
+    bool ok = gatt_client_discovery_cache_store(context->le_device_db_index, GATT_CLIENT_DISCOVERY_CACHE_TYPE_SERVICES,
+                                                database->services, database->services_num * sizeof(gatt_client_service_t));
+    ok = ok && gatt_client_discovery_cache_store(context->le_device_db_index, GATT_CLIENT_DISCOVERY_CACHE_TYPE_CHARACTERISTICS,
+                                                 database->characteristics, database->characteristics_num * sizeof(gatt_client_characteristic_t));
+    ok = ok && gatt_client_discovery_cache_store(context->le_device_db_index, GATT_CLIENT_DISCOVERY_CACHE_TYPE_DESCRIPTORS,
+                                                 database->descriptors, database->descriptors_num * sizeof(gatt_client_characteristic_descriptor_t));
+    ok = ok && gatt_client_discovery_cache_store(context->le_device_db_index, GATT_CLIENT_DISCOVERY_CACHE_TYPE_HEADER,
+                                                 &header, sizeof(header));
+    if (ok == false){
+        log_error("GATT Client Discovery, storing cache for le device db index %d failed", context->le_device_db_index);
+        gatt_client_discovery_cache_delete(context->le_device_db_index);
+    }
+}
+
+static void gatt_client_discovery_handle_service_changed(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    if (hci_event_packet_get_type(packet) != GATT_EVENT_INDICATION) return;
+
+    hci_con_handle_t con_handle = gatt_event_indication_get_handle(packet);
+    int le_device_db_index = sm_le_device_index(con_handle);
+    if (le_device_db_index < 0) return;
+
+    gatt_client_discovery_cache_header_t header;
+    if (gatt_client_discovery_cache_get_header(le_device_db_index, &header) == false) return;
+    if (header.service_changed_value_handle == 0u) return;
+    if (header.service_changed_value_handle != gatt_event_indication_get_value_handle(packet)) return;
+    log_info("GATT Client Discovery, service changed");
+    gatt_client_discovery_cache_delete(le_device_db_index);
+
+    // affected attribute handle range, complete database if not provided
+    uint16_t start_handle = 0x0001;
+    uint16_t end_handle   = 0xffff;
+    if (gatt_event_indication_get_value_length(packet) >= 4u){
+        const uint8_t * value = gatt_event_indication_get_value(packet);
+        start_handle = little_endian_read_16(value, 0);
+        end_handle   = little_endian_read_16(value, 2);
+    }
+    if (gatt_client_discovery_cache_callback == NULL) return;
+    uint8_t event[8];
+    uint16_t len = hci_event_create_from_template_and_arguments(event, sizeof(event), &gatt_client_discovery_database_changed,
+                                                                con_handle, start_handle, end_handle);
+    (*gatt_client_discovery_cache_callback)(HCI_EVENT_PACKET, 0, event, len);
+}
+
+void gatt_client_discovery_enable_cache(btstack_packet_handler_t callback){
+    gatt_client_discovery_cache_callback = callback;
+    if (gatt_client_discovery_cache_enabled) return;
+    gatt_client_discovery_cache_enabled = true;
+    gatt_client_listen_for_characteristic_value_updates(&gatt_client_discovery_service_changed_listener,
+                                                        &gatt_client_discovery_handle_service_changed,
+                                                        GATT_CLIENT_ANY_CONNECTION, NULL);
+}
+
+// cache for bonded devices
+// ---------------------
+
+static gatt_client_discovery_t * gatt_client_discovery_for_con_handle(hci_con_handle_t con_handle){
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &gatt_client_discovery_contexts);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        gatt_client_discovery_t * context = (gatt_client_discovery_t *) btstack_linked_list_iterator_next(&it);
+        if (context->con_handle == con_handle){
+            return context;
+        }
+    }
+    return NULL;
+}
+
+// results of parallel queries are stored in order of arrival, sort by handle
+static void gatt_client_discovery_sort_database(gatt_client_database_t * database){
+    uint16_t i;
+    for (i = 1; i < database->characteristics_num; i++){
+        gatt_client_characteristic_t characteristic = database->characteristics[i];
+        uint16_t j = i;
+        while ((j > 0u) && (database->characteristics[j-1u].start_handle > characteristic.start_handle)){
+            database->characteristics[j] = database->characteristics[j-1u];
+            j--;
+        }
+        database->characteristics[j] = characteristic;
+    }
+    for (i = 1; i < database->descriptors_num; i++){
+        gatt_client_characteristic_descriptor_t descriptor = database->descriptors[i];
+        uint16_t j = i;
+        while ((j > 0u) && (database->descriptors[j-1u].handle > descriptor.handle)){
+            database->descriptors[j] = database->descriptors[j-1u];
+            j--;
+        }
+        database->descriptors[j] = descriptor;
+    }
+}
+
+static void gatt_client_discovery_emit_complete(gatt_client_discovery_t * context){
+    gatt_client_database_t * database = context->database;
+    uint8_t event[12];
+    uint16_t len = hci_event_create_from_template_and_arguments(event, sizeof(event), &gatt_client_discovery_complete,
+                                                                context->con_handle, context->att_status,
+                                                                database->services_num, database->characteristics_num,
+                                                                database->descriptors_num, (uint8_t) context->from_cache);
+    (*context->callback)(HCI_EVENT_PACKET, 0, event, len);
+}
+
+static void gatt_client_discovery_done(gatt_client_discovery_t * context){
+    btstack_linked_list_remove(&gatt_client_discovery_contexts, (btstack_linked_item_t *) context);
+    context->state = GATT_CLIENT_DISCOVERY_STATE_IDLE;
+    gatt_client_discovery_emit_complete(context);
+}
+
+// @return true if write of Service Changed CCCD was started
+static bool gatt_client_discovery_enable_service_changed(gatt_client_discovery_t * context){
+    const gatt_client_database_t * database = context->database;
+    uint16_t cccd_handle = 0;
+    uint16_t i;
+    for (i = 0; i < database->characteristics_num; i++){
+        const gatt_client_characteristic_t * characteristic = &database->characteristics[i];
+        if (characteristic->uuid16 != ORG_BLUETOOTH_CHARACTERISTIC_GATT_SERVICE_CHANGED) continue;
+        uint16_t num_descriptors;
+        const gatt_client_characteristic_descriptor_t * descriptors =
+                gatt_client_database_get_descriptors_for_characteristic(database, characteristic, &num_descriptors);
+        uint16_t j;
+        for (j = 0; j < num_descriptors; j++){
+            if (descriptors[j].uuid16 == ORG_BLUETOOTH_DESCRIPTOR_GATT_CLIENT_CHARACTERISTIC_CONFIGURATION){
+                cccd_handle = descriptors[j].handle;
+                break;
+            }
+        }
+        break;
+    }
+    if (cccd_handle == 0u) return false;
+
+    // write might complete before gatt_client_write_characteristic_descriptor_using_descriptor_handle returns
+    context->requests[0].type = GATT_CLIENT_DISCOVERY_REQUEST_SERVICE_CHANGED_CCCD;
+    context->num_requests_active = 1;
+    context->state = GATT_CLIENT_DISCOVERY_STATE_W4_SERVICE_CHANGED_CCCD;
+    uint8_t status = gatt_client_write_characteristic_descriptor_using_descriptor_handle(gatt_client_discovery_handlers[0], context->con_handle, cccd_handle,
+                                                                                         sizeof(gatt_client_discovery_service_changed_configuration),
+                                                                                         gatt_client_discovery_service_changed_configuration);
+    if (status != ERROR_CODE_SUCCESS){
+        log_info("GATT Client Discovery, enable Service Changed failed with status 0x%02x", status);
+        context->requests[0].type = GATT_CLIENT_DISCOVERY_REQUEST_IDLE;
+        context->num_requests_active = 0;
+        return false;
+    }
+    return true;
+}
+
+static void gatt_client_discovery_finalize(gatt_client_discovery_t * context){
+    if (context->from_cache == false){
+        gatt_client_discovery_sort_database(context->database);
+        // only a database with hash can be validated on reconnect
+        if ((context->att_status == ATT_ERROR_SUCCESS) && (context->le_device_db_index >= 0) && context->database_hash_valid){
+            gatt_client_discovery_cache_store_database(context);
+        }
+    }
+    // cached database is used, get notified about changes
+    if ((context->att_status == ATT_ERROR_SUCCESS) && (context->le_device_db_index >= 0) && context->database_hash_valid){
+        if (gatt_client_discovery_enable_service_changed(context)) return;
+    }
+    gatt_client_discovery_done(context);
+}
+
+static void gatt_client_discovery_handle_query_request(void * context){
+    gatt_client_discovery_run((gatt_client_discovery_t *) context);
+}
+
+static bool gatt_client_discovery_next_request(gatt_client_discovery_t * context, gatt_client_discovery_request_t * request){
+    gatt_client_database_t * database = context->database;
+    if (context->next_service_index < database->services_num){
+        request->type  = GATT_CLIENT_DISCOVERY_REQUEST_CHARACTERISTICS;
+        request->index = context->next_service_index;
+        return true;
+    }
+    while (context->next_characteristic_index < database->characteristics_num){
+        const gatt_client_characteristic_t * characteristic = &database->characteristics[context->next_characteristic_index];
+        // skip characteristics without space for descriptors
+        if (characteristic->end_handle > characteristic->value_handle){
+            request->type  = GATT_CLIENT_DISCOVERY_REQUEST_DESCRIPTORS;
+            request->index = context->next_characteristic_index;
+            return true;
+        }
+        context->next_characteristic_index++;
+    }
+    return false;
+}
+
+static uint8_t gatt_client_discovery_send_request(gatt_client_discovery_t * context, uint8_t request_index){
+    gatt_client_discovery_request_t * request = &context->requests[request_index];
+    btstack_packet_handler_t handler = gatt_client_discovery_handlers[request_index];
+    gatt_client_database_t * database = context->database;
+    switch (request->type){
+        case GATT_CLIENT_DISCOVERY_REQUEST_DATABASE_HASH:
+            return gatt_client_read_value_of_characteristics_by_uuid16(handler, context->con_handle, 0x0001, 0xffff,
+                                                                       ORG_BLUETOOTH_CHARACTERISTIC_DATABASE_HASH);
+        case GATT_CLIENT_DISCOVERY_REQUEST_SERVICES:
+            return gatt_client_discover_primary_services(handler, context->con_handle);
+        case GATT_CLIENT_DISCOVERY_REQUEST_CHARACTERISTICS:
+            return gatt_client_discover_characteristics_for_service(handler, context->con_handle, &database->services[request->index]);
+        case GATT_CLIENT_DISCOVERY_REQUEST_DESCRIPTORS:
+            return gatt_client_discover_characteristic_descriptors(handler, context->con_handle, &database->characteristics[request->index]);
+        default:
+            btstack_unreachable();
+            return ERROR_CODE_COMMAND_DISALLOWED;
+    }
+}
+
+static void gatt_client_discovery_run(gatt_client_discovery_t * context){
+    // with a synchronous peer, queries can complete before they have been started
+    if (context->run_active){
+        context->run_pending = true;
+        return;
+    }
+    context->run_active = true;
+
+    do {
+        context->run_pending = false;
+
+        // fill free request slots, stop on error
+        uint8_t request_index;
+        for (request_index = 0; request_index < GATT_CLIENT_DISCOVERY_MAX_REQUESTS; request_index++){
+            if (context->att_status != ATT_ERROR_SUCCESS) break;
+            if (context->state != GATT_CLIENT_DISCOVERY_STATE_W4_CHARACTERISTICS_AND_DESCRIPTORS) break;
+
+            gatt_client_discovery_request_t * request = &context->requests[request_index];
+            if (request->type != GATT_CLIENT_DISCOVERY_REQUEST_IDLE) continue;
+            if (gatt_client_discovery_next_request(context, request) == false) break;
+
+            // query might complete before gatt_client_discovery_send_request returns
+            gatt_client_discovery_request_type_t request_type = request->type;
+            context->num_requests_active++;
+            uint8_t status = gatt_client_discovery_send_request(context, request_index);
+            if (status == ERROR_CODE_SUCCESS){
+                if (request_type == GATT_CLIENT_DISCOVERY_REQUEST_CHARACTERISTICS){
+                    context->next_service_index++;
+                } else {
+                    context->next_characteristic_index++;
+                }
+                continue;
+            }
+
+            request->type = GATT_CLIENT_DISCOVERY_REQUEST_IDLE;
+            context->num_requests_active--;
+            if ((status == ERROR_CODE_COMMAND_DISALLOWED) || (status == GATT_CLIENT_IN_WRONG_STATE)){
+                // all bearers busy, retry when one of our queries completes or GATT Client is ready
+                if (context->num_requests_active == 0u){
+                    context->query_request.callback = &gatt_client_discovery_handle_query_request;
+                    context->query_request.context  = context;
+                    (void) gatt_client_request_to_send_gatt_query(&context->query_request, context->con_handle);
+                }
+            } else {
+                log_error("GATT Client Discovery, request failed with status 0x%02x", status);
+                context->att_status = ATT_ERROR_UNLIKELY_ERROR;
+            }
+            break;
+        }
+    } while (context->run_pending);
+
+    context->run_active = false;
+
+    // done if all queries have completed and no further queries are needed
+    if (context->num_requests_active > 0u) return;
+    if (context->state == GATT_CLIENT_DISCOVERY_STATE_W4_DATABASE_HASH) return;
+    if (context->state == GATT_CLIENT_DISCOVERY_STATE_W4_SERVICES) return;
+    if (context->att_status == ATT_ERROR_SUCCESS){
+        gatt_client_discovery_request_t request;
+        if (gatt_client_discovery_next_request(context, &request)) return;
+    }
+    gatt_client_discovery_finalize(context);
+}
+
+static uint8_t gatt_client_discovery_start_services(gatt_client_discovery_t * context){
+    // services are discovered first with a single query
+    context->requests[0].type = GATT_CLIENT_DISCOVERY_REQUEST_SERVICES;
+    context->num_requests_active = 1;
+    context->state = GATT_CLIENT_DISCOVERY_STATE_W4_SERVICES;
+    uint8_t status = gatt_client_discovery_send_request(context, 0);
+    if (status != ERROR_CODE_SUCCESS){
+        context->requests[0].type = GATT_CLIENT_DISCOVERY_REQUEST_IDLE;
+        context->num_requests_active = 0;
+    }
+    return status;
+}
+
+static void gatt_client_discovery_handle_database_hash(gatt_client_discovery_t * context){
+    if (context->database_hash_valid && gatt_client_discovery_cache_load(context)){
+        log_info("GATT Client Discovery, use cached database");
+        context->from_cache = true;
+        gatt_client_discovery_finalize(context);
+        return;
+    }
+    uint8_t status = gatt_client_discovery_start_services(context);
+    if (status != ERROR_CODE_SUCCESS){
+        log_error("GATT Client Discovery, service discovery failed with status 0x%02x", status);
+        context->att_status = ATT_ERROR_UNLIKELY_ERROR;
+        gatt_client_discovery_finalize(context);
+    }
+}
+
+static void gatt_client_discovery_handle_event(uint8_t request_index, uint8_t packet_type, uint8_t *packet, uint16_t size){
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+
+    // all GATT Client query events start with the connection handle
+    hci_con_handle_t con_handle = little_endian_read_16(packet, 2);
+    gatt_client_discovery_t * context = gatt_client_discovery_for_con_handle(con_handle);
+    if (context == NULL) return;
+
+    gatt_client_discovery_request_t * request = &context->requests[request_index];
+    gatt_client_database_t * database = context->database;
+    uint8_t att_status;
+
+    switch (hci_event_packet_get_type(packet)){
+        case GATT_EVENT_CHARACTERISTIC_VALUE_QUERY_RESULT:
+            if (gatt_event_characteristic_value_query_result_get_value_length(packet) == 16u){
+                (void)memcpy(context->database_hash, gatt_event_characteristic_value_query_result_get_value(packet), 16);
+                context->database_hash_valid = true;
+            }
+            break;
+        case GATT_EVENT_SERVICE_QUERY_RESULT:
+            if (database->services_num < database->services_max){
+                gatt_event_service_query_result_get_service(packet, &database->services[database->services_num++]);
+            } else {
+                context->att_status = ATT_ERROR_INSUFFICIENT_RESOURCES;
+            }
+            break;
+        case GATT_EVENT_CHARACTERISTIC_QUERY_RESULT:
+            if (database->characteristics_num < database->characteristics_max){
+                gatt_event_characteristic_query_result_get_characteristic(packet, &database->characteristics[database->characteristics_num++]);
+            } else {
+                context->att_status = ATT_ERROR_INSUFFICIENT_RESOURCES;
+            }
+            break;
+        case GATT_EVENT_ALL_CHARACTERISTIC_DESCRIPTORS_QUERY_RESULT:
+            if (database->descriptors_num < database->descriptors_max){
+                gatt_event_all_characteristic_descriptors_query_result_get_characteristic_descriptor(packet, &database->descriptors[database->descriptors_num++]);
+            } else {
+                context->att_status = ATT_ERROR_INSUFFICIENT_RESOURCES;
+            }
+            break;
+        case GATT_EVENT_QUERY_COMPLETE:
+            if (request->type == GATT_CLIENT_DISCOVERY_REQUEST_SERVICE_CHANGED_CCCD){
+                // database is complete, ignore error
+                request->type = GATT_CLIENT_DISCOVERY_REQUEST_IDLE;
+                context->num_requests_active--;
+                gatt_client_discovery_done(context);
+                break;
+            }
+            if (request->type == GATT_CLIENT_DISCOVERY_REQUEST_DATABASE_HASH){
+                // Database Hash is optional, ignore error
+                request->type = GATT_CLIENT_DISCOVERY_REQUEST_IDLE;
+                context->num_requests_active--;
+                gatt_client_discovery_handle_database_hash(context);
+                break;
+            }
+            att_status = gatt_event_query_complete_get_att_status(packet);
+            if ((att_status != ATT_ERROR_SUCCESS) && (context->att_status == ATT_ERROR_SUCCESS)){
+                context->att_status = att_status;
+            }
+            if (request->type == GATT_CLIENT_DISCOVERY_REQUEST_SERVICES){
+                context->state = GATT_CLIENT_DISCOVERY_STATE_W4_CHARACTERISTICS_AND_DESCRIPTORS;
+            }
+            request->type = GATT_CLIENT_DISCOVERY_REQUEST_IDLE;
+            btstack_assert(context->num_requests_active > 0u);
+            context->num_requests_active--;
+            gatt_client_discovery_run(context);
+            break;
+        default:
+            break;
+    }
+}
+
+uint8_t gatt_client_discovery_start(gatt_client_discovery_t * context, btstack_packet_handler_t callback,
+                                    hci_con_handle_t con_handle, gatt_client_database_t * database){
+    if (gatt_client_discovery_for_con_handle(con_handle) != NULL){
+        return ERROR_CODE_COMMAND_DISALLOWED;
+    }
+
+    memset(context, 0, sizeof(gatt_client_discovery_t));
+    context->con_handle = con_handle;
+    context->callback = callback;
+    context->database = database;
+    context->att_status = ATT_ERROR_SUCCESS;
+    context->le_device_db_index = -1;
+    database->services_num = 0;
+    database->characteristics_num = 0;
+    database->descriptors_num = 0;
+    btstack_linked_list_add(&gatt_client_discovery_contexts, (btstack_linked_item_t *) context);
+
+    uint8_t status;
+    void * tlv_context;
+    if (gatt_client_discovery_cache_enabled && (gatt_client_discovery_cache_tlv(&tlv_context) != NULL)){
+        context->le_device_db_index = sm_le_device_index(con_handle);
+    }
+    if (context->le_device_db_index >= 0){
+        // read Database Hash to validate cache
+        context->requests[0].type = GATT_CLIENT_DISCOVERY_REQUEST_DATABASE_HASH;
+        context->num_requests_active = 1;
+        context->state = GATT_CLIENT_DISCOVERY_STATE_W4_DATABASE_HASH;
+        status = gatt_client_discovery_send_request(context, 0);
+    } else {
+        status = gatt_client_discovery_start_services(context);
+    }
+    if (status != ERROR_CODE_SUCCESS){
+        btstack_linked_list_remove(&gatt_client_discovery_contexts, (btstack_linked_item_t *) context);
+        context->state = GATT_CLIENT_DISCOVERY_STATE_IDLE;
+    }
+    return status;
+}
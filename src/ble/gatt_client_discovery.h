@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+/**
+ * @title GATT Client Discovery
+ *
+ * Discovers all primary services, characteristics, and characteristic descriptors of a remote GATT Server
+ * and stores them in an in-memory database model provided by the application.
+ *
+ * After the primary services have been found, characteristic and descriptor discovery for different services and
+ * characteristics is independent. If the GATT Client is connected via EATT (see gatt_client_le_enhanced_connect),
+ * up to GATT_CLIENT_DISCOVERY_MAX_REQUESTS queries are kept in flight on separate EATT bearers. Otherwise, queries
+ * are sent back-to-back on the ATT bearer.
+ *
+ * Descriptor discovery is skipped for characteristics without space for descriptors.
+ *
+ * With gatt_client_discovery_enable_cache, the discovered database of bonded devices is stored in btstack_tlv.
+ * On reconnect, the Database Hash characteristic is read and, if it matches the stored one, the database is loaded
+ * from the cache instead. When a cached database is stored or used, the Service Changed indication is enabled.
+ * A Service Changed indication from the remote invalidates its cache and GATT_EVENT_DATABASE_CHANGED is emitted,
+ * the application should then run the discovery again.
+ */
+
+#ifndef GATT_CLIENT_DISCOVERY_H
+#define GATT_CLIENT_DISCOVERY_H
+
+#include <stdint.h>
+
+#include "ble/gatt_client.h"
+#include "btstack_config.h"
+#include "btstack_defines.h"
+#include "btstack_linked_list.h"
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+// max number of parallel queries, limited by the number of EATT bearers
+#ifndef GATT_CLIENT_DISCOVERY_MAX_REQUESTS
+#define GATT_CLIENT_DISCOVERY_MAX_REQUESTS 5
+#endif
+
+#if GATT_CLIENT_DISCOVERY_MAX_REQUESTS > 5
+#error "GATT_CLIENT_DISCOVERY_MAX_REQUESTS must not be larger than 5"
+#endif
+
+typedef struct {
+    gatt_client_service_t * services;
+    uint16_t services_max;
+    uint16_t services_num;
+
+    gatt_client_characteristic_t * characteristics;
+    uint16_t characteristics_max;
+    uint16_t characteristics_num;
+
+    gatt_client_characteristic_descriptor_t * descriptors;
+    uint16_t descriptors_max;
+    uint16_t descriptors_num;
+} gatt_client_database_t;
+
+typedef enum {
+    GATT_CLIENT_DISCOVERY_REQUEST_IDLE,
+    GATT_CLIENT_DISCOVERY_REQUEST_DATABASE_HASH,
+    GATT_CLIENT_DISCOVERY_REQUEST_SERVICES,
+    GATT_CLIENT_DISCOVERY_REQUEST_CHARACTERISTICS,
+    GATT_CLIENT_DISCOVERY_REQUEST_DESCRIPTORS,
+    GATT_CLIENT_DISCOVERY_REQUEST_SERVICE_CHANGED_CCCD,
+} gatt_client_discovery_request_type_t;
+
+typedef enum {
+    GATT_CLIENT_DISCOVERY_STATE_IDLE,
+    GATT_CLIENT_DISCOVERY_STATE_W4_DATABASE_HASH,
+    GATT_CLIENT_DISCOVERY_STATE_W4_SERVICES,
+    GATT_CLIENT_DISCOVERY_STATE_W4_CHARACTERISTICS_AND_DESCRIPTORS,
+    GATT_CLIENT_DISCOVERY_STATE_W4_SERVICE_CHANGED_CCCD,
+} gatt_client_discovery_state_t;
+
+typedef struct {
+    gatt_client_discovery_request_type_t type;
+    // index of service or characteristic in database
+    uint16_t index;
+} gatt_client_discovery_request_t;
+
+typedef struct {
+    btstack_linked_item_t item;
+
+    hci_con_handle_t con_handle;
+    btstack_packet_handler_t callback;
+    gatt_client_database_t * database;
+
+    gatt_client_discovery_state_t state;
+    uint8_t att_status;
+
+    // cache for bonded device, le_device_db_index < 0 if not used
+    int le_device_db_index;
+    bool database_hash_valid;
+    uint8_t database_hash[16];
+    bool from_cache;
+
+    // next service for characteristic discovery
+    uint16_t next_service_index;
+    // next characteristic for descriptor discovery
+    uint16_t next_characteristic_index;
+
+    gatt_client_discovery_request_t requests[GATT_CLIENT_DISCOVERY_MAX_REQUESTS];
+    uint8_t num_requests_active;
+
+    // retry if GATT Client was busy with other queries
+    btstack_context_callback_registration_t query_request;
+
+    bool run_active;
+    bool run_pending;
+} gatt_client_discovery_t;
+
+/* API_START */
+
+/**
+ * @brief Init database model with storage for services, characteristics, and descriptors
+ * @param database
+ * @param services storage
+ * @param services_max number of services that can be stored
+ * @param characteristics storage
+ * @param characteristics_max number of characteristics that can be stored
+ * @param descriptors storage
+ * @param descriptors_max number of characteristic descriptors that can be stored
+ */
+void gatt_client_database_init(gatt_client_database_t * database,
+                               gatt_client_service_t * services, uint16_t services_max,
+                               gatt_client_characteristic_t * characteristics, uint16_t characteristics_max,
+                               gatt_client_characteristic_descriptor_t * descriptors, uint16_t descriptors_max);
+
+/**
+ * @brief Get characteristics of service after discovery completed
+ * @param database
+ * @param service
+ * @param out_num_characteristics
+ * @return first characteristic of service
+ */
+const gatt_client_characteristic_t * gatt_client_database_get_characteristics_for_service(const gatt_client_database_t * database,
+        const gatt_client_service_t * service, uint16_t * out_num_characteristics);
+
+/**
+ * @brief Get descriptors of characteristic after discovery completed
+ * @param database
+ * @param characteristic
+ * @param out_num_descriptors
+ * @return first descriptor of characteristic
+ */
+const gatt_client_characteristic_descriptor_t * gatt_client_database_get_descriptors_for_characteristic(const gatt_client_database_t * database,
+        const gatt_client_characteristic_t * characteristic, uint16_t * out_num_descriptors);
+
+/**
+ * @brief Enable cache of discovered databases for bonded devices in btstack_tlv
+ * @note The cache is only used if the remote GATT Server provides the Database Hash characteristic
+ * @param callback for GATT_EVENT_DATABASE_CHANGED, emitted when a Service Changed indication invalidated the cache
+ */
+void gatt_client_discovery_enable_cache(btstack_packet_handler_t callback);
+
+/**
+ * @brief Delete cached database for bonded device
+ * @param le_device_db_index
+ */
+void gatt_client_discovery_cache_delete(int le_device_db_index);
+
+/**
+ * @brief Discover complete GATT database of remote GATT Server. GATT_EVENT_DISCOVERY_COMPLETE is emitted when done.
+ * @note If database storage is exhausted, no further queries are sent. After outstanding queries have completed,
+ *       GATT_EVENT_DISCOVERY_COMPLETE reports ATT_ERROR_INSUFFICIENT_RESOURCES with the entries stored so far
+ * @param context for discovery, must stay valid until GATT_EVENT_DISCOVERY_COMPLETE
+ * @param callback for GATT_EVENT_DISCOVERY_COMPLETE
+ * @param con_handle
+ * @param database initialized with gatt_client_database_init. Entries are sorted by handle
+ * @return status ERROR_CODE_SUCCESS if ok, ERROR_CODE_COMMAND_DISALLOWED if discovery is already active for this connection
+ */
+uint8_t gatt_client_discovery_start(gatt_client_discovery_t * context, btstack_packet_handler_t callback,
+                                    hci_con_handle_t con_handle, gatt_client_database_t * database);
+
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+
+#endif // GATT_CLIENT_DISCOVERY_H
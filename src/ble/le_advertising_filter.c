@@ -0,0 +1,396 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "le_advertising_filter.c"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ble/le_advertising_filter.h"
+
+#include "ad_parser.h"
+#include "bluetooth_data_types.h"
+#include "btstack_debug.h"
+#include "btstack_defines.h"
+#include "btstack_event.h"
+#include "btstack_run_loop.h"
+#include "btstack_util.h"
+#include "gap.h"
+
+#ifdef ENABLE_LE_CENTRAL
+
+// number of cache entries checked for a report
+#define LE_ADVERTISING_FILTER_CACHE_PROBES 4
+
+// rssi not available
+#define LE_ADVERTISING_FILTER_RSSI_NOT_AVAILABLE 127
+
+static const le_advertising_filter_address_t * le_advertising_filter_deny_list;
+static uint16_t                                le_advertising_filter_deny_list_len;
+static const le_advertising_filter_address_t * le_advertising_filter_allow_list;
+static uint16_t                                le_advertising_filter_allow_list_len;
+
+static int8_t   le_advertising_filter_rssi_threshold;
+
+// data filter
+static bool            le_advertising_filter_data_filter_active;
+static uint8_t         le_advertising_filter_ad_types[256 / 8];
+static const uint16_t * le_advertising_filter_uuid16s;
+static uint16_t         le_advertising_filter_uuid16s_len;
+static const uint8_t (*le_advertising_filter_uuid128s)[16];
+static uint16_t         le_advertising_filter_uuid128s_len;
+static const uint16_t * le_advertising_filter_company_ids;
+static uint16_t         le_advertising_filter_company_ids_len;
+
+// duplicate cache
+static le_advertising_filter_cache_entry_t * le_advertising_filter_cache;
+static uint16_t le_advertising_filter_cache_len;
+static uint32_t le_advertising_filter_cache_window_ms;
+
+static le_advertising_filter_stats_t le_advertising_filter_stats;
+
+// FNV-1a
+static uint32_t le_advertising_filter_hash(uint32_t hash, const uint8_t * data, uint16_t size){
+    uint16_t i;
+    for (i = 0; i < size; i++){
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool le_advertising_filter_address_list_contains(const le_advertising_filter_address_t * list, uint16_t list_len,
+                                                        const bd_addr_t address){
+    uint16_t i;
+    for (i = 0; i < list_len; i++){
+        if (memcmp(list[i].address, address, list[i].match_len) == 0){
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool le_advertising_filter_uuid16_matches(uint16_t uuid16){
+    uint16_t i;
+    for (i = 0; i < le_advertising_filter_uuid16s_len; i++){
+        if (le_advertising_filter_uuid16s[i] == uuid16){
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool le_advertising_filter_uuid128_matches(const uint8_t * uuid128_le){
+    uint8_t uuid128[16];
+    reverse_128(uuid128_le, uuid128);
+    uint16_t i;
+    for (i = 0; i < le_advertising_filter_uuid128s_len; i++){
+        if (memcmp(le_advertising_filter_uuid128s[i], uuid128, 16) == 0){
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool le_advertising_filter_company_id_matches(uint16_t company_id){
+    uint16_t i;
+    for (i = 0; i < le_advertising_filter_company_ids_len; i++){
+        if (le_advertising_filter_company_ids[i] == company_id){
+            return true;
+        }
+    }
+    return false;
+}
+
+// single pass over advertising data for all data criteria
+static bool le_advertising_filter_data_matches(uint8_t ad_len, const uint8_t * ad_data){
+    ad_context_t context;
+    for (ad_iterator_init(&context, ad_len, ad_data) ; ad_iterator_has_more(&context) ; ad_iterator_next(&context)){
+        uint8_t data_type    = ad_iterator_get_data_type(&context);
+        uint8_t data_len     = ad_iterator_get_data_len(&context);
+        const uint8_t * data = ad_iterator_get_data(&context);
+        if ((le_advertising_filter_ad_types[data_type >> 3] & (1u << (data_type & 7u))) != 0u){
+            return true;
+        }
+        uint8_t i;
+        switch (data_type){
+            case BLUETOOTH_DATA_TYPE_INCOMPLETE_LIST_OF_16_BIT_SERVICE_CLASS_UUIDS:
+            case BLUETOOTH_DATA_TYPE_COMPLETE_LIST_OF_16_BIT_SERVICE_CLASS_UUIDS:
+                for (i = 0u; (i + 2u) <= data_len; i += 2u){
+                    if (le_advertising_filter_uuid16_matches(little_endian_read_16(data, i))){
+                        return true;
+                    }
+                }
+                break;
+            case BLUETOOTH_DATA_TYPE_SERVICE_DATA_16_BIT_UUID:
+                if ((data_len >= 2u) && le_advertising_filter_uuid16_matches(little_endian_read_16(data, 0))){
+                    return true;
+                }
+                break;
+            case BLUETOOTH_DATA_TYPE_INCOMPLETE_LIST_OF_128_BIT_SERVICE_CLASS_UUIDS:
+            case BLUETOOTH_DATA_TYPE_COMPLETE_LIST_OF_128_BIT_SERVICE_CLASS_UUIDS:
+                for (i = 0u; (i + 16u) <= data_len; i += 16u){
+                    if (le_advertising_filter_uuid128_matches(&data[i])){
+                        return true;
+                    }
+                }
+                break;
+            case BLUETOOTH_DATA_TYPE_SERVICE_DATA_128_BIT_UUID:
+                if ((data_len >= 16u) && le_advertising_filter_uuid128_matches(data)){
+                    return true;
+                }
+                break;
+            case BLUETOOTH_DATA_TYPE_MANUFACTURER_SPECIFIC_DATA:
+                if ((data_len >= 2u) && le_advertising_filter_company_id_matches(little_endian_read_16(data, 0))){
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+// returns true if report with same address and data was delivered within duplicate window
+static bool le_advertising_filter_is_duplicate(uint8_t address_type, const bd_addr_t address, uint8_t event_type,
+                                               uint8_t ad_len, const uint8_t * ad_data){
+    uint32_t data_hash = le_advertising_filter_hash(2166136261u, &event_type, 1);
+    data_hash = le_advertising_filter_hash(data_hash, ad_data, ad_len);
+    uint32_t key = le_advertising_filter_hash(data_hash, &address_type, 1);
+    key = le_advertising_filter_hash(key, address, BD_ADDR_LEN);
+
+    uint32_t now_ms = btstack_run_loop_get_time_ms();
+    le_advertising_filter_cache_entry_t * free_entry = NULL;
+    le_advertising_filter_cache_entry_t * oldest_entry = NULL;
+    uint16_t index = (uint16_t) (key % le_advertising_filter_cache_len);
+    uint16_t i;
+    for (i = 0; (i < LE_ADVERTISING_FILTER_CACHE_PROBES) && (i < le_advertising_filter_cache_len); i++){
+        le_advertising_filter_cache_entry_t * entry = &le_advertising_filter_cache[index];
+        bool expired = (entry->in_use == false) ||
+                       ((now_ms - entry->timestamp_ms) >= le_advertising_filter_cache_window_ms);
+        if ((expired == false) && (entry->data_hash == data_hash) && (entry->address_type == address_type) &&
+            (memcmp(entry->address, address, BD_ADDR_LEN) == 0)){
+            return true;
+        }
+        if (expired){
+            if (free_entry == NULL){
+                free_entry = entry;
+            }
+        } else if ((oldest_entry == NULL) || ((now_ms - entry->timestamp_ms) > (now_ms - oldest_entry->timestamp_ms))){
+            oldest_entry = entry;
+        }
+        index++;
+        if (index == le_advertising_filter_cache_len){
+            index = 0;
+        }
+    }
+
+    // store delivered report, replace oldest entry if no free entry was found
+    le_advertising_filter_cache_entry_t * entry = (free_entry != NULL) ? free_entry : oldest_entry;
+    entry->in_use = true;
+    entry->address_type = address_type;
+    (void) memcpy(entry->address, address, BD_ADDR_LEN);
+    entry->data_hash = data_hash;
+    entry->timestamp_ms = now_ms;
+    return false;
+}
+
+static bool le_advertising_filter_report_matches(uint8_t event_type, uint8_t address_type, const bd_addr_t address,
+                                                 int8_t rssi, uint8_t ad_len, const uint8_t * ad_data, bool complete){
+    if (le_advertising_filter_address_list_contains(le_advertising_filter_deny_list, le_advertising_filter_deny_list_len, address)){
+        return false;
+    }
+    if ((le_advertising_filter_allow_list_len > 0u) &&
+        (le_advertising_filter_address_list_contains(le_advertising_filter_allow_list, le_advertising_filter_allow_list_len, address) == false)){
+        return false;
+    }
+    if ((rssi != LE_ADVERTISING_FILTER_RSSI_NOT_AVAILABLE) && (rssi < le_advertising_filter_rssi_threshold)){
+        return false;
+    }
+    // data criteria require complete advertising data
+    if (complete == false){
+        return true;
+    }
+    if (le_advertising_filter_data_filter_active && (le_advertising_filter_data_matches(ad_len, ad_data) == false)){
+        return false;
+    }
+    if ((le_advertising_filter_cache_len > 0u) &&
+        le_advertising_filter_is_duplicate(address_type, address, event_type, ad_len, ad_data)){
+        le_advertising_filter_stats.num_reports_duplicate++;
+        return false;
+    }
+    return true;
+}
+
+bool le_advertising_filter_process(const uint8_t * event, uint16_t size){
+    UNUSED(size);
+    bd_addr_t address;
+    bool deliver;
+    switch (hci_event_packet_get_type(event)){
+        case GAP_EVENT_ADVERTISING_REPORT:
+            gap_event_advertising_report_get_address(event, address);
+            deliver = le_advertising_filter_report_matches(gap_event_advertising_report_get_advertising_event_type(event),
+                                                           gap_event_advertising_report_get_address_type(event),
+                                                           address,
+                                                           (int8_t) gap_event_advertising_report_get_rssi(event),
+                                                           gap_event_advertising_report_get_data_length(event),
+                                                           gap_event_advertising_report_get_data(event),
+                                                           true);
+            break;
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+        case GAP_EVENT_EXTENDED_ADVERTISING_REPORT: {
+            uint16_t event_type = gap_event_extended_advertising_report_get_advertising_event_type(event);
+            // data status: complete
+            bool complete = (event_type & 0x60u) == 0u;
+            gap_event_extended_advertising_report_get_address(event, address);
+            deliver = le_advertising_filter_report_matches((uint8_t) event_type,
+                                                           gap_event_extended_advertising_report_get_address_type(event),
+                                                           address,
+                                                           (int8_t) gap_event_extended_advertising_report_get_rssi(event),
+                                                           gap_event_extended_advertising_report_get_data_length(event),
+                                                           gap_event_extended_advertising_report_get_data(event),
+                                                           complete);
+            break;
+        }
+#endif
+        default:
+            return true;
+    }
+    le_advertising_filter_stats.num_reports_seen++;
+    if (deliver){
+        le_advertising_filter_stats.num_reports_delivered++;
+    } else {
+        le_advertising_filter_stats.num_reports_filtered++;
+    }
+    return deliver;
+}
+
+static void le_advertising_filter_update_data_filter_active(void){
+    bool active = (le_advertising_filter_uuid16s_len > 0u) || (le_advertising_filter_uuid128s_len > 0u) ||
+                  (le_advertising_filter_company_ids_len > 0u);
+    uint16_t i;
+    for (i = 0; i < sizeof(le_advertising_filter_ad_types); i++){
+        if (le_advertising_filter_ad_types[i] != 0u){
+            active = true;
+        }
+    }
+    le_advertising_filter_data_filter_active = active;
+}
+
+void le_advertising_filter_init(void){
+    le_advertising_filter_deny_list_len = 0;
+    le_advertising_filter_allow_list_len = 0;
+    le_advertising_filter_rssi_threshold = -127;
+    le_advertising_filter_cache_len = 0;
+    le_advertising_filter_clear_data_filter();
+    le_advertising_filter_reset_stats();
+    gap_register_advertising_report_filter(&le_advertising_filter_process);
+}
+
+void le_advertising_filter_set_deny_list(const le_advertising_filter_address_t * addresses, uint16_t num_addresses){
+    le_advertising_filter_deny_list = addresses;
+    le_advertising_filter_deny_list_len = num_addresses;
+}
+
+void le_advertising_filter_set_allow_list(const le_advertising_filter_address_t * addresses, uint16_t num_addresses){
+    le_advertising_filter_allow_list = addresses;
+    le_advertising_filter_allow_list_len = num_addresses;
+}
+
+void le_advertising_filter_set_rssi_threshold(int8_t rssi_threshold){
+    le_advertising_filter_rssi_threshold = rssi_threshold;
+}
+
+void le_advertising_filter_add_ad_type(uint8_t ad_type){
+    le_advertising_filter_ad_types[ad_type >> 3] |= (uint8_t) (1u << (ad_type & 7u));
+    le_advertising_filter_data_filter_active = true;
+}
+
+void le_advertising_filter_set_uuid16_list(const uint16_t * uuid16s, uint16_t num_uuid16s){
+    le_advertising_filter_uuid16s = uuid16s;
+    le_advertising_filter_uuid16s_len = num_uuid16s;
+    le_advertising_filter_update_data_filter_active();
+}
+
+void le_advertising_filter_set_uuid128_list(const uint8_t (*uuid128s)[16], uint16_t num_uuid128s){
+    le_advertising_filter_uuid128s = uuid128s;
+    le_advertising_filter_uuid128s_len = num_uuid128s;
+    le_advertising_filter_update_data_filter_active();
+}
+
+void le_advertising_filter_set_company_id_list(const uint16_t * company_ids, uint16_t num_company_ids){
+    le_advertising_filter_company_ids = company_ids;
+    le_advertising_filter_company_ids_len = num_company_ids;
+    le_advertising_filter_update_data_filter_active();
+}
+
+void le_advertising_filter_clear_data_filter(void){
+    memset(le_advertising_filter_ad_types, 0, sizeof(le_advertising_filter_ad_types));
+    le_advertising_filter_uuid16s_len = 0;
+    le_advertising_filter_uuid128s_len = 0;
+    le_advertising_filter_company_ids_len = 0;
+    le_advertising_filter_data_filter_active = false;
+}
+
+void le_advertising_filter_set_duplicate_cache(le_advertising_filter_cache_entry_t * entries, uint16_t num_entries, uint32_t window_ms){
+    uint16_t i;
+    for (i = 0; i < num_entries; i++){
+        entries[i].in_use = false;
+    }
+    le_advertising_filter_cache = entries;
+    le_advertising_filter_cache_len = num_entries;
+    le_advertising_filter_cache_window_ms = window_ms;
+}
+
+void le_advertising_filter_get_stats(le_advertising_filter_stats_t * stats){
+    *stats = le_advertising_filter_stats;
+}
+
+void le_advertising_filter_reset_stats(void){
+    memset(&le_advertising_filter_stats, 0, sizeof(le_advertising_filter_stats));
+}
+
+void le_advertising_filter_deinit(void){
+    gap_register_advertising_report_filter(NULL);
+    le_advertising_filter_deny_list_len = 0;
+    le_advertising_filter_allow_list_len = 0;
+    le_advertising_filter_cache_len = 0;
+    le_advertising_filter_clear_data_filter();
+}
+
+#endif
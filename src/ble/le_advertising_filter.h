@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+/**
+ * @title LE Advertising Report Filter
+ *
+ * Host-side filter for LE Advertising Reports that runs in HCI before GAP_EVENT_ADVERTISING_REPORT and
+ * GAP_EVENT_EXTENDED_ADVERTISING_REPORT are emitted to the registered packet handlers.
+ *
+ * A report is delivered if all configured criteria are met:
+ * - its address is not on the deny list
+ * - its address is on the allow list, if an allow list is set
+ * - its RSSI is not below the RSSI threshold
+ * - its advertising data contains one of the configured AD Types, 16-bit or 128-bit Service UUIDs or
+ *   Company Identifiers in Manufacturer Specific Data, if any of these are configured
+ * - it has not been delivered within the duplicate window, if a duplicate cache is set
+ *
+ * Address list entries match either the full address or its first 3 bytes, i.e. the OUI for public addresses.
+ * Duplicates are detected per address and advertising data, so changed advertising data is delivered right away.
+ * Extended Advertising Reports that are only a part of fragmented advertising data are only checked against the
+ * address lists and the RSSI threshold.
+ */
+
+#ifndef LE_ADVERTISING_FILTER_H
+#define LE_ADVERTISING_FILTER_H
+
+#include <stdint.h>
+
+#include "btstack_bool.h"
+#include "btstack_config.h"
+#include "bluetooth.h"
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+#define LE_ADVERTISING_FILTER_MATCH_ADDRESS 6
+#define LE_ADVERTISING_FILTER_MATCH_OUI     3
+
+typedef struct {
+    bd_addr_t address;
+    // LE_ADVERTISING_FILTER_MATCH_ADDRESS or LE_ADVERTISING_FILTER_MATCH_OUI
+    uint8_t   match_len;
+} le_advertising_filter_address_t;
+
+typedef struct {
+    bd_addr_t address;
+    // address type 0xff is used for anonymous advertisements
+    uint8_t   address_type;
+    bool      in_use;
+    uint32_t  data_hash;
+    uint32_t  timestamp_ms;
+} le_advertising_filter_cache_entry_t;
+
+typedef struct {
+    uint32_t num_reports_seen;
+    uint32_t num_reports_filtered;
+    uint32_t num_reports_duplicate;
+    uint32_t num_reports_delivered;
+} le_advertising_filter_stats_t;
+
+/* API_START */
+
+/**
+ * @brief Init LE Advertising Report Filter and register it with HCI. All reports are delivered until configured.
+ */
+void le_advertising_filter_init(void);
+
+/**
+ * @brief Set addresses that are always filtered
+ * @param addresses storage, needs to stay valid
+ * @param num_addresses
+ */
+void le_advertising_filter_set_deny_list(const le_advertising_filter_address_t * addresses, uint16_t num_addresses);
+
+/**
+ * @brief Set addresses that are delivered. If set, reports from other addresses are filtered
+ * @param addresses storage, needs to stay valid
+ * @param num_addresses, 0 to deliver reports from all addresses
+ */
+void le_advertising_filter_set_allow_list(const le_advertising_filter_address_t * addresses, uint16_t num_addresses);
+
+/**
+ * @brief Filter reports with RSSI below threshold. Reports without RSSI (127) are not filtered
+ * @param rssi_threshold in dBm, -127 to deliver all reports
+ */
+void le_advertising_filter_set_rssi_threshold(int8_t rssi_threshold);
+
+/**
+ * @brief Deliver reports that contain AD Structure with given AD Type
+ * @param ad_type
+ */
+void le_advertising_filter_add_ad_type(uint8_t ad_type);
+
+/**
+ * @brief Deliver reports that list or provide Service Data for one of the given 16-bit Service UUIDs
+ * @param uuid16s storage, needs to stay valid
+ * @param num_uuid16s
+ */
+void le_advertising_filter_set_uuid16_list(const uint16_t * uuid16s, uint16_t num_uuid16s);
+
+/**
+ * @brief Deliver reports that list or provide Service Data for one of the given 128-bit Service UUIDs
+ * @param uuid128s storage in big endian, needs to stay valid
+ * @param num_uuid128s
+ */
+void le_advertising_filter_set_uuid128_list(const uint8_t (*uuid128s)[16], uint16_t num_uuid128s);
+
+/**
+ * @brief Deliver reports that contain Manufacturer Specific Data with one of the given Company Identifiers
+ * @param company_ids storage, needs to stay valid
+ * @param num_company_ids
+ */
+void le_advertising_filter_set_company_id_list(const uint16_t * company_ids, uint16_t num_company_ids);
+
+/**
+ * @brief Remove all AD Type, Service UUID, and Company Identifier criteria
+ */
+void le_advertising_filter_clear_data_filter(void);
+
+/**
+ * @brief Suppress reports with same address and advertising data within time window
+ * @param entries storage for cache entries
+ * @param num_entries, 0 to disable duplicate suppression
+ * @param window_ms
+ */
+void le_advertising_filter_set_duplicate_cache(le_advertising_filter_cache_entry_t * entries, uint16_t num_entries, uint32_t window_ms);
+
+/**
+ * @brief Get counters for reports seen, filtered, suppressed as duplicate, and delivered
+ * @param stats
+ */
+void le_advertising_filter_get_stats(le_advertising_filter_stats_t * stats);
+
+/**
+ * @brief Reset counters
+ */
+void le_advertising_filter_reset_stats(void);
+
+/**
+ * @brief Check GAP_EVENT_ADVERTISING_REPORT or GAP_EVENT_EXTENDED_ADVERTISING_REPORT against filter
+ * @note Called by HCI, public for testing
+ * @param event
+ * @param size
+ * @return true if report should be delivered
+ */
+bool le_advertising_filter_process(const uint8_t * event, uint16_t size);
+
+/**
+ * @brief De-Init LE Advertising Report Filter and unregister it from HCI
+ */
+void le_advertising_filter_deinit(void);
+
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+
+#endif // LE_ADVERTISING_FILTER_H
@@ -87,6 +87,15 @@
 #define USE_CMAC_ENGINE
 #endif
 
+// number of bonded connections that can be re-encrypted in parallel, each with its own crypto context
+#ifndef SM_NUM_CRYPTO_CONTEXTS
+#define SM_NUM_CRYPTO_CONTEXTS 4
+#endif
+
+#if SM_NUM_CRYPTO_CONTEXTS < 1
+#error "SM_NUM_CRYPTO_CONTEXTS must be at least 1"
+#endif
+
 
 #define BTSTACK_TAG32(A,B,C,D) (((A) << 24) | ((B) << 16) | ((C) << 8) | (D))
 
@@ -171,6 +180,20 @@ typedef enum {
     SM_SC_OOB_W4_CONFIRM,
 } sm_sc_oob_state_t;
 
+// re-encryption of a bonded connection, does not require the setup context
+// stays allocated until a pending crypto operation completes, even if the connection is gone
+typedef struct {
+    btstack_linked_item_t   item;
+    bool                    in_use;
+    bool                    crypto_active;
+    // HCI_CON_HANDLE_INVALID after disconnect
+    hci_con_handle_t        con_handle;
+    btstack_crypto_aes128_t aes128_request;
+    sm_key_t                aes128_plaintext;
+    sm_key_t                aes128_ciphertext;
+    sm_key_t                ltk;
+} sm_crypto_context_t;
+
 typedef uint8_t sm_key24_t[3];
 typedef uint8_t sm_key56_t[7];
 typedef uint8_t sm_key256_t[32];
@@ -265,6 +288,11 @@ static btstack_linked_list_t sm_address_resolution_general_queue;
 // aes128 crypto engine.
 static sm_aes128_state_t  sm_aes128_state;
 
+// per-connection crypto contexts for re-encryption, queued while connection has work to do
+static sm_crypto_context_t   sm_crypto_contexts[SM_NUM_CRYPTO_CONTEXTS];
+static btstack_linked_list_t sm_crypto_contexts_ready;
+static bool                  sm_crypto_contexts_exhausted;
+
 // crypto 
 static btstack_crypto_random_t   sm_crypto_random_request;
 static btstack_crypto_aes128_t   sm_crypto_aes128_request;
@@ -400,6 +428,7 @@ static void sm_run(void);
 static void sm_state_reset(void);
 static void sm_done_for_handle(hci_con_handle_t con_handle);
 static sm_connection_t * sm_get_connection_for_handle(hci_con_handle_t con_handle);
+static void sm_crypto_context_request(sm_connection_t * sm_connection);
 static void sm_cache_ltk(sm_connection_t * connection, const sm_key_t ltk);
 #ifdef ENABLE_CROSS_TRANSPORT_KEY_DERIVATION
 static sm_connection_t * sm_get_connection_for_bd_addr_and_type(bd_addr_t address, bd_addr_type_t addr_type);
@@ -1326,6 +1355,7 @@ static void sm_address_resolution_handle_event(address_resolution_event_t event)
                         // IRK required before, continue
                         if (sm_connection->sm_engine_state == SM_RESPONDER_PH0_RECEIVED_LTK_W4_IRK){
                             sm_connection->sm_engine_state = SM_RESPONDER_PH0_RECEIVED_LTK_REQUEST;
+                            sm_crypto_context_request(sm_connection);
                             break;
                         }
                         if (sm_connection->sm_engine_state == SM_RESPONDER_PH1_PAIRING_REQUEST_RECEIVED_W4_IRK){
@@ -1381,6 +1411,7 @@ static void sm_address_resolution_handle_event(address_resolution_event_t event)
                         if (trigger_reencryption){
                             log_info("central: enable encryption for bonded device");
                             sm_connection->sm_engine_state = SM_INITIATOR_PH4_HAS_LTK;
+                            sm_crypto_context_request(sm_connection);
                             break;
                         }
 
@@ -2130,14 +2161,14 @@ static void sm_ctkd_start_from_br_edr(sm_connection_t * sm_conn){
 // - both devices store same LTK from ECDH key exchange.
 
 #if defined(ENABLE_LE_SECURE_CONNECTIONS) || defined(ENABLE_LE_CENTRAL)
-static void sm_load_security_info(sm_connection_t * sm_connection){
+static void sm_load_security_info(sm_connection_t * sm_connection, uint16_t * ediv, uint8_t * rand, sm_key_t ltk){
     int encryption_key_size;
     int authenticated;
     int authorized;
     int secure_connection;
 
     // fetch data from device db - incl. authenticated/authorized/key size. Note all sm_connection_X require encryption enabled
-    le_device_db_encryption_get(sm_connection->sm_le_db_index, &setup->sm_peer_ediv, setup->sm_peer_rand, setup->sm_peer_ltk,
+    le_device_db_encryption_get(sm_connection->sm_le_db_index, ediv, rand, ltk,
                                 &encryption_key_size, &authenticated, &authorized, &secure_connection);
     log_info("db index %u, key size %u, authenticated %u, authorized %u, secure connetion %u", sm_connection->sm_le_db_index, encryption_key_size, authenticated, authorized, secure_connection);
     sm_connection->sm_actual_encryption_key_size = encryption_key_size;
@@ -2149,13 +2180,11 @@ static void sm_load_security_info(sm_connection_t * sm_connection){
 
 #ifdef ENABLE_LE_PERIPHERAL
 static void sm_start_calculating_ltk_from_ediv_and_rand(sm_connection_t * sm_connection){
-    (void)memcpy(setup->sm_local_rand, sm_connection->sm_local_rand, 8);
-    setup->sm_local_ediv = sm_connection->sm_local_ediv;
     // re-establish used key encryption size
-    // no db for encryption size hack: encryption size is stored in lowest nibble of setup->sm_local_rand
-    sm_connection->sm_actual_encryption_key_size = (setup->sm_local_rand[7u] & 0x0fu) + 1u;
+    // no db for encryption size hack: encryption size is stored in lowest nibble of sm_local_rand
+    sm_connection->sm_actual_encryption_key_size = (sm_connection->sm_local_rand[7u] & 0x0fu) + 1u;
     // no db for authenticated flag hack: flag is stored in bit 4 of LSB
-    sm_connection->sm_connection_authenticated = (setup->sm_local_rand[7u] & 0x10u) >> 4u;
+    sm_connection->sm_connection_authenticated = (sm_connection->sm_local_rand[7u] & 0x10u) >> 4u;
     // Legacy paring -> not SC
     sm_connection->sm_connection_sc = false;
     log_info("sm: received ltk request with key size %u, authenticated %u",
@@ -2163,6 +2192,102 @@ static void sm_start_calculating_ltk_from_ediv_and_rand(sm_connection_t * sm_con
 }
 #endif
 
+// crypto contexts for re-encryption
+
+static sm_crypto_context_t * sm_crypto_context_for_handle(hci_con_handle_t con_handle){
+    uint8_t i;
+    for (i = 0; i < SM_NUM_CRYPTO_CONTEXTS; i++){
+        sm_crypto_context_t * context = &sm_crypto_contexts[i];
+        if (context->in_use && (context->con_handle == con_handle)) return context;
+    }
+    return NULL;
+}
+
+static bool sm_crypto_context_needed(const sm_connection_t * sm_connection){
+    switch (sm_connection->sm_engine_state){
+#ifdef ENABLE_LE_PERIPHERAL
+        case SM_RESPONDER_PH0_RECEIVED_LTK_REQUEST:
+#ifdef ENABLE_LE_SECURE_CONNECTIONS
+        case SM_SC_RECEIVED_LTK_REQUEST:
+#endif
+#endif
+#ifdef ENABLE_LE_CENTRAL
+        case SM_INITIATOR_PH4_HAS_LTK:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+// queue connection for re-encryption, waits for free crypto context if all are in use
+static void sm_crypto_context_request(sm_connection_t * sm_connection){
+    if (sm_crypto_context_for_handle(sm_connection->sm_handle) != NULL) return;
+    uint8_t i;
+    for (i = 0; i < SM_NUM_CRYPTO_CONTEXTS; i++){
+        sm_crypto_context_t * context = &sm_crypto_contexts[i];
+        if (context->in_use) continue;
+        context->in_use = true;
+        context->crypto_active = false;
+        context->con_handle = sm_connection->sm_handle;
+        btstack_linked_list_add_tail(&sm_crypto_contexts_ready, (btstack_linked_item_t *) context);
+        return;
+    }
+    log_info("sm: no crypto context for connection 0x%04x, waiting", sm_connection->sm_handle);
+    sm_crypto_contexts_exhausted = true;
+}
+
+static void sm_crypto_context_free(sm_crypto_context_t * context){
+    btstack_linked_list_remove(&sm_crypto_contexts_ready, (btstack_linked_item_t *) context);
+    context->in_use = false;
+    if (sm_crypto_contexts_exhausted == false) return;
+
+    // hand over to connections waiting for a crypto context
+    sm_crypto_contexts_exhausted = false;
+    btstack_linked_list_iterator_t it;
+    hci_connections_get_iterator(&it);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        hci_connection_t * hci_connection = (hci_connection_t *) btstack_linked_list_iterator_next(&it);
+        sm_connection_t  * sm_connection  = &hci_connection->sm_connection;
+        if (sm_crypto_context_needed(sm_connection) == false) continue;
+        sm_crypto_context_request(sm_connection);
+    }
+    sm_trigger_run();
+}
+
+// connection is gone, context is freed when pending crypto operation completes
+static void sm_crypto_context_release(hci_con_handle_t con_handle){
+    sm_crypto_context_t * context = sm_crypto_context_for_handle(con_handle);
+    if (context == NULL) return;
+    if (context->crypto_active){
+        btstack_linked_list_remove(&sm_crypto_contexts_ready, (btstack_linked_item_t *) context);
+        context->con_handle = HCI_CON_HANDLE_INVALID;
+        return;
+    }
+    sm_crypto_context_free(context);
+}
+
+#ifdef ENABLE_LE_PERIPHERAL
+// @return connection for completed crypto operation or NULL if it is gone
+static sm_connection_t * sm_crypto_context_crypto_done(sm_crypto_context_t * context){
+    context->crypto_active = false;
+    sm_connection_t * sm_connection = NULL;
+    if (context->con_handle != HCI_CON_HANDLE_INVALID){
+        sm_connection = sm_get_connection_for_handle(context->con_handle);
+    }
+    if (sm_connection == NULL){
+        sm_crypto_context_free(context);
+    }
+    return sm_connection;
+}
+#endif
+
+static void sm_crypto_contexts_reset(void){
+    memset(sm_crypto_contexts, 0, sizeof(sm_crypto_contexts));
+    sm_crypto_contexts_ready = NULL;
+    sm_crypto_contexts_exhausted = false;
+}
+
 // distributed key generation
 static bool sm_run_dpkg(void){
     switch (dkg_state){
@@ -2368,6 +2493,122 @@ static bool sm_run_basic(void){
     return false;
 }
 
+// re-encryption of bonded connections, processed in order of the ready queue
+static bool sm_run_reencryption(void){
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &sm_crypto_contexts_ready);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        sm_crypto_context_t * context = (sm_crypto_context_t *) btstack_linked_list_iterator_next(&it);
+        if (context->crypto_active) continue;
+        sm_connection_t * connection = sm_get_connection_for_handle(context->con_handle);
+        if (connection == NULL){
+            sm_crypto_context_free(context);
+            btstack_linked_list_iterator_init(&it, &sm_crypto_contexts_ready);
+            continue;
+        }
+
+#if defined(ENABLE_LE_SECURE_CONNECTIONS) || defined(ENABLE_LE_CENTRAL)
+        uint16_t ediv;
+        uint8_t  rand[8];
+#endif
+        switch (connection->sm_engine_state){
+#ifdef ENABLE_LE_CENTRAL
+            case SM_INITIATOR_PH4_HAS_LTK: {
+                if (!hci_can_send_command_packet_now()) return true;
+                sm_load_security_info(connection, &ediv, rand, context->ltk);
+                sm_key_t peer_ltk_flipped;
+                reverse_128(context->ltk, peer_ltk_flipped);
+                connection->sm_engine_state = SM_PH4_W4_CONNECTION_ENCRYPTED;
+                log_info("sm: hci_le_start_encryption ediv 0x%04x", ediv);
+                uint32_t rand_high = big_endian_read_32(rand, 0);
+                uint32_t rand_low  = big_endian_read_32(rand, 4);
+                sm_crypto_context_free(context);
+                hci_send_cmd(&hci_le_start_encryption, connection->sm_handle,rand_low, rand_high, ediv, peer_ltk_flipped);
+
+                // notify after sending
+                sm_reencryption_started(connection);
+                return true;
+            }
+#endif
+
+#ifdef ENABLE_LE_PERIPHERAL
+#ifdef ENABLE_LE_SECURE_CONNECTIONS
+            case SM_SC_RECEIVED_LTK_REQUEST:
+                switch (connection->sm_irk_lookup_state){
+                    case IRK_LOOKUP_SUCCEEDED:
+                        // assuming Secure Connection, we have a stored LTK and the EDIV/RAND are null
+                        sm_load_security_info(connection, &ediv, rand, context->ltk);
+                        if ((ediv == 0u) && sm_is_null_random(rand) && !sm_is_null_key(context->ltk)){
+                            connection->sm_engine_state = SM_RESPONDER_PH4_SEND_LTK_REPLY;
+                            sm_reencryption_started(connection);
+                            btstack_linked_list_iterator_init(&it, &sm_crypto_contexts_ready);
+                            continue;
+                        }
+                        if (!hci_can_send_command_packet_now()) return true;
+                        log_info("LTK Request: ediv & random are empty, but no stored LTK (IRK Lookup Succeeded)");
+                        connection->sm_engine_state = SM_RESPONDER_IDLE;
+                        sm_crypto_context_free(context);
+                        hci_send_cmd(&hci_le_long_term_key_negative_reply, connection->sm_handle);
+                        return true;
+                    case IRK_LOOKUP_FAILED:
+                        // negative reply sent by sm_run_basic
+                        break;
+                    default:
+                        // just wait until IRK lookup is completed
+                        continue;
+                }
+                break;
+#endif /* ENABLE_LE_SECURE_CONNECTIONS */
+
+            case SM_RESPONDER_PH0_RECEIVED_LTK_REQUEST:
+                // DHK and ER ready?
+                if (dkg_state != DKG_READY) continue;
+                log_info("LTK Request: recalculating with ediv 0x%04x", connection->sm_local_ediv);
+
+                sm_start_calculating_ltk_from_ediv_and_rand(connection);
+
+                sm_reencryption_started(connection);
+
+                // dm helper (was sm_dm_r_prime)
+                // r' = padding || r
+                // r - 64 bit value
+                memset(&context->aes128_plaintext[0], 0, 8);
+                (void)memcpy(&context->aes128_plaintext[8], connection->sm_local_rand, 8);
+
+                // Y = dm(DHK, Rand)
+                connection->sm_engine_state = SM_RESPONDER_PH4_Y_W4_ENC;
+                context->crypto_active = true;
+                btstack_crypto_aes128_encrypt(&context->aes128_request, sm_persistent_dhk, context->aes128_plaintext, context->aes128_ciphertext, sm_handle_encryption_result_enc_ph4_y, context);
+                // start crypto for next connection
+                continue;
+
+            case SM_RESPONDER_PH4_SEND_LTK_REPLY: {
+                if (!hci_can_send_command_packet_now()) return true;
+                // allow to override LTK
+                if (sm_get_ltk_callback != NULL){
+                    (void)(*sm_get_ltk_callback)(connection->sm_handle, connection->sm_peer_addr_type, connection->sm_peer_address, context->ltk);
+                }
+                // cache key before using
+                sm_cache_ltk(connection, context->ltk);
+                sm_key_t ltk_flipped;
+                reverse_128(context->ltk, ltk_flipped);
+                connection->sm_engine_state = SM_PH4_W4_CONNECTION_ENCRYPTED;
+                sm_crypto_context_free(context);
+                hci_send_cmd(&hci_le_long_term_key_request_reply, connection->sm_handle, ltk_flipped);
+                return true;
+            }
+#endif
+            default:
+                break;
+        }
+
+        // no re-encryption in progress
+        sm_crypto_context_free(context);
+        btstack_linked_list_iterator_init(&it, &sm_crypto_contexts_ready);
+    }
+    return false;
+}
+
 static void sm_run_activate_connection(void){
     // Find connections that requires setup context and make active if no other is locked
     btstack_linked_list_iterator_t it;
@@ -2398,13 +2639,8 @@ static void sm_run_activate_connection(void){
 #ifdef ENABLE_LE_PERIPHERAL
             case SM_RESPONDER_SEND_SECURITY_REQUEST:
             case SM_RESPONDER_PH1_PAIRING_REQUEST_RECEIVED:
-            case SM_RESPONDER_PH0_RECEIVED_LTK_REQUEST:
-#ifdef ENABLE_LE_SECURE_CONNECTIONS
-            case SM_SC_RECEIVED_LTK_REQUEST:
-#endif
 #endif
 #ifdef ENABLE_LE_CENTRAL
-            case SM_INITIATOR_PH4_HAS_LTK:
 			case SM_INITIATOR_PH1_W2_SEND_PAIRING_REQUEST:
 #endif
 #ifdef ENABLE_CROSS_TRANSPORT_KEY_DERIVATION
@@ -2802,6 +3038,10 @@ static void sm_run(void){
     done = sm_run_basic();
     if (done) return;
 
+    // re-encrypt bonded connections without setup context
+    done = sm_run_reencryption();
+    if (done) return;
+
     //
     // active connection handling
     // -- use loop to handle next connection if lock on setup context is released
@@ -2892,23 +3132,6 @@ static void sm_run(void){
 #ifdef ENABLE_LE_CENTRAL
             // initiator side
 
-            case SM_INITIATOR_PH4_HAS_LTK: {
-				sm_reset_setup();
-				sm_load_security_info(connection);
-
-                sm_key_t peer_ltk_flipped;
-                reverse_128(setup->sm_peer_ltk, peer_ltk_flipped);
-                connection->sm_engine_state = SM_PH4_W4_CONNECTION_ENCRYPTED;
-                log_info("sm: hci_le_start_encryption ediv 0x%04x", setup->sm_peer_ediv);
-                uint32_t rand_high = big_endian_read_32(setup->sm_peer_rand, 0);
-                uint32_t rand_low  = big_endian_read_32(setup->sm_peer_rand, 4);
-                hci_send_cmd(&hci_le_start_encryption, connection->sm_handle,rand_low, rand_high, setup->sm_peer_ediv, peer_ltk_flipped);
-
-                // notify after sending
-                sm_reencryption_started(connection);
-                return;
-            }
-
 			case SM_INITIATOR_PH1_W2_SEND_PAIRING_REQUEST:
 				sm_reset_setup();
 				sm_init_setup(connection);
@@ -2948,32 +3171,6 @@ static void sm_run(void){
 				break;
 			}
 
-#ifdef ENABLE_LE_SECURE_CONNECTIONS
-			case SM_SC_RECEIVED_LTK_REQUEST:
-				switch (connection->sm_irk_lookup_state){
-					case IRK_LOOKUP_SUCCEEDED:
-						// assuming Secure Connection, we have a stored LTK and the EDIV/RAND are null
-						// start using context by loading security info
-						sm_reset_setup();
-						sm_load_security_info(connection);
-						if ((setup->sm_peer_ediv == 0u) && sm_is_null_random(setup->sm_peer_rand) && !sm_is_null_key(setup->sm_peer_ltk)){
-							(void)memcpy(setup->sm_ltk, setup->sm_peer_ltk, 16);
-							connection->sm_engine_state = SM_RESPONDER_PH4_SEND_LTK_REPLY;
-                            sm_reencryption_started(connection);
-                            sm_trigger_run();
-							break;
-						}
-						log_info("LTK Request: ediv & random are empty, but no stored LTK (IRK Lookup Succeeded)");
-						connection->sm_engine_state = SM_RESPONDER_IDLE;
-						hci_send_cmd(&hci_le_long_term_key_negative_reply, connection->sm_handle);
-						return;
-					default:
-						// just wait until IRK lookup is completed
-						break;
-				}
-				break;
-#endif /* ENABLE_LE_SECURE_CONNECTIONS */
-
 			case SM_RESPONDER_PH1_PAIRING_REQUEST_RECEIVED:
                 sm_reset_setup();
 
@@ -3149,41 +3346,6 @@ static void sm_run(void){
                 hci_send_cmd(&hci_le_long_term_key_request_reply, connection->sm_handle, stk_flipped);
                 return;
             }
-            case SM_RESPONDER_PH4_SEND_LTK_REPLY: {
-                // allow to override LTK
-                if (sm_get_ltk_callback != NULL){
-                    (void)(*sm_get_ltk_callback)(connection->sm_handle, connection->sm_peer_addr_type, connection->sm_peer_address, setup->sm_ltk);
-                }
-                // cache key before using
-                sm_cache_ltk(connection, setup->sm_ltk);
-                sm_key_t ltk_flipped;
-                reverse_128(setup->sm_ltk, ltk_flipped);
-                connection->sm_engine_state = SM_PH4_W4_CONNECTION_ENCRYPTED;
-                hci_send_cmd(&hci_le_long_term_key_request_reply, connection->sm_handle, ltk_flipped);
-                return;
-            }
-
-			case SM_RESPONDER_PH0_RECEIVED_LTK_REQUEST:
-                // already busy?
-                if (sm_aes128_state == SM_AES128_ACTIVE) break;
-                log_info("LTK Request: recalculating with ediv 0x%04x", setup->sm_local_ediv);
-
-				sm_reset_setup();
-				sm_start_calculating_ltk_from_ediv_and_rand(connection);
-
-				sm_reencryption_started(connection);
-
-                // dm helper (was sm_dm_r_prime)
-                // r' = padding || r
-                // r - 64 bit value
-                memset(&sm_aes128_plaintext[0], 0, 8);
-                (void)memcpy(&sm_aes128_plaintext[8], setup->sm_local_rand, 8);
-
-                // Y = dm(DHK, Rand)
-                connection->sm_engine_state = SM_RESPONDER_PH4_Y_W4_ENC;
-                sm_aes128_state = SM_AES128_ACTIVE;
-                btstack_crypto_aes128_encrypt(&sm_crypto_aes128_request, sm_persistent_dhk, sm_aes128_plaintext, sm_aes128_ciphertext, sm_handle_encryption_result_enc_ph4_y, (void *)(uintptr_t) connection->sm_handle);
-                return;
 #endif
 #ifdef ENABLE_LE_CENTRAL
             case SM_INITIATOR_PH3_SEND_START_ENCRYPTION: {
@@ -3448,25 +3610,24 @@ static void sm_handle_encryption_result_enc_ph3_y(void *arg){
 }
 
 #ifdef ENABLE_LE_PERIPHERAL
-// sm_aes128_state stays active
+// crypto context stays active
 static void sm_handle_encryption_result_enc_ph4_y(void *arg){
-    sm_aes128_state = SM_AES128_IDLE;
-    hci_con_handle_t con_handle = (hci_con_handle_t) (uintptr_t) arg;
+    sm_crypto_context_t * context = (sm_crypto_context_t *) arg;
 
-    sm_connection_t * connection = sm_get_connection_for_handle(con_handle);
+    sm_connection_t * connection = sm_crypto_context_crypto_done(context);
     if (connection == NULL) return;
 
-    setup->sm_local_y = big_endian_read_16(sm_aes128_ciphertext, 14);
-    log_info_hex16("y", setup->sm_local_y);
+    uint16_t y = big_endian_read_16(context->aes128_ciphertext, 14);
+    log_info_hex16("y", y);
 
     // PH3B3 - calculate DIV
-    setup->sm_local_div = setup->sm_local_y ^ setup->sm_local_ediv;
-    log_info_hex16("ediv", setup->sm_local_ediv);
+    uint16_t div = y ^ connection->sm_local_ediv;
+    log_info_hex16("ediv", connection->sm_local_ediv);
     // PH3B4 - calculate LTK         - enc
     // LTK = d1(ER, DIV, 0))
-    sm_d1_d_prime(setup->sm_local_div, 0, sm_aes128_plaintext);
-    sm_aes128_state = SM_AES128_ACTIVE;
-    btstack_crypto_aes128_encrypt(&sm_crypto_aes128_request, sm_persistent_er, sm_aes128_plaintext, setup->sm_ltk, sm_handle_encryption_result_enc_ph4_ltk, (void *)(uintptr_t) connection->sm_handle);
+    sm_d1_d_prime(div, 0, context->aes128_plaintext);
+    context->crypto_active = true;
+    btstack_crypto_aes128_encrypt(&context->aes128_request, sm_persistent_er, context->aes128_plaintext, context->ltk, sm_handle_encryption_result_enc_ph4_ltk, context);
 }
 #endif
 
@@ -3515,14 +3676,13 @@ static void sm_handle_encryption_result_enc_csrk(void *arg){
 
 #ifdef ENABLE_LE_PERIPHERAL
 static void sm_handle_encryption_result_enc_ph4_ltk(void *arg){
-    hci_con_handle_t con_handle = (hci_con_handle_t) (uintptr_t) arg;
-    sm_aes128_state = SM_AES128_IDLE;
+    sm_crypto_context_t * context = (sm_crypto_context_t *) arg;
 
-    sm_connection_t * connection = sm_get_connection_for_handle(con_handle);
+    sm_connection_t * connection = sm_crypto_context_crypto_done(context);
     if (connection == NULL) return;
 
-    sm_truncate_key(setup->sm_ltk, connection->sm_actual_encryption_key_size);
-    log_info_key("ltk", setup->sm_ltk);
+    sm_truncate_key(context->ltk, connection->sm_actual_encryption_key_size);
+    log_info_key("ltk", context->ltk);
     connection->sm_engine_state = SM_RESPONDER_PH4_SEND_LTK_REPLY;
     sm_trigger_run();
 }
@@ -3964,6 +4124,7 @@ static void sm_event_packet_handler (uint8_t packet_type, uint16_t channel, uint
                             if ((sm_conn->sm_local_ediv != 0u) || !sm_is_null_random(sm_conn->sm_local_rand)){
                                 if (sm_reconstruct_ltk_without_le_device_db_entry){
                                     sm_conn->sm_engine_state = SM_RESPONDER_PH0_RECEIVED_LTK_REQUEST;
+                                    sm_crypto_context_request(sm_conn);
                                     break;
                                 }
                                 // additionally check if remote is in LE Device DB if requested
@@ -3974,6 +4135,7 @@ static void sm_event_packet_handler (uint8_t packet_type, uint16_t channel, uint
                                         break;
                                     case IRK_LOOKUP_SUCCEEDED:
                                         sm_conn->sm_engine_state = SM_RESPONDER_PH0_RECEIVED_LTK_REQUEST;
+                                        sm_crypto_context_request(sm_conn);
                                         break;
                                     default:
                                         // wait for irk look doen
@@ -3985,6 +4147,7 @@ static void sm_event_packet_handler (uint8_t packet_type, uint16_t channel, uint
 
 #ifdef ENABLE_LE_SECURE_CONNECTIONS
                             sm_conn->sm_engine_state = SM_SC_RECEIVED_LTK_REQUEST;
+                            sm_crypto_context_request(sm_conn);
 #else
                             log_info("LTK Request: ediv & random are empty, but LE Secure Connections not supported");
                             sm_conn->sm_engine_state = SM_RESPONDER_PH0_SEND_LTK_REQUESTED_NEGATIVE_REPLY;
@@ -4124,6 +4287,7 @@ static void sm_event_packet_handler (uint8_t packet_type, uint16_t channel, uint
                 case HCI_EVENT_DISCONNECTION_COMPLETE:
                     con_handle = little_endian_read_16(packet, 3);
                     sm_done_for_handle(con_handle);
+                    sm_crypto_context_release(con_handle);
                     sm_conn = sm_get_connection_for_handle(con_handle);
                     if (!sm_conn) break;
 
@@ -4270,6 +4434,7 @@ static void sm_initiator_connected_handle_security_request(sm_connection_t * sm_
             if (have_ltk && (sm_conn->sm_connection_encrypted == 0)){
                 // start re-encrypt if we have LTK and the connection is not already encrypted
                 sm_conn->sm_engine_state = SM_INITIATOR_PH4_HAS_LTK;
+                sm_crypto_context_request(sm_conn);
             } else {
                 // start pairing
                 sm_conn->sm_engine_state = SM_INITIATOR_PH1_W2_SEND_PAIRING_REQUEST;
@@ -5018,6 +5183,7 @@ static void sm_state_reset(void) {
     sm_address_resolution_general_queue = NULL;
     sm_active_connection_handle = HCI_CON_HANDLE_INVALID;
     sm_persistent_keys_random_active = false;
+    sm_crypto_contexts_reset();
 #ifdef ENABLE_LE_SECURE_CONNECTIONS
     ec_key_generation_state = EC_KEY_GENERATION_IDLE;
 #endif
@@ -5179,6 +5345,7 @@ void sm_request_pairing(hci_con_handle_t con_handle){
                         if (trigger_reencryption){
                             sm_conn->sm_pairing_requested = true;
                             sm_conn->sm_engine_state = SM_INITIATOR_PH4_HAS_LTK;
+                            sm_crypto_context_request(sm_conn);
                             break;
                         }
                         /* fall through */
@@ -97,6 +97,7 @@
 #include "ble/gatt-service/scan_parameters_service_server.h"
 #include "ble/gatt-service/tx_power_service_server.h"
 #include "ble/gatt_client.h"
+#include "ble/le_advertising_filter.h"
 #include "ble/le_device_db.h"
 #include "ble/sm.h"
 #endif
@@ -162,6 +162,9 @@ static btstack_crypto_ecc_p256_key_generation_state_t btstack_crypto_ecc_p256_ke
 
 #ifdef USE_SOFTWARE_ECC_P256_IMPLEMENTATION
 static uint8_t btstack_crypto_ecc_p256_d[32];
+// DHKey calculation offloaded to worker, private key must not change while active
+static void (*btstack_crypto_ecc_p256_worker)(btstack_crypto_ecc_p256_t * request);
+static uint8_t btstack_crypto_ecc_p256_worker_active;
 #endif
 
 // Software ECDH implementation provided by mbedtls
@@ -592,9 +595,19 @@ static void btstack_crypto_ecc_p256_calculate_dhkey_software(btstack_crypto_ecc_
     mbedtls_mpi_free(&d);
     mbedtls_ecp_point_free(&Q);
 #endif
+}
 
+static void btstack_crypto_ecc_p256_calculate_dhkey_done(btstack_crypto_ecc_p256_t * btstack_crypto_ec_p192){
     log_info("dhkey");
     log_info_hexdump(btstack_crypto_ec_p192->dhkey, 32);
+    (*btstack_crypto_ec_p192->btstack_crypto.context_callback.callback)(btstack_crypto_ec_p192->btstack_crypto.context_callback.context);
+}
+
+static void btstack_crypto_ecc_p256_worker_done(void * context){
+    btstack_crypto_ecc_p256_t * btstack_crypto_ec_p192 = (btstack_crypto_ecc_p256_t *) context;
+    btstack_crypto_ecc_p256_worker_active--;
+    btstack_crypto_ecc_p256_calculate_dhkey_done(btstack_crypto_ec_p192);
+    btstack_crypto_run();
 }
 #endif
 
@@ -945,6 +958,8 @@ static void btstack_crypto_run(void){
                         break;
                     case ECC_P256_KEY_GENERATION_IDLE:
 #ifdef USE_SOFTWARE_ECC_P256_IMPLEMENTATION
+                        // wait until worker does not use the current private key anymore
+                        if (btstack_crypto_ecc_p256_worker_active > 0u) return;
                         log_info("start ecc random");
                         btstack_crypto_ecc_p256_key_generation_state = ECC_P256_KEY_GENERATION_GENERATING_RANDOM;
                         btstack_crypto_ecc_p256_random_len = 0;
@@ -970,10 +985,19 @@ static void btstack_crypto_run(void){
             case BTSTACK_CRYPTO_ECC_P256_CALCULATE_DHKEY:
                 btstack_crypto_ec_p192 = (btstack_crypto_ecc_p256_t *) btstack_crypto;
 #ifdef USE_SOFTWARE_ECC_P256_IMPLEMENTATION
+                btstack_linked_list_pop(&btstack_crypto_operations);
+                if (btstack_crypto_ecc_p256_worker != NULL){
+                    // continue with next operation while worker calculates DHKey
+                    btstack_crypto_ecc_p256_worker_active++;
+                    btstack_crypto_ec_p192->worker_completion.item     = NULL;
+                    btstack_crypto_ec_p192->worker_completion.callback = &btstack_crypto_ecc_p256_worker_done;
+                    btstack_crypto_ec_p192->worker_completion.context  = btstack_crypto_ec_p192;
+                    (*btstack_crypto_ecc_p256_worker)(btstack_crypto_ec_p192);
+                    break;
+                }
                 btstack_crypto_ecc_p256_calculate_dhkey_software(btstack_crypto_ec_p192);
                 // done
-                btstack_linked_list_pop(&btstack_crypto_operations);
-                (*btstack_crypto_ec_p192->btstack_crypto.context_callback.callback)(btstack_crypto_ec_p192->btstack_crypto.context_callback.context);
+                btstack_crypto_ecc_p256_calculate_dhkey_done(btstack_crypto_ec_p192);
 #else
                 btstack_crypto_wait_for_hci_result = 1;
                 hci_send_cmd(&hci_le_generate_dhkey, &btstack_crypto_ec_p192->public_key[0], &btstack_crypto_ec_p192->public_key[32]);
@@ -1264,6 +1288,23 @@ void btstack_crypto_ecc_p256_calculate_dhkey(btstack_crypto_ecc_p256_t * request
     btstack_crypto_run();
 }
 
+void btstack_crypto_ecc_p256_set_worker(void (*worker)(btstack_crypto_ecc_p256_t * request)){
+#ifdef USE_SOFTWARE_ECC_P256_IMPLEMENTATION
+    btstack_crypto_ecc_p256_worker = worker;
+#else
+    UNUSED(worker);
+#endif
+}
+
+void btstack_crypto_ecc_p256_worker_calculate_dhkey(btstack_crypto_ecc_p256_t * request){
+#ifdef USE_SOFTWARE_ECC_P256_IMPLEMENTATION
+    // only reads private key and request, no logging as HCI Dump is not thread-safe
+    btstack_crypto_ecc_p256_calculate_dhkey_software(request);
+#else
+    UNUSED(request);
+#endif
+}
+
 int btstack_crypto_ecc_p256_validate_public_key(const uint8_t * public_key){
 
     int err = 0;
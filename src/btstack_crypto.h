@@ -99,6 +99,8 @@ typedef struct {
 	btstack_crypto_t btstack_crypto;
 	uint8_t * public_key;
     uint8_t * dhkey;
+    // used to report DHKey from ECC worker to main thread
+    btstack_context_callback_registration_t worker_completion;
 } btstack_crypto_ecc_p256_t;
 
 typedef enum {
@@ -224,6 +226,22 @@ void btstack_crypto_ecc_p256_calculate_dhkey(btstack_crypto_ecc_p256_t * request
  */
 int btstack_crypto_ecc_p256_validate_public_key(const uint8_t * public_key);
 
+/**
+ * Offload software DHKey calculation to an ECC worker, e.g. a thread pool, instead of blocking the run loop
+ * @note The worker is called on the main thread with a request that is not queued anymore. It has to call
+ *       btstack_crypto_ecc_p256_worker_calculate_dhkey for the request on any thread and afterwards
+ *       schedule request->worker_completion via btstack_run_loop_execute_on_main_thread
+ * @note Key generation is still done on the main thread. Without software ECC, the worker is not used
+ * @param worker or NULL to calculate DHKey on the main thread
+ */
+void btstack_crypto_ecc_p256_set_worker(void (*worker)(btstack_crypto_ecc_p256_t * request));
+
+/**
+ * Calculate DHKey for request passed to ECC worker. Thread-safe, can be called from any thread
+ * @param request
+ */
+void btstack_crypto_ecc_p256_worker_calculate_dhkey(btstack_crypto_ecc_p256_t * request);
+
 /** 
  * Initialize Counter with CBC-MAC for Bluetooth Mesh (L=2)
  * @param request
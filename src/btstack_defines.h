@@ -1538,6 +1538,25 @@ typedef uint8_t sm_key_t[16];
  */
 #define GATT_EVENT_DISCONNECTED                                  0xAEu
 
+/**
+ * @format H12221
+ * @param handle
+ * @param att_status
+ * @param num_services
+ * @param num_characteristics
+ * @param num_descriptors
+ * @param from_cache
+ */
+#define GATT_EVENT_DISCOVERY_COMPLETE                            0xAFu
+
+/**
+ * @format H22
+ * @param handle
+ * @param start_handle
+ * @param end_handle
+ */
+#define GATT_EVENT_DATABASE_CHANGED                              0xB0u
+
 
 /** 
  * @format 1BH
@@ -2019,6 +2038,16 @@ typedef uint8_t sm_key_t[16];
  */
 #define GAP_SUBEVENT_LE_CONNECTION_COMPLETE                     0x08u
 
+/**
+ * @brief HCI Command for Advertising Set failed, emitted for Set Extended Advertising Data and Enable
+ * @format 1121
+ * @param subevent_code
+ * @param advertising_handle
+ * @param opcode
+ * @param status
+ */
+#define GAP_SUBEVENT_ADVERTISING_SET_COMMAND_FAILED              0x09u
+
 /** HSP Subevent */
 
 /**
@@ -2948,6 +2948,93 @@ static inline hci_con_handle_t gatt_event_disconnected_get_handle(const uint8_t
 }
 #endif
 
+#ifdef ENABLE_BLE
+/**
+ * @brief Get field handle from event GATT_EVENT_DISCOVERY_COMPLETE
+ * @param event packet
+ * @return handle
+ * @note: btstack_type H
+ */
+static inline hci_con_handle_t gatt_event_discovery_complete_get_handle(const uint8_t * event){
+    return little_endian_read_16(event, 2);
+}
+/**
+ * @brief Get field att_status from event GATT_EVENT_DISCOVERY_COMPLETE
+ * @param event packet
+ * @return att_status
+ * @note: btstack_type 1
+ */
+static inline uint8_t gatt_event_discovery_complete_get_att_status(const uint8_t * event){
+    return event[4];
+}
+/**
+ * @brief Get field num_services from event GATT_EVENT_DISCOVERY_COMPLETE
+ * @param event packet
+ * @return num_services
+ * @note: btstack_type 2
+ */
+static inline uint16_t gatt_event_discovery_complete_get_num_services(const uint8_t * event){
+    return little_endian_read_16(event, 5);
+}
+/**
+ * @brief Get field num_characteristics from event GATT_EVENT_DISCOVERY_COMPLETE
+ * @param event packet
+ * @return num_characteristics
+ * @note: btstack_type 2
+ */
+static inline uint16_t gatt_event_discovery_complete_get_num_characteristics(const uint8_t * event){
+    return little_endian_read_16(event, 7);
+}
+/**
+ * @brief Get field num_descriptors from event GATT_EVENT_DISCOVERY_COMPLETE
+ * @param event packet
+ * @return num_descriptors
+ * @note: btstack_type 2
+ */
+static inline uint16_t gatt_event_discovery_complete_get_num_descriptors(const uint8_t * event){
+    return little_endian_read_16(event, 9);
+}
+/**
+ * @brief Get field from_cache from event GATT_EVENT_DISCOVERY_COMPLETE
+ * @param event packet
+ * @return from_cache
+ * @note: btstack_type 1
+ */
+static inline uint8_t gatt_event_discovery_complete_get_from_cache(const uint8_t * event){
+    return event[11];
+}
+#endif
+
+#ifdef ENABLE_BLE
+/**
+ * @brief Get field handle from event GATT_EVENT_DATABASE_CHANGED
+ * @param event packet
+ * @return handle
+ * @note: btstack_type H
+ */
+static inline hci_con_handle_t gatt_event_database_changed_get_handle(const uint8_t * event){
+    return little_endian_read_16(event, 2);
+}
+/**
+ * @brief Get field start_handle from event GATT_EVENT_DATABASE_CHANGED
+ * @param event packet
+ * @return start_handle
+ * @note: btstack_type 2
+ */
+static inline uint16_t gatt_event_database_changed_get_start_handle(const uint8_t * event){
+    return little_endian_read_16(event, 4);
+}
+/**
+ * @brief Get field end_handle from event GATT_EVENT_DATABASE_CHANGED
+ * @param event packet
+ * @return end_handle
+ * @note: btstack_type 2
+ */
+static inline uint16_t gatt_event_database_changed_get_end_handle(const uint8_t * event){
+    return little_endian_read_16(event, 6);
+}
+#endif
+
 /**
  * @brief Get field address_type from event ATT_EVENT_CONNECTED
  * @param event packet
@@ -6134,6 +6221,33 @@ static inline uint8_t gap_subevent_le_connection_complete_get_advertising_handle
 static inline hci_con_handle_t gap_subevent_le_connection_complete_get_sync_handle(const uint8_t * event){
     return little_endian_read_16(event, 34);
 }
+/**
+ * @brief Get field advertising_handle from event GAP_SUBEVENT_ADVERTISING_SET_COMMAND_FAILED
+ * @param event packet
+ * @return advertising_handle
+ * @note: btstack_type 1
+ */
+static inline uint8_t gap_subevent_advertising_set_command_failed_get_advertising_handle(const uint8_t * event){
+    return event[3];
+}
+/**
+ * @brief Get field opcode from event GAP_SUBEVENT_ADVERTISING_SET_COMMAND_FAILED
+ * @param event packet
+ * @return opcode
+ * @note: btstack_type 2
+ */
+static inline uint16_t gap_subevent_advertising_set_command_failed_get_opcode(const uint8_t * event){
+    return little_endian_read_16(event, 4);
+}
+/**
+ * @brief Get field status from event GAP_SUBEVENT_ADVERTISING_SET_COMMAND_FAILED
+ * @param event packet
+ * @return status
+ * @note: btstack_type 1
+ */
+static inline uint8_t gap_subevent_advertising_set_command_failed_get_status(const uint8_t * event){
+    return event[6];
+}
 
 /**
  * @brief Get field acl_handle from event HSP_SUBEVENT_RFCOMM_CONNECTION_COMPLETE
@@ -40,6 +40,7 @@
 #include <string.h>
 
 #include "btstack_hid_parser.h"
+#include "bluetooth.h"
 #include "btstack_util.h"
 #include "btstack_debug.h"
 
@@ -352,6 +353,19 @@ static void btstack_hid_parser_find_next_usage(btstack_hid_parser_t * parser){
     }
 }
 
+// read field (up to 32 bit unsigned) - check report len
+static uint32_t btstack_hid_read_bits(const uint8_t * report, uint16_t report_len, uint16_t bit_pos, uint8_t bit_size){
+    int pos_start     = btstack_min(  bit_pos >> 3, report_len);
+    int pos_end       = btstack_min( (bit_pos + bit_size - 1u) >> 3u, report_len);
+    int bytes_to_read = pos_end - pos_start + 1;
+    int i;
+    uint32_t multi_byte_value = 0;
+    for (i=0;i < bytes_to_read;i++){
+        multi_byte_value |= report[pos_start+i] << (i*8);
+    }
+    return (multi_byte_value >> (bit_pos & 0x07u)) & ((1u<<bit_size)-1u);
+}
+
 // PUBLIC API
 
 void btstack_hid_parser_init(btstack_hid_parser_t * parser, const uint8_t * hid_descriptor, uint16_t hid_descriptor_len, hid_report_type_t hid_report_type, const uint8_t * hid_report, uint16_t hid_report_len){
@@ -376,18 +390,10 @@ void btstack_hid_parser_get_field(btstack_hid_parser_t * parser, uint16_t * usag
 
     *usage_page = parser->usage_minimum >> 16;
 
-    // read field (up to 32 bit unsigned, up to 31 bit signed - 32 bit signed behaviour is undefined) - check report len
+    // read field (up to 32 bit unsigned, up to 31 bit signed - 32 bit signed behaviour is undefined)
     bool is_variable   = (parser->descriptor_item.item_value & 2) != 0;
     bool is_signed     = parser->global_logical_minimum < 0;
-    int pos_start     = btstack_min(  parser->report_pos_in_bit >> 3, parser->report_len);
-    int pos_end       = btstack_min( (parser->report_pos_in_bit + parser->global_report_size - 1u) >> 3u, parser->report_len);
-    int bytes_to_read = pos_end - pos_start + 1;
-    int i;
-    uint32_t multi_byte_value = 0;
-    for (i=0;i < bytes_to_read;i++){
-        multi_byte_value |= parser->report[pos_start+i] << (i*8);
-    }
-    uint32_t unsigned_value = (multi_byte_value >> (parser->report_pos_in_bit & 0x07u)) & ((1u<<parser->global_report_size)-1u);
+    uint32_t unsigned_value = btstack_hid_read_bits(parser->report, parser->report_len, parser->report_pos_in_bit, parser->global_report_size);
     // log_debug("bit pos %2u, report size %u, start %u, end %u, len %u;; unsigned value %08x", parser->report_pos_in_bit, parser->global_report_size, pos_start, pos_end, parser->report_len, unsigned_value);
     if (is_variable){
         *usage      = parser->usage_minimum & 0xffffu;
@@ -537,3 +543,125 @@ int btstack_hid_report_id_declared(uint16_t hid_descriptor_len, const uint8_t *
     }
     return 0;
 }
+
+// HID Report Table
+
+void btstack_hid_report_table_init(btstack_hid_report_table_t * table, btstack_hid_report_field_t * fields, uint16_t max_fields){
+    memset(table, 0, sizeof(btstack_hid_report_table_t));
+    table->fields     = fields;
+    table->max_fields = max_fields;
+}
+
+// append field to last run if it directly follows it in the report
+static bool btstack_hid_report_table_merge_field(btstack_hid_report_table_t * table, const btstack_hid_report_field_t * field){
+    if (table->num_fields == 0u) return false;
+    btstack_hid_report_field_t * last = &table->fields[table->num_fields - 1u];
+    if (last->report_count == 0xffu) return false;
+    if (last->flags != field->flags) return false;
+    if (last->report_size != field->report_size) return false;
+    if (last->usage_page != field->usage_page) return false;
+    if (last->logical_minimum != field->logical_minimum) return false;
+    if (last->logical_maximum != field->logical_maximum) return false;
+    if ((last->bit_offset + (last->report_count * last->report_size)) != field->bit_offset) return false;
+    if (((field->flags & BTSTACK_HID_REPORT_FIELD_FLAG_VARIABLE) != 0u) &&
+        ((last->usage_minimum + last->report_count) != field->usage_minimum)) return false;
+    last->report_count++;
+    return true;
+}
+
+uint8_t btstack_hid_report_table_compile(btstack_hid_report_table_t * table, const uint8_t * hid_descriptor, uint16_t hid_descriptor_len, hid_report_type_t hid_report_type, uint8_t report_id){
+    table->num_fields  = 0;
+    table->report_type = hid_report_type;
+    table->report_id   = report_id;
+
+    // run parser on dummy report, only the report ID gets evaluated. Second byte avoids read beyond report len
+    const uint8_t report[2] = { report_id, 0 };
+    btstack_hid_parser_t parser;
+    btstack_hid_parser_init(&parser, hid_descriptor, hid_descriptor_len, hid_report_type, report, 1);
+    while (btstack_hid_parser_has_more(&parser)){
+        btstack_hid_report_field_t field;
+        field.bit_offset      = parser.report_pos_in_bit;
+        field.usage_page      = parser.usage_minimum >> 16;
+        field.usage_minimum   = parser.usage_minimum & 0xffffu;
+        field.report_size     = parser.global_report_size;
+        field.report_count    = 1;
+        field.flags           = 0;
+        field.logical_minimum = parser.global_logical_minimum;
+        field.logical_maximum = parser.global_logical_maximum;
+        if ((parser.descriptor_item.item_value & 2) != 0){
+            field.flags |= BTSTACK_HID_REPORT_FIELD_FLAG_VARIABLE;
+        }
+        if (parser.global_logical_minimum < 0){
+            field.flags |= BTSTACK_HID_REPORT_FIELD_FLAG_SIGNED;
+        }
+
+        uint16_t usage_page;
+        uint16_t usage;
+        int32_t  value;
+        btstack_hid_parser_get_field(&parser, &usage_page, &usage, &value);
+
+        if (btstack_hid_report_table_merge_field(table, &field)) continue;
+        if (table->num_fields >= table->max_fields){
+            log_error("HID Report Table too small for report id %u", report_id);
+            return ERROR_CODE_MEMORY_CAPACITY_EXCEEDED;
+        }
+        table->fields[table->num_fields++] = field;
+    }
+    return ERROR_CODE_SUCCESS;
+}
+
+void btstack_hid_report_iterator_init(btstack_hid_report_iterator_t * iterator, const btstack_hid_report_table_t * table, const uint8_t * hid_report, uint16_t hid_report_len){
+    iterator->table         = table;
+    iterator->report        = hid_report;
+    iterator->report_len    = hid_report_len;
+    iterator->field_index   = 0;
+    iterator->element_index = 0;
+    // skip all fields if report ID does not match
+    if ((table->report_id != 0u) && ((hid_report_len == 0u) || (hid_report[0] != table->report_id))){
+        iterator->field_index = table->num_fields;
+    }
+}
+
+bool btstack_hid_report_iterator_has_more(btstack_hid_report_iterator_t * iterator){
+    const btstack_hid_report_table_t * table = iterator->table;
+    while (iterator->field_index < table->num_fields){
+        const btstack_hid_report_field_t * field = &table->fields[iterator->field_index];
+        if (iterator->element_index < field->report_count){
+            // field complete in report?
+            uint32_t bit_end = field->bit_offset + ((iterator->element_index + 1u) * field->report_size);
+            return bit_end <= (iterator->report_len * 8u);
+        }
+        iterator->field_index++;
+        iterator->element_index = 0;
+    }
+    return false;
+}
+
+void btstack_hid_report_iterator_get_field(btstack_hid_report_iterator_t * iterator, uint16_t * usage_page, uint16_t * usage, int32_t * value){
+    const btstack_hid_report_field_t * field = &iterator->table->fields[iterator->field_index];
+    uint16_t bit_pos = field->bit_offset + (iterator->element_index * field->report_size);
+
+    // byte aligned 8 and 16 bit fields, e.g. key codes, are read directly
+    uint32_t unsigned_value;
+    if (((bit_pos & 0x07u) == 0u) && (field->report_size == 8u)){
+        unsigned_value = iterator->report[bit_pos >> 3];
+    } else if (((bit_pos & 0x07u) == 0u) && (field->report_size == 16u)){
+        unsigned_value = little_endian_read_16(iterator->report, bit_pos >> 3);
+    } else {
+        unsigned_value = btstack_hid_read_bits(iterator->report, iterator->report_len, bit_pos, field->report_size);
+    }
+
+    *usage_page = field->usage_page;
+    if ((field->flags & BTSTACK_HID_REPORT_FIELD_FLAG_VARIABLE) != 0u){
+        *usage = field->usage_minimum + iterator->element_index;
+        if (((field->flags & BTSTACK_HID_REPORT_FIELD_FLAG_SIGNED) != 0u) && (unsigned_value & (1u << (field->report_size - 1u)))){
+            *value = unsigned_value - (1u << field->report_size);
+        } else {
+            *value = unsigned_value;
+        }
+    } else {
+        *usage = unsigned_value;
+        *value = 1;
+    }
+    iterator->element_index++;
+}
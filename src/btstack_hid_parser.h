@@ -40,6 +40,9 @@
  *
  * Single-pass HID Report Parser: HID Report is directly parsed without preprocessing HID Descriptor to minimize memory.
  *
+ * For devices with high report rates, the HID Descriptor can be compiled once per Report ID into a table of report fields.
+ * Reports are then decoded by table lookup via the HID Report Iterator.
+ *
  */
 
 #ifndef BTSTACK_HID_PARSER_H
@@ -151,6 +154,40 @@ typedef struct {
     uint8_t         global_report_id;
 } btstack_hid_parser_t;
 
+// report field flags
+#define BTSTACK_HID_REPORT_FIELD_FLAG_VARIABLE 0x01u
+#define BTSTACK_HID_REPORT_FIELD_FLAG_SIGNED   0x02u
+
+// run of report_count fields with same size, usage page and logical range
+// variable fields: usages are usage_minimum, usage_minimum + 1, ...
+// array fields: usage is provided in report
+typedef struct {
+    uint16_t        bit_offset;
+    uint16_t        usage_page;
+    uint16_t        usage_minimum;
+    uint8_t         report_size;
+    uint8_t         report_count;
+    uint8_t         flags;
+    int32_t         logical_minimum;
+    int32_t         logical_maximum;
+} btstack_hid_report_field_t;
+
+typedef struct {
+    btstack_hid_report_field_t * fields;
+    uint16_t        max_fields;
+    uint16_t        num_fields;
+    hid_report_type_t report_type;
+    uint8_t         report_id;
+} btstack_hid_report_table_t;
+
+typedef struct {
+    const btstack_hid_report_table_t * table;
+    const uint8_t * report;
+    uint16_t        report_len;
+    uint16_t        field_index;
+    uint8_t         element_index;
+} btstack_hid_report_iterator_t;
+
 /* API_START */
 
 /**
@@ -210,6 +247,50 @@ hid_report_id_status_t btstack_hid_id_valid(int report_id, uint16_t hid_descript
  * @param hid_descriptor
  */
 int btstack_hid_report_id_declared(uint16_t hid_descriptor_len, const uint8_t * hid_descriptor);
+
+/**
+ * @brief Initialize HID Report Table with storage for fields
+ * @param table
+ * @param fields storage
+ * @param max_fields
+ */
+void btstack_hid_report_table_init(btstack_hid_report_table_t * table, btstack_hid_report_field_t * fields, uint16_t max_fields);
+
+/**
+ * @brief Compile HID Descriptor into table of fields for given report type and report ID
+ * @note report ID 0 is used for descriptors without Report ID
+ * @param table
+ * @param hid_descriptor
+ * @param hid_descriptor_len
+ * @param hid_report_type
+ * @param report_id
+ * @return status ERROR_CODE_SUCCESS or ERROR_CODE_MEMORY_CAPACITY_EXCEEDED if table is too small
+ */
+uint8_t btstack_hid_report_table_compile(btstack_hid_report_table_t * table, const uint8_t * hid_descriptor, uint16_t hid_descriptor_len, hid_report_type_t hid_report_type, uint8_t report_id);
+
+/**
+ * @brief Initialize HID Report Iterator to decode report with compiled table. Provides same fields as HID Parser.
+ * @param iterator
+ * @param table
+ * @param hid_report
+ * @param hid_report_len
+ */
+void btstack_hid_report_iterator_init(btstack_hid_report_iterator_t * iterator, const btstack_hid_report_table_t * table, const uint8_t * hid_report, uint16_t hid_report_len);
+
+/**
+ * @brief Checks if more fields are available
+ * @param iterator
+ */
+bool btstack_hid_report_iterator_has_more(btstack_hid_report_iterator_t * iterator);
+
+/**
+ * @brief Get next field
+ * @param iterator
+ * @param usage_page
+ * @param usage
+ * @param value provided in HID report
+ */
+void btstack_hid_report_iterator_get_field(btstack_hid_report_iterator_t * iterator, uint16_t * usage_page, uint16_t * usage, int32_t * value);
 /* API_END */
 
 #if defined __cplusplus
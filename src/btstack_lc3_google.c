@@ -53,6 +53,32 @@ static uint16_t lc3_frame_duration_in_us(btstack_lc3_frame_duration_t frame_dura
     }
 }
 
+/* Multi-channel support */
+
+static btstack_lc3_google_parallel_for_t lc3_google_parallel_for;
+
+void btstack_lc3_google_set_parallel_for(btstack_lc3_google_parallel_for_t parallel_for){
+    lc3_google_parallel_for = parallel_for;
+}
+
+static void lc3_google_run_channels(uint8_t num_channels, void (*work)(void * context, uint16_t first_item, uint16_t num_items), void * context){
+    if ((lc3_google_parallel_for != NULL) && (num_channels > 1)){
+        (*lc3_google_parallel_for)(num_channels, work, context);
+    } else {
+        (*work)(context, 0, num_channels);
+    }
+}
+
+static uint8_t lc3_google_channels_status(uint8_t num_channels, const uint8_t * status){
+    uint8_t i;
+    for (i = 0; i < num_channels; i++){
+        if (status[i] != ERROR_CODE_SUCCESS){
+            return status[i];
+        }
+    }
+    return ERROR_CODE_SUCCESS;
+}
+
 /* Decoder implementation */
 
 static uint8_t lc3_decoder_google_configure(void * context, uint32_t sample_rate, btstack_lc3_frame_duration_t frame_duration, uint16_t octets_per_frame){
@@ -129,6 +155,41 @@ const btstack_lc3_decoder_t * btstack_lc3_decoder_google_init_instance(btstack_l
     return &btstack_l3c_decoder_google_instance;
 }
 
+typedef struct {
+    btstack_lc3_decoder_google_t * contexts;
+    const uint8_t * bytes;
+    uint16_t        bytes_stride;
+    const uint8_t * BFI;
+    int16_t *       pcm_out;
+    uint16_t        pcm_stride;
+    uint8_t *       BEC_detect;
+    uint8_t *       status;
+} lc3_decoder_google_channels_job_t;
+
+static void lc3_decoder_google_decode_channels_work(void * context, uint16_t first_item, uint16_t num_items){
+    lc3_decoder_google_channels_job_t * job = (lc3_decoder_google_channels_job_t *) context;
+    uint16_t i;
+    for (i = first_item; i < (first_item + num_items); i++){
+        uint8_t channel_bfi = (job->BFI != NULL) ? job->BFI[i] : 0;
+        job->status[i] = lc3_decoder_google_decode(&job->contexts[i], &job->bytes[i * job->bytes_stride], channel_bfi,
+                                                   LC3_PCM_FORMAT_S16, (void *) &job->pcm_out[i], job->pcm_stride, &job->BEC_detect[i]);
+    }
+}
+
+uint8_t btstack_lc3_decoder_google_decode_channels_signed_16(btstack_lc3_decoder_google_t * contexts, uint8_t num_channels,
+                                                             const uint8_t * bytes, uint16_t bytes_stride, const uint8_t * BFI,
+                                                             int16_t * pcm_out, uint16_t pcm_stride, uint8_t * BEC_detect){
+    uint8_t status[BTSTACK_LC3_GOOGLE_MAX_CHANNELS];
+    if (num_channels > BTSTACK_LC3_GOOGLE_MAX_CHANNELS){
+        return ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS;
+    }
+    lc3_decoder_google_channels_job_t job = {
+        contexts, bytes, bytes_stride, BFI, pcm_out, pcm_stride, BEC_detect, status
+    };
+    lc3_google_run_channels(num_channels, &lc3_decoder_google_decode_channels_work, &job);
+    return lc3_google_channels_status(num_channels, status);
+}
+
 /* Encoder implementation */
 
 static uint8_t lc3_encoder_google_configure(void * context, uint32_t sample_rate, btstack_lc3_frame_duration_t frame_duration, uint16_t octets_per_frame){
@@ -191,3 +252,34 @@ const btstack_lc3_encoder_t * btstack_lc3_encoder_google_init_instance(btstack_l
     return &btstack_l3c_encoder_google_instance;
 }
 
+typedef struct {
+    btstack_lc3_encoder_google_t * contexts;
+    const int16_t * pcm_in;
+    uint16_t        pcm_stride;
+    uint8_t *       bytes;
+    uint16_t        bytes_stride;
+    uint8_t *       status;
+} lc3_encoder_google_channels_job_t;
+
+static void lc3_encoder_google_encode_channels_work(void * context, uint16_t first_item, uint16_t num_items){
+    lc3_encoder_google_channels_job_t * job = (lc3_encoder_google_channels_job_t *) context;
+    uint16_t i;
+    for (i = first_item; i < (first_item + num_items); i++){
+        job->status[i] = lc3_encoder_google_encode_signed(&job->contexts[i], LC3_PCM_FORMAT_S16, (const void *) &job->pcm_in[i],
+                                                          job->pcm_stride, &job->bytes[i * job->bytes_stride]);
+    }
+}
+
+uint8_t btstack_lc3_encoder_google_encode_channels_signed_16(btstack_lc3_encoder_google_t * contexts, uint8_t num_channels,
+                                                             const int16_t * pcm_in, uint16_t pcm_stride,
+                                                             uint8_t * bytes, uint16_t bytes_stride){
+    uint8_t status[BTSTACK_LC3_GOOGLE_MAX_CHANNELS];
+    if (num_channels > BTSTACK_LC3_GOOGLE_MAX_CHANNELS){
+        return ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS;
+    }
+    lc3_encoder_google_channels_job_t job = {
+        contexts, pcm_in, pcm_stride, bytes, bytes_stride, status
+    };
+    lc3_google_run_channels(num_channels, &lc3_encoder_google_encode_channels_work, &job);
+    return lc3_google_channels_status(num_channels, status);
+}
@@ -46,6 +46,11 @@ extern "C" {
 
 /* API_START */
 
+// max number of channels for multi-channel encode/decode
+#ifndef BTSTACK_LC3_GOOGLE_MAX_CHANNELS
+#define BTSTACK_LC3_GOOGLE_MAX_CHANNELS 8
+#endif
+
 typedef struct {
     lc3_decoder_mem_48k_t           decoder_mem;
     lc3_decoder_t                   decoder;    // pointer
@@ -74,6 +79,48 @@ const btstack_lc3_decoder_t * btstack_lc3_decoder_google_init_instance(btstack_l
  */
 const btstack_lc3_encoder_t * btstack_lc3_encoder_google_init_instance(btstack_lc3_encoder_google_t * context);
 
+/**
+ * Executor used by multi-channel functions to process channels in parallel, e.g. btstack_parallel_posix_for
+ * @note must return after work has been called for all items, e.g. work(context, 0, 2); work(context, 2, 2);
+ */
+typedef void (*btstack_lc3_google_parallel_for_t)(uint16_t num_items, void (*work)(void * context, uint16_t first_item, uint16_t num_items), void * context);
+
+/**
+ * Set executor for multi-channel encode/decode
+ * @param parallel_for or NULL to process all channels on the calling thread
+ */
+void btstack_lc3_google_set_parallel_for(btstack_lc3_google_parallel_for_t parallel_for);
+
+/**
+ * Decode one LC3 Frame per channel into signed 16-bit samples
+ * @param contexts array of configured decoder contexts, one per channel
+ * @param num_channels
+ * @param bytes LC3 frame for channel i at bytes + i * bytes_stride
+ * @param bytes_stride
+ * @param BFI array of Bad Frame Indication flags, one per channel, or NULL
+ * @param pcm_out buffer for decoded PCM samples, channel i starts at pcm_out + i
+ * @param pcm_stride count between two consecutive samples of a channel, usually total number of channels
+ * @param BEC_detect array of Bit Error Detected flags, one per channel
+ * @return status of first failed channel or ERROR_CODE_SUCCESS
+ */
+uint8_t btstack_lc3_decoder_google_decode_channels_signed_16(btstack_lc3_decoder_google_t * contexts, uint8_t num_channels,
+                                                             const uint8_t * bytes, uint16_t bytes_stride, const uint8_t * BFI,
+                                                             int16_t * pcm_out, uint16_t pcm_stride, uint8_t * BEC_detect);
+
+/**
+ * Encode one LC3 Frame per channel from signed 16-bit samples
+ * @param contexts array of configured encoder contexts, one per channel
+ * @param num_channels
+ * @param pcm_in PCM samples, channel i starts at pcm_in + i
+ * @param pcm_stride count between two consecutive samples of a channel, usually total number of channels
+ * @param bytes LC3 frame for channel i is stored at bytes + i * bytes_stride
+ * @param bytes_stride
+ * @return status of first failed channel or ERROR_CODE_SUCCESS
+ */
+uint8_t btstack_lc3_encoder_google_encode_channels_signed_16(btstack_lc3_encoder_google_t * contexts, uint8_t num_channels,
+                                                             const int16_t * pcm_in, uint16_t pcm_stride,
+                                                             uint8_t * bytes, uint16_t bytes_stride);
+
 /* API_END */
 
 #if defined __cplusplus
@@ -46,6 +46,7 @@
  *
  *  @note code generated by tool/btstack_memory_generator.py
  *  @note returnes buffers are initialized with 0
+ *  @note with HAVE_MALLOC and ENABLE_BTSTACK_MEMORY_ARENA, buffers are allocated from one memory arena per type
  *
  */
 
@@ -60,7 +61,7 @@ void * test_malloc(size_t size);
 #define malloc test_malloc
 #endif
 
-#ifdef HAVE_MALLOC
+#if defined(HAVE_MALLOC) && !defined(ENABLE_BTSTACK_MEMORY_ARENA)
 typedef struct btstack_memory_buffer {
     struct btstack_memory_buffer * next;
     struct btstack_memory_buffer * prev;
@@ -103,18 +104,6 @@ static void btstack_memory_tracking_remove(btstack_memory_buffer_t * buffer){
 }
 #endif
 
-void btstack_memory_deinit(void){
-#ifdef HAVE_MALLOC
-    while (btstack_memory_malloc_buffers != NULL){
-        btstack_memory_buffer_t * buffer = btstack_memory_malloc_buffers;
-        btstack_memory_malloc_buffers = buffer->next;
-        free(buffer);
-        btstack_memory_malloc_counter--;
-    }
-    btstack_assert(btstack_memory_malloc_counter == 0);
-#endif
-}
-
 
 // MARK: hci_connection_t
 #if !defined(HAVE_MALLOC) && !defined(MAX_NR_HCI_CONNECTIONS)
@@ -147,6 +136,18 @@ void btstack_memory_hci_connection_free(hci_connection_t *hci_connection){
     UNUSED(hci_connection);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t hci_connection_arena;
+hci_connection_t * btstack_memory_hci_connection_get(void){
+    void * buffer = btstack_memory_arena_get(&hci_connection_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(hci_connection_t));
+    }
+    return (hci_connection_t *) buffer;
+}
+void btstack_memory_hci_connection_free(hci_connection_t *hci_connection){
+    btstack_memory_arena_free(&hci_connection_arena, hci_connection);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -205,6 +206,18 @@ void btstack_memory_l2cap_service_free(l2cap_service_t *l2cap_service){
     UNUSED(l2cap_service);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t l2cap_service_arena;
+l2cap_service_t * btstack_memory_l2cap_service_get(void){
+    void * buffer = btstack_memory_arena_get(&l2cap_service_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(l2cap_service_t));
+    }
+    return (l2cap_service_t *) buffer;
+}
+void btstack_memory_l2cap_service_free(l2cap_service_t *l2cap_service){
+    btstack_memory_arena_free(&l2cap_service_arena, l2cap_service);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -262,6 +275,18 @@ void btstack_memory_l2cap_channel_free(l2cap_channel_t *l2cap_channel){
     UNUSED(l2cap_channel);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t l2cap_channel_arena;
+l2cap_channel_t * btstack_memory_l2cap_channel_get(void){
+    void * buffer = btstack_memory_arena_get(&l2cap_channel_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(l2cap_channel_t));
+    }
+    return (l2cap_channel_t *) buffer;
+}
+void btstack_memory_l2cap_channel_free(l2cap_channel_t *l2cap_channel){
+    btstack_memory_arena_free(&l2cap_channel_arena, l2cap_channel);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -321,6 +346,18 @@ void btstack_memory_rfcomm_multiplexer_free(rfcomm_multiplexer_t *rfcomm_multipl
     UNUSED(rfcomm_multiplexer);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t rfcomm_multiplexer_arena;
+rfcomm_multiplexer_t * btstack_memory_rfcomm_multiplexer_get(void){
+    void * buffer = btstack_memory_arena_get(&rfcomm_multiplexer_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(rfcomm_multiplexer_t));
+    }
+    return (rfcomm_multiplexer_t *) buffer;
+}
+void btstack_memory_rfcomm_multiplexer_free(rfcomm_multiplexer_t *rfcomm_multiplexer){
+    btstack_memory_arena_free(&rfcomm_multiplexer_arena, rfcomm_multiplexer);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -378,6 +415,18 @@ void btstack_memory_rfcomm_service_free(rfcomm_service_t *rfcomm_service){
     UNUSED(rfcomm_service);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t rfcomm_service_arena;
+rfcomm_service_t * btstack_memory_rfcomm_service_get(void){
+    void * buffer = btstack_memory_arena_get(&rfcomm_service_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(rfcomm_service_t));
+    }
+    return (rfcomm_service_t *) buffer;
+}
+void btstack_memory_rfcomm_service_free(rfcomm_service_t *rfcomm_service){
+    btstack_memory_arena_free(&rfcomm_service_arena, rfcomm_service);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -435,6 +484,18 @@ void btstack_memory_rfcomm_channel_free(rfcomm_channel_t *rfcomm_channel){
     UNUSED(rfcomm_channel);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t rfcomm_channel_arena;
+rfcomm_channel_t * btstack_memory_rfcomm_channel_get(void){
+    void * buffer = btstack_memory_arena_get(&rfcomm_channel_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(rfcomm_channel_t));
+    }
+    return (rfcomm_channel_t *) buffer;
+}
+void btstack_memory_rfcomm_channel_free(rfcomm_channel_t *rfcomm_channel){
+    btstack_memory_arena_free(&rfcomm_channel_arena, rfcomm_channel);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -493,6 +554,18 @@ void btstack_memory_btstack_link_key_db_memory_entry_free(btstack_link_key_db_me
     UNUSED(btstack_link_key_db_memory_entry);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t btstack_link_key_db_memory_entry_arena;
+btstack_link_key_db_memory_entry_t * btstack_memory_btstack_link_key_db_memory_entry_get(void){
+    void * buffer = btstack_memory_arena_get(&btstack_link_key_db_memory_entry_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(btstack_link_key_db_memory_entry_t));
+    }
+    return (btstack_link_key_db_memory_entry_t *) buffer;
+}
+void btstack_memory_btstack_link_key_db_memory_entry_free(btstack_link_key_db_memory_entry_t *btstack_link_key_db_memory_entry){
+    btstack_memory_arena_free(&btstack_link_key_db_memory_entry_arena, btstack_link_key_db_memory_entry);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -551,6 +624,18 @@ void btstack_memory_bnep_service_free(bnep_service_t *bnep_service){
     UNUSED(bnep_service);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t bnep_service_arena;
+bnep_service_t * btstack_memory_bnep_service_get(void){
+    void * buffer = btstack_memory_arena_get(&bnep_service_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(bnep_service_t));
+    }
+    return (bnep_service_t *) buffer;
+}
+void btstack_memory_bnep_service_free(bnep_service_t *bnep_service){
+    btstack_memory_arena_free(&bnep_service_arena, bnep_service);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -608,6 +693,18 @@ void btstack_memory_bnep_channel_free(bnep_channel_t *bnep_channel){
     UNUSED(bnep_channel);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t bnep_channel_arena;
+bnep_channel_t * btstack_memory_bnep_channel_get(void){
+    void * buffer = btstack_memory_arena_get(&bnep_channel_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(bnep_channel_t));
+    }
+    return (bnep_channel_t *) buffer;
+}
+void btstack_memory_bnep_channel_free(bnep_channel_t *bnep_channel){
+    btstack_memory_arena_free(&bnep_channel_arena, bnep_channel);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -666,6 +763,18 @@ void btstack_memory_goep_server_service_free(goep_server_service_t *goep_server_
     UNUSED(goep_server_service);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t goep_server_service_arena;
+goep_server_service_t * btstack_memory_goep_server_service_get(void){
+    void * buffer = btstack_memory_arena_get(&goep_server_service_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(goep_server_service_t));
+    }
+    return (goep_server_service_t *) buffer;
+}
+void btstack_memory_goep_server_service_free(goep_server_service_t *goep_server_service){
+    btstack_memory_arena_free(&goep_server_service_arena, goep_server_service);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -723,6 +832,18 @@ void btstack_memory_goep_server_connection_free(goep_server_connection_t *goep_s
     UNUSED(goep_server_connection);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t goep_server_connection_arena;
+goep_server_connection_t * btstack_memory_goep_server_connection_get(void){
+    void * buffer = btstack_memory_arena_get(&goep_server_connection_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(goep_server_connection_t));
+    }
+    return (goep_server_connection_t *) buffer;
+}
+void btstack_memory_goep_server_connection_free(goep_server_connection_t *goep_server_connection){
+    btstack_memory_arena_free(&goep_server_connection_arena, goep_server_connection);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -781,6 +902,18 @@ void btstack_memory_hfp_connection_free(hfp_connection_t *hfp_connection){
     UNUSED(hfp_connection);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t hfp_connection_arena;
+hfp_connection_t * btstack_memory_hfp_connection_get(void){
+    void * buffer = btstack_memory_arena_get(&hfp_connection_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(hfp_connection_t));
+    }
+    return (hfp_connection_t *) buffer;
+}
+void btstack_memory_hfp_connection_free(hfp_connection_t *hfp_connection){
+    btstack_memory_arena_free(&hfp_connection_arena, hfp_connection);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -839,6 +972,18 @@ void btstack_memory_hid_host_connection_free(hid_host_connection_t *hid_host_con
     UNUSED(hid_host_connection);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t hid_host_connection_arena;
+hid_host_connection_t * btstack_memory_hid_host_connection_get(void){
+    void * buffer = btstack_memory_arena_get(&hid_host_connection_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(hid_host_connection_t));
+    }
+    return (hid_host_connection_t *) buffer;
+}
+void btstack_memory_hid_host_connection_free(hid_host_connection_t *hid_host_connection){
+    btstack_memory_arena_free(&hid_host_connection_arena, hid_host_connection);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -897,6 +1042,18 @@ void btstack_memory_service_record_item_free(service_record_item_t *service_reco
     UNUSED(service_record_item);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t service_record_item_arena;
+service_record_item_t * btstack_memory_service_record_item_get(void){
+    void * buffer = btstack_memory_arena_get(&service_record_item_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(service_record_item_t));
+    }
+    return (service_record_item_t *) buffer;
+}
+void btstack_memory_service_record_item_free(service_record_item_t *service_record_item){
+    btstack_memory_arena_free(&service_record_item_arena, service_record_item);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -955,6 +1112,18 @@ void btstack_memory_avdtp_stream_endpoint_free(avdtp_stream_endpoint_t *avdtp_st
     UNUSED(avdtp_stream_endpoint);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t avdtp_stream_endpoint_arena;
+avdtp_stream_endpoint_t * btstack_memory_avdtp_stream_endpoint_get(void){
+    void * buffer = btstack_memory_arena_get(&avdtp_stream_endpoint_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(avdtp_stream_endpoint_t));
+    }
+    return (avdtp_stream_endpoint_t *) buffer;
+}
+void btstack_memory_avdtp_stream_endpoint_free(avdtp_stream_endpoint_t *avdtp_stream_endpoint){
+    btstack_memory_arena_free(&avdtp_stream_endpoint_arena, avdtp_stream_endpoint);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1013,6 +1182,18 @@ void btstack_memory_avdtp_connection_free(avdtp_connection_t *avdtp_connection){
     UNUSED(avdtp_connection);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t avdtp_connection_arena;
+avdtp_connection_t * btstack_memory_avdtp_connection_get(void){
+    void * buffer = btstack_memory_arena_get(&avdtp_connection_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(avdtp_connection_t));
+    }
+    return (avdtp_connection_t *) buffer;
+}
+void btstack_memory_avdtp_connection_free(avdtp_connection_t *avdtp_connection){
+    btstack_memory_arena_free(&avdtp_connection_arena, avdtp_connection);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1071,6 +1252,18 @@ void btstack_memory_avrcp_connection_free(avrcp_connection_t *avrcp_connection){
     UNUSED(avrcp_connection);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t avrcp_connection_arena;
+avrcp_connection_t * btstack_memory_avrcp_connection_get(void){
+    void * buffer = btstack_memory_arena_get(&avrcp_connection_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(avrcp_connection_t));
+    }
+    return (avrcp_connection_t *) buffer;
+}
+void btstack_memory_avrcp_connection_free(avrcp_connection_t *avrcp_connection){
+    btstack_memory_arena_free(&avrcp_connection_arena, avrcp_connection);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1129,6 +1322,18 @@ void btstack_memory_avrcp_browsing_connection_free(avrcp_browsing_connection_t *
     UNUSED(avrcp_browsing_connection);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t avrcp_browsing_connection_arena;
+avrcp_browsing_connection_t * btstack_memory_avrcp_browsing_connection_get(void){
+    void * buffer = btstack_memory_arena_get(&avrcp_browsing_connection_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(avrcp_browsing_connection_t));
+    }
+    return (avrcp_browsing_connection_t *) buffer;
+}
+void btstack_memory_avrcp_browsing_connection_free(avrcp_browsing_connection_t *avrcp_browsing_connection){
+    btstack_memory_arena_free(&avrcp_browsing_connection_arena, avrcp_browsing_connection);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1189,6 +1394,18 @@ void btstack_memory_battery_service_client_free(battery_service_client_t *batter
     UNUSED(battery_service_client);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t battery_service_client_arena;
+battery_service_client_t * btstack_memory_battery_service_client_get(void){
+    void * buffer = btstack_memory_arena_get(&battery_service_client_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(battery_service_client_t));
+    }
+    return (battery_service_client_t *) buffer;
+}
+void btstack_memory_battery_service_client_free(battery_service_client_t *battery_service_client){
+    btstack_memory_arena_free(&battery_service_client_arena, battery_service_client);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1246,6 +1463,18 @@ void btstack_memory_gatt_client_free(gatt_client_t *gatt_client){
     UNUSED(gatt_client);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t gatt_client_arena;
+gatt_client_t * btstack_memory_gatt_client_get(void){
+    void * buffer = btstack_memory_arena_get(&gatt_client_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(gatt_client_t));
+    }
+    return (gatt_client_t *) buffer;
+}
+void btstack_memory_gatt_client_free(gatt_client_t *gatt_client){
+    btstack_memory_arena_free(&gatt_client_arena, gatt_client);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1303,6 +1532,18 @@ void btstack_memory_hids_client_free(hids_client_t *hids_client){
     UNUSED(hids_client);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t hids_client_arena;
+hids_client_t * btstack_memory_hids_client_get(void){
+    void * buffer = btstack_memory_arena_get(&hids_client_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(hids_client_t));
+    }
+    return (hids_client_t *) buffer;
+}
+void btstack_memory_hids_client_free(hids_client_t *hids_client){
+    btstack_memory_arena_free(&hids_client_arena, hids_client);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1360,6 +1601,18 @@ void btstack_memory_scan_parameters_service_client_free(scan_parameters_service_
     UNUSED(scan_parameters_service_client);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t scan_parameters_service_client_arena;
+scan_parameters_service_client_t * btstack_memory_scan_parameters_service_client_get(void){
+    void * buffer = btstack_memory_arena_get(&scan_parameters_service_client_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(scan_parameters_service_client_t));
+    }
+    return (scan_parameters_service_client_t *) buffer;
+}
+void btstack_memory_scan_parameters_service_client_free(scan_parameters_service_client_t *scan_parameters_service_client){
+    btstack_memory_arena_free(&scan_parameters_service_client_arena, scan_parameters_service_client);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1417,6 +1670,18 @@ void btstack_memory_sm_lookup_entry_free(sm_lookup_entry_t *sm_lookup_entry){
     UNUSED(sm_lookup_entry);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t sm_lookup_entry_arena;
+sm_lookup_entry_t * btstack_memory_sm_lookup_entry_get(void){
+    void * buffer = btstack_memory_arena_get(&sm_lookup_entry_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(sm_lookup_entry_t));
+    }
+    return (sm_lookup_entry_t *) buffer;
+}
+void btstack_memory_sm_lookup_entry_free(sm_lookup_entry_t *sm_lookup_entry){
+    btstack_memory_arena_free(&sm_lookup_entry_arena, sm_lookup_entry);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1474,6 +1739,18 @@ void btstack_memory_whitelist_entry_free(whitelist_entry_t *whitelist_entry){
     UNUSED(whitelist_entry);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t whitelist_entry_arena;
+whitelist_entry_t * btstack_memory_whitelist_entry_get(void){
+    void * buffer = btstack_memory_arena_get(&whitelist_entry_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(whitelist_entry_t));
+    }
+    return (whitelist_entry_t *) buffer;
+}
+void btstack_memory_whitelist_entry_free(whitelist_entry_t *whitelist_entry){
+    btstack_memory_arena_free(&whitelist_entry_arena, whitelist_entry);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1531,6 +1808,18 @@ void btstack_memory_periodic_advertiser_list_entry_free(periodic_advertiser_list
     UNUSED(periodic_advertiser_list_entry);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t periodic_advertiser_list_entry_arena;
+periodic_advertiser_list_entry_t * btstack_memory_periodic_advertiser_list_entry_get(void){
+    void * buffer = btstack_memory_arena_get(&periodic_advertiser_list_entry_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(periodic_advertiser_list_entry_t));
+    }
+    return (periodic_advertiser_list_entry_t *) buffer;
+}
+void btstack_memory_periodic_advertiser_list_entry_free(periodic_advertiser_list_entry_t *periodic_advertiser_list_entry){
+    btstack_memory_arena_free(&periodic_advertiser_list_entry_arena, periodic_advertiser_list_entry);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1591,6 +1880,18 @@ void btstack_memory_mesh_network_pdu_free(mesh_network_pdu_t *mesh_network_pdu){
     UNUSED(mesh_network_pdu);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t mesh_network_pdu_arena;
+mesh_network_pdu_t * btstack_memory_mesh_network_pdu_get(void){
+    void * buffer = btstack_memory_arena_get(&mesh_network_pdu_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(mesh_network_pdu_t));
+    }
+    return (mesh_network_pdu_t *) buffer;
+}
+void btstack_memory_mesh_network_pdu_free(mesh_network_pdu_t *mesh_network_pdu){
+    btstack_memory_arena_free(&mesh_network_pdu_arena, mesh_network_pdu);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1648,6 +1949,18 @@ void btstack_memory_mesh_segmented_pdu_free(mesh_segmented_pdu_t *mesh_segmented
     UNUSED(mesh_segmented_pdu);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t mesh_segmented_pdu_arena;
+mesh_segmented_pdu_t * btstack_memory_mesh_segmented_pdu_get(void){
+    void * buffer = btstack_memory_arena_get(&mesh_segmented_pdu_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(mesh_segmented_pdu_t));
+    }
+    return (mesh_segmented_pdu_t *) buffer;
+}
+void btstack_memory_mesh_segmented_pdu_free(mesh_segmented_pdu_t *mesh_segmented_pdu){
+    btstack_memory_arena_free(&mesh_segmented_pdu_arena, mesh_segmented_pdu);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1705,6 +2018,18 @@ void btstack_memory_mesh_upper_transport_pdu_free(mesh_upper_transport_pdu_t *me
     UNUSED(mesh_upper_transport_pdu);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t mesh_upper_transport_pdu_arena;
+mesh_upper_transport_pdu_t * btstack_memory_mesh_upper_transport_pdu_get(void){
+    void * buffer = btstack_memory_arena_get(&mesh_upper_transport_pdu_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(mesh_upper_transport_pdu_t));
+    }
+    return (mesh_upper_transport_pdu_t *) buffer;
+}
+void btstack_memory_mesh_upper_transport_pdu_free(mesh_upper_transport_pdu_t *mesh_upper_transport_pdu){
+    btstack_memory_arena_free(&mesh_upper_transport_pdu_arena, mesh_upper_transport_pdu);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1762,6 +2087,18 @@ void btstack_memory_mesh_network_key_free(mesh_network_key_t *mesh_network_key){
     UNUSED(mesh_network_key);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t mesh_network_key_arena;
+mesh_network_key_t * btstack_memory_mesh_network_key_get(void){
+    void * buffer = btstack_memory_arena_get(&mesh_network_key_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(mesh_network_key_t));
+    }
+    return (mesh_network_key_t *) buffer;
+}
+void btstack_memory_mesh_network_key_free(mesh_network_key_t *mesh_network_key){
+    btstack_memory_arena_free(&mesh_network_key_arena, mesh_network_key);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1819,6 +2156,18 @@ void btstack_memory_mesh_transport_key_free(mesh_transport_key_t *mesh_transport
     UNUSED(mesh_transport_key);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t mesh_transport_key_arena;
+mesh_transport_key_t * btstack_memory_mesh_transport_key_get(void){
+    void * buffer = btstack_memory_arena_get(&mesh_transport_key_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(mesh_transport_key_t));
+    }
+    return (mesh_transport_key_t *) buffer;
+}
+void btstack_memory_mesh_transport_key_free(mesh_transport_key_t *mesh_transport_key){
+    btstack_memory_arena_free(&mesh_transport_key_arena, mesh_transport_key);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1876,6 +2225,18 @@ void btstack_memory_mesh_virtual_address_free(mesh_virtual_address_t *mesh_virtu
     UNUSED(mesh_virtual_address);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t mesh_virtual_address_arena;
+mesh_virtual_address_t * btstack_memory_mesh_virtual_address_get(void){
+    void * buffer = btstack_memory_arena_get(&mesh_virtual_address_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(mesh_virtual_address_t));
+    }
+    return (mesh_virtual_address_t *) buffer;
+}
+void btstack_memory_mesh_virtual_address_free(mesh_virtual_address_t *mesh_virtual_address){
+    btstack_memory_arena_free(&mesh_virtual_address_arena, mesh_virtual_address);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1933,6 +2294,18 @@ void btstack_memory_mesh_subnet_free(mesh_subnet_t *mesh_subnet){
     UNUSED(mesh_subnet);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t mesh_subnet_arena;
+mesh_subnet_t * btstack_memory_mesh_subnet_get(void){
+    void * buffer = btstack_memory_arena_get(&mesh_subnet_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(mesh_subnet_t));
+    }
+    return (mesh_subnet_t *) buffer;
+}
+void btstack_memory_mesh_subnet_free(mesh_subnet_t *mesh_subnet){
+    btstack_memory_arena_free(&mesh_subnet_arena, mesh_subnet);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -1993,6 +2366,18 @@ void btstack_memory_hci_iso_stream_free(hci_iso_stream_t *hci_iso_stream){
     UNUSED(hci_iso_stream);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t hci_iso_stream_arena;
+hci_iso_stream_t * btstack_memory_hci_iso_stream_get(void){
+    void * buffer = btstack_memory_arena_get(&hci_iso_stream_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(hci_iso_stream_t));
+    }
+    return (hci_iso_stream_t *) buffer;
+}
+void btstack_memory_hci_iso_stream_free(hci_iso_stream_t *hci_iso_stream){
+    btstack_memory_arena_free(&hci_iso_stream_arena, hci_iso_stream);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -2023,7 +2408,7 @@ void btstack_memory_hci_iso_stream_free(hci_iso_stream_t *hci_iso_stream){
 
 // init
 void btstack_memory_init(void){
-#ifdef HAVE_MALLOC
+#if defined(HAVE_MALLOC) && !defined(ENABLE_BTSTACK_MEMORY_ARENA)
     // assert that there is no unexpected padding for combined buffer
     btstack_assert(sizeof(test_buffer_t) == sizeof(btstack_memory_buffer_t) + sizeof(void *));
 #endif
@@ -2031,124 +2416,365 @@ void btstack_memory_init(void){
 #if MAX_NR_HCI_CONNECTIONS > 0
     btstack_memory_pool_create(&hci_connection_pool, hci_connection_storage, MAX_NR_HCI_CONNECTIONS, sizeof(hci_connection_t));
 #endif
+#if !defined(MAX_NR_HCI_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&hci_connection_arena, "hci_connection", sizeof(hci_connection_t));
+#endif
 
 #if MAX_NR_L2CAP_SERVICES > 0
     btstack_memory_pool_create(&l2cap_service_pool, l2cap_service_storage, MAX_NR_L2CAP_SERVICES, sizeof(l2cap_service_t));
 #endif
+#if !defined(MAX_NR_L2CAP_SERVICES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&l2cap_service_arena, "l2cap_service", sizeof(l2cap_service_t));
+#endif
 #if MAX_NR_L2CAP_CHANNELS > 0
     btstack_memory_pool_create(&l2cap_channel_pool, l2cap_channel_storage, MAX_NR_L2CAP_CHANNELS, sizeof(l2cap_channel_t));
 #endif
+#if !defined(MAX_NR_L2CAP_CHANNELS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&l2cap_channel_arena, "l2cap_channel", sizeof(l2cap_channel_t));
+#endif
 
 #ifdef ENABLE_CLASSIC
 #if MAX_NR_RFCOMM_MULTIPLEXERS > 0
     btstack_memory_pool_create(&rfcomm_multiplexer_pool, rfcomm_multiplexer_storage, MAX_NR_RFCOMM_MULTIPLEXERS, sizeof(rfcomm_multiplexer_t));
 #endif
+#if !defined(MAX_NR_RFCOMM_MULTIPLEXERS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&rfcomm_multiplexer_arena, "rfcomm_multiplexer", sizeof(rfcomm_multiplexer_t));
+#endif
 #if MAX_NR_RFCOMM_SERVICES > 0
     btstack_memory_pool_create(&rfcomm_service_pool, rfcomm_service_storage, MAX_NR_RFCOMM_SERVICES, sizeof(rfcomm_service_t));
 #endif
+#if !defined(MAX_NR_RFCOMM_SERVICES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&rfcomm_service_arena, "rfcomm_service", sizeof(rfcomm_service_t));
+#endif
 #if MAX_NR_RFCOMM_CHANNELS > 0
     btstack_memory_pool_create(&rfcomm_channel_pool, rfcomm_channel_storage, MAX_NR_RFCOMM_CHANNELS, sizeof(rfcomm_channel_t));
 #endif
+#if !defined(MAX_NR_RFCOMM_CHANNELS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&rfcomm_channel_arena, "rfcomm_channel", sizeof(rfcomm_channel_t));
+#endif
 
 #if MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES > 0
     btstack_memory_pool_create(&btstack_link_key_db_memory_entry_pool, btstack_link_key_db_memory_entry_storage, MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES, sizeof(btstack_link_key_db_memory_entry_t));
 #endif
+#if !defined(MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&btstack_link_key_db_memory_entry_arena, "btstack_link_key_db_memory_entry", sizeof(btstack_link_key_db_memory_entry_t));
+#endif
 
 #if MAX_NR_BNEP_SERVICES > 0
     btstack_memory_pool_create(&bnep_service_pool, bnep_service_storage, MAX_NR_BNEP_SERVICES, sizeof(bnep_service_t));
 #endif
+#if !defined(MAX_NR_BNEP_SERVICES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&bnep_service_arena, "bnep_service", sizeof(bnep_service_t));
+#endif
 #if MAX_NR_BNEP_CHANNELS > 0
     btstack_memory_pool_create(&bnep_channel_pool, bnep_channel_storage, MAX_NR_BNEP_CHANNELS, sizeof(bnep_channel_t));
 #endif
+#if !defined(MAX_NR_BNEP_CHANNELS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&bnep_channel_arena, "bnep_channel", sizeof(bnep_channel_t));
+#endif
 
 #if MAX_NR_GOEP_SERVER_SERVICES > 0
     btstack_memory_pool_create(&goep_server_service_pool, goep_server_service_storage, MAX_NR_GOEP_SERVER_SERVICES, sizeof(goep_server_service_t));
 #endif
+#if !defined(MAX_NR_GOEP_SERVER_SERVICES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&goep_server_service_arena, "goep_server_service", sizeof(goep_server_service_t));
+#endif
 #if MAX_NR_GOEP_SERVER_CONNECTIONS > 0
     btstack_memory_pool_create(&goep_server_connection_pool, goep_server_connection_storage, MAX_NR_GOEP_SERVER_CONNECTIONS, sizeof(goep_server_connection_t));
 #endif
+#if !defined(MAX_NR_GOEP_SERVER_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&goep_server_connection_arena, "goep_server_connection", sizeof(goep_server_connection_t));
+#endif
 
 #if MAX_NR_HFP_CONNECTIONS > 0
     btstack_memory_pool_create(&hfp_connection_pool, hfp_connection_storage, MAX_NR_HFP_CONNECTIONS, sizeof(hfp_connection_t));
 #endif
+#if !defined(MAX_NR_HFP_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&hfp_connection_arena, "hfp_connection", sizeof(hfp_connection_t));
+#endif
 
 #if MAX_NR_HID_HOST_CONNECTIONS > 0
     btstack_memory_pool_create(&hid_host_connection_pool, hid_host_connection_storage, MAX_NR_HID_HOST_CONNECTIONS, sizeof(hid_host_connection_t));
 #endif
+#if !defined(MAX_NR_HID_HOST_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&hid_host_connection_arena, "hid_host_connection", sizeof(hid_host_connection_t));
+#endif
 
 #if MAX_NR_SERVICE_RECORD_ITEMS > 0
     btstack_memory_pool_create(&service_record_item_pool, service_record_item_storage, MAX_NR_SERVICE_RECORD_ITEMS, sizeof(service_record_item_t));
 #endif
+#if !defined(MAX_NR_SERVICE_RECORD_ITEMS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&service_record_item_arena, "service_record_item", sizeof(service_record_item_t));
+#endif
 
 #if MAX_NR_AVDTP_STREAM_ENDPOINTS > 0
     btstack_memory_pool_create(&avdtp_stream_endpoint_pool, avdtp_stream_endpoint_storage, MAX_NR_AVDTP_STREAM_ENDPOINTS, sizeof(avdtp_stream_endpoint_t));
 #endif
+#if !defined(MAX_NR_AVDTP_STREAM_ENDPOINTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&avdtp_stream_endpoint_arena, "avdtp_stream_endpoint", sizeof(avdtp_stream_endpoint_t));
+#endif
 
 #if MAX_NR_AVDTP_CONNECTIONS > 0
     btstack_memory_pool_create(&avdtp_connection_pool, avdtp_connection_storage, MAX_NR_AVDTP_CONNECTIONS, sizeof(avdtp_connection_t));
 #endif
+#if !defined(MAX_NR_AVDTP_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&avdtp_connection_arena, "avdtp_connection", sizeof(avdtp_connection_t));
+#endif
 
 #if MAX_NR_AVRCP_CONNECTIONS > 0
     btstack_memory_pool_create(&avrcp_connection_pool, avrcp_connection_storage, MAX_NR_AVRCP_CONNECTIONS, sizeof(avrcp_connection_t));
 #endif
+#if !defined(MAX_NR_AVRCP_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&avrcp_connection_arena, "avrcp_connection", sizeof(avrcp_connection_t));
+#endif
 
 #if MAX_NR_AVRCP_BROWSING_CONNECTIONS > 0
     btstack_memory_pool_create(&avrcp_browsing_connection_pool, avrcp_browsing_connection_storage, MAX_NR_AVRCP_BROWSING_CONNECTIONS, sizeof(avrcp_browsing_connection_t));
 #endif
+#if !defined(MAX_NR_AVRCP_BROWSING_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&avrcp_browsing_connection_arena, "avrcp_browsing_connection", sizeof(avrcp_browsing_connection_t));
+#endif
 
 #endif
 #ifdef ENABLE_BLE
 #if MAX_NR_BATTERY_SERVICE_CLIENTS > 0
     btstack_memory_pool_create(&battery_service_client_pool, battery_service_client_storage, MAX_NR_BATTERY_SERVICE_CLIENTS, sizeof(battery_service_client_t));
 #endif
+#if !defined(MAX_NR_BATTERY_SERVICE_CLIENTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&battery_service_client_arena, "battery_service_client", sizeof(battery_service_client_t));
+#endif
 #if MAX_NR_GATT_CLIENTS > 0
     btstack_memory_pool_create(&gatt_client_pool, gatt_client_storage, MAX_NR_GATT_CLIENTS, sizeof(gatt_client_t));
 #endif
+#if !defined(MAX_NR_GATT_CLIENTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&gatt_client_arena, "gatt_client", sizeof(gatt_client_t));
+#endif
 #if MAX_NR_HIDS_CLIENTS > 0
     btstack_memory_pool_create(&hids_client_pool, hids_client_storage, MAX_NR_HIDS_CLIENTS, sizeof(hids_client_t));
 #endif
+#if !defined(MAX_NR_HIDS_CLIENTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&hids_client_arena, "hids_client", sizeof(hids_client_t));
+#endif
 #if MAX_NR_SCAN_PARAMETERS_SERVICE_CLIENTS > 0
     btstack_memory_pool_create(&scan_parameters_service_client_pool, scan_parameters_service_client_storage, MAX_NR_SCAN_PARAMETERS_SERVICE_CLIENTS, sizeof(scan_parameters_service_client_t));
 #endif
+#if !defined(MAX_NR_SCAN_PARAMETERS_SERVICE_CLIENTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&scan_parameters_service_client_arena, "scan_parameters_service_client", sizeof(scan_parameters_service_client_t));
+#endif
 #if MAX_NR_SM_LOOKUP_ENTRIES > 0
     btstack_memory_pool_create(&sm_lookup_entry_pool, sm_lookup_entry_storage, MAX_NR_SM_LOOKUP_ENTRIES, sizeof(sm_lookup_entry_t));
 #endif
+#if !defined(MAX_NR_SM_LOOKUP_ENTRIES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&sm_lookup_entry_arena, "sm_lookup_entry", sizeof(sm_lookup_entry_t));
+#endif
 #if MAX_NR_WHITELIST_ENTRIES > 0
     btstack_memory_pool_create(&whitelist_entry_pool, whitelist_entry_storage, MAX_NR_WHITELIST_ENTRIES, sizeof(whitelist_entry_t));
 #endif
+#if !defined(MAX_NR_WHITELIST_ENTRIES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&whitelist_entry_arena, "whitelist_entry", sizeof(whitelist_entry_t));
+#endif
 #if MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES > 0
     btstack_memory_pool_create(&periodic_advertiser_list_entry_pool, periodic_advertiser_list_entry_storage, MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES, sizeof(periodic_advertiser_list_entry_t));
 #endif
+#if !defined(MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&periodic_advertiser_list_entry_arena, "periodic_advertiser_list_entry", sizeof(periodic_advertiser_list_entry_t));
+#endif
 
 #endif
 #ifdef ENABLE_MESH
 #if MAX_NR_MESH_NETWORK_PDUS > 0
     btstack_memory_pool_create(&mesh_network_pdu_pool, mesh_network_pdu_storage, MAX_NR_MESH_NETWORK_PDUS, sizeof(mesh_network_pdu_t));
 #endif
+#if !defined(MAX_NR_MESH_NETWORK_PDUS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&mesh_network_pdu_arena, "mesh_network_pdu", sizeof(mesh_network_pdu_t));
+#endif
 #if MAX_NR_MESH_SEGMENTED_PDUS > 0
     btstack_memory_pool_create(&mesh_segmented_pdu_pool, mesh_segmented_pdu_storage, MAX_NR_MESH_SEGMENTED_PDUS, sizeof(mesh_segmented_pdu_t));
 #endif
+#if !defined(MAX_NR_MESH_SEGMENTED_PDUS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&mesh_segmented_pdu_arena, "mesh_segmented_pdu", sizeof(mesh_segmented_pdu_t));
+#endif
 #if MAX_NR_MESH_UPPER_TRANSPORT_PDUS > 0
     btstack_memory_pool_create(&mesh_upper_transport_pdu_pool, mesh_upper_transport_pdu_storage, MAX_NR_MESH_UPPER_TRANSPORT_PDUS, sizeof(mesh_upper_transport_pdu_t));
 #endif
+#if !defined(MAX_NR_MESH_UPPER_TRANSPORT_PDUS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&mesh_upper_transport_pdu_arena, "mesh_upper_transport_pdu", sizeof(mesh_upper_transport_pdu_t));
+#endif
 #if MAX_NR_MESH_NETWORK_KEYS > 0
     btstack_memory_pool_create(&mesh_network_key_pool, mesh_network_key_storage, MAX_NR_MESH_NETWORK_KEYS, sizeof(mesh_network_key_t));
 #endif
+#if !defined(MAX_NR_MESH_NETWORK_KEYS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&mesh_network_key_arena, "mesh_network_key", sizeof(mesh_network_key_t));
+#endif
 #if MAX_NR_MESH_TRANSPORT_KEYS > 0
     btstack_memory_pool_create(&mesh_transport_key_pool, mesh_transport_key_storage, MAX_NR_MESH_TRANSPORT_KEYS, sizeof(mesh_transport_key_t));
 #endif
+#if !defined(MAX_NR_MESH_TRANSPORT_KEYS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&mesh_transport_key_arena, "mesh_transport_key", sizeof(mesh_transport_key_t));
+#endif
 #if MAX_NR_MESH_VIRTUAL_ADDRESSS > 0
     btstack_memory_pool_create(&mesh_virtual_address_pool, mesh_virtual_address_storage, MAX_NR_MESH_VIRTUAL_ADDRESSS, sizeof(mesh_virtual_address_t));
 #endif
+#if !defined(MAX_NR_MESH_VIRTUAL_ADDRESSS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&mesh_virtual_address_arena, "mesh_virtual_address", sizeof(mesh_virtual_address_t));
+#endif
 #if MAX_NR_MESH_SUBNETS > 0
     btstack_memory_pool_create(&mesh_subnet_pool, mesh_subnet_storage, MAX_NR_MESH_SUBNETS, sizeof(mesh_subnet_t));
 #endif
+#if !defined(MAX_NR_MESH_SUBNETS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&mesh_subnet_arena, "mesh_subnet", sizeof(mesh_subnet_t));
+#endif
 
 #endif
 #ifdef ENABLE_LE_ISOCHRONOUS_STREAMS
 #if MAX_NR_HCI_ISO_STREAMS > 0
     btstack_memory_pool_create(&hci_iso_stream_pool, hci_iso_stream_storage, MAX_NR_HCI_ISO_STREAMS, sizeof(hci_iso_stream_t));
 #endif
+#if !defined(MAX_NR_HCI_ISO_STREAMS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&hci_iso_stream_arena, "hci_iso_stream", sizeof(hci_iso_stream_t));
+#endif
+
+#endif
+}
+
+// deinit
+void btstack_memory_deinit(void){
+#if defined(HAVE_MALLOC) && !defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    while (btstack_memory_malloc_buffers != NULL){
+        btstack_memory_buffer_t * buffer = btstack_memory_malloc_buffers;
+        btstack_memory_malloc_buffers = buffer->next;
+        free(buffer);
+        btstack_memory_malloc_counter--;
+    }
+    btstack_assert(btstack_memory_malloc_counter == 0);
+#endif
+#if !defined(MAX_NR_HCI_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&hci_connection_arena);
+#endif
+
+#if !defined(MAX_NR_L2CAP_SERVICES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&l2cap_service_arena);
+#endif
+#if !defined(MAX_NR_L2CAP_CHANNELS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&l2cap_channel_arena);
+#endif
+
+#ifdef ENABLE_CLASSIC
+#if !defined(MAX_NR_RFCOMM_MULTIPLEXERS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&rfcomm_multiplexer_arena);
+#endif
+#if !defined(MAX_NR_RFCOMM_SERVICES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&rfcomm_service_arena);
+#endif
+#if !defined(MAX_NR_RFCOMM_CHANNELS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&rfcomm_channel_arena);
+#endif
+
+#if !defined(MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&btstack_link_key_db_memory_entry_arena);
+#endif
+
+#if !defined(MAX_NR_BNEP_SERVICES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&bnep_service_arena);
+#endif
+#if !defined(MAX_NR_BNEP_CHANNELS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&bnep_channel_arena);
+#endif
+
+#if !defined(MAX_NR_GOEP_SERVER_SERVICES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&goep_server_service_arena);
+#endif
+#if !defined(MAX_NR_GOEP_SERVER_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&goep_server_connection_arena);
+#endif
+
+#if !defined(MAX_NR_HFP_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&hfp_connection_arena);
+#endif
+
+#if !defined(MAX_NR_HID_HOST_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&hid_host_connection_arena);
+#endif
+
+#if !defined(MAX_NR_SERVICE_RECORD_ITEMS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&service_record_item_arena);
+#endif
+
+#if !defined(MAX_NR_AVDTP_STREAM_ENDPOINTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&avdtp_stream_endpoint_arena);
+#endif
+
+#if !defined(MAX_NR_AVDTP_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&avdtp_connection_arena);
+#endif
+
+#if !defined(MAX_NR_AVRCP_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&avrcp_connection_arena);
+#endif
+
+#if !defined(MAX_NR_AVRCP_BROWSING_CONNECTIONS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&avrcp_browsing_connection_arena);
+#endif
+
+#endif
+#ifdef ENABLE_BLE
+#if !defined(MAX_NR_BATTERY_SERVICE_CLIENTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&battery_service_client_arena);
+#endif
+#if !defined(MAX_NR_GATT_CLIENTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&gatt_client_arena);
+#endif
+#if !defined(MAX_NR_HIDS_CLIENTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&hids_client_arena);
+#endif
+#if !defined(MAX_NR_SCAN_PARAMETERS_SERVICE_CLIENTS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&scan_parameters_service_client_arena);
+#endif
+#if !defined(MAX_NR_SM_LOOKUP_ENTRIES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&sm_lookup_entry_arena);
+#endif
+#if !defined(MAX_NR_WHITELIST_ENTRIES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&whitelist_entry_arena);
+#endif
+#if !defined(MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&periodic_advertiser_list_entry_arena);
+#endif
+
+#endif
+#ifdef ENABLE_MESH
+#if !defined(MAX_NR_MESH_NETWORK_PDUS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&mesh_network_pdu_arena);
+#endif
+#if !defined(MAX_NR_MESH_SEGMENTED_PDUS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&mesh_segmented_pdu_arena);
+#endif
+#if !defined(MAX_NR_MESH_UPPER_TRANSPORT_PDUS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&mesh_upper_transport_pdu_arena);
+#endif
+#if !defined(MAX_NR_MESH_NETWORK_KEYS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&mesh_network_key_arena);
+#endif
+#if !defined(MAX_NR_MESH_TRANSPORT_KEYS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&mesh_transport_key_arena);
+#endif
+#if !defined(MAX_NR_MESH_VIRTUAL_ADDRESSS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&mesh_virtual_address_arena);
+#endif
+#if !defined(MAX_NR_MESH_SUBNETS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&mesh_subnet_arena);
+#endif
+
+#endif
+#ifdef ENABLE_LE_ISOCHRONOUS_STREAMS
+#if !defined(MAX_NR_HCI_ISO_STREAMS) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&hci_iso_stream_arena);
+#endif
+
+#endif
+}
 
+void btstack_memory_log_usage(void){
+#if defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arenas_log_usage();
 #endif
 }
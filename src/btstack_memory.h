@@ -100,6 +100,12 @@ void btstack_memory_init(void);
  */
 void btstack_memory_deinit(void);
 
+/**
+ * @brief Log usage statistics of BTstack memory arenas
+ * @note only available with HAVE_MALLOC and ENABLE_BTSTACK_MEMORY_ARENA
+ */
+void btstack_memory_log_usage(void);
+
 /* API_END */
 
 hci_connection_t * btstack_memory_hci_connection_get(void);
@@ -51,6 +51,15 @@
 #include <stddef.h>
 #include "btstack_debug.h"
 
+#ifdef HAVE_MALLOC
+#include <stdlib.h>
+
+#ifdef ENABLE_MALLOC_TEST
+void * test_malloc(size_t size);
+#define malloc test_malloc
+#endif
+#endif
+
 typedef struct node {
     struct node * next;
 } node_t;
@@ -94,3 +103,122 @@ void btstack_memory_pool_free(btstack_memory_pool_t *pool, void * block){
     node->next          = free_blocks->next;
     free_blocks->next   = node;
 }
+
+#if defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+
+// blocks and slab header are aligned to 8 bytes or pointer size, whatever is larger
+#define BTSTACK_MEMORY_ARENA_ALIGNMENT ((sizeof(void *) > 8u) ? sizeof(void *) : 8u)
+
+static btstack_linked_list_t btstack_memory_arenas;
+
+static uint32_t btstack_memory_arena_align(uint32_t size){
+    return (uint32_t) (((size + BTSTACK_MEMORY_ARENA_ALIGNMENT - 1u) / BTSTACK_MEMORY_ARENA_ALIGNMENT) * BTSTACK_MEMORY_ARENA_ALIGNMENT);
+}
+
+// all arenas and the list of arenas are protected by a single lock
+static void btstack_memory_arenas_lock(void){
+#ifdef ENABLE_BTSTACK_MEMORY_ARENA_THREAD_SAFE
+    btstack_memory_arena_lock();
+#endif
+}
+
+static void btstack_memory_arenas_unlock(void){
+#ifdef ENABLE_BTSTACK_MEMORY_ARENA_THREAD_SAFE
+    btstack_memory_arena_unlock();
+#endif
+}
+
+void btstack_memory_arena_init(btstack_memory_arena_t * arena, const char * name, uint32_t block_size){
+    btstack_assert(block_size > 0u);
+    arena->name = name;
+    arena->block_size = btstack_memory_arena_align(block_size);
+    arena->free_blocks = NULL;
+    arena->slabs = NULL;
+    arena->num_blocks_in_use = 0;
+    arena->high_water_mark = 0;
+    arena->num_allocations = 0;
+    arena->num_slabs = 0;
+    btstack_memory_arenas_lock();
+    btstack_linked_list_add(&btstack_memory_arenas, (btstack_linked_item_t *) arena);
+    btstack_memory_arenas_unlock();
+}
+
+// add slab and put its blocks into free list
+static bool btstack_memory_arena_grow(btstack_memory_arena_t * arena){
+    uint32_t header_size = btstack_memory_arena_align(sizeof(btstack_memory_arena_slab_t));
+    uint8_t * storage = (uint8_t *) malloc(header_size + (BTSTACK_MEMORY_ARENA_BLOCKS_PER_SLAB * arena->block_size));
+    if (storage == NULL) return false;
+
+    btstack_memory_arena_slab_t * slab = (btstack_memory_arena_slab_t *) storage;
+    slab->next = arena->slabs;
+    arena->slabs = slab;
+    arena->num_slabs++;
+
+    uint8_t * block = &storage[header_size];
+    uint32_t i;
+    for (i = 0; i < BTSTACK_MEMORY_ARENA_BLOCKS_PER_SLAB; i++){
+        *(void **) block = arena->free_blocks;
+        arena->free_blocks = block;
+        block += arena->block_size;
+    }
+    return true;
+}
+
+void * btstack_memory_arena_get(btstack_memory_arena_t * arena){
+    btstack_memory_arenas_lock();
+    if ((arena->free_blocks == NULL) && (btstack_memory_arena_grow(arena) == false)){
+        btstack_memory_arenas_unlock();
+        return NULL;
+    }
+    void * block = arena->free_blocks;
+    arena->free_blocks = *(void **) block;
+    arena->num_blocks_in_use++;
+    arena->num_allocations++;
+    if (arena->num_blocks_in_use > arena->high_water_mark){
+        arena->high_water_mark = arena->num_blocks_in_use;
+    }
+    btstack_memory_arenas_unlock();
+    return block;
+}
+
+void btstack_memory_arena_free(btstack_memory_arena_t * arena, void * block){
+    if (block == NULL) return;
+    btstack_memory_arenas_lock();
+    btstack_assert(arena->num_blocks_in_use > 0u);
+    *(void **) block = arena->free_blocks;
+    arena->free_blocks = block;
+    arena->num_blocks_in_use--;
+    btstack_memory_arenas_unlock();
+}
+
+void btstack_memory_arena_deinit(btstack_memory_arena_t * arena){
+    btstack_memory_arenas_lock();
+    btstack_linked_list_remove(&btstack_memory_arenas, (btstack_linked_item_t *) arena);
+    while (arena->slabs != NULL){
+        btstack_memory_arena_slab_t * slab = arena->slabs;
+        arena->slabs = slab->next;
+        free(slab);
+    }
+    arena->free_blocks = NULL;
+    arena->num_blocks_in_use = 0;
+    arena->num_slabs = 0;
+    btstack_memory_arenas_unlock();
+}
+
+void btstack_memory_arenas_get_iterator(btstack_linked_list_iterator_t * it){
+    btstack_linked_list_iterator_init(it, &btstack_memory_arenas);
+}
+
+void btstack_memory_arenas_log_usage(void){
+    btstack_memory_arenas_lock();
+    btstack_linked_list_iterator_t it;
+    btstack_memory_arenas_get_iterator(&it);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        btstack_memory_arena_t * arena = (btstack_memory_arena_t *) btstack_linked_list_iterator_next(&it);
+        log_info("%s: %u bytes, %u in use, high water mark %u, %u allocations, %u slabs", arena->name,
+                 (unsigned int) arena->block_size, (unsigned int) arena->num_blocks_in_use, (unsigned int) arena->high_water_mark,
+                 (unsigned int) arena->num_allocations, (unsigned int) arena->num_slabs);
+    }
+    btstack_memory_arenas_unlock();
+}
+#endif
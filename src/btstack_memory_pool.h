@@ -44,11 +44,24 @@
  *  @Assumption size of storage >= count * block_size
  *
  *  @Note minimal implementation, no error checking/handling
+ *
+ *  With HAVE_MALLOC and ENABLE_BTSTACK_MEMORY_ARENA, a memory arena provides the same for a growing
+ *  number of blocks: storage is allocated in slabs of BTSTACK_MEMORY_ARENA_BLOCKS_PER_SLAB blocks and
+ *  only returned to the system by btstack_memory_arena_deinit
+ *
+ *  Memory arenas and the list of all arenas are not thread-safe. With ENABLE_BTSTACK_MEMORY_ARENA_THREAD_SAFE,
+ *  all arena functions are serialized by btstack_memory_arena_lock/unlock, which have to be provided by the port,
+ *  see platform/posix/btstack_memory_arena_lock_posix.c
  */
 
 #ifndef btstack_memory_pool_H
 #define btstack_memory_pool_H
 
+#include <stdint.h>
+
+#include "btstack_config.h"
+#include "btstack_linked_list.h"
+
 #if defined __cplusplus
 extern "C" {
 #endif
@@ -64,6 +77,61 @@ void * btstack_memory_pool_get(btstack_memory_pool_t *pool);
 // return previously reserved block to memory pool
 void   btstack_memory_pool_free(btstack_memory_pool_t *pool, void * block);
 
+#if defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+
+#ifndef BTSTACK_MEMORY_ARENA_BLOCKS_PER_SLAB
+#define BTSTACK_MEMORY_ARENA_BLOCKS_PER_SLAB 4
+#endif
+
+#if BTSTACK_MEMORY_ARENA_BLOCKS_PER_SLAB < 1
+#error "BTSTACK_MEMORY_ARENA_BLOCKS_PER_SLAB must be at least 1"
+#endif
+
+typedef struct btstack_memory_arena_slab {
+    struct btstack_memory_arena_slab * next;
+} btstack_memory_arena_slab_t;
+
+typedef struct {
+    btstack_linked_item_t item;
+    const char * name;
+    uint32_t block_size;
+    void * free_blocks;
+    btstack_memory_arena_slab_t * slabs;
+    // usage statistics
+    uint32_t num_blocks_in_use;
+    uint32_t high_water_mark;
+    uint32_t num_allocations;
+    uint32_t num_slabs;
+} btstack_memory_arena_t;
+
+#ifdef ENABLE_BTSTACK_MEMORY_ARENA_THREAD_SAFE
+// acquire lock shared by all memory arenas, provided by port
+void   btstack_memory_arena_lock(void);
+
+// release lock shared by all memory arenas, provided by port
+void   btstack_memory_arena_unlock(void);
+#endif
+
+// initialize empty memory arena for blocks of given size
+void   btstack_memory_arena_init(btstack_memory_arena_t * arena, const char * name, uint32_t block_size);
+
+// get free block from arena, allocates new slab if needed. @return NULL or pointer to block
+void * btstack_memory_arena_get(btstack_memory_arena_t * arena);
+
+// return previously reserved block to memory arena
+void   btstack_memory_arena_free(btstack_memory_arena_t * arena, void * block);
+
+// free all slabs of arena, blocks must not be used anymore
+void   btstack_memory_arena_deinit(btstack_memory_arena_t * arena);
+
+// get iterator over all initialized memory arenas. With ENABLE_BTSTACK_MEMORY_ARENA_THREAD_SAFE, hold btstack_memory_arena_lock while iterating
+void   btstack_memory_arenas_get_iterator(btstack_linked_list_iterator_t * it);
+
+// log usage statistics of all initialized memory arenas
+void   btstack_memory_arenas_log_usage(void);
+
+#endif
+
 #if defined __cplusplus
 }
 #endif
@@ -339,6 +339,8 @@ void btstack_run_loop_execute(void);
 /**
  * @brief Registers callback with run loop and mark main thread as ready
  * @note If callback is already registered, the call will be ignored.
+ *       The registration is tracked via its item field. A registration that is not queued can be
+ *       reused at any time, a stale item value from previous use does not prevent execution.
  *       This function allows to implement, e.g., a queue-based message passing mechanism:
  *       The external thread puts an item into a queue and call this function to trigger
  *       processing by the BTstack main thread. If this happens multiple times, it is
@@ -678,3 +678,37 @@ uint16_t btstack_virtual_memcpy(
     memcpy(&buffer[(field_offset + skip_at_start) - buffer_offset], &field_data[skip_at_start], bytes_to_copy);
     return bytes_to_copy;
 }
+
+uint32_t btstack_iovec_get_total_len(const btstack_iovec_t * iov, uint8_t iovcnt){
+    uint32_t total_len = 0;
+    uint8_t i;
+    for (i = 0; i < iovcnt; i++){
+        total_len += iov[i].len;
+    }
+    return total_len;
+}
+
+#ifdef UNIT_TEST
+// total number of bytes gathered by btstack_iovec_copy, used to measure copy overhead in tests
+uint32_t btstack_iovec_copy_num_bytes;
+#endif
+
+uint16_t btstack_iovec_copy(const btstack_iovec_t * iov, uint8_t iovcnt, uint32_t offset, uint8_t * buffer, uint16_t len){
+    uint16_t bytes_copied = 0;
+    uint8_t i;
+    for (i = 0; (i < iovcnt) && (bytes_copied < len); i++){
+        // skip buffers before offset
+        if (offset >= iov[i].len){
+            offset -= iov[i].len;
+            continue;
+        }
+        uint16_t bytes_to_copy = (uint16_t) btstack_min(iov[i].len - offset, len - bytes_copied);
+        (void) memcpy(&buffer[bytes_copied], &iov[i].data[offset], bytes_to_copy);
+        bytes_copied += bytes_to_copy;
+        offset = 0;
+    }
+#ifdef UNIT_TEST
+    btstack_iovec_copy_num_bytes += bytes_copied;
+#endif
+    return bytes_copied;
+}
@@ -69,6 +69,14 @@ extern "C" {
 #define DEVICE_NAME_LEN 248
 typedef uint8_t device_name_t[DEVICE_NAME_LEN+1]; 
 
+/**
+ * @brief Buffer descriptor for scatter-gather operations, e.g. protocol header and payload in separate buffers
+ */
+typedef struct {
+    const uint8_t * data;
+    uint16_t len;
+} btstack_iovec_t;
+
 /* API_START */
 
 /**
@@ -416,6 +424,25 @@ uint16_t btstack_virtual_memcpy(
     const uint8_t * field_data, uint16_t field_len, uint16_t field_offset, 
     uint8_t * buffer, uint16_t buffer_size, uint16_t buffer_offset);
 
+/**
+ * @brief Get total length of data described by buffer descriptors
+ * @param iov buffer descriptors
+ * @param iovcnt number of buffer descriptors
+ * @return sum of buffer lengths
+ */
+uint32_t btstack_iovec_get_total_len(const btstack_iovec_t * iov, uint8_t iovcnt);
+
+/**
+ * @brief Gather len bytes starting at offset in data described by buffer descriptors into contiguous buffer
+ * @param iov buffer descriptors
+ * @param iovcnt number of buffer descriptors
+ * @param offset in concatenated data
+ * @param buffer
+ * @param len
+ * @return bytes_copied number of bytes actually stored in buffer
+ */
+uint16_t btstack_iovec_copy(const btstack_iovec_t * iov, uint8_t iovcnt, uint32_t offset, uint8_t * buffer, uint16_t len);
+
 
 /* API_END */
 
@@ -207,12 +207,16 @@ avdtp_source_stream_send_media_payload_rtp(uint16_t avdtp_cid, uint8_t local_sei
     uint32_t buffer_size = l2cap_get_remote_mtu_for_local_cid(stream_endpoint->l2cap_media_cid);
     uint32_t packet_size = AVDTP_MEDIA_PAYLOAD_HEADER_SIZE + payload_size;
     if (packet_size > buffer_size) return ERROR_CODE_MEMORY_CAPACITY_EXCEEDED;
-    l2cap_reserve_packet_buffer();
-    uint8_t * media_packet = l2cap_get_outgoing_buffer();
-    avdtp_source_setup_media_header(media_packet, marker, stream_endpoint->sequence_number, timestamp);
-    (void)memcpy(&media_packet[AVDTP_MEDIA_PAYLOAD_HEADER_SIZE], payload, payload_size);
+    // gather media header and payload in outgoing buffer
+    uint8_t media_header[AVDTP_MEDIA_PAYLOAD_HEADER_SIZE];
+    avdtp_source_setup_media_header(media_header, marker, stream_endpoint->sequence_number, timestamp);
+    btstack_iovec_t iov[2];
+    iov[0].data = media_header;
+    iov[0].len  = sizeof(media_header);
+    iov[1].data = payload;
+    iov[1].len  = payload_size;
     stream_endpoint->sequence_number++;
-    return l2cap_send_prepared(stream_endpoint->l2cap_media_cid, (uint16_t) packet_size);
+    return l2cap_send_iovec(stream_endpoint->l2cap_media_cid, iov, 2);
 }
 
 uint8_t avdtp_source_stream_send_media_packet(uint16_t avdtp_cid, uint8_t local_seid, const uint8_t * packet, uint16_t size){
@@ -481,7 +481,8 @@ static int bnep_filter_multicast(bnep_channel_t *channel, bd_addr_t addr_dest)
 int bnep_send(uint16_t bnep_cid, uint8_t *packet, uint16_t len)
 {
     bnep_channel_t *channel;
-    uint8_t        *bnep_out_buffer = NULL;
+    uint8_t         bnep_header[1 + sizeof(bd_addr_t) + sizeof(bd_addr_t) + 2];
+    btstack_iovec_t iov[2];
     uint16_t        pos = 0;
     uint16_t        pos_out = 0;
     uint16_t        payload_len;
@@ -545,10 +546,6 @@ int bnep_send(uint16_t bnep_cid, uint8_t *packet, uint16_t len)
         }
     }
 
-    /* Reserve l2cap packet buffer */    
-    l2cap_reserve_packet_buffer();
-    bnep_out_buffer = l2cap_get_outgoing_buffer();
-
     /* Check if source address is the same as our local address and if the 
        destination address is the same as the remote addr. Maybe we can use
        the compressed data format
@@ -564,39 +561,41 @@ int bnep_send(uint16_t bnep_cid, uint8_t *packet, uint16_t len)
     
     /* Fill in the package type depending on the given source and destination address */
     if (has_source && has_dest) {
-        bnep_out_buffer[pos_out++] = BNEP_PKT_TYPE_GENERAL_ETHERNET;
+        bnep_header[pos_out++] = BNEP_PKT_TYPE_GENERAL_ETHERNET;
     } else 
     if (has_source && !has_dest) {
-        bnep_out_buffer[pos_out++] = BNEP_PKT_TYPE_COMPRESSED_ETHERNET_SOURCE_ONLY;
+        bnep_header[pos_out++] = BNEP_PKT_TYPE_COMPRESSED_ETHERNET_SOURCE_ONLY;
     } else 
     if (!has_source && has_dest) {
-        bnep_out_buffer[pos_out++] = BNEP_PKT_TYPE_COMPRESSED_ETHERNET_DEST_ONLY;
+        bnep_header[pos_out++] = BNEP_PKT_TYPE_COMPRESSED_ETHERNET_DEST_ONLY;
     } else {
-        bnep_out_buffer[pos_out++] = BNEP_PKT_TYPE_COMPRESSED_ETHERNET;
+        bnep_header[pos_out++] = BNEP_PKT_TYPE_COMPRESSED_ETHERNET;
     }
 
     /* Add the destination address if needed */
     if (has_dest) {
-        bd_addr_copy(bnep_out_buffer + pos_out, addr_dest);
+        bd_addr_copy(bnep_header + pos_out, addr_dest);
         pos_out += sizeof(bd_addr_t);
     }
 
     /* Add the source address if needed */
     if (has_source) {
-        bd_addr_copy(bnep_out_buffer + pos_out, addr_source);
+        bd_addr_copy(bnep_header + pos_out, addr_source);
         pos_out += sizeof(bd_addr_t);
     }
 
     /* Add protocol type */
-    big_endian_store_16(bnep_out_buffer, pos_out, network_protocol_type);
+    big_endian_store_16(bnep_header, pos_out, network_protocol_type);
     pos_out += 2;
     
     /* TODO: Add extension headers, if we may support them at a later stage */
-    /* Add the payload and then send out the package */
-    (void)memcpy(bnep_out_buffer + pos_out, packet + pos, payload_len);
-    pos_out += payload_len;
+    /* Gather header and payload in l2cap outgoing buffer and send out the package */
+    iov[0].data = bnep_header;
+    iov[0].len  = pos_out;
+    iov[1].data = packet + pos;
+    iov[1].len  = payload_len;
 
-    err = l2cap_send_prepared(channel->l2cap_cid, pos_out);
+    err = l2cap_send_iovec(channel->l2cap_cid, iov, 2);
     
     if (err) {
         log_error("bnep_send: error %d", err);
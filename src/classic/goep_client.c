@@ -77,16 +77,31 @@ static uint8_t goep_packet_buffer[150];
 static goep_client_t   goep_client_singleton;
 
 #ifdef ENABLE_GOEP_L2CAP
+// L2CAP ERTM config for singleton instance. The buffer holds the reassembly buffer (MTU) and is split equally
+// into rx and tx buffers, which limits the L2CAP MPS and the number of I-frames in flight during SRM transfers
+#ifndef GOEP_CLIENT_ERTM_MTU
+#define GOEP_CLIENT_ERTM_MTU 512
+#endif
+#ifndef GOEP_CLIENT_ERTM_NUM_TX_BUFFERS
+#define GOEP_CLIENT_ERTM_NUM_TX_BUFFERS 2
+#endif
+#ifndef GOEP_CLIENT_ERTM_NUM_RX_BUFFERS
+#define GOEP_CLIENT_ERTM_NUM_RX_BUFFERS 2
+#endif
+#ifndef GOEP_CLIENT_ERTM_BUFFER_SIZE
+#define GOEP_CLIENT_ERTM_BUFFER_SIZE 1000
+#endif
+
 // singleton instance
-static uint8_t goep_client_singleton_ertm_buffer[1000];
+static uint8_t goep_client_singleton_ertm_buffer[GOEP_CLIENT_ERTM_BUFFER_SIZE];
 static l2cap_ertm_config_t goep_client_singleton_ertm_config = {
     1,  // ertm mandatory
     2,  // max transmit, some tests require > 1
     2000,
     12000,
-    512,    // l2cap ertm mtu
-    2,
-    2,
+    GOEP_CLIENT_ERTM_MTU,    // l2cap ertm mtu
+    GOEP_CLIENT_ERTM_NUM_TX_BUFFERS,
+    GOEP_CLIENT_ERTM_NUM_RX_BUFFERS,
     1,      // 16-bit FCS
 };
 #endif
@@ -1149,7 +1149,8 @@ typedef struct {
     hfp_command_t command_id;
 } hfp_command_entry_t;
 
-static hfp_command_entry_t hfp_ag_command_table[] = {
+// tables have to be sorted by command string
+static const hfp_command_entry_t hfp_ag_command_table[] = {
     { "AT+BAC=",   HFP_CMD_AVAILABLE_CODECS },
     { "AT+BCC",    HFP_CMD_TRIGGER_CODEC_CONNECTION_SETUP },
     { "AT+BCS=",   HFP_CMD_HF_CONFIRMED_CODEC },
@@ -1184,7 +1185,7 @@ static hfp_command_entry_t hfp_ag_command_table[] = {
     { "ATA",       HFP_CMD_CALL_ANSWERED },
 };
 
-static hfp_command_entry_t hfp_hf_command_table[] = {
+static const hfp_command_entry_t hfp_hf_command_table[] = {
     { "+BCS:",  HFP_CMD_AG_SUGGESTED_CODEC },
     { "+BIND:", HFP_CMD_SET_GENERIC_STATUS_INDICATOR_STATUS },
     { "+BINP:", HFP_CMD_AG_SENT_PHONE_NUMBER },
@@ -1236,7 +1237,7 @@ static hfp_command_t parse_command(const char * line_buffer, int isHandsFree){
 
     // table lookup based on role
     uint16_t num_entries;
-    hfp_command_entry_t * table;
+    const hfp_command_entry_t * table;
     if (isHandsFree == 0){
         table = hfp_ag_command_table;
         num_entries = sizeof(hfp_ag_command_table) / sizeof(hfp_command_entry_t);
@@ -1244,23 +1245,30 @@ static hfp_command_t parse_command(const char * line_buffer, int isHandsFree){
         table = hfp_hf_command_table;
         num_entries = sizeof(hfp_hf_command_table) / sizeof(hfp_command_entry_t);
     }
-    // binary search
-    uint16_t left = 0;
-    uint16_t right = num_entries - 1;
-    while (left <= right){
-        uint16_t middle = left + (right - left) / 2;
-        hfp_command_entry_t *entry = &table[middle];
-        int match = strcmp(line_buffer, entry->command);
-        if (match < 0){
-            // search term is lower than middle element
-            if (right == 0) break;
-            right = middle - 1;
-        } else if (match == 0){
-            return entry->command_id;
-        } else {
-            // search term is higher than middle element
-            left = middle + 1;
+
+    // walk sorted table as trie: entries with same prefix are adjacent and ordered by next character,
+    // so each character of the command narrows [first..last] without comparing full strings
+    uint16_t first = 0;
+    uint16_t last  = num_entries - 1;
+    uint16_t pos;
+    for (pos = 0; line_buffer[pos] != 0; pos++){
+        char c = line_buffer[pos];
+        // shorter entries have '\0' at pos and are skipped here as well
+        while ((first <= last) && (table[first].command[pos] < c)){
+            first++;
+        }
+        while ((first <= last) && (table[last].command[pos] > c)){
+            if (last == 0) break;
+            last--;
         }
+        if ((first > last) || (table[first].command[pos] != c)) {
+            first = num_entries;
+            break;
+        }
+    }
+    // exact match is the shortest entry in range
+    if ((first < num_entries) && (table[first].command[pos] == 0)){
+        return table[first].command_id;
     }
 
     // note: if parser in CMD_HEADER state would treats digits and maybe '+' as separator, match on "ATD" would work.
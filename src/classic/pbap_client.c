@@ -197,6 +197,10 @@ typedef struct pbap_client {
     /* srm */
     obex_srm_t obex_srm;
     srm_state_t srm_state;
+    /* transfer statistics */
+    uint32_t transfer_bytes;
+    uint32_t transfer_start_ms;
+    uint32_t transfer_duration_ms;
 } pbap_client_t;
 
 static uint32_t pbap_client_supported_features;
@@ -531,6 +535,17 @@ static void pbap_client_parser_callback_get_phonebook_size(void * user_data, uin
     }
 }
 
+static void pbap_client_transfer_statistics_reset(pbap_client_t * client){
+    client->transfer_bytes = 0;
+    client->transfer_start_ms = btstack_run_loop_get_time_ms();
+    client->transfer_duration_ms = 0;
+}
+
+static void pbap_client_transfer_statistics_update(pbap_client_t * client, uint16_t data_len){
+    client->transfer_bytes += data_len;
+    client->transfer_duration_ms = btstack_run_loop_get_time_ms() - client->transfer_start_ms;
+}
+
 static void pbap_client_parser_callback_get_operation(void * user_data, uint8_t header_id, uint16_t total_len, uint16_t data_offset, const uint8_t * data_buffer, uint16_t data_len){
     pbap_client_t *client = (pbap_client_t *) user_data;
     switch (header_id) {
@@ -542,6 +557,8 @@ static void pbap_client_parser_callback_get_operation(void * user_data, uint8_t
             break;
         case OBEX_HEADER_BODY:
         case OBEX_HEADER_END_OF_BODY:
+            // body data is passed on directly from the GOEP packet
+            pbap_client_transfer_statistics_update(client, data_len);
             switch(pbap_client->state){
                 case PBAP_W4_PHONEBOOK:
                 case PBAP_W4_GET_CARD_ENTRY_COMPLETE:
@@ -1214,6 +1231,7 @@ uint8_t pbap_pull_phonebook(uint16_t pbap_cid, const char * path){
     pbap_client->phonebook_path = path;
     pbap_client->vcard_name = NULL;
     pbap_client->request_number = 0;
+    pbap_client_transfer_statistics_reset(pbap_client);
     goep_client_request_can_send_now(pbap_client->goep_cid);
     return ERROR_CODE_SUCCESS;
 }
@@ -1251,6 +1269,7 @@ uint8_t pbap_pull_vcard_listing(uint16_t pbap_cid, const char * path){
     pbap_client->phone_number = NULL;
     pbap_client->request_number = 0;
     pbap_client_vcard_listing_init_parser(pbap_client);
+    pbap_client_transfer_statistics_reset(pbap_client);
     goep_client_request_can_send_now(pbap_client->goep_cid);
     return ERROR_CODE_SUCCESS;
 }
@@ -1265,6 +1284,7 @@ uint8_t pbap_pull_vcard_entry(uint16_t pbap_cid, const char * path){
     // pbap_client->phone_number = NULL;
     pbap_client->vcard_name = path;
     pbap_client->request_number = 0;
+    pbap_client_transfer_statistics_reset(pbap_client);
     goep_client_request_can_send_now(pbap_client->goep_cid);
     return ERROR_CODE_SUCCESS;
 }
@@ -1279,6 +1299,7 @@ uint8_t pbap_lookup_by_number(uint16_t pbap_cid, const char * phone_number){
     pbap_client->phone_number   = phone_number;
     pbap_client->request_number = 0;
     pbap_client_vcard_listing_init_parser(pbap_client);
+    pbap_client_transfer_statistics_reset(pbap_client);
     goep_client_request_can_send_now(pbap_client->goep_cid);
     return ERROR_CODE_SUCCESS;
 }
@@ -1312,6 +1333,20 @@ uint8_t pbap_next_packet(uint16_t pbap_cid){
     return ERROR_CODE_SUCCESS;
 }
 
+uint8_t pbap_get_transfer_statistics(uint16_t pbap_cid, uint32_t * bytes_received, uint32_t * bytes_per_second){
+    UNUSED(pbap_cid);
+    if (pbap_client->state < PBAP_CONNECTED){
+        return ERROR_CODE_COMMAND_DISALLOWED;
+    }
+    *bytes_received = pbap_client->transfer_bytes;
+    if (pbap_client->transfer_duration_ms == 0){
+        *bytes_per_second = 0;
+    } else {
+        *bytes_per_second = (uint32_t) (((uint64_t) pbap_client->transfer_bytes * 1000u) / pbap_client->transfer_duration_ms);
+    }
+    return ERROR_CODE_SUCCESS;
+}
+
 uint8_t pbap_set_flow_control_mode(uint16_t pbap_cid, int enable){
     UNUSED(pbap_cid);
     if (pbap_client->state != PBAP_CONNECTED){
@@ -209,6 +209,15 @@ uint8_t pbap_set_flow_control_mode(uint16_t pbap_cid, int enable);
  */
 uint8_t pbap_next_packet(uint16_t pbap_cid);
 
+/**
+ * @brief Get number of body bytes received by current or last pull operation and the average data rate
+ * @param pbap_cid
+ * @param bytes_received
+ * @param bytes_per_second since start of the operation
+ * @return status ERROR_CODE_SUCCESS on success, otherwise ERROR_CODE_COMMAND_DISALLOWED if not connected
+ */
+uint8_t pbap_get_transfer_statistics(uint16_t pbap_cid, uint32_t * bytes_received, uint32_t * bytes_per_second);
+
 /**
  * @brief De-Init PBAP Client
  */
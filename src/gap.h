@@ -590,6 +590,14 @@ void gap_set_scan_parameters(uint8_t scan_type, uint16_t scan_interval, uint16_t
  */
 void gap_set_scan_duplicate_filter(bool enabled);
 
+/**
+ * @brief Register filter for LE Advertising Reports. Callback gets GAP_EVENT_ADVERTISING_REPORT or
+ * GAP_EVENT_EXTENDED_ADVERTISING_REPORT before it is emitted and returns true to deliver the report.
+ * @note see ble/le_advertising_filter.h for a configurable filter
+ * @param filter_callback or NULL to deliver all reports
+ */
+void gap_register_advertising_report_filter(bool (*filter_callback)(const uint8_t * event, uint16_t size));
+
 /**
  * @brief Set PHYs for LE Scan
  * @param phy bitmask: 1 = LE 1M PHY, 4 = LE Coded PHY
@@ -672,6 +680,13 @@ void gap_advertisements_enable(int enabled);
 void gap_scan_response_set_data(uint8_t scan_response_data_length, uint8_t * scan_response_data);
 
 
+/**
+ * @brief Check if Controller supports LE Extended Advertising
+ * @note valid after HCI_STATE_WORKING
+ * @return true if supported
+ */
+bool gap_extended_advertising_supported(void);
+
 /**
  * @brief Set update interval for resolvable private addresses generated by the Controller
  * @param update_s timeout for updates in seconds
@@ -694,6 +709,7 @@ uint8_t gap_extended_advertising_setup(le_advertising_set_t * storage, const le_
  * @param advertising_handle
  * @param advertising_parameters
  * @return status
+ * @events: GAP_SUBEVENT_ADVERTISING_SET_INSTALLED
  */
 uint8_t gap_extended_advertising_set_params(uint8_t advertising_handle, const le_extended_advertising_parameters_t * advertising_parameters);
 
@@ -735,6 +751,7 @@ uint8_t gap_extended_advertising_set_random_address(uint8_t advertising_handle,
  * @param advertising_data_length
  * @param advertising_data
  * @return status
+ * @events: GAP_SUBEVENT_ADVERTISING_SET_COMMAND_FAILED on error
  */
 uint8_t gap_extended_advertising_set_adv_data(uint8_t advertising_handle, uint16_t advertising_data_length, const uint8_t * advertising_data);
 
@@ -762,6 +779,7 @@ uint8_t gap_periodic_advertising_set_data(uint8_t advertising_handle, uint16_t p
  * @param timeout in 10ms, or 0 == no timeout
  * @param num_extended_advertising_events Controller shall send, or 0 == no max number
  * @return status
+ * @events: GAP_SUBEVENT_ADVERTISING_SET_COMMAND_FAILED on error
  */
 uint8_t gap_extended_advertising_start(uint8_t advertising_handle, uint16_t timeout, uint8_t num_extended_advertising_events);
 
@@ -71,6 +71,7 @@
 #include "gap.h"
 #include "hci.h"
 #include "hci_cmd.h"
+#include "hci_cmd_serializer.h"
 #include "hci_dump.h"
 #include "ad_parser.h"
 
@@ -151,6 +152,13 @@
 #define GAP_PAIRING_STATE_SEND_CONFIRMATION_NEGATIVE 6
 #define GAP_PAIRING_STATE_WAIT_FOR_COMMAND_COMPLETE  7
 
+// hci_run tasks
+#define HCI_RUN_TASK_GAP_CLASSIC 0x01
+#define HCI_RUN_TASK_GAP_LE      0x02
+#define HCI_RUN_TASK_ISO         0x04
+#define HCI_RUN_TASK_CONNECTIONS 0x08
+#define HCI_RUN_TASK_ALL         0x0f
+
 //
 // compact storage of relevant supported HCI Commands.
 // X-Macro below provides enumeration and mapping table into the supported
@@ -215,6 +223,9 @@ static void hci_emit_dedicated_bonding_result(bd_addr_t address, uint8_t status)
 static void hci_emit_event(uint8_t * event, uint16_t size, int dump);
 static void hci_emit_acl_packet(uint8_t * packet, uint16_t size);
 static void hci_run(void);
+static void hci_run_pending(void);
+static uint8_t * hci_reserve_cmd_packet_buffer(void);
+static uint8_t hci_send_reserved_cmd_packet_buffer(uint16_t size);
 static bool hci_is_le_connection(hci_connection_t * connection);
 
 #ifdef ENABLE_CLASSIC
@@ -247,6 +258,8 @@ static void hci_iso_packet_handler(hci_iso_stream_t *iso_stream, uint8_t *packet
 static le_audio_big_t * hci_big_for_handle(uint8_t big_handle);
 static le_audio_cig_t * hci_cig_for_id(uint8_t cig_id);
 static void hci_iso_notify_can_send_now(void);
+static void hci_iso_send_queued_sdus(void);
+static void hci_iso_stream_free(hci_iso_stream_t * iso_stream);
 static void hci_emit_big_created(const le_audio_big_t * big, uint8_t status);
 static void hci_emit_big_terminated(const le_audio_big_t * big);
 static void hci_emit_big_sync_created(const le_audio_big_sync_t * big_sync, uint8_t status);
@@ -276,6 +289,7 @@ static uint8_t disable_l2cap_timeouts = 0;
 // don't overwrite addr, con handle, role
 static void hci_connection_init(hci_connection_t * conn){
     conn->authentication_flags = AUTH_FLAG_NONE;
+    conn->run_pending = true;
     conn->bonding_flags = 0;
     conn->requested_security_level = LEVEL_0;
 #ifdef ENABLE_CLASSIC
@@ -1268,8 +1282,8 @@ static void acl_handler(uint8_t *packet, uint16_t size){
             return;
     }
     
-    // execute main loop
-    hci_run();
+    // execute main loop, state changes by upper layers call hci_run or hci_request_connection_run
+    hci_run_pending();
 }
 
 static void hci_connection_stop_timer(hci_connection_t * conn){
@@ -1518,6 +1532,15 @@ void gap_le_get_own_connection_address(uint8_t * addr_type, bd_addr_t addr){
     hci_get_own_address_for_addr_type(hci_stack->le_connection_own_addr_type, addr);
 }
 
+static void hci_emit_advertising_report(uint8_t * event, uint16_t size){
+    if (hci_stack->le_advertising_report_filter != NULL){
+        if ((*hci_stack->le_advertising_report_filter)(event, size) == false){
+            return;
+        }
+    }
+    hci_emit_event(event, size, 1);
+}
+
 void le_handle_advertisement_report(uint8_t *packet, uint16_t size){
 
     uint16_t offset = 3;
@@ -1545,7 +1568,7 @@ void le_handle_advertisement_report(uint8_t *packet, uint16_t size){
         (void)memcpy(&event[pos], &packet[offset], data_length);
         pos +=    data_length;
         offset += data_length + 1u; // rssi
-        hci_emit_event(event, pos, 1);
+        hci_emit_advertising_report(event, pos);
     }
 }
 
@@ -1609,7 +1632,7 @@ void le_handle_extended_advertisement_report(uint8_t *packet, uint16_t size) {
             (void) memcpy(&event[pos], &packet[offset], 1 + data_length);
             pos    += 1 +data_length;
             offset += 1+ data_length;
-            hci_emit_event(event, pos, 1);
+            hci_emit_advertising_report(event, pos);
         } else {
             event[0] = GAP_EVENT_EXTENDED_ADVERTISING_REPORT;
             uint8_t report_len = 24 + data_length;
@@ -1617,7 +1640,7 @@ void le_handle_extended_advertisement_report(uint8_t *packet, uint16_t size) {
             little_endian_store_16(event, 2, event_type);
             memcpy(&event[4], &packet[offset], report_len);
             offset += report_len;
-            hci_emit_event(event, 2 + report_len, 1);
+            hci_emit_advertising_report(event, 2 + report_len);
         }
     }
 }
@@ -2785,8 +2808,8 @@ static void handle_command_complete_event(uint8_t * packet, uint16_t size){
     hci_stack->hci_command_con_handle = HCI_CON_HANDLE_INVALID;
 #endif
 
-    // get num cmd packets - limit to 1 to reduce complexity
-    hci_stack->num_cmd_packets = packet[2] ? 1 : 0;
+    // get num cmd packets - limit to HCI_MAX_NUM_CMD_PACKETS to reduce complexity
+    hci_stack->num_cmd_packets = btstack_min(packet[2], HCI_MAX_NUM_CMD_PACKETS);
 
     uint16_t opcode = hci_event_command_complete_get_command_opcode(packet);
     switch (opcode){
@@ -2862,24 +2885,42 @@ static void handle_command_complete_event(uint8_t * packet, uint16_t size){
             break;
         case HCI_OPCODE_HCI_LE_SET_EXTENDED_ADVERTISING_PARAMETERS:
             if (hci_stack->le_advertising_set_in_current_command != 0) {
-                le_advertising_set_t * advertising_set = hci_advertising_set_for_handle(hci_stack->le_advertising_set_in_current_command);
+                uint8_t advertising_handle = hci_stack->le_advertising_set_in_current_command;
+                le_advertising_set_t * advertising_set = hci_advertising_set_for_handle(advertising_handle);
                 hci_stack->le_advertising_set_in_current_command = 0;
                 if (advertising_set == NULL) break;
-                uint8_t adv_status = packet[6];
-                uint8_t tx_power   = packet[7];
-                uint8_t event[] = { HCI_EVENT_META_GAP, 4, GAP_SUBEVENT_ADVERTISING_SET_INSTALLED, hci_stack->le_advertising_set_in_current_command, adv_status, tx_power };
-                if (adv_status == 0){
+                uint8_t tx_power = packet[6];
+                uint8_t event[] = { HCI_EVENT_META_GAP, 4, GAP_SUBEVENT_ADVERTISING_SET_INSTALLED, advertising_handle, status, tx_power };
+                if (status == ERROR_CODE_SUCCESS){
                     advertising_set->state |= LE_ADVERTISEMENT_STATE_PARAMS_SET;
                 }
                 hci_emit_event(event, sizeof(event), 1);
             }
             break;
+        case HCI_OPCODE_HCI_LE_SET_EXTENDED_ADVERTISING_DATA:
+        case HCI_OPCODE_HCI_LE_SET_EXTENDED_ADVERTISING_ENABLE:
+            if (hci_stack->le_advertising_set_in_current_command != 0) {
+                uint8_t advertising_handle = hci_stack->le_advertising_set_in_current_command;
+                le_advertising_set_t * advertising_set = hci_advertising_set_for_handle(advertising_handle);
+                hci_stack->le_advertising_set_in_current_command = 0;
+                if (advertising_set == NULL) break;
+                if (status == ERROR_CODE_SUCCESS) break;
+                if (opcode == HCI_OPCODE_HCI_LE_SET_EXTENDED_ADVERTISING_ENABLE){
+                    // set did not start advertising
+                    advertising_set->state &= ~(LE_ADVERTISEMENT_STATE_ACTIVE | LE_ADVERTISEMENT_STATE_ENABLED);
+                }
+                uint8_t event[] = { HCI_EVENT_META_GAP, 5, GAP_SUBEVENT_ADVERTISING_SET_COMMAND_FAILED, advertising_handle, 0, 0, status };
+                little_endian_store_16(event, 4, opcode);
+                hci_emit_event(event, sizeof(event), 1);
+            }
+            break;
         case HCI_OPCODE_HCI_LE_REMOVE_ADVERTISING_SET:
             if (hci_stack->le_advertising_set_in_current_command != 0) {
-                le_advertising_set_t * advertising_set = hci_advertising_set_for_handle(hci_stack->le_advertising_set_in_current_command);
+                uint8_t advertising_handle = hci_stack->le_advertising_set_in_current_command;
+                le_advertising_set_t * advertising_set = hci_advertising_set_for_handle(advertising_handle);
                 hci_stack->le_advertising_set_in_current_command = 0;
                 if (advertising_set == NULL) break;
-                uint8_t event[] = { HCI_EVENT_META_GAP, 3, GAP_SUBEVENT_ADVERTISING_SET_REMOVED, hci_stack->le_advertising_set_in_current_command, status };
+                uint8_t event[] = { HCI_EVENT_META_GAP, 3, GAP_SUBEVENT_ADVERTISING_SET_REMOVED, advertising_handle, status };
                 if (status == 0){
                     btstack_linked_list_remove(&hci_stack->le_advertising_sets, (btstack_linked_item_t *) advertising_set);
                 }
@@ -3184,8 +3225,8 @@ static void handle_command_complete_event(uint8_t * packet, uint16_t size){
 static void handle_command_status_event(uint8_t * packet, uint16_t size) {
     UNUSED(size);
 
-    // get num cmd packets - limit to 1 to reduce complexity
-    hci_stack->num_cmd_packets = packet[3] ? 1 : 0;
+    // get num cmd packets - limit to HCI_MAX_NUM_CMD_PACKETS to reduce complexity
+    hci_stack->num_cmd_packets = btstack_min(packet[3], HCI_MAX_NUM_CMD_PACKETS);
 
     // get opcode and command status
     uint16_t opcode = hci_event_command_status_get_command_opcode(packet);
@@ -3508,6 +3549,27 @@ static void hci_ssp_assess_security_on_io_cap_request(hci_connection_t * conn){
 
 #endif
 
+// events that only report data or buffer/transport state don't change the state of the sub statemachines
+static bool hci_event_requires_full_run(const uint8_t * packet){
+    switch (hci_event_packet_get_type(packet)){
+        case HCI_EVENT_NUMBER_OF_COMPLETED_PACKETS:
+        case HCI_EVENT_TRANSPORT_PACKET_SENT:
+            return false;
+#ifdef ENABLE_BLE
+        case HCI_EVENT_LE_META:
+            switch (hci_event_le_meta_get_subevent_code(packet)){
+                case HCI_SUBEVENT_LE_ADVERTISING_REPORT:
+                case HCI_SUBEVENT_LE_EXTENDED_ADVERTISING_REPORT:
+                    return false;
+                default:
+                    return true;
+            }
+#endif
+        default:
+            return true;
+    }
+}
+
 static void event_handler(uint8_t *packet, uint16_t size){
 
     uint16_t event_length = packet[1];
@@ -4471,7 +4533,7 @@ static void event_handler(uint8_t *packet, uint16_t size){
                             if (iso_stream->group_id == big->big_handle){
                                 log_info("BIG Terminated, big_handle 0x%02x, con handle 0x%04x", iso_stream->group_id, iso_stream->cis_handle);
                                 btstack_linked_list_iterator_remove(&it);
-                                btstack_memory_hci_iso_stream_free(iso_stream);
+                                hci_iso_stream_free(iso_stream);
                             }
                         }
                         btstack_linked_list_remove(&hci_stack->le_audio_bigs, (btstack_linked_item_t *) big);
@@ -4576,7 +4638,11 @@ static void event_handler(uint8_t *packet, uint16_t size){
     }
 
 	// execute main loop
-	hci_run();
+    if (hci_event_requires_full_run(packet)){
+        hci_run();
+    } else {
+        hci_run_pending();
+    }
 }
 
 #ifdef ENABLE_CLASSIC
@@ -4635,7 +4701,7 @@ static void sco_handler(uint8_t * packet, uint16_t size){
 #ifdef ENABLE_HCI_CONTROLLER_TO_HOST_FLOW_CONTROL
     conn->num_packets_completed++;
     hci_stack->host_completed_packets = 1;
-    hci_run();
+    hci_run_pending();
 #endif    
 }
 #endif
@@ -4773,6 +4839,26 @@ static void hci_state_reset(void){
     if (hci_stack->le_advertisements_data != NULL){
         hci_stack->le_advertisements_todo |= LE_ADVERTISEMENT_TASKS_SET_ADV_DATA;
     }
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+    // install advertising sets again after reset
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_stack->le_advertising_sets);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        le_advertising_set_t * advertising_set = (le_advertising_set_t*) btstack_linked_list_iterator_next(&it);
+        advertising_set->state &= ~(LE_ADVERTISEMENT_STATE_PARAMS_SET | LE_ADVERTISEMENT_STATE_ACTIVE | LE_ADVERTISEMENT_STATE_PERIODIC_ACTIVE);
+        advertising_set->tasks |= LE_ADVERTISEMENT_TASKS_SET_PARAMS;
+        if (btstack_is_null_bd_addr(advertising_set->random_address) == false){
+            advertising_set->tasks |= LE_ADVERTISEMENT_TASKS_SET_ADDRESS;
+        }
+        if (advertising_set->adv_data_len > 0){
+            advertising_set->tasks |= LE_ADVERTISEMENT_TASKS_SET_ADV_DATA;
+        }
+        if (advertising_set->scan_data_len > 0){
+            advertising_set->tasks |= LE_ADVERTISEMENT_TASKS_SET_SCAN_DATA;
+        }
+    }
+    hci_stack->le_advertising_set_in_current_command = 0;
+#endif
 #endif
 #ifdef ENABLE_LE_PRIVACY_ADDRESS_RESOLUTION
     hci_stack->le_resolving_list_state = LE_RESOLVING_LIST_SEND_ENABLE_ADDRESS_RESOLUTION;
@@ -5478,6 +5564,7 @@ static void hci_halting_run(void) {
 #endif /* ENABLE_LE_PERIODIC_ADVERTISING */
                 if (stop_advertismenets){
                     hci_stack->le_advertisements_state &= ~LE_ADVERTISEMENT_STATE_ACTIVE;
+                    hci_stack->le_advertising_set_in_current_command = 0;
                     hci_send_cmd(&hci_le_set_extended_advertising_enable, 0, 0, NULL, NULL, NULL);
                     return;
                 }
@@ -5904,14 +5991,18 @@ static uint8_t hci_le_num_phys(uint8_t phys){
 
 #ifdef ENABLE_LE_CENTRAL
 static void hci_le_scan_stop(void){
+    uint8_t * packet = hci_reserve_cmd_packet_buffer();
+    if (packet == NULL) return;
+    uint16_t size;
 #ifdef ENABLE_LE_EXTENDED_ADVERTISING
     if (hci_extended_advertising_supported()) {
-            hci_send_cmd(&hci_le_set_extended_scan_enable, 0, 0, 0, 0);
+        size = hci_cmd_create_le_set_extended_scan_enable(packet, 0, 0, 0, 0);
     } else
 #endif
     {
-        hci_send_cmd(&hci_le_set_scan_enable, 0, 0);
+        size = hci_cmd_create_le_set_scan_enable(packet, 0, 0);
     }
+    (void) hci_send_reserved_cmd_packet_buffer(size);
 }
 
 static void
@@ -6265,6 +6356,7 @@ static bool hci_run_general_gap_le(void){
                 advertising_stop_handle = 0;
                 hci_stack->le_advertisements_state &= ~LE_ADVERTISEMENT_STATE_ACTIVE;
             }
+            hci_stack->le_advertising_set_in_current_command = 0;
             const uint8_t advertising_handles[] = { advertising_stop_handle };
             const uint16_t durations[] = { 0 };
             const uint16_t max_events[] = { 0 };
@@ -6392,15 +6484,19 @@ static bool hci_run_general_gap_le(void){
         (void)memcpy(adv_data_clean, hci_stack->le_advertisements_data,
                      hci_stack->le_advertisements_data_len);
         btstack_replace_bd_addr_placeholder(adv_data_clean, hci_stack->le_advertisements_data_len, hci_stack->local_bd_addr);
+        uint8_t * packet = hci_reserve_cmd_packet_buffer();
+        if (packet == NULL) return true;
+        uint16_t size;
 #ifdef ENABLE_LE_EXTENDED_ADVERTISING
         if (hci_extended_advertising_supported()){
             hci_stack->le_advertising_set_in_current_command = 0;
-            hci_send_cmd(&hci_le_set_extended_advertising_data, 0, 0x03, 0x01, hci_stack->le_advertisements_data_len, adv_data_clean);
+            size = hci_cmd_create_le_set_extended_advertising_data(packet, 0, 0x03, 0x01, hci_stack->le_advertisements_data_len, adv_data_clean);
         } else
 #endif
         {
-            hci_send_cmd(&hci_le_set_advertising_data, hci_stack->le_advertisements_data_len, adv_data_clean);
+            size = hci_cmd_create_le_set_advertising_data(packet, hci_stack->le_advertisements_data_len, adv_data_clean);
         }
+        (void) hci_send_reserved_cmd_packet_buffer(size);
         return true;
     }
 
@@ -6411,15 +6507,19 @@ static bool hci_run_general_gap_le(void){
         (void)memcpy(scan_data_clean, hci_stack->le_scan_response_data,
                      hci_stack->le_scan_response_data_len);
         btstack_replace_bd_addr_placeholder(scan_data_clean, hci_stack->le_scan_response_data_len, hci_stack->local_bd_addr);
+        uint8_t * packet = hci_reserve_cmd_packet_buffer();
+        if (packet == NULL) return true;
+        uint16_t size;
 #ifdef ENABLE_LE_EXTENDED_ADVERTISING
         if (hci_extended_advertising_supported()){
             hci_stack->le_advertising_set_in_current_command = 0;
-            hci_send_cmd(&hci_le_set_extended_scan_response_data, 0, 0x03, 0x01, hci_stack->le_scan_response_data_len, scan_data_clean);
+            size = hci_cmd_create_le_set_extended_scan_response_data(packet, 0, 0x03, 0x01, hci_stack->le_scan_response_data_len, scan_data_clean);
         } else
 #endif
         {
-            hci_send_cmd(&hci_le_set_scan_response_data, hci_stack->le_scan_response_data_len, scan_data_clean);
+            size = hci_cmd_create_le_set_scan_response_data(packet, hci_stack->le_scan_response_data_len, scan_data_clean);
         }
+        (void) hci_send_reserved_cmd_packet_buffer(size);
         return true;
     }
 
@@ -6475,7 +6575,10 @@ static bool hci_run_general_gap_le(void){
                     advertising_set->adv_data_pos += data_to_upload;
                 }
                 hci_stack->le_advertising_set_in_current_command = advertising_set->advertising_handle;
-                hci_send_cmd(&hci_le_set_extended_advertising_data, advertising_set->advertising_handle, operation, 0x01, data_to_upload, &advertising_set->adv_data[pos]);
+                uint8_t * packet = hci_reserve_cmd_packet_buffer();
+                if (packet == NULL) return true;
+                (void) hci_send_reserved_cmd_packet_buffer(hci_cmd_create_le_set_extended_advertising_data(packet,
+                    advertising_set->advertising_handle, operation, 0x01, (uint8_t) data_to_upload, &advertising_set->adv_data[pos]));
                 return true;
             }
             if ((advertising_set->tasks & LE_ADVERTISEMENT_TASKS_SET_SCAN_DATA) != 0) {
@@ -6489,7 +6592,10 @@ static bool hci_run_general_gap_le(void){
                     advertising_set->scan_data_pos += data_to_upload;
                 }
                 hci_stack->le_advertising_set_in_current_command = advertising_set->advertising_handle;
-                hci_send_cmd(&hci_le_set_extended_scan_response_data, advertising_set->advertising_handle, operation, 0x01, data_to_upload, &advertising_set->scan_data[pos]);
+                uint8_t * packet = hci_reserve_cmd_packet_buffer();
+                if (packet == NULL) return true;
+                (void) hci_send_reserved_cmd_packet_buffer(hci_cmd_create_le_set_extended_scan_response_data(packet,
+                    advertising_set->advertising_handle, operation, 0x01, (uint8_t) data_to_upload, &advertising_set->scan_data[pos]));
                 return true;
             }
 #ifdef ENABLE_LE_PERIODIC_ADVERTISING
@@ -6516,7 +6622,10 @@ static bool hci_run_general_gap_le(void){
                     advertising_set->periodic_data_pos += data_to_upload;
                 }
                 hci_stack->le_advertising_set_in_current_command = advertising_set->advertising_handle;
-                hci_send_cmd(&hci_le_set_periodic_advertising_data, advertising_set->advertising_handle, operation, data_to_upload, &advertising_set->periodic_data[pos]);
+                uint8_t * packet = hci_reserve_cmd_packet_buffer();
+                if (packet == NULL) return true;
+                (void) hci_send_reserved_cmd_packet_buffer(hci_cmd_create_le_set_periodic_advertising_data(packet,
+                    advertising_set->advertising_handle, operation, (uint8_t) data_to_upload, &advertising_set->periodic_data[pos]));
                 return true;
             }
 #endif /* ENABLE_LE_PERIODIC_ADVERTISING */
@@ -6728,14 +6837,18 @@ static bool hci_run_general_gap_le(void){
     // re-start scanning
     if ((hci_stack->le_scanning_enabled && !hci_stack->le_scanning_active)){
         hci_stack->le_scanning_active = true;
+        uint8_t * packet = hci_reserve_cmd_packet_buffer();
+        if (packet == NULL) return true;
+        uint16_t size;
 #ifdef ENABLE_LE_EXTENDED_ADVERTISING
         if (hci_extended_advertising_supported()){
-            hci_send_cmd(&hci_le_set_extended_scan_enable, 1, hci_stack->le_scan_filter_duplicates, 0, 0);
+            size = hci_cmd_create_le_set_extended_scan_enable(packet, 1, hci_stack->le_scan_filter_duplicates, 0, 0);
         } else
 #endif
         {
-            hci_send_cmd(&hci_le_set_scan_enable, 1, hci_stack->le_scan_filter_duplicates);
+            size = hci_cmd_create_le_set_scan_enable(packet, 1, hci_stack->le_scan_filter_duplicates);
         }
+        (void) hci_send_reserved_cmd_packet_buffer(size);
         return true;
     }
 #endif
@@ -6781,6 +6894,7 @@ static bool hci_run_general_gap_le(void){
 
 #ifdef ENABLE_LE_EXTENDED_ADVERTISING
         if (hci_extended_advertising_supported()){
+            hci_stack->le_advertising_set_in_current_command = 0;
             const uint8_t advertising_handles[] = { 0 };
             const uint16_t durations[] = { 0 };
             const uint16_t max_events[] = { 0 };
@@ -6801,6 +6915,7 @@ static bool hci_run_general_gap_le(void){
             le_advertising_set_t *advertising_set = (le_advertising_set_t *) btstack_linked_list_iterator_next(&it);
             if (((advertising_set->state & LE_ADVERTISEMENT_STATE_ENABLED) != 0) && ((advertising_set->state & LE_ADVERTISEMENT_STATE_ACTIVE) == 0)){
                 advertising_set->state |= LE_ADVERTISEMENT_STATE_ACTIVE;
+                hci_stack->le_advertising_set_in_current_command = advertising_set->advertising_handle;
                 const uint8_t advertising_handles[] = { advertising_set->advertising_handle };
                 const uint16_t durations[] = { advertising_set->enable_timeout };
                 const uint16_t max_events[] = { advertising_set->enable_max_scan_events };
@@ -7042,368 +7157,428 @@ static bool hci_run_iso_tasks(void){
 #endif /* ENABLE_LE_ISOCHRONOUS_STREAMS */
 #endif
 
-static bool hci_run_general_pending_commands(void){
-    btstack_linked_item_t * it;
-    for (it = (btstack_linked_item_t *) hci_stack->connections; it != NULL; it = it->next){
-        hci_connection_t * connection = (hci_connection_t *) it;
+static bool hci_run_connection(hci_connection_t * connection){
 
-        switch(connection->state){
-            case SEND_CREATE_CONNECTION:
-                switch(connection->address_type){
+    switch(connection->state){
+        case SEND_CREATE_CONNECTION:
+            switch(connection->address_type){
 #ifdef ENABLE_CLASSIC
-                    case BD_ADDR_TYPE_ACL:
-                        log_info("sending hci_create_connection");
-                        hci_send_cmd(&hci_create_connection, connection->address, hci_usable_acl_packet_types(), 0, 0, 0, hci_stack->allow_role_switch);
-                        break;
+                case BD_ADDR_TYPE_ACL:
+                    log_info("sending hci_create_connection");
+                    hci_send_cmd(&hci_create_connection, connection->address, hci_usable_acl_packet_types(), 0, 0, 0, hci_stack->allow_role_switch);
+                    break;
 #endif
-                    default:
+                default:
 #ifdef ENABLE_BLE
 #ifdef ENABLE_LE_CENTRAL
-                        log_info("sending hci_le_create_connection");
-                        hci_stack->le_connection_own_addr_type =  hci_stack->le_own_addr_type;
-                        hci_get_own_address_for_addr_type(hci_stack->le_connection_own_addr_type, hci_stack->le_connection_own_address);
-                        hci_send_le_create_connection(0, connection->address_type, connection->address);
-                        connection->state = SENT_CREATE_CONNECTION;
+                    log_info("sending hci_le_create_connection");
+                    hci_stack->le_connection_own_addr_type =  hci_stack->le_own_addr_type;
+                    hci_get_own_address_for_addr_type(hci_stack->le_connection_own_addr_type, hci_stack->le_connection_own_address);
+                    hci_send_le_create_connection(0, connection->address_type, connection->address);
+                    connection->state = SENT_CREATE_CONNECTION;
 #endif
 #endif
-                        break;
-                }
-                return true;
+                    break;
+            }
+            return true;
 
 #ifdef ENABLE_CLASSIC
-            case RECEIVED_CONNECTION_REQUEST:
-                if (connection->address_type == BD_ADDR_TYPE_ACL){
-                    log_info("sending hci_accept_connection_request");
-                    connection->state = ACCEPTED_CONNECTION_REQUEST;
-                    hci_send_cmd(&hci_accept_connection_request, connection->address, hci_stack->master_slave_policy);
-                    return true;
-                }
-                break;
-#endif
-            case SEND_DISCONNECT:
-                connection->state = SENT_DISCONNECT;
-                hci_send_cmd(&hci_disconnect, connection->con_handle, ERROR_CODE_REMOTE_USER_TERMINATED_CONNECTION);
+        case RECEIVED_CONNECTION_REQUEST:
+            if (connection->address_type == BD_ADDR_TYPE_ACL){
+                log_info("sending hci_accept_connection_request");
+                connection->state = ACCEPTED_CONNECTION_REQUEST;
+                hci_send_cmd(&hci_accept_connection_request, connection->address, hci_stack->master_slave_policy);
                 return true;
+            }
+            break;
+#endif
+        case SEND_DISCONNECT:
+            connection->state = SENT_DISCONNECT;
+            hci_send_cmd(&hci_disconnect, connection->con_handle, ERROR_CODE_REMOTE_USER_TERMINATED_CONNECTION);
+            return true;
 
-            default:
-                break;
-        }
+        default:
+            break;
+    }
 
-        // no further commands if connection is about to get shut down
-        if (connection->state == SENT_DISCONNECT) continue;
+    // no further commands if connection is about to get shut down
+    if (connection->state == SENT_DISCONNECT) return false;
 
 #ifdef ENABLE_CLASSIC
 
-        // Handling link key request requires remote supported features
-        if (((connection->authentication_flags & AUTH_FLAG_HANDLE_LINK_KEY_REQUEST) != 0)){
-            log_info("responding to link key request, have link key db: %u", hci_stack->link_key_db != NULL);
-            connectionClearAuthenticationFlags(connection, AUTH_FLAG_HANDLE_LINK_KEY_REQUEST);
+    // Handling link key request requires remote supported features
+    if (((connection->authentication_flags & AUTH_FLAG_HANDLE_LINK_KEY_REQUEST) != 0)){
+        log_info("responding to link key request, have link key db: %u", hci_stack->link_key_db != NULL);
+        connectionClearAuthenticationFlags(connection, AUTH_FLAG_HANDLE_LINK_KEY_REQUEST);
 
-            bool have_link_key = connection->link_key_type != INVALID_LINK_KEY;
-            bool security_level_sufficient = have_link_key && (gap_security_level_for_link_key_type(connection->link_key_type) >= connection->requested_security_level);
-            if (have_link_key && security_level_sufficient){
-                hci_send_cmd(&hci_link_key_request_reply, connection->address, &connection->link_key);
-            } else {
-                hci_send_cmd(&hci_link_key_request_negative_reply, connection->address);
-            }
-            return true;
+        bool have_link_key = connection->link_key_type != INVALID_LINK_KEY;
+        bool security_level_sufficient = have_link_key && (gap_security_level_for_link_key_type(connection->link_key_type) >= connection->requested_security_level);
+        if (have_link_key && security_level_sufficient){
+            hci_send_cmd(&hci_link_key_request_reply, connection->address, &connection->link_key);
+        } else {
+            hci_send_cmd(&hci_link_key_request_negative_reply, connection->address);
         }
+        return true;
+    }
 
-        if (connection->authentication_flags & AUTH_FLAG_DENY_PIN_CODE_REQUEST){
-            log_info("denying to pin request");
-            connectionClearAuthenticationFlags(connection, AUTH_FLAG_DENY_PIN_CODE_REQUEST);
-            hci_send_cmd(&hci_pin_code_request_negative_reply, connection->address);
-            return true;
-        }
+    if (connection->authentication_flags & AUTH_FLAG_DENY_PIN_CODE_REQUEST){
+        log_info("denying to pin request");
+        connectionClearAuthenticationFlags(connection, AUTH_FLAG_DENY_PIN_CODE_REQUEST);
+        hci_send_cmd(&hci_pin_code_request_negative_reply, connection->address);
+        return true;
+    }
 
-        // security assessment requires remote features
-        if ((connection->authentication_flags & AUTH_FLAG_RECV_IO_CAPABILITIES_REQUEST) != 0){
-            connectionClearAuthenticationFlags(connection, AUTH_FLAG_RECV_IO_CAPABILITIES_REQUEST);
-            hci_ssp_assess_security_on_io_cap_request(connection);
-            // no return here as hci_ssp_assess_security_on_io_cap_request only sets AUTH_FLAG_SEND_IO_CAPABILITIES_REPLY or AUTH_FLAG_SEND_IO_CAPABILITIES_NEGATIVE_REPLY
-        }
-
-        if (connection->authentication_flags & AUTH_FLAG_SEND_IO_CAPABILITIES_REPLY){
-            connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_IO_CAPABILITIES_REPLY);
-            // set authentication requirements:
-            // - MITM = ssp_authentication_requirement (USER) | requested_security_level (dynamic)
-            // - BONDING MODE: dedicated if requested, bondable otherwise. Drop bondable if not set for remote
-            uint8_t authreq = hci_stack->ssp_authentication_requirement & 1;
-            if (gap_mitm_protection_required_for_security_level(connection->requested_security_level)){
-                authreq |= 1;
-            }
-            bool bonding = hci_stack->bondable;
-            if (connection->authentication_flags & AUTH_FLAG_RECV_IO_CAPABILITIES_RESPONSE){
-                // if we have received IO Cap Response, we're in responder role
-                bool remote_bonding = connection->io_cap_response_auth_req >= SSP_IO_AUTHREQ_MITM_PROTECTION_NOT_REQUIRED_DEDICATED_BONDING;
-                if (bonding && !remote_bonding){
-                    log_info("Remote not bonding, dropping local flag");
-                    bonding = false;
-                }
+    // security assessment requires remote features
+    if ((connection->authentication_flags & AUTH_FLAG_RECV_IO_CAPABILITIES_REQUEST) != 0){
+        connectionClearAuthenticationFlags(connection, AUTH_FLAG_RECV_IO_CAPABILITIES_REQUEST);
+        hci_ssp_assess_security_on_io_cap_request(connection);
+        // no return here as hci_ssp_assess_security_on_io_cap_request only sets AUTH_FLAG_SEND_IO_CAPABILITIES_REPLY or AUTH_FLAG_SEND_IO_CAPABILITIES_NEGATIVE_REPLY
+    }
+
+    if (connection->authentication_flags & AUTH_FLAG_SEND_IO_CAPABILITIES_REPLY){
+        connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_IO_CAPABILITIES_REPLY);
+        // set authentication requirements:
+        // - MITM = ssp_authentication_requirement (USER) | requested_security_level (dynamic)
+        // - BONDING MODE: dedicated if requested, bondable otherwise. Drop bondable if not set for remote
+        uint8_t authreq = hci_stack->ssp_authentication_requirement & 1;
+        if (gap_mitm_protection_required_for_security_level(connection->requested_security_level)){
+            authreq |= 1;
+        }
+        bool bonding = hci_stack->bondable;
+        if (connection->authentication_flags & AUTH_FLAG_RECV_IO_CAPABILITIES_RESPONSE){
+            // if we have received IO Cap Response, we're in responder role
+            bool remote_bonding = connection->io_cap_response_auth_req >= SSP_IO_AUTHREQ_MITM_PROTECTION_NOT_REQUIRED_DEDICATED_BONDING;
+            if (bonding && !remote_bonding){
+                log_info("Remote not bonding, dropping local flag");
+                bonding = false;
             }
-            if (bonding){
-                if (connection->bonding_flags & BONDING_DEDICATED){
-                    authreq |= SSP_IO_AUTHREQ_MITM_PROTECTION_NOT_REQUIRED_DEDICATED_BONDING;
-                } else {
-                    authreq |= SSP_IO_AUTHREQ_MITM_PROTECTION_NOT_REQUIRED_GENERAL_BONDING;
-                }
+        }
+        if (bonding){
+            if (connection->bonding_flags & BONDING_DEDICATED){
+                authreq |= SSP_IO_AUTHREQ_MITM_PROTECTION_NOT_REQUIRED_DEDICATED_BONDING;
+            } else {
+                authreq |= SSP_IO_AUTHREQ_MITM_PROTECTION_NOT_REQUIRED_GENERAL_BONDING;
             }
-            uint8_t have_oob_data = 0;
+        }
+        uint8_t have_oob_data = 0;
 #ifdef ENABLE_CLASSIC_PAIRING_OOB
-            if (connection->classic_oob_c_192 != NULL){
-                    have_oob_data |= 1;
-            }
-            if (connection->classic_oob_c_256 != NULL){
-                have_oob_data |= 2;
-            }
-#endif
-            hci_send_cmd(&hci_io_capability_request_reply, &connection->address, hci_stack->ssp_io_capability, have_oob_data, authreq);
-            return true;
+        if (connection->classic_oob_c_192 != NULL){
+                have_oob_data |= 1;
         }
-
-        if (connection->authentication_flags & AUTH_FLAG_SEND_IO_CAPABILITIES_NEGATIVE_REPLY) {
-            connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_IO_CAPABILITIES_NEGATIVE_REPLY);
-            hci_send_cmd(&hci_io_capability_request_negative_reply, &connection->address, ERROR_CODE_PAIRING_NOT_ALLOWED);
-            return true;
+        if (connection->classic_oob_c_256 != NULL){
+            have_oob_data |= 2;
         }
+#endif
+        hci_send_cmd(&hci_io_capability_request_reply, &connection->address, hci_stack->ssp_io_capability, have_oob_data, authreq);
+        return true;
+    }
 
-#ifdef ENABLE_CLASSIC_PAIRING_OOB
-        if (connection->authentication_flags & AUTH_FLAG_SEND_REMOTE_OOB_DATA_REPLY){
-            connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_REMOTE_OOB_DATA_REPLY);
-            const uint8_t zero[16] = { 0 };
-            const uint8_t * r_192 = zero;
-            const uint8_t * c_192 = zero;
-            const uint8_t * r_256 = zero;
-            const uint8_t * c_256 = zero;
-            // verify P-256 OOB
-            if ((connection->classic_oob_c_256 != NULL) && hci_command_supported(SUPPORTED_HCI_COMMAND_REMOTE_OOB_EXTENDED_DATA_REQUEST_REPLY)) {
-                c_256 = connection->classic_oob_c_256;
-                if (connection->classic_oob_r_256 != NULL) {
-                    r_256 = connection->classic_oob_r_256;
-                }
-            }
-            // verify P-192 OOB
-            if ((connection->classic_oob_c_192 != NULL)) {
-                c_192 = connection->classic_oob_c_192;
-                if (connection->classic_oob_r_192 != NULL) {
-                    r_192 = connection->classic_oob_r_192;
-                }
-            }
-
-            // assess security
-            bool need_level_4 = hci_stack->gap_secure_connections_only_mode || (connection->requested_security_level == LEVEL_4);
-            bool can_reach_level_4 = hci_remote_sc_enabled(connection) && (c_256 != NULL);
-            if (need_level_4 && !can_reach_level_4){
-                log_info("Level 4 required, but not possible -> abort");
-                hci_pairing_complete(connection, ERROR_CODE_INSUFFICIENT_SECURITY);
-                // send oob negative reply
-                c_256 = NULL;
-                c_192 = NULL;
-            }
+    if (connection->authentication_flags & AUTH_FLAG_SEND_IO_CAPABILITIES_NEGATIVE_REPLY) {
+        connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_IO_CAPABILITIES_NEGATIVE_REPLY);
+        hci_send_cmd(&hci_io_capability_request_negative_reply, &connection->address, ERROR_CODE_PAIRING_NOT_ALLOWED);
+        return true;
+    }
 
-            // Reply
-            if (c_256 != zero) {
-                hci_send_cmd(&hci_remote_oob_extended_data_request_reply, &connection->address, c_192, r_192, c_256, r_256);
-            } else if (c_192 != zero){
-                hci_send_cmd(&hci_remote_oob_data_request_reply, &connection->address, c_192, r_192);
-            } else {
-                hci_stack->classic_oob_con_handle = connection->con_handle;
-                hci_send_cmd(&hci_remote_oob_data_request_negative_reply, &connection->address);
-            }
-            return true;
+#ifdef ENABLE_CLASSIC_PAIRING_OOB
+    if (connection->authentication_flags & AUTH_FLAG_SEND_REMOTE_OOB_DATA_REPLY){
+        connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_REMOTE_OOB_DATA_REPLY);
+        const uint8_t zero[16] = { 0 };
+        const uint8_t * r_192 = zero;
+        const uint8_t * c_192 = zero;
+        const uint8_t * r_256 = zero;
+        const uint8_t * c_256 = zero;
+        // verify P-256 OOB
+        if ((connection->classic_oob_c_256 != NULL) && hci_command_supported(SUPPORTED_HCI_COMMAND_REMOTE_OOB_EXTENDED_DATA_REQUEST_REPLY)) {
+            c_256 = connection->classic_oob_c_256;
+            if (connection->classic_oob_r_256 != NULL) {
+                r_256 = connection->classic_oob_r_256;
+            }
+        }
+        // verify P-192 OOB
+        if ((connection->classic_oob_c_192 != NULL)) {
+            c_192 = connection->classic_oob_c_192;
+            if (connection->classic_oob_r_192 != NULL) {
+                r_192 = connection->classic_oob_r_192;
+            }
+        }
+
+        // assess security
+        bool need_level_4 = hci_stack->gap_secure_connections_only_mode || (connection->requested_security_level == LEVEL_4);
+        bool can_reach_level_4 = hci_remote_sc_enabled(connection) && (c_256 != NULL);
+        if (need_level_4 && !can_reach_level_4){
+            log_info("Level 4 required, but not possible -> abort");
+            hci_pairing_complete(connection, ERROR_CODE_INSUFFICIENT_SECURITY);
+            // send oob negative reply
+            c_256 = NULL;
+            c_192 = NULL;
+        }
+
+        // Reply
+        if (c_256 != zero) {
+            hci_send_cmd(&hci_remote_oob_extended_data_request_reply, &connection->address, c_192, r_192, c_256, r_256);
+        } else if (c_192 != zero){
+            hci_send_cmd(&hci_remote_oob_data_request_reply, &connection->address, c_192, r_192);
+        } else {
+            hci_stack->classic_oob_con_handle = connection->con_handle;
+            hci_send_cmd(&hci_remote_oob_data_request_negative_reply, &connection->address);
         }
+        return true;
+    }
 #endif
 
-        if (connection->authentication_flags & AUTH_FLAG_SEND_USER_CONFIRM_REPLY){
-            connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_USER_CONFIRM_REPLY);
-            hci_send_cmd(&hci_user_confirmation_request_reply, &connection->address);
-            return true;
-        }
+    if (connection->authentication_flags & AUTH_FLAG_SEND_USER_CONFIRM_REPLY){
+        connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_USER_CONFIRM_REPLY);
+        hci_send_cmd(&hci_user_confirmation_request_reply, &connection->address);
+        return true;
+    }
 
-        if (connection->authentication_flags & AUTH_FLAG_SEND_USER_CONFIRM_NEGATIVE_REPLY){
-            connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_USER_CONFIRM_NEGATIVE_REPLY);
-            hci_send_cmd(&hci_user_confirmation_request_negative_reply, &connection->address);
-            return true;
-        }
+    if (connection->authentication_flags & AUTH_FLAG_SEND_USER_CONFIRM_NEGATIVE_REPLY){
+        connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_USER_CONFIRM_NEGATIVE_REPLY);
+        hci_send_cmd(&hci_user_confirmation_request_negative_reply, &connection->address);
+        return true;
+    }
 
-        if (connection->authentication_flags & AUTH_FLAG_SEND_USER_PASSKEY_REPLY){
-            connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_USER_PASSKEY_REPLY);
-            hci_send_cmd(&hci_user_passkey_request_reply, &connection->address, 000000);
-            return true;
-        }
+    if (connection->authentication_flags & AUTH_FLAG_SEND_USER_PASSKEY_REPLY){
+        connectionClearAuthenticationFlags(connection, AUTH_FLAG_SEND_USER_PASSKEY_REPLY);
+        hci_send_cmd(&hci_user_passkey_request_reply, &connection->address, 000000);
+        return true;
+    }
 
-        if ((connection->bonding_flags & (BONDING_DISCONNECT_DEDICATED_DONE | BONDING_DEDICATED_DEFER_DISCONNECT)) == BONDING_DISCONNECT_DEDICATED_DONE){
-            connection->bonding_flags &= ~BONDING_DISCONNECT_DEDICATED_DONE;
-            connection->bonding_flags |= BONDING_EMIT_COMPLETE_ON_DISCONNECT;
-            connection->state = SENT_DISCONNECT;
-            hci_send_cmd(&hci_disconnect, connection->con_handle, ERROR_CODE_REMOTE_USER_TERMINATED_CONNECTION);
-            return true;
-        }
+    if ((connection->bonding_flags & (BONDING_DISCONNECT_DEDICATED_DONE | BONDING_DEDICATED_DEFER_DISCONNECT)) == BONDING_DISCONNECT_DEDICATED_DONE){
+        connection->bonding_flags &= ~BONDING_DISCONNECT_DEDICATED_DONE;
+        connection->bonding_flags |= BONDING_EMIT_COMPLETE_ON_DISCONNECT;
+        connection->state = SENT_DISCONNECT;
+        hci_send_cmd(&hci_disconnect, connection->con_handle, ERROR_CODE_REMOTE_USER_TERMINATED_CONNECTION);
+        return true;
+    }
 
-        if ((connection->bonding_flags & BONDING_SEND_AUTHENTICATE_REQUEST) && ((connection->bonding_flags & BONDING_RECEIVED_REMOTE_FEATURES) != 0)){
-            connection->bonding_flags &= ~BONDING_SEND_AUTHENTICATE_REQUEST;
-            connection->bonding_flags |= BONDING_SENT_AUTHENTICATE_REQUEST;
-            hci_send_cmd(&hci_authentication_requested, connection->con_handle);
-            return true;
-        }
+    if ((connection->bonding_flags & BONDING_SEND_AUTHENTICATE_REQUEST) && ((connection->bonding_flags & BONDING_RECEIVED_REMOTE_FEATURES) != 0)){
+        connection->bonding_flags &= ~BONDING_SEND_AUTHENTICATE_REQUEST;
+        connection->bonding_flags |= BONDING_SENT_AUTHENTICATE_REQUEST;
+        hci_send_cmd(&hci_authentication_requested, connection->con_handle);
+        return true;
+    }
 
-        if (connection->bonding_flags & BONDING_SEND_ENCRYPTION_REQUEST){
-            connection->bonding_flags &= ~BONDING_SEND_ENCRYPTION_REQUEST;
-            hci_send_cmd(&hci_set_connection_encryption, connection->con_handle, 1);
-            return true;
-        }
+    if (connection->bonding_flags & BONDING_SEND_ENCRYPTION_REQUEST){
+        connection->bonding_flags &= ~BONDING_SEND_ENCRYPTION_REQUEST;
+        hci_send_cmd(&hci_set_connection_encryption, connection->con_handle, 1);
+        return true;
+    }
 
-        if (connection->bonding_flags & BONDING_SEND_READ_ENCRYPTION_KEY_SIZE){
-            connection->bonding_flags &= ~BONDING_SEND_READ_ENCRYPTION_KEY_SIZE;
-            hci_send_cmd(&hci_read_encryption_key_size, connection->con_handle, 1);
-            return true;
-        }
+    if (connection->bonding_flags & BONDING_SEND_READ_ENCRYPTION_KEY_SIZE){
+        connection->bonding_flags &= ~BONDING_SEND_READ_ENCRYPTION_KEY_SIZE;
+        hci_send_cmd(&hci_read_encryption_key_size, connection->con_handle, 1);
+        return true;
+    }
 
-        if (connection->bonding_flags & BONDING_REQUEST_REMOTE_FEATURES_PAGE_0){
-            connection->bonding_flags &= ~BONDING_REQUEST_REMOTE_FEATURES_PAGE_0;
-            hci_send_cmd(&hci_read_remote_supported_features_command, connection->con_handle);
-            return true;
-        }
+    if (connection->bonding_flags & BONDING_REQUEST_REMOTE_FEATURES_PAGE_0){
+        connection->bonding_flags &= ~BONDING_REQUEST_REMOTE_FEATURES_PAGE_0;
+        hci_send_cmd(&hci_read_remote_supported_features_command, connection->con_handle);
+        return true;
+    }
 
-        if (connection->bonding_flags & BONDING_REQUEST_REMOTE_FEATURES_PAGE_1){
-            connection->bonding_flags &= ~BONDING_REQUEST_REMOTE_FEATURES_PAGE_1;
-            hci_send_cmd(&hci_read_remote_extended_features_command, connection->con_handle, 1);
-            return true;
-        }
+    if (connection->bonding_flags & BONDING_REQUEST_REMOTE_FEATURES_PAGE_1){
+        connection->bonding_flags &= ~BONDING_REQUEST_REMOTE_FEATURES_PAGE_1;
+        hci_send_cmd(&hci_read_remote_extended_features_command, connection->con_handle, 1);
+        return true;
+    }
 
-        if (connection->bonding_flags & BONDING_REQUEST_REMOTE_FEATURES_PAGE_2){
-            connection->bonding_flags &= ~BONDING_REQUEST_REMOTE_FEATURES_PAGE_2;
-            hci_send_cmd(&hci_read_remote_extended_features_command, connection->con_handle, 2);
-            return true;
-        }
+    if (connection->bonding_flags & BONDING_REQUEST_REMOTE_FEATURES_PAGE_2){
+        connection->bonding_flags &= ~BONDING_REQUEST_REMOTE_FEATURES_PAGE_2;
+        hci_send_cmd(&hci_read_remote_extended_features_command, connection->con_handle, 2);
+        return true;
+    }
 #endif
 
-        if (connection->bonding_flags & BONDING_DISCONNECT_SECURITY_BLOCK){
-            connection->bonding_flags &= ~BONDING_DISCONNECT_SECURITY_BLOCK;
+    if (connection->bonding_flags & BONDING_DISCONNECT_SECURITY_BLOCK){
+        connection->bonding_flags &= ~BONDING_DISCONNECT_SECURITY_BLOCK;
 #ifdef ENABLE_CLASSIC
-            hci_pairing_complete(connection, ERROR_CODE_CONNECTION_REJECTED_DUE_TO_SECURITY_REASONS);
+        hci_pairing_complete(connection, ERROR_CODE_CONNECTION_REJECTED_DUE_TO_SECURITY_REASONS);
 #endif
-            if (connection->state != SENT_DISCONNECT){
-                connection->state = SENT_DISCONNECT;
-                hci_send_cmd(&hci_disconnect, connection->con_handle, ERROR_CODE_AUTHENTICATION_FAILURE);
-                return true;
-            }
+        if (connection->state != SENT_DISCONNECT){
+            connection->state = SENT_DISCONNECT;
+            hci_send_cmd(&hci_disconnect, connection->con_handle, ERROR_CODE_AUTHENTICATION_FAILURE);
+            return true;
         }
+    }
 
 #ifdef ENABLE_CLASSIC
-        uint16_t sniff_min_interval;
-        switch (connection->sniff_min_interval){
-            case 0:
-                break;
-            case 0xffff:
-                connection->sniff_min_interval = 0;
-                hci_send_cmd(&hci_exit_sniff_mode, connection->con_handle);
-                return true;
-            default:
-                sniff_min_interval = connection->sniff_min_interval;
-                connection->sniff_min_interval = 0;
-                hci_send_cmd(&hci_sniff_mode, connection->con_handle, connection->sniff_max_interval, sniff_min_interval, connection->sniff_attempt, connection->sniff_timeout);
-                return true;
-        }
-
-        if (connection->sniff_subrating_max_latency != 0xffff){
-            uint16_t max_latency = connection->sniff_subrating_max_latency;
-            connection->sniff_subrating_max_latency = 0;
-            hci_send_cmd(&hci_sniff_subrating, connection->con_handle, max_latency, connection->sniff_subrating_min_remote_timeout, connection->sniff_subrating_min_local_timeout);
+    uint16_t sniff_min_interval;
+    switch (connection->sniff_min_interval){
+        case 0:
+            break;
+        case 0xffff:
+            connection->sniff_min_interval = 0;
+            hci_send_cmd(&hci_exit_sniff_mode, connection->con_handle);
             return true;
-        }
-
-        if (connection->qos_service_type != HCI_SERVICE_TYPE_INVALID){
-            uint8_t service_type = (uint8_t) connection->qos_service_type;
-            connection->qos_service_type = HCI_SERVICE_TYPE_INVALID;
-            hci_send_cmd(&hci_qos_setup, connection->con_handle, 0, service_type, connection->qos_token_rate, connection->qos_peak_bandwidth, connection->qos_latency, connection->qos_delay_variation);
+        default:
+            sniff_min_interval = connection->sniff_min_interval;
+            connection->sniff_min_interval = 0;
+            hci_send_cmd(&hci_sniff_mode, connection->con_handle, connection->sniff_max_interval, sniff_min_interval, connection->sniff_attempt, connection->sniff_timeout);
             return true;
-        }
+    }
 
-        if (connection->request_role != HCI_ROLE_INVALID){
-            hci_role_t role = connection->request_role;
-            connection->request_role = HCI_ROLE_INVALID;
-            hci_send_cmd(&hci_switch_role_command, connection->address, role);
-            return true;
-        }
+    if (connection->sniff_subrating_max_latency != 0xffff){
+        uint16_t max_latency = connection->sniff_subrating_max_latency;
+        connection->sniff_subrating_max_latency = 0;
+        hci_send_cmd(&hci_sniff_subrating, connection->con_handle, max_latency, connection->sniff_subrating_min_remote_timeout, connection->sniff_subrating_min_local_timeout);
+        return true;
+    }
+
+    if (connection->qos_service_type != HCI_SERVICE_TYPE_INVALID){
+        uint8_t service_type = (uint8_t) connection->qos_service_type;
+        connection->qos_service_type = HCI_SERVICE_TYPE_INVALID;
+        hci_send_cmd(&hci_qos_setup, connection->con_handle, 0, service_type, connection->qos_token_rate, connection->qos_peak_bandwidth, connection->qos_latency, connection->qos_delay_variation);
+        return true;
+    }
+
+    if (connection->request_role != HCI_ROLE_INVALID){
+        hci_role_t role = connection->request_role;
+        connection->request_role = HCI_ROLE_INVALID;
+        hci_send_cmd(&hci_switch_role_command, connection->address, role);
+        return true;
+    }
 #endif
 
-        if (connection->gap_connection_tasks != 0){
+    if (connection->gap_connection_tasks != 0){
 #ifdef ENABLE_CLASSIC
-            if ((connection->gap_connection_tasks & GAP_CONNECTION_TASK_WRITE_AUTOMATIC_FLUSH_TIMEOUT) != 0){
-                connection->gap_connection_tasks &= ~GAP_CONNECTION_TASK_WRITE_AUTOMATIC_FLUSH_TIMEOUT;
-                hci_send_cmd(&hci_write_automatic_flush_timeout, connection->con_handle, hci_stack->automatic_flush_timeout);
-                return true;
-            }
-            if (connection->gap_connection_tasks & GAP_CONNECTION_TASK_WRITE_SUPERVISION_TIMEOUT){
-                connection->gap_connection_tasks &= ~GAP_CONNECTION_TASK_WRITE_SUPERVISION_TIMEOUT;
-                hci_send_cmd(&hci_write_link_supervision_timeout, connection->con_handle, hci_stack->link_supervision_timeout);
-                return true;
-            }
+        if ((connection->gap_connection_tasks & GAP_CONNECTION_TASK_WRITE_AUTOMATIC_FLUSH_TIMEOUT) != 0){
+            connection->gap_connection_tasks &= ~GAP_CONNECTION_TASK_WRITE_AUTOMATIC_FLUSH_TIMEOUT;
+            hci_send_cmd(&hci_write_automatic_flush_timeout, connection->con_handle, hci_stack->automatic_flush_timeout);
+            return true;
+        }
+        if (connection->gap_connection_tasks & GAP_CONNECTION_TASK_WRITE_SUPERVISION_TIMEOUT){
+            connection->gap_connection_tasks &= ~GAP_CONNECTION_TASK_WRITE_SUPERVISION_TIMEOUT;
+            hci_send_cmd(&hci_write_link_supervision_timeout, connection->con_handle, hci_stack->link_supervision_timeout);
+            return true;
+        }
 #endif
-            if (connection->gap_connection_tasks & GAP_CONNECTION_TASK_READ_RSSI){
-                connection->gap_connection_tasks &= ~GAP_CONNECTION_TASK_READ_RSSI;
-                hci_send_cmd(&hci_read_rssi, connection->con_handle);
-                return true;
-            }
+        if (connection->gap_connection_tasks & GAP_CONNECTION_TASK_READ_RSSI){
+            connection->gap_connection_tasks &= ~GAP_CONNECTION_TASK_READ_RSSI;
+            hci_send_cmd(&hci_read_rssi, connection->con_handle);
+            return true;
+        }
 #ifdef ENABLE_BLE
-            if (connection->gap_connection_tasks & GAP_CONNECTION_TASK_LE_READ_REMOTE_FEATURES){
-                connection->gap_connection_tasks &= ~GAP_CONNECTION_TASK_LE_READ_REMOTE_FEATURES;
-                hci_send_cmd(&hci_le_read_remote_used_features, connection->con_handle);
-                return true;
-            }
-#endif
+        if (connection->gap_connection_tasks & GAP_CONNECTION_TASK_LE_READ_REMOTE_FEATURES){
+            connection->gap_connection_tasks &= ~GAP_CONNECTION_TASK_LE_READ_REMOTE_FEATURES;
+            hci_send_cmd(&hci_le_read_remote_used_features, connection->con_handle);
+            return true;
         }
+#endif
+    }
 
 #ifdef ENABLE_BLE
-        switch (connection->le_con_parameter_update_state){
-            // response to L2CAP CON PARAMETER UPDATE REQUEST
-            case CON_PARAMETER_UPDATE_CHANGE_HCI_CON_PARAMETERS:
-                connection->le_con_parameter_update_state = CON_PARAMETER_UPDATE_NONE;
-                hci_send_cmd(&hci_le_connection_update, connection->con_handle, connection->le_conn_interval_min,
-                             connection->le_conn_interval_max, connection->le_conn_latency, connection->le_supervision_timeout,
-                             hci_stack->le_minimum_ce_length, hci_stack->le_maximum_ce_length);
-                return true;
-            case CON_PARAMETER_UPDATE_REPLY:
-                connection->le_con_parameter_update_state = CON_PARAMETER_UPDATE_NONE;
-                hci_send_cmd(&hci_le_remote_connection_parameter_request_reply, connection->con_handle, connection->le_conn_interval_min,
-                             connection->le_conn_interval_max, connection->le_conn_latency, connection->le_supervision_timeout,
-                             hci_stack->le_minimum_ce_length, hci_stack->le_maximum_ce_length);
-                return true;
-            case CON_PARAMETER_UPDATE_NEGATIVE_REPLY:
-                connection->le_con_parameter_update_state = CON_PARAMETER_UPDATE_NONE;
-                hci_send_cmd(&hci_le_remote_connection_parameter_request_negative_reply, connection->con_handle,
-                             ERROR_CODE_UNACCEPTABLE_CONNECTION_PARAMETERS);
-                return true;
-            default:
-                break;
-        }
-        if (connection->le_phy_update_all_phys != 0xffu){
-            uint8_t all_phys = connection->le_phy_update_all_phys;
-            connection->le_phy_update_all_phys = 0xff;
-            hci_send_cmd(&hci_le_set_phy, connection->con_handle, all_phys, connection->le_phy_update_tx_phys, connection->le_phy_update_rx_phys, connection->le_phy_update_phy_options);
+    switch (connection->le_con_parameter_update_state){
+        // response to L2CAP CON PARAMETER UPDATE REQUEST
+        case CON_PARAMETER_UPDATE_CHANGE_HCI_CON_PARAMETERS:
+            connection->le_con_parameter_update_state = CON_PARAMETER_UPDATE_NONE;
+            hci_send_cmd(&hci_le_connection_update, connection->con_handle, connection->le_conn_interval_min,
+                         connection->le_conn_interval_max, connection->le_conn_latency, connection->le_supervision_timeout,
+                         hci_stack->le_minimum_ce_length, hci_stack->le_maximum_ce_length);
             return true;
-        }
-#ifdef ENABLE_LE_PERIODIC_ADVERTISING
-        if (connection->le_past_sync_handle != HCI_CON_HANDLE_INVALID){
-            hci_con_handle_t sync_handle = connection->le_past_sync_handle;
-            connection->le_past_sync_handle = HCI_CON_HANDLE_INVALID;
-            hci_send_cmd(&hci_le_periodic_advertising_sync_transfer, connection->con_handle, connection->le_past_service_data, sync_handle);
+        case CON_PARAMETER_UPDATE_REPLY:
+            connection->le_con_parameter_update_state = CON_PARAMETER_UPDATE_NONE;
+            hci_send_cmd(&hci_le_remote_connection_parameter_request_reply, connection->con_handle, connection->le_conn_interval_min,
+                         connection->le_conn_interval_max, connection->le_conn_latency, connection->le_supervision_timeout,
+                         hci_stack->le_minimum_ce_length, hci_stack->le_maximum_ce_length);
             return true;
-        }
-        if (connection->le_past_advertising_handle != 0xff){
-            uint8_t advertising_handle = connection->le_past_advertising_handle;
-            connection->le_past_advertising_handle = 0xff;
-            hci_send_cmd(&hci_le_periodic_advertising_set_info_transfer, connection->con_handle, connection->le_past_service_data, advertising_handle);
+        case CON_PARAMETER_UPDATE_NEGATIVE_REPLY:
+            connection->le_con_parameter_update_state = CON_PARAMETER_UPDATE_NONE;
+            hci_send_cmd(&hci_le_remote_connection_parameter_request_negative_reply, connection->con_handle,
+                         ERROR_CODE_UNACCEPTABLE_CONNECTION_PARAMETERS);
+            return true;
+        default:
+            break;
+    }
+    if (connection->le_phy_update_all_phys != 0xffu){
+        uint8_t all_phys = connection->le_phy_update_all_phys;
+        connection->le_phy_update_all_phys = 0xff;
+        hci_send_cmd(&hci_le_set_phy, connection->con_handle, all_phys, connection->le_phy_update_tx_phys, connection->le_phy_update_rx_phys, connection->le_phy_update_phy_options);
+        return true;
+    }
+#ifdef ENABLE_LE_PERIODIC_ADVERTISING
+    if (connection->le_past_sync_handle != HCI_CON_HANDLE_INVALID){
+        hci_con_handle_t sync_handle = connection->le_past_sync_handle;
+        connection->le_past_sync_handle = HCI_CON_HANDLE_INVALID;
+        hci_send_cmd(&hci_le_periodic_advertising_sync_transfer, connection->con_handle, connection->le_past_service_data, sync_handle);
+        return true;
+    }
+    if (connection->le_past_advertising_handle != 0xff){
+        uint8_t advertising_handle = connection->le_past_advertising_handle;
+        connection->le_past_advertising_handle = 0xff;
+        hci_send_cmd(&hci_le_periodic_advertising_set_info_transfer, connection->con_handle, connection->le_past_service_data, advertising_handle);
+        return true;
+    }
+#endif
+#endif
+    return false;
+}
+
+static bool hci_run_general_pending_commands(void){
+    btstack_linked_item_t * it;
+    for (it = (btstack_linked_item_t *) hci_stack->connections; it != NULL; it = it->next){
+        hci_connection_t * connection = (hci_connection_t *) it;
+        if ((hci_stack->run_all_connections == false) && (connection->run_pending == false)) continue;
+        hci_stack->run_stats.num_connections_visited++;
+        if (hci_run_connection(connection)){
             return true;
         }
+        // nothing to do until a new event or an explicit request
+        connection->run_pending = false;
+    }
+    hci_stack->run_all_connections = false;
+    return false;
+}
+
+// run single pending task in priority order, drop tasks that have nothing to do
+static bool hci_run_tasks(void){
+    bool done;
+
+#ifdef ENABLE_CLASSIC
+    // general gap classic
+    if ((hci_stack->run_tasks & HCI_RUN_TASK_GAP_CLASSIC) != 0){
+        hci_stack->run_stats.num_tasks_visited++;
+        done = hci_run_general_gap_classic();
+        if (done) return true;
+        hci_stack->run_tasks &= ~HCI_RUN_TASK_GAP_CLASSIC;
+    }
+#endif
+
+#ifdef ENABLE_BLE
+    // general gap le
+    if ((hci_stack->run_tasks & HCI_RUN_TASK_GAP_LE) != 0){
+        hci_stack->run_stats.num_tasks_visited++;
+        done = hci_run_general_gap_le();
+        if (done) return true;
+        hci_stack->run_tasks &= ~HCI_RUN_TASK_GAP_LE;
+    }
+
+#ifdef ENABLE_LE_ISOCHRONOUS_STREAMS
+    // ISO related tasks, e.g. BIG create/terminate/sync
+    if ((hci_stack->run_tasks & HCI_RUN_TASK_ISO) != 0){
+        hci_stack->run_stats.num_tasks_visited++;
+        done = hci_run_iso_tasks();
+        if (done) return true;
+        hci_stack->run_tasks &= ~HCI_RUN_TASK_ISO;
+    }
 #endif
 #endif
+
+    // send pending HCI commands
+    if ((hci_stack->run_tasks & HCI_RUN_TASK_CONNECTIONS) != 0){
+        hci_stack->run_stats.num_tasks_visited++;
+        done = hci_run_general_pending_commands();
+        if (done) return true;
     }
+
+    hci_stack->run_tasks = 0;
     return false;
 }
 
-static void hci_run(void){
+// continue with tasks and connections that reported work in the last pass
+static void hci_run_pending(void){
+
+    hci_stack->run_stats.num_runs++;
 
     // stack state sub statemachines
     switch (hci_stack->state) {
@@ -7445,31 +7620,31 @@ static void hci_run(void){
     }
 #endif
 
-    if (!hci_can_send_command_packet_now()) return;
-
-    // global/non-connection oriented commands
-
-
-#ifdef ENABLE_CLASSIC
-    // general gap classic
-    done = hci_run_general_gap_classic();
-    if (done) return;
-#endif
+    // global/non-connection oriented commands and pending HCI commands, as long as the controller accepts them
+    uint8_t num_commands;
+    for (num_commands = 0; num_commands < HCI_MAX_NUM_CMD_PACKETS; num_commands++){
+        if (hci_stack->run_tasks == 0) break;
+        if (!hci_can_send_command_packet_now()) break;
+        done = hci_run_tasks();
+        if (!done) break;
+        hci_stack->run_stats.num_commands_sent++;
+    }
+}
 
-#ifdef ENABLE_BLE
-    // general gap le
-    done = hci_run_general_gap_le();
-    if (done) return;
+static void hci_run(void){
+    // state has been changed by API call or event, check all tasks and connections
+    hci_stack->run_tasks = HCI_RUN_TASK_ALL;
+    hci_stack->run_all_connections = true;
+    hci_run_pending();
+}
 
-#ifdef ENABLE_LE_ISOCHRONOUS_STREAMS
-    // ISO related tasks, e.g. BIG create/terminate/sync
-    done = hci_run_iso_tasks();
-    if (done) return;
-#endif
-#endif
+void hci_request_connection_run(hci_connection_t * connection){
+    connection->run_pending = true;
+    hci_stack->run_tasks |= HCI_RUN_TASK_CONNECTIONS;
+}
 
-    // send pending HCI commands
-    hci_run_general_pending_commands();
+void hci_get_run_stats(hci_run_stats_t * stats){
+    *stats = hci_stack->run_stats;
 }
 
 #ifdef ENABLE_CLASSIC
@@ -7746,19 +7921,23 @@ bool gap_secure_connections_active(void){
 #endif
 
 // va_list part of hci_send_cmd
-uint8_t hci_send_cmd_va_arg(const hci_cmd_t * cmd, va_list argptr){
-    if (!hci_can_send_command_packet_now()){ 
+// reserve packet buffer for HCI Command, returns NULL if command cannot be sent now
+static uint8_t * hci_reserve_cmd_packet_buffer(void){
+    if (!hci_can_send_command_packet_now()){
         log_error("hci_send_cmd called but cannot send packet now");
-        return ERROR_CODE_COMMAND_DISALLOWED;
+        return NULL;
     }
+    hci_reserve_packet_buffer();
+    return hci_stack->hci_packet_buffer;
+}
+
+// send HCI Command created in reserved packet buffer, e.g. by hci_cmd_create_* from hci_cmd_serializer.h
+static uint8_t hci_send_reserved_cmd_packet_buffer(uint16_t size){
+    uint8_t * packet = hci_stack->hci_packet_buffer;
 
     // for HCI INITIALIZATION
-    // log_info("hci_send_cmd: opcode %04x", cmd->opcode);
-    hci_stack->last_cmd_opcode = cmd->opcode;
+    hci_stack->last_cmd_opcode = little_endian_read_16(packet, 0);
 
-    hci_reserve_packet_buffer();
-    uint8_t * packet = hci_stack->hci_packet_buffer;
-    uint16_t size = hci_cmd_create_from_template(packet, cmd, argptr);
     uint8_t status = hci_send_cmd_packet(packet, size);
 
     // release packet buffer on error or for synchronous transport implementations
@@ -7770,6 +7949,15 @@ uint8_t hci_send_cmd_va_arg(const hci_cmd_t * cmd, va_list argptr){
     return status;
 }
 
+uint8_t hci_send_cmd_va_arg(const hci_cmd_t * cmd, va_list argptr){
+    uint8_t * packet = hci_reserve_cmd_packet_buffer();
+    if (packet == NULL){
+        return ERROR_CODE_COMMAND_DISALLOWED;
+    }
+    uint16_t size = hci_cmd_create_from_template(packet, cmd, argptr);
+    return hci_send_reserved_cmd_packet_buffer(size);
+}
+
 /**
  * pre: numcmds >= 0 - it's allowed to send a command to the controller
  */
@@ -8317,6 +8505,10 @@ void gap_set_scan_duplicate_filter(bool enabled){
     hci_stack->le_scan_filter_duplicates = enabled ? 1 : 0;
 }
 
+void gap_register_advertising_report_filter(bool (*filter_callback)(const uint8_t * event, uint16_t size)){
+    hci_stack->le_advertising_report_filter = filter_callback;
+}
+
 void gap_set_scan_phys(uint8_t phys){
     // LE Coded and LE 1M PHY
     hci_stack->le_scan_phys = phys & 0x05;
@@ -8592,6 +8784,10 @@ static le_advertising_set_t * hci_advertising_set_for_handle(uint8_t advertising
     return NULL;
 }
 
+bool gap_extended_advertising_supported(void){
+    return hci_extended_advertising_supported();
+}
+
 uint8_t gap_extended_advertising_set_resolvable_private_address_update(uint16_t update_s){
     hci_stack->le_resolvable_private_address_update_s = update_s;
     hci_run();
@@ -9901,10 +10097,18 @@ static hci_iso_stream_t * hci_iso_stream_for_con_handle(hci_con_handle_t con_han
     return NULL;
 }
 
+static void hci_iso_stream_free(hci_iso_stream_t * iso_stream){
+    // release SDU buffer
+    if (iso_stream->tx_sdu != NULL){
+        iso_stream->tx_sdu->in_use = false;
+    }
+    btstack_memory_hci_iso_stream_free(iso_stream);
+}
+
 static void hci_iso_stream_finalize(hci_iso_stream_t * iso_stream){
     log_info("hci_iso_stream_finalize con_handle 0x%04x, group_id 0x%02x", iso_stream->cis_handle, iso_stream->group_id);
     btstack_linked_list_remove(&hci_stack->iso_streams, (btstack_linked_item_t*) iso_stream);
-    btstack_memory_hci_iso_stream_free(iso_stream);
+    hci_iso_stream_free(iso_stream);
 }
 
 static void hci_iso_stream_finalize_by_type_and_group_id(hci_iso_type_t iso_type, uint8_t group_id) {
@@ -9915,7 +10119,7 @@ static void hci_iso_stream_finalize_by_type_and_group_id(hci_iso_type_t iso_type
         if ((iso_stream->group_id == group_id) &&
             (iso_stream->iso_type == iso_type)){
             btstack_linked_list_iterator_remove(&it);
-            btstack_memory_hci_iso_stream_free(iso_stream);
+            hci_iso_stream_free(iso_stream);
         }
     }
 }
@@ -9928,7 +10132,7 @@ static void hci_iso_stream_requested_finalize(uint8_t group_id) {
         if ((iso_stream->state == HCI_ISO_STREAM_STATE_REQUESTED ) &&
             (iso_stream->group_id == group_id)){
             btstack_linked_list_iterator_remove(&it);
-            btstack_memory_hci_iso_stream_free(iso_stream);
+            hci_iso_stream_free(iso_stream);
         }
     }
 }
@@ -10185,6 +10389,9 @@ static le_audio_cig_t * hci_cig_for_id(uint8_t cig_id){
 
 static void hci_iso_notify_can_send_now(void){
 
+    // queued SDUs first
+    hci_iso_send_queued_sdus();
+
     // BIG
 
     btstack_linked_list_iterator_t it;
@@ -10423,6 +10630,149 @@ uint8_t hci_request_cis_can_send_now_events(hci_con_handle_t cis_con_handle){
     return ERROR_CODE_SUCCESS;
 }
 
+static void hci_iso_send_queued_sdus(void){
+    // sending on synchronous transport doesn't call hci_iso_notify_can_send_now, avoid re-entrance anyway
+    if (hci_stack->iso_tx_sdus_active) return;
+    hci_stack->iso_tx_sdus_active = true;
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_stack->iso_streams);
+    while (btstack_linked_list_iterator_has_next(&it)) {
+        hci_iso_stream_t *iso_stream = (hci_iso_stream_t *) btstack_linked_list_iterator_next(&it);
+        if ((iso_stream->tx_sdu == NULL) || (iso_stream->tx_sdu->size == 0)) continue;
+        if (iso_stream->num_packets_sent >= hci_stack->iso_packets_to_queue) continue;
+        if (hci_stack->hci_packet_buffer_reserved) break;
+        if (!hci_transport_can_send_prepared_packet_now(HCI_ISO_DATA_PACKET)) break;
+        hci_reserve_packet_buffer();
+        uint16_t size = iso_stream->tx_sdu->size;
+        (void) memcpy(hci_stack->hci_packet_buffer, iso_stream->tx_sdu->buffer, size);
+        iso_stream->tx_sdu->size = 0;
+        iso_stream->tx_stats.num_sdus_sent++;
+        hci_send_iso_packet_buffer(size);
+    }
+    hci_stack->iso_tx_sdus_active = false;
+}
+
+static hci_iso_tx_sdu_buffer_t * hci_iso_tx_sdu_buffer_get(void){
+#if HCI_ISO_NUM_TX_SDU_BUFFERS > 0
+    uint8_t i;
+    for (i=0;i<HCI_ISO_NUM_TX_SDU_BUFFERS;i++){
+        hci_iso_tx_sdu_buffer_t * tx_sdu = &hci_stack->iso_tx_sdu_buffers[i];
+        if (tx_sdu->in_use == false){
+            tx_sdu->in_use = true;
+            tx_sdu->size = 0;
+            return tx_sdu;
+        }
+    }
+#endif
+    return NULL;
+}
+
+uint8_t hci_iso_send_sdus(uint16_t packet_sequence_number, bool time_stamp_valid, uint32_t time_stamp_us, uint8_t num_sdus, const hci_iso_sdu_t * sdus){
+    if (num_sdus == 0){
+        return ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS;
+    }
+    // validate all SDUs first
+    hci_iso_stream_t * first_stream = NULL;
+    uint8_t i;
+    for (i=0;i<num_sdus;i++){
+        hci_iso_stream_t * iso_stream = hci_iso_stream_for_con_handle(sdus[i].con_handle);
+        if (iso_stream == NULL){
+            return ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER;
+        }
+        if (iso_stream->state != HCI_ISO_STREAM_STATE_ESTABLISHED){
+            return ERROR_CODE_COMMAND_DISALLOWED;
+        }
+        if (first_stream == NULL){
+            first_stream = iso_stream;
+        } else if ((iso_stream->iso_type != first_stream->iso_type) || (iso_stream->group_id != first_stream->group_id)){
+            return ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS;
+        }
+        if (sdus[i].len > HCI_ISO_PAYLOAD_SIZE){
+            return ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS;
+        }
+    }
+
+    // reject all SDUs if previous SDU of a stream has not been sent yet
+    bool busy = false;
+    for (i=0;i<num_sdus;i++){
+        hci_iso_stream_t * iso_stream = hci_iso_stream_for_con_handle(sdus[i].con_handle);
+        if ((iso_stream->tx_sdu != NULL) && (iso_stream->tx_sdu->size > 0)){
+            iso_stream->tx_stats.num_late++;
+            busy = true;
+        }
+    }
+    if (busy){
+        return ERROR_CODE_CONTROLLER_BUSY;
+    }
+
+    // assign SDU buffers on first use
+    for (i=0;i<num_sdus;i++){
+        hci_iso_stream_t * iso_stream = hci_iso_stream_for_con_handle(sdus[i].con_handle);
+        if (iso_stream->tx_sdu == NULL){
+            iso_stream->tx_sdu = hci_iso_tx_sdu_buffer_get();
+            if (iso_stream->tx_sdu == NULL){
+                log_error("hci_iso_send_sdus: no SDU buffer for con handle 0x%04x, see HCI_ISO_NUM_TX_SDU_BUFFERS", iso_stream->cis_handle);
+                return ERROR_CODE_MEMORY_CAPACITY_EXCEEDED;
+            }
+        }
+    }
+
+    // count underruns for streams of this group without SDU
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_stack->iso_streams);
+    while (btstack_linked_list_iterator_has_next(&it)) {
+        hci_iso_stream_t *iso_stream = (hci_iso_stream_t *) btstack_linked_list_iterator_next(&it);
+        if (iso_stream->iso_type != first_stream->iso_type) continue;
+        if (iso_stream->group_id != first_stream->group_id) continue;
+        if (iso_stream->state != HCI_ISO_STREAM_STATE_ESTABLISHED) continue;
+        bool has_sdu = false;
+        for (i=0;i<num_sdus;i++){
+            if (sdus[i].con_handle == iso_stream->cis_handle){
+                has_sdu = true;
+                break;
+            }
+        }
+        if (has_sdu == false){
+            iso_stream->tx_stats.num_underruns++;
+        }
+    }
+
+    // store ISO Data packets
+    for (i=0;i<num_sdus;i++){
+        hci_iso_stream_t * iso_stream = hci_iso_stream_for_con_handle(sdus[i].con_handle);
+        uint8_t * buffer = iso_stream->tx_sdu->buffer;
+        uint16_t pos = 4;
+        uint16_t handle_and_flags = ((uint16_t) sdus[i].con_handle) | (2 << 12);
+        if (time_stamp_valid){
+            handle_and_flags |= 1 << 14;
+            little_endian_store_32(buffer, pos, time_stamp_us);
+            pos += 4;
+        }
+        little_endian_store_16(buffer, 0, handle_and_flags);
+        little_endian_store_16(buffer, pos, packet_sequence_number);
+        pos += 2;
+        little_endian_store_16(buffer, pos, sdus[i].len);
+        pos += 2;
+        (void) memcpy(&buffer[pos], sdus[i].data, sdus[i].len);
+        pos += sdus[i].len;
+        little_endian_store_16(buffer, 2, pos - 4);
+        iso_stream->tx_sdu->size = pos;
+        iso_stream->tx_stats.num_sdus_queued++;
+    }
+
+    hci_iso_send_queued_sdus();
+    return ERROR_CODE_SUCCESS;
+}
+
+uint8_t hci_iso_get_tx_stats(hci_con_handle_t con_handle, hci_iso_tx_stats_t * stats){
+    hci_iso_stream_t * iso_stream = hci_iso_stream_for_con_handle(con_handle);
+    if (iso_stream == NULL){
+        return ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER;
+    }
+    *stats = iso_stream->tx_stats;
+    return ERROR_CODE_SUCCESS;
+}
+
 uint8_t gap_cig_create(le_audio_cig_t * storage, le_audio_cig_params_t * cig_params){
     if (hci_cig_for_id(cig_params->cig_id) != NULL){
         return ERROR_CODE_ACL_CONNECTION_ALREADY_EXISTS;
@@ -90,6 +90,11 @@ extern "C" {
 #define HCI_ISO_PAYLOAD_SIZE 310
 #endif
 
+// number of SDU buffers for hci_iso_send_sdus, assigned to a BIS/CIS on first use
+#ifndef HCI_ISO_NUM_TX_SDU_BUFFERS
+#define HCI_ISO_NUM_TX_SDU_BUFFERS 0
+#endif
+
 // Max HCI Command LE payload size:
 // 64 from LE Generate DHKey command
 // 32 from LE Encrypt command
@@ -167,6 +172,11 @@ extern "C" {
 #endif
 #endif
 
+// max number of HCI Commands in flight, Num_HCI_Command_Packets from Command Complete/Status is limited to this
+#ifndef HCI_MAX_NUM_CMD_PACKETS
+#define HCI_MAX_NUM_CMD_PACKETS 1
+#endif
+
 // 
 #define IS_COMMAND(packet, command) ( little_endian_read_16(packet,0) == command.opcode )
 
@@ -486,6 +496,13 @@ typedef enum {
     ATT_SERVER_RESPONSE_PENDING,
 } att_server_state_t;
 
+#ifdef ENABLE_ATT_SERVER_NOTIFICATION_AGGREGATION
+// size of buffer for aggregated notifications per connection
+#ifndef ATT_SERVER_NOTIFICATION_AGGREGATION_BUFFER_SIZE
+#define ATT_SERVER_NOTIFICATION_AGGREGATION_BUFFER_SIZE 128
+#endif
+#endif
+
 typedef struct {
     att_server_state_t      state;
 
@@ -504,6 +521,16 @@ typedef struct {
     btstack_linked_list_t   notification_requests;
     btstack_linked_list_t   indication_requests;
 
+#ifdef ENABLE_ATT_SERVER_NOTIFICATION_AGGREGATION
+    // queued notifications stored as Handle Length Value Tuple List
+    btstack_context_callback_registration_t notification_aggregation_request;
+    bool                    notification_aggregation_multiple_supported;
+    bool                    notification_aggregation_scheduled;
+    uint16_t                notification_aggregation_size;
+    uint8_t                 notification_aggregation_buffer[ATT_SERVER_NOTIFICATION_AGGREGATION_BUFFER_SIZE];
+    att_server_notification_stats_t notification_aggregation_stats;
+#endif
+
 #if defined(ENABLE_GATT_OVER_CLASSIC) || defined(ENABLE_GATT_OVER_EATT)
     // unified (client + server) att bearer
     uint16_t                l2cap_cid;
@@ -630,6 +657,9 @@ typedef struct {
     // gap connection tasks, see GAP_CONNECTION_TASK_x
     uint16_t gap_connection_tasks;
 
+    // connection might have pending HCI Commands, see hci_request_connection_run
+    bool run_pending;
+
     btstack_timer_source_t timeout;
 
     // timeout in system ticks (HAVE_EMBEDDED_TICK) or milliseconds (HAVE_EMBEDDED_TIME_MS)
@@ -697,8 +727,40 @@ typedef struct {
 
 } hci_connection_t;
 
+/**
+ * Transmit statistics for SDUs queued via hci_iso_send_sdus
+ */
+typedef struct {
+    // number of SDUs queued via hci_iso_send_sdus
+    uint32_t num_sdus_queued;
+    // number of queued SDUs sent to Controller
+    uint32_t num_sdus_sent;
+    // SDU interval without SDU for this stream, while other streams of its group got one
+    uint32_t num_underruns;
+    // SDU rejected as previous SDU has not been sent to the Controller yet
+    uint32_t num_late;
+} hci_iso_tx_stats_t;
+
+/**
+ * SDU for a single BIS/CIS used with hci_iso_send_sdus
+ */
+typedef struct {
+    hci_con_handle_t con_handle;
+    const uint8_t *  data;
+    uint16_t         len;
+} hci_iso_sdu_t;
+
 #ifdef ENABLE_LE_ISOCHRONOUS_STREAMS
 
+/**
+ * Outgoing SDU queued via hci_iso_send_sdus, includes ISO packet header with timestamp
+ */
+typedef struct {
+    bool     in_use;
+    // 0 = no SDU queued
+    uint16_t size;
+    uint8_t  buffer[12 + HCI_ISO_PAYLOAD_SIZE];
+} hci_iso_tx_sdu_buffer_t;
 
 typedef enum {
     HCI_ISO_TYPE_INVALID = 0,
@@ -723,6 +785,7 @@ typedef enum{
     HCI_ISO_STREAM_STATE_W4_ISO_SETUP_OUTPUT,
 } hci_iso_stream_state_t;
 
+
 typedef struct {
     // linked list - assert: first field
     btstack_linked_item_t    item;
@@ -769,6 +832,12 @@ typedef struct {
     // ready to send
     bool emit_ready_to_send;
 
+    // SDU buffer for hci_iso_send_sdus, only assigned to streams used for sending
+    hci_iso_tx_sdu_buffer_t * tx_sdu;
+
+    // transmit statistics
+    hci_iso_tx_stats_t tx_stats;
+
 } hci_iso_stream_t;
 #endif
 
@@ -985,6 +1054,20 @@ typedef enum {
     LE_RESOLVING_LIST_DONE
 } le_resolving_list_state_t;
 
+/**
+ * HCI Run statistics
+ */
+typedef struct {
+    // calls to hci_run
+    uint32_t num_runs;
+    // sub-state machines (GAP Classic, GAP LE, ISO, connections) visited
+    uint32_t num_tasks_visited;
+    // connections visited
+    uint32_t num_connections_visited;
+    // commands sent by sub-state machines
+    uint32_t num_commands_sent;
+} hci_run_stats_t;
+
 /**
  * main data structure
  */
@@ -1037,6 +1120,11 @@ typedef struct {
     bool      iso_fragmentation_tx_active;
 
     uint8_t   iso_packets_to_queue;
+    // sending SDUs queued via hci_iso_send_sdus
+    bool      iso_tx_sdus_active;
+#if HCI_ISO_NUM_TX_SDU_BUFFERS > 0
+    hci_iso_tx_sdu_buffer_t iso_tx_sdu_buffers[HCI_ISO_NUM_TX_SDU_BUFFERS];
+#endif
     // group id and type of active operation
     hci_iso_type_t iso_active_operation_type;
     uint8_t iso_active_operation_group_id;
@@ -1229,6 +1317,9 @@ typedef struct {
     uint16_t le_scan_interval;
     uint16_t le_scan_window;
 
+    // host-side advertising report filter
+    bool (*le_advertising_report_filter)(const uint8_t * event, uint16_t size);
+
     uint8_t  le_connection_own_addr_type;
     uint8_t  le_connection_phys;
     bd_addr_t le_connection_own_address;
@@ -1329,6 +1420,11 @@ typedef struct {
 #ifdef HAVE_SCO_TRANSPORT
 	const btstack_sco_transport_t * sco_transport;
 #endif
+
+    // pending work for hci_run, see HCI_RUN_TASK_x
+    uint8_t         run_tasks;
+    bool            run_all_connections;
+    hci_run_stats_t run_stats;
 } hci_stack_t;
 
 
@@ -1463,6 +1559,12 @@ bool hci_can_send_command_packet_now(void);
 uint8_t hci_send_cmd(const hci_cmd_t * cmd, ...);
 
 
+/**
+ * @brief Get statistics for HCI Command scheduling
+ * @param stats
+ */
+void hci_get_run_stats(hci_run_stats_t * stats);
+
 // Sending SCO Packets
 
 /** @brief Get SCO payload length for existing SCO connection and current SCO Voice setting
@@ -1524,6 +1626,29 @@ uint8_t hci_request_cis_can_send_now_events(hci_con_handle_t cis_con_handle);
  */
 uint8_t hci_send_iso_packet_buffer(uint16_t size);
 
+/**
+ * @brief Queue SDUs for all BIS/CIS of a group for the current SDU interval.
+ * @note SDUs are copied and sent back-to-back to the Controller as soon as possible without HCI_EVENT_BIS_CAN_SEND_NOW
+ *       or HCI_EVENT_CIS_CAN_SEND_NOW. Each stream gets one of HCI_ISO_NUM_TX_SDU_BUFFERS SDU buffers on first use.
+ *       If the previous SDU of a stream has not been sent yet, no SDU is queued and ERROR_CODE_CONTROLLER_BUSY is returned.
+ *       Streams of the same group without an SDU in this call are counted as underrun.
+ * @param packet_sequence_number used for all SDUs
+ * @param time_stamp_valid if set, time_stamp_us is included in the ISO Data packets
+ * @param time_stamp_us
+ * @param num_sdus
+ * @param sdus array of SDUs, all streams need to belong to the same BIG/CIG
+ * @return status ERROR_CODE_CONTROLLER_BUSY if previous SDU not sent yet, ERROR_CODE_MEMORY_CAPACITY_EXCEEDED if no SDU buffer available
+ */
+uint8_t hci_iso_send_sdus(uint16_t packet_sequence_number, bool time_stamp_valid, uint32_t time_stamp_us, uint8_t num_sdus, const hci_iso_sdu_t * sdus);
+
+/**
+ * @brief Get transmit statistics for SDUs queued via hci_iso_send_sdus
+ * @param con_handle of BIS/CIS
+ * @param stats
+ * @return status
+ */
+uint8_t hci_iso_get_tx_stats(hci_con_handle_t con_handle, hci_iso_tx_stats_t * stats);
+
 /**
  * Reserves outgoing packet buffer.
  * @return true on success
@@ -1582,6 +1707,11 @@ uint8_t hci_send_cmd_va_arg(const hci_cmd_t * cmd, va_list argptr);
  */
 void hci_connections_get_iterator(btstack_linked_list_iterator_t *it);
 
+/**
+ * Mark connection for next run of HCI after modifying its state outside of HCI. Used by L2CAP
+ */
+void hci_request_connection_run(hci_connection_t * connection);
+
 /**
  * Get internal hci_connection_t for given handle. Used by L2CAP, SM, daemon
  */
@@ -1603,8 +1603,8 @@ const hci_cmd_t hci_le_read_local_p256_public_key = {
 };
 
 /**
- * @param public key
- * @param private key
+ * @param remote_p256_public_key_x
+ * @param remote_p256_public_key_y
  */
 const hci_cmd_t hci_le_generate_dhkey = {
     HCI_OPCODE_HCI_LE_GENERATE_DHKEY, "QQ"
@@ -2035,7 +2035,7 @@ const hci_cmd_t hci_le_set_connectionless_cte_transmit_enable = {
  */
 
 const hci_cmd_t hci_le_set_connectionless_iq_sampling_enable = {
-    HCI_OPCODE_HCI_LE_SET_CONNECTIONLESS_IQ_SAMPLING_ENABLE, "2111a[i]"
+    HCI_OPCODE_HCI_LE_SET_CONNECTIONLESS_IQ_SAMPLING_ENABLE, "2111a[1]"
 };
 
 /**
@@ -2134,8 +2134,8 @@ const hci_cmd_t hci_le_set_default_periodic_advertising_sync_transfer_parameters
 };
 
 /**
- * @param 256Remote_P-256_public_key_x
- * @param 256Remote_P-256_public_key_y
+ * @param remote_p256_public_key_x
+ * @param remote_p256_public_key_y
  * @param key_type
  */
 const hci_cmd_t hci_le_generate_dhkey_v2 = {
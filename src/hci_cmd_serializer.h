@@ -0,0 +1,4859 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at 
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+
+/**
+ * HCI Command Serializer
+ *
+ * Fixed-layout serializers for all HCI Commands in hci_cmd.c. In contrast to hci_cmd_create_from_template,
+ * the parameters are type-checked by the compiler and no format string is interpreted at runtime.
+ *
+ * Note: Don't edit this file. It is generated by tool/btstack_hci_cmd_generator.py
+ *
+ */
+
+#ifndef HCI_CMD_SERIALIZER_H
+#define HCI_CMD_SERIALIZER_H
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+#include "bluetooth.h"
+#include "btstack_util.h"
+#include "hci_cmd.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/* API_START */
+
+/**
+ * @brief Create HCI_INQUIRY command
+ * @param hci_cmd_buffer
+ * @param lap
+ * @param inquiry_length
+ * @param num_responses
+ * @return size of command
+ * @note: format 311
+ */
+static inline uint16_t hci_cmd_create_inquiry(uint8_t * hci_cmd_buffer, uint32_t lap, uint8_t inquiry_length, uint8_t num_responses){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_INQUIRY);
+    little_endian_store_24(hci_cmd_buffer, 3, lap);
+    hci_cmd_buffer[6] = inquiry_length;
+    hci_cmd_buffer[7] = num_responses;
+    hci_cmd_buffer[2] = 5;
+    return 8;
+}
+
+/**
+ * @brief Create HCI_INQUIRY_CANCEL command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_inquiry_cancel(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_INQUIRY_CANCEL);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_PERIODIC_INQUIRY_MODE command
+ * @param hci_cmd_buffer
+ * @param max_period_length
+ * @param min_period_length
+ * @param lap
+ * @param inquiry_length
+ * @param num_responses
+ * @return size of command
+ * @note: format 22311
+ */
+static inline uint16_t hci_cmd_create_periodic_inquiry_mode(uint8_t * hci_cmd_buffer, uint16_t max_period_length, uint16_t min_period_length, uint32_t lap, uint8_t inquiry_length, uint8_t num_responses){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_PERIODIC_INQUIRY_MODE);
+    little_endian_store_16(hci_cmd_buffer, 3, max_period_length);
+    little_endian_store_16(hci_cmd_buffer, 5, min_period_length);
+    little_endian_store_24(hci_cmd_buffer, 7, lap);
+    hci_cmd_buffer[10] = inquiry_length;
+    hci_cmd_buffer[11] = num_responses;
+    hci_cmd_buffer[2] = 9;
+    return 12;
+}
+
+/**
+ * @brief Create HCI_EXIT_PERIODIC_INQUIRY_MODE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_exit_periodic_inquiry_mode(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_EXIT_PERIODIC_INQUIRY_MODE);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_CREATE_CONNECTION command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param packet_type
+ * @param page_scan_repetition_mode
+ * @param reserved
+ * @param clock_offset
+ * @param allow_role_switch
+ * @return size of command
+ * @note: format B21121
+ */
+static inline uint16_t hci_cmd_create_create_connection(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint16_t packet_type, uint8_t page_scan_repetition_mode, uint8_t reserved, uint16_t clock_offset, uint8_t allow_role_switch){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_CREATE_CONNECTION);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    little_endian_store_16(hci_cmd_buffer, 9, packet_type);
+    hci_cmd_buffer[11] = page_scan_repetition_mode;
+    hci_cmd_buffer[12] = reserved;
+    little_endian_store_16(hci_cmd_buffer, 13, clock_offset);
+    hci_cmd_buffer[15] = allow_role_switch;
+    hci_cmd_buffer[2] = 13;
+    return 16;
+}
+
+/**
+ * @brief Create HCI_DISCONNECT command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param reason
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_disconnect(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint8_t reason){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_DISCONNECT);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[5] = reason;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_CREATE_CONNECTION_CANCEL command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @return size of command
+ * @note: format B
+ */
+static inline uint16_t hci_cmd_create_create_connection_cancel(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_CREATE_CONNECTION_CANCEL);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_ACCEPT_CONNECTION_REQUEST command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param role
+ * @return size of command
+ * @note: format B1
+ */
+static inline uint16_t hci_cmd_create_accept_connection_request(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint8_t role){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_ACCEPT_CONNECTION_REQUEST);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[9] = role;
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_REJECT_CONNECTION_REQUEST command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param reason
+ * @return size of command
+ * @note: format B1
+ */
+static inline uint16_t hci_cmd_create_reject_connection_request(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint8_t reason){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_REJECT_CONNECTION_REQUEST);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[9] = reason;
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_LINK_KEY_REQUEST_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param link_key
+ * @return size of command
+ * @note: format BP
+ */
+static inline uint16_t hci_cmd_create_link_key_request_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, const uint8_t * link_key){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LINK_KEY_REQUEST_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    (void)memcpy(&hci_cmd_buffer[9], link_key, 16);
+    hci_cmd_buffer[2] = 22;
+    return 25;
+}
+
+/**
+ * @brief Create HCI_LINK_KEY_REQUEST_NEGATIVE_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @return size of command
+ * @note: format B
+ */
+static inline uint16_t hci_cmd_create_link_key_request_negative_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LINK_KEY_REQUEST_NEGATIVE_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_PIN_CODE_REQUEST_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param pin_length
+ * @param pin
+ * @return size of command
+ * @note: format B1P
+ */
+static inline uint16_t hci_cmd_create_pin_code_request_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint8_t pin_length, const uint8_t * pin){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_PIN_CODE_REQUEST_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[9] = pin_length;
+    (void)memcpy(&hci_cmd_buffer[10], pin, 16);
+    hci_cmd_buffer[2] = 23;
+    return 26;
+}
+
+/**
+ * @brief Create HCI_PIN_CODE_REQUEST_NEGATIVE_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @return size of command
+ * @note: format B
+ */
+static inline uint16_t hci_cmd_create_pin_code_request_negative_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_PIN_CODE_REQUEST_NEGATIVE_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_CHANGE_CONNECTION_PACKET_TYPE command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param packet_type
+ * @return size of command
+ * @note: format H2
+ */
+static inline uint16_t hci_cmd_create_change_connection_packet_type(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint16_t packet_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_CHANGE_CONNECTION_PACKET_TYPE);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_16(hci_cmd_buffer, 5, packet_type);
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_AUTHENTICATION_REQUESTED command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_authentication_requested(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_AUTHENTICATION_REQUESTED);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_SET_CONNECTION_ENCRYPTION command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param encryption_enable
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_set_connection_encryption(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint8_t encryption_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SET_CONNECTION_ENCRYPTION);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[5] = encryption_enable;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_CHANGE_CONNECTION_LINK_KEY command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_change_connection_link_key(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_CHANGE_CONNECTION_LINK_KEY);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_REMOTE_NAME_REQUEST command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param page_scan_repetition_mode
+ * @param reserved
+ * @param clock_offset
+ * @return size of command
+ * @note: format B112
+ */
+static inline uint16_t hci_cmd_create_remote_name_request(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint8_t page_scan_repetition_mode, uint8_t reserved, uint16_t clock_offset){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_REMOTE_NAME_REQUEST);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[9] = page_scan_repetition_mode;
+    hci_cmd_buffer[10] = reserved;
+    little_endian_store_16(hci_cmd_buffer, 11, clock_offset);
+    hci_cmd_buffer[2] = 10;
+    return 13;
+}
+
+/**
+ * @brief Create HCI_REMOTE_NAME_REQUEST_CANCEL command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @return size of command
+ * @note: format B
+ */
+static inline uint16_t hci_cmd_create_remote_name_request_cancel(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_REMOTE_NAME_REQUEST_CANCEL);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_READ_REMOTE_SUPPORTED_FEATURES_COMMAND command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_read_remote_supported_features_command(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_REMOTE_SUPPORTED_FEATURES_COMMAND);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_READ_REMOTE_EXTENDED_FEATURES_COMMAND command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @param arg2
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_read_remote_extended_features_command(uint8_t * hci_cmd_buffer, hci_con_handle_t arg1, uint8_t arg2){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_REMOTE_EXTENDED_FEATURES_COMMAND);
+    little_endian_store_16(hci_cmd_buffer, 3, arg1);
+    hci_cmd_buffer[5] = arg2;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_READ_REMOTE_VERSION_INFORMATION command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_read_remote_version_information(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_REMOTE_VERSION_INFORMATION);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_READ_CLOCK_OFFSET command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_read_clock_offset(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_CLOCK_OFFSET);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_SETUP_SYNCHRONOUS_CONNECTION command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param transmit_bandwidth
+ * @param receive_bandwidth
+ * @param max_latency
+ * @param voice_settings
+ * @param retransmission_effort
+ * @param packet_type
+ * @return size of command
+ * @note: format H442212
+ */
+static inline uint16_t hci_cmd_create_setup_synchronous_connection(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint32_t transmit_bandwidth, uint32_t receive_bandwidth, uint16_t max_latency, uint16_t voice_settings, uint8_t retransmission_effort, uint16_t packet_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SETUP_SYNCHRONOUS_CONNECTION);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_32(hci_cmd_buffer, 5, transmit_bandwidth);
+    little_endian_store_32(hci_cmd_buffer, 9, receive_bandwidth);
+    little_endian_store_16(hci_cmd_buffer, 13, max_latency);
+    little_endian_store_16(hci_cmd_buffer, 15, voice_settings);
+    hci_cmd_buffer[17] = retransmission_effort;
+    little_endian_store_16(hci_cmd_buffer, 18, packet_type);
+    hci_cmd_buffer[2] = 17;
+    return 20;
+}
+
+/**
+ * @brief Create HCI_ACCEPT_SYNCHRONOUS_CONNECTION command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param transmit_bandwidth
+ * @param receive_bandwidth
+ * @param max_latency
+ * @param voice_settings
+ * @param retransmission_effort
+ * @param packet_type
+ * @return size of command
+ * @note: format B442212
+ */
+static inline uint16_t hci_cmd_create_accept_synchronous_connection(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint32_t transmit_bandwidth, uint32_t receive_bandwidth, uint16_t max_latency, uint16_t voice_settings, uint8_t retransmission_effort, uint16_t packet_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_ACCEPT_SYNCHRONOUS_CONNECTION);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    little_endian_store_32(hci_cmd_buffer, 9, transmit_bandwidth);
+    little_endian_store_32(hci_cmd_buffer, 13, receive_bandwidth);
+    little_endian_store_16(hci_cmd_buffer, 17, max_latency);
+    little_endian_store_16(hci_cmd_buffer, 19, voice_settings);
+    hci_cmd_buffer[21] = retransmission_effort;
+    little_endian_store_16(hci_cmd_buffer, 22, packet_type);
+    hci_cmd_buffer[2] = 21;
+    return 24;
+}
+
+/**
+ * @brief Create HCI_IO_CAPABILITY_REQUEST_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param io_capability
+ * @param oob_data_present
+ * @param authentication_requirements
+ * @return size of command
+ * @note: format B111
+ */
+static inline uint16_t hci_cmd_create_io_capability_request_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint8_t io_capability, uint8_t oob_data_present, uint8_t authentication_requirements){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_IO_CAPABILITY_REQUEST_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[9] = io_capability;
+    hci_cmd_buffer[10] = oob_data_present;
+    hci_cmd_buffer[11] = authentication_requirements;
+    hci_cmd_buffer[2] = 9;
+    return 12;
+}
+
+/**
+ * @brief Create HCI_USER_CONFIRMATION_REQUEST_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @return size of command
+ * @note: format B
+ */
+static inline uint16_t hci_cmd_create_user_confirmation_request_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_USER_CONFIRMATION_REQUEST_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_USER_CONFIRMATION_REQUEST_NEGATIVE_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @return size of command
+ * @note: format B
+ */
+static inline uint16_t hci_cmd_create_user_confirmation_request_negative_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_USER_CONFIRMATION_REQUEST_NEGATIVE_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_USER_PASSKEY_REQUEST_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param numeric_value
+ * @return size of command
+ * @note: format B4
+ */
+static inline uint16_t hci_cmd_create_user_passkey_request_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint32_t numeric_value){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_USER_PASSKEY_REQUEST_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    little_endian_store_32(hci_cmd_buffer, 9, numeric_value);
+    hci_cmd_buffer[2] = 10;
+    return 13;
+}
+
+/**
+ * @brief Create HCI_USER_PASSKEY_REQUEST_NEGATIVE_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @return size of command
+ * @note: format B
+ */
+static inline uint16_t hci_cmd_create_user_passkey_request_negative_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_USER_PASSKEY_REQUEST_NEGATIVE_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_REMOTE_OOB_DATA_REQUEST_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param c
+ * @param r
+ * @return size of command
+ * @note: format BKK
+ */
+static inline uint16_t hci_cmd_create_remote_oob_data_request_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, const uint8_t * c, const uint8_t * r){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_REMOTE_OOB_DATA_REQUEST_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    reverse_128(c, &hci_cmd_buffer[9]);
+    reverse_128(r, &hci_cmd_buffer[25]);
+    hci_cmd_buffer[2] = 38;
+    return 41;
+}
+
+/**
+ * @brief Create HCI_REMOTE_OOB_DATA_REQUEST_NEGATIVE_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @return size of command
+ * @note: format B
+ */
+static inline uint16_t hci_cmd_create_remote_oob_data_request_negative_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_REMOTE_OOB_DATA_REQUEST_NEGATIVE_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_IO_CAPABILITY_REQUEST_NEGATIVE_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param reason
+ * @return size of command
+ * @note: format B1
+ */
+static inline uint16_t hci_cmd_create_io_capability_request_negative_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint8_t reason){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_IO_CAPABILITY_REQUEST_NEGATIVE_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[9] = reason;
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_ENHANCED_SETUP_SYNCHRONOUS_CONNECTION command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param transmit_bandwidth
+ * @param receive_bandwidth
+ * @param transmit_coding_format_type
+ * @param transmit_coding_format_company
+ * @param transmit_coding_format_codec
+ * @param receive_coding_format_type
+ * @param receive_coding_format_company
+ * @param receive_coding_format_codec
+ * @param transmit_coding_frame_size
+ * @param receive_coding_frame_size
+ * @param input_bandwidth
+ * @param output_bandwidth
+ * @param input_coding_format_type
+ * @param input_coding_format_company
+ * @param input_coding_format_codec
+ * @param output_coding_format_type
+ * @param output_coding_format_company
+ * @param output_coding_format_codec
+ * @param input_coded_data_size
+ * @param outupt_coded_data_size
+ * @param input_pcm_data_format
+ * @param output_pcm_data_format
+ * @param input_pcm_sample_payload_msb_position
+ * @param output_pcm_sample_payload_msb_position
+ * @param input_data_path
+ * @param output_data_path
+ * @param input_transport_unit_size
+ * @param output_transport_unit_size
+ * @param max_latency
+ * @param packet_type
+ * @param retransmission_effort
+ * @return size of command
+ * @note: format H4412212222441221222211111111221
+ */
+static inline uint16_t hci_cmd_create_enhanced_setup_synchronous_connection(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint32_t transmit_bandwidth, uint32_t receive_bandwidth, uint8_t transmit_coding_format_type, uint16_t transmit_coding_format_company, uint16_t transmit_coding_format_codec, uint8_t receive_coding_format_type, uint16_t receive_coding_format_company, uint16_t receive_coding_format_codec, uint16_t transmit_coding_frame_size, uint16_t receive_coding_frame_size, uint32_t input_bandwidth, uint32_t output_bandwidth, uint8_t input_coding_format_type, uint16_t input_coding_format_company, uint16_t input_coding_format_codec, uint8_t output_coding_format_type, uint16_t output_coding_format_company, uint16_t output_coding_format_codec, uint16_t input_coded_data_size, uint16_t outupt_coded_data_size, uint8_t input_pcm_data_format, uint8_t output_pcm_data_format, uint8_t input_pcm_sample_payload_msb_position, uint8_t output_pcm_sample_payload_msb_position, uint8_t input_data_path, uint8_t output_data_path, uint8_t input_transport_unit_size, uint8_t output_transport_unit_size, uint16_t max_latency, uint16_t packet_type, uint8_t retransmission_effort){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_ENHANCED_SETUP_SYNCHRONOUS_CONNECTION);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_32(hci_cmd_buffer, 5, transmit_bandwidth);
+    little_endian_store_32(hci_cmd_buffer, 9, receive_bandwidth);
+    hci_cmd_buffer[13] = transmit_coding_format_type;
+    little_endian_store_16(hci_cmd_buffer, 14, transmit_coding_format_company);
+    little_endian_store_16(hci_cmd_buffer, 16, transmit_coding_format_codec);
+    hci_cmd_buffer[18] = receive_coding_format_type;
+    little_endian_store_16(hci_cmd_buffer, 19, receive_coding_format_company);
+    little_endian_store_16(hci_cmd_buffer, 21, receive_coding_format_codec);
+    little_endian_store_16(hci_cmd_buffer, 23, transmit_coding_frame_size);
+    little_endian_store_16(hci_cmd_buffer, 25, receive_coding_frame_size);
+    little_endian_store_32(hci_cmd_buffer, 27, input_bandwidth);
+    little_endian_store_32(hci_cmd_buffer, 31, output_bandwidth);
+    hci_cmd_buffer[35] = input_coding_format_type;
+    little_endian_store_16(hci_cmd_buffer, 36, input_coding_format_company);
+    little_endian_store_16(hci_cmd_buffer, 38, input_coding_format_codec);
+    hci_cmd_buffer[40] = output_coding_format_type;
+    little_endian_store_16(hci_cmd_buffer, 41, output_coding_format_company);
+    little_endian_store_16(hci_cmd_buffer, 43, output_coding_format_codec);
+    little_endian_store_16(hci_cmd_buffer, 45, input_coded_data_size);
+    little_endian_store_16(hci_cmd_buffer, 47, outupt_coded_data_size);
+    hci_cmd_buffer[49] = input_pcm_data_format;
+    hci_cmd_buffer[50] = output_pcm_data_format;
+    hci_cmd_buffer[51] = input_pcm_sample_payload_msb_position;
+    hci_cmd_buffer[52] = output_pcm_sample_payload_msb_position;
+    hci_cmd_buffer[53] = input_data_path;
+    hci_cmd_buffer[54] = output_data_path;
+    hci_cmd_buffer[55] = input_transport_unit_size;
+    hci_cmd_buffer[56] = output_transport_unit_size;
+    little_endian_store_16(hci_cmd_buffer, 57, max_latency);
+    little_endian_store_16(hci_cmd_buffer, 59, packet_type);
+    hci_cmd_buffer[61] = retransmission_effort;
+    hci_cmd_buffer[2] = 59;
+    return 62;
+}
+
+/**
+ * @brief Create HCI_ENHANCED_ACCEPT_SYNCHRONOUS_CONNECTION command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param transmit_bandwidth
+ * @param receive_bandwidth
+ * @param transmit_coding_format_type
+ * @param transmit_coding_format_company
+ * @param transmit_coding_format_codec
+ * @param receive_coding_format_type
+ * @param receive_coding_format_company
+ * @param receive_coding_format_codec
+ * @param transmit_coding_frame_size
+ * @param receive_coding_frame_size
+ * @param input_bandwidth
+ * @param output_bandwidth
+ * @param input_coding_format_type
+ * @param input_coding_format_company
+ * @param input_coding_format_codec
+ * @param output_coding_format_type
+ * @param output_coding_format_company
+ * @param output_coding_format_codec
+ * @param input_coded_data_size
+ * @param outupt_coded_data_size
+ * @param input_pcm_data_format
+ * @param output_pcm_data_format
+ * @param input_pcm_sample_payload_msb_position
+ * @param output_pcm_sample_payload_msb_position
+ * @param input_data_path
+ * @param output_data_path
+ * @param input_transport_unit_size
+ * @param output_transport_unit_size
+ * @param max_latency
+ * @param packet_type
+ * @param retransmission_effort
+ * @return size of command
+ * @note: format B4412212222441221222211111111221
+ */
+static inline uint16_t hci_cmd_create_enhanced_accept_synchronous_connection(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint32_t transmit_bandwidth, uint32_t receive_bandwidth, uint8_t transmit_coding_format_type, uint16_t transmit_coding_format_company, uint16_t transmit_coding_format_codec, uint8_t receive_coding_format_type, uint16_t receive_coding_format_company, uint16_t receive_coding_format_codec, uint16_t transmit_coding_frame_size, uint16_t receive_coding_frame_size, uint32_t input_bandwidth, uint32_t output_bandwidth, uint8_t input_coding_format_type, uint16_t input_coding_format_company, uint16_t input_coding_format_codec, uint8_t output_coding_format_type, uint16_t output_coding_format_company, uint16_t output_coding_format_codec, uint16_t input_coded_data_size, uint16_t outupt_coded_data_size, uint8_t input_pcm_data_format, uint8_t output_pcm_data_format, uint8_t input_pcm_sample_payload_msb_position, uint8_t output_pcm_sample_payload_msb_position, uint8_t input_data_path, uint8_t output_data_path, uint8_t input_transport_unit_size, uint8_t output_transport_unit_size, uint16_t max_latency, uint16_t packet_type, uint8_t retransmission_effort){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_ENHANCED_ACCEPT_SYNCHRONOUS_CONNECTION);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    little_endian_store_32(hci_cmd_buffer, 9, transmit_bandwidth);
+    little_endian_store_32(hci_cmd_buffer, 13, receive_bandwidth);
+    hci_cmd_buffer[17] = transmit_coding_format_type;
+    little_endian_store_16(hci_cmd_buffer, 18, transmit_coding_format_company);
+    little_endian_store_16(hci_cmd_buffer, 20, transmit_coding_format_codec);
+    hci_cmd_buffer[22] = receive_coding_format_type;
+    little_endian_store_16(hci_cmd_buffer, 23, receive_coding_format_company);
+    little_endian_store_16(hci_cmd_buffer, 25, receive_coding_format_codec);
+    little_endian_store_16(hci_cmd_buffer, 27, transmit_coding_frame_size);
+    little_endian_store_16(hci_cmd_buffer, 29, receive_coding_frame_size);
+    little_endian_store_32(hci_cmd_buffer, 31, input_bandwidth);
+    little_endian_store_32(hci_cmd_buffer, 35, output_bandwidth);
+    hci_cmd_buffer[39] = input_coding_format_type;
+    little_endian_store_16(hci_cmd_buffer, 40, input_coding_format_company);
+    little_endian_store_16(hci_cmd_buffer, 42, input_coding_format_codec);
+    hci_cmd_buffer[44] = output_coding_format_type;
+    little_endian_store_16(hci_cmd_buffer, 45, output_coding_format_company);
+    little_endian_store_16(hci_cmd_buffer, 47, output_coding_format_codec);
+    little_endian_store_16(hci_cmd_buffer, 49, input_coded_data_size);
+    little_endian_store_16(hci_cmd_buffer, 51, outupt_coded_data_size);
+    hci_cmd_buffer[53] = input_pcm_data_format;
+    hci_cmd_buffer[54] = output_pcm_data_format;
+    hci_cmd_buffer[55] = input_pcm_sample_payload_msb_position;
+    hci_cmd_buffer[56] = output_pcm_sample_payload_msb_position;
+    hci_cmd_buffer[57] = input_data_path;
+    hci_cmd_buffer[58] = output_data_path;
+    hci_cmd_buffer[59] = input_transport_unit_size;
+    hci_cmd_buffer[60] = output_transport_unit_size;
+    little_endian_store_16(hci_cmd_buffer, 61, max_latency);
+    little_endian_store_16(hci_cmd_buffer, 63, packet_type);
+    hci_cmd_buffer[65] = retransmission_effort;
+    hci_cmd_buffer[2] = 63;
+    return 66;
+}
+
+/**
+ * @brief Create HCI_REMOTE_OOB_EXTENDED_DATA_REQUEST_REPLY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param c_192
+ * @param r_192
+ * @param c_256
+ * @param r_256
+ * @return size of command
+ * @note: format BKKKK
+ */
+static inline uint16_t hci_cmd_create_remote_oob_extended_data_request_reply(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, const uint8_t * c_192, const uint8_t * r_192, const uint8_t * c_256, const uint8_t * r_256){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_REMOTE_OOB_EXTENDED_DATA_REQUEST_REPLY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    reverse_128(c_192, &hci_cmd_buffer[9]);
+    reverse_128(r_192, &hci_cmd_buffer[25]);
+    reverse_128(c_256, &hci_cmd_buffer[41]);
+    reverse_128(r_256, &hci_cmd_buffer[57]);
+    hci_cmd_buffer[2] = 70;
+    return 73;
+}
+
+/**
+ * @brief Create HCI_HOLD_MODE command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param hold_mode_max_interval
+ * @param hold_mode_min_interval
+ * @return size of command
+ * @note: format H22
+ */
+static inline uint16_t hci_cmd_create_hold_mode(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint16_t hold_mode_max_interval, uint16_t hold_mode_min_interval){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_HOLD_MODE);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_16(hci_cmd_buffer, 5, hold_mode_max_interval);
+    little_endian_store_16(hci_cmd_buffer, 7, hold_mode_min_interval);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_SNIFF_MODE command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param sniff_max_interval
+ * @param sniff_min_interval
+ * @param sniff_attempt
+ * @param sniff_timeout
+ * @return size of command
+ * @note: format H2222
+ */
+static inline uint16_t hci_cmd_create_sniff_mode(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint16_t sniff_max_interval, uint16_t sniff_min_interval, uint16_t sniff_attempt, uint16_t sniff_timeout){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SNIFF_MODE);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_16(hci_cmd_buffer, 5, sniff_max_interval);
+    little_endian_store_16(hci_cmd_buffer, 7, sniff_min_interval);
+    little_endian_store_16(hci_cmd_buffer, 9, sniff_attempt);
+    little_endian_store_16(hci_cmd_buffer, 11, sniff_timeout);
+    hci_cmd_buffer[2] = 10;
+    return 13;
+}
+
+/**
+ * @brief Create HCI_EXIT_SNIFF_MODE command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_exit_sniff_mode(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_EXIT_SNIFF_MODE);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_PARK_STATE command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param beacon_max_interval
+ * @param beacon_max_interval_2
+ * @return size of command
+ * @note: format H22
+ */
+static inline uint16_t hci_cmd_create_park_state(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint16_t beacon_max_interval, uint16_t beacon_max_interval_2){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_PARK_STATE);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_16(hci_cmd_buffer, 5, beacon_max_interval);
+    little_endian_store_16(hci_cmd_buffer, 7, beacon_max_interval_2);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_EXIT_PARK_STATE command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_exit_park_state(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_EXIT_PARK_STATE);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_QOS_SETUP command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param flags
+ * @param service_type
+ * @param token_rate
+ * @param peak_bandwith
+ * @param latency
+ * @param delay_variation
+ * @return size of command
+ * @note: format H114444
+ */
+static inline uint16_t hci_cmd_create_qos_setup(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint8_t flags, uint8_t service_type, uint32_t token_rate, uint32_t peak_bandwith, uint32_t latency, uint32_t delay_variation){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_QOS_SETUP);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[5] = flags;
+    hci_cmd_buffer[6] = service_type;
+    little_endian_store_32(hci_cmd_buffer, 7, token_rate);
+    little_endian_store_32(hci_cmd_buffer, 11, peak_bandwith);
+    little_endian_store_32(hci_cmd_buffer, 15, latency);
+    little_endian_store_32(hci_cmd_buffer, 19, delay_variation);
+    hci_cmd_buffer[2] = 20;
+    return 23;
+}
+
+/**
+ * @brief Create HCI_ROLE_DISCOVERY command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_role_discovery(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_ROLE_DISCOVERY);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_SWITCH_ROLE_COMMAND command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param role
+ * @return size of command
+ * @note: format B1
+ */
+static inline uint16_t hci_cmd_create_switch_role_command(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint8_t role){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SWITCH_ROLE_COMMAND);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[9] = role;
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_READ_LINK_POLICY_SETTINGS command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_read_link_policy_settings(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LINK_POLICY_SETTINGS);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_WRITE_LINK_POLICY_SETTINGS command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param settings
+ * @return size of command
+ * @note: format H2
+ */
+static inline uint16_t hci_cmd_create_write_link_policy_settings(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint16_t settings){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_LINK_POLICY_SETTINGS);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_16(hci_cmd_buffer, 5, settings);
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_SNIFF_SUBRATING command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param max_latency
+ * @param min_remote_timeout
+ * @param min_local_timeout
+ * @return size of command
+ * @note: format H222
+ */
+static inline uint16_t hci_cmd_create_sniff_subrating(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint16_t max_latency, uint16_t min_remote_timeout, uint16_t min_local_timeout){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SNIFF_SUBRATING);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_16(hci_cmd_buffer, 5, max_latency);
+    little_endian_store_16(hci_cmd_buffer, 7, min_remote_timeout);
+    little_endian_store_16(hci_cmd_buffer, 9, min_local_timeout);
+    hci_cmd_buffer[2] = 8;
+    return 11;
+}
+
+/**
+ * @brief Create HCI_WRITE_DEFAULT_LINK_POLICY_SETTING command
+ * @param hci_cmd_buffer
+ * @param policy
+ * @return size of command
+ * @note: format 2
+ */
+static inline uint16_t hci_cmd_create_write_default_link_policy_setting(uint8_t * hci_cmd_buffer, uint16_t policy){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_DEFAULT_LINK_POLICY_SETTING);
+    little_endian_store_16(hci_cmd_buffer, 3, policy);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_FLOW_SPECIFICATION command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param unused
+ * @param flow_direction
+ * @param service_type
+ * @param token_rate
+ * @param token_bucket_size
+ * @param peak_bandwidth
+ * @param access_latency
+ * @return size of command
+ * @note: format H1114444
+ */
+static inline uint16_t hci_cmd_create_flow_specification(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint8_t unused, uint8_t flow_direction, uint8_t service_type, uint32_t token_rate, uint32_t token_bucket_size, uint32_t peak_bandwidth, uint32_t access_latency){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_FLOW_SPECIFICATION);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[5] = unused;
+    hci_cmd_buffer[6] = flow_direction;
+    hci_cmd_buffer[7] = service_type;
+    little_endian_store_32(hci_cmd_buffer, 8, token_rate);
+    little_endian_store_32(hci_cmd_buffer, 12, token_bucket_size);
+    little_endian_store_32(hci_cmd_buffer, 16, peak_bandwidth);
+    little_endian_store_32(hci_cmd_buffer, 20, access_latency);
+    hci_cmd_buffer[2] = 21;
+    return 24;
+}
+
+/**
+ * @brief Create HCI_SET_EVENT_MASK command
+ * @param hci_cmd_buffer
+ * @param event_mask_lower_octets
+ * @param event_mask_higher_octets
+ * @return size of command
+ * @note: format 44
+ */
+static inline uint16_t hci_cmd_create_set_event_mask(uint8_t * hci_cmd_buffer, uint32_t event_mask_lower_octets, uint32_t event_mask_higher_octets){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SET_EVENT_MASK);
+    little_endian_store_32(hci_cmd_buffer, 3, event_mask_lower_octets);
+    little_endian_store_32(hci_cmd_buffer, 7, event_mask_higher_octets);
+    hci_cmd_buffer[2] = 8;
+    return 11;
+}
+
+/**
+ * @brief Create HCI_RESET command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_reset(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_RESET);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_FLUSH command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_flush(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_FLUSH);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_READ_PIN_TYPE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_pin_type(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_PIN_TYPE);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_PIN_TYPE command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_pin_type(uint8_t * hci_cmd_buffer, uint8_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_PIN_TYPE);
+    hci_cmd_buffer[3] = handle;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_DELETE_STORED_LINK_KEY command
+ * @param hci_cmd_buffer
+ * @param bd_addr
+ * @param delete_all_flags
+ * @return size of command
+ * @note: format B1
+ */
+static inline uint16_t hci_cmd_create_delete_stored_link_key(uint8_t * hci_cmd_buffer, const bd_addr_t bd_addr, uint8_t delete_all_flags){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_DELETE_STORED_LINK_KEY);
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[9] = delete_all_flags;
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_WRITE_LOCAL_NAME command
+ * @param hci_cmd_buffer
+ * @param local_name
+ * @return size of command
+ * @note: format N
+ */
+static inline uint16_t hci_cmd_create_write_local_name(uint8_t * hci_cmd_buffer, const char * local_name){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_LOCAL_NAME);
+    uint16_t local_name_len = (uint16_t) strlen(local_name);
+    if (local_name_len > 248u) {
+        local_name_len = 248u;
+    }
+    (void)memcpy(&hci_cmd_buffer[3], local_name, local_name_len);
+    memset(&hci_cmd_buffer[3 + local_name_len], 0, 248u - local_name_len);
+    hci_cmd_buffer[2] = 248;
+    return 251;
+}
+
+/**
+ * @brief Create HCI_READ_LOCAL_NAME command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_local_name(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LOCAL_NAME);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_READ_PAGE_TIMEOUT command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_page_timeout(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_PAGE_TIMEOUT);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_PAGE_TIMEOUT command
+ * @param hci_cmd_buffer
+ * @param page_timeout
+ * @return size of command
+ * @note: format 2
+ */
+static inline uint16_t hci_cmd_create_write_page_timeout(uint8_t * hci_cmd_buffer, uint16_t page_timeout){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_PAGE_TIMEOUT);
+    little_endian_store_16(hci_cmd_buffer, 3, page_timeout);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_WRITE_SCAN_ENABLE command
+ * @param hci_cmd_buffer
+ * @param scan_enable
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_scan_enable(uint8_t * hci_cmd_buffer, uint8_t scan_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_SCAN_ENABLE);
+    hci_cmd_buffer[3] = scan_enable;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_READ_PAGE_SCAN_ACTIVITY command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_page_scan_activity(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_PAGE_SCAN_ACTIVITY);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_PAGE_SCAN_ACTIVITY command
+ * @param hci_cmd_buffer
+ * @param page_scan_interval
+ * @param page_scan_window
+ * @return size of command
+ * @note: format 22
+ */
+static inline uint16_t hci_cmd_create_write_page_scan_activity(uint8_t * hci_cmd_buffer, uint16_t page_scan_interval, uint16_t page_scan_window){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_PAGE_SCAN_ACTIVITY);
+    little_endian_store_16(hci_cmd_buffer, 3, page_scan_interval);
+    little_endian_store_16(hci_cmd_buffer, 5, page_scan_window);
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_READ_INQUIRY_SCAN_ACTIVITY command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_inquiry_scan_activity(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_INQUIRY_SCAN_ACTIVITY);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_INQUIRY_SCAN_ACTIVITY command
+ * @param hci_cmd_buffer
+ * @param inquiry_scan_interval
+ * @param inquiry_scan_window
+ * @return size of command
+ * @note: format 22
+ */
+static inline uint16_t hci_cmd_create_write_inquiry_scan_activity(uint8_t * hci_cmd_buffer, uint16_t inquiry_scan_interval, uint16_t inquiry_scan_window){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_INQUIRY_SCAN_ACTIVITY);
+    little_endian_store_16(hci_cmd_buffer, 3, inquiry_scan_interval);
+    little_endian_store_16(hci_cmd_buffer, 5, inquiry_scan_window);
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_WRITE_AUTHENTICATION_ENABLE command
+ * @param hci_cmd_buffer
+ * @param authentication_enable
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_authentication_enable(uint8_t * hci_cmd_buffer, uint8_t authentication_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_AUTHENTICATION_ENABLE);
+    hci_cmd_buffer[3] = authentication_enable;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_WRITE_AUTOMATIC_FLUSH_TIMEOUT command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param timeout
+ * @return size of command
+ * @note: format H2
+ */
+static inline uint16_t hci_cmd_create_write_automatic_flush_timeout(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint16_t timeout){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_AUTOMATIC_FLUSH_TIMEOUT);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_16(hci_cmd_buffer, 5, timeout);
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_WRITE_CLASS_OF_DEVICE command
+ * @param hci_cmd_buffer
+ * @param class_of_device
+ * @return size of command
+ * @note: format 3
+ */
+static inline uint16_t hci_cmd_create_write_class_of_device(uint8_t * hci_cmd_buffer, uint32_t class_of_device){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_CLASS_OF_DEVICE);
+    little_endian_store_24(hci_cmd_buffer, 3, class_of_device);
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_READ_NUM_BROADCAST_RETRANSMISSIONS command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_num_broadcast_retransmissions(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_NUM_BROADCAST_RETRANSMISSIONS);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_NUM_BROADCAST_RETRANSMISSIONS command
+ * @param hci_cmd_buffer
+ * @param num_broadcast_retransmissions
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_num_broadcast_retransmissions(uint8_t * hci_cmd_buffer, uint8_t num_broadcast_retransmissions){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_NUM_BROADCAST_RETRANSMISSIONS);
+    hci_cmd_buffer[3] = num_broadcast_retransmissions;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_READ_TRANSMIT_POWER_LEVEL command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param type
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_read_transmit_power_level(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_TRANSMIT_POWER_LEVEL);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = type;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_WRITE_SYNCHRONOUS_FLOW_CONTROL_ENABLE command
+ * @param hci_cmd_buffer
+ * @param synchronous_flow_control_enable
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_synchronous_flow_control_enable(uint8_t * hci_cmd_buffer, uint8_t synchronous_flow_control_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_SYNCHRONOUS_FLOW_CONTROL_ENABLE);
+    hci_cmd_buffer[3] = synchronous_flow_control_enable;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_SET_CONTROLLER_TO_HOST_FLOW_CONTROL command
+ * @param hci_cmd_buffer
+ * @param flow_control_enable
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_set_controller_to_host_flow_control(uint8_t * hci_cmd_buffer, uint8_t flow_control_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SET_CONTROLLER_TO_HOST_FLOW_CONTROL);
+    hci_cmd_buffer[3] = flow_control_enable;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_HOST_BUFFER_SIZE command
+ * @param hci_cmd_buffer
+ * @param host_acl_data_packet_length
+ * @param host_synchronous_data_packet_length
+ * @param host_total_num_acl_data_packets
+ * @param host_total_num_synchronous_data_packets
+ * @return size of command
+ * @note: format 2122
+ */
+static inline uint16_t hci_cmd_create_host_buffer_size(uint8_t * hci_cmd_buffer, uint16_t host_acl_data_packet_length, uint8_t host_synchronous_data_packet_length, uint16_t host_total_num_acl_data_packets, uint16_t host_total_num_synchronous_data_packets){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_HOST_BUFFER_SIZE);
+    little_endian_store_16(hci_cmd_buffer, 3, host_acl_data_packet_length);
+    hci_cmd_buffer[5] = host_synchronous_data_packet_length;
+    little_endian_store_16(hci_cmd_buffer, 6, host_total_num_acl_data_packets);
+    little_endian_store_16(hci_cmd_buffer, 8, host_total_num_synchronous_data_packets);
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_READ_LINK_SUPERVISION_TIMEOUT command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_read_link_supervision_timeout(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LINK_SUPERVISION_TIMEOUT);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_WRITE_LINK_SUPERVISION_TIMEOUT command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param timeout
+ * @return size of command
+ * @note: format H2
+ */
+static inline uint16_t hci_cmd_create_write_link_supervision_timeout(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint16_t timeout){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_LINK_SUPERVISION_TIMEOUT);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    little_endian_store_16(hci_cmd_buffer, 5, timeout);
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_WRITE_CURRENT_IAC_LAP_TWO_IACS command
+ * @param hci_cmd_buffer
+ * @param num_current_iac
+ * @param iac_lap1
+ * @param iac_lap2
+ * @return size of command
+ * @note: format 133
+ */
+static inline uint16_t hci_cmd_create_write_current_iac_lap_two_iacs(uint8_t * hci_cmd_buffer, uint8_t num_current_iac, uint32_t iac_lap1, uint32_t iac_lap2){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_CURRENT_IAC_LAP_TWO_IACS);
+    hci_cmd_buffer[3] = num_current_iac;
+    little_endian_store_24(hci_cmd_buffer, 4, iac_lap1);
+    little_endian_store_24(hci_cmd_buffer, 7, iac_lap2);
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_WRITE_INQUIRY_SCAN_TYPE command
+ * @param hci_cmd_buffer
+ * @param inquiry_scan_type
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_inquiry_scan_type(uint8_t * hci_cmd_buffer, uint8_t inquiry_scan_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_INQUIRY_SCAN_TYPE);
+    hci_cmd_buffer[3] = inquiry_scan_type;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_WRITE_INQUIRY_MODE command
+ * @param hci_cmd_buffer
+ * @param inquiry_mode
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_inquiry_mode(uint8_t * hci_cmd_buffer, uint8_t inquiry_mode){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_INQUIRY_MODE);
+    hci_cmd_buffer[3] = inquiry_mode;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_WRITE_PAGE_SCAN_TYPE command
+ * @param hci_cmd_buffer
+ * @param page_scan_type
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_page_scan_type(uint8_t * hci_cmd_buffer, uint8_t page_scan_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_PAGE_SCAN_TYPE);
+    hci_cmd_buffer[3] = page_scan_type;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_WRITE_EXTENDED_INQUIRY_RESPONSE command
+ * @param hci_cmd_buffer
+ * @param fec_required
+ * @param exstended_inquiry_response
+ * @return size of command
+ * @note: format 1E
+ */
+static inline uint16_t hci_cmd_create_write_extended_inquiry_response(uint8_t * hci_cmd_buffer, uint8_t fec_required, const uint8_t * exstended_inquiry_response){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_EXTENDED_INQUIRY_RESPONSE);
+    hci_cmd_buffer[3] = fec_required;
+    (void)memcpy(&hci_cmd_buffer[4], exstended_inquiry_response, 240);
+    hci_cmd_buffer[2] = 241;
+    return 244;
+}
+
+/**
+ * @brief Create HCI_WRITE_SIMPLE_PAIRING_MODE command
+ * @param hci_cmd_buffer
+ * @param mode
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_simple_pairing_mode(uint8_t * hci_cmd_buffer, uint8_t mode){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_SIMPLE_PAIRING_MODE);
+    hci_cmd_buffer[3] = mode;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_READ_LOCAL_OOB_DATA command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_local_oob_data(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LOCAL_OOB_DATA);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_READ_INQUIRY_RESPONSE_TRANSMIT_POWER_LEVEL command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_inquiry_response_transmit_power_level(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_INQUIRY_RESPONSE_TRANSMIT_POWER_LEVEL);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_INQUIRY_TRANSMIT_POWER_LEVEL command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_inquiry_transmit_power_level(uint8_t * hci_cmd_buffer, uint8_t arg1){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_INQUIRY_TRANSMIT_POWER_LEVEL);
+    hci_cmd_buffer[3] = arg1;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_WRITE_DEFAULT_ERRONEOUS_DATA_REPORTING command
+ * @param hci_cmd_buffer
+ * @param mode
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_default_erroneous_data_reporting(uint8_t * hci_cmd_buffer, uint8_t mode){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_DEFAULT_ERRONEOUS_DATA_REPORTING);
+    hci_cmd_buffer[3] = mode;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_SET_EVENT_MASK_2 command
+ * @param hci_cmd_buffer
+ * @param event_mask_page_2_lower_octets
+ * @param event_mask_page_2_higher_octets
+ * @return size of command
+ * @note: format 44
+ */
+static inline uint16_t hci_cmd_create_set_event_mask_2(uint8_t * hci_cmd_buffer, uint32_t event_mask_page_2_lower_octets, uint32_t event_mask_page_2_higher_octets){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SET_EVENT_MASK_2);
+    little_endian_store_32(hci_cmd_buffer, 3, event_mask_page_2_lower_octets);
+    little_endian_store_32(hci_cmd_buffer, 7, event_mask_page_2_higher_octets);
+    hci_cmd_buffer[2] = 8;
+    return 11;
+}
+
+/**
+ * @brief Create HCI_READ_LE_HOST_SUPPORTED command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_le_host_supported(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LE_HOST_SUPPORTED);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_LE_HOST_SUPPORTED command
+ * @param hci_cmd_buffer
+ * @param le_supported_host
+ * @param simultaneous_le_host
+ * @return size of command
+ * @note: format 11
+ */
+static inline uint16_t hci_cmd_create_write_le_host_supported(uint8_t * hci_cmd_buffer, uint8_t le_supported_host, uint8_t simultaneous_le_host){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_LE_HOST_SUPPORTED);
+    hci_cmd_buffer[3] = le_supported_host;
+    hci_cmd_buffer[4] = simultaneous_le_host;
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_WRITE_SECURE_CONNECTIONS_HOST_SUPPORT command
+ * @param hci_cmd_buffer
+ * @param secure_connections_host_support
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_secure_connections_host_support(uint8_t * hci_cmd_buffer, uint8_t secure_connections_host_support){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_SECURE_CONNECTIONS_HOST_SUPPORT);
+    hci_cmd_buffer[3] = secure_connections_host_support;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_READ_LOCAL_EXTENDED_OOB_DATA command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_local_extended_oob_data(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LOCAL_EXTENDED_OOB_DATA);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_READ_EXTENDED_PAGE_TIMEOUT command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_extended_page_timeout(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_EXTENDED_PAGE_TIMEOUT);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_EXTENDED_PAGE_TIMEOUT command
+ * @param hci_cmd_buffer
+ * @param extended_page_timeout
+ * @return size of command
+ * @note: format 2
+ */
+static inline uint16_t hci_cmd_create_write_extended_page_timeout(uint8_t * hci_cmd_buffer, uint16_t extended_page_timeout){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_EXTENDED_PAGE_TIMEOUT);
+    little_endian_store_16(hci_cmd_buffer, 3, extended_page_timeout);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_READ_EXTENDED_INQUIRY_LENGTH command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_extended_inquiry_length(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_EXTENDED_INQUIRY_LENGTH);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_EXTENDED_INQUIRY_LENGTH command
+ * @param hci_cmd_buffer
+ * @param extended_inquiry_length
+ * @return size of command
+ * @note: format 2
+ */
+static inline uint16_t hci_cmd_create_write_extended_inquiry_length(uint8_t * hci_cmd_buffer, uint16_t extended_inquiry_length){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_EXTENDED_INQUIRY_LENGTH);
+    little_endian_store_16(hci_cmd_buffer, 3, extended_inquiry_length);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_SET_ECOSYSTEM_BASE_INTERVAL command
+ * @param hci_cmd_buffer
+ * @param interval
+ * @return size of command
+ * @note: format 2
+ */
+static inline uint16_t hci_cmd_create_set_ecosystem_base_interval(uint8_t * hci_cmd_buffer, uint16_t interval){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SET_ECOSYSTEM_BASE_INTERVAL);
+    little_endian_store_16(hci_cmd_buffer, 3, interval);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_CONFIGURE_DATA_PATH command
+ * @param hci_cmd_buffer
+ * @param data_path_direction
+ * @param data_path_id
+ * @param vendor_specific_config_length
+ * @param vendor_specific_config
+ * @return size of command
+ * @note: format 11JV
+ */
+static inline uint16_t hci_cmd_create_configure_data_path(uint8_t * hci_cmd_buffer, uint8_t data_path_direction, uint8_t data_path_id, uint8_t vendor_specific_config_length, const uint8_t * vendor_specific_config){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_CONFIGURE_DATA_PATH);
+    hci_cmd_buffer[3] = data_path_direction;
+    hci_cmd_buffer[4] = data_path_id;
+    hci_cmd_buffer[5] = vendor_specific_config_length;
+    uint16_t pos = 6;
+    (void)memcpy(&hci_cmd_buffer[pos], vendor_specific_config, vendor_specific_config_length);
+    pos += vendor_specific_config_length;
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_SET_MIN_ENCRYPTION_KEY_SIZE command
+ * @param hci_cmd_buffer
+ * @param min_encryption_key_size
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_set_min_encryption_key_size(uint8_t * hci_cmd_buffer, uint8_t min_encryption_key_size){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_SET_MIN_ENCRYPTION_KEY_SIZE);
+    hci_cmd_buffer[3] = min_encryption_key_size;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_READ_LOOPBACK_MODE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_loopback_mode(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LOOPBACK_MODE);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_LOOPBACK_MODE command
+ * @param hci_cmd_buffer
+ * @param loopback_mode
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_loopback_mode(uint8_t * hci_cmd_buffer, uint8_t loopback_mode){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_LOOPBACK_MODE);
+    hci_cmd_buffer[3] = loopback_mode;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_ENABLE_DEVICE_UNDER_TEST_MODE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_enable_device_under_test_mode(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_ENABLE_DEVICE_UNDER_TEST_MODE);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_WRITE_SIMPLE_PAIRING_DEBUG_MODE command
+ * @param hci_cmd_buffer
+ * @param simple_pairing_debug_mode
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_write_simple_pairing_debug_mode(uint8_t * hci_cmd_buffer, uint8_t simple_pairing_debug_mode){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_SIMPLE_PAIRING_DEBUG_MODE);
+    hci_cmd_buffer[3] = simple_pairing_debug_mode;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_WRITE_SECURE_CONNECTIONS_TEST_MODE command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param dm1_acl_u_mode
+ * @param esco_loopback_mode
+ * @return size of command
+ * @note: format H11
+ */
+static inline uint16_t hci_cmd_create_write_secure_connections_test_mode(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint8_t dm1_acl_u_mode, uint8_t esco_loopback_mode){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_WRITE_SECURE_CONNECTIONS_TEST_MODE);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[5] = dm1_acl_u_mode;
+    hci_cmd_buffer[6] = esco_loopback_mode;
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_READ_LOCAL_VERSION_INFORMATION command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_local_version_information(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LOCAL_VERSION_INFORMATION);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_READ_LOCAL_SUPPORTED_COMMANDS command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_local_supported_commands(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LOCAL_SUPPORTED_COMMANDS);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_READ_LOCAL_SUPPORTED_FEATURES command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_local_supported_features(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LOCAL_SUPPORTED_FEATURES);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_READ_BUFFER_SIZE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_buffer_size(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_BUFFER_SIZE);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_READ_BD_ADDR command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_read_bd_addr(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_BD_ADDR);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_READ_FAILED_CONTACT_COUNTER command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_read_failed_contact_counter(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_FAILED_CONTACT_COUNTER);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_RESET_FAILED_CONTACT_COUNTER command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_reset_failed_contact_counter(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_RESET_FAILED_CONTACT_COUNTER);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_READ_LINK_QUALITY command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_read_link_quality(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_LINK_QUALITY);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_READ_RSSI command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_read_rssi(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_RSSI);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_READ_CLOCK command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @param which_clock
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_read_clock(uint8_t * hci_cmd_buffer, hci_con_handle_t handle, uint8_t which_clock){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_CLOCK);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[5] = which_clock;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_READ_ENCRYPTION_KEY_SIZE command
+ * @param hci_cmd_buffer
+ * @param handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_read_encryption_key_size(uint8_t * hci_cmd_buffer, hci_con_handle_t handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_READ_ENCRYPTION_KEY_SIZE);
+    little_endian_store_16(hci_cmd_buffer, 3, handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_SET_EVENT_MASK command
+ * @param hci_cmd_buffer
+ * @param event_mask_lower_octets
+ * @param event_mask_higher_octets
+ * @return size of command
+ * @note: format 44
+ */
+static inline uint16_t hci_cmd_create_le_set_event_mask(uint8_t * hci_cmd_buffer, uint32_t event_mask_lower_octets, uint32_t event_mask_higher_octets){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_EVENT_MASK);
+    little_endian_store_32(hci_cmd_buffer, 3, event_mask_lower_octets);
+    little_endian_store_32(hci_cmd_buffer, 7, event_mask_higher_octets);
+    hci_cmd_buffer[2] = 8;
+    return 11;
+}
+
+/**
+ * @brief Create HCI_LE_READ_BUFFER_SIZE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_buffer_size(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_BUFFER_SIZE);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_LOCAL_SUPPORTED_FEATURES command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_local_supported_features(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_LOCAL_SUPPORTED_FEATURES);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_SET_RANDOM_ADDRESS command
+ * @param hci_cmd_buffer
+ * @param random_bd_addr
+ * @return size of command
+ * @note: format B
+ */
+static inline uint16_t hci_cmd_create_le_set_random_address(uint8_t * hci_cmd_buffer, const bd_addr_t random_bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_RANDOM_ADDRESS);
+    reverse_bd_addr(random_bd_addr, &hci_cmd_buffer[3]);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_LE_SET_ADVERTISING_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param advertising_interval_min
+ * @param advertising_interval_max
+ * @param advertising_type
+ * @param own_address_type
+ * @param direct_address_type
+ * @param direct_address
+ * @param advertising_channel_map
+ * @param advertising_filter_policy
+ * @return size of command
+ * @note: format 22111B11
+ */
+static inline uint16_t hci_cmd_create_le_set_advertising_parameters(uint8_t * hci_cmd_buffer, uint16_t advertising_interval_min, uint16_t advertising_interval_max, uint8_t advertising_type, uint8_t own_address_type, uint8_t direct_address_type, const bd_addr_t direct_address, uint8_t advertising_channel_map, uint8_t advertising_filter_policy){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_ADVERTISING_PARAMETERS);
+    little_endian_store_16(hci_cmd_buffer, 3, advertising_interval_min);
+    little_endian_store_16(hci_cmd_buffer, 5, advertising_interval_max);
+    hci_cmd_buffer[7] = advertising_type;
+    hci_cmd_buffer[8] = own_address_type;
+    hci_cmd_buffer[9] = direct_address_type;
+    reverse_bd_addr(direct_address, &hci_cmd_buffer[10]);
+    hci_cmd_buffer[16] = advertising_channel_map;
+    hci_cmd_buffer[17] = advertising_filter_policy;
+    hci_cmd_buffer[2] = 15;
+    return 18;
+}
+
+/**
+ * @brief Create HCI_LE_READ_ADVERTISING_CHANNEL_TX_POWER command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_advertising_channel_tx_power(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_ADVERTISING_CHANNEL_TX_POWER);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_SET_ADVERTISING_DATA command
+ * @param hci_cmd_buffer
+ * @param advertising_data_length
+ * @param advertising_data
+ * @return size of command
+ * @note: format 1A
+ */
+static inline uint16_t hci_cmd_create_le_set_advertising_data(uint8_t * hci_cmd_buffer, uint8_t advertising_data_length, const uint8_t * advertising_data){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_ADVERTISING_DATA);
+    hci_cmd_buffer[3] = advertising_data_length;
+    (void)memcpy(&hci_cmd_buffer[4], advertising_data, 31);
+    hci_cmd_buffer[2] = 32;
+    return 35;
+}
+
+/**
+ * @brief Create HCI_LE_SET_SCAN_RESPONSE_DATA command
+ * @param hci_cmd_buffer
+ * @param scan_response_data_length
+ * @param scan_response_data
+ * @return size of command
+ * @note: format 1A
+ */
+static inline uint16_t hci_cmd_create_le_set_scan_response_data(uint8_t * hci_cmd_buffer, uint8_t scan_response_data_length, const uint8_t * scan_response_data){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_SCAN_RESPONSE_DATA);
+    hci_cmd_buffer[3] = scan_response_data_length;
+    (void)memcpy(&hci_cmd_buffer[4], scan_response_data, 31);
+    hci_cmd_buffer[2] = 32;
+    return 35;
+}
+
+/**
+ * @brief Create HCI_LE_SET_ADVERTISE_ENABLE command
+ * @param hci_cmd_buffer
+ * @param advertise_enable
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_le_set_advertise_enable(uint8_t * hci_cmd_buffer, uint8_t advertise_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_ADVERTISE_ENABLE);
+    hci_cmd_buffer[3] = advertise_enable;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_LE_SET_SCAN_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param le_scan_type
+ * @param le_scan_interval
+ * @param le_scan_window
+ * @param own_address_type
+ * @param scanning_filter_policy
+ * @return size of command
+ * @note: format 12211
+ */
+static inline uint16_t hci_cmd_create_le_set_scan_parameters(uint8_t * hci_cmd_buffer, uint8_t le_scan_type, uint16_t le_scan_interval, uint16_t le_scan_window, uint8_t own_address_type, uint8_t scanning_filter_policy){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_SCAN_PARAMETERS);
+    hci_cmd_buffer[3] = le_scan_type;
+    little_endian_store_16(hci_cmd_buffer, 4, le_scan_interval);
+    little_endian_store_16(hci_cmd_buffer, 6, le_scan_window);
+    hci_cmd_buffer[8] = own_address_type;
+    hci_cmd_buffer[9] = scanning_filter_policy;
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_LE_SET_SCAN_ENABLE command
+ * @param hci_cmd_buffer
+ * @param le_scan_enable
+ * @param filter_duplices
+ * @return size of command
+ * @note: format 11
+ */
+static inline uint16_t hci_cmd_create_le_set_scan_enable(uint8_t * hci_cmd_buffer, uint8_t le_scan_enable, uint8_t filter_duplices){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_SCAN_ENABLE);
+    hci_cmd_buffer[3] = le_scan_enable;
+    hci_cmd_buffer[4] = filter_duplices;
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_CREATE_CONNECTION command
+ * @param hci_cmd_buffer
+ * @param le_scan_interval
+ * @param le_scan_window
+ * @param initiator_filter_policy
+ * @param peer_address_type
+ * @param peer_address
+ * @param own_address_type
+ * @param conn_interval_min
+ * @param conn_interval_max
+ * @param conn_latency
+ * @param supervision_timeout
+ * @param minimum_ce_length
+ * @param maximum_ce_length
+ * @return size of command
+ * @note: format 2211B1222222
+ */
+static inline uint16_t hci_cmd_create_le_create_connection(uint8_t * hci_cmd_buffer, uint16_t le_scan_interval, uint16_t le_scan_window, uint8_t initiator_filter_policy, uint8_t peer_address_type, const bd_addr_t peer_address, uint8_t own_address_type, uint16_t conn_interval_min, uint16_t conn_interval_max, uint16_t conn_latency, uint16_t supervision_timeout, uint16_t minimum_ce_length, uint16_t maximum_ce_length){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CREATE_CONNECTION);
+    little_endian_store_16(hci_cmd_buffer, 3, le_scan_interval);
+    little_endian_store_16(hci_cmd_buffer, 5, le_scan_window);
+    hci_cmd_buffer[7] = initiator_filter_policy;
+    hci_cmd_buffer[8] = peer_address_type;
+    reverse_bd_addr(peer_address, &hci_cmd_buffer[9]);
+    hci_cmd_buffer[15] = own_address_type;
+    little_endian_store_16(hci_cmd_buffer, 16, conn_interval_min);
+    little_endian_store_16(hci_cmd_buffer, 18, conn_interval_max);
+    little_endian_store_16(hci_cmd_buffer, 20, conn_latency);
+    little_endian_store_16(hci_cmd_buffer, 22, supervision_timeout);
+    little_endian_store_16(hci_cmd_buffer, 24, minimum_ce_length);
+    little_endian_store_16(hci_cmd_buffer, 26, maximum_ce_length);
+    hci_cmd_buffer[2] = 25;
+    return 28;
+}
+
+/**
+ * @brief Create HCI_LE_CREATE_CONNECTION_CANCEL command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_create_connection_cancel(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CREATE_CONNECTION_CANCEL);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_WHITE_LIST_SIZE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_white_list_size(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_WHITE_LIST_SIZE);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_CLEAR_WHITE_LIST command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_clear_white_list(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CLEAR_WHITE_LIST);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_ADD_DEVICE_TO_WHITE_LIST command
+ * @param hci_cmd_buffer
+ * @param address_type
+ * @param bd_addr
+ * @return size of command
+ * @note: format 1B
+ */
+static inline uint16_t hci_cmd_create_le_add_device_to_white_list(uint8_t * hci_cmd_buffer, uint8_t address_type, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ADD_DEVICE_TO_WHITE_LIST);
+    hci_cmd_buffer[3] = address_type;
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[4]);
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_LE_REMOVE_DEVICE_FROM_WHITE_LIST command
+ * @param hci_cmd_buffer
+ * @param address_type
+ * @param bd_addr
+ * @return size of command
+ * @note: format 1B
+ */
+static inline uint16_t hci_cmd_create_le_remove_device_from_white_list(uint8_t * hci_cmd_buffer, uint8_t address_type, const bd_addr_t bd_addr){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REMOVE_DEVICE_FROM_WHITE_LIST);
+    hci_cmd_buffer[3] = address_type;
+    reverse_bd_addr(bd_addr, &hci_cmd_buffer[4]);
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_LE_CONNECTION_UPDATE command
+ * @param hci_cmd_buffer
+ * @param conn_handle
+ * @param conn_interval_min
+ * @param conn_interval_max
+ * @param conn_latency
+ * @param supervision_timeout
+ * @param minimum_ce_length
+ * @param maximum_ce_length
+ * @return size of command
+ * @note: format H222222
+ */
+static inline uint16_t hci_cmd_create_le_connection_update(uint8_t * hci_cmd_buffer, hci_con_handle_t conn_handle, uint16_t conn_interval_min, uint16_t conn_interval_max, uint16_t conn_latency, uint16_t supervision_timeout, uint16_t minimum_ce_length, uint16_t maximum_ce_length){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CONNECTION_UPDATE);
+    little_endian_store_16(hci_cmd_buffer, 3, conn_handle);
+    little_endian_store_16(hci_cmd_buffer, 5, conn_interval_min);
+    little_endian_store_16(hci_cmd_buffer, 7, conn_interval_max);
+    little_endian_store_16(hci_cmd_buffer, 9, conn_latency);
+    little_endian_store_16(hci_cmd_buffer, 11, supervision_timeout);
+    little_endian_store_16(hci_cmd_buffer, 13, minimum_ce_length);
+    little_endian_store_16(hci_cmd_buffer, 15, maximum_ce_length);
+    hci_cmd_buffer[2] = 14;
+    return 17;
+}
+
+/**
+ * @brief Create HCI_LE_SET_HOST_CHANNEL_CLASSIFICATION command
+ * @param hci_cmd_buffer
+ * @param channel_map_lower_32bits
+ * @param channel_map_higher_5bits
+ * @return size of command
+ * @note: format 41
+ */
+static inline uint16_t hci_cmd_create_le_set_host_channel_classification(uint8_t * hci_cmd_buffer, uint32_t channel_map_lower_32bits, uint8_t channel_map_higher_5bits){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_HOST_CHANNEL_CLASSIFICATION);
+    little_endian_store_32(hci_cmd_buffer, 3, channel_map_lower_32bits);
+    hci_cmd_buffer[7] = channel_map_higher_5bits;
+    hci_cmd_buffer[2] = 5;
+    return 8;
+}
+
+/**
+ * @brief Create HCI_LE_READ_CHANNEL_MAP command
+ * @param hci_cmd_buffer
+ * @param conn_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_read_channel_map(uint8_t * hci_cmd_buffer, hci_con_handle_t conn_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_CHANNEL_MAP);
+    little_endian_store_16(hci_cmd_buffer, 3, conn_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_READ_REMOTE_USED_FEATURES command
+ * @param hci_cmd_buffer
+ * @param conn_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_read_remote_used_features(uint8_t * hci_cmd_buffer, hci_con_handle_t conn_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_REMOTE_USED_FEATURES);
+    little_endian_store_16(hci_cmd_buffer, 3, conn_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_ENCRYPT command
+ * @param hci_cmd_buffer
+ * @param key
+ * @param plain_text
+ * @return size of command
+ * @note: format PP
+ */
+static inline uint16_t hci_cmd_create_le_encrypt(uint8_t * hci_cmd_buffer, const uint8_t * key, const uint8_t * plain_text){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ENCRYPT);
+    (void)memcpy(&hci_cmd_buffer[3], key, 16);
+    (void)memcpy(&hci_cmd_buffer[19], plain_text, 16);
+    hci_cmd_buffer[2] = 32;
+    return 35;
+}
+
+/**
+ * @brief Create HCI_LE_RAND command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_rand(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_RAND);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_START_ENCRYPTION command
+ * @param hci_cmd_buffer
+ * @param conn_handle
+ * @param random_number_lower_32bits
+ * @param random_number_higher_32bits
+ * @param encryption_diversifier
+ * @param long_term_key
+ * @return size of command
+ * @note: format H442P
+ */
+static inline uint16_t hci_cmd_create_le_start_encryption(uint8_t * hci_cmd_buffer, hci_con_handle_t conn_handle, uint32_t random_number_lower_32bits, uint32_t random_number_higher_32bits, uint16_t encryption_diversifier, const uint8_t * long_term_key){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_START_ENCRYPTION);
+    little_endian_store_16(hci_cmd_buffer, 3, conn_handle);
+    little_endian_store_32(hci_cmd_buffer, 5, random_number_lower_32bits);
+    little_endian_store_32(hci_cmd_buffer, 9, random_number_higher_32bits);
+    little_endian_store_16(hci_cmd_buffer, 13, encryption_diversifier);
+    (void)memcpy(&hci_cmd_buffer[15], long_term_key, 16);
+    hci_cmd_buffer[2] = 28;
+    return 31;
+}
+
+/**
+ * @brief Create HCI_LE_LONG_TERM_KEY_REQUEST_REPLY command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param long_term_key
+ * @return size of command
+ * @note: format HP
+ */
+static inline uint16_t hci_cmd_create_le_long_term_key_request_reply(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, const uint8_t * long_term_key){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_LONG_TERM_KEY_REQUEST_REPLY);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    (void)memcpy(&hci_cmd_buffer[5], long_term_key, 16);
+    hci_cmd_buffer[2] = 18;
+    return 21;
+}
+
+/**
+ * @brief Create HCI_LE_LONG_TERM_KEY_NEGATIVE_REPLY command
+ * @param hci_cmd_buffer
+ * @param conn_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_long_term_key_negative_reply(uint8_t * hci_cmd_buffer, hci_con_handle_t conn_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_LONG_TERM_KEY_NEGATIVE_REPLY);
+    little_endian_store_16(hci_cmd_buffer, 3, conn_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_READ_SUPPORTED_STATES command
+ * @param hci_cmd_buffer
+ * @param conn_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_read_supported_states(uint8_t * hci_cmd_buffer, hci_con_handle_t conn_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_SUPPORTED_STATES);
+    little_endian_store_16(hci_cmd_buffer, 3, conn_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_RECEIVER_TEST command
+ * @param hci_cmd_buffer
+ * @param rx_frequency
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_le_receiver_test(uint8_t * hci_cmd_buffer, uint8_t rx_frequency){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_RECEIVER_TEST);
+    hci_cmd_buffer[3] = rx_frequency;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_LE_TRANSMITTER_TEST command
+ * @param hci_cmd_buffer
+ * @param tx_frequency
+ * @param test_payload_lengh
+ * @param packet_payload
+ * @return size of command
+ * @note: format 111
+ */
+static inline uint16_t hci_cmd_create_le_transmitter_test(uint8_t * hci_cmd_buffer, uint8_t tx_frequency, uint8_t test_payload_lengh, uint8_t packet_payload){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_TRANSMITTER_TEST);
+    hci_cmd_buffer[3] = tx_frequency;
+    hci_cmd_buffer[4] = test_payload_lengh;
+    hci_cmd_buffer[5] = packet_payload;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_TEST_END command
+ * @param hci_cmd_buffer
+ * @param end_test_cmd
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_le_test_end(uint8_t * hci_cmd_buffer, uint8_t end_test_cmd){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_TEST_END);
+    hci_cmd_buffer[3] = end_test_cmd;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_LE_REMOTE_CONNECTION_PARAMETER_REQUEST_REPLY command
+ * @param hci_cmd_buffer
+ * @param conn_handle
+ * @param conn_interval_min
+ * @param conn_interval_max
+ * @param conn_latency
+ * @param supervision_timeout
+ * @param minimum_ce_length
+ * @param maximum_ce_length
+ * @return size of command
+ * @note: format H222222
+ */
+static inline uint16_t hci_cmd_create_le_remote_connection_parameter_request_reply(uint8_t * hci_cmd_buffer, hci_con_handle_t conn_handle, uint16_t conn_interval_min, uint16_t conn_interval_max, uint16_t conn_latency, uint16_t supervision_timeout, uint16_t minimum_ce_length, uint16_t maximum_ce_length){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REMOTE_CONNECTION_PARAMETER_REQUEST_REPLY);
+    little_endian_store_16(hci_cmd_buffer, 3, conn_handle);
+    little_endian_store_16(hci_cmd_buffer, 5, conn_interval_min);
+    little_endian_store_16(hci_cmd_buffer, 7, conn_interval_max);
+    little_endian_store_16(hci_cmd_buffer, 9, conn_latency);
+    little_endian_store_16(hci_cmd_buffer, 11, supervision_timeout);
+    little_endian_store_16(hci_cmd_buffer, 13, minimum_ce_length);
+    little_endian_store_16(hci_cmd_buffer, 15, maximum_ce_length);
+    hci_cmd_buffer[2] = 14;
+    return 17;
+}
+
+/**
+ * @brief Create HCI_LE_REMOTE_CONNECTION_PARAMETER_REQUEST_NEGATIVE_REPLY command
+ * @param hci_cmd_buffer
+ * @param con_handle
+ * @param reason
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_remote_connection_parameter_request_negative_reply(uint8_t * hci_cmd_buffer, hci_con_handle_t con_handle, uint8_t reason){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REMOTE_CONNECTION_PARAMETER_REQUEST_NEGATIVE_REPLY);
+    little_endian_store_16(hci_cmd_buffer, 3, con_handle);
+    hci_cmd_buffer[5] = reason;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_SET_DATA_LENGTH command
+ * @param hci_cmd_buffer
+ * @param con_handle
+ * @param tx_octets
+ * @param tx_time
+ * @return size of command
+ * @note: format H22
+ */
+static inline uint16_t hci_cmd_create_le_set_data_length(uint8_t * hci_cmd_buffer, hci_con_handle_t con_handle, uint16_t tx_octets, uint16_t tx_time){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_DATA_LENGTH);
+    little_endian_store_16(hci_cmd_buffer, 3, con_handle);
+    little_endian_store_16(hci_cmd_buffer, 5, tx_octets);
+    little_endian_store_16(hci_cmd_buffer, 7, tx_time);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_LE_READ_SUGGESTED_DEFAULT_DATA_LENGTH command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_suggested_default_data_length(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_SUGGESTED_DEFAULT_DATA_LENGTH);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_WRITE_SUGGESTED_DEFAULT_DATA_LENGTH command
+ * @param hci_cmd_buffer
+ * @param suggested_max_tx_octets
+ * @param suggested_max_tx_time
+ * @return size of command
+ * @note: format 22
+ */
+static inline uint16_t hci_cmd_create_le_write_suggested_default_data_length(uint8_t * hci_cmd_buffer, uint16_t suggested_max_tx_octets, uint16_t suggested_max_tx_time){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_WRITE_SUGGESTED_DEFAULT_DATA_LENGTH);
+    little_endian_store_16(hci_cmd_buffer, 3, suggested_max_tx_octets);
+    little_endian_store_16(hci_cmd_buffer, 5, suggested_max_tx_time);
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_LE_READ_LOCAL_P256_PUBLIC_KEY command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_local_p256_public_key(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_LOCAL_P256_PUBLIC_KEY);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_GENERATE_DHKEY command
+ * @param hci_cmd_buffer
+ * @param remote_p256_public_key_x
+ * @param remote_p256_public_key_y
+ * @return size of command
+ * @note: format QQ
+ */
+static inline uint16_t hci_cmd_create_le_generate_dhkey(uint8_t * hci_cmd_buffer, const uint8_t * remote_p256_public_key_x, const uint8_t * remote_p256_public_key_y){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_GENERATE_DHKEY);
+    reverse_256(remote_p256_public_key_x, &hci_cmd_buffer[3]);
+    reverse_256(remote_p256_public_key_y, &hci_cmd_buffer[35]);
+    hci_cmd_buffer[2] = 64;
+    return 67;
+}
+
+/**
+ * @brief Create HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST command
+ * @param hci_cmd_buffer
+ * @param peer_identity_address_type
+ * @param peer_identity_address
+ * @param peer_irk
+ * @param local_irk
+ * @return size of command
+ * @note: format 1BPP
+ */
+static inline uint16_t hci_cmd_create_le_add_device_to_resolving_list(uint8_t * hci_cmd_buffer, uint8_t peer_identity_address_type, const bd_addr_t peer_identity_address, const uint8_t * peer_irk, const uint8_t * local_irk){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ADD_DEVICE_TO_RESOLVING_LIST);
+    hci_cmd_buffer[3] = peer_identity_address_type;
+    reverse_bd_addr(peer_identity_address, &hci_cmd_buffer[4]);
+    (void)memcpy(&hci_cmd_buffer[10], peer_irk, 16);
+    (void)memcpy(&hci_cmd_buffer[26], local_irk, 16);
+    hci_cmd_buffer[2] = 39;
+    return 42;
+}
+
+/**
+ * @brief Create HCI_LE_REMOVE_DEVICE_FROM_RESOLVING_LIST command
+ * @param hci_cmd_buffer
+ * @param peer_identity_address_type
+ * @param peer_identity_address
+ * @return size of command
+ * @note: format 1B
+ */
+static inline uint16_t hci_cmd_create_le_remove_device_from_resolving_list(uint8_t * hci_cmd_buffer, uint8_t peer_identity_address_type, const bd_addr_t peer_identity_address){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REMOVE_DEVICE_FROM_RESOLVING_LIST);
+    hci_cmd_buffer[3] = peer_identity_address_type;
+    reverse_bd_addr(peer_identity_address, &hci_cmd_buffer[4]);
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_LE_CLEAR_RESOLVING_LIST command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_clear_resolving_list(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CLEAR_RESOLVING_LIST);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_RESOLVING_LIST_SIZE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_resolving_list_size(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_RESOLVING_LIST_SIZE);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_PEER_RESOLVABLE_ADDRESS command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_peer_resolvable_address(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_PEER_RESOLVABLE_ADDRESS);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_LOCAL_RESOLVABLE_ADDRESS command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_local_resolvable_address(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_LOCAL_RESOLVABLE_ADDRESS);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_SET_ADDRESS_RESOLUTION_ENABLED command
+ * @param hci_cmd_buffer
+ * @param address_resolution_enable
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_le_set_address_resolution_enabled(uint8_t * hci_cmd_buffer, uint8_t address_resolution_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_ADDRESS_RESOLUTION_ENABLED);
+    hci_cmd_buffer[3] = address_resolution_enable;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_LE_SET_RESOLVABLE_PRIVATE_ADDRESS_TIMEOUT command
+ * @param hci_cmd_buffer
+ * @param rpa_timeout
+ * @return size of command
+ * @note: format 2
+ */
+static inline uint16_t hci_cmd_create_le_set_resolvable_private_address_timeout(uint8_t * hci_cmd_buffer, uint16_t rpa_timeout){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_RESOLVABLE_PRIVATE_ADDRESS_TIMEOUT);
+    little_endian_store_16(hci_cmd_buffer, 3, rpa_timeout);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_READ_MAXIMUM_DATA_LENGTH command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_maximum_data_length(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_MAXIMUM_DATA_LENGTH);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_PHY command
+ * @param hci_cmd_buffer
+ * @param con_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_read_phy(uint8_t * hci_cmd_buffer, hci_con_handle_t con_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_PHY);
+    little_endian_store_16(hci_cmd_buffer, 3, con_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_SET_DEFAULT_PHY command
+ * @param hci_cmd_buffer
+ * @param all_phys
+ * @param tx_phys
+ * @param rx_phys
+ * @return size of command
+ * @note: format 111
+ */
+static inline uint16_t hci_cmd_create_le_set_default_phy(uint8_t * hci_cmd_buffer, uint8_t all_phys, uint8_t tx_phys, uint8_t rx_phys){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_DEFAULT_PHY);
+    hci_cmd_buffer[3] = all_phys;
+    hci_cmd_buffer[4] = tx_phys;
+    hci_cmd_buffer[5] = rx_phys;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_SET_PHY command
+ * @param hci_cmd_buffer
+ * @param con_handle
+ * @param all_phys
+ * @param tx_phys
+ * @param rx_phys
+ * @param phy_options
+ * @return size of command
+ * @note: format H1112
+ */
+static inline uint16_t hci_cmd_create_le_set_phy(uint8_t * hci_cmd_buffer, hci_con_handle_t con_handle, uint8_t all_phys, uint8_t tx_phys, uint8_t rx_phys, uint16_t phy_options){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_PHY);
+    little_endian_store_16(hci_cmd_buffer, 3, con_handle);
+    hci_cmd_buffer[5] = all_phys;
+    hci_cmd_buffer[6] = tx_phys;
+    hci_cmd_buffer[7] = rx_phys;
+    little_endian_store_16(hci_cmd_buffer, 8, phy_options);
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_LE_RECEIVER_TEST_V2 command
+ * @param hci_cmd_buffer
+ * @param rx_channel
+ * @param phy
+ * @param modulation_index
+ * @return size of command
+ * @note: format 111
+ */
+static inline uint16_t hci_cmd_create_le_receiver_test_v2(uint8_t * hci_cmd_buffer, uint8_t rx_channel, uint8_t phy, uint8_t modulation_index){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_RECEIVER_TEST_V2);
+    hci_cmd_buffer[3] = rx_channel;
+    hci_cmd_buffer[4] = phy;
+    hci_cmd_buffer[5] = modulation_index;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_TRANSMITTER_TEST_V2 command
+ * @param hci_cmd_buffer
+ * @param tx_channel
+ * @param test_data_length
+ * @param packet_payload
+ * @param phy
+ * @return size of command
+ * @note: format 1111
+ */
+static inline uint16_t hci_cmd_create_le_transmitter_test_v2(uint8_t * hci_cmd_buffer, uint8_t tx_channel, uint8_t test_data_length, uint8_t packet_payload, uint8_t phy){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_TRANSMITTER_TEST_V2);
+    hci_cmd_buffer[3] = tx_channel;
+    hci_cmd_buffer[4] = test_data_length;
+    hci_cmd_buffer[5] = packet_payload;
+    hci_cmd_buffer[6] = phy;
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_LE_SET_ADVERTISING_SET_RANDOM_ADDRESS command
+ * @param hci_cmd_buffer
+ * @param advertising_handle
+ * @param random_address
+ * @return size of command
+ * @note: format 1B
+ */
+static inline uint16_t hci_cmd_create_le_set_advertising_set_random_address(uint8_t * hci_cmd_buffer, uint8_t advertising_handle, const bd_addr_t random_address){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_ADVERTISING_SET_RANDOM_ADDRESS);
+    hci_cmd_buffer[3] = advertising_handle;
+    reverse_bd_addr(random_address, &hci_cmd_buffer[4]);
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_LE_SET_EXTENDED_ADVERTISING_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param advertising_handle
+ * @param advertising_event_properties
+ * @param primary_advertising_interval_min
+ * @param primary_advertising_interval_max
+ * @param primary_advertising_channel_map
+ * @param own_address_type
+ * @param peer_address_type
+ * @param peer_address
+ * @param advertising_filter_policy
+ * @param advertising_tx_power
+ * @param primary_advertising_phy
+ * @param secondary_advertising_max_skip
+ * @param secondary_advertising_phy
+ * @param advertising_sid
+ * @param scan_request_notification_enable
+ * @return size of command
+ * @note: format 1233111B1111111
+ */
+static inline uint16_t hci_cmd_create_le_set_extended_advertising_parameters(uint8_t * hci_cmd_buffer, uint8_t advertising_handle, uint16_t advertising_event_properties, uint32_t primary_advertising_interval_min, uint32_t primary_advertising_interval_max, uint8_t primary_advertising_channel_map, uint8_t own_address_type, uint8_t peer_address_type, const bd_addr_t peer_address, uint8_t advertising_filter_policy, uint8_t advertising_tx_power, uint8_t primary_advertising_phy, uint8_t secondary_advertising_max_skip, uint8_t secondary_advertising_phy, uint8_t advertising_sid, uint8_t scan_request_notification_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_EXTENDED_ADVERTISING_PARAMETERS);
+    hci_cmd_buffer[3] = advertising_handle;
+    little_endian_store_16(hci_cmd_buffer, 4, advertising_event_properties);
+    little_endian_store_24(hci_cmd_buffer, 6, primary_advertising_interval_min);
+    little_endian_store_24(hci_cmd_buffer, 9, primary_advertising_interval_max);
+    hci_cmd_buffer[12] = primary_advertising_channel_map;
+    hci_cmd_buffer[13] = own_address_type;
+    hci_cmd_buffer[14] = peer_address_type;
+    reverse_bd_addr(peer_address, &hci_cmd_buffer[15]);
+    hci_cmd_buffer[21] = advertising_filter_policy;
+    hci_cmd_buffer[22] = advertising_tx_power;
+    hci_cmd_buffer[23] = primary_advertising_phy;
+    hci_cmd_buffer[24] = secondary_advertising_max_skip;
+    hci_cmd_buffer[25] = secondary_advertising_phy;
+    hci_cmd_buffer[26] = advertising_sid;
+    hci_cmd_buffer[27] = scan_request_notification_enable;
+    hci_cmd_buffer[2] = 25;
+    return 28;
+}
+
+/**
+ * @brief Create HCI_LE_SET_EXTENDED_ADVERTISING_DATA command
+ * @param hci_cmd_buffer
+ * @param advertising_handle
+ * @param operation
+ * @param fragment_preference
+ * @param advertising_data_length
+ * @param advertising_data
+ * @return size of command
+ * @note: format 111JV
+ */
+static inline uint16_t hci_cmd_create_le_set_extended_advertising_data(uint8_t * hci_cmd_buffer, uint8_t advertising_handle, uint8_t operation, uint8_t fragment_preference, uint8_t advertising_data_length, const uint8_t * advertising_data){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_EXTENDED_ADVERTISING_DATA);
+    hci_cmd_buffer[3] = advertising_handle;
+    hci_cmd_buffer[4] = operation;
+    hci_cmd_buffer[5] = fragment_preference;
+    hci_cmd_buffer[6] = advertising_data_length;
+    uint16_t pos = 7;
+    (void)memcpy(&hci_cmd_buffer[pos], advertising_data, advertising_data_length);
+    pos += advertising_data_length;
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_SET_EXTENDED_SCAN_RESPONSE_DATA command
+ * @param hci_cmd_buffer
+ * @param advertising_handle
+ * @param operation
+ * @param fragment_preference
+ * @param scan_response_data_length
+ * @param scan_response_data
+ * @return size of command
+ * @note: format 111JV
+ */
+static inline uint16_t hci_cmd_create_le_set_extended_scan_response_data(uint8_t * hci_cmd_buffer, uint8_t advertising_handle, uint8_t operation, uint8_t fragment_preference, uint8_t scan_response_data_length, const uint8_t * scan_response_data){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_EXTENDED_SCAN_RESPONSE_DATA);
+    hci_cmd_buffer[3] = advertising_handle;
+    hci_cmd_buffer[4] = operation;
+    hci_cmd_buffer[5] = fragment_preference;
+    hci_cmd_buffer[6] = scan_response_data_length;
+    uint16_t pos = 7;
+    (void)memcpy(&hci_cmd_buffer[pos], scan_response_data, scan_response_data_length);
+    pos += scan_response_data_length;
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_SET_EXTENDED_ADVERTISING_ENABLE command
+ * @param hci_cmd_buffer
+ * @param enable
+ * @param num_sets
+ * @param advertising_handle array
+ * @param duration array
+ * @param max_extended_advertising_events array
+ * @return size of command
+ * @note: format 1a[121]
+ */
+static inline uint16_t hci_cmd_create_le_set_extended_advertising_enable(uint8_t * hci_cmd_buffer, uint8_t enable, uint8_t num_sets, const uint8_t * advertising_handle, const uint16_t * duration, const uint8_t * max_extended_advertising_events){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_EXTENDED_ADVERTISING_ENABLE);
+    hci_cmd_buffer[3] = enable;
+    hci_cmd_buffer[4] = num_sets;
+    uint16_t pos = 5;
+    uint8_t num_elements = num_sets;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = advertising_handle[i];
+        little_endian_store_16(hci_cmd_buffer, pos, duration[i]);
+        pos += 2;
+        hci_cmd_buffer[pos++] = max_extended_advertising_events[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_READ_MAXIMUM_ADVERTISING_DATA_LENGTH command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_maximum_advertising_data_length(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_MAXIMUM_ADVERTISING_DATA_LENGTH);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_NUMBER_OF_SUPPORTED_ADVERTISING_SETS command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_number_of_supported_advertising_sets(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_NUMBER_OF_SUPPORTED_ADVERTISING_SETS);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_REMOVE_ADVERTISING_SET command
+ * @param hci_cmd_buffer
+ * @param advertising_handle
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_le_remove_advertising_set(uint8_t * hci_cmd_buffer, uint8_t advertising_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REMOVE_ADVERTISING_SET);
+    hci_cmd_buffer[3] = advertising_handle;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_LE_CLEAR_ADVERTISING_SETS command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_clear_advertising_sets(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CLEAR_ADVERTISING_SETS);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_SET_PERIODIC_ADVERTISING_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param advertising_handle
+ * @param periodic_advertising_interval_min
+ * @param periodic_advertising_interval_max
+ * @param periodic_advertising_properties
+ * @return size of command
+ * @note: format 1222
+ */
+static inline uint16_t hci_cmd_create_le_set_periodic_advertising_parameters(uint8_t * hci_cmd_buffer, uint8_t advertising_handle, uint16_t periodic_advertising_interval_min, uint16_t periodic_advertising_interval_max, uint16_t periodic_advertising_properties){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_PERIODIC_ADVERTISING_PARAMETERS);
+    hci_cmd_buffer[3] = advertising_handle;
+    little_endian_store_16(hci_cmd_buffer, 4, periodic_advertising_interval_min);
+    little_endian_store_16(hci_cmd_buffer, 6, periodic_advertising_interval_max);
+    little_endian_store_16(hci_cmd_buffer, 8, periodic_advertising_properties);
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_LE_SET_PERIODIC_ADVERTISING_DATA command
+ * @param hci_cmd_buffer
+ * @param advertising_handle
+ * @param operation
+ * @param advertising_data_length
+ * @param advertising_data
+ * @return size of command
+ * @note: format 11JV
+ */
+static inline uint16_t hci_cmd_create_le_set_periodic_advertising_data(uint8_t * hci_cmd_buffer, uint8_t advertising_handle, uint8_t operation, uint8_t advertising_data_length, const uint8_t * advertising_data){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_PERIODIC_ADVERTISING_DATA);
+    hci_cmd_buffer[3] = advertising_handle;
+    hci_cmd_buffer[4] = operation;
+    hci_cmd_buffer[5] = advertising_data_length;
+    uint16_t pos = 6;
+    (void)memcpy(&hci_cmd_buffer[pos], advertising_data, advertising_data_length);
+    pos += advertising_data_length;
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_SET_PERIODIC_ADVERTISING_ENABLE command
+ * @param hci_cmd_buffer
+ * @param enable
+ * @param advertising_handle
+ * @return size of command
+ * @note: format 11
+ */
+static inline uint16_t hci_cmd_create_le_set_periodic_advertising_enable(uint8_t * hci_cmd_buffer, uint8_t enable, uint8_t advertising_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_PERIODIC_ADVERTISING_ENABLE);
+    hci_cmd_buffer[3] = enable;
+    hci_cmd_buffer[4] = advertising_handle;
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_SET_EXTENDED_SCAN_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param own_address_type
+ * @param scanning_filter_policy
+ * @param scanning_phys
+ * @param scan_type array
+ * @param scan_interval array
+ * @param scan_window array
+ * @return size of command
+ * @note: format 11b[122]
+ */
+static inline uint16_t hci_cmd_create_le_set_extended_scan_parameters(uint8_t * hci_cmd_buffer, uint8_t own_address_type, uint8_t scanning_filter_policy, uint8_t scanning_phys, const uint8_t * scan_type, const uint16_t * scan_interval, const uint16_t * scan_window){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_EXTENDED_SCAN_PARAMETERS);
+    hci_cmd_buffer[3] = own_address_type;
+    hci_cmd_buffer[4] = scanning_filter_policy;
+    hci_cmd_buffer[5] = scanning_phys;
+    uint16_t pos = 6;
+    uint8_t num_elements = (uint8_t) count_set_bits_uint32(scanning_phys);
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = scan_type[i];
+        little_endian_store_16(hci_cmd_buffer, pos, scan_interval[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, scan_window[i]);
+        pos += 2;
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_SET_EXTENDED_SCAN_ENABLE command
+ * @param hci_cmd_buffer
+ * @param enable
+ * @param filter_duplicates
+ * @param duration
+ * @param period
+ * @return size of command
+ * @note: format 1122
+ */
+static inline uint16_t hci_cmd_create_le_set_extended_scan_enable(uint8_t * hci_cmd_buffer, uint8_t enable, uint8_t filter_duplicates, uint16_t duration, uint16_t period){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_EXTENDED_SCAN_ENABLE);
+    hci_cmd_buffer[3] = enable;
+    hci_cmd_buffer[4] = filter_duplicates;
+    little_endian_store_16(hci_cmd_buffer, 5, duration);
+    little_endian_store_16(hci_cmd_buffer, 7, period);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_LE_EXTENDED_CREATE_CONNECTION command
+ * @param hci_cmd_buffer
+ * @param initiator_filter_policy
+ * @param own_address_type
+ * @param peer_address_type
+ * @param peer_address
+ * @param initiating_phys
+ * @param scan_interval array
+ * @param scan_window array
+ * @param connection_interval_min array
+ * @param connection_interval_max array
+ * @param connection_latency array
+ * @param supervision_timeout array
+ * @param min_ce_length array
+ * @param max_ce_length array
+ * @return size of command
+ * @note: format 111Bb[22222222]
+ */
+static inline uint16_t hci_cmd_create_le_extended_create_connection(uint8_t * hci_cmd_buffer, uint8_t initiator_filter_policy, uint8_t own_address_type, uint8_t peer_address_type, const bd_addr_t peer_address, uint8_t initiating_phys, const uint16_t * scan_interval, const uint16_t * scan_window, const uint16_t * connection_interval_min, const uint16_t * connection_interval_max, const uint16_t * connection_latency, const uint16_t * supervision_timeout, const uint16_t * min_ce_length, const uint16_t * max_ce_length){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_EXTENDED_CREATE_CONNECTION);
+    hci_cmd_buffer[3] = initiator_filter_policy;
+    hci_cmd_buffer[4] = own_address_type;
+    hci_cmd_buffer[5] = peer_address_type;
+    reverse_bd_addr(peer_address, &hci_cmd_buffer[6]);
+    hci_cmd_buffer[12] = initiating_phys;
+    uint16_t pos = 13;
+    uint8_t num_elements = (uint8_t) count_set_bits_uint32(initiating_phys);
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        little_endian_store_16(hci_cmd_buffer, pos, scan_interval[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, scan_window[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, connection_interval_min[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, connection_interval_max[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, connection_latency[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, supervision_timeout[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, min_ce_length[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, max_ce_length[i]);
+        pos += 2;
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_PERIODIC_ADVERTISING_CREATE_SYNC command
+ * @param hci_cmd_buffer
+ * @param options
+ * @param advertising_sid
+ * @param advertiser_address_type
+ * @param advertiser_address
+ * @param skip
+ * @param sync_timeout
+ * @param sync_cte_type
+ * @return size of command
+ * @note: format 111B221
+ */
+static inline uint16_t hci_cmd_create_le_periodic_advertising_create_sync(uint8_t * hci_cmd_buffer, uint8_t options, uint8_t advertising_sid, uint8_t advertiser_address_type, const bd_addr_t advertiser_address, uint16_t skip, uint16_t sync_timeout, uint8_t sync_cte_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_PERIODIC_ADVERTISING_CREATE_SYNC);
+    hci_cmd_buffer[3] = options;
+    hci_cmd_buffer[4] = advertising_sid;
+    hci_cmd_buffer[5] = advertiser_address_type;
+    reverse_bd_addr(advertiser_address, &hci_cmd_buffer[6]);
+    little_endian_store_16(hci_cmd_buffer, 12, skip);
+    little_endian_store_16(hci_cmd_buffer, 14, sync_timeout);
+    hci_cmd_buffer[16] = sync_cte_type;
+    hci_cmd_buffer[2] = 14;
+    return 17;
+}
+
+/**
+ * @brief Create HCI_LE_PERIODIC_ADVERTISING_CREATE_SYNC_CANCEL command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_periodic_advertising_create_sync_cancel(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_PERIODIC_ADVERTISING_CREATE_SYNC_CANCEL);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_PERIODIC_ADVERTISING_TERMINATE_SYNC command
+ * @param hci_cmd_buffer
+ * @param sync_handle
+ * @return size of command
+ * @note: format 2
+ */
+static inline uint16_t hci_cmd_create_le_periodic_advertising_terminate_sync(uint8_t * hci_cmd_buffer, uint16_t sync_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_PERIODIC_ADVERTISING_TERMINATE_SYNC);
+    little_endian_store_16(hci_cmd_buffer, 3, sync_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_ADD_DEVICE_TO_PERIODIC_ADVERTISER_LIST command
+ * @param hci_cmd_buffer
+ * @param advertiser_address_type
+ * @param advertiser_address
+ * @param advertising_sid
+ * @return size of command
+ * @note: format 1B1
+ */
+static inline uint16_t hci_cmd_create_le_add_device_to_periodic_advertiser_list(uint8_t * hci_cmd_buffer, uint8_t advertiser_address_type, const bd_addr_t advertiser_address, uint8_t advertising_sid){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ADD_DEVICE_TO_PERIODIC_ADVERTISER_LIST);
+    hci_cmd_buffer[3] = advertiser_address_type;
+    reverse_bd_addr(advertiser_address, &hci_cmd_buffer[4]);
+    hci_cmd_buffer[10] = advertising_sid;
+    hci_cmd_buffer[2] = 8;
+    return 11;
+}
+
+/**
+ * @brief Create HCI_LE_REMOVE_DEVICE_FROM_PERIODIC_ADVERTISER_LIST command
+ * @param hci_cmd_buffer
+ * @param advertiser_address_type
+ * @param advertiser_address
+ * @param advertising_sid
+ * @return size of command
+ * @note: format 1B1
+ */
+static inline uint16_t hci_cmd_create_le_remove_device_from_periodic_advertiser_list(uint8_t * hci_cmd_buffer, uint8_t advertiser_address_type, const bd_addr_t advertiser_address, uint8_t advertising_sid){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REMOVE_DEVICE_FROM_PERIODIC_ADVERTISER_LIST);
+    hci_cmd_buffer[3] = advertiser_address_type;
+    reverse_bd_addr(advertiser_address, &hci_cmd_buffer[4]);
+    hci_cmd_buffer[10] = advertising_sid;
+    hci_cmd_buffer[2] = 8;
+    return 11;
+}
+
+/**
+ * @brief Create HCI_LE_CLEAR_PERIODIC_ADVERTISER_LIST command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_clear_periodic_advertiser_list(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CLEAR_PERIODIC_ADVERTISER_LIST);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_PERIODIC_ADVERTISER_LIST_SIZE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_periodic_advertiser_list_size(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_PERIODIC_ADVERTISER_LIST_SIZE);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_TRANSMIT_POWER command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_transmit_power(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_TRANSMIT_POWER);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_RF_PATH_COMPENSATION command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_rf_path_compensation(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_RF_PATH_COMPENSATION);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_WRITE_RF_PATH_COMPENSATION command
+ * @param hci_cmd_buffer
+ * @param rf_tx_path_compensation_value
+ * @param rf_rx_path_compensation_value
+ * @return size of command
+ * @note: format 22
+ */
+static inline uint16_t hci_cmd_create_le_write_rf_path_compensation(uint8_t * hci_cmd_buffer, uint16_t rf_tx_path_compensation_value, uint16_t rf_rx_path_compensation_value){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_WRITE_RF_PATH_COMPENSATION);
+    little_endian_store_16(hci_cmd_buffer, 3, rf_tx_path_compensation_value);
+    little_endian_store_16(hci_cmd_buffer, 5, rf_rx_path_compensation_value);
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_LE_SET_PRIVACY_MODE command
+ * @param hci_cmd_buffer
+ * @param peer_identity_address_type
+ * @param peer_identity_address
+ * @param privacy_mode
+ * @return size of command
+ * @note: format 1B1
+ */
+static inline uint16_t hci_cmd_create_le_set_privacy_mode(uint8_t * hci_cmd_buffer, uint8_t peer_identity_address_type, const bd_addr_t peer_identity_address, uint8_t privacy_mode){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_PRIVACY_MODE);
+    hci_cmd_buffer[3] = peer_identity_address_type;
+    reverse_bd_addr(peer_identity_address, &hci_cmd_buffer[4]);
+    hci_cmd_buffer[10] = privacy_mode;
+    hci_cmd_buffer[2] = 8;
+    return 11;
+}
+
+/**
+ * @brief Create HCI_LE_RECEIVER_TEST_V3 command
+ * @param hci_cmd_buffer
+ * @param rx_channel
+ * @param phy
+ * @param modulation_index
+ * @param expected_cte_length
+ * @param expected_cte_type
+ * @param slot_durations
+ * @param switching_pattern_length
+ * @param antenna_ids array
+ * @return size of command
+ * @note: format 111111a[1]
+ */
+static inline uint16_t hci_cmd_create_le_receiver_test_v3(uint8_t * hci_cmd_buffer, uint8_t rx_channel, uint8_t phy, uint8_t modulation_index, uint8_t expected_cte_length, uint8_t expected_cte_type, uint8_t slot_durations, uint8_t switching_pattern_length, const uint8_t * antenna_ids){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_RECEIVER_TEST_V3);
+    hci_cmd_buffer[3] = rx_channel;
+    hci_cmd_buffer[4] = phy;
+    hci_cmd_buffer[5] = modulation_index;
+    hci_cmd_buffer[6] = expected_cte_length;
+    hci_cmd_buffer[7] = expected_cte_type;
+    hci_cmd_buffer[8] = slot_durations;
+    hci_cmd_buffer[9] = switching_pattern_length;
+    uint16_t pos = 10;
+    uint8_t num_elements = switching_pattern_length;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = antenna_ids[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_TRANSMITTER_TEST_V3 command
+ * @param hci_cmd_buffer
+ * @param tx_channel
+ * @param test_data_length
+ * @param packet_payload
+ * @param phy
+ * @param cte_length
+ * @param cte_type
+ * @param switching_pattern_length
+ * @param antenna_ids array
+ * @return size of command
+ * @note: format 111111a[1]
+ */
+static inline uint16_t hci_cmd_create_le_transmitter_test_v3(uint8_t * hci_cmd_buffer, uint8_t tx_channel, uint8_t test_data_length, uint8_t packet_payload, uint8_t phy, uint8_t cte_length, uint8_t cte_type, uint8_t switching_pattern_length, const uint8_t * antenna_ids){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_TRANSMITTER_TEST_V3);
+    hci_cmd_buffer[3] = tx_channel;
+    hci_cmd_buffer[4] = test_data_length;
+    hci_cmd_buffer[5] = packet_payload;
+    hci_cmd_buffer[6] = phy;
+    hci_cmd_buffer[7] = cte_length;
+    hci_cmd_buffer[8] = cte_type;
+    hci_cmd_buffer[9] = switching_pattern_length;
+    uint16_t pos = 10;
+    uint8_t num_elements = switching_pattern_length;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = antenna_ids[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_SET_CONNECTIONLESS_CTE_TRANSMIT_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param advertising_handle
+ * @param cte_length
+ * @param cte_type
+ * @param cte_count
+ * @param switching_pattern_length
+ * @param antenna_ids array
+ * @return size of command
+ * @note: format 1111a[1]
+ */
+static inline uint16_t hci_cmd_create_le_set_connectionless_cte_transmit_parameters(uint8_t * hci_cmd_buffer, uint8_t advertising_handle, uint8_t cte_length, uint8_t cte_type, uint8_t cte_count, uint8_t switching_pattern_length, const uint8_t * antenna_ids){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_CONNECTIONLESS_CTE_TRANSMIT_PARAMETERS);
+    hci_cmd_buffer[3] = advertising_handle;
+    hci_cmd_buffer[4] = cte_length;
+    hci_cmd_buffer[5] = cte_type;
+    hci_cmd_buffer[6] = cte_count;
+    hci_cmd_buffer[7] = switching_pattern_length;
+    uint16_t pos = 8;
+    uint8_t num_elements = switching_pattern_length;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = antenna_ids[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_SET_CONNECTIONLESS_CTE_TRANSMIT_ENABLE command
+ * @param hci_cmd_buffer
+ * @param advertising_handle
+ * @param cte_enable
+ * @return size of command
+ * @note: format 11
+ */
+static inline uint16_t hci_cmd_create_le_set_connectionless_cte_transmit_enable(uint8_t * hci_cmd_buffer, uint8_t advertising_handle, uint8_t cte_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_CONNECTIONLESS_CTE_TRANSMIT_ENABLE);
+    hci_cmd_buffer[3] = advertising_handle;
+    hci_cmd_buffer[4] = cte_enable;
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_SET_CONNECTIONLESS_IQ_SAMPLING_ENABLE command
+ * @param hci_cmd_buffer
+ * @param sync_handle
+ * @param sampling_enable
+ * @param slot_durations
+ * @param max_sampled_ctes
+ * @param switching_pattern_length
+ * @param antenna_ids array
+ * @return size of command
+ * @note: format 2111a[1]
+ */
+static inline uint16_t hci_cmd_create_le_set_connectionless_iq_sampling_enable(uint8_t * hci_cmd_buffer, uint16_t sync_handle, uint8_t sampling_enable, uint8_t slot_durations, uint8_t max_sampled_ctes, uint8_t switching_pattern_length, const uint8_t * antenna_ids){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_CONNECTIONLESS_IQ_SAMPLING_ENABLE);
+    little_endian_store_16(hci_cmd_buffer, 3, sync_handle);
+    hci_cmd_buffer[5] = sampling_enable;
+    hci_cmd_buffer[6] = slot_durations;
+    hci_cmd_buffer[7] = max_sampled_ctes;
+    hci_cmd_buffer[8] = switching_pattern_length;
+    uint16_t pos = 9;
+    uint8_t num_elements = switching_pattern_length;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = antenna_ids[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_SET_CONNECTION_CTE_RECEIVE_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param sampling_enable
+ * @param slot_durations
+ * @param switching_pattern_length
+ * @param antenna_ids array
+ * @return size of command
+ * @note: format 211a[1]
+ */
+static inline uint16_t hci_cmd_create_le_set_connection_cte_receive_parameters(uint8_t * hci_cmd_buffer, uint16_t connection_handle, uint8_t sampling_enable, uint8_t slot_durations, uint8_t switching_pattern_length, const uint8_t * antenna_ids){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_CONNECTION_CTE_RECEIVE_PARAMETERS);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = sampling_enable;
+    hci_cmd_buffer[6] = slot_durations;
+    hci_cmd_buffer[7] = switching_pattern_length;
+    uint16_t pos = 8;
+    uint8_t num_elements = switching_pattern_length;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = antenna_ids[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_SET_CONNECTION_CTE_TRANSMIT_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param cte_types
+ * @param switching_pattern_length
+ * @param antenna_ids array
+ * @return size of command
+ * @note: format 21a[1]
+ */
+static inline uint16_t hci_cmd_create_le_set_connection_cte_transmit_parameters(uint8_t * hci_cmd_buffer, uint16_t connection_handle, uint8_t cte_types, uint8_t switching_pattern_length, const uint8_t * antenna_ids){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_CONNECTION_CTE_TRANSMIT_PARAMETERS);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = cte_types;
+    hci_cmd_buffer[6] = switching_pattern_length;
+    uint16_t pos = 7;
+    uint8_t num_elements = switching_pattern_length;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = antenna_ids[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_CONNECTION_CTE_REQUEST_ENABLE command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param enable
+ * @param cte_request_interval
+ * @param requested_cte_length
+ * @param requested_cte_type
+ * @return size of command
+ * @note: format H1211
+ */
+static inline uint16_t hci_cmd_create_le_connection_cte_request_enable(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t enable, uint16_t cte_request_interval, uint8_t requested_cte_length, uint8_t requested_cte_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CONNECTION_CTE_REQUEST_ENABLE);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = enable;
+    little_endian_store_16(hci_cmd_buffer, 6, cte_request_interval);
+    hci_cmd_buffer[8] = requested_cte_length;
+    hci_cmd_buffer[9] = requested_cte_type;
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_LE_CONNECTION_CTE_RESPONSE_ENABLE command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param enable
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_connection_cte_response_enable(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CONNECTION_CTE_RESPONSE_ENABLE);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = enable;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_READ_ANTENNA_INFORMATION command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_antenna_information(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_ANTENNA_INFORMATION);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_SET_PERIODIC_ADVERTISING_RECEIVE_ENABLE command
+ * @param hci_cmd_buffer
+ * @param sync_handle
+ * @param enable
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_set_periodic_advertising_receive_enable(uint8_t * hci_cmd_buffer, hci_con_handle_t sync_handle, uint8_t enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_PERIODIC_ADVERTISING_RECEIVE_ENABLE);
+    little_endian_store_16(hci_cmd_buffer, 3, sync_handle);
+    hci_cmd_buffer[5] = enable;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_PERIODIC_ADVERTISING_SYNC_TRANSFER command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param service_data
+ * @param sync_handle
+ * @return size of command
+ * @note: format H22
+ */
+static inline uint16_t hci_cmd_create_le_periodic_advertising_sync_transfer(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint16_t service_data, uint16_t sync_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_PERIODIC_ADVERTISING_SYNC_TRANSFER);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    little_endian_store_16(hci_cmd_buffer, 5, service_data);
+    little_endian_store_16(hci_cmd_buffer, 7, sync_handle);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_LE_PERIODIC_ADVERTISING_SET_INFO_TRANSFER command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param service_data
+ * @param advertising_handle
+ * @return size of command
+ * @note: format H21
+ */
+static inline uint16_t hci_cmd_create_le_periodic_advertising_set_info_transfer(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint16_t service_data, uint8_t advertising_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_PERIODIC_ADVERTISING_SET_INFO_TRANSFER);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    little_endian_store_16(hci_cmd_buffer, 5, service_data);
+    hci_cmd_buffer[7] = advertising_handle;
+    hci_cmd_buffer[2] = 5;
+    return 8;
+}
+
+/**
+ * @brief Create HCI_LE_SET_PERIODIC_ADVERTISING_SYNC_TRANSFER_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param mode
+ * @param skip
+ * @param sync_timeout
+ * @param cte_type
+ * @return size of command
+ * @note: format H1221
+ */
+static inline uint16_t hci_cmd_create_le_set_periodic_advertising_sync_transfer_parameters(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t mode, uint16_t skip, uint16_t sync_timeout, uint8_t cte_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_PERIODIC_ADVERTISING_SYNC_TRANSFER_PARAMETERS);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = mode;
+    little_endian_store_16(hci_cmd_buffer, 6, skip);
+    little_endian_store_16(hci_cmd_buffer, 8, sync_timeout);
+    hci_cmd_buffer[10] = cte_type;
+    hci_cmd_buffer[2] = 8;
+    return 11;
+}
+
+/**
+ * @brief Create HCI_LE_SET_DEFAULT_PERIODIC_ADVERTISING_SYNC_TRANSFER_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param mode
+ * @param skip
+ * @param sync_timeout
+ * @param cte_type
+ * @return size of command
+ * @note: format 1221
+ */
+static inline uint16_t hci_cmd_create_le_set_default_periodic_advertising_sync_transfer_parameters(uint8_t * hci_cmd_buffer, uint8_t mode, uint16_t skip, uint16_t sync_timeout, uint8_t cte_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_DEFAULT_PERIODIC_ADVERTISING_SYNC_TRANSFER_PARAMETERS);
+    hci_cmd_buffer[3] = mode;
+    little_endian_store_16(hci_cmd_buffer, 4, skip);
+    little_endian_store_16(hci_cmd_buffer, 6, sync_timeout);
+    hci_cmd_buffer[8] = cte_type;
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_LE_GENERATE_DHKEY_V2 command
+ * @param hci_cmd_buffer
+ * @param remote_p256_public_key_x
+ * @param remote_p256_public_key_y
+ * @param key_type
+ * @return size of command
+ * @note: format QQ1
+ */
+static inline uint16_t hci_cmd_create_le_generate_dhkey_v2(uint8_t * hci_cmd_buffer, const uint8_t * remote_p256_public_key_x, const uint8_t * remote_p256_public_key_y, uint8_t key_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_GENERATE_DHKEY_V2);
+    reverse_256(remote_p256_public_key_x, &hci_cmd_buffer[3]);
+    reverse_256(remote_p256_public_key_y, &hci_cmd_buffer[35]);
+    hci_cmd_buffer[67] = key_type;
+    hci_cmd_buffer[2] = 65;
+    return 68;
+}
+
+/**
+ * @brief Create HCI_LE_MODIFY_SLEEP_CLOCK_ACCURACY command
+ * @param hci_cmd_buffer
+ * @param action
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_le_modify_sleep_clock_accuracy(uint8_t * hci_cmd_buffer, uint8_t action){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_MODIFY_SLEEP_CLOCK_ACCURACY);
+    hci_cmd_buffer[3] = action;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_LE_READ_BUFFER_SIZE_V2 command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_le_read_buffer_size_v2(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_BUFFER_SIZE_V2);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_LE_READ_ISO_TX_SYNC command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_read_iso_tx_sync(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_ISO_TX_SYNC);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_SET_CIG_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param cig_id
+ * @param sdu_interval_m_to_s
+ * @param sdu_interval_s_to_m
+ * @param slaves_clock_accuracy
+ * @param packing
+ * @param framing
+ * @param max_transport_latency_m_to_s
+ * @param max_transport_latency_s_to_m
+ * @param cis_count
+ * @param cis_id array
+ * @param max_sdu_m_to_s array
+ * @param max_sdu_s_to_m array
+ * @param phy_m_to_s array
+ * @param phy_s_to_m array
+ * @param rtn_m_to_s array
+ * @param rtn_s_to_m array
+ * @return size of command
+ * @note: format 13311122a[1221111]
+ */
+static inline uint16_t hci_cmd_create_le_set_cig_parameters(uint8_t * hci_cmd_buffer, uint8_t cig_id, uint32_t sdu_interval_m_to_s, uint32_t sdu_interval_s_to_m, uint8_t slaves_clock_accuracy, uint8_t packing, uint8_t framing, uint16_t max_transport_latency_m_to_s, uint16_t max_transport_latency_s_to_m, uint8_t cis_count, const uint8_t * cis_id, const uint16_t * max_sdu_m_to_s, const uint16_t * max_sdu_s_to_m, const uint8_t * phy_m_to_s, const uint8_t * phy_s_to_m, const uint8_t * rtn_m_to_s, const uint8_t * rtn_s_to_m){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_CIG_PARAMETERS);
+    hci_cmd_buffer[3] = cig_id;
+    little_endian_store_24(hci_cmd_buffer, 4, sdu_interval_m_to_s);
+    little_endian_store_24(hci_cmd_buffer, 7, sdu_interval_s_to_m);
+    hci_cmd_buffer[10] = slaves_clock_accuracy;
+    hci_cmd_buffer[11] = packing;
+    hci_cmd_buffer[12] = framing;
+    little_endian_store_16(hci_cmd_buffer, 13, max_transport_latency_m_to_s);
+    little_endian_store_16(hci_cmd_buffer, 15, max_transport_latency_s_to_m);
+    hci_cmd_buffer[17] = cis_count;
+    uint16_t pos = 18;
+    uint8_t num_elements = cis_count;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = cis_id[i];
+        little_endian_store_16(hci_cmd_buffer, pos, max_sdu_m_to_s[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, max_sdu_s_to_m[i]);
+        pos += 2;
+        hci_cmd_buffer[pos++] = phy_m_to_s[i];
+        hci_cmd_buffer[pos++] = phy_s_to_m[i];
+        hci_cmd_buffer[pos++] = rtn_m_to_s[i];
+        hci_cmd_buffer[pos++] = rtn_s_to_m[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_SET_CIG_PARAMETERS_TEST command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @param arg6
+ * @param arg7
+ * @param arg8
+ * @param arg9
+ * @param arg10
+ * @param arg11 array
+ * @param arg12 array
+ * @param arg13 array
+ * @param arg14 array
+ * @param arg15 array
+ * @param arg16 array
+ * @param arg17 array
+ * @param arg18 array
+ * @param arg19 array
+ * @param arg20 array
+ * @return size of command
+ * @note: format 133112111a[1122221111]
+ */
+static inline uint16_t hci_cmd_create_le_set_cig_parameters_test(uint8_t * hci_cmd_buffer, uint8_t arg1, uint32_t arg2, uint32_t arg3, uint8_t arg4, uint8_t arg5, uint16_t arg6, uint8_t arg7, uint8_t arg8, uint8_t arg9, uint8_t arg10, const uint8_t * arg11, const uint8_t * arg12, const uint16_t * arg13, const uint16_t * arg14, const uint16_t * arg15, const uint16_t * arg16, const uint8_t * arg17, const uint8_t * arg18, const uint8_t * arg19, const uint8_t * arg20){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_CIG_PARAMETERS_TEST);
+    hci_cmd_buffer[3] = arg1;
+    little_endian_store_24(hci_cmd_buffer, 4, arg2);
+    little_endian_store_24(hci_cmd_buffer, 7, arg3);
+    hci_cmd_buffer[10] = arg4;
+    hci_cmd_buffer[11] = arg5;
+    little_endian_store_16(hci_cmd_buffer, 12, arg6);
+    hci_cmd_buffer[14] = arg7;
+    hci_cmd_buffer[15] = arg8;
+    hci_cmd_buffer[16] = arg9;
+    hci_cmd_buffer[17] = arg10;
+    uint16_t pos = 18;
+    uint8_t num_elements = arg10;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = arg11[i];
+        hci_cmd_buffer[pos++] = arg12[i];
+        little_endian_store_16(hci_cmd_buffer, pos, arg13[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, arg14[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, arg15[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, arg16[i]);
+        pos += 2;
+        hci_cmd_buffer[pos++] = arg17[i];
+        hci_cmd_buffer[pos++] = arg18[i];
+        hci_cmd_buffer[pos++] = arg19[i];
+        hci_cmd_buffer[pos++] = arg20[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_CREATE_CIS command
+ * @param hci_cmd_buffer
+ * @param cis_count
+ * @param cis_connection_handle array
+ * @param acl_connection_handle array
+ * @return size of command
+ * @note: format a[22]
+ */
+static inline uint16_t hci_cmd_create_le_create_cis(uint8_t * hci_cmd_buffer, uint8_t cis_count, const uint16_t * cis_connection_handle, const uint16_t * acl_connection_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CREATE_CIS);
+    hci_cmd_buffer[3] = cis_count;
+    uint16_t pos = 4;
+    uint8_t num_elements = cis_count;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        little_endian_store_16(hci_cmd_buffer, pos, cis_connection_handle[i]);
+        pos += 2;
+        little_endian_store_16(hci_cmd_buffer, pos, acl_connection_handle[i]);
+        pos += 2;
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_REMOVE_CIG command
+ * @param hci_cmd_buffer
+ * @param cig_id
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_le_remove_cig(uint8_t * hci_cmd_buffer, uint8_t cig_id){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REMOVE_CIG);
+    hci_cmd_buffer[3] = cig_id;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_LE_ACCEPT_CIS_REQUEST command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_accept_cis_request(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ACCEPT_CIS_REQUEST);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_REJECT_CIS_REQUEST command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @param arg2
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_reject_cis_request(uint8_t * hci_cmd_buffer, hci_con_handle_t arg1, uint8_t arg2){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REJECT_CIS_REQUEST);
+    little_endian_store_16(hci_cmd_buffer, 3, arg1);
+    hci_cmd_buffer[5] = arg2;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_CREATE_BIG command
+ * @param hci_cmd_buffer
+ * @param big_handle
+ * @param advertising_handle
+ * @param num_bis
+ * @param sdu_interval
+ * @param max_sdu
+ * @param max_transport_latency
+ * @param rtn
+ * @param phy
+ * @param packing
+ * @param framing
+ * @param encryption
+ * @param broadcast_code
+ * @return size of command
+ * @note: format 11132211111K
+ */
+static inline uint16_t hci_cmd_create_le_create_big(uint8_t * hci_cmd_buffer, uint8_t big_handle, uint8_t advertising_handle, uint8_t num_bis, uint32_t sdu_interval, uint16_t max_sdu, uint16_t max_transport_latency, uint8_t rtn, uint8_t phy, uint8_t packing, uint8_t framing, uint8_t encryption, const uint8_t * broadcast_code){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CREATE_BIG);
+    hci_cmd_buffer[3] = big_handle;
+    hci_cmd_buffer[4] = advertising_handle;
+    hci_cmd_buffer[5] = num_bis;
+    little_endian_store_24(hci_cmd_buffer, 6, sdu_interval);
+    little_endian_store_16(hci_cmd_buffer, 9, max_sdu);
+    little_endian_store_16(hci_cmd_buffer, 11, max_transport_latency);
+    hci_cmd_buffer[13] = rtn;
+    hci_cmd_buffer[14] = phy;
+    hci_cmd_buffer[15] = packing;
+    hci_cmd_buffer[16] = framing;
+    hci_cmd_buffer[17] = encryption;
+    reverse_128(broadcast_code, &hci_cmd_buffer[18]);
+    hci_cmd_buffer[2] = 31;
+    return 34;
+}
+
+/**
+ * @brief Create HCI_LE_CREATE_BIG_TEST command
+ * @param hci_cmd_buffer
+ * @param big_handle
+ * @param advertising_handle
+ * @param num_bis
+ * @param sdu_interval
+ * @param iso_interval
+ * @param nse
+ * @param max_sdu
+ * @param max_pdu
+ * @param phy
+ * @param packing
+ * @param framing
+ * @param bn
+ * @param irc
+ * @param pto
+ * @param encryption
+ * @param broadcast_code
+ * @return size of command
+ * @note: format 111321221111111K
+ */
+static inline uint16_t hci_cmd_create_le_create_big_test(uint8_t * hci_cmd_buffer, uint8_t big_handle, uint8_t advertising_handle, uint8_t num_bis, uint32_t sdu_interval, uint16_t iso_interval, uint8_t nse, uint16_t max_sdu, uint16_t max_pdu, uint8_t phy, uint8_t packing, uint8_t framing, uint8_t bn, uint8_t irc, uint8_t pto, uint8_t encryption, const uint8_t * broadcast_code){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_CREATE_BIG_TEST);
+    hci_cmd_buffer[3] = big_handle;
+    hci_cmd_buffer[4] = advertising_handle;
+    hci_cmd_buffer[5] = num_bis;
+    little_endian_store_24(hci_cmd_buffer, 6, sdu_interval);
+    little_endian_store_16(hci_cmd_buffer, 9, iso_interval);
+    hci_cmd_buffer[11] = nse;
+    little_endian_store_16(hci_cmd_buffer, 12, max_sdu);
+    little_endian_store_16(hci_cmd_buffer, 14, max_pdu);
+    hci_cmd_buffer[16] = phy;
+    hci_cmd_buffer[17] = packing;
+    hci_cmd_buffer[18] = framing;
+    hci_cmd_buffer[19] = bn;
+    hci_cmd_buffer[20] = irc;
+    hci_cmd_buffer[21] = pto;
+    hci_cmd_buffer[22] = encryption;
+    reverse_128(broadcast_code, &hci_cmd_buffer[23]);
+    hci_cmd_buffer[2] = 36;
+    return 39;
+}
+
+/**
+ * @brief Create HCI_LE_TERMINATE_BIG command
+ * @param hci_cmd_buffer
+ * @param big_handle
+ * @param reason
+ * @return size of command
+ * @note: format 11
+ */
+static inline uint16_t hci_cmd_create_le_terminate_big(uint8_t * hci_cmd_buffer, uint8_t big_handle, uint8_t reason){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_TERMINATE_BIG);
+    hci_cmd_buffer[3] = big_handle;
+    hci_cmd_buffer[4] = reason;
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_BIG_CREATE_SYNC command
+ * @param hci_cmd_buffer
+ * @param big_handle
+ * @param sync_handle
+ * @param encryption
+ * @param broadcast_code
+ * @param mse
+ * @param big_sync_timeout
+ * @param num_bis
+ * @param bis array
+ * @return size of command
+ * @note: format 1H1K12a[1]
+ */
+static inline uint16_t hci_cmd_create_le_big_create_sync(uint8_t * hci_cmd_buffer, uint8_t big_handle, hci_con_handle_t sync_handle, uint8_t encryption, const uint8_t * broadcast_code, uint8_t mse, uint16_t big_sync_timeout, uint8_t num_bis, const uint8_t * bis){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_BIG_CREATE_SYNC);
+    hci_cmd_buffer[3] = big_handle;
+    little_endian_store_16(hci_cmd_buffer, 4, sync_handle);
+    hci_cmd_buffer[6] = encryption;
+    reverse_128(broadcast_code, &hci_cmd_buffer[7]);
+    hci_cmd_buffer[23] = mse;
+    little_endian_store_16(hci_cmd_buffer, 24, big_sync_timeout);
+    hci_cmd_buffer[26] = num_bis;
+    uint16_t pos = 27;
+    uint8_t num_elements = num_bis;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = bis[i];
+    }
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_BIG_TERMINATE_SYNC command
+ * @param hci_cmd_buffer
+ * @param big_handle
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_le_big_terminate_sync(uint8_t * hci_cmd_buffer, uint8_t big_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_BIG_TERMINATE_SYNC);
+    hci_cmd_buffer[3] = big_handle;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_LE_REQUEST_PEER_SCA command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_request_peer_sca(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REQUEST_PEER_SCA);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_SETUP_ISO_DATA_PATH command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param data_path_direction
+ * @param data_path_id
+ * @param codec_id_coding_format
+ * @param codec_id_company_identifier
+ * @param codec_id_vendor_codec_id
+ * @param controller_delay
+ * @param codec_configuration_length
+ * @param codec_configuration
+ * @return size of command
+ * @note: format H111223JV
+ */
+static inline uint16_t hci_cmd_create_le_setup_iso_data_path(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t data_path_direction, uint8_t data_path_id, uint8_t codec_id_coding_format, uint16_t codec_id_company_identifier, uint16_t codec_id_vendor_codec_id, uint32_t controller_delay, uint8_t codec_configuration_length, const uint8_t * codec_configuration){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SETUP_ISO_DATA_PATH);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = data_path_direction;
+    hci_cmd_buffer[6] = data_path_id;
+    hci_cmd_buffer[7] = codec_id_coding_format;
+    little_endian_store_16(hci_cmd_buffer, 8, codec_id_company_identifier);
+    little_endian_store_16(hci_cmd_buffer, 10, codec_id_vendor_codec_id);
+    little_endian_store_24(hci_cmd_buffer, 12, controller_delay);
+    hci_cmd_buffer[15] = codec_configuration_length;
+    uint16_t pos = 16;
+    (void)memcpy(&hci_cmd_buffer[pos], codec_configuration, codec_configuration_length);
+    pos += codec_configuration_length;
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_LE_REMOVE_ISO_DATA_PATH command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @param arg2
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_remove_iso_data_path(uint8_t * hci_cmd_buffer, hci_con_handle_t arg1, uint8_t arg2){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_REMOVE_ISO_DATA_PATH);
+    little_endian_store_16(hci_cmd_buffer, 3, arg1);
+    hci_cmd_buffer[5] = arg2;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_ISO_TRANSMIT_TEST command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param paylaod_type
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_iso_transmit_test(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t paylaod_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ISO_TRANSMIT_TEST);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = paylaod_type;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_ISO_RECEIVE_TEST command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param paylaod_type
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_iso_receive_test(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t paylaod_type){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ISO_RECEIVE_TEST);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = paylaod_type;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_ISO_READ_TEST_COUNTERS command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_iso_read_test_counters(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ISO_READ_TEST_COUNTERS);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_ISO_TEST_END command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_iso_test_end(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ISO_TEST_END);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_SET_HOST_FEATURE command
+ * @param hci_cmd_buffer
+ * @param bit_number
+ * @param bit_value
+ * @return size of command
+ * @note: format 11
+ */
+static inline uint16_t hci_cmd_create_le_set_host_feature(uint8_t * hci_cmd_buffer, uint8_t bit_number, uint8_t bit_value){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_HOST_FEATURE);
+    hci_cmd_buffer[3] = bit_number;
+    hci_cmd_buffer[4] = bit_value;
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_READ_ISO_LINK_QUALITY command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_le_read_iso_link_quality(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_ISO_LINK_QUALITY);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_LE_ENHANCED_READ_TRANSMIT_POWER_LEVEL command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param phy
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_enhanced_read_transmit_power_level(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t phy){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_ENHANCED_READ_TRANSMIT_POWER_LEVEL);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = phy;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_READ_REMOTE_TRANSMIT_POWER_LEVEL command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param phy
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_read_remote_transmit_power_level(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t phy){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_READ_REMOTE_TRANSMIT_POWER_LEVEL);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = phy;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_SET_PATH_LOSS_REPORTING_PARAMETERS command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param high_threshold
+ * @param high_hysteresis
+ * @param low_threshold
+ * @param low_hysteresis
+ * @param min_time_spent
+ * @return size of command
+ * @note: format 211112
+ */
+static inline uint16_t hci_cmd_create_le_set_path_loss_reporting_parameters(uint8_t * hci_cmd_buffer, uint16_t connection_handle, uint8_t high_threshold, uint8_t high_hysteresis, uint8_t low_threshold, uint8_t low_hysteresis, uint16_t min_time_spent){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_PATH_LOSS_REPORTING_PARAMETERS);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = high_threshold;
+    hci_cmd_buffer[6] = high_hysteresis;
+    hci_cmd_buffer[7] = low_threshold;
+    hci_cmd_buffer[8] = low_hysteresis;
+    little_endian_store_16(hci_cmd_buffer, 9, min_time_spent);
+    hci_cmd_buffer[2] = 8;
+    return 11;
+}
+
+/**
+ * @brief Create HCI_LE_SET_PATH_LOSS_REPORTING_ENABLE command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param enable
+ * @return size of command
+ * @note: format H1
+ */
+static inline uint16_t hci_cmd_create_le_set_path_loss_reporting_enable(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_PATH_LOSS_REPORTING_ENABLE);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = enable;
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_LE_SET_TRANSMIT_POWER_REPORTING_ENABLE command
+ * @param hci_cmd_buffer
+ * @param connection_handle
+ * @param local_enable
+ * @param remote_enable
+ * @return size of command
+ * @note: format H11
+ */
+static inline uint16_t hci_cmd_create_le_set_transmit_power_reporting_enable(uint8_t * hci_cmd_buffer, hci_con_handle_t connection_handle, uint8_t local_enable, uint8_t remote_enable){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_SET_TRANSMIT_POWER_REPORTING_ENABLE);
+    little_endian_store_16(hci_cmd_buffer, 3, connection_handle);
+    hci_cmd_buffer[5] = local_enable;
+    hci_cmd_buffer[6] = remote_enable;
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_LE_TRANSMITTER_TEST_V4 command
+ * @param hci_cmd_buffer
+ * @param tx_channel
+ * @param test_data_length
+ * @param packet_payload
+ * @param phy
+ * @param cte_length
+ * @param cte_type
+ * @param switching_pattern_length
+ * @param antenna_ids array
+ * @param transmit_power_level
+ * @return size of command
+ * @note: format 111111a[1]1
+ */
+static inline uint16_t hci_cmd_create_le_transmitter_test_v4(uint8_t * hci_cmd_buffer, uint8_t tx_channel, uint8_t test_data_length, uint8_t packet_payload, uint8_t phy, uint8_t cte_length, uint8_t cte_type, uint8_t switching_pattern_length, const uint8_t * antenna_ids, uint8_t transmit_power_level){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_LE_TRANSMITTER_TEST_V4);
+    hci_cmd_buffer[3] = tx_channel;
+    hci_cmd_buffer[4] = test_data_length;
+    hci_cmd_buffer[5] = packet_payload;
+    hci_cmd_buffer[6] = phy;
+    hci_cmd_buffer[7] = cte_length;
+    hci_cmd_buffer[8] = cte_type;
+    hci_cmd_buffer[9] = switching_pattern_length;
+    uint16_t pos = 10;
+    uint8_t num_elements = switching_pattern_length;
+    uint8_t i;
+    for (i = 0; i < num_elements; i++){
+        hci_cmd_buffer[pos++] = antenna_ids[i];
+    }
+    hci_cmd_buffer[pos] = transmit_power_level;
+    pos += 1;
+    hci_cmd_buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Create HCI_BCM_ENABLE_WBS command
+ * @param hci_cmd_buffer
+ * @param enable_wbs
+ * @param uuid_wbs
+ * @return size of command
+ * @note: format 12
+ */
+static inline uint16_t hci_cmd_create_bcm_enable_wbs(uint8_t * hci_cmd_buffer, uint8_t enable_wbs, uint16_t uuid_wbs){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_BCM_ENABLE_WBS);
+    hci_cmd_buffer[3] = enable_wbs;
+    little_endian_store_16(hci_cmd_buffer, 4, uuid_wbs);
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_BCM_PCM2_SETUP command
+ * @param hci_cmd_buffer
+ * @param action
+ * @param test_options
+ * @param op_mode
+ * @param sync_and_clock_options
+ * @param pcm_clock_freq
+ * @param sync_signal_width
+ * @param slot_width
+ * @param number_of_slots
+ * @param bank_0_fill_mode
+ * @param bank_0_number_of_fill_bits
+ * @param bank_0_programmable_fill_data
+ * @param bank_1_fill_mode
+ * @param bank_1_number_of_fill_bits
+ * @param bank_1_programmable_fill_data
+ * @param data_justify_and_bit_order_options
+ * @param ch_0_slot_number
+ * @param ch_1_slot_number
+ * @param ch_2_slot_number
+ * @param ch_3_slot_number
+ * @param ch_4_slot_number
+ * @param ch_0_period
+ * @param ch_1_period
+ * @param ch_2_period
+ * @return size of command
+ * @note: format 11114111111111111111111
+ */
+static inline uint16_t hci_cmd_create_bcm_pcm2_setup(uint8_t * hci_cmd_buffer, uint8_t action, uint8_t test_options, uint8_t op_mode, uint8_t sync_and_clock_options, uint32_t pcm_clock_freq, uint8_t sync_signal_width, uint8_t slot_width, uint8_t number_of_slots, uint8_t bank_0_fill_mode, uint8_t bank_0_number_of_fill_bits, uint8_t bank_0_programmable_fill_data, uint8_t bank_1_fill_mode, uint8_t bank_1_number_of_fill_bits, uint8_t bank_1_programmable_fill_data, uint8_t data_justify_and_bit_order_options, uint8_t ch_0_slot_number, uint8_t ch_1_slot_number, uint8_t ch_2_slot_number, uint8_t ch_3_slot_number, uint8_t ch_4_slot_number, uint8_t ch_0_period, uint8_t ch_1_period, uint8_t ch_2_period){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_BCM_PCM2_SETUP);
+    hci_cmd_buffer[3] = action;
+    hci_cmd_buffer[4] = test_options;
+    hci_cmd_buffer[5] = op_mode;
+    hci_cmd_buffer[6] = sync_and_clock_options;
+    little_endian_store_32(hci_cmd_buffer, 7, pcm_clock_freq);
+    hci_cmd_buffer[11] = sync_signal_width;
+    hci_cmd_buffer[12] = slot_width;
+    hci_cmd_buffer[13] = number_of_slots;
+    hci_cmd_buffer[14] = bank_0_fill_mode;
+    hci_cmd_buffer[15] = bank_0_number_of_fill_bits;
+    hci_cmd_buffer[16] = bank_0_programmable_fill_data;
+    hci_cmd_buffer[17] = bank_1_fill_mode;
+    hci_cmd_buffer[18] = bank_1_number_of_fill_bits;
+    hci_cmd_buffer[19] = bank_1_programmable_fill_data;
+    hci_cmd_buffer[20] = data_justify_and_bit_order_options;
+    hci_cmd_buffer[21] = ch_0_slot_number;
+    hci_cmd_buffer[22] = ch_1_slot_number;
+    hci_cmd_buffer[23] = ch_2_slot_number;
+    hci_cmd_buffer[24] = ch_3_slot_number;
+    hci_cmd_buffer[25] = ch_4_slot_number;
+    hci_cmd_buffer[26] = ch_0_period;
+    hci_cmd_buffer[27] = ch_1_period;
+    hci_cmd_buffer[28] = ch_2_period;
+    hci_cmd_buffer[2] = 26;
+    return 29;
+}
+
+/**
+ * @brief Create HCI_BCM_WRITE_SCO_PCM_INT command
+ * @param hci_cmd_buffer
+ * @param sco_routing
+ * @param pcm_interface_rate
+ * @param frame_type
+ * @param sync_mode
+ * @param clock_mode
+ * @return size of command
+ * @note: format 11111
+ */
+static inline uint16_t hci_cmd_create_bcm_write_sco_pcm_int(uint8_t * hci_cmd_buffer, uint8_t sco_routing, uint8_t pcm_interface_rate, uint8_t frame_type, uint8_t sync_mode, uint8_t clock_mode){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_BCM_WRITE_SCO_PCM_INT);
+    hci_cmd_buffer[3] = sco_routing;
+    hci_cmd_buffer[4] = pcm_interface_rate;
+    hci_cmd_buffer[5] = frame_type;
+    hci_cmd_buffer[6] = sync_mode;
+    hci_cmd_buffer[7] = clock_mode;
+    hci_cmd_buffer[2] = 5;
+    return 8;
+}
+
+/**
+ * @brief Create HCI_BCM_WRITE_PCM_DATA_FORMAT_PARAM command
+ * @param hci_cmd_buffer
+ * @param lsb_position
+ * @param fill_bits_value
+ * @param fill_data_selection
+ * @param number_of_fill_bits
+ * @param right_left_justification
+ * @return size of command
+ * @note: format 11111
+ */
+static inline uint16_t hci_cmd_create_bcm_write_pcm_data_format_param(uint8_t * hci_cmd_buffer, uint8_t lsb_position, uint8_t fill_bits_value, uint8_t fill_data_selection, uint8_t number_of_fill_bits, uint8_t right_left_justification){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_BCM_WRITE_PCM_DATA_FORMAT_PARAM);
+    hci_cmd_buffer[3] = lsb_position;
+    hci_cmd_buffer[4] = fill_bits_value;
+    hci_cmd_buffer[5] = fill_data_selection;
+    hci_cmd_buffer[6] = number_of_fill_bits;
+    hci_cmd_buffer[7] = right_left_justification;
+    hci_cmd_buffer[2] = 5;
+    return 8;
+}
+
+/**
+ * @brief Create HCI_BCM_WRITE_I2SPCM_INTERFACE_PARAM command
+ * @param hci_cmd_buffer
+ * @param i2s_enable
+ * @param is_master
+ * @param sample_rate
+ * @param clock_rate
+ * @return size of command
+ * @note: format 1111
+ */
+static inline uint16_t hci_cmd_create_bcm_write_i2spcm_interface_param(uint8_t * hci_cmd_buffer, uint8_t i2s_enable, uint8_t is_master, uint8_t sample_rate, uint8_t clock_rate){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_BCM_WRITE_I2SPCM_INTERFACE_PARAM);
+    hci_cmd_buffer[3] = i2s_enable;
+    hci_cmd_buffer[4] = is_master;
+    hci_cmd_buffer[5] = sample_rate;
+    hci_cmd_buffer[6] = clock_rate;
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_BCM_SET_SLEEP_MODE command
+ * @param hci_cmd_buffer
+ * @param sleep_mode
+ * @param idle_threshold_host
+ * @param idle_threshold_controller
+ * @param bt_wake_active_mode
+ * @param host_wake_active_mode
+ * @param allow_host_sleep_during_sco
+ * @param combine_sleep_mode_and_lpm
+ * @param enable_tristate_control_of_uart_tx_line
+ * @param active_connection_handling_on_suspend
+ * @param resume_timeout
+ * @param enable_break_to_host
+ * @param pulsed_host_wake
+ * @return size of command
+ * @note: format 111111111111
+ */
+static inline uint16_t hci_cmd_create_bcm_set_sleep_mode(uint8_t * hci_cmd_buffer, uint8_t sleep_mode, uint8_t idle_threshold_host, uint8_t idle_threshold_controller, uint8_t bt_wake_active_mode, uint8_t host_wake_active_mode, uint8_t allow_host_sleep_during_sco, uint8_t combine_sleep_mode_and_lpm, uint8_t enable_tristate_control_of_uart_tx_line, uint8_t active_connection_handling_on_suspend, uint8_t resume_timeout, uint8_t enable_break_to_host, uint8_t pulsed_host_wake){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_BCM_SET_SLEEP_MODE);
+    hci_cmd_buffer[3] = sleep_mode;
+    hci_cmd_buffer[4] = idle_threshold_host;
+    hci_cmd_buffer[5] = idle_threshold_controller;
+    hci_cmd_buffer[6] = bt_wake_active_mode;
+    hci_cmd_buffer[7] = host_wake_active_mode;
+    hci_cmd_buffer[8] = allow_host_sleep_during_sco;
+    hci_cmd_buffer[9] = combine_sleep_mode_and_lpm;
+    hci_cmd_buffer[10] = enable_tristate_control_of_uart_tx_line;
+    hci_cmd_buffer[11] = active_connection_handling_on_suspend;
+    hci_cmd_buffer[12] = resume_timeout;
+    hci_cmd_buffer[13] = enable_break_to_host;
+    hci_cmd_buffer[14] = pulsed_host_wake;
+    hci_cmd_buffer[2] = 12;
+    return 15;
+}
+
+/**
+ * @brief Create HCI_BCM_WRITE_TX_POWER_TABLE command
+ * @param hci_cmd_buffer
+ * @param is_le
+ * @param chip_max_tx_pwr_db
+ * @return size of command
+ * @note: format 11
+ */
+static inline uint16_t hci_cmd_create_bcm_write_tx_power_table(uint8_t * hci_cmd_buffer, uint8_t is_le, uint8_t chip_max_tx_pwr_db){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_BCM_WRITE_TX_POWER_TABLE);
+    hci_cmd_buffer[3] = is_le;
+    hci_cmd_buffer[4] = chip_max_tx_pwr_db;
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_BCM_SET_TX_PWR command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @return size of command
+ * @note: format 11H
+ */
+static inline uint16_t hci_cmd_create_bcm_set_tx_pwr(uint8_t * hci_cmd_buffer, uint8_t arg1, uint8_t arg2, hci_con_handle_t arg3){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_BCM_SET_TX_PWR);
+    hci_cmd_buffer[3] = arg1;
+    hci_cmd_buffer[4] = arg2;
+    little_endian_store_16(hci_cmd_buffer, 5, arg3);
+    hci_cmd_buffer[2] = 4;
+    return 7;
+}
+
+/**
+ * @brief Create HCI_TI_DRPB_TESTER_CON_RX command
+ * @param hci_cmd_buffer
+ * @param frequency
+ * @param adpll
+ * @return size of command
+ * @note: format 11
+ */
+static inline uint16_t hci_cmd_create_ti_drpb_tester_con_rx(uint8_t * hci_cmd_buffer, uint8_t frequency, uint8_t adpll){
+    little_endian_store_16(hci_cmd_buffer, 0, 0xFD17);
+    hci_cmd_buffer[3] = frequency;
+    hci_cmd_buffer[4] = adpll;
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_TI_DRPB_TESTER_CON_TX command
+ * @param hci_cmd_buffer
+ * @param modulation
+ * @param test_pattern
+ * @param frequency
+ * @param power_level
+ * @param reserved1
+ * @param reserved2
+ * @return size of command
+ * @note: format 111144
+ */
+static inline uint16_t hci_cmd_create_ti_drpb_tester_con_tx(uint8_t * hci_cmd_buffer, uint8_t modulation, uint8_t test_pattern, uint8_t frequency, uint8_t power_level, uint32_t reserved1, uint32_t reserved2){
+    little_endian_store_16(hci_cmd_buffer, 0, 0xFD84);
+    hci_cmd_buffer[3] = modulation;
+    hci_cmd_buffer[4] = test_pattern;
+    hci_cmd_buffer[5] = frequency;
+    hci_cmd_buffer[6] = power_level;
+    little_endian_store_32(hci_cmd_buffer, 7, reserved1);
+    little_endian_store_32(hci_cmd_buffer, 11, reserved2);
+    hci_cmd_buffer[2] = 12;
+    return 15;
+}
+
+/**
+ * @brief Create HCI_TI_DRPB_TESTER_PACKET_TX_RX command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @param arg6
+ * @param arg7
+ * @param arg8
+ * @param arg9
+ * @param arg10
+ * @return size of command
+ * @note: format 1111112112
+ */
+static inline uint16_t hci_cmd_create_ti_drpb_tester_packet_tx_rx(uint8_t * hci_cmd_buffer, uint8_t arg1, uint8_t arg2, uint8_t arg3, uint8_t arg4, uint8_t arg5, uint8_t arg6, uint16_t arg7, uint8_t arg8, uint8_t arg9, uint16_t arg10){
+    little_endian_store_16(hci_cmd_buffer, 0, 0xFD85);
+    hci_cmd_buffer[3] = arg1;
+    hci_cmd_buffer[4] = arg2;
+    hci_cmd_buffer[5] = arg3;
+    hci_cmd_buffer[6] = arg4;
+    hci_cmd_buffer[7] = arg5;
+    hci_cmd_buffer[8] = arg6;
+    little_endian_store_16(hci_cmd_buffer, 9, arg7);
+    hci_cmd_buffer[11] = arg8;
+    hci_cmd_buffer[12] = arg9;
+    little_endian_store_16(hci_cmd_buffer, 13, arg10);
+    hci_cmd_buffer[2] = 12;
+    return 15;
+}
+
+/**
+ * @brief Create HCI_TI_CONFIGURE_DDIP command
+ * @param hci_cmd_buffer
+ * @param best
+ * @param guaranteed
+ * @param poll
+ * @param slave
+ * @param slave_2
+ * @param master
+ * @param master_2
+ * @return size of command
+ * @note: format 1111111
+ */
+static inline uint16_t hci_cmd_create_ti_configure_ddip(uint8_t * hci_cmd_buffer, uint8_t best, uint8_t guaranteed, uint8_t poll, uint8_t slave, uint8_t slave_2, uint8_t master, uint8_t master_2){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_TI_VS_CONFIGURE_DDIP);
+    hci_cmd_buffer[3] = best;
+    hci_cmd_buffer[4] = guaranteed;
+    hci_cmd_buffer[5] = poll;
+    hci_cmd_buffer[6] = slave;
+    hci_cmd_buffer[7] = slave_2;
+    hci_cmd_buffer[8] = master;
+    hci_cmd_buffer[9] = master_2;
+    hci_cmd_buffer[2] = 7;
+    return 10;
+}
+
+/**
+ * @brief Create HCI_TI_AVRP_ENABLE command
+ * @param hci_cmd_buffer
+ * @param enable
+ * @param a3dp_role
+ * @param code_upload
+ * @param reserved
+ * @return size of command
+ * @note: format 1112
+ */
+static inline uint16_t hci_cmd_create_ti_avrp_enable(uint8_t * hci_cmd_buffer, uint8_t enable, uint8_t a3dp_role, uint8_t code_upload, uint16_t reserved){
+    little_endian_store_16(hci_cmd_buffer, 0, 0xFD92);
+    hci_cmd_buffer[3] = enable;
+    hci_cmd_buffer[4] = a3dp_role;
+    hci_cmd_buffer[5] = code_upload;
+    little_endian_store_16(hci_cmd_buffer, 6, reserved);
+    hci_cmd_buffer[2] = 5;
+    return 8;
+}
+
+/**
+ * @brief Create HCI_TI_WBS_ASSOCIATE command
+ * @param hci_cmd_buffer
+ * @param acl_con_handle
+ * @return size of command
+ * @note: format H
+ */
+static inline uint16_t hci_cmd_create_ti_wbs_associate(uint8_t * hci_cmd_buffer, hci_con_handle_t acl_con_handle){
+    little_endian_store_16(hci_cmd_buffer, 0, 0xFD78);
+    little_endian_store_16(hci_cmd_buffer, 3, acl_con_handle);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_TI_WBS_DISASSOCIATE command
+ * @param hci_cmd_buffer
+ * @return size of command
+ * @note: format 
+ */
+static inline uint16_t hci_cmd_create_ti_wbs_disassociate(uint8_t * hci_cmd_buffer){
+    little_endian_store_16(hci_cmd_buffer, 0, 0xFD79);
+    hci_cmd_buffer[2] = 0;
+    return 3;
+}
+
+/**
+ * @brief Create HCI_TI_WRITE_CODEC_CONFIG command
+ * @param hci_cmd_buffer
+ * @param clock_rate
+ * @param clock_direction
+ * @param frame_sync_frequency
+ * @param frame_sync_duty_cycle
+ * @param frame_sync_edge
+ * @param frame_sync_polariy
+ * @param reserved1
+ * @param channel_1_data_out_size
+ * @param channel_1_data_out_offset
+ * @param channel_1_data_out_edge
+ * @param channel_1_data_in_size
+ * @param channel_1_data_in_offset
+ * @param channel_1_data_in_edge
+ * @param fsync_multiplier
+ * @param channel_2_data_out_size
+ * @param channel_2_data_out_offset
+ * @param channel_2_data_out_edge
+ * @param channel_2_data_in_size
+ * @param channel_2_data_in_offset
+ * @param channel_2_data_in_edge
+ * @param reserved2
+ * @return size of command
+ * @note: format 214211122122112212211
+ */
+static inline uint16_t hci_cmd_create_ti_write_codec_config(uint8_t * hci_cmd_buffer, uint16_t clock_rate, uint8_t clock_direction, uint32_t frame_sync_frequency, uint16_t frame_sync_duty_cycle, uint8_t frame_sync_edge, uint8_t frame_sync_polariy, uint8_t reserved1, uint16_t channel_1_data_out_size, uint16_t channel_1_data_out_offset, uint8_t channel_1_data_out_edge, uint16_t channel_1_data_in_size, uint16_t channel_1_data_in_offset, uint8_t channel_1_data_in_edge, uint8_t fsync_multiplier, uint16_t channel_2_data_out_size, uint16_t channel_2_data_out_offset, uint8_t channel_2_data_out_edge, uint16_t channel_2_data_in_size, uint16_t channel_2_data_in_offset, uint8_t channel_2_data_in_edge, uint8_t reserved2){
+    little_endian_store_16(hci_cmd_buffer, 0, 0xFD06);
+    little_endian_store_16(hci_cmd_buffer, 3, clock_rate);
+    hci_cmd_buffer[5] = clock_direction;
+    little_endian_store_32(hci_cmd_buffer, 6, frame_sync_frequency);
+    little_endian_store_16(hci_cmd_buffer, 10, frame_sync_duty_cycle);
+    hci_cmd_buffer[12] = frame_sync_edge;
+    hci_cmd_buffer[13] = frame_sync_polariy;
+    hci_cmd_buffer[14] = reserved1;
+    little_endian_store_16(hci_cmd_buffer, 15, channel_1_data_out_size);
+    little_endian_store_16(hci_cmd_buffer, 17, channel_1_data_out_offset);
+    hci_cmd_buffer[19] = channel_1_data_out_edge;
+    little_endian_store_16(hci_cmd_buffer, 20, channel_1_data_in_size);
+    little_endian_store_16(hci_cmd_buffer, 22, channel_1_data_in_offset);
+    hci_cmd_buffer[24] = channel_1_data_in_edge;
+    hci_cmd_buffer[25] = fsync_multiplier;
+    little_endian_store_16(hci_cmd_buffer, 26, channel_2_data_out_size);
+    little_endian_store_16(hci_cmd_buffer, 28, channel_2_data_out_offset);
+    hci_cmd_buffer[30] = channel_2_data_out_edge;
+    little_endian_store_16(hci_cmd_buffer, 31, channel_2_data_in_size);
+    little_endian_store_16(hci_cmd_buffer, 33, channel_2_data_in_offset);
+    hci_cmd_buffer[35] = channel_2_data_in_edge;
+    hci_cmd_buffer[36] = reserved2;
+    hci_cmd_buffer[2] = 34;
+    return 37;
+}
+
+/**
+ * @brief Create HCI_TI_DRPB_ENABLE_RF_CALIBRATION command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @return size of command
+ * @note: format 141
+ */
+static inline uint16_t hci_cmd_create_ti_drpb_enable_rf_calibration(uint8_t * hci_cmd_buffer, uint8_t arg1, uint32_t arg2, uint8_t arg3){
+    little_endian_store_16(hci_cmd_buffer, 0, 0xFD80);
+    hci_cmd_buffer[3] = arg1;
+    little_endian_store_32(hci_cmd_buffer, 4, arg2);
+    hci_cmd_buffer[8] = arg3;
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_TI_WRITE_HARDWARE_REGISTER command
+ * @param hci_cmd_buffer
+ * @param frequency
+ * @param adpll
+ * @return size of command
+ * @note: format 42
+ */
+static inline uint16_t hci_cmd_create_ti_write_hardware_register(uint8_t * hci_cmd_buffer, uint32_t frequency, uint16_t adpll){
+    little_endian_store_16(hci_cmd_buffer, 0, 0xFF01);
+    little_endian_store_32(hci_cmd_buffer, 3, frequency);
+    little_endian_store_16(hci_cmd_buffer, 7, adpll);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_RTK_CONFIGURE_SCO_ROUTING command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @param arg6
+ * @param arg7
+ * @param arg8
+ * @param arg9
+ * @return size of command
+ * @note: format 111111111
+ */
+static inline uint16_t hci_cmd_create_rtk_configure_sco_routing(uint8_t * hci_cmd_buffer, uint8_t arg1, uint8_t arg2, uint8_t arg3, uint8_t arg4, uint8_t arg5, uint8_t arg6, uint8_t arg7, uint8_t arg8, uint8_t arg9){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_RTK_CONFIGURE_SCO_ROUTING);
+    hci_cmd_buffer[3] = arg1;
+    hci_cmd_buffer[4] = arg2;
+    hci_cmd_buffer[5] = arg3;
+    hci_cmd_buffer[6] = arg4;
+    hci_cmd_buffer[7] = arg5;
+    hci_cmd_buffer[8] = arg6;
+    hci_cmd_buffer[9] = arg7;
+    hci_cmd_buffer[10] = arg8;
+    hci_cmd_buffer[11] = arg9;
+    hci_cmd_buffer[2] = 9;
+    return 12;
+}
+
+/**
+ * @brief Create HCI_RTK_READ_CARD_INFO command
+ * @param hci_cmd_buffer
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @return size of command
+ * @note: format 11111
+ */
+static inline uint16_t hci_cmd_create_rtk_read_card_info(uint8_t * hci_cmd_buffer, uint8_t arg1, uint8_t arg2, uint8_t arg3, uint8_t arg4, uint8_t arg5){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_RTK_READ_CARD_INFO);
+    hci_cmd_buffer[3] = arg1;
+    hci_cmd_buffer[4] = arg2;
+    hci_cmd_buffer[5] = arg3;
+    hci_cmd_buffer[6] = arg4;
+    hci_cmd_buffer[7] = arg5;
+    hci_cmd_buffer[2] = 5;
+    return 8;
+}
+
+/**
+ * @brief Create HCI_NXP_SET_SCO_DATA_PATH command
+ * @param hci_cmd_buffer
+ * @param voice_path
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_nxp_set_sco_data_path(uint8_t * hci_cmd_buffer, uint8_t voice_path){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_NXP_SET_SCO_DATA_PATH);
+    hci_cmd_buffer[3] = voice_path;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_NXP_WRITE_PCM_I2S_SETTINGS command
+ * @param hci_cmd_buffer
+ * @param settings
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_nxp_write_pcm_i2s_settings(uint8_t * hci_cmd_buffer, uint8_t settings){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_NXP_WRITE_PCM_I2S_SETTINGS);
+    hci_cmd_buffer[3] = settings;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_NXP_WRITE_PCM_I2S_SYNC_SETTINGS command
+ * @param hci_cmd_buffer
+ * @param sync_settings_1
+ * @param sync_settings_2
+ * @return size of command
+ * @note: format 12
+ */
+static inline uint16_t hci_cmd_create_nxp_write_pcm_i2s_sync_settings(uint8_t * hci_cmd_buffer, uint8_t sync_settings_1, uint16_t sync_settings_2){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_NXP_WRITE_PCM_I2S_SYNC_SETTINGS);
+    hci_cmd_buffer[3] = sync_settings_1;
+    little_endian_store_16(hci_cmd_buffer, 4, sync_settings_2);
+    hci_cmd_buffer[2] = 3;
+    return 6;
+}
+
+/**
+ * @brief Create HCI_NXP_WRITE_PCM_LINK_SETTINGS command
+ * @param hci_cmd_buffer
+ * @param settings
+ * @return size of command
+ * @note: format 2
+ */
+static inline uint16_t hci_cmd_create_nxp_write_pcm_link_settings(uint8_t * hci_cmd_buffer, uint16_t settings){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_NXP_WRITE_PCM_LINK_SETTINGS);
+    little_endian_store_16(hci_cmd_buffer, 3, settings);
+    hci_cmd_buffer[2] = 2;
+    return 5;
+}
+
+/**
+ * @brief Create HCI_NXP_SET_WBS_CONNECTION command
+ * @param hci_cmd_buffer
+ * @param next_connection_wbs
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_nxp_set_wbs_connection(uint8_t * hci_cmd_buffer, uint8_t next_connection_wbs){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_NXP_SET_WBS_CONNECTION);
+    hci_cmd_buffer[3] = next_connection_wbs;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+/**
+ * @brief Create HCI_NXP_HOST_PCM_I2S_AUDIO_CONFIG command
+ * @param hci_cmd_buffer
+ * @param action
+ * @param operation
+ * @param sco_handle_1
+ * @param sco_handle_2
+ * @return size of command
+ * @note: format 11HH
+ */
+static inline uint16_t hci_cmd_create_nxp_host_pcm_i2s_audio_config(uint8_t * hci_cmd_buffer, uint8_t action, uint8_t operation, hci_con_handle_t sco_handle_1, hci_con_handle_t sco_handle_2){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_NXP_HOST_PCM_I2S_AUDIO_CONFIG);
+    hci_cmd_buffer[3] = action;
+    hci_cmd_buffer[4] = operation;
+    little_endian_store_16(hci_cmd_buffer, 5, sco_handle_1);
+    little_endian_store_16(hci_cmd_buffer, 7, sco_handle_2);
+    hci_cmd_buffer[2] = 6;
+    return 9;
+}
+
+/**
+ * @brief Create HCI_NXP_HOST_PCM_I2S_CONTROL_ENABLE command
+ * @param hci_cmd_buffer
+ * @param action
+ * @return size of command
+ * @note: format 1
+ */
+static inline uint16_t hci_cmd_create_nxp_host_pcm_i2s_control_enable(uint8_t * hci_cmd_buffer, uint8_t action){
+    little_endian_store_16(hci_cmd_buffer, 0, HCI_OPCODE_HCI_NXP_HOST_PCM_I2S_CONTROL_ENABLE);
+    hci_cmd_buffer[3] = action;
+    hci_cmd_buffer[2] = 1;
+    return 4;
+}
+
+
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+
+#endif // HCI_CMD_SERIALIZER_H
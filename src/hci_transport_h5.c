@@ -82,8 +82,17 @@ typedef enum {
 
 } hci_transport_link_actions_t;
 
-// Configuration Field. No packet buffers -> sliding window = 1, no OOF flow control, support data integrity check
-#define LINK_CONFIG_SLIDING_WINDOW_SIZE 1
+// Number of unacknowledged reliable packets, > 1 requires a copy of each outgoing packet
+#ifndef HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE
+#define HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE 1
+#endif
+
+#if (HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE < 1) || (HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE > 7)
+#error HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE must be between 1 and 7
+#endif
+
+// Configuration Field. Sliding window as configured, no OOF flow control, support data integrity check
+#define LINK_CONFIG_SLIDING_WINDOW_SIZE HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE
 #define LINK_CONFIG_OOF_FLOW_CONTROL 0
 #define LINK_CONFIG_DATA_INTEGRITY_CHECK 1
 #define LINK_CONFIG_VERSION_NR 0
@@ -134,10 +143,35 @@ static uint32_t link_new_baudrate;
 static btstack_timer_source_t inactivity_timer;
 static uint16_t link_inactivity_timeout_ms; // auto-sleep if set
 
-// Outgoing packet
+// Outgoing reliable packets waiting for ack, oldest one has link_seq_nr
+typedef struct {
+    uint8_t * packet;
+    uint16_t  size;
+    uint8_t   type;
+} hci_transport_link_slot_t;
+
+static hci_transport_link_slot_t link_slots[HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE];
+static uint8_t  link_window_size;
+static uint8_t  link_slots_head;
+static uint8_t  link_slots_used;
+// number of slots sent at least once and index of next slot to (re)send
+static uint8_t  link_slots_sent;
+static uint8_t  link_slots_next;
+// HCI_EVENT_TRANSPORT_PACKET_SENT not emitted yet for last reliable packet
+static uint8_t  link_packet_sent_pending;
+// early resend triggered by duplicate ack for this seq nr
+static uint8_t  link_fast_resend_pending;
+
+#if HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE > 1
+// per slot: 4 bytes H5 header + outgoing packet + 2 bytes DIC
+static uint8_t  link_slot_buffers[HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE][4 + HCI_OUTGOING_PACKET_BUFFER_SIZE + 2];
+#endif
+
+// Outgoing unreliable packet (SCO)
 static uint8_t   hci_packet_type;
 static uint16_t  hci_packet_size;
 static uint8_t * hci_packet;
+static int       slip_write_unreliable_packet;
 
 // restore 2 bytes temp overwritten by DIC
 static uint8_t * hci_packet_restore_dic_address;
@@ -263,17 +297,45 @@ static void hci_transport_slip_send_frame_with_dic(uint8_t * frame, uint16_t fra
     btstack_uart->send_frame(frame, frame_size);
 }
 
-static void hci_transport_link_send_queued_packet(void){
+static void hci_transport_link_send_unreliable_packet(void){
     uint8_t * buffer =      hci_packet      - 4;
     uint16_t  buffer_size = hci_packet_size + 4;
 
     // setup header
-    int reliable = hci_packet_type == HCI_SCO_DATA_PACKET ? 0 : 1;
-    hci_transport_link_calc_header(buffer, link_seq_nr, link_ack_nr, link_peer_supports_data_integrity_check, reliable, hci_packet_type, hci_packet_size);
+    hci_transport_link_calc_header(buffer, 0, link_ack_nr, link_peer_supports_data_integrity_check, 0, hci_packet_type, hci_packet_size);
 
     // send frame with dic
-    log_debug("send queued packet: seq %u, ack %u, size %u, append dic %u", link_seq_nr, link_ack_nr, hci_packet_size, link_peer_supports_data_integrity_check);
+    log_debug("send unreliable packet: ack %u, size %u, append dic %u", link_ack_nr, hci_packet_size, link_peer_supports_data_integrity_check);
     log_debug_hexdump(hci_packet, hci_packet_size);
+    slip_write_unreliable_packet = 1;
+    hci_transport_slip_send_frame_with_dic(buffer, buffer_size);
+
+    // reset inactvitiy timer
+    hci_transport_inactivity_timer_set();
+}
+
+static void hci_transport_link_send_queued_packet(void){
+    uint8_t slot_index = link_slots_next;
+    hci_transport_link_slot_t * slot = &link_slots[(link_slots_head + slot_index) % HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE];
+    uint8_t   seq_nr      = (link_seq_nr + slot_index) & 0x07;
+    uint8_t * buffer      = slot->packet - 4;
+    uint16_t  buffer_size = slot->size   + 4;
+
+    // start resend timer with first packet in flight
+    if (link_slots_sent == 0){
+        hci_transport_link_set_timer(link_resend_timeout_ms);
+    }
+    link_slots_next++;
+    if (link_slots_next > link_slots_sent){
+        link_slots_sent = link_slots_next;
+    }
+
+    // setup header
+    hci_transport_link_calc_header(buffer, seq_nr, link_ack_nr, link_peer_supports_data_integrity_check, 1, slot->type, slot->size);
+
+    // send frame with dic
+    log_debug("send queued packet: seq %u, ack %u, size %u, append dic %u", seq_nr, link_ack_nr, slot->size, link_peer_supports_data_integrity_check);
+    log_debug_hexdump(slot->packet, slot->size);
     hci_transport_slip_send_frame_with_dic(buffer, buffer_size);
 
     // reset inactvitiy timer
@@ -385,11 +447,24 @@ static void hci_transport_link_run(void){
         return;
     }
     if (hci_transport_link_actions & HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET){
-        hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
         // packet already contains ack, no need to send addtitional one
         hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_ACK_PACKET;
-        hci_transport_link_send_queued_packet();
-        return;
+        // unreliable packet first, then all reliable packets within window
+        if (hci_packet != NULL){
+            hci_transport_link_send_unreliable_packet();
+            if (link_slots_next == link_slots_used){
+                hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
+            }
+            return;
+        }
+        if (link_slots_next < link_slots_used){
+            hci_transport_link_send_queued_packet();
+            if (link_slots_next == link_slots_used){
+                hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
+            }
+            return;
+        }
+        hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
     }
     if (hci_transport_link_actions & HCI_TRANSPORT_LINK_SEND_ACK_PACKET){
         hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_ACK_PACKET;
@@ -406,6 +481,7 @@ static void hci_transport_link_run(void){
 }
 
 static void hci_transport_link_set_timer(uint16_t timeout_ms){
+    btstack_run_loop_remove_timer(&link_timer);
     btstack_run_loop_set_timer_handler(&link_timer, &hci_transport_link_timeout_handler);
     btstack_run_loop_set_timer(&link_timer, timeout_ms);
     btstack_run_loop_add_timer(&link_timer);
@@ -431,7 +507,9 @@ static void hci_transport_link_timeout_handler(btstack_timer_source_t * timer){
                 hci_transport_link_set_timer(LINK_WAKEUP_MS);
                 break;
             }
-            // resend packet
+            // resend all unacknowledged packets, starting with the oldest one, as peer drops out-of-sequence packets
+            log_info("resend %u packets from seq nr %u", link_slots_sent, link_seq_nr);
+            link_slots_next = 0;
             hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
             hci_transport_link_set_timer(link_resend_timeout_ms);
             break;
@@ -458,18 +536,92 @@ static int hci_transport_link_inc_seq_nr(int seq_nr){
 }
 
 static int hci_transport_link_have_outgoing_packet(void){
-    return hci_packet != 0;
+    return (hci_packet != NULL) || (link_slots_used > 0);
 }
 
 static void hci_transport_link_clear_queue(void){
     btstack_run_loop_remove_timer(&link_timer);
     hci_packet = NULL;
+    link_slots_head = 0;
+    link_slots_used = 0;
+    link_slots_sent = 0;
+    link_slots_next = 0;
+    link_packet_sent_pending = 0;
+    link_fast_resend_pending = 0;
 }
 
 static void hci_transport_h5_queue_packet(uint8_t packet_type, uint8_t *packet, int size){
-    hci_packet = packet;
-    hci_packet_type = packet_type;
-    hci_packet_size = size;
+    // unreliable packets are sent from HCI buffer
+    if (packet_type == HCI_SCO_DATA_PACKET){
+        hci_packet = packet;
+        hci_packet_type = packet_type;
+        hci_packet_size = size;
+        return;
+    }
+    hci_transport_link_slot_t * slot = &link_slots[(link_slots_head + link_slots_used) % HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE];
+#if HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE > 1
+    // copy packet into slot buffer as HCI packet buffer is released before packet is acknowledged
+    uint8_t * slot_buffer = link_slot_buffers[(link_slots_head + link_slots_used) % HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE];
+    memcpy(&slot_buffer[4], packet, size);
+    slot->packet = &slot_buffer[4];
+#else
+    slot->packet = packet;
+#endif
+    slot->type = packet_type;
+    slot->size = size;
+    link_slots_used++;
+    link_packet_sent_pending = 1;
+}
+
+static void hci_transport_h5_emit_packet_sent(void){
+    uint8_t event[] = { HCI_EVENT_TRANSPORT_PACKET_SENT, 0};
+    packet_handler(HCI_EVENT_PACKET, &event[0], sizeof(event));
+}
+
+// HCI packet buffer can be released as soon as packet is stored in a free slot
+static void hci_transport_h5_emit_packet_sent_if_slot_free(void){
+    if (link_packet_sent_pending == 0) return;
+    if (link_slots_used >= link_window_size) return;
+    link_packet_sent_pending = 0;
+    hci_transport_h5_emit_packet_sent();
+}
+
+// ack_nr is the next seq nr expected by peer and acknowledges all packets before
+static void hci_transport_link_process_ack(uint8_t ack_nr, int pure_ack){
+    uint8_t num_acked = (ack_nr - link_seq_nr) & 0x07;
+    if (num_acked == 0){
+        // peer drops out-of-sequence packets and acks each with the seq nr it expects. a duplicate ack while
+        // later packets are in flight indicates that the oldest one got lost: resend once without waiting for timeout
+        if (pure_ack && (link_slots_sent > 1) && (link_fast_resend_pending == 0)){
+            log_info("duplicate ack %u, resend %u packets", ack_nr, link_slots_sent);
+            link_fast_resend_pending = 1;
+            link_slots_next = 0;
+            hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
+            hci_transport_link_set_timer(link_resend_timeout_ms);
+        }
+        return;
+    }
+    if (num_acked > link_slots_sent){
+        log_info("ack nr %u for packet not sent yet, seq nr %u, sent %u", ack_nr, link_seq_nr, link_slots_sent);
+        return;
+    }
+    log_debug("outgoing packets with seq %u..%u ack'ed", link_seq_nr, (ack_nr - 1) & 0x07);
+    link_fast_resend_pending = 0;
+    link_seq_nr      = ack_nr;
+    link_slots_head  = (link_slots_head + num_acked) % HCI_TRANSPORT_H5_SLIDING_WINDOW_SIZE;
+    link_slots_used -= num_acked;
+    link_slots_sent -= num_acked;
+    link_slots_next  = (link_slots_next > num_acked) ? (link_slots_next - num_acked) : 0;
+
+    // restart resend timer for remaining packets in flight
+    if (link_slots_sent > 0){
+        hci_transport_link_set_timer(link_resend_timeout_ms);
+    } else {
+        btstack_run_loop_remove_timer(&link_timer);
+    }
+
+    // notify upper stack that it can send again
+    hci_transport_h5_emit_packet_sent_if_slot_free();
 }
 
 static void hci_transport_h5_emit_sleep_state(int sleep_active){
@@ -577,7 +729,8 @@ static void hci_transport_h5_process_frame(uint16_t frame_size){
             if (memcmp(slip_payload, link_control_config_response, link_control_config_response_prefix_len) == 0){
                 uint8_t config = slip_payload[2];
                 link_peer_supports_data_integrity_check = (config & 0x10) != 0;
-                log_info("link received config response 0x%02x, data integrity check supported %u", config, link_peer_supports_data_integrity_check);
+                link_window_size = btstack_min(btstack_max(config & 0x07, 1), LINK_CONFIG_SLIDING_WINDOW_SIZE);
+                log_info("link received config response 0x%02x, data integrity check supported %u, sliding window %u", config, link_peer_supports_data_integrity_check, link_window_size);
                 link_state = LINK_ACTIVE;
                 btstack_run_loop_remove_timer(&link_timer);
                 log_info("link activated");
@@ -585,8 +738,7 @@ static void hci_transport_h5_process_frame(uint16_t frame_size){
                 link_seq_nr = 0;
                 link_ack_nr = 0;
                 // notify upper stack that it can start
-                uint8_t event[] = { HCI_EVENT_TRANSPORT_PACKET_SENT, 0};
-                packet_handler(HCI_EVENT_PACKET, &event[0], sizeof(event));
+                hci_transport_h5_emit_packet_sent();
                 break;
             }
             break;
@@ -606,17 +758,7 @@ static void hci_transport_h5_process_frame(uint16_t frame_size){
 
             // Process ACKs in reliable packet and explicit ack packets
             if (reliable_packet || link_packet_type == LINK_ACKNOWLEDGEMENT_TYPE){
-                // our packet is good if the remote expects our seq nr + 1
-                int next_seq_nr = hci_transport_link_inc_seq_nr(link_seq_nr);
-                if (hci_transport_link_have_outgoing_packet() && next_seq_nr == ack_nr){
-                    log_debug("outoing packet with seq %u ack'ed", link_seq_nr);
-                    link_seq_nr = next_seq_nr;
-                    hci_transport_link_clear_queue();
-
-                    // notify upper stack that it can send again
-                    uint8_t event[] = { HCI_EVENT_TRANSPORT_PACKET_SENT, 0};
-                    packet_handler(HCI_EVENT_PACKET, &event[0], sizeof(event));
-                }
+                hci_transport_link_process_ack(ack_nr, link_packet_type == LINK_ACKNOWLEDGEMENT_TYPE);
             } 
 
             switch (link_packet_type){
@@ -734,13 +876,16 @@ static void hci_transport_h5_frame_sent(void){
     }
 
     // SCO packets are sent as unreliable, so we're done now
-    if (hci_packet_type == HCI_SCO_DATA_PACKET){
-        hci_transport_link_clear_queue();
+    if (slip_write_unreliable_packet){
+        slip_write_unreliable_packet = 0;
+        hci_packet = NULL;
         // notify upper stack that it can send again
-        uint8_t event[] = { HCI_EVENT_TRANSPORT_PACKET_SENT, 0};
-        packet_handler(HCI_EVENT_PACKET, &event[0], sizeof(event));
+        hci_transport_h5_emit_packet_sent();
     }
 
+    // reliable packet stored in free slot
+    hci_transport_h5_emit_packet_sent_if_slot_free();
+
     hci_transport_link_run();
 }
 
@@ -814,9 +959,11 @@ static void hci_transport_h5_register_packet_handler(void (*handler)(uint8_t pac
 }
 
 static int hci_transport_h5_can_send_packet_now(uint8_t packet_type){
-    int res = !hci_transport_link_have_outgoing_packet() && link_state == LINK_ACTIVE;
-    // log_info("can_send_packet_now: %u", res);
-    return res;
+    if (link_state != LINK_ACTIVE) return 0;
+    if (link_packet_sent_pending) return 0;
+    if (hci_packet != NULL) return 0;
+    if (packet_type == HCI_SCO_DATA_PACKET) return 1;
+    return link_slots_used < link_window_size;
 }
 
 static int hci_transport_h5_send_packet(uint8_t packet_type, uint8_t *packet, int size){
@@ -839,7 +986,6 @@ static int hci_transport_h5_send_packet(uint8_t packet_type, uint8_t *packet, in
         hci_transport_link_set_timer(LINK_WAKEUP_MS);
     } else {
         hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
-        hci_transport_link_set_timer(link_resend_timeout_ms);
     }
     hci_transport_link_run();
     return 0;
@@ -172,7 +172,7 @@ static void l2cap_emit_channel_opened(l2cap_channel_t *channel, uint8_t status);
 static void l2cap_emit_channel_closed(l2cap_channel_t *channel);
 static void l2cap_emit_incoming_connection(l2cap_channel_t *channel);
 static int  l2cap_channel_ready_for_open(l2cap_channel_t *channel);
-static uint8_t l2cap_classic_send(l2cap_channel_t * channel, const uint8_t *data, uint16_t len);
+static uint8_t l2cap_classic_send(l2cap_channel_t * channel, const btstack_iovec_t * iov, uint8_t iovcnt, uint16_t len);
 #endif
 #ifdef ENABLE_L2CAP_LE_CREDIT_BASED_FLOW_CONTROL_MODE
 static void l2cap_cbm_emit_channel_opened(l2cap_channel_t *channel, uint8_t status);
@@ -182,7 +182,7 @@ static void l2cap_cbm_finialize_channel_close(l2cap_channel_t *channel);
 static inline l2cap_service_t * l2cap_cbm_get_service(uint16_t le_psm);
 #endif
 #ifdef L2CAP_USES_CREDIT_BASED_CHANNELS
-static uint8_t l2cap_credit_based_send_data(l2cap_channel_t * channel, const uint8_t * data, uint16_t size);
+static uint8_t l2cap_credit_based_send_data(l2cap_channel_t * channel, const btstack_iovec_t * iov, uint8_t iovcnt, uint16_t size);
 static void l2cap_credit_based_send_pdu(l2cap_channel_t *channel);
 static void l2cap_credit_based_send_credits(l2cap_channel_t *channel);
 static bool l2cap_credit_based_handle_credit_indication(hci_con_handle_t handle, const uint8_t * command, uint16_t len);
@@ -430,7 +430,8 @@ static int l2cap_ertm_send_information_frame(l2cap_channel_t * channel, int inde
     return l2cap_send_prepared(channel->local_cid, 2 + tx_state->len);
 }
 
-static void l2cap_ertm_store_fragment(l2cap_channel_t * channel, l2cap_segmentation_and_reassembly_t sar, uint16_t sdu_length, const uint8_t * data, uint16_t len){
+static void l2cap_ertm_store_fragment(l2cap_channel_t * channel, l2cap_segmentation_and_reassembly_t sar, uint16_t sdu_length,
+                                      const btstack_iovec_t * iov, uint8_t iovcnt, uint16_t offset, uint16_t len){
     // get next index for storing packets
     int index = channel->tx_write_index;
 
@@ -446,7 +447,7 @@ static void l2cap_ertm_store_fragment(l2cap_channel_t * channel, l2cap_segmentat
         little_endian_store_16(tx_packet, 0, sdu_length);
         pos += 2;
     }
-    (void)memcpy(&tx_packet[pos], data, len);
+    (void) btstack_iovec_copy(iov, iovcnt, offset, &tx_packet[pos], len);
     tx_state->len = pos + len;
 
     // update
@@ -458,7 +459,7 @@ static void l2cap_ertm_store_fragment(l2cap_channel_t * channel, l2cap_segmentat
 
 }
 
-static uint8_t l2cap_ertm_send(l2cap_channel_t * channel, const uint8_t * data, uint16_t len){
+static uint8_t l2cap_ertm_send(l2cap_channel_t * channel, const btstack_iovec_t * iov, uint8_t iovcnt, uint16_t len){
     if (len > channel->remote_mtu){
         log_error("l2cap_ertm_send cid 0x%02x, data length exceeds remote MTU.", channel->local_cid);
         return L2CAP_DATA_LEN_EXCEEDS_REMOTE_MTU;
@@ -475,11 +476,12 @@ static uint8_t l2cap_ertm_send(l2cap_channel_t * channel, const uint8_t * data,
         // fragmentation needed.
         l2cap_segmentation_and_reassembly_t sar =  L2CAP_SEGMENTATION_AND_REASSEMBLY_START_OF_L2CAP_SDU;
         uint16_t chunk_len = 0;
+        uint16_t offset = 0;
         while (len){
             switch (sar){
                 case L2CAP_SEGMENTATION_AND_REASSEMBLY_START_OF_L2CAP_SDU:
                     chunk_len = effective_mps - 2;    // sdu_length
-                    l2cap_ertm_store_fragment(channel, sar, len, data, chunk_len);
+                    l2cap_ertm_store_fragment(channel, sar, len, iov, iovcnt, offset, chunk_len);
                     sar = L2CAP_SEGMENTATION_AND_REASSEMBLY_CONTINUATION_OF_L2CAP_SDU;
                     break;
                 case L2CAP_SEGMENTATION_AND_REASSEMBLY_CONTINUATION_OF_L2CAP_SDU:
@@ -488,18 +490,18 @@ static uint8_t l2cap_ertm_send(l2cap_channel_t * channel, const uint8_t * data,
                         sar = L2CAP_SEGMENTATION_AND_REASSEMBLY_END_OF_L2CAP_SDU; 
                         chunk_len = len;                       
                     }
-                    l2cap_ertm_store_fragment(channel, sar, len, data, chunk_len);
+                    l2cap_ertm_store_fragment(channel, sar, len, iov, iovcnt, offset, chunk_len);
                     break;
                 default:
                     btstack_unreachable();
                     break;
             }
-            len  -= chunk_len;
-            data += chunk_len;
+            len    -= chunk_len;
+            offset += chunk_len;
         }
 
     } else {
-        l2cap_ertm_store_fragment(channel, L2CAP_SEGMENTATION_AND_REASSEMBLY_UNSEGMENTED_L2CAP_SDU, 0, data, len);
+        l2cap_ertm_store_fragment(channel, L2CAP_SEGMENTATION_AND_REASSEMBLY_UNSEGMENTED_L2CAP_SDU, 0, iov, iovcnt, 0, len);
     }
 
     // try to send
@@ -1097,7 +1099,21 @@ uint8_t l2cap_send_prepared_connectionless(hci_con_handle_t con_handle, uint16_t
 
 // assumption - only on LE connections
 uint8_t l2cap_send_connectionless(hci_con_handle_t con_handle, uint16_t cid, uint8_t *data, uint16_t len){
-    
+    btstack_iovec_t iov;
+    iov.data = data;
+    iov.len  = len;
+    return l2cap_send_connectionless_iovec(con_handle, cid, &iov, 1);
+}
+
+// assumption - only on LE connections
+uint8_t l2cap_send_connectionless_iovec(hci_con_handle_t con_handle, uint16_t cid, const btstack_iovec_t * iov, uint8_t iovcnt){
+
+    uint32_t len = btstack_iovec_get_total_len(iov, iovcnt);
+    if (len > l2cap_max_mtu()){
+        log_error("l2cap_send_connectionless cid 0x%02x, data length exceeds MTU", cid);
+        return L2CAP_DATA_LEN_EXCEEDS_REMOTE_MTU;
+    }
+
     if (!hci_can_send_acl_packet_now(con_handle)){
         log_info("l2cap_send cid 0x%02x, cannot send", cid);
         return BTSTACK_ACL_BUFFERS_FULL;
@@ -1106,9 +1122,10 @@ uint8_t l2cap_send_connectionless(hci_con_handle_t con_handle, uint16_t cid, uin
     hci_reserve_packet_buffer();
     uint8_t *acl_buffer = hci_get_outgoing_packet_buffer();
     
-    (void)memcpy(&acl_buffer[8], data, len);
+    // gather data behind L2CAP header
+    (void) btstack_iovec_copy(iov, iovcnt, 0, &acl_buffer[8], (uint16_t) len);
     
-    return l2cap_send_prepared_connectionless(con_handle, cid, len);
+    return l2cap_send_prepared_connectionless(con_handle, cid, (uint16_t) len);
 }
 
 static void l2cap_emit_can_send_now(btstack_packet_handler_t packet_handler, uint16_t channel) {
@@ -1318,11 +1335,11 @@ bool l2cap_can_send_packet_now(uint16_t local_cid){
             return hci_can_send_acl_packet_now(channel->con_handle);
 #ifdef ENABLE_L2CAP_LE_CREDIT_BASED_FLOW_CONTROL_MODE
         case L2CAP_CHANNEL_TYPE_CHANNEL_CBM:
-            return channel->send_sdu_buffer == NULL;
+            return channel->send_sdu_iovcnt == 0u;
 #endif
 #ifdef ENABLE_L2CAP_ENHANCED_CREDIT_BASED_FLOW_CONTROL_MODE
         case L2CAP_CHANNEL_TYPE_CHANNEL_ECBM:
-            return channel->send_sdu_buffer == NULL;
+            return channel->send_sdu_iovcnt == 0u;
 #endif
         default:
             return false;
@@ -1330,23 +1347,39 @@ bool l2cap_can_send_packet_now(uint16_t local_cid){
 }
 
 uint8_t l2cap_send(uint16_t local_cid, const uint8_t *data, uint16_t len){
+    btstack_iovec_t iov;
+    iov.data = data;
+    iov.len  = len;
+    return l2cap_send_iovec(local_cid, &iov, 1);
+}
+
+uint8_t l2cap_send_iovec(uint16_t local_cid, const btstack_iovec_t * iov, uint8_t iovcnt){
     l2cap_channel_t * channel = l2cap_get_channel_for_local_cid(local_cid);
     if (!channel) {
         log_error("l2cap_send no channel for cid 0x%02x", local_cid);
         return L2CAP_LOCAL_CID_DOES_NOT_EXIST;
     }
+    if ((iovcnt == 0u) || (iovcnt > L2CAP_MAX_NUM_IOVEC)){
+        log_error("l2cap_send cid 0x%02x, invalid number of buffers %u", local_cid, iovcnt);
+        return ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS;
+    }
+    uint32_t len = btstack_iovec_get_total_len(iov, iovcnt);
+    if (len > 0xffffu){
+        log_error("l2cap_send cid 0x%02x, data length exceeds remote MTU.", local_cid);
+        return L2CAP_DATA_LEN_EXCEEDS_REMOTE_MTU;
+    }
     switch (channel->channel_type){
 #ifdef ENABLE_CLASSIC
         case L2CAP_CHANNEL_TYPE_CLASSIC:
-            return l2cap_classic_send(channel, data, len);
+            return l2cap_classic_send(channel, iov, iovcnt, (uint16_t) len);
 #endif
 #ifdef ENABLE_L2CAP_LE_CREDIT_BASED_FLOW_CONTROL_MODE
         case L2CAP_CHANNEL_TYPE_CHANNEL_CBM:
-            return l2cap_credit_based_send_data(channel, data, len);
+            return l2cap_credit_based_send_data(channel, iov, iovcnt, (uint16_t) len);
 #endif
 #ifdef ENABLE_L2CAP_ENHANCED_CREDIT_BASED_FLOW_CONTROL_MODE
         case L2CAP_CHANNEL_TYPE_CHANNEL_ECBM:
-            return l2cap_credit_based_send_data(channel, data, len);
+            return l2cap_credit_based_send_data(channel, iov, iovcnt, (uint16_t) len);
 #endif
         default:
             return ERROR_CODE_UNSPECIFIED_ERROR;
@@ -1533,12 +1566,12 @@ uint8_t l2cap_send_prepared(uint16_t local_cid, uint16_t len){
 }
 
 // assumption - only on Classic connections
-static uint8_t l2cap_classic_send(l2cap_channel_t * channel, const uint8_t *data, uint16_t len){
+static uint8_t l2cap_classic_send(l2cap_channel_t * channel, const btstack_iovec_t * iov, uint8_t iovcnt, uint16_t len){
 
 #ifdef ENABLE_L2CAP_ENHANCED_RETRANSMISSION_MODE
     // send in ERTM
     if (channel->mode == L2CAP_CHANNEL_MODE_ENHANCED_RETRANSMISSION){
-        return l2cap_ertm_send(channel, data, len);
+        return l2cap_ertm_send(channel, iov, iovcnt, len);
     }
 #endif
 
@@ -1554,7 +1587,7 @@ static uint8_t l2cap_classic_send(l2cap_channel_t * channel, const uint8_t *data
 
     hci_reserve_packet_buffer();
     uint8_t *acl_buffer = hci_get_outgoing_packet_buffer();
-    (void)memcpy(&acl_buffer[8], data, len);
+    (void) btstack_iovec_copy(iov, iovcnt, 0, &acl_buffer[8], len);
     return l2cap_send_prepared(channel->local_cid, len);
 }
 
@@ -2367,6 +2400,8 @@ static void l2cap_run(void){
             case CON_PARAMETER_UPDATE_SEND_RESPONSE:
                 connection->le_con_parameter_update_state = CON_PARAMETER_UPDATE_CHANGE_HCI_CON_PARAMETERS;
                 l2cap_send_le_signaling_packet(connection->con_handle, CONNECTION_PARAMETER_UPDATE_RESPONSE, connection->le_con_param_update_identifier, 0);
+                // HCI LE Connection Update is sent by hci_run for this connection
+                hci_request_connection_run(connection);
                 break;
             case CON_PARAMETER_UPDATE_DENY:
                 connection->le_con_parameter_update_state = CON_PARAMETER_UPDATE_NONE;
@@ -2670,7 +2705,7 @@ static bool l2cap_channel_ready_to_send(l2cap_channel_t * channel){
 #ifdef ENABLE_L2CAP_LE_CREDIT_BASED_FLOW_CONTROL_MODE
         case L2CAP_CHANNEL_TYPE_CHANNEL_CBM:
             if (channel->state != L2CAP_STATE_OPEN) return false;
-            if (channel->send_sdu_buffer == NULL) return false;
+            if (channel->send_sdu_iovcnt == 0u) return false;
             if (channel->credits_outgoing == 0u) return false;
             return hci_can_send_acl_packet_now(channel->con_handle);
 #endif
@@ -2678,7 +2713,7 @@ static bool l2cap_channel_ready_to_send(l2cap_channel_t * channel){
 #ifdef ENABLE_L2CAP_ENHANCED_CREDIT_BASED_FLOW_CONTROL_MODE
         case L2CAP_CHANNEL_TYPE_CHANNEL_ECBM:
             if (channel->state != L2CAP_STATE_OPEN) return false;
-            if (channel->send_sdu_buffer == NULL) return false;
+            if (channel->send_sdu_iovcnt == 0u) return false;
             if (channel->credits_outgoing == 0u) return false;
             return hci_can_send_acl_packet_now(channel->con_handle);
 #endif
@@ -5050,7 +5085,7 @@ uint8_t l2cap_unregister_service(uint16_t psm){
 
 static void l2cap_credit_based_send_pdu(l2cap_channel_t *channel) {
     btstack_assert(channel != NULL);
-    btstack_assert(channel->send_sdu_buffer != NULL);
+    btstack_assert(channel->send_sdu_iovcnt > 0u);
     btstack_assert(channel->credits_outgoing > 0);
 
     // send part of SDU
@@ -5067,9 +5102,9 @@ static void l2cap_credit_based_send_pdu(l2cap_channel_t *channel) {
     uint16_t payload_size = btstack_min(channel->send_sdu_len + 2u - channel->send_sdu_pos, channel->remote_mps - pos);
     log_info("len %u, pos %u => payload %u, credits %u", channel->send_sdu_len, channel->send_sdu_pos, payload_size,
              channel->credits_outgoing);
-    (void) memcpy(&l2cap_payload[pos],
-                  &channel->send_sdu_buffer[channel->send_sdu_pos - 2u],
-                  payload_size); // -2 for virtual SDU len
+    (void) btstack_iovec_copy(channel->send_sdu_iov, channel->send_sdu_iovcnt,
+                              channel->send_sdu_pos - 2u, &l2cap_payload[pos],
+                              payload_size); // -2 for virtual SDU len
     pos += payload_size;
     channel->send_sdu_pos += payload_size;
     l2cap_setup_header(acl_buffer, channel->con_handle, 0, channel->remote_cid, pos);
@@ -5079,7 +5114,7 @@ static void l2cap_credit_based_send_pdu(l2cap_channel_t *channel) {
     // update state (mark SDU as done) before calling hci_send_acl_packet_buffer (trigger l2cap_le_send_pdu again)
     bool done = channel->send_sdu_pos >= (channel->send_sdu_len + 2u);
     if (done) {
-        channel->send_sdu_buffer = NULL;
+        channel->send_sdu_iovcnt = 0;
     }
 
     hci_send_acl_packet_buffer(8u + pos);
@@ -5092,19 +5127,21 @@ static void l2cap_credit_based_send_pdu(l2cap_channel_t *channel) {
     }
 }
 
-static uint8_t l2cap_credit_based_send_data(l2cap_channel_t * channel, const uint8_t * data, uint16_t size){
+static uint8_t l2cap_credit_based_send_data(l2cap_channel_t * channel, const btstack_iovec_t * iov, uint8_t iovcnt, uint16_t size){
 
     if (size > channel->remote_mtu){
         log_error("l2cap send, cid 0x%02x, data length exceeds remote MTU.", channel->local_cid);
         return L2CAP_DATA_LEN_EXCEEDS_REMOTE_MTU;
     }
 
-    if (channel->send_sdu_buffer){
+    if (channel->send_sdu_iovcnt > 0u){
         log_info("l2cap send, cid 0x%02x, cannot send", channel->local_cid);
         return BTSTACK_ACL_BUFFERS_FULL;
     }
 
-    channel->send_sdu_buffer = data;
+    // store buffer descriptors, data is gathered into outgoing buffer for each PDU
+    (void) memcpy(channel->send_sdu_iov, iov, iovcnt * sizeof(btstack_iovec_t));
+    channel->send_sdu_iovcnt = iovcnt;
     channel->send_sdu_len    = size;
     channel->send_sdu_pos    = 0;
 
@@ -5244,7 +5281,7 @@ static void l2cap_credit_based_handle_pdu(l2cap_channel_t * l2cap_channel, const
 
 static void l2cap_credit_based_notify_channel_can_send(l2cap_channel_t *channel){
     if (!channel->waiting_for_can_send_now) return;
-    if (channel->send_sdu_buffer) return;
+    if (channel->send_sdu_iovcnt > 0u) return;
     channel->waiting_for_can_send_now = 0;
     log_debug("le can send now, local_cid 0x%x", channel->local_cid);
     l2cap_emit_simple_event_with_cid(channel, L2CAP_EVENT_CAN_SEND_NOW);
@@ -68,6 +68,15 @@ extern "C" {
 
 #define L2CAP_LE_AUTOMATIC_CREDITS 0xffff
 
+// max number of buffers gathered into a single L2CAP SDU by l2cap_send_iovec
+#ifndef L2CAP_MAX_NUM_IOVEC
+#define L2CAP_MAX_NUM_IOVEC 3
+#endif
+
+#if L2CAP_MAX_NUM_IOVEC < 1
+#error "L2CAP_MAX_NUM_IOVEC must be at least 1"
+#endif
+
 // private structs
 typedef enum {
     L2CAP_STATE_CLOSED = 1,           // no baseband
@@ -264,8 +273,9 @@ typedef struct {
     uint16_t  renegotiate_mtu;
 #endif
 
-    // outgoing SDU
-    const uint8_t * send_sdu_buffer;
+    // outgoing SDU, gathered from send_sdu_iovcnt buffers - send_sdu_iovcnt == 0 if no SDU pending
+    btstack_iovec_t send_sdu_iov[L2CAP_MAX_NUM_IOVEC];
+    uint8_t    send_sdu_iovcnt;
     uint16_t   send_sdu_len;
     uint16_t   send_sdu_pos;
 
@@ -438,6 +448,7 @@ bool l2cap_can_send_fixed_channel_packet_now(hci_con_handle_t con_handle, uint16
 void l2cap_request_can_send_fix_channel_now_event(hci_con_handle_t con_handle, uint16_t channel_id);
 uint8_t l2cap_send_connectionless(hci_con_handle_t con_handle, uint16_t cid, uint8_t *data, uint16_t len);
 uint8_t l2cap_send_prepared_connectionless(hci_con_handle_t con_handle, uint16_t cid, uint16_t len);
+uint8_t l2cap_send_connectionless_iovec(hci_con_handle_t con_handle, uint16_t cid, const btstack_iovec_t * iov, uint8_t iovcnt);
 
 // PTS Testing
 int l2cap_send_echo_request(hci_con_handle_t con_handle, uint8_t *data, uint16_t len);
@@ -523,6 +534,17 @@ uint16_t l2cap_get_remote_mtu_for_local_cid(uint16_t local_cid);
  */
 uint8_t l2cap_send(uint16_t local_cid, const uint8_t *data, uint16_t len);
 
+/**
+ * @brief Sends L2CAP data packet gathered from multiple buffers, e.g. protocol header and payload, to the channel with given identifier.
+ *        Data is copied once into the outgoing HCI buffer (Basic, Credit-Based) or the ERTM tx buffers
+ * @note For channel in credit-based flow control mode, buffers need to stay valid until L2CAP_EVENT_PACKET_SENT, buffer descriptors are copied
+ * @param local_cid
+ * @param iov buffer descriptors
+ * @param iovcnt number of buffer descriptors, max L2CAP_MAX_NUM_IOVEC
+ * @return status
+ */
+uint8_t l2cap_send_iovec(uint16_t local_cid, const btstack_iovec_t * iov, uint8_t iovcnt);
+
 /** 
  * @brief Registers L2CAP service with given PSM and MTU, and assigns a packet handler. 
  * @param packet_handler
@@ -66,6 +66,35 @@
 // num adv bearer message types
 #define NUM_TYPES 3
 
+// number of queued adv bearer messages
+#ifndef MESH_ADV_BEARER_QUEUE_SIZE
+#define MESH_ADV_BEARER_QUEUE_SIZE 8
+#endif
+
+#if MESH_ADV_BEARER_QUEUE_SIZE < 1
+#error "MESH_ADV_BEARER_QUEUE_SIZE must be at least 1"
+#endif
+
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+// number of advertising sets used in parallel for adv bearer messages if supported by Controller
+#ifndef MESH_ADV_BEARER_NUM_ADVERTISING_SETS
+#define MESH_ADV_BEARER_NUM_ADVERTISING_SETS 4
+#endif
+
+#if MESH_ADV_BEARER_NUM_ADVERTISING_SETS < 1
+#error "MESH_ADV_BEARER_NUM_ADVERTISING_SETS must be at least 1"
+#endif
+
+// min advertising interval 20 ms for non-connectable advertisements (5.0 controllers)
+#define ADVERTISING_INTERVAL_EXTENDED_NONCONNECTABLE_MIN 0x20
+
+// legacy PDU, non-connectable and non-scannable undirected (ADV_NONCONN_IND)
+#define ADVERTISING_EVENT_PROPERTIES_LEGACY_NONCONNECTABLE 0x10
+
+// advertising event limit reached
+#define ADVERTISING_SET_TERMINATED_LIMIT_REACHED 0x43
+#endif
+
 typedef enum {
     MESH_NETWORK_ID,
     MESH_BEACON_ID,
@@ -79,9 +108,35 @@ typedef enum {
     STATE_GAP,
 } state_t;
 
+// queued adv bearer message
+typedef struct {
+    btstack_linked_item_t item;
+    uint32_t queued_ms;
+    // advertising interval in 0.625 ms units
+    uint16_t interval;
+    // remaining transmissions
+    uint8_t  count;
+    uint8_t  data_len;
+    uint8_t  data[31];
+} adv_bearer_pdu_t;
+
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+typedef struct {
+    le_advertising_set_t le_advertising_set;
+    // message being advertised, NULL if idle
+    adv_bearer_pdu_t *   pdu;
+    // configured advertising interval in 0.625 ms units
+    uint16_t             interval;
+    uint8_t              advertising_handle;
+    // parameters rejected by Controller, e.g. if it supports fewer advertising sets
+    bool                 failed;
+} adv_bearer_advertising_set_t;
+#endif
+
 
 // prototypes
 static void adv_bearer_run(void);
+static void adv_bearer_emit_can_send_now(void);
 
 // globals
 
@@ -98,11 +153,30 @@ static int last_sender;
 static state_t    adv_bearer_state;
 static uint32_t   gap_adv_next_ms;
 
-// adv bearer packets
-static uint8_t   adv_bearer_buffer[31];
-static uint8_t   adv_bearer_buffer_length;
-static uint8_t   adv_bearer_count;
-static uint16_t  adv_bearer_interval;
+// adv bearer packets, queued by message type and sent in order of priority
+static adv_bearer_pdu_t      adv_bearer_pdu_storage[MESH_ADV_BEARER_QUEUE_SIZE];
+static btstack_linked_list_t adv_bearer_pdus_free;
+static btstack_linked_list_t adv_bearer_queues[NUM_TYPES];
+static const message_type_id_t adv_bearer_priorities[NUM_TYPES] = { PB_ADV_ID, MESH_NETWORK_ID, MESH_BEACON_ID };
+static int                   adv_bearer_emitting_can_send_now;
+
+// message sent with legacy advertising
+static adv_bearer_pdu_t *    adv_bearer_current_pdu;
+
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+// messages sent in parallel with extended advertising sets
+static adv_bearer_advertising_set_t adv_bearer_advertising_sets[MESH_ADV_BEARER_NUM_ADVERTISING_SETS];
+static int                          adv_bearer_advertising_sets_ready;
+// sets registered with HCI, HCI installs them again after Controller reset
+static uint8_t                      adv_bearer_advertising_sets_num;
+static uint8_t                      adv_bearer_advertising_sets_num_failed;
+#endif
+
+// statistics
+static adv_bearer_statistics_t adv_bearer_statistics;
+static uint32_t                adv_bearer_statistics_start_ms;
+static uint32_t                adv_bearer_statistics_latency_sum_ms;
+static uint32_t                adv_bearer_statistics_num_started;
 
 // gap advertising
 static int       gap_advertising_enabled;
@@ -117,6 +191,209 @@ static uint8_t   gap_filter_policy  = 0;
 
 static btstack_linked_list_t gap_connectable_advertisements;
 
+// queue
+
+static void adv_bearer_queue_init(void){
+    adv_bearer_pdus_free = NULL;
+    uint16_t i;
+    for (i = 0; i < MESH_ADV_BEARER_QUEUE_SIZE; i++){
+        btstack_linked_list_add(&adv_bearer_pdus_free, (btstack_linked_item_t *) &adv_bearer_pdu_storage[i]);
+    }
+    for (i = 0; i < NUM_TYPES; i++){
+        adv_bearer_queues[i] = NULL;
+    }
+}
+
+static adv_bearer_pdu_t * adv_bearer_queue_pop(void){
+    uint8_t i;
+    for (i = 0; i < NUM_TYPES; i++){
+        adv_bearer_pdu_t * pdu = (adv_bearer_pdu_t *) btstack_linked_list_pop(&adv_bearer_queues[adv_bearer_priorities[i]]);
+        if (pdu != NULL) return pdu;
+    }
+    return NULL;
+}
+
+static void adv_bearer_pdu_started(adv_bearer_pdu_t * pdu){
+    uint32_t latency_ms = btstack_run_loop_get_time_ms() - pdu->queued_ms;
+    adv_bearer_statistics_latency_sum_ms += latency_ms;
+    adv_bearer_statistics_num_started++;
+    adv_bearer_statistics.queue_latency_max_ms = btstack_max(adv_bearer_statistics.queue_latency_max_ms, latency_ms);
+}
+
+static void adv_bearer_pdu_done(adv_bearer_pdu_t * pdu){
+    adv_bearer_statistics.pdus_sent++;
+    btstack_linked_list_add(&adv_bearer_pdus_free, (btstack_linked_item_t *) pdu);
+}
+
+static void adv_bearer_pdu_dropped(adv_bearer_pdu_t * pdu){
+    adv_bearer_statistics.pdus_dropped++;
+    btstack_linked_list_add(&adv_bearer_pdus_free, (btstack_linked_item_t *) pdu);
+}
+
+static bool adv_bearer_advertising_sets_active(void){
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+    if (adv_bearer_advertising_sets_ready == 0) return false;
+    return adv_bearer_advertising_sets_num_failed < adv_bearer_advertising_sets_num;
+#else
+    return false;
+#endif
+}
+
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+
+static void adv_bearer_setup_advertising_sets(void){
+    if (adv_bearer_advertising_sets_ready) return;
+    if (gap_extended_advertising_supported() == false) return;
+
+    // use own address type configured via gap_random_address_set_mode, as legacy advertising does
+    uint8_t   own_address_type;
+    bd_addr_t own_address;
+    gap_le_get_own_address(&own_address_type, own_address);
+
+    le_extended_advertising_parameters_t params;
+    memset(&params, 0, sizeof(params));
+    params.advertising_event_properties     = ADVERTISING_EVENT_PROPERTIES_LEGACY_NONCONNECTABLE;
+    params.primary_advertising_interval_min = ADVERTISING_INTERVAL_EXTENDED_NONCONNECTABLE_MIN;
+    params.primary_advertising_interval_max = ADVERTISING_INTERVAL_EXTENDED_NONCONNECTABLE_MIN;
+    params.primary_advertising_channel_map  = 0x07;
+    params.own_address_type                 = own_address_type;
+    params.advertising_tx_power             = 127;  // no preference
+    params.primary_advertising_phy          = 1;    // LE 1M
+    params.secondary_advertising_phy        = 1;    // LE 1M
+
+    uint8_t i;
+    if (adv_bearer_advertising_sets_num == 0){
+        for (i = 0; i < MESH_ADV_BEARER_NUM_ADVERTISING_SETS; i++){
+            adv_bearer_advertising_set_t * advertising_set = &adv_bearer_advertising_sets[i];
+            uint8_t status = gap_extended_advertising_setup(&advertising_set->le_advertising_set, &params, &advertising_set->advertising_handle);
+            if (status != ERROR_CODE_SUCCESS){
+                log_error("Setup advertising set %u failed, status 0x%02x", i, status);
+                break;
+            }
+            adv_bearer_advertising_sets_num++;
+        }
+    } else {
+        // already registered, own address type might have changed since
+        for (i = 0; i < adv_bearer_advertising_sets_num; i++){
+            gap_extended_advertising_set_params(adv_bearer_advertising_sets[i].advertising_handle, &params);
+        }
+    }
+    if (adv_bearer_advertising_sets_num == 0) return;
+
+    for (i = 0; i < adv_bearer_advertising_sets_num; i++){
+        adv_bearer_advertising_set_t * advertising_set = &adv_bearer_advertising_sets[i];
+        if (own_address_type != BD_ADDR_TYPE_LE_PUBLIC){
+            gap_extended_advertising_set_random_address(advertising_set->advertising_handle, own_address);
+        }
+        advertising_set->interval = ADVERTISING_INTERVAL_EXTENDED_NONCONNECTABLE_MIN;
+        advertising_set->pdu = NULL;
+        advertising_set->failed = false;
+    }
+    adv_bearer_advertising_sets_num_failed = 0;
+    adv_bearer_advertising_sets_ready = 1;
+    log_info("ADV Bearer uses %u advertising sets", adv_bearer_advertising_sets_num);
+}
+
+// HCI not working: messages in advertising sets are lost, sets are setup again when HCI is working
+static void adv_bearer_reset_advertising_sets(void){
+    if (adv_bearer_advertising_sets_ready == 0) return;
+    adv_bearer_advertising_sets_ready = 0;
+    uint8_t i;
+    for (i = 0; i < adv_bearer_advertising_sets_num; i++){
+        adv_bearer_advertising_set_t * advertising_set = &adv_bearer_advertising_sets[i];
+        if (advertising_set->pdu == NULL) continue;
+        gap_extended_advertising_stop(advertising_set->advertising_handle);
+        adv_bearer_pdu_dropped(advertising_set->pdu);
+        advertising_set->pdu = NULL;
+    }
+}
+
+// start queued messages on idle advertising sets, prefer sets that don't need a parameter update
+static void adv_bearer_extended_run(void){
+    while (true){
+        adv_bearer_advertising_set_t * idle_set = NULL;
+        uint8_t i;
+        for (i = 0; i < adv_bearer_advertising_sets_num; i++){
+            if (adv_bearer_advertising_sets[i].pdu != NULL) continue;
+            if (adv_bearer_advertising_sets[i].failed) continue;
+            idle_set = &adv_bearer_advertising_sets[i];
+            break;
+        }
+        if (idle_set == NULL) return;
+
+        adv_bearer_pdu_t * pdu = adv_bearer_queue_pop();
+        if (pdu == NULL) return;
+
+        adv_bearer_advertising_set_t * advertising_set = idle_set;
+        for ( ; i < adv_bearer_advertising_sets_num; i++){
+            if (adv_bearer_advertising_sets[i].pdu != NULL) continue;
+            if (adv_bearer_advertising_sets[i].failed) continue;
+            if (adv_bearer_advertising_sets[i].interval != pdu->interval) continue;
+            advertising_set = &adv_bearer_advertising_sets[i];
+            break;
+        }
+
+        if (advertising_set->interval != pdu->interval){
+            le_extended_advertising_parameters_t params;
+            gap_extended_advertising_get_params(advertising_set->advertising_handle, &params);
+            params.primary_advertising_interval_min = pdu->interval;
+            params.primary_advertising_interval_max = pdu->interval;
+            gap_extended_advertising_set_params(advertising_set->advertising_handle, &params);
+            advertising_set->interval = pdu->interval;
+            adv_bearer_statistics.parameter_updates++;
+        }
+
+        log_debug("Send ADV Bearer message, advertising set %u", advertising_set->advertising_handle);
+        advertising_set->pdu = pdu;
+        adv_bearer_pdu_started(pdu);
+        gap_extended_advertising_set_adv_data(advertising_set->advertising_handle, pdu->data_len, pdu->data);
+        gap_extended_advertising_start(advertising_set->advertising_handle, 0, pdu->count);
+    }
+}
+
+static adv_bearer_advertising_set_t * adv_bearer_advertising_set_for_handle(uint8_t advertising_handle){
+    uint8_t i;
+    for (i = 0; i < adv_bearer_advertising_sets_num; i++){
+        if (adv_bearer_advertising_sets[i].advertising_handle == advertising_handle) return &adv_bearer_advertising_sets[i];
+    }
+    return NULL;
+}
+
+static void adv_bearer_handle_advertising_set_terminated(const uint8_t * packet){
+    uint8_t advertising_handle = hci_subevent_le_advertising_set_terminated_get_advertising_handle(packet);
+    adv_bearer_advertising_set_t * advertising_set = adv_bearer_advertising_set_for_handle(advertising_handle);
+    if (advertising_set == NULL) return;
+    if (advertising_set->pdu == NULL) return;
+    uint8_t status = hci_subevent_le_advertising_set_terminated_get_status(packet);
+    if (status != ADVERTISING_SET_TERMINATED_LIMIT_REACHED){
+        log_info("Advertising set %u terminated, status 0x%02x", advertising_handle, status);
+    }
+    adv_bearer_pdu_done(advertising_set->pdu);
+    advertising_set->pdu = NULL;
+    // let clients queue messages first, so that higher priority ones get the free set
+    adv_bearer_emit_can_send_now();
+    adv_bearer_run();
+}
+
+// set parameters, data or enable command failed, Controller does not terminate set
+static void adv_bearer_handle_advertising_set_error(uint8_t advertising_handle, uint8_t status, bool parameters_rejected){
+    adv_bearer_advertising_set_t * advertising_set = adv_bearer_advertising_set_for_handle(advertising_handle);
+    if (advertising_set == NULL) return;
+    log_error("Advertising set %u command failed, status 0x%02x", advertising_handle, status);
+    if (parameters_rejected && (advertising_set->failed == false)){
+        advertising_set->failed = true;
+        adv_bearer_advertising_sets_num_failed++;
+    }
+    if (advertising_set->pdu != NULL){
+        gap_extended_advertising_stop(advertising_handle);
+        adv_bearer_pdu_dropped(advertising_set->pdu);
+        advertising_set->pdu = NULL;
+    }
+    adv_bearer_emit_can_send_now();
+    adv_bearer_run();
+}
+#endif
+
 // dispatch advertising events
 static void adv_bearer_packet_handler (uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
     const uint8_t * data;
@@ -127,9 +404,38 @@ static void adv_bearer_packet_handler (uint8_t packet_type, uint16_t channel, ui
         case HCI_EVENT_PACKET:
             switch(packet[0]){
                 case BTSTACK_EVENT_STATE:
-                    if (btstack_event_state_get_state(packet) != HCI_STATE_WORKING) break;
+                    if (btstack_event_state_get_state(packet) != HCI_STATE_WORKING) {
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+                        adv_bearer_reset_advertising_sets();
+#endif
+                        break;
+                    }
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+                    adv_bearer_setup_advertising_sets();
+#endif
                     adv_bearer_run();
                     break;
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+                case HCI_EVENT_LE_META:
+                    if (hci_event_le_meta_get_subevent_code(packet) != HCI_SUBEVENT_LE_ADVERTISING_SET_TERMINATED) break;
+                    adv_bearer_handle_advertising_set_terminated(packet);
+                    break;
+                case HCI_EVENT_META_GAP:
+                    switch (hci_event_gap_meta_get_subevent_code(packet)){
+                        case GAP_SUBEVENT_ADVERTISING_SET_INSTALLED:
+                            if (gap_subevent_advertising_set_installed_get_status(packet) == ERROR_CODE_SUCCESS) break;
+                            adv_bearer_handle_advertising_set_error(gap_subevent_advertising_set_installed_get_advertisement_handle(packet),
+                                                                    gap_subevent_advertising_set_installed_get_status(packet), true);
+                            break;
+                        case GAP_SUBEVENT_ADVERTISING_SET_COMMAND_FAILED:
+                            adv_bearer_handle_advertising_set_error(gap_subevent_advertising_set_command_failed_get_advertising_handle(packet),
+                                                                    gap_subevent_advertising_set_command_failed_get_status(packet), false);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+#endif
                 case GAP_EVENT_ADVERTISING_REPORT:
                     // only non-connectable ind
                     if (gap_event_advertising_report_get_advertising_event_type(packet) != 0x03) break;
@@ -174,29 +480,38 @@ static void adv_bearer_packet_handler (uint8_t packet_type, uint16_t channel, ui
     }
 }
 
-// round-robin
+// round-robin, as long as messages can be queued
 static void adv_bearer_emit_can_send_now(void){
 
-    if (adv_bearer_count > 0) return;
-
-    int countdown = NUM_TYPES;
-    while (countdown--) {
-        last_sender++;
-        if (last_sender == NUM_TYPES) {
-            last_sender = 0;
-        }
-        if (request_can_send_now[last_sender]){
-            request_can_send_now[last_sender] = 0;
-            // emit can send now
-            log_debug("can send now");
-            uint8_t event[3];
-            event[0] = HCI_EVENT_MESH_META;
-            event[1] = 1;
-            event[2] = MESH_SUBEVENT_CAN_SEND_NOW;
-            (*client_callbacks[last_sender])(HCI_EVENT_PACKET, 0, &event[0], sizeof(event));
-            return;
+    // clients usually send and request again from the callback, emit from loop instead of recursion
+    if (adv_bearer_emitting_can_send_now) return;
+    adv_bearer_emitting_can_send_now = 1;
+
+    while (btstack_linked_list_empty(&adv_bearer_pdus_free) == false){
+        btstack_linked_item_t * free_pdu = adv_bearer_pdus_free;
+        int countdown = NUM_TYPES;
+        while (countdown--) {
+            last_sender++;
+            if (last_sender == NUM_TYPES) {
+                last_sender = 0;
+            }
+            if (request_can_send_now[last_sender]){
+                request_can_send_now[last_sender] = 0;
+                // emit can send now
+                log_debug("can send now");
+                uint8_t event[3];
+                event[0] = HCI_EVENT_MESH_META;
+                event[1] = 1;
+                event[2] = MESH_SUBEVENT_CAN_SEND_NOW;
+                (*client_callbacks[last_sender])(HCI_EVENT_PACKET, 0, &event[0], sizeof(event));
+                break;
+            }
         }
+        // stop if no message was queued
+        if (adv_bearer_pdus_free == free_pdu) break;
     }
+
+    adv_bearer_emitting_can_send_now = 0;
 }
 
 static void adv_bearer_timeout_handler(btstack_timer_source_t * ts){
@@ -216,11 +531,15 @@ static void adv_bearer_timeout_handler(btstack_timer_source_t * ts){
         case STATE_BEARER:
             log_debug("Timeout (state bearer)");
             gap_advertisements_enable(0);
-            adv_bearer_count--;
-            if (adv_bearer_count == 0){
+            adv_bearer_current_pdu->count--;
+            adv_bearer_state = STATE_IDLE;
+            if (adv_bearer_current_pdu->count == 0){
+                adv_bearer_pdu_done(adv_bearer_current_pdu);
+                adv_bearer_current_pdu = NULL;
                 adv_bearer_emit_can_send_now();
+                adv_bearer_run();
+                return;
             }
-            adv_bearer_state = STATE_IDLE;
             break;
         default:
             break;
@@ -239,6 +558,13 @@ static void adv_bearer_set_timeout(uint32_t time_ms){
 static void adv_bearer_run(void){
 
     if (hci_get_state() != HCI_STATE_WORKING) return;
+
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+    if (adv_bearer_advertising_sets_active()){
+        adv_bearer_extended_run();
+    }
+#endif
+
     if (adv_timer_active) return;
     
     uint32_t now = btstack_run_loop_get_time_ms();
@@ -264,13 +590,19 @@ static void adv_bearer_run(void){
                     }
                 }
             }
-            if (adv_bearer_count > 0){
+            if ((adv_bearer_current_pdu == NULL) && (adv_bearer_advertising_sets_active() == false)){
+                adv_bearer_current_pdu = adv_bearer_queue_pop();
+                if (adv_bearer_current_pdu != NULL){
+                    adv_bearer_pdu_started(adv_bearer_current_pdu);
+                }
+            }
+            if (adv_bearer_current_pdu != NULL){
                 // schedule adv bearer message if enough time
                 // if ((gap_advertising_enabled) == 0 || ((int32_t)(gap_adv_next_ms - now) >= ADVERTISING_INTERVAL_NONCONNECTABLE_MIN_MS)){
                 log_debug("Send ADV Bearer message");
                 // configure LE advertisments: non-conn ind
                 gap_advertisements_set_params(ADVERTISING_INTERVAL_NONCONNECTABLE_MIN, ADVERTISING_INTERVAL_NONCONNECTABLE_MIN, 3, 0, null_addr, 0x07, 0);
-                gap_advertisements_set_data(adv_bearer_buffer_length, adv_bearer_buffer);
+                gap_advertisements_set_data(adv_bearer_current_pdu->data_len, adv_bearer_current_pdu->data);
                 gap_advertisements_enable(1);
                 adv_bearer_state = STATE_BEARER;
                 adv_bearer_set_timeout(ADVERTISING_INTERVAL_NONCONNECTABLE_MIN_MS);
@@ -287,19 +619,35 @@ static void adv_bearer_run(void){
     }
 }
 
-//
-static void adv_bearer_prepare_message(const uint8_t * data, uint16_t data_len, uint8_t type, uint8_t count, uint16_t interval){
-    btstack_assert(data_len <= (sizeof(adv_bearer_buffer)-2));
+// queue message
+static void adv_bearer_prepare_message(message_type_id_t type_id, const uint8_t * data, uint16_t data_len, uint8_t type, uint8_t count, uint16_t interval_ms){
+    btstack_assert(data_len <= (sizeof(adv_bearer_pdu_storage[0].data)-2));
     log_debug("adv bearer message, type 0x%x\n", type);
+
+    adv_bearer_pdu_t * pdu = (adv_bearer_pdu_t *) btstack_linked_list_pop(&adv_bearer_pdus_free);
+    if (pdu == NULL){
+        log_error("adv bearer queue full, drop message type 0x%x", type);
+        adv_bearer_statistics.pdus_dropped++;
+        return;
+    }
+
     // prepare message
-    adv_bearer_buffer[0] = data_len+1;
-    adv_bearer_buffer[1] = type;
-    (void)memcpy(&adv_bearer_buffer[2], data, data_len);
-    adv_bearer_buffer_length = data_len + 2;
+    pdu->data[0] = data_len+1;
+    pdu->data[1] = type;
+    (void)memcpy(&pdu->data[2], data, data_len);
+    pdu->data_len = data_len + 2;
 
     // setup trasmission schedule
-    adv_bearer_count    = count;
-    adv_bearer_interval = interval;
+    pdu->count     = btstack_max(count, 1);
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+    pdu->interval  = btstack_max(interval_ms * 1000 / 625, ADVERTISING_INTERVAL_EXTENDED_NONCONNECTABLE_MIN);
+#else
+    // legacy advertising uses fixed interval
+    UNUSED(interval_ms);
+    pdu->interval  = ADVERTISING_INTERVAL_NONCONNECTABLE_MIN;
+#endif
+    pdu->queued_ms = btstack_run_loop_get_time_ms();
+    btstack_linked_list_add_tail(&adv_bearer_queues[type_id], (btstack_linked_item_t *) pdu);
 }
 
 //////
@@ -316,6 +664,15 @@ void adv_bearer_init(void){
     // idle
     adv_bearer_state = STATE_IDLE; 
     memset(null_addr, 0, 6);
+    // queue
+    adv_bearer_queue_init();
+    adv_bearer_current_pdu = NULL;
+#ifdef ENABLE_LE_EXTENDED_ADVERTISING
+    adv_bearer_advertising_sets_ready = 0;
+    adv_bearer_advertising_sets_num = 0;
+    adv_bearer_advertising_sets_num_failed = 0;
+#endif
+    adv_bearer_reset_statistics();
 }
 
 // adv bearer packet handler regisration
@@ -345,21 +702,38 @@ void adv_bearer_request_can_send_now_for_provisioning_pdu(void){
 // adv bearer send message
 
 void adv_bearer_send_network_pdu(const uint8_t * data, uint16_t data_len, uint8_t count, uint16_t interval){
-    btstack_assert(data_len <= (sizeof(adv_bearer_buffer)-2));
-    adv_bearer_prepare_message(data, data_len, BLUETOOTH_DATA_TYPE_MESH_MESSAGE, count, interval);
+    adv_bearer_prepare_message(MESH_NETWORK_ID, data, data_len, BLUETOOTH_DATA_TYPE_MESH_MESSAGE, count, interval);
     adv_bearer_run();
 }
 void adv_bearer_send_beacon(const uint8_t * data, uint16_t data_len){
-    btstack_assert(data_len <= (sizeof(adv_bearer_buffer)-2));
-    adv_bearer_prepare_message(data, data_len, BLUETOOTH_DATA_TYPE_MESH_BEACON, 3, 100);
+    adv_bearer_prepare_message(MESH_BEACON_ID, data, data_len, BLUETOOTH_DATA_TYPE_MESH_BEACON, 3, 100);
     adv_bearer_run();
 }
 void adv_bearer_send_provisioning_pdu(const uint8_t * data, uint16_t data_len){
-    btstack_assert(data_len <= (sizeof(adv_bearer_buffer)-2));
-    adv_bearer_prepare_message(data, data_len, BLUETOOTH_DATA_TYPE_PB_ADV, 3, 100);
+    adv_bearer_prepare_message(PB_ADV_ID, data, data_len, BLUETOOTH_DATA_TYPE_PB_ADV, 3, 100);
     adv_bearer_run();
 }
 
+// statistics
+
+void adv_bearer_get_statistics(adv_bearer_statistics_t * statistics){
+    *statistics = adv_bearer_statistics;
+    uint32_t duration_ms = btstack_run_loop_get_time_ms() - adv_bearer_statistics_start_ms;
+    if (duration_ms > 0){
+        statistics->pdus_per_second = (uint32_t) (((uint64_t) adv_bearer_statistics.pdus_sent * 1000u) / duration_ms);
+    }
+    if (adv_bearer_statistics_num_started > 0){
+        statistics->queue_latency_avg_ms = adv_bearer_statistics_latency_sum_ms / adv_bearer_statistics_num_started;
+    }
+}
+
+void adv_bearer_reset_statistics(void){
+    memset(&adv_bearer_statistics, 0, sizeof(adv_bearer_statistics));
+    adv_bearer_statistics_start_ms = btstack_run_loop_get_time_ms();
+    adv_bearer_statistics_latency_sum_ms = 0;
+    adv_bearer_statistics_num_started = 0;
+}
+
 // gap advertising
 
 void adv_bearer_advertisements_enable(int enabled){
@@ -54,6 +54,20 @@ typedef struct {
 	uint8_t adv_data[31];
 } adv_bearer_connectable_advertisement_data_item_t;
 
+typedef struct {
+	// messages with all transmissions completed
+	uint32_t pdus_sent;
+	// messages dropped as queue was full
+	uint32_t pdus_dropped;
+	// pdus_sent per second since last reset
+	uint32_t pdus_per_second;
+	// time from queueing a message until its first transmission
+	uint32_t queue_latency_avg_ms;
+	uint32_t queue_latency_max_ms;
+	// advertising parameter updates for extended advertising sets
+	uint32_t parameter_updates;
+} adv_bearer_statistics_t;
+
 /**
  * Initialize Advertising Bearer
  */
@@ -130,6 +144,17 @@ void adv_bearer_send_network_pdu(const uint8_t * network_pdu, uint16_t size, uin
  */
 void adv_bearer_send_beacon(const uint8_t * beacon_update, uint16_t size);
 void adv_bearer_send_provisioning_pdu(const uint8_t * pb_adv_pdu, uint16_t size); 
+
+/**
+ * @brief Get statistics for sent messages since init or last reset
+ * @param statistics
+ */
+void adv_bearer_get_statistics(adv_bearer_statistics_t * statistics);
+
+/**
+ * @brief Reset statistics
+ */
+void adv_bearer_reset_statistics(void);
  
 
 #if defined __cplusplus
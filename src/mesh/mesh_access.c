@@ -74,6 +74,37 @@ static int                    mesh_access_acknowledged_timer_active;
 // Transitions
 static uint8_t mesh_transaction_id_counter = 0;
 
+#ifdef ENABLE_MESH_ACCESS_OPCODE_TABLE
+// opcode dispatch table with one entry per model operation, falls back to linear scan if composition does not fit
+#ifndef MESH_ACCESS_OPCODE_TABLE_SIZE
+#define MESH_ACCESS_OPCODE_TABLE_SIZE 64
+#endif
+
+#if (MESH_ACCESS_OPCODE_TABLE_SIZE < 1) || (MESH_ACCESS_OPCODE_TABLE_SIZE > 0xfffe)
+#error "MESH_ACCESS_OPCODE_TABLE_SIZE must be in range 1..65534"
+#endif
+
+// one bucket per entry keeps chains short
+#define MESH_ACCESS_OPCODE_TABLE_NUM_BUCKETS   MESH_ACCESS_OPCODE_TABLE_SIZE
+#define MESH_ACCESS_OPCODE_TABLE_INDEX_INVALID 0xffffu
+
+typedef struct {
+    mesh_model_t * model;
+    const mesh_operation_t * operation;
+    // next entry in same (element, opcode) bucket, used for unicast
+    uint16_t next_unicast;
+    // next entry in same opcode bucket, used for group addresses
+    uint16_t next_group;
+} mesh_access_opcode_table_entry_t;
+
+static mesh_access_opcode_table_entry_t mesh_access_opcode_table[MESH_ACCESS_OPCODE_TABLE_SIZE];
+static uint16_t mesh_access_opcode_table_unicast_buckets[MESH_ACCESS_OPCODE_TABLE_NUM_BUCKETS];
+static uint16_t mesh_access_opcode_table_group_buckets[MESH_ACCESS_OPCODE_TABLE_NUM_BUCKETS];
+static uint16_t mesh_access_opcode_table_composition_counter;
+static bool     mesh_access_opcode_table_ready;
+static bool     mesh_access_opcode_table_valid;
+#endif
+
 void mesh_access_init(void){
     // register with upper transport
     mesh_upper_transport_register_access_message_handler(&mesh_access_upper_transport_handler);
@@ -734,15 +765,7 @@ static const mesh_operation_t * mesh_model_lookup_operation_by_opcode(mesh_model
     return NULL;
 }
 
-static const mesh_operation_t * mesh_model_lookup_operation(mesh_model_t * model, mesh_pdu_t * pdu){
-
-    uint32_t opcode = 0;
-    uint16_t opcode_size = 0;
-    int ok = mesh_access_pdu_get_opcode( pdu, &opcode, &opcode_size);
-    if (!ok) return NULL;
-
-    uint16_t len = mesh_pdu_len(pdu);
-
+static const mesh_operation_t * mesh_model_lookup_operation(mesh_model_t * model, uint32_t opcode, uint16_t opcode_size, uint16_t len){
     // find opcode in table
     const mesh_operation_t * operation = model->operations;
     if (operation == NULL) return NULL;
@@ -761,6 +784,168 @@ static int mesh_access_validate_appkey_index(mesh_model_t * model, uint16_t appk
     return mesh_model_contains_appkey(model, appkey_index);
 }
 
+static void mesh_access_message_deliver(mesh_model_t * model, const mesh_operation_t * operation, mesh_pdu_t * pdu, uint32_t opcode){
+    if (mesh_access_validate_appkey_index(model, mesh_pdu_appkey_index(pdu)) == 0) return;
+    mesh_access_acknowledged_received(mesh_pdu_src(pdu), opcode);
+    mesh_access_received_pdu_refcount++;
+    operation->handler(model, pdu);
+}
+
+#ifdef ENABLE_MESH_ACCESS_OPCODE_TABLE
+
+// Opcode dispatch table: operations of all models in element/model order. Each entry is in two hash chains:
+// one keyed by (element index, opcode) for unicast and one keyed by opcode for group addresses.
+// It is rebuilt when the node composition changes. If it is too small, the access layer iterates over the models.
+
+static uint32_t mesh_access_opcode_table_fold(uint32_t opcode){
+    return opcode ^ (opcode >> 8) ^ (opcode >> 16);
+}
+
+static uint16_t mesh_access_opcode_table_hash_unicast(uint16_t element_index, uint32_t opcode){
+    return (uint16_t) ((mesh_access_opcode_table_fold(opcode) + (31u * element_index)) % MESH_ACCESS_OPCODE_TABLE_NUM_BUCKETS);
+}
+
+static uint16_t mesh_access_opcode_table_hash_group(uint32_t opcode){
+    return (uint16_t) (mesh_access_opcode_table_fold(opcode) % MESH_ACCESS_OPCODE_TABLE_NUM_BUCKETS);
+}
+
+static bool mesh_access_opcode_table_update(void){
+    uint16_t composition_counter = mesh_node_get_composition_counter();
+    if (mesh_access_opcode_table_ready && (mesh_access_opcode_table_composition_counter == composition_counter)){
+        return mesh_access_opcode_table_valid;
+    }
+    mesh_access_opcode_table_ready = true;
+    mesh_access_opcode_table_valid = false;
+    mesh_access_opcode_table_composition_counter = composition_counter;
+
+    // collect operations in element/model order
+    uint16_t num_entries = 0;
+    uint32_t num_operations = 0;
+    mesh_element_iterator_t element_it;
+    mesh_element_iterator_init(&element_it);
+    while (mesh_element_iterator_has_next(&element_it)){
+        mesh_element_t * element = mesh_element_iterator_next(&element_it);
+        mesh_model_iterator_t model_it;
+        mesh_model_iterator_init(&model_it, element);
+        while (mesh_model_iterator_has_next(&model_it)){
+            mesh_model_t * model = mesh_model_iterator_next(&model_it);
+            const mesh_operation_t * operation = model->operations;
+            if (operation == NULL) continue;
+            for ( ; operation->handler != NULL ; operation++){
+                // keep counting to report required size
+                num_operations++;
+                if (num_entries == MESH_ACCESS_OPCODE_TABLE_SIZE) continue;
+                mesh_access_opcode_table[num_entries].model = model;
+                mesh_access_opcode_table[num_entries].operation = operation;
+                num_entries++;
+            }
+        }
+    }
+    if (num_operations > MESH_ACCESS_OPCODE_TABLE_SIZE){
+        log_error("Opcode dispatch table too small for %u operations, MESH_ACCESS_OPCODE_TABLE_SIZE %u, using linear scan",
+                  (unsigned int) num_operations, MESH_ACCESS_OPCODE_TABLE_SIZE);
+        return false;
+    }
+
+    // link entries in reverse, so chains are in element/model order
+    uint16_t i;
+    for (i = 0; i < MESH_ACCESS_OPCODE_TABLE_NUM_BUCKETS; i++){
+        mesh_access_opcode_table_unicast_buckets[i] = MESH_ACCESS_OPCODE_TABLE_INDEX_INVALID;
+        mesh_access_opcode_table_group_buckets[i] = MESH_ACCESS_OPCODE_TABLE_INDEX_INVALID;
+    }
+    i = num_entries;
+    while (i > 0){
+        i--;
+        mesh_access_opcode_table_entry_t * entry = &mesh_access_opcode_table[i];
+        uint32_t opcode = entry->operation->opcode;
+        uint16_t bucket = mesh_access_opcode_table_hash_unicast(entry->model->element->element_index, opcode);
+        entry->next_unicast = mesh_access_opcode_table_unicast_buckets[bucket];
+        mesh_access_opcode_table_unicast_buckets[bucket] = i;
+        bucket = mesh_access_opcode_table_hash_group(opcode);
+        entry->next_group = mesh_access_opcode_table_group_buckets[bucket];
+        mesh_access_opcode_table_group_buckets[bucket] = i;
+    }
+    mesh_access_opcode_table_valid = true;
+    return true;
+}
+
+// @return false if opcode table cannot be used
+static bool mesh_access_opcode_table_dispatch_unicast(mesh_pdu_t * pdu, uint32_t opcode, uint16_t opcode_size, uint16_t len, uint16_t element_index){
+    if (mesh_access_opcode_table_update() == false) return false;
+    // entries of a model follow each other in chain, deliver to first operation with sufficient length
+    mesh_model_t * delivered_model = NULL;
+    uint16_t index = mesh_access_opcode_table_unicast_buckets[mesh_access_opcode_table_hash_unicast(element_index, opcode)];
+    while (index != MESH_ACCESS_OPCODE_TABLE_INDEX_INVALID){
+        const mesh_access_opcode_table_entry_t * entry = &mesh_access_opcode_table[index];
+        index = entry->next_unicast;
+        if (entry->operation->opcode != opcode) continue;
+        if (entry->model->element->element_index != element_index) continue;
+        if (entry->model == delivered_model) continue;
+        if ((opcode_size + entry->operation->minimum_length) > len) continue;
+        delivered_model = entry->model;
+        mesh_access_message_deliver(entry->model, entry->operation, pdu, opcode);
+    }
+    return true;
+}
+
+// @return false if opcode table cannot be used
+static bool mesh_access_opcode_table_dispatch_group(mesh_pdu_t * pdu, uint32_t opcode, uint16_t opcode_size, uint16_t len, uint16_t group_address){
+    if (mesh_access_opcode_table_update() == false) return false;
+    // subscription lists change at runtime, only check them for models that implement the opcode
+    mesh_model_t * delivered_model = NULL;
+    uint16_t index = mesh_access_opcode_table_group_buckets[mesh_access_opcode_table_hash_group(opcode)];
+    while (index != MESH_ACCESS_OPCODE_TABLE_INDEX_INVALID){
+        const mesh_access_opcode_table_entry_t * entry = &mesh_access_opcode_table[index];
+        index = entry->next_group;
+        if (entry->operation->opcode != opcode) continue;
+        if (entry->model == delivered_model) continue;
+        if ((opcode_size + entry->operation->minimum_length) > len) continue;
+        if (mesh_model_contains_subscription(entry->model, group_address) == 0) continue;
+        delivered_model = entry->model;
+        mesh_access_message_deliver(entry->model, entry->operation, pdu, opcode);
+    }
+    return true;
+}
+#endif
+
+// iterate over models of element, only models subscribed to group address if given
+static void mesh_access_message_dispatch_element(mesh_pdu_t * pdu, uint32_t opcode, uint16_t opcode_size, uint16_t len, mesh_element_t * element, uint16_t group_address){
+    mesh_model_iterator_t model_it;
+    mesh_model_iterator_init(&model_it, element);
+    while (mesh_model_iterator_has_next(&model_it)){
+        mesh_model_t * model = mesh_model_iterator_next(&model_it);
+        if ((group_address != MESH_ADDRESS_UNSASSIGNED) && (mesh_model_contains_subscription(model, group_address) == 0)) continue;
+        // find opcode in table
+        const mesh_operation_t * operation = mesh_model_lookup_operation(model, opcode, opcode_size, len);
+        if (operation == NULL) continue;
+        mesh_access_message_deliver(model, operation, pdu, opcode);
+    }
+}
+
+static void mesh_access_message_dispatch_unicast(mesh_pdu_t * pdu, uint32_t opcode, uint16_t opcode_size, uint16_t element_index){
+    uint16_t len = mesh_pdu_len(pdu);
+#ifdef ENABLE_MESH_ACCESS_OPCODE_TABLE
+    if (mesh_access_opcode_table_dispatch_unicast(pdu, opcode, opcode_size, len, element_index)) return;
+#endif
+    mesh_element_t * element = mesh_node_element_for_index(element_index);
+    if (element == NULL) return;
+    mesh_access_message_dispatch_element(pdu, opcode, opcode_size, len, element, MESH_ADDRESS_UNSASSIGNED);
+}
+
+static void mesh_access_message_dispatch_group(mesh_pdu_t * pdu, uint32_t opcode, uint16_t opcode_size, uint16_t group_address){
+    uint16_t len = mesh_pdu_len(pdu);
+#ifdef ENABLE_MESH_ACCESS_OPCODE_TABLE
+    if (mesh_access_opcode_table_dispatch_group(pdu, opcode, opcode_size, len, group_address)) return;
+#endif
+    // iterate over all elements / models, check subscription list
+    mesh_element_iterator_t it;
+    mesh_element_iterator_init(&it);
+    while (mesh_element_iterator_has_next(&it)){
+        mesh_element_t * element = (mesh_element_t *) mesh_element_iterator_next(&it);
+        mesh_access_message_dispatch_element(pdu, opcode, opcode_size, len, element, group_address);
+    }
+}
+
 // decrease use count and report as free if done
 void mesh_access_message_processed(mesh_pdu_t * pdu){
     if (mesh_access_received_pdu_refcount > 0){
@@ -786,31 +971,14 @@ static void mesh_access_message_process_handler(mesh_pdu_t * pdu){
         return;
     }
 
-    uint16_t len = mesh_pdu_len(pdu);
-    printf("MESH Access Message, Opcode = %08" PRIx32 ": ", opcode);
-    printf_hexdump(mesh_pdu_data(pdu), len);
+    log_info("MESH Access Message, Opcode = %08" PRIx32, opcode);
+    log_info_hexdump(mesh_pdu_data(pdu), mesh_pdu_len(pdu));
 
-    uint16_t src = mesh_pdu_src(pdu);
     uint16_t dst = mesh_pdu_dst(pdu);
-    uint16_t appkey_index = mesh_pdu_appkey_index(pdu);
     if (mesh_network_address_unicast(dst)){
-        // loookup element by unicast address
-        mesh_element_t * element = mesh_node_element_for_unicast_address(dst);
-        if (element != NULL){
-            // iterate over models, look for operation
-            mesh_model_iterator_t model_it;
-            mesh_model_iterator_init(&model_it, element);
-            while (mesh_model_iterator_has_next(&model_it)){
-                mesh_model_t * model = mesh_model_iterator_next(&model_it);
-                // find opcode in table
-                const mesh_operation_t * operation = mesh_model_lookup_operation(model, pdu);
-                if (operation == NULL) continue;
-                if (mesh_access_validate_appkey_index(model, appkey_index) == 0) continue;
-                mesh_access_acknowledged_received(src, opcode);
-                mesh_access_received_pdu_refcount++;
-                operation->handler(model, pdu);
-            }
-        }
+        // element index is offset to primary element address
+        uint16_t element_index = (uint16_t) (dst - mesh_node_get_primary_element_address());
+        mesh_access_message_dispatch_unicast(pdu, opcode, opcode_size, element_index);
     }
     else if (mesh_network_address_group(dst)){
 
@@ -838,41 +1006,12 @@ static void mesh_access_message_process_handler(mesh_pdu_t * pdu){
                     break;
             }
             if (deliver_to_primary_element){
-                mesh_model_iterator_t model_it;
-                mesh_model_iterator_init(&model_it, mesh_node_get_primary_element());
-                while (mesh_model_iterator_has_next(&model_it)){
-                    mesh_model_t * model = mesh_model_iterator_next(&model_it);
-                    // find opcode in table
-                    const mesh_operation_t * operation = mesh_model_lookup_operation(model, pdu);
-                    if (operation == NULL) continue;
-                    if (mesh_access_validate_appkey_index(model, appkey_index) == 0) continue;
-                    mesh_access_acknowledged_received(src, opcode);
-                    mesh_access_received_pdu_refcount++;
-                    operation->handler(model, pdu);
-                }
+                mesh_access_message_dispatch_unicast(pdu, opcode, opcode_size, 0);
             }
         }
         else {
-            // iterate over all elements / models, check subscription list
-            mesh_element_iterator_t it;
-            mesh_element_iterator_init(&it);
-            while (mesh_element_iterator_has_next(&it)){
-                mesh_element_t * element = (mesh_element_t *) mesh_element_iterator_next(&it);
-                mesh_model_iterator_t model_it;
-                mesh_model_iterator_init(&model_it, element);
-                while (mesh_model_iterator_has_next(&model_it)){
-                    mesh_model_t * model = mesh_model_iterator_next(&model_it);
-                    if (mesh_model_contains_subscription(model, dst)){
-                        // find opcode in table
-                        const mesh_operation_t * operation = mesh_model_lookup_operation(model, pdu);
-                        if (operation == NULL) continue;
-                        if (mesh_access_validate_appkey_index(model, appkey_index) == 0) continue;
-                        mesh_access_acknowledged_received(src, opcode);
-                        mesh_access_received_pdu_refcount++;
-                        operation->handler(model, pdu);
-                    }
-                }
-            }
+            // models with subscription to group address
+            mesh_access_message_dispatch_group(pdu, opcode, opcode_size, dst);
         }
     }
 
@@ -55,6 +55,23 @@
 
 #define LOG_LOWER_TRANSPORT
 
+// number of destinations for which outgoing statistics are kept
+#ifndef MESH_LOWER_TRANSPORT_NUM_DESTINATION_STATS
+#define MESH_LOWER_TRANSPORT_NUM_DESTINATION_STATS 8
+#endif
+
+// pause between outgoing segments, e.g. to pace transmissions on advertising bearer
+#ifndef MESH_LOWER_TRANSPORT_SEGMENT_INTERVAL_MS
+#define MESH_LOWER_TRANSPORT_SEGMENT_INTERVAL_MS 0
+#endif
+
+#if MESH_LOWER_TRANSPORT_NUM_DESTINATION_STATS < 1
+#error "MESH_LOWER_TRANSPORT_NUM_DESTINATION_STATS must be at least 1"
+#endif
+
+// transmissions of a segmented message without progress
+#define MESH_LOWER_TRANSPORT_RETRY_COUNT 3
+
 // prototypes
 static void mesh_lower_transport_run(void);
 static void mesh_lower_transport_outgoing_complete(mesh_segmented_pdu_t * segmented_pdu, mesh_transport_status_t status);
@@ -87,6 +104,16 @@ static bool                    lower_transport_outgoing_transmission_aborted;
 // active outgoing unsegmented message
 static mesh_network_pdu_t *   lower_transport_outgoing_network_pdu;
 
+#if MESH_LOWER_TRANSPORT_SEGMENT_INTERVAL_MS > 0
+// next segment of lower_transport_outgoing_message is sent on timeout
+static btstack_timer_source_t  lower_transport_outgoing_pacing_timer;
+static bool                    lower_transport_outgoing_pacing_active;
+#endif
+
+// outgoing statistics per destination, oldest entry is replaced
+static mesh_lower_transport_destination_stats_t lower_transport_destination_stats[MESH_LOWER_TRANSPORT_NUM_DESTINATION_STATS];
+static uint16_t lower_transport_destination_stats_next;
+
 // deliver to higher layer
 static void (*higher_layer_handler)( mesh_transport_callback_type_t callback_type, mesh_transport_status_t status, mesh_pdu_t * pdu);
 static mesh_pdu_t * mesh_lower_transport_higher_layer_pdu;
@@ -438,11 +465,11 @@ static void mesh_lower_transport_incoming_process_segment(mesh_segmented_pdu_t *
     // send ack
     mesh_lower_transport_incoming_send_ack_for_segmented_pdu(message_pdu);
 
-    // forward to upper transport
-    mesh_lower_transport_incoming_queue_for_higher_layer((mesh_pdu_t *) message_pdu);
-
     // mark as done
     mesh_lower_transport_incoming_segmented_message_complete(message_pdu);
+
+    // forward to upper transport, might get processed and freed synchronously
+    mesh_lower_transport_incoming_queue_for_higher_layer((mesh_pdu_t *) message_pdu);
 }
 
 void mesh_lower_transport_message_processed_by_higher_layer(mesh_pdu_t * pdu){
@@ -467,6 +494,41 @@ void mesh_lower_transport_message_processed_by_higher_layer(mesh_pdu_t * pdu){
 
 // OUTGOING //
 
+static mesh_lower_transport_destination_stats_t * mesh_lower_transport_destination_stats_for_dst(uint16_t dst){
+    uint16_t i;
+    for (i = 0; i < MESH_LOWER_TRANSPORT_NUM_DESTINATION_STATS; i++){
+        if (lower_transport_destination_stats[i].address == dst){
+            return &lower_transport_destination_stats[i];
+        }
+    }
+    mesh_lower_transport_destination_stats_t * stats = &lower_transport_destination_stats[lower_transport_destination_stats_next];
+    memset(stats, 0, sizeof(mesh_lower_transport_destination_stats_t));
+    stats->address = dst;
+    lower_transport_destination_stats_next++;
+    if (lower_transport_destination_stats_next == MESH_LOWER_TRANSPORT_NUM_DESTINATION_STATS){
+        lower_transport_destination_stats_next = 0;
+    }
+    return stats;
+}
+
+const mesh_lower_transport_destination_stats_t * mesh_lower_transport_get_destination_stats(uint16_t dest){
+    uint16_t i;
+    for (i = 0; i < MESH_LOWER_TRANSPORT_NUM_DESTINATION_STATS; i++){
+        if ((dest != MESH_ADDRESS_UNSASSIGNED) && (lower_transport_destination_stats[i].address == dest)){
+            return &lower_transport_destination_stats[i];
+        }
+    }
+    return NULL;
+}
+
+static void mesh_lower_transport_outgoing_stop_pacing(void){
+#if MESH_LOWER_TRANSPORT_SEGMENT_INTERVAL_MS > 0
+    if (lower_transport_outgoing_pacing_active == false) return;
+    lower_transport_outgoing_pacing_active = false;
+    btstack_run_loop_remove_timer(&lower_transport_outgoing_pacing_timer);
+#endif
+}
+
 static void mesh_lower_transport_outgoing_setup_block_ack(mesh_segmented_pdu_t *message_pdu){
     // setup block ack - set bit for segment to send, will be cleared on ack
     int      ctl = message_pdu->ctl_ttl >> 7;
@@ -479,11 +541,46 @@ static void mesh_lower_transport_outgoing_setup_block_ack(mesh_segmented_pdu_t *
     }
 }
 
+static mesh_segmented_pdu_t * mesh_lower_transport_outgoing_message_in_list(btstack_linked_list_t * list, uint16_t dst){
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, list);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        mesh_pdu_t * pdu = (mesh_pdu_t *) btstack_linked_list_iterator_next(&it);
+        if (pdu->pdu_type != MESH_PDU_TYPE_SEGMENTED) continue;
+        mesh_segmented_pdu_t * segmented_pdu = (mesh_segmented_pdu_t *) pdu;
+        if (segmented_pdu->dst == dst){
+            return segmented_pdu;
+        }
+    }
+    return NULL;
+}
+
+// one segmented message per destination: active, waiting for acknowledgement, or queued for (re)transmission
 static mesh_segmented_pdu_t * mesh_lower_transport_outgoing_message_for_dst(uint16_t dst){
     if (lower_transport_outgoing_message != NULL && lower_transport_outgoing_message->dst == dst){
         return lower_transport_outgoing_message;
     }
-    return NULL;
+    mesh_segmented_pdu_t * segmented_pdu = mesh_lower_transport_outgoing_message_in_list(&lower_transport_outgoing_waiting, dst);
+    if (segmented_pdu != NULL){
+        return segmented_pdu;
+    }
+    return mesh_lower_transport_outgoing_message_in_list(&lower_transport_outgoing_ready, dst);
+}
+
+static void mesh_lower_transport_outgoing_update_ack_latency(mesh_segmented_pdu_t * segmented_pdu, mesh_lower_transport_destination_stats_t * stats){
+    uint32_t latency_ms = btstack_run_loop_get_time_ms() - segmented_pdu->transmission_time_ms;
+    if (stats->acks_received == 0u){
+        stats->ack_latency_ms = latency_ms;
+    } else {
+        stats->ack_latency_ms = ((3u * stats->ack_latency_ms) + latency_ms) / 4u;
+    }
+    stats->acks_received++;
+}
+
+static void mesh_lower_transport_outgoing_stop_acknowledgment_timer(mesh_segmented_pdu_t *segmented_pdu){
+    if ((segmented_pdu->flags & MESH_TRANSPORT_FLAG_ACK_TIMER) == 0) return;
+    segmented_pdu->flags &= ~MESH_TRANSPORT_FLAG_ACK_TIMER;
+    btstack_run_loop_remove_timer(&segmented_pdu->acknowledgement_timer);
 }
 
 static void mesh_lower_transport_outgoing_process_segment_acknowledgement_message(mesh_network_pdu_t *network_pdu){
@@ -492,7 +589,7 @@ static void mesh_lower_transport_outgoing_process_segment_acknowledgement_messag
 
     uint8_t * lower_transport_pdu     = mesh_network_pdu_data(network_pdu);
     uint16_t seq_zero_pdu = big_endian_read_16(lower_transport_pdu, 1) >> 2;
-    uint16_t seq_zero_out = lower_transport_outgoing_message->seq & 0x1fff;
+    uint16_t seq_zero_out = segmented_pdu->seq & 0x1fff;
     uint32_t block_ack = big_endian_read_32(lower_transport_pdu, 3);
 
 #ifdef LOG_LOWER_TRANSPORT
@@ -523,6 +620,9 @@ static void mesh_lower_transport_outgoing_process_segment_acknowledgement_messag
         return;
     }
 
+    mesh_lower_transport_outgoing_update_ack_latency(segmented_pdu, mesh_lower_transport_destination_stats_for_dst(segmented_pdu->dst));
+
+    uint32_t newly_acked = segmented_pdu->block_ack & block_ack;
     segmented_pdu->block_ack &= ~block_ack;
 #ifdef LOG_LOWER_TRANSPORT
     printf("[+] Updated block_ack %08" PRIx32 "\n", segmented_pdu->block_ack);
@@ -538,21 +638,38 @@ static void mesh_lower_transport_outgoing_process_segment_acknowledgement_messag
         } else {
             mesh_lower_transport_outgoing_complete(segmented_pdu, MESH_TRANSPORT_STATUS_SUCCESS);
         }
+        return;
     }
-}
 
-static void mesh_lower_transport_outgoing_stop_acknowledgment_timer(mesh_segmented_pdu_t *segmented_pdu){
-    if ((segmented_pdu->flags & MESH_TRANSPORT_FLAG_ACK_TIMER) == 0) return;
-    segmented_pdu->flags &= ~MESH_TRANSPORT_FLAG_ACK_TIMER;
-    btstack_run_loop_remove_timer(&segmented_pdu->acknowledgement_timer);
+    // no progress, segment transmission timer will retransmit
+    if (newly_acked == 0u) return;
+
+    // progress, retries are only consumed without progress
+    segmented_pdu->retry_count = MESH_LOWER_TRANSPORT_RETRY_COUNT;
+
+    // all segments sent but some are missing: retransmit them right away instead of waiting for the timer
+    if (btstack_linked_list_remove(&lower_transport_outgoing_waiting, (btstack_linked_item_t *) segmented_pdu)){
+#ifdef LOG_LOWER_TRANSPORT
+        printf("[+] Partial ack, retransmit missing segments\n");
+#endif
+        mesh_lower_transport_outgoing_stop_acknowledgment_timer(segmented_pdu);
+        segmented_pdu->flags |= MESH_TRANSPORT_FLAG_RETRANSMISSION;
+        btstack_linked_list_add_tail(&lower_transport_outgoing_ready, (btstack_linked_item_t *) segmented_pdu);
+        mesh_lower_transport_run();
+    }
 }
 
 static void mesh_lower_transport_outgoing_restart_segment_transmission_timer(mesh_segmented_pdu_t *segmented_pdu){
     // restart segment transmission timer for unicast dst
     // - "This timer shall be set to a minimum of 200 + 50 * TTL milliseconds."
     uint32_t timeout = 200 + 50 * (segmented_pdu->ctl_ttl & 0x7f);
+    // - allow for twice the acknowledgement latency observed for this destination, e.g. over several hops
+    const mesh_lower_transport_destination_stats_t * stats = mesh_lower_transport_get_destination_stats(segmented_pdu->dst);
+    if ((stats != NULL) && ((2u * stats->ack_latency_ms) > timeout)){
+        timeout = 2u * stats->ack_latency_ms;
+    }
     if ((segmented_pdu->flags & MESH_TRANSPORT_FLAG_ACK_TIMER) != 0){
-        btstack_run_loop_remove_timer(&lower_transport_outgoing_message->acknowledgement_timer);
+        btstack_run_loop_remove_timer(&segmented_pdu->acknowledgement_timer);
     }
 
 #ifdef LOG_LOWER_TRANSPORT
@@ -562,7 +679,7 @@ static void mesh_lower_transport_outgoing_restart_segment_transmission_timer(mes
 
     btstack_run_loop_set_timer(&segmented_pdu->acknowledgement_timer, timeout);
     btstack_run_loop_set_timer_handler(&segmented_pdu->acknowledgement_timer, &mesh_lower_transport_outgoing_segment_transmission_timeout);
-    btstack_run_loop_set_timer_context(&segmented_pdu->acknowledgement_timer, lower_transport_outgoing_message);
+    btstack_run_loop_set_timer_context(&segmented_pdu->acknowledgement_timer, segmented_pdu);
     btstack_run_loop_add_timer(&segmented_pdu->acknowledgement_timer);
     segmented_pdu->flags |= MESH_TRANSPORT_FLAG_ACK_TIMER;
 }
@@ -576,8 +693,17 @@ static void mesh_lower_transport_outgoing_complete(mesh_segmented_pdu_t * segmen
     // stop timers
     mesh_lower_transport_outgoing_stop_acknowledgment_timer(segmented_pdu);
 
+    // update stats
+    mesh_lower_transport_destination_stats_t * stats = mesh_lower_transport_destination_stats_for_dst(segmented_pdu->dst);
+    if (status == MESH_TRANSPORT_STATUS_SUCCESS){
+        stats->messages_sent++;
+    } else {
+        stats->messages_failed++;
+    }
+
     // remove from lists
     if (lower_transport_outgoing_message == segmented_pdu){
+        mesh_lower_transport_outgoing_stop_pacing();
         lower_transport_outgoing_message = NULL;
     } else {
         btstack_linked_list_remove(&lower_transport_outgoing_waiting, (btstack_linked_item_t *) segmented_pdu);
@@ -692,6 +818,7 @@ static void mesh_lower_transport_outgoing_send_next_segment(void){
         printf("[+] Lower Transport, message unacknowledged retry count %u\n", lower_transport_outgoing_message->retry_count);
 #endif
         lower_transport_outgoing_message->retry_count--;
+        lower_transport_outgoing_message->flags |= MESH_TRANSPORT_FLAG_RETRANSMISSION;
         btstack_linked_list_add(&lower_transport_outgoing_ready, (btstack_linked_item_t *) lower_transport_outgoing_message);
         lower_transport_outgoing_message = NULL;
         mesh_lower_transport_run();
@@ -715,6 +842,14 @@ static void mesh_lower_transport_outgoing_send_next_segment(void){
     // next segment
     lower_transport_outgoing_seg_o++;
 
+    // update stats
+    mesh_lower_transport_destination_stats_t * stats = mesh_lower_transport_destination_stats_for_dst(lower_transport_outgoing_message->dst);
+    stats->segments_sent++;
+    if ((lower_transport_outgoing_message->flags & MESH_TRANSPORT_FLAG_RETRANSMISSION) != 0){
+        stats->segments_retransmitted++;
+    }
+    lower_transport_outgoing_message->transmission_time_ms = btstack_run_loop_get_time_ms();
+
     // send network pdu
     lower_transport_outgoing_segment_at_network_layer = true;
     mesh_network_send_pdu(lower_transport_outgoing_segment);
@@ -747,10 +882,12 @@ static void mesh_lower_transport_outgoing_segment_transmission_fired(mesh_segmen
 
     // re-queue message for sending remaining segments
     if (lower_transport_outgoing_message == segmented_pdu){
+        mesh_lower_transport_outgoing_stop_pacing();
         lower_transport_outgoing_message = NULL;
     } else {
         btstack_linked_list_remove(&lower_transport_outgoing_waiting, (btstack_linked_item_t *) segmented_pdu);
     }
+    segmented_pdu->flags |= MESH_TRANSPORT_FLAG_RETRANSMISSION;
     btstack_linked_list_add_tail(&lower_transport_outgoing_ready, (btstack_linked_item_t *) segmented_pdu);
 
     // continue
@@ -772,6 +909,14 @@ static void mesh_lower_transport_outgoing_segment_transmission_timeout(btstack_t
     }
 }
 
+#if MESH_LOWER_TRANSPORT_SEGMENT_INTERVAL_MS > 0
+static void mesh_lower_transport_outgoing_pacing_timeout(btstack_timer_source_t * ts){
+    UNUSED(ts);
+    lower_transport_outgoing_pacing_active = false;
+    mesh_lower_transport_outgoing_send_next_segment();
+}
+#endif
+
 // GENERAL //
 
 static void mesh_lower_transport_network_pdu_sent(mesh_network_pdu_t *network_pdu){
@@ -816,7 +961,14 @@ static void mesh_lower_transport_network_pdu_sent(mesh_network_pdu_t *network_pd
         }
 
         // send next segment
+#if MESH_LOWER_TRANSPORT_SEGMENT_INTERVAL_MS > 0
+        lower_transport_outgoing_pacing_active = true;
+        btstack_run_loop_set_timer(&lower_transport_outgoing_pacing_timer, MESH_LOWER_TRANSPORT_SEGMENT_INTERVAL_MS);
+        btstack_run_loop_set_timer_handler(&lower_transport_outgoing_pacing_timer, &mesh_lower_transport_outgoing_pacing_timeout);
+        btstack_run_loop_add_timer(&lower_transport_outgoing_pacing_timer);
+#else
         mesh_lower_transport_outgoing_send_next_segment();
+#endif
         return;
     }
 
@@ -949,7 +1101,8 @@ void mesh_lower_transport_send_pdu(mesh_pdu_t *pdu){
         case MESH_PDU_TYPE_SEGMENTED:
             // set num retries, set of segments to send
             segmented_pdu = (mesh_segmented_pdu_t *) pdu;
-            segmented_pdu->retry_count = 3;
+            segmented_pdu->retry_count = MESH_LOWER_TRANSPORT_RETRY_COUNT;
+            segmented_pdu->flags &= ~MESH_TRANSPORT_FLAG_RETRANSMISSION;
             mesh_lower_transport_outgoing_setup_block_ack(segmented_pdu);
             break;
         default:
@@ -997,6 +1150,16 @@ bool mesh_lower_transport_can_send_to_dest(uint16_t dest){
             return false;
         }
     }
+    // check queued for (re)transmission
+    btstack_linked_list_iterator_init(&it, &lower_transport_outgoing_ready);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        mesh_pdu_t * pdu = (mesh_pdu_t *) btstack_linked_list_iterator_next(&it);
+        if (pdu->pdu_type != MESH_PDU_TYPE_SEGMENTED) continue;
+        num_messages++;
+        if (((mesh_segmented_pdu_t *) pdu)->dst == dest){
+            return false;
+        }
+    }
 #ifdef MAX_NR_MESH_OUTGOING_SEGMENTED_MESSAGES
     // limit number of parallel outgoing messages if configured
     if (num_messages >= MAX_NR_MESH_OUTGOING_SEGMENTED_MESSAGES) return false;
@@ -1024,6 +1187,9 @@ void mesh_lower_transport_reset(void){
     mesh_network_pdu_free(lower_transport_outgoing_segment);
     lower_transport_outgoing_segment_at_network_layer = false;
     lower_transport_outgoing_segment = NULL;
+    mesh_lower_transport_outgoing_stop_pacing();
+    memset(lower_transport_destination_stats, 0, sizeof(lower_transport_destination_stats));
+    lower_transport_destination_stats_next = 0;
 }
 
 void mesh_lower_transport_init(){
@@ -75,6 +75,21 @@ typedef enum {
     MESH_TRANSPORT_STATUS_SEND_ABORT_BY_REMOTE,
 } mesh_transport_status_t;
 
+// statistics for outgoing segmented messages per destination
+typedef struct {
+    uint16_t address;
+    // segmented messages completed / failed or aborted
+    uint32_t messages_sent;
+    uint32_t messages_failed;
+    // segments sent / thereof sent again
+    uint32_t segments_sent;
+    uint32_t segments_retransmitted;
+    // Segment Acknowledgment messages received
+    uint32_t acks_received;
+    // smoothed time between last segment and Segment Acknowledgment message
+    uint32_t ack_latency_ms;
+} mesh_lower_transport_destination_stats_t;
+
 mesh_segmented_pdu_t * mesh_segmented_pdu_get(void);
 void mesh_segmented_pdu_free(mesh_segmented_pdu_t * message_pdu);
 
@@ -87,6 +102,13 @@ bool mesh_lower_transport_can_send_to_dest(uint16_t dest);
 void mesh_lower_transport_reserve_slot(void);
 void mesh_lower_transport_send_pdu(mesh_pdu_t * pdu);
 
+/**
+ * @brief Get statistics for outgoing segmented messages to destination
+ * @param dest
+ * @return stats or NULL if no segmented message was sent to dest recently
+ */
+const mesh_lower_transport_destination_stats_t * mesh_lower_transport_get_destination_stats(uint16_t dest);
+
 // test
 void mesh_lower_transport_received_message(mesh_network_callback_type_t callback_type, mesh_network_pdu_t *network_pdu);
 void mesh_lower_transport_reset(void);
@@ -1252,6 +1252,8 @@ void mesh_network_reset(void){
         incoming_pdu_decoded = NULL;
     }
     mesh_crypto_active = 0;
+    memset(mesh_network_cache, 0, sizeof(mesh_network_cache));
+    mesh_network_cache_index = 0;
 }
 
 // buffer pool
@@ -112,6 +112,7 @@ typedef struct mesh_network_pdu {
 #define MESH_TRANSPORT_FLAG_TRANSMIC_64       4
 #define MESH_TRANSPORT_FLAG_ACK_TIMER         8
 #define MESH_TRANSPORT_FLAG_INCOMPLETE_TIMER 16
+#define MESH_TRANSPORT_FLAG_RETRANSMISSION   32
 
 typedef struct {
     mesh_pdu_t pdu_header;
@@ -136,6 +137,8 @@ typedef struct {
     uint16_t              flags;
     // retry count
     uint8_t               retry_count;
+    // outgoing: time of last segment transmission, used to measure acknowledgement latency
+    uint32_t              transmission_time_ms;
     // pdu segments
     uint16_t              len;
     btstack_linked_list_t segments;
@@ -57,6 +57,8 @@ static btstack_linked_list_t mesh_elements;
 
 static uint16_t mid_counter;
 
+static uint16_t mesh_node_composition_counter;
+
 static uint8_t mesh_node_device_uuid[16];
 static int     mesh_node_have_device_uuid;
 
@@ -98,12 +100,17 @@ uint16_t mesh_node_get_product_version_id(void){
 void mesh_node_add_element(mesh_element_t * element){
     element->element_index = mesh_element_index_next++;
     btstack_linked_list_add_tail(&mesh_elements, (void*) element);
+    mesh_node_composition_counter++;
 }
 
 uint16_t mesh_node_element_count(void){
 	return (uint16_t) btstack_linked_list_count(&mesh_elements);
 }
 
+uint16_t mesh_node_get_composition_counter(void){
+    return mesh_node_composition_counter;
+}
+
 mesh_element_t * mesh_node_get_primary_element(void){
     return &primary_element;
 }
@@ -203,6 +210,7 @@ void mesh_element_add_model(mesh_element_t * element, mesh_model_t * mesh_model)
     mesh_model->mid = mid_counter++;
     mesh_model->element = element;
     btstack_linked_list_add_tail(&element->models, (btstack_linked_item_t *) mesh_model);
+    mesh_node_composition_counter++;
 }
 
 void mesh_model_iterator_init(mesh_model_iterator_t * iterator, mesh_element_t * element){
@@ -222,6 +222,13 @@ void mesh_node_add_element(mesh_element_t * element);
  */
 uint16_t mesh_node_element_count(void);
 
+/**
+ * @brief Get composition counter, incremented whenever an element or a model is added
+ * @note Used to detect when lookup tables derived from the node composition need to be rebuilt
+ * @return composition counter
+ */
+uint16_t mesh_node_get_composition_counter(void);
+
 /**
  * @brief Get element for given unicast address
  * @param unicast_address
@@ -76,38 +76,80 @@ typedef struct {
     // key info
 } mesh_transport_key_and_virtual_address_iterator_t;
 
+#ifndef MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS
+#define MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS 1
+#endif
+
+#ifndef MESH_UPPER_TRANSPORT_KEY_CACHE_SIZE
+#define MESH_UPPER_TRANSPORT_KEY_CACHE_SIZE 8
+#endif
+
+#if (MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS < 1) || (MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS > 255)
+#error "MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS must be in range 1..255"
+#endif
+
+#if MESH_UPPER_TRANSPORT_KEY_CACHE_SIZE < 1
+#error "MESH_UPPER_TRANSPORT_KEY_CACHE_SIZE must be at least 1"
+#endif
+
+typedef enum {
+    MESH_UPPER_TRANSPORT_DECRYPT_IDLE,
+    MESH_UPPER_TRANSPORT_DECRYPT_ACTIVE,
+    MESH_UPPER_TRANSPORT_DECRYPT_VALID,
+    MESH_UPPER_TRANSPORT_DECRYPT_INVALID,
+    MESH_UPPER_TRANSPORT_DECRYPT_DELIVERED,
+} mesh_upper_transport_decrypt_state_t;
+
+// trial decryption of a single incoming access pdu
+typedef struct {
+    mesh_upper_transport_decrypt_state_t state;
+    // incoming segmented (mesh_segmented_pdu_t) or unsegmented (network_pdu_t)
+    mesh_pdu_t *           encrypted;
+    mesh_access_pdu_t      decrypted;
+    btstack_crypto_ccm_t   ccm;
+    uint8_t                nonce[13];
+    mesh_transport_key_and_virtual_address_iterator_t key_it;
+    // key used for current trial
+    const mesh_transport_key_t * key;
+    // key from cache, tried first
+    const mesh_transport_key_t * cached_key;
+} mesh_upper_transport_decrypt_context_t;
+
+typedef struct {
+    uint16_t src;
+    uint16_t netkey_index;
+    uint16_t appkey_index;
+} mesh_upper_transport_key_cache_entry_t;
+
 static void mesh_upper_transport_run(void);
 static void mesh_upper_transport_schedule_send_requests(void);
-static void mesh_upper_transport_validate_access_message(void);
+static void mesh_upper_transport_validate_access_message(mesh_upper_transport_decrypt_context_t * context);
 
 // upper transport callbacks - in access layer
 static void (*mesh_access_message_handler)( mesh_transport_callback_type_t callback_type, mesh_transport_status_t status, mesh_pdu_t * pdu);
 static void (*mesh_control_message_handler)( mesh_transport_callback_type_t callback_type, mesh_transport_status_t status, mesh_pdu_t * pdu);
 
-//
+// outgoing access encryption
 static int crypto_active;
 static uint8_t application_nonce[13];
 static btstack_crypto_ccm_t ccm;
-static mesh_transport_key_and_virtual_address_iterator_t mesh_transport_key_it;
+static uint8_t outgoing_access_buffer[MESH_ACCESS_PAYLOAD_MAX];
 
-// incoming segmented (mesh_segmented_pdu_t) or unsegmented (network_pdu_t)
-static mesh_pdu_t *          incoming_access_encrypted;
+// incoming access pdus: key trials for several pdus can be in flight, delivered in order of reception
+static mesh_upper_transport_decrypt_context_t decrypt_contexts[MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS];
+static uint8_t decrypt_contexts_head;
+static uint8_t decrypt_contexts_count;
 
-// multi-purpose union: segmented control reassembly, decrypted access pdu
-static union {
-    mesh_control_pdu_t    control;
-    mesh_access_pdu_t     access;
-} incoming_pdu_singleton;
+// last successful AppKey per source address
+static mesh_upper_transport_key_cache_entry_t key_cache[MESH_UPPER_TRANSPORT_KEY_CACHE_SIZE];
+static uint16_t key_cache_next;
 
-// pointer to incoming_pdu_singleton.access
-static mesh_access_pdu_t *   incoming_access_decrypted;
+// segmented control reassembly
+static mesh_control_pdu_t    incoming_control_pdu_singleton;
 
-// pointer to incoming_pdu_singleton.access
+// pointer to incoming_control_pdu_singleton while delivered
 static mesh_control_pdu_t *  incoming_control_pdu;
 
-// incoming incoming_access_decrypted ready to be deliverd
-static bool incoming_access_pdu_ready;
-
 // incoming unsegmented (network) and segmented (transport) control and access messages
 static btstack_linked_list_t upper_transport_incoming;
 
@@ -279,6 +321,16 @@ void mesh_upper_transport_dump(void){
 
 void mesh_upper_transport_reset(void){
     crypto_active = 0;
+    uint8_t i;
+    for (i = 0; i < MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS; i++){
+        decrypt_contexts[i].state = MESH_UPPER_TRANSPORT_DECRYPT_IDLE;
+        decrypt_contexts[i].encrypted = NULL;
+    }
+    decrypt_contexts_head = 0;
+    decrypt_contexts_count = 0;
+    memset(key_cache, 0, sizeof(key_cache));
+    key_cache_next = 0;
+    incoming_control_pdu = NULL;
     mesh_upper_transport_reset_pdus(&upper_transport_incoming);
     mesh_upper_transport_reset_pdus(&upper_transport_outgoing);
     message_builder_num_network_pdus_reserved = 0;
@@ -377,18 +429,113 @@ static void transport_segmented_setup_device_nonce(uint8_t * nonce, const mesh_p
     mesh_print_hex("DeviceNonce", nonce, 13);
 }
 
+static void mesh_upper_transport_key_cache_store(uint16_t src, uint16_t netkey_index, uint16_t appkey_index){
+    uint16_t i;
+    for (i = 0; i < MESH_UPPER_TRANSPORT_KEY_CACHE_SIZE; i++){
+        if ((key_cache[i].src == src) && (key_cache[i].netkey_index == netkey_index)){
+            key_cache[i].appkey_index = appkey_index;
+            return;
+        }
+    }
+    // replace oldest entry
+    key_cache[key_cache_next].src          = src;
+    key_cache[key_cache_next].netkey_index = netkey_index;
+    key_cache[key_cache_next].appkey_index = appkey_index;
+    key_cache_next++;
+    if (key_cache_next == MESH_UPPER_TRANSPORT_KEY_CACHE_SIZE){
+        key_cache_next = 0;
+    }
+}
+
+static const mesh_transport_key_t * mesh_upper_transport_key_cache_lookup(uint16_t src, uint16_t netkey_index, uint8_t aid){
+    uint16_t i;
+    for (i = 0; i < MESH_UPPER_TRANSPORT_KEY_CACHE_SIZE; i++){
+        if (key_cache[i].src != src) continue;
+        if (key_cache[i].netkey_index != netkey_index) continue;
+        // cached AppKey might have been removed or updated
+        mesh_transport_key_iterator_t it;
+        mesh_transport_key_aid_iterator_init(&it, netkey_index, 1, aid);
+        while (mesh_transport_key_aid_iterator_has_more(&it)){
+            const mesh_transport_key_t * key = mesh_transport_key_aid_iterator_get_next(&it);
+            if (key->appkey_index == key_cache[i].appkey_index){
+                return key;
+            }
+        }
+        return NULL;
+    }
+    return NULL;
+}
+
+static bool mesh_upper_transport_incoming_pdu_ctl(mesh_pdu_t * pdu){
+    switch (pdu->pdu_type){
+        case MESH_PDU_TYPE_UNSEGMENTED:
+            return mesh_network_control((mesh_network_pdu_t *) pdu) != 0;
+        case MESH_PDU_TYPE_SEGMENTED:
+            return (((mesh_segmented_pdu_t *) pdu)->ctl_ttl & 0x80) != 0;
+        default:
+            btstack_assert(false);
+            return false;
+    }
+}
+
+static mesh_upper_transport_decrypt_context_t * mesh_upper_transport_decrypt_context_allocate(void){
+    btstack_assert(decrypt_contexts_count < MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS);
+    uint16_t index = (decrypt_contexts_head + decrypt_contexts_count) % MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS;
+    decrypt_contexts_count++;
+    return &decrypt_contexts[index];
+}
+
+static mesh_upper_transport_decrypt_context_t * mesh_upper_transport_decrypt_context_oldest(void){
+    if (decrypt_contexts_count == 0u){
+        return NULL;
+    }
+    return &decrypt_contexts[decrypt_contexts_head];
+}
+
+static bool mesh_upper_transport_incoming_access_pdu_ready(void){
+    const mesh_upper_transport_decrypt_context_t * context = mesh_upper_transport_decrypt_context_oldest();
+    return (context != NULL) && (context->state == MESH_UPPER_TRANSPORT_DECRYPT_VALID);
+}
+
+static void mesh_upper_transport_decrypt_context_release(mesh_upper_transport_decrypt_context_t * context){
+    btstack_assert(context == mesh_upper_transport_decrypt_context_oldest());
+    btstack_assert((context->decrypted.ctl_ttl & 0x80) == 0);
+    mesh_lower_transport_message_processed_by_higher_layer(context->encrypted);
+    context->encrypted = NULL;
+    context->state = MESH_UPPER_TRANSPORT_DECRYPT_IDLE;
+    decrypt_contexts_head++;
+    if (decrypt_contexts_head == MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS){
+        decrypt_contexts_head = 0;
+    }
+    decrypt_contexts_count--;
+}
+
+static void mesh_upper_transport_process_decrypted_access_messages(void){
+    // drop messages without valid key in order of reception
+    while (true){
+        mesh_upper_transport_decrypt_context_t * context = mesh_upper_transport_decrypt_context_oldest();
+        if (context == NULL) break;
+        if (context->state != MESH_UPPER_TRANSPORT_DECRYPT_INVALID) break;
+        mesh_upper_transport_decrypt_context_release(context);
+    }
+    // pass oldest to upper layer
+    if (mesh_upper_transport_incoming_access_pdu_ready()){
+        mesh_upper_transport_schedule_send_requests();
+    }
+}
+
 static void mesh_upper_transport_process_access_message_done(mesh_access_pdu_t *access_pdu){
-    crypto_active = 0;
-    btstack_assert((access_pdu->ctl_ttl & 0x80) == 0);
-    mesh_lower_transport_message_processed_by_higher_layer(incoming_access_encrypted);
-    incoming_access_encrypted = NULL;
-    incoming_access_decrypted = NULL;
+    mesh_upper_transport_decrypt_context_t * context = mesh_upper_transport_decrypt_context_oldest();
+    btstack_assert(context != NULL);
+    btstack_assert(access_pdu == &context->decrypted);
+    UNUSED(access_pdu);
+    mesh_upper_transport_decrypt_context_release(context);
+    mesh_upper_transport_process_decrypted_access_messages();
     mesh_upper_transport_run();
 }
 
 static void mesh_upper_transport_process_control_message_done(mesh_control_pdu_t * control_pdu){
     UNUSED(control_pdu);
-    crypto_active = 0;
     incoming_control_pdu = NULL;
     mesh_upper_transport_run();
 }
@@ -422,12 +569,13 @@ static void mesh_upper_transport_need_pdu_for_run_outgoing(void) {
 }
 
 static void mesh_upper_transport_deliver_access_message(void) {
-    incoming_access_pdu_ready = false;
-    mesh_access_message_handler(MESH_TRANSPORT_PDU_RECEIVED, MESH_TRANSPORT_STATUS_SUCCESS, (mesh_pdu_t *) incoming_access_decrypted);
+    mesh_upper_transport_decrypt_context_t * context = mesh_upper_transport_decrypt_context_oldest();
+    context->state = MESH_UPPER_TRANSPORT_DECRYPT_DELIVERED;
+    mesh_access_message_handler(MESH_TRANSPORT_PDU_RECEIVED, MESH_TRANSPORT_STATUS_SUCCESS, (mesh_pdu_t *) &context->decrypted);
 }
 
 static bool mesh_upper_transport_send_requests_pending(void){
-    if (incoming_access_pdu_ready) {
+    if (mesh_upper_transport_incoming_access_pdu_ready()) {
         return true;
     }
     return btstack_linked_list_empty(&upper_transport_send_requests) == false;
@@ -453,7 +601,7 @@ static void mesh_upper_transport_schedule_send_requests(void){
         // process send requests
 
         // incoming access pdu
-        if (incoming_access_pdu_ready){
+        if (mesh_upper_transport_incoming_access_pdu_ready()){
             // message builder ready = one outgoing pdu is guaranteed, deliver access pdu
             mesh_upper_transport_deliver_access_message();
             continue;
@@ -471,133 +619,169 @@ void mesh_upper_transport_request_to_send(btstack_context_callback_registration_
     mesh_upper_transport_schedule_send_requests();
 }
 
+static void mesh_upper_transport_validate_access_message_done(mesh_upper_transport_decrypt_context_t * context, bool valid){
+    mesh_access_pdu_t * access_pdu = &context->decrypted;
+    if (valid){
+        uint8_t transmic_len = ((access_pdu->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
+
+        // remember AppKey for next message from this source
+        if (context->key->akf && !mesh_network_address_virtual(access_pdu->dst)){
+            mesh_upper_transport_key_cache_store(access_pdu->src, access_pdu->netkey_index, context->key->appkey_index);
+        }
+
+        // remove TransMIC from payload
+        access_pdu->len -= transmic_len;
+
+        // if virtual address, update dst to pseudo_dst
+        if (mesh_network_address_virtual(access_pdu->dst)){
+            access_pdu->dst = context->key_it.address->pseudo_dst;
+        }
+    }
+    context->state = valid ? MESH_UPPER_TRANSPORT_DECRYPT_VALID : MESH_UPPER_TRANSPORT_DECRYPT_INVALID;
+    mesh_upper_transport_process_decrypted_access_messages();
+}
+
+// @return next key to try, cached key first
+static const mesh_transport_key_t * mesh_upper_transport_validate_access_message_next_key(mesh_upper_transport_decrypt_context_t * context){
+    if ((context->cached_key != NULL) && (context->key == NULL)){
+        return context->cached_key;
+    }
+    while (mesh_transport_key_and_virtual_address_iterator_has_more(&context->key_it)){
+        mesh_transport_key_and_virtual_address_iterator_next(&context->key_it);
+        if (context->key_it.key != context->cached_key){
+            return context->key_it.key;
+        }
+    }
+    return NULL;
+}
+
+// copy encrypted payload into decrypted pdu, decryption is done in place
+static void mesh_upper_transport_validate_access_message_load(mesh_upper_transport_decrypt_context_t * context){
+    mesh_access_pdu_t * access_pdu = &context->decrypted;
+    mesh_network_pdu_t * unsegmented_pdu;
+    mesh_segmented_pdu_t * segmented_pdu;
+    switch (context->encrypted->pdu_type){
+        case MESH_PDU_TYPE_SEGMENTED:
+            segmented_pdu = (mesh_segmented_pdu_t *) context->encrypted;
+            mesh_segmented_pdu_flatten(&segmented_pdu->segments, 12, access_pdu->data);
+            break;
+        case MESH_PDU_TYPE_UNSEGMENTED:
+            unsegmented_pdu = (mesh_network_pdu_t *) context->encrypted;
+            (void)memcpy(access_pdu->data, &unsegmented_pdu->data[10], access_pdu->len);
+            break;
+        default:
+            btstack_assert(false);
+            break;
+    }
+}
+
+static void mesh_upper_transport_validate_access_message_setup(mesh_upper_transport_decrypt_context_t * context, const mesh_transport_key_t * message_key){
+    context->key = message_key;
+    if (message_key->akf){
+        transport_segmented_setup_application_nonce(context->nonce, (mesh_pdu_t *) &context->decrypted);
+    } else {
+        transport_segmented_setup_device_nonce(context->nonce, (mesh_pdu_t *) &context->decrypted);
+    }
+
+    // store application / device key index
+    mesh_print_hex("AppOrDevKey", message_key->key, 16);
+    context->decrypted.appkey_index = message_key->appkey_index;
+
+    mesh_upper_transport_validate_access_message_load(context);
+}
+
 static void mesh_upper_transport_validate_access_message_ccm(void * arg){
-    UNUSED(arg);
+    mesh_upper_transport_decrypt_context_t * context = (mesh_upper_transport_decrypt_context_t *) arg;
+    mesh_access_pdu_t * access_pdu = &context->decrypted;
 
-    uint8_t transmic_len = ((incoming_access_decrypted->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
-    uint8_t * upper_transport_pdu     = incoming_access_decrypted->data;
-    uint8_t   upper_transport_pdu_len = incoming_access_decrypted->len - transmic_len;
+    uint8_t transmic_len = ((access_pdu->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
+    uint8_t * upper_transport_pdu     = access_pdu->data;
+    uint8_t   upper_transport_pdu_len = access_pdu->len - transmic_len;
  
     mesh_print_hex("Decrypted PDU", upper_transport_pdu, upper_transport_pdu_len);
 
     // store TransMIC
     uint8_t trans_mic[8];
-    btstack_crypto_ccm_get_authentication_value(&ccm, trans_mic);
+    btstack_crypto_ccm_get_authentication_value(&context->ccm, trans_mic);
     mesh_print_hex("TransMIC", trans_mic, transmic_len);
 
     if (memcmp(trans_mic, &upper_transport_pdu[upper_transport_pdu_len], transmic_len) == 0){
         printf("TransMIC matches\n");
-
-        // remove TransMIC from payload
-        incoming_access_decrypted->len -= transmic_len;
-
-        // if virtual address, update dst to pseudo_dst
-        if (mesh_network_address_virtual(incoming_access_decrypted->dst)){
-            incoming_access_decrypted->dst = mesh_transport_key_it.address->pseudo_dst;
-        }
-
-        // pass to upper layer
-        incoming_access_pdu_ready = true;
-        mesh_upper_transport_schedule_send_requests();
-
+        mesh_upper_transport_validate_access_message_done(context, true);
     } else {
-        uint8_t akf = incoming_access_decrypted->akf_aid_control & 0x40;
+        uint8_t akf = access_pdu->akf_aid_control & 0x40;
         if (akf){
             printf("TransMIC does not match, try next key\n");
-            mesh_upper_transport_validate_access_message();
+            mesh_upper_transport_validate_access_message(context);
         } else {
             printf("TransMIC does not match device key, done\n");
             // done
-            mesh_upper_transport_process_access_message_done(incoming_access_decrypted);
+            mesh_upper_transport_validate_access_message_done(context, false);
         }
     }
+    // decrypt contexts might have become available
+    mesh_upper_transport_run();
 }
 
 static void mesh_upper_transport_validate_access_message_digest(void * arg){
-    UNUSED(arg);
-    uint8_t   transmic_len = ((incoming_access_decrypted->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
-    uint8_t   upper_transport_pdu_len      = incoming_access_decrypted->len - transmic_len;
-    uint8_t * upper_transport_pdu_data_out = incoming_access_decrypted->data;
-
-    mesh_network_pdu_t * unsegmented_pdu = NULL;
-    mesh_segmented_pdu_t * segmented_pdu = NULL;
-    switch (incoming_access_encrypted->pdu_type){
-        case MESH_PDU_TYPE_SEGMENTED:
-            segmented_pdu = (mesh_segmented_pdu_t *) incoming_access_encrypted;
-            mesh_segmented_pdu_flatten(&segmented_pdu->segments, 12, upper_transport_pdu_data_out);
-            mesh_print_hex("Encrypted Payload:", upper_transport_pdu_data_out, upper_transport_pdu_len);
-            btstack_crypto_ccm_decrypt_block(&ccm, upper_transport_pdu_len, upper_transport_pdu_data_out, upper_transport_pdu_data_out,
-                                             &mesh_upper_transport_validate_access_message_ccm, NULL);
-            break;
-        case MESH_PDU_TYPE_UNSEGMENTED:
-            unsegmented_pdu = (mesh_network_pdu_t *) incoming_access_encrypted;
-            (void)memcpy(upper_transport_pdu_data_out, &unsegmented_pdu->data[10], incoming_access_decrypted->len);
-            btstack_crypto_ccm_decrypt_block(&ccm, upper_transport_pdu_len, upper_transport_pdu_data_out, upper_transport_pdu_data_out,
-                                             &mesh_upper_transport_validate_access_message_ccm, NULL);
-            break;
-        default:
-            btstack_assert(false);
-            break;
-    }
-
+    mesh_upper_transport_decrypt_context_t * context = (mesh_upper_transport_decrypt_context_t *) arg;
+    mesh_access_pdu_t * access_pdu = &context->decrypted;
+    uint8_t   transmic_len = ((access_pdu->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
+    uint8_t   upper_transport_pdu_len      = access_pdu->len - transmic_len;
+    uint8_t * upper_transport_pdu_data_out = access_pdu->data;
+
+    mesh_print_hex("Encrypted Payload:", upper_transport_pdu_data_out, upper_transport_pdu_len);
+    btstack_crypto_ccm_decrypt_block(&context->ccm, upper_transport_pdu_len, upper_transport_pdu_data_out, upper_transport_pdu_data_out,
+                                     &mesh_upper_transport_validate_access_message_ccm, context);
 }
 
-static void mesh_upper_transport_validate_access_message(void){
-    uint8_t   transmic_len = ((incoming_access_decrypted->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
-    uint8_t * upper_transport_pdu_data =  incoming_access_decrypted->data;
-    uint8_t   upper_transport_pdu_len  = incoming_access_decrypted->len - transmic_len;
+static void mesh_upper_transport_validate_access_message(mesh_upper_transport_decrypt_context_t * context){
+    mesh_access_pdu_t * access_pdu = &context->decrypted;
+    uint8_t   transmic_len = ((access_pdu->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
+    uint8_t   upper_transport_pdu_len  = access_pdu->len - transmic_len;
 
-    if (!mesh_transport_key_and_virtual_address_iterator_has_more(&mesh_transport_key_it)){
+    const mesh_transport_key_t * message_key = mesh_upper_transport_validate_access_message_next_key(context);
+    if (message_key == NULL){
         printf("No valid transport key found\n");
-        mesh_upper_transport_process_access_message_done(incoming_access_decrypted);
+        mesh_upper_transport_validate_access_message_done(context, false);
         return;
     }
-    mesh_transport_key_and_virtual_address_iterator_next(&mesh_transport_key_it);
-    const mesh_transport_key_t * message_key = mesh_transport_key_it.key;
-
-    if (message_key->akf){
-        transport_segmented_setup_application_nonce(application_nonce, (mesh_pdu_t *) incoming_access_decrypted);
-    } else {
-        transport_segmented_setup_device_nonce(application_nonce, (mesh_pdu_t *) incoming_access_decrypted);
-    }
-
-    // store application / device key index
-    mesh_print_hex("AppOrDevKey", message_key->key, 16);
-    incoming_access_decrypted->appkey_index = message_key->appkey_index;
+    mesh_upper_transport_validate_access_message_setup(context, message_key);
 
-    mesh_print_hex("EncAccessPayload", upper_transport_pdu_data, upper_transport_pdu_len);
+    mesh_print_hex("EncAccessPayload", access_pdu->data, upper_transport_pdu_len);
 
     // decrypt ccm
-    crypto_active = 1;
     uint16_t aad_len  = 0;
-    if (mesh_network_address_virtual(incoming_access_decrypted->dst)){
+    if (mesh_network_address_virtual(access_pdu->dst)){
         aad_len  = 16;
     }
-    btstack_crypto_ccm_init(&ccm, message_key->key, application_nonce, upper_transport_pdu_len, aad_len, transmic_len);
+    btstack_crypto_ccm_init(&context->ccm, message_key->key, context->nonce, upper_transport_pdu_len, aad_len, transmic_len);
 
     if (aad_len){
-        btstack_crypto_ccm_digest(&ccm, (uint8_t *) mesh_transport_key_it.address->label_uuid, aad_len,
-                                  &mesh_upper_transport_validate_access_message_digest, NULL);
+        btstack_crypto_ccm_digest(&context->ccm, (uint8_t *) context->key_it.address->label_uuid, aad_len,
+                                  &mesh_upper_transport_validate_access_message_digest, context);
     } else {
-        mesh_upper_transport_validate_access_message_digest(NULL);
+        mesh_upper_transport_validate_access_message_digest(context);
     }
 }
 
-static void mesh_upper_transport_process_access_message(void){
-    uint8_t   transmic_len = ((incoming_access_decrypted->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
-    uint8_t * upper_transport_pdu     =  incoming_access_decrypted->data;
-    uint8_t   upper_transport_pdu_len = incoming_access_decrypted->len - transmic_len;
-    mesh_print_hex("Upper Transport pdu", upper_transport_pdu, upper_transport_pdu_len);
-
-    uint8_t aid = incoming_access_decrypted->akf_aid_control & 0x3f;
-    uint8_t akf = (incoming_access_decrypted->akf_aid_control & 0x40) >> 6;
+static void mesh_upper_transport_process_access_message(mesh_upper_transport_decrypt_context_t * context){
+    mesh_access_pdu_t * access_pdu = &context->decrypted;
+    uint8_t aid = access_pdu->akf_aid_control & 0x3f;
+    uint8_t akf = (access_pdu->akf_aid_control & 0x40) >> 6;
 
     printf("AKF: %u\n",   akf);
     printf("AID: %02x\n", aid);
 
-    mesh_transport_key_and_virtual_address_iterator_init(&mesh_transport_key_it, incoming_access_decrypted->dst,
-                                                         incoming_access_decrypted->netkey_index, akf, aid);
-    mesh_upper_transport_validate_access_message();
+    context->state = MESH_UPPER_TRANSPORT_DECRYPT_ACTIVE;
+    context->key = NULL;
+    context->cached_key = NULL;
+    if (akf && !mesh_network_address_virtual(access_pdu->dst)){
+        context->cached_key = mesh_upper_transport_key_cache_lookup(access_pdu->src, access_pdu->netkey_index, aid);
+    }
+    mesh_transport_key_and_virtual_address_iterator_init(&context->key_it, access_pdu->dst,
+                                                         access_pdu->netkey_index, akf, aid);
+    mesh_upper_transport_validate_access_message(context);
 }
 
 static void mesh_upper_transport_message_received(mesh_pdu_t * pdu){
@@ -613,7 +797,7 @@ static void mesh_upper_transport_send_access_segmented(mesh_upper_transport_pdu_
     // convert mesh_access_pdu_t into mesh_segmented_pdu_t
     btstack_linked_list_t free_segments = segmented_pdu->segments;
     segmented_pdu->segments = NULL;
-    mesh_segmented_store_payload(incoming_pdu_singleton.access.data, upper_pdu->len, &free_segments, &segmented_pdu->segments);
+    mesh_segmented_store_payload(outgoing_access_buffer, upper_pdu->len, &free_segments, &segmented_pdu->segments);
 
     // copy meta
     segmented_pdu->len = upper_pdu->len;
@@ -654,7 +838,7 @@ static void mesh_upper_transport_send_access_unsegmented(mesh_upper_transport_pd
     // setup access message
     network_pdu->data[9] = upper_pdu->akf_aid_control;
     btstack_assert(upper_pdu->len < 15);
-    (void)memcpy(&network_pdu->data[10], &incoming_pdu_singleton.access.data, upper_pdu->len);
+    (void)memcpy(&network_pdu->data[10], &outgoing_access_buffer, upper_pdu->len);
     network_pdu->len = 10 + upper_pdu->len;
     network_pdu->flags = 0;
 
@@ -668,13 +852,13 @@ static void mesh_upper_transport_send_access_ccm(void * arg){
     crypto_active = 0;
 
     mesh_upper_transport_pdu_t * upper_pdu = (mesh_upper_transport_pdu_t *) arg;
-    mesh_print_hex("EncAccessPayload", incoming_pdu_singleton.access.data, upper_pdu->len);
+    mesh_print_hex("EncAccessPayload", outgoing_access_buffer, upper_pdu->len);
     // store TransMIC
-    btstack_crypto_ccm_get_authentication_value(&ccm, &incoming_pdu_singleton.access.data[upper_pdu->len]);
+    btstack_crypto_ccm_get_authentication_value(&ccm, &outgoing_access_buffer[upper_pdu->len]);
     uint8_t transmic_len = ((upper_pdu->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
-    mesh_print_hex("TransMIC", &incoming_pdu_singleton.access.data[upper_pdu->len], transmic_len);
+    mesh_print_hex("TransMIC", &outgoing_access_buffer[upper_pdu->len], transmic_len);
     upper_pdu->len += transmic_len;
-    mesh_print_hex("UpperTransportPDU", incoming_pdu_singleton.access.data, upper_pdu->len);
+    mesh_print_hex("UpperTransportPDU", outgoing_access_buffer, upper_pdu->len);
     switch (upper_pdu->pdu_header.pdu_type){
         case MESH_PDU_TYPE_UPPER_UNSEGMENTED_ACCESS:
             mesh_upper_transport_send_access_unsegmented(upper_pdu);
@@ -690,7 +874,7 @@ static void mesh_upper_transport_send_access_ccm(void * arg){
 static void mesh_upper_transport_send_access_digest(void *arg){
     mesh_upper_transport_pdu_t * upper_pdu = (mesh_upper_transport_pdu_t *) arg;
     uint16_t  access_pdu_len  = upper_pdu->len;
-    btstack_crypto_ccm_encrypt_block(&ccm, access_pdu_len, incoming_pdu_singleton.access.data, incoming_pdu_singleton.access.data,
+    btstack_crypto_ccm_encrypt_block(&ccm, access_pdu_len, outgoing_access_buffer, outgoing_access_buffer,
                                      &mesh_upper_transport_send_access_ccm, upper_pdu);
 }
 
@@ -733,13 +917,13 @@ static void mesh_upper_transport_send_access(mesh_upper_transport_pdu_t * upper_
     crypto_active = 1;
 
     // flatten segmented pdu into crypto buffer
-    uint16_t payload_len = mesh_upper_pdu_flatten(upper_pdu, incoming_pdu_singleton.access.data, sizeof(incoming_pdu_singleton.access.data));
+    uint16_t payload_len = mesh_upper_pdu_flatten(upper_pdu, outgoing_access_buffer, sizeof(outgoing_access_buffer));
     btstack_assert(payload_len == upper_pdu->len);
     UNUSED(payload_len);
     
     // Dump PDU
     printf("[+] Upper transport, send upper (un)segmented Access PDU - dest %04x, seq %06" PRIx32 "\n", upper_pdu->dst, upper_pdu->seq);
-    mesh_print_hex("Access Payload", incoming_pdu_singleton.access.data, upper_pdu->len);
+    mesh_print_hex("Access Payload", outgoing_access_buffer, upper_pdu->len);
 
     // setup nonce - uses dst, so after pseudo address translation
     if (appkey_index == MESH_DEVICE_KEY_INDEX){
@@ -825,10 +1009,17 @@ static void mesh_upper_transport_run(void){
 
     while(!btstack_linked_list_empty(&upper_transport_incoming)){
 
-        if (crypto_active) return;
+        // control messages are delivered after all earlier access messages, access messages need a decrypt context
+        mesh_pdu_t * pdu = (mesh_pdu_t *) btstack_linked_list_get_first_item(&upper_transport_incoming);
+        if (mesh_upper_transport_incoming_pdu_ctl(pdu)){
+            if (decrypt_contexts_count > 0u) return;
+        } else {
+            if (decrypt_contexts_count == MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS) return;
+        }
 
         // get next message
-        mesh_pdu_t * pdu =  (mesh_pdu_t *) btstack_linked_list_pop(&upper_transport_incoming);
+        (void) btstack_linked_list_pop(&upper_transport_incoming);
+        mesh_upper_transport_decrypt_context_t * context;
         mesh_network_pdu_t   * network_pdu;
         mesh_segmented_pdu_t   * segmented_pdu;
         switch (pdu->pdu_type){
@@ -837,7 +1028,7 @@ static void mesh_upper_transport_run(void){
                 // control?
                 if (mesh_network_control(network_pdu)) {
 
-                    incoming_control_pdu =  &incoming_pdu_singleton.control;
+                    incoming_control_pdu =  &incoming_control_pdu_singleton;
                     incoming_control_pdu->pdu_header.pdu_type = MESH_PDU_TYPE_CONTROL;
                     incoming_control_pdu->len =  network_pdu->len;
                     incoming_control_pdu->netkey_index =  network_pdu->netkey_index;
@@ -865,9 +1056,10 @@ static void mesh_upper_transport_run(void){
 
                 } else {
 
-                    incoming_access_encrypted = (mesh_pdu_t *) network_pdu;
+                    context = mesh_upper_transport_decrypt_context_allocate();
+                    context->encrypted = (mesh_pdu_t *) network_pdu;
 
-                    incoming_access_decrypted = &incoming_pdu_singleton.access;
+                    mesh_access_pdu_t * incoming_access_decrypted = &context->decrypted;
                     incoming_access_decrypted->pdu_header.pdu_type = MESH_PDU_TYPE_ACCESS;
                     incoming_access_decrypted->flags = 0;
                     incoming_access_decrypted->netkey_index = network_pdu->netkey_index;
@@ -879,14 +1071,14 @@ static void mesh_upper_transport_run(void){
                     incoming_access_decrypted->src = big_endian_read_16(network_pdu->data, 5);
                     incoming_access_decrypted->dst = big_endian_read_16(network_pdu->data, 7);
 
-                    mesh_upper_transport_process_access_message();
+                    mesh_upper_transport_process_access_message(context);
                 }
                 break;
             case MESH_PDU_TYPE_SEGMENTED:
                 segmented_pdu = (mesh_segmented_pdu_t *) pdu;
                 uint8_t ctl = segmented_pdu->ctl_ttl >> 7;
                 if (ctl){
-                    incoming_control_pdu=  &incoming_pdu_singleton.control;
+                    incoming_control_pdu=  &incoming_control_pdu_singleton;
                     incoming_control_pdu->pdu_header.pdu_type = MESH_PDU_TYPE_CONTROL;
 
                     // flatten
@@ -913,9 +1105,10 @@ static void mesh_upper_transport_run(void){
 
                 } else {
 
-                    incoming_access_encrypted = (mesh_pdu_t *) segmented_pdu;
+                    context = mesh_upper_transport_decrypt_context_allocate();
+                    context->encrypted = (mesh_pdu_t *) segmented_pdu;
 
-                    incoming_access_decrypted = &incoming_pdu_singleton.access;
+                    mesh_access_pdu_t * incoming_access_decrypted = &context->decrypted;
                     incoming_access_decrypted->pdu_header.pdu_type = MESH_PDU_TYPE_ACCESS;
                     incoming_access_decrypted->flags = segmented_pdu->flags;
                     incoming_access_decrypted->len =  segmented_pdu->len;
@@ -927,7 +1120,7 @@ static void mesh_upper_transport_run(void){
                     incoming_access_decrypted->src = segmented_pdu->src;
                     incoming_access_decrypted->dst = segmented_pdu->dst;
 
-                    mesh_upper_transport_process_access_message();
+                    mesh_upper_transport_process_access_message(context);
                 }
                 break;
             default:
@@ -1129,7 +1322,6 @@ void mesh_upper_transport_pdu_free(mesh_pdu_t * pdu){
 }
 
 void mesh_upper_transport_message_processed_by_higher_layer(mesh_pdu_t * pdu){
-    crypto_active = 0;
     switch (pdu->pdu_type){
         case MESH_PDU_TYPE_ACCESS:
             mesh_upper_transport_process_access_message_done((mesh_access_pdu_t *) pdu);
@@ -909,6 +909,78 @@ TEST(AttDb, att_read_callback_handle_little_endian_32){
 }
 
 
+#ifdef ENABLE_ATT_DB_INDEX
+// build index like compile_gatt.py: number of attributes, offsets of attributes and END marker relative to first attribute
+static uint16_t build_db_index(const uint8_t * db, uint16_t * index, uint16_t max_entries){
+	uint16_t num_attributes = 0;
+	uint16_t offset = 0;
+	const uint8_t * attributes = &db[1];
+	while (little_endian_read_16(attributes, offset) != 0){
+		CHECK_TRUE(num_attributes + 2u < max_entries);
+		index[1 + num_attributes++] = offset;
+		offset += little_endian_read_16(attributes, offset);
+	}
+	index[1 + num_attributes] = offset;
+	index[0] = num_attributes;
+	return num_attributes;
+}
+
+static uint16_t att_request_with_range(uint8_t request_type, uint16_t start_handle, uint16_t end_handle, uint16_t uuid16){
+	att_request[0] = request_type;
+	little_endian_store_16(att_request, 1, start_handle);
+	little_endian_store_16(att_request, 3, end_handle);
+	if (request_type == ATT_FIND_INFORMATION_REQUEST){
+		return 5;
+	}
+	little_endian_store_16(att_request, 5, uuid16);
+	return 7;
+}
+
+TEST(AttDb, att_db_index){
+	static uint16_t index[50];
+	static uint8_t  response_without_index[sizeof(att_response)];
+	const uint8_t * db = att_db_util_get_address();
+	uint16_t num_attributes = build_db_index(db, index, sizeof(index) / sizeof(uint16_t));
+	CHECK_TRUE(num_attributes > 0);
+
+	const uint8_t request_types[] = { ATT_FIND_INFORMATION_REQUEST, ATT_READ_BY_TYPE_REQUEST, ATT_READ_BY_GROUP_TYPE_REQUEST, ATT_READ_REQUEST };
+	const uint16_t uuids[] = { GATT_CHARACTERISTICS_UUID, GATT_CHARACTERISTICS_UUID, GATT_PRIMARY_SERVICE_UUID, 0 };
+	uint16_t i;
+	for (i = 0; i < sizeof(request_types); i++){
+		uint16_t start_handle;
+		for (start_handle = 1; start_handle <= (num_attributes + 2u); start_handle++){
+			if (request_types[i] == ATT_READ_REQUEST){
+				att_request[0] = ATT_READ_REQUEST;
+				little_endian_store_16(att_request, 1, start_handle);
+				att_request_len = 3;
+			} else {
+				att_request_len = att_request_with_range(request_types[i], start_handle, 0xffff, uuids[i]);
+			}
+
+			// linear scan
+			att_set_db(db);
+			uint16_t response_len_without_index = att_handle_request(&att_connection, (uint8_t *) att_request, att_request_len, response_without_index);
+
+			// binary search with index
+			att_set_db_index(index);
+			att_response_len = att_handle_request(&att_connection, (uint8_t *) att_request, att_request_len, att_response);
+
+			CHECK_EQUAL(response_len_without_index, att_response_len);
+			MEMCMP_EQUAL(response_without_index, att_response, att_response_len);
+		}
+	}
+
+	// lookup by handle via index
+	att_set_db_index(index);
+	CHECK_EQUAL(0x2A38, att_uuid_for_handle(0x0011));
+	CHECK_EQUAL(0, att_uuid_for_handle(0xFF00));
+
+	// index is cleared by att_set_db
+	att_set_db(db);
+	CHECK_EQUAL(0x2A38, att_uuid_for_handle(0x0011));
+}
+#endif
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
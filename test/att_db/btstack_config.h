@@ -12,6 +12,7 @@
 #define HAVE_POSIX_TIME
 
 // BTstack features that can be enabled
+#define ENABLE_ATT_DB_INDEX
 #define ENABLE_ATT_DELAYED_RESPONSE
 #define ENABLE_BLE
 #define ENABLE_LE_CENTRAL
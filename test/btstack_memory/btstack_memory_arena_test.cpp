@@ -0,0 +1,239 @@
+// *****************************************************************************
+//
+// test memory arena and compare allocation cost against malloc
+//
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef ENABLE_BTSTACK_MEMORY_ARENA_THREAD_SAFE
+#include <pthread.h>
+#endif
+
+// malloc hook
+static int simulate_no_memory;
+extern "C" void * test_malloc(size_t size);
+void * test_malloc(size_t size){
+    if (simulate_no_memory) return NULL;
+    return malloc(size);
+}
+
+#include "btstack_config.h"
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_memory.h"
+#include "btstack_memory_pool.h"
+
+#define BENCHMARK_NUM_LIVE_BLOCKS 64
+#define BENCHMARK_NUM_OPERATIONS  1000000
+
+typedef struct {
+    uint8_t  data[100];
+} test_block_t;
+
+static uint32_t get_time_ns(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) ((now.tv_sec * 1000000000ull) + now.tv_nsec);
+}
+
+TEST_GROUP(MemoryArena){
+    btstack_memory_arena_t arena;
+
+    void setup(void){
+        simulate_no_memory = 0;
+        btstack_memory_arena_init(&arena, "test", sizeof(test_block_t));
+    }
+    void teardown(void){
+        btstack_memory_arena_deinit(&arena);
+    }
+};
+
+TEST(MemoryArena, BlockSizeAligned){
+    CHECK_EQUAL(0, (int) (arena.block_size % sizeof(void *)));
+    CHECK(arena.block_size >= sizeof(test_block_t));
+}
+
+TEST(MemoryArena, GetAndFree){
+    test_block_t * block = (test_block_t *) btstack_memory_arena_get(&arena);
+    CHECK(block != NULL);
+    CHECK_EQUAL(1, arena.num_blocks_in_use);
+    CHECK_EQUAL(1, arena.num_slabs);
+    btstack_memory_arena_free(&arena, block);
+    CHECK_EQUAL(0, arena.num_blocks_in_use);
+    // block is re-used
+    CHECK_EQUAL(block, btstack_memory_arena_get(&arena));
+}
+
+TEST(MemoryArena, GrowAndHighWaterMark){
+    test_block_t * blocks[(3 * BTSTACK_MEMORY_ARENA_BLOCKS_PER_SLAB) + 1];
+    uint16_t num_blocks = sizeof(blocks) / sizeof(test_block_t *);
+    uint16_t i;
+    for (i = 0; i < num_blocks; i++){
+        blocks[i] = (test_block_t *) btstack_memory_arena_get(&arena);
+        CHECK(blocks[i] != NULL);
+        memset(blocks[i], i, sizeof(test_block_t));
+    }
+    CHECK_EQUAL(4, arena.num_slabs);
+    for (i = 0; i < num_blocks; i++){
+        CHECK_EQUAL((uint8_t) i, blocks[i]->data[sizeof(test_block_t) - 1]);
+        btstack_memory_arena_free(&arena, blocks[i]);
+    }
+    CHECK_EQUAL(0, arena.num_blocks_in_use);
+    CHECK_EQUAL(num_blocks, arena.high_water_mark);
+    CHECK_EQUAL(num_blocks, arena.num_allocations);
+    // slabs are kept
+    for (i = 0; i < num_blocks; i++){
+        blocks[i] = (test_block_t *) btstack_memory_arena_get(&arena);
+    }
+    CHECK_EQUAL(4, arena.num_slabs);
+}
+
+TEST(MemoryArena, NotEnoughMemory){
+    simulate_no_memory = 1;
+    CHECK(btstack_memory_arena_get(&arena) == NULL);
+    CHECK_EQUAL(0, arena.num_blocks_in_use);
+}
+
+TEST(MemoryArena, Iterator){
+    btstack_linked_list_iterator_t it;
+    btstack_memory_arenas_get_iterator(&it);
+    bool found = false;
+    while (btstack_linked_list_iterator_has_next(&it)){
+        if (btstack_linked_list_iterator_next(&it) == (btstack_linked_item_t *) &arena){
+            found = true;
+        }
+    }
+    CHECK_TRUE(found);
+    btstack_memory_arenas_log_usage();
+}
+
+#ifdef ENABLE_BTSTACK_MEMORY_ARENA_THREAD_SAFE
+#define NUM_THREADS 4
+static void * thread_churn(void * context){
+    btstack_memory_arena_t * arena = (btstack_memory_arena_t *) context;
+    test_block_t * blocks[16];
+    int round;
+    for (round = 0; round < 10000; round++){
+        int i;
+        for (i = 0; i < 16; i++){
+            blocks[i] = (test_block_t *) btstack_memory_arena_get(arena);
+            blocks[i]->data[0] = (uint8_t) i;
+        }
+        for (i = 0; i < 16; i++){
+            btstack_memory_arena_free(arena, blocks[i]);
+        }
+    }
+    return NULL;
+}
+
+TEST(MemoryArena, ThreadSafe){
+    pthread_t threads[NUM_THREADS];
+    int i;
+    for (i = 0; i < NUM_THREADS; i++){
+        pthread_create(&threads[i], NULL, &thread_churn, &arena);
+    }
+    for (i = 0; i < NUM_THREADS; i++){
+        pthread_join(threads[i], NULL);
+    }
+    CHECK_EQUAL(0, arena.num_blocks_in_use);
+    CHECK(arena.high_water_mark <= (NUM_THREADS * 16));
+}
+
+// init and deinit own arenas while other threads do the same and log usage of all arenas
+static void * thread_register(void * context){
+    (void) context;
+    btstack_memory_arena_t thread_arena;
+    int round;
+    for (round = 0; round < 1000; round++){
+        btstack_memory_arena_init(&thread_arena, "thread", sizeof(test_block_t));
+        btstack_memory_arena_free(&thread_arena, btstack_memory_arena_get(&thread_arena));
+        btstack_memory_arenas_log_usage();
+        btstack_memory_arena_deinit(&thread_arena);
+    }
+    return NULL;
+}
+
+TEST(MemoryArena, ThreadSafeRegistry){
+    pthread_t threads[NUM_THREADS];
+    int i;
+    for (i = 0; i < NUM_THREADS; i++){
+        pthread_create(&threads[i], NULL, &thread_register, NULL);
+    }
+    for (i = 0; i < NUM_THREADS; i++){
+        pthread_join(threads[i], NULL);
+    }
+    // all thread arenas have been removed, arena of test group is still registered
+    btstack_linked_list_iterator_t it;
+    int num_arenas = 0;
+    btstack_memory_arena_lock();
+    btstack_memory_arenas_get_iterator(&it);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        CHECK_EQUAL(&arena, (btstack_memory_arena_t *) btstack_linked_list_iterator_next(&it));
+        num_arenas++;
+    }
+    btstack_memory_arena_unlock();
+    CHECK_EQUAL(1, num_arenas);
+}
+#endif
+
+TEST_GROUP(MemoryArenaBenchmark){
+    void setup(void){
+        simulate_no_memory = 0;
+        btstack_memory_init();
+    }
+    void teardown(void){
+        btstack_memory_deinit();
+    }
+};
+
+// replace random live L2CAP channel, similar to connection and channel churn on a gateway
+TEST(MemoryArenaBenchmark, L2capChannelChurn){
+    static l2cap_channel_t * live_channels[BENCHMARK_NUM_LIVE_BLOCKS];
+    uint32_t i;
+
+    srand(0);
+    uint32_t start = get_time_ns();
+    for (i = 0; i < BENCHMARK_NUM_OPERATIONS; i++){
+        uint32_t index = ((uint32_t) rand()) % BENCHMARK_NUM_LIVE_BLOCKS;
+        free(live_channels[index]);
+        live_channels[index] = (l2cap_channel_t *) malloc(sizeof(l2cap_channel_t));
+        memset(live_channels[index], 0, sizeof(l2cap_channel_t));
+    }
+    uint32_t time_malloc_ns = get_time_ns() - start;
+    for (i = 0; i < BENCHMARK_NUM_LIVE_BLOCKS; i++){
+        free(live_channels[i]);
+        live_channels[i] = NULL;
+    }
+
+    srand(0);
+    start = get_time_ns();
+    for (i = 0; i < BENCHMARK_NUM_OPERATIONS; i++){
+        uint32_t index = ((uint32_t) rand()) % BENCHMARK_NUM_LIVE_BLOCKS;
+        if (live_channels[index] != NULL){
+            btstack_memory_l2cap_channel_free(live_channels[index]);
+        }
+        live_channels[index] = btstack_memory_l2cap_channel_get();
+    }
+    uint32_t time_arena_ns = get_time_ns() - start;
+    for (i = 0; i < BENCHMARK_NUM_LIVE_BLOCKS; i++){
+        btstack_memory_l2cap_channel_free(live_channels[i]);
+        live_channels[i] = NULL;
+    }
+
+    printf("l2cap_channel_t (%u bytes), %u live: malloc %u ns/op, arena %u ns/op\n",
+           (unsigned int) sizeof(l2cap_channel_t), BENCHMARK_NUM_LIVE_BLOCKS,
+           (unsigned int) (time_malloc_ns / BENCHMARK_NUM_OPERATIONS),
+           (unsigned int) (time_arena_ns / BENCHMARK_NUM_OPERATIONS));
+    btstack_memory_log_usage();
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
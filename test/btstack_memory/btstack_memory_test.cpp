@@ -64,6 +64,9 @@ TEST_GROUP(btstack_memory){
         btstack_memory_init();
         simulate_no_memory = 0;
     }
+    void teardown(void){
+        btstack_memory_deinit();
+    }
 };
 
 #ifdef HAVE_MALLOC
@@ -2,8 +2,11 @@
 #include "CppUTest/CommandLineTestRunner.h"
 
 #include "hci_cmd.h"
+#include "hci_cmd_serializer.h"
 #include "btstack_util.h"
 
+#include <time.h>
+
 static uint8_t hci_cmd_buffer[350];
 static uint8_t input_buffer[350];
 
@@ -234,6 +237,127 @@ TEST(HCI_Command, format_INVALID){
     CHECK_EQUAL(expected_size, size);
 }
 
+static uint8_t serializer_buffer[350];
+
+static void check_serializer(uint16_t serializer_size, const hci_cmd_t * cmd, ...){
+    va_list argptr;
+    va_start(argptr, cmd);
+    uint16_t size = hci_cmd_create_from_template(hci_cmd_buffer, cmd, argptr);
+    va_end(argptr);
+    CHECK_EQUAL(size, serializer_size);
+    MEMCMP_EQUAL(hci_cmd_buffer, serializer_buffer, size);
+}
+
+TEST_GROUP(HCI_Command_Serializer){
+    bd_addr_t addr;
+    uint8_t   data[64];
+    void setup(void){
+        uint16_t i;
+        for (i = 0; i < sizeof(data); i++){
+            data[i] = (uint8_t) (i + 1);
+        }
+        memcpy(addr, data, 6);
+        memset(hci_cmd_buffer, 0x55, sizeof(hci_cmd_buffer));
+        memset(serializer_buffer, 0xaa, sizeof(serializer_buffer));
+    }
+};
+
+TEST(HCI_Command_Serializer, no_params){
+    uint16_t size = hci_cmd_create_reset(serializer_buffer);
+    check_serializer(size, &hci_reset);
+}
+
+TEST(HCI_Command_Serializer, fixed_params){
+    uint16_t size = hci_cmd_create_create_connection(serializer_buffer, addr, 0xcc18, 1, 0, 0x8000 | 0x1234, 1);
+    check_serializer(size, &hci_create_connection, addr, 0xcc18, 1, 0, 0x8000 | 0x1234, 1);
+    size = hci_cmd_create_remote_oob_data_request_reply(serializer_buffer, addr, &data[0], &data[16]);
+    check_serializer(size, &hci_remote_oob_data_request_reply, addr, &data[0], &data[16]);
+    size = hci_cmd_create_le_generate_dhkey(serializer_buffer, &data[0], &data[32]);
+    check_serializer(size, &hci_le_generate_dhkey, &data[0], &data[32]);
+}
+
+TEST(HCI_Command_Serializer, name){
+    // hci_write_local_name requires ENABLE_CLASSIC, compare with generic 'N' command
+    uint16_t size = hci_cmd_create_write_local_name(serializer_buffer, "BTstack 00:00:00:00:00:00");
+    CHECK_EQUAL(HCI_OPCODE_HCI_WRITE_LOCAL_NAME, little_endian_read_16(serializer_buffer, 0));
+    CHECK_EQUAL(create_hci_cmd(&cmd_N, "BTstack 00:00:00:00:00:00") + 3, size);
+    MEMCMP_EQUAL(&hci_cmd_buffer[2], &serializer_buffer[2], size - 2);
+}
+
+TEST(HCI_Command_Serializer, variable_length){
+    uint16_t size = hci_cmd_create_le_set_extended_advertising_data(serializer_buffer, 1, 3, 1, 31, data);
+    check_serializer(size, &hci_le_set_extended_advertising_data, 1, 3, 1, 31, data);
+}
+
+TEST(HCI_Command_Serializer, arrays){
+    const uint8_t  handles[] = { 1, 2 };
+    const uint16_t durations[] = { 100, 200 };
+    const uint8_t  max_events[] = { 0, 10 };
+    uint16_t size = hci_cmd_create_le_set_extended_advertising_enable(serializer_buffer, 1, 2, handles, durations, max_events);
+    check_serializer(size, &hci_le_set_extended_advertising_enable, 1, 2, handles, durations, max_events);
+
+    // bit field with LE 1M and LE Coded PHY
+    const uint8_t  scan_types[] = { 1, 0 };
+    const uint16_t scan_intervals[] = { 0x30, 0x60 };
+    const uint16_t scan_windows[] = { 0x30, 0x30 };
+    size = hci_cmd_create_le_set_extended_scan_parameters(serializer_buffer, 0, 0, 0x05, scan_types, scan_intervals, scan_windows);
+    check_serializer(size, &hci_le_set_extended_scan_parameters, 0, 0, 0x05, scan_types, scan_intervals, scan_windows);
+}
+
+#define NUM_CIS 4
+static const uint8_t  cis_id[NUM_CIS]  = { 0, 1, 2, 3 };
+static const uint16_t max_sdu[NUM_CIS] = { 120, 120, 120, 120 };
+static const uint8_t  phy[NUM_CIS]     = { 2, 2, 2, 2 };
+static const uint8_t  rtn[NUM_CIS]     = { 2, 2, 2, 2 };
+
+static uint16_t create_cig_parameters_generic(void){
+    return hci_cmd_create_from_template_with_vargs(hci_cmd_buffer, &hci_le_set_cig_parameters, 1, 10000, 10000, 0, 0, 0, 10, 10,
+                                                   NUM_CIS, cis_id, max_sdu, max_sdu, phy, phy, rtn, rtn);
+}
+
+static uint16_t create_cig_parameters_serializer(void){
+    return hci_cmd_create_le_set_cig_parameters(serializer_buffer, 1, 10000, 10000, 0, 0, 0, 10, 10,
+                                                NUM_CIS, cis_id, max_sdu, max_sdu, phy, phy, rtn, rtn);
+}
+
+TEST(HCI_Command_Serializer, cig_parameters){
+    uint16_t size = create_cig_parameters_serializer();
+    CHECK_EQUAL(create_cig_parameters_generic(), size);
+    MEMCMP_EQUAL(hci_cmd_buffer, serializer_buffer, size);
+}
+
+static double commands_per_second(clock_t start, uint32_t num_commands){
+    double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+    if (seconds <= 0.0) {
+        seconds = 1.0 / CLOCKS_PER_SEC;
+    }
+    return num_commands / seconds;
+}
+
+TEST(HCI_Command_Serializer, benchmark){
+    const uint32_t num_commands = 200000;
+    uint32_t i;
+    uint32_t checksum_generic = 0;
+    uint32_t checksum_serializer = 0;
+
+    clock_t start = clock();
+    for (i = 0; i < num_commands; i++){
+        checksum_generic += hci_cmd_create_from_template_with_vargs(hci_cmd_buffer, &hci_le_set_scan_enable, 1, i & 1);
+        checksum_generic += create_cig_parameters_generic();
+    }
+    double generic = commands_per_second(start, 2 * num_commands);
+
+    start = clock();
+    for (i = 0; i < num_commands; i++){
+        checksum_serializer += hci_cmd_create_le_set_scan_enable(serializer_buffer, 1, i & 1);
+        checksum_serializer += create_cig_parameters_serializer();
+    }
+    double serializer = commands_per_second(start, 2 * num_commands);
+
+    CHECK_EQUAL(checksum_generic, checksum_serializer);
+    printf("HCI Command creation: generic %.0f cmds/s, serializer %.0f cmds/s\n", generic, serializer);
+}
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
@@ -0,0 +1,230 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_memory.h"
+#include "hci.h"
+#include "hci_cmd.h"
+#include "btstack_debug.h"
+#include "btstack_util.h"
+#include "btstack_run_loop_posix.h"
+
+#if HCI_ISO_NUM_TX_SDU_BUFFERS != 2
+#error "hci_iso_test requires HCI_ISO_NUM_TX_SDU_BUFFERS = 2"
+#endif
+
+#define BIG_HANDLE 0x01
+#define BIS_HANDLE_1 0x0100
+#define BIS_HANDLE_2 0x0101
+#define BIS_HANDLE_3 0x0102
+
+typedef struct {
+    uint8_t type;
+    uint16_t size;
+    uint8_t  buffer[300];
+} hci_packet_t;
+
+#define MAX_HCI_PACKETS 20
+static uint16_t transport_count_packets;
+static hci_packet_t transport_packets[MAX_HCI_PACKETS];
+
+static  void (*packet_handler)(uint8_t packet_type, uint8_t *packet, uint16_t size);
+
+static const uint8_t packet_sent_event[] = { HCI_EVENT_TRANSPORT_PACKET_SENT, 0};
+
+static int hci_transport_test_set_baudrate(uint32_t baudrate){
+    return 0;
+}
+
+static int hci_transport_test_can_send_now(uint8_t packet_type){
+    return 1;
+}
+
+static int hci_transport_test_send_packet(uint8_t packet_type, uint8_t * packet, int size){
+    btstack_assert(transport_count_packets < MAX_HCI_PACKETS);
+    memcpy(transport_packets[transport_count_packets].buffer, packet, size);
+    transport_packets[transport_count_packets].type = packet_type;
+    transport_packets[transport_count_packets].size = size;
+    transport_count_packets++;
+    // notify upper stack that it can send again
+    packet_handler(HCI_EVENT_PACKET, (uint8_t *) &packet_sent_event[0], sizeof(packet_sent_event));
+    return 0;
+}
+
+static void hci_transport_test_init(const void * transport_config){
+}
+
+static int hci_transport_test_open(void){
+    return 0;
+}
+
+static int hci_transport_test_close(void){
+    return 0;
+}
+
+static void hci_transport_test_register_packet_handler(void (*handler)(uint8_t packet_type, uint8_t *packet, uint16_t size)){
+    packet_handler = handler;
+}
+
+static const hci_transport_t hci_transport_test = {
+        /* const char * name; */                                        "TEST",
+        /* void   (*init) (const void *transport_config); */            &hci_transport_test_init,
+        /* int    (*open)(void); */                                     &hci_transport_test_open,
+        /* int    (*close)(void); */                                    &hci_transport_test_close,
+        /* void   (*register_packet_handler)(void (*handler)(...); */   &hci_transport_test_register_packet_handler,
+        /* int    (*can_send_packet_now)(uint8_t packet_type); */       &hci_transport_test_can_send_now,
+        /* int    (*send_packet)(...); */                               &hci_transport_test_send_packet,
+        /* int    (*set_baudrate)(uint32_t baudrate); */                &hci_transport_test_set_baudrate,
+        /* void   (*reset_link)(void); */                               NULL,
+        /* void   (*set_sco_config)(uint16_t voice_setting, int num_connections); */ NULL,
+};
+
+static uint16_t count_iso_packets(void){
+    uint16_t count = 0;
+    uint16_t i;
+    for (i=0;i<transport_count_packets;i++){
+        if (transport_packets[i].type == HCI_ISO_DATA_PACKET){
+            count++;
+        }
+    }
+    return count;
+}
+
+static void simulate_number_of_completed_packets(hci_con_handle_t con_handle){
+    uint8_t event[] = { HCI_EVENT_NUMBER_OF_COMPLETED_PACKETS, 5, 1, 0, 0, 1, 0};
+    little_endian_store_16(event, 3, con_handle);
+    packet_handler(HCI_EVENT_PACKET, event, sizeof(event));
+}
+
+static le_audio_big_t big_storage;
+static le_audio_big_params_t big_params;
+
+TEST_GROUP(HCI_ISO){
+    void setup(void){
+        transport_count_packets = 0;
+        hci_init(&hci_transport_test, NULL);
+        hci_simulate_working_fuzz();
+
+        // ISO buffer size: 251 bytes, 8 packets
+        const uint8_t read_buffer_size_v2_complete[] = { HCI_EVENT_COMMAND_COMPLETE, 10, 1, 0x60, 0x20, 0, 0xfb, 0x00, 0x08, 0xfb, 0x00, 0x08};
+        packet_handler(HCI_EVENT_PACKET, (uint8_t *) read_buffer_size_v2_complete, sizeof(read_buffer_size_v2_complete));
+
+        // create BIG with three BIS
+        memset(&big_params, 0, sizeof(big_params));
+        big_params.big_handle = BIG_HANDLE;
+        big_params.num_bis = 3;
+        big_params.max_sdu = 100;
+        big_params.sdu_interval_us = 10000;
+        CHECK_EQUAL(ERROR_CODE_SUCCESS, gap_big_create(&big_storage, &big_params));
+        uint8_t big_complete[] = { HCI_EVENT_LE_META, 25, HCI_SUBEVENT_LE_CREATE_BIG_COMPLETE, ERROR_CODE_SUCCESS, BIG_HANDLE,
+                                   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0};
+        little_endian_store_16(big_complete, 21, BIS_HANDLE_1);
+        little_endian_store_16(big_complete, 23, BIS_HANDLE_2);
+        little_endian_store_16(big_complete, 25, BIS_HANDLE_3);
+        packet_handler(HCI_EVENT_PACKET, big_complete, sizeof(big_complete));
+        transport_count_packets = 0;
+    }
+    void teardown(void){
+        hci_deinit();
+    }
+};
+
+static const uint8_t sdu_data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+static uint8_t send_sdus(uint16_t sequence_number, uint8_t num_handles, const hci_con_handle_t * handles){
+    hci_iso_sdu_t sdus[3];
+    uint8_t i;
+    for (i=0;i<num_handles;i++){
+        sdus[i].con_handle = handles[i];
+        sdus[i].data = sdu_data;
+        sdus[i].len = sizeof(sdu_data);
+    }
+    return hci_iso_send_sdus(sequence_number, false, 0, num_handles, sdus);
+}
+
+TEST(HCI_ISO, SendSdus){
+    const hci_con_handle_t handles[] = { BIS_HANDLE_1, BIS_HANDLE_2 };
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, send_sdus(5, 2, handles));
+    CHECK_EQUAL(2, count_iso_packets());
+    // handle and flags, iso data load length, packet sequence number, sdu length, data
+    hci_packet_t * packet = &transport_packets[0];
+    CHECK_EQUAL(4 + 4 + sizeof(sdu_data), packet->size);
+    CHECK_EQUAL(BIS_HANDLE_1 | (2 << 12), little_endian_read_16(packet->buffer, 0));
+    CHECK_EQUAL(4 + sizeof(sdu_data), little_endian_read_16(packet->buffer, 2));
+    CHECK_EQUAL(5, little_endian_read_16(packet->buffer, 4));
+    CHECK_EQUAL(sizeof(sdu_data), little_endian_read_16(packet->buffer, 6));
+    MEMCMP_EQUAL(sdu_data, &packet->buffer[8], sizeof(sdu_data));
+    CHECK_EQUAL(BIS_HANDLE_2, little_endian_read_16(transport_packets[1].buffer, 0) & 0x0fff);
+}
+
+TEST(HCI_ISO, SendSdusInvalid){
+    const hci_con_handle_t unknown[] = { 0x0200 };
+    CHECK_EQUAL(ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER, send_sdus(0, 1, unknown));
+    CHECK_EQUAL(ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS, send_sdus(0, 0, unknown));
+    CHECK_EQUAL(0, count_iso_packets());
+}
+
+TEST(HCI_ISO, RejectUnsentSdu){
+    const hci_con_handle_t handles[] = { BIS_HANDLE_1, BIS_HANDLE_2 };
+    // first SDUs go to the Controller, second SDUs wait for Number of Completed Packets
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, send_sdus(0, 2, handles));
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, send_sdus(1, 2, handles));
+    CHECK_EQUAL(2, count_iso_packets());
+
+    // third SDUs would overwrite the queued ones
+    CHECK_EQUAL(ERROR_CODE_CONTROLLER_BUSY, send_sdus(2, 2, handles));
+    hci_iso_tx_stats_t stats;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, hci_iso_get_tx_stats(BIS_HANDLE_1, &stats));
+    CHECK_EQUAL(2, stats.num_sdus_queued);
+    CHECK_EQUAL(1, stats.num_sdus_sent);
+    CHECK_EQUAL(1, stats.num_late);
+
+    // queued SDUs are sent after Controller reports completion
+    simulate_number_of_completed_packets(BIS_HANDLE_1);
+    simulate_number_of_completed_packets(BIS_HANDLE_2);
+    CHECK_EQUAL(4, count_iso_packets());
+    CHECK_EQUAL(1, little_endian_read_16(transport_packets[3].buffer, 4));
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, send_sdus(2, 2, handles));
+
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, hci_iso_get_tx_stats(BIS_HANDLE_2, &stats));
+    CHECK_EQUAL(3, stats.num_sdus_queued);
+    CHECK_EQUAL(2, stats.num_sdus_sent);
+    CHECK_EQUAL(1, stats.num_late);
+}
+
+TEST(HCI_ISO, TxStats){
+    hci_iso_tx_stats_t stats;
+    CHECK_EQUAL(ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER, hci_iso_get_tx_stats(0x0200, &stats));
+
+    // SDU only for first BIS counts underruns for the other BIS of the BIG
+    const hci_con_handle_t handles[] = { BIS_HANDLE_1 };
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, send_sdus(0, 1, handles));
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, hci_iso_get_tx_stats(BIS_HANDLE_1, &stats));
+    CHECK_EQUAL(1, stats.num_sdus_queued);
+    CHECK_EQUAL(1, stats.num_sdus_sent);
+    CHECK_EQUAL(0, stats.num_underruns);
+    CHECK_EQUAL(0, stats.num_late);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, hci_iso_get_tx_stats(BIS_HANDLE_2, &stats));
+    CHECK_EQUAL(0, stats.num_sdus_queued);
+    CHECK_EQUAL(1, stats.num_underruns);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, hci_iso_get_tx_stats(BIS_HANDLE_3, &stats));
+    CHECK_EQUAL(1, stats.num_underruns);
+}
+
+TEST(HCI_ISO, NoSduBuffer){
+    // two SDU buffers are assigned to the first two BIS
+    const hci_con_handle_t handles[] = { BIS_HANDLE_1, BIS_HANDLE_2 };
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, send_sdus(0, 2, handles));
+    const hci_con_handle_t third[] = { BIS_HANDLE_3 };
+    CHECK_EQUAL(ERROR_CODE_MEMORY_CAPACITY_EXCEEDED, send_sdus(0, 1, third));
+    CHECK_EQUAL(2, count_iso_packets());
+}
+
+int main (int argc, const char * argv[]){
+    btstack_run_loop_init(btstack_run_loop_posix_get_instance());
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -355,6 +355,42 @@ TEST(HCI, SetScanResponse){
     gap_scan_response_set_data(0, NULL);
 }
 
+static hci_packet_t * find_hci_command(uint16_t opcode){
+    uint16_t i;
+    for (i = 0; i < transport_count_packets; i++){
+        if ((transport_packets[i].type == HCI_COMMAND_DATA_PACKET) && (little_endian_read_16(transport_packets[i].buffer, 0) == opcode)){
+            return &transport_packets[i];
+        }
+    }
+    return NULL;
+}
+
+TEST(HCI, SetAdvertisingDataCommand){
+    static const uint8_t adv_data[] = { 0x02, 0x01, 0x06, 0x03, 0x09, 'B', 'K' };
+    transport_count_packets = 0;
+    gap_advertisements_set_data(sizeof(adv_data), (uint8_t *) adv_data);
+    hci_packet_t * packet = find_hci_command(HCI_OPCODE_HCI_LE_SET_ADVERTISING_DATA);
+    CHECK(packet != NULL);
+    // length and 31 bytes of data padded with zeros
+    CHECK_EQUAL(3 + 1 + 31, packet->size);
+    CHECK_EQUAL(32, packet->buffer[2]);
+    CHECK_EQUAL(sizeof(adv_data), packet->buffer[3]);
+    MEMCMP_EQUAL(adv_data, &packet->buffer[4], sizeof(adv_data));
+    CHECK_EQUAL(0, packet->buffer[4 + sizeof(adv_data)]);
+}
+
+TEST(HCI, StartScanCommand){
+    transport_count_packets = 0;
+    gap_set_scan_duplicate_filter(true);
+    gap_start_scan();
+    hci_packet_t * packet = find_hci_command(HCI_OPCODE_HCI_LE_SET_SCAN_ENABLE);
+    CHECK(packet != NULL);
+    CHECK_EQUAL(5, packet->size);
+    CHECK_EQUAL(2, packet->buffer[2]);
+    CHECK_EQUAL(1, packet->buffer[3]);
+    CHECK_EQUAL(1, packet->buffer[4]);
+}
+
 TEST(HCI, SetAddrType){
     hci_le_set_own_address_type(0);
     hci_le_set_own_address_type(1);
@@ -380,6 +416,34 @@ TEST(HCI, GetRole){
     gap_get_role(5);
 }
 
+TEST(HCI, RunOnlyPendingConnections){
+    // command complete allows to send next command and triggers a full run
+    const uint8_t command_complete[] = { HCI_EVENT_COMMAND_COMPLETE, 3, 1, 0x00, 0xfc };
+    packet_handler(HCI_EVENT_PACKET, (uint8_t *) command_complete, sizeof(command_complete));
+
+    hci_run_stats_t stats_before;
+    hci_get_run_stats(&stats_before);
+    CHECK(stats_before.num_connections_visited > 0);
+
+    // num completed packets doesn't change connection state, no task or connection is checked
+    const uint8_t num_completed_packets[] = { HCI_EVENT_NUMBER_OF_COMPLETED_PACKETS, 5, 1, 0x05, 0x00, 0x00, 0x00 };
+    packet_handler(HCI_EVENT_PACKET, (uint8_t *) num_completed_packets, sizeof(num_completed_packets));
+    hci_run_stats_t stats_after;
+    hci_get_run_stats(&stats_after);
+    CHECK_EQUAL(stats_before.num_runs + 1, stats_after.num_runs);
+    CHECK_EQUAL(stats_before.num_tasks_visited, stats_after.num_tasks_visited);
+    CHECK_EQUAL(stats_before.num_connections_visited, stats_after.num_connections_visited);
+
+    // explicit request only checks the requested connection
+    hci_connection_t * connection = hci_connection_for_handle(5);
+    CHECK(connection != NULL);
+    hci_request_connection_run(connection);
+    packet_handler(HCI_EVENT_PACKET, (uint8_t *) num_completed_packets, sizeof(num_completed_packets));
+    hci_get_run_stats(&stats_before);
+    CHECK_EQUAL(stats_after.num_tasks_visited + 1, stats_before.num_tasks_visited);
+    CHECK_EQUAL(stats_after.num_connections_visited + 1, stats_before.num_connections_visited);
+}
+
 int main (int argc, const char * argv[]){
     btstack_run_loop_init(btstack_run_loop_posix_get_instance());
     return CommandLineTestRunner::RunAllTests(argc, argv);
@@ -0,0 +1,251 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "ble/le_advertising_filter.h"
+#include "bluetooth_company_id.h"
+#include "bluetooth_data_types.h"
+#include "btstack_defines.h"
+#include "btstack_util.h"
+
+static uint32_t time_ms;
+static bool (*registered_filter)(const uint8_t * event, uint16_t size);
+
+// stubs
+extern "C" uint32_t btstack_run_loop_get_time_ms(void){
+    return time_ms;
+}
+
+extern "C" void gap_register_advertising_report_filter(bool (*filter_callback)(const uint8_t * event, uint16_t size)){
+    registered_filter = filter_callback;
+}
+
+static const bd_addr_t address_1 = { 0x00, 0x1B, 0xDC, 0x01, 0x02, 0x03 };
+static const bd_addr_t address_2 = { 0x00, 0x1B, 0xDC, 0x04, 0x05, 0x06 };
+static const bd_addr_t address_3 = { 0xC0, 0x11, 0x22, 0x33, 0x44, 0x55 };
+
+// flags, complete list of 16-bit uuids: 0x180F, 0x180A
+static const uint8_t adv_data_uuid16[] = { 0x02, BLUETOOTH_DATA_TYPE_FLAGS, 0x06, 0x05, BLUETOOTH_DATA_TYPE_COMPLETE_LIST_OF_16_BIT_SERVICE_CLASS_UUIDS, 0x0F, 0x18, 0x0A, 0x18 };
+// manufacturer specific data for BlueKitchen
+static const uint8_t adv_data_manufacturer[] = { 0x05, BLUETOOTH_DATA_TYPE_MANUFACTURER_SPECIFIC_DATA, 0x8F, 0x04, 0x01, 0x02 };
+// shortened local name
+static const uint8_t adv_data_name[] = { 0x04, BLUETOOTH_DATA_TYPE_SHORTENED_LOCAL_NAME, 'B', 'T', 'K' };
+
+static uint8_t report[12 + 31];
+static uint16_t report_len;
+
+static void setup_report(uint8_t event_type, const bd_addr_t address, int8_t rssi, const uint8_t * data, uint8_t data_len){
+    report[0] = GAP_EVENT_ADVERTISING_REPORT;
+    report[1] = 10 + data_len;
+    report[2] = event_type;
+    report[3] = BD_ADDR_TYPE_LE_PUBLIC;
+    reverse_bd_addr(address, &report[4]);
+    report[10] = (uint8_t) rssi;
+    report[11] = data_len;
+    memcpy(&report[12], data, data_len);
+    report_len = 12 + data_len;
+}
+
+static bool process(const bd_addr_t address, int8_t rssi, const uint8_t * data, uint8_t data_len){
+    setup_report(0, address, rssi, data, data_len);
+    return le_advertising_filter_process(report, report_len);
+}
+
+TEST_GROUP(LE_ADVERTISING_FILTER){
+    void setup(void){
+        time_ms = 0;
+        le_advertising_filter_init();
+    }
+    void teardown(void){
+        le_advertising_filter_deinit();
+    }
+};
+
+TEST(LE_ADVERTISING_FILTER, Register){
+    CHECK(registered_filter == &le_advertising_filter_process);
+    le_advertising_filter_deinit();
+    CHECK(registered_filter == NULL);
+}
+
+TEST(LE_ADVERTISING_FILTER, DeliverAll){
+    CHECK_TRUE(process(address_1, -60, adv_data_uuid16, sizeof(adv_data_uuid16)));
+    CHECK_TRUE(process(address_1, -60, adv_data_uuid16, sizeof(adv_data_uuid16)));
+    CHECK_TRUE(process(address_2, -90, adv_data_name, sizeof(adv_data_name)));
+    le_advertising_filter_stats_t stats;
+    le_advertising_filter_get_stats(&stats);
+    CHECK_EQUAL(3, stats.num_reports_seen);
+    CHECK_EQUAL(3, stats.num_reports_delivered);
+    CHECK_EQUAL(0, stats.num_reports_filtered);
+}
+
+TEST(LE_ADVERTISING_FILTER, OtherEvent){
+    uint8_t event[] = { HCI_EVENT_COMMAND_COMPLETE, 0 };
+    CHECK_TRUE(le_advertising_filter_process(event, sizeof(event)));
+    le_advertising_filter_stats_t stats;
+    le_advertising_filter_get_stats(&stats);
+    CHECK_EQUAL(0, stats.num_reports_seen);
+}
+
+TEST(LE_ADVERTISING_FILTER, DenyList){
+    static const le_advertising_filter_address_t deny_list[] = {
+        { { 0x00, 0x1B, 0xDC, 0x04, 0x05, 0x06 }, LE_ADVERTISING_FILTER_MATCH_ADDRESS },
+    };
+    le_advertising_filter_set_deny_list(deny_list, 1);
+    CHECK_TRUE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    CHECK_FALSE(process(address_2, -60, adv_data_name, sizeof(adv_data_name)));
+    CHECK_TRUE(process(address_3, -60, adv_data_name, sizeof(adv_data_name)));
+}
+
+TEST(LE_ADVERTISING_FILTER, AllowListOui){
+    static const le_advertising_filter_address_t allow_list[] = {
+        { { 0x00, 0x1B, 0xDC, 0x00, 0x00, 0x00 }, LE_ADVERTISING_FILTER_MATCH_OUI },
+    };
+    le_advertising_filter_set_allow_list(allow_list, 1);
+    CHECK_TRUE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    CHECK_TRUE(process(address_2, -60, adv_data_name, sizeof(adv_data_name)));
+    CHECK_FALSE(process(address_3, -60, adv_data_name, sizeof(adv_data_name)));
+    le_advertising_filter_stats_t stats;
+    le_advertising_filter_get_stats(&stats);
+    CHECK_EQUAL(3, stats.num_reports_seen);
+    CHECK_EQUAL(2, stats.num_reports_delivered);
+    CHECK_EQUAL(1, stats.num_reports_filtered);
+}
+
+TEST(LE_ADVERTISING_FILTER, RssiThreshold){
+    le_advertising_filter_set_rssi_threshold(-70);
+    CHECK_TRUE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    CHECK_TRUE(process(address_1, -70, adv_data_name, sizeof(adv_data_name)));
+    CHECK_FALSE(process(address_1, -71, adv_data_name, sizeof(adv_data_name)));
+    CHECK_TRUE(process(address_1, 127, adv_data_name, sizeof(adv_data_name)));
+}
+
+TEST(LE_ADVERTISING_FILTER, AdType){
+    le_advertising_filter_add_ad_type(BLUETOOTH_DATA_TYPE_SHORTENED_LOCAL_NAME);
+    CHECK_TRUE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    CHECK_FALSE(process(address_1, -60, adv_data_uuid16, sizeof(adv_data_uuid16)));
+    le_advertising_filter_clear_data_filter();
+    CHECK_TRUE(process(address_1, -60, adv_data_uuid16, sizeof(adv_data_uuid16)));
+}
+
+TEST(LE_ADVERTISING_FILTER, Uuid16){
+    static const uint16_t uuid16s[] = { 0x1812, 0x180A };
+    le_advertising_filter_set_uuid16_list(uuid16s, 2);
+    CHECK_TRUE(process(address_1, -60, adv_data_uuid16, sizeof(adv_data_uuid16)));
+    CHECK_FALSE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    le_advertising_filter_set_uuid16_list(uuid16s, 1);
+    CHECK_FALSE(process(address_1, -60, adv_data_uuid16, sizeof(adv_data_uuid16)));
+}
+
+TEST(LE_ADVERTISING_FILTER, Uuid128){
+    static const uint8_t uuid128s[][16] = {
+        { 0x00, 0x00, 0x18, 0x0F, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x34, 0xFB },
+    };
+    uint8_t adv_data[18];
+    adv_data[0] = 17;
+    adv_data[1] = BLUETOOTH_DATA_TYPE_SERVICE_DATA_128_BIT_UUID;
+    reverse_128(uuid128s[0], &adv_data[2]);
+    le_advertising_filter_set_uuid128_list(uuid128s, 1);
+    CHECK_TRUE(process(address_1, -60, adv_data, sizeof(adv_data)));
+    CHECK_FALSE(process(address_1, -60, adv_data_uuid16, sizeof(adv_data_uuid16)));
+}
+
+TEST(LE_ADVERTISING_FILTER, CompanyId){
+    static const uint16_t company_ids[] = { BLUETOOTH_COMPANY_ID_BLUEKITCHEN_GMBH };
+    le_advertising_filter_set_company_id_list(company_ids, 1);
+    CHECK_TRUE(process(address_1, -60, adv_data_manufacturer, sizeof(adv_data_manufacturer)));
+    CHECK_FALSE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+}
+
+TEST(LE_ADVERTISING_FILTER, Duplicates){
+    le_advertising_filter_cache_entry_t cache[8];
+    le_advertising_filter_set_duplicate_cache(cache, 8, 1000);
+    CHECK_TRUE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    CHECK_FALSE(process(address_1, -65, adv_data_name, sizeof(adv_data_name)));
+    // other address
+    CHECK_TRUE(process(address_2, -60, adv_data_name, sizeof(adv_data_name)));
+    // changed data
+    CHECK_TRUE(process(address_1, -60, adv_data_uuid16, sizeof(adv_data_uuid16)));
+    CHECK_FALSE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    // scan response with same data
+    setup_report(4, address_1, -60, adv_data_name, sizeof(adv_data_name));
+    CHECK_TRUE(le_advertising_filter_process(report, report_len));
+    // window expired
+    time_ms += 1000;
+    CHECK_TRUE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    CHECK_FALSE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+
+    le_advertising_filter_stats_t stats;
+    le_advertising_filter_get_stats(&stats);
+    CHECK_EQUAL(8, stats.num_reports_seen);
+    CHECK_EQUAL(5, stats.num_reports_delivered);
+    CHECK_EQUAL(3, stats.num_reports_filtered);
+    CHECK_EQUAL(3, stats.num_reports_duplicate);
+}
+
+TEST(LE_ADVERTISING_FILTER, DuplicatesAnonymous){
+    le_advertising_filter_cache_entry_t cache[2];
+    le_advertising_filter_set_duplicate_cache(cache, 2, 1000);
+    // anonymous advertisements are reported with address type 0xff and empty address
+    static const bd_addr_t address_anonymous = { 0 };
+    setup_report(0, address_anonymous, -60, adv_data_name, sizeof(adv_data_name));
+    report[3] = 0xff;
+    CHECK_TRUE(le_advertising_filter_process(report, report_len));
+    CHECK_FALSE(le_advertising_filter_process(report, report_len));
+    // cached anonymous report does not get replaced by other reports while cache has space
+    CHECK_TRUE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    CHECK_FALSE(process(address_1, -60, adv_data_name, sizeof(adv_data_name)));
+    setup_report(0, address_anonymous, -60, adv_data_name, sizeof(adv_data_name));
+    report[3] = 0xff;
+    CHECK_FALSE(le_advertising_filter_process(report, report_len));
+}
+
+TEST(LE_ADVERTISING_FILTER, DuplicateCacheFull){
+    le_advertising_filter_cache_entry_t cache[2];
+    le_advertising_filter_set_duplicate_cache(cache, 2, 1000);
+    uint8_t address[6];
+    uint8_t i;
+    for (i = 0; i < 10; i++){
+        memcpy(address, address_1, 6);
+        address[5] = i;
+        time_ms++;
+        CHECK_TRUE(process(address, -60, adv_data_name, sizeof(adv_data_name)));
+    }
+    // last address is still cached
+    CHECK_FALSE(process(address, -60, adv_data_name, sizeof(adv_data_name)));
+}
+
+TEST(LE_ADVERTISING_FILTER, Throughput){
+    // dense venue: 200 devices advertise every 100 ms, only 10 of them are of interest
+    static const uint16_t company_ids[] = { BLUETOOTH_COMPANY_ID_BLUEKITCHEN_GMBH };
+    le_advertising_filter_cache_entry_t cache[64];
+    le_advertising_filter_set_company_id_list(company_ids, 1);
+    le_advertising_filter_set_duplicate_cache(cache, 64, 1000);
+    uint8_t address[6];
+    uint32_t i;
+    for (i = 0; i < 20000; i++){
+        uint8_t device = (uint8_t) (i % 200);
+        memcpy(address, address_1, 6);
+        address[5] = device;
+        time_ms = i / 2;
+        if (device < 10){
+            process(address, -60, adv_data_manufacturer, sizeof(adv_data_manufacturer));
+        } else {
+            process(address, -60, adv_data_uuid16, sizeof(adv_data_uuid16));
+        }
+    }
+    le_advertising_filter_stats_t stats;
+    le_advertising_filter_get_stats(&stats);
+    CHECK_EQUAL(20000, stats.num_reports_seen);
+    CHECK_EQUAL(100, stats.num_reports_delivered);
+    printf("Reports: %u seen, %u filtered (%u duplicates), %u delivered\n",
+           (unsigned int) stats.num_reports_seen, (unsigned int) stats.num_reports_filtered,
+           (unsigned int) stats.num_reports_duplicate, (unsigned int) stats.num_reports_delivered);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -0,0 +1,341 @@
+// *****************************************************************************
+//
+// test parallel gatt client discovery against simulated peer
+//
+// *****************************************************************************
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "hci.h"
+#include "btstack_event.h"
+#include "btstack_util.h"
+#include "bluetooth_gatt.h"
+#include "ble/att_db.h"
+#include "ble/att_db_util.h"
+#include "ble/gatt_client.h"
+#include "ble/gatt_client_discovery.h"
+#include "ble/le_device_db.h"
+#include "btstack_tlv.h"
+#include "mock_btstack_tlv.h"
+
+extern "C" void hci_setup_le_connection(uint16_t con_handle);
+extern "C" uint32_t mock_att_get_num_requests(void);
+extern "C" uint8_t mock_l2cap_ecbm_process(void);
+extern "C" void mock_set_encryption_key_size(uint8_t encryption_key_size);
+extern "C" void mock_att_simulate_indication(uint16_t value_handle, const uint8_t * value, uint16_t value_len);
+
+#define NUM_SERVICES                 20
+#define NUM_CHARACTERISTICS_PER_SERVICE 8
+#define NUM_EATT_BEARERS             5
+#define EATT_STORAGE_SIZE_PER_BEARER 200
+
+static const hci_con_handle_t con_handle = 0x40;
+
+static uint8_t server_supported_features = 0x01;    // EATT supported
+static uint8_t client_supported_features = 0x00;
+static uint8_t characteristic_value = 0x00;
+static uint8_t service_changed_value[4];
+static uint16_t service_changed_value_handle;
+
+static gatt_client_service_t                   services[NUM_SERVICES + 2];
+static gatt_client_characteristic_t            characteristics[(NUM_SERVICES * NUM_CHARACTERISTICS_PER_SERVICE) + 4];
+static gatt_client_characteristic_descriptor_t descriptors[NUM_SERVICES * NUM_CHARACTERISTICS_PER_SERVICE];
+
+static gatt_client_database_t  database;
+static gatt_client_discovery_t discovery;
+
+static uint8_t eatt_storage[NUM_EATT_BEARERS * EATT_STORAGE_SIZE_PER_BEARER];
+
+static bool     discovery_complete;
+static uint8_t  discovery_att_status;
+static bool     discovery_from_cache;
+static bool     eatt_connected;
+static bool     database_changed;
+static uint16_t database_changed_start_handle;
+static uint16_t database_changed_end_handle;
+static uint16_t service_changed_configuration;
+
+static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    switch (hci_event_packet_get_type(packet)){
+        case GATT_EVENT_DISCOVERY_COMPLETE:
+            discovery_complete = true;
+            discovery_att_status = gatt_event_discovery_complete_get_att_status(packet);
+            discovery_from_cache = gatt_event_discovery_complete_get_from_cache(packet) != 0;
+            break;
+        case GATT_EVENT_CONNECTED:
+            eatt_connected = gatt_event_connected_get_status(packet) == ERROR_CODE_SUCCESS;
+            break;
+        case GATT_EVENT_DATABASE_CHANGED:
+            database_changed = true;
+            database_changed_start_handle = gatt_event_database_changed_get_start_handle(packet);
+            database_changed_end_handle = gatt_event_database_changed_get_end_handle(packet);
+            break;
+        default:
+            break;
+    }
+}
+
+// only Client Characteristic Configuration of Service Changed is written
+static int att_write_callback(hci_con_handle_t connection_handle, uint16_t attribute_handle, uint16_t transaction_mode, uint16_t offset, uint8_t *buffer, uint16_t buffer_size){
+    UNUSED(connection_handle);
+    UNUSED(transaction_mode);
+    UNUSED(offset);
+    if (attribute_handle != (service_changed_value_handle + 1)) return ATT_ERROR_WRITE_NOT_PERMITTED;
+    if (buffer_size != 2) return ATT_ERROR_INVALID_ATTRIBUTE_VALUE_LENGTH;
+    service_changed_configuration = little_endian_read_16(buffer, 0);
+    return 0;
+}
+
+// peer with GATT Service and a number of services with characteristics, every second one with CCC
+// with database hash, GATT Service also contains Service Changed and Database Hash characteristics
+static void setup_peer_database(const uint8_t * database_hash){
+    att_db_util_init();
+    att_db_util_add_service_uuid16(ORG_BLUETOOTH_SERVICE_GENERIC_ATTRIBUTE);
+    if (database_hash != NULL){
+        service_changed_value_handle = att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_GATT_SERVICE_CHANGED, ATT_PROPERTY_INDICATE,
+                                                                             ATT_SECURITY_NONE, ATT_SECURITY_NONE, service_changed_value, sizeof(service_changed_value));
+        att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_DATABASE_HASH, ATT_PROPERTY_READ,
+                                              ATT_SECURITY_NONE, ATT_SECURITY_NONE, (uint8_t *) database_hash, 16);
+    }
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_SERVER_SUPPORTED_FEATURES, ATT_PROPERTY_READ,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, &server_supported_features, 1);
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_CLIENT_SUPPORTED_FEATURES, ATT_PROPERTY_READ | ATT_PROPERTY_WRITE,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, &client_supported_features, 1);
+    uint16_t i;
+    for (i = 0; i < NUM_SERVICES; i++){
+        att_db_util_add_service_uuid16(0xA000 + i);
+        uint16_t j;
+        for (j = 0; j < NUM_CHARACTERISTICS_PER_SERVICE; j++){
+            uint16_t properties = ATT_PROPERTY_READ;
+            if ((j & 1) != 0){
+                properties |= ATT_PROPERTY_NOTIFY;
+            }
+            att_db_util_add_characteristic_uuid16(0xB000 + j, properties, ATT_SECURITY_NONE, ATT_SECURITY_NONE, &characteristic_value, 1);
+        }
+    }
+    att_set_db(att_db_util_get_address());
+}
+
+static void check_database(bool with_database_hash){
+    uint16_t num_gatt_service_characteristics = with_database_hash ? 4 : 2;
+    uint16_t num_gatt_service_descriptors     = with_database_hash ? 1 : 0;
+    CHECK_EQUAL(NUM_SERVICES + 1, database.services_num);
+    CHECK_EQUAL((NUM_SERVICES * NUM_CHARACTERISTICS_PER_SERVICE) + num_gatt_service_characteristics, database.characteristics_num);
+    CHECK_EQUAL(((NUM_SERVICES * NUM_CHARACTERISTICS_PER_SERVICE) / 2) + num_gatt_service_descriptors, database.descriptors_num);
+
+    uint16_t i;
+    for (i = 1; i < database.services_num; i++){
+        uint16_t num_characteristics;
+        const gatt_client_characteristic_t * service_characteristics =
+                gatt_client_database_get_characteristics_for_service(&database, &database.services[i], &num_characteristics);
+        CHECK_EQUAL(NUM_CHARACTERISTICS_PER_SERVICE, num_characteristics);
+        uint16_t j;
+        for (j = 0; j < num_characteristics; j++){
+            CHECK_EQUAL(0xB000 + j, service_characteristics[j].uuid16);
+            uint16_t num_descriptors;
+            const gatt_client_characteristic_descriptor_t * characteristic_descriptors =
+                    gatt_client_database_get_descriptors_for_characteristic(&database, &service_characteristics[j], &num_descriptors);
+            CHECK_EQUAL(j & 1, num_descriptors);
+            if (num_descriptors > 0){
+                CHECK_EQUAL(ORG_BLUETOOTH_DESCRIPTOR_GATT_CLIENT_CHARACTERISTIC_CONFIGURATION, characteristic_descriptors[0].uuid16);
+            }
+        }
+    }
+}
+
+TEST_GROUP(GATTClientDiscovery){
+    void setup(void){
+        setup_peer_database(NULL);
+        gatt_client_init();
+        gatt_client_mtu_enable_auto_negotiation(0);
+        hci_setup_le_connection(con_handle);
+        gatt_client_database_init(&database, services, sizeof(services) / sizeof(gatt_client_service_t),
+                                  characteristics, sizeof(characteristics) / sizeof(gatt_client_characteristic_t),
+                                  descriptors, sizeof(descriptors) / sizeof(gatt_client_characteristic_descriptor_t));
+        discovery_complete = false;
+        discovery_att_status = ATT_ERROR_SUCCESS;
+        eatt_connected = false;
+    }
+};
+
+TEST(GATTClientDiscovery, discovery_over_att){
+    uint32_t num_requests = mock_att_get_num_requests();
+    uint8_t status = gatt_client_discovery_start(&discovery, &packet_handler, con_handle, &database);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    CHECK_TRUE(discovery_complete);
+    CHECK_EQUAL(ATT_ERROR_SUCCESS, discovery_att_status);
+    check_database(false);
+
+    // single bearer: each request is one round trip
+    num_requests = mock_att_get_num_requests() - num_requests;
+    printf("ATT:         %4u requests, %4u round trips\n", (unsigned int) num_requests, (unsigned int) num_requests);
+}
+
+static void discovery_over_eatt(uint8_t num_bearers){
+    uint8_t status = gatt_client_le_enhanced_connect(&packet_handler, con_handle, num_bearers, eatt_storage, num_bearers * EATT_STORAGE_SIZE_PER_BEARER);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    mock_l2cap_ecbm_process();
+    CHECK_TRUE(eatt_connected);
+
+    uint32_t num_requests = mock_att_get_num_requests();
+    status = gatt_client_discovery_start(&discovery, &packet_handler, con_handle, &database);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+
+    // discovery already active
+    gatt_client_discovery_t second_discovery;
+    status = gatt_client_discovery_start(&second_discovery, &packet_handler, con_handle, &database);
+    CHECK_EQUAL(ERROR_CODE_COMMAND_DISALLOWED, status);
+
+    // peer answers all outstanding requests once per connection event
+    uint32_t num_round_trips = 0;
+    while (discovery_complete == false){
+        CHECK_TRUE(mock_l2cap_ecbm_process() > 0);
+        num_round_trips++;
+    }
+    CHECK_EQUAL(ATT_ERROR_SUCCESS, discovery_att_status);
+    check_database(false);
+
+    num_requests = mock_att_get_num_requests() - num_requests;
+    printf("EATT x %u:    %4u requests, %4u round trips\n", num_bearers, (unsigned int) num_requests, (unsigned int) num_round_trips);
+}
+
+TEST(GATTClientDiscovery, discovery_over_eatt_single_bearer){
+    discovery_over_eatt(1);
+}
+
+TEST(GATTClientDiscovery, discovery_over_eatt_multiple_bearers){
+    discovery_over_eatt(NUM_EATT_BEARERS);
+}
+
+TEST(GATTClientDiscovery, discovery_insufficient_resources){
+    gatt_client_database_init(&database, services, sizeof(services) / sizeof(gatt_client_service_t),
+                              characteristics, 10, descriptors, 0);
+    uint8_t status = gatt_client_discovery_start(&discovery, &packet_handler, con_handle, &database);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    CHECK_TRUE(discovery_complete);
+    CHECK_EQUAL(ATT_ERROR_INSUFFICIENT_RESOURCES, discovery_att_status);
+    CHECK_EQUAL(10, database.characteristics_num);
+}
+
+static const uint8_t database_hash_a[16] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf };
+static const uint8_t database_hash_b[16] = { 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf };
+
+TEST_GROUP(GATTClientDiscoveryCache){
+    mock_btstack_tlv_t tlv_context;
+
+    void setup(void){
+        const btstack_tlv_t * tlv_impl = mock_btstack_tlv_init_instance(&tlv_context);
+        btstack_tlv_set_instance(tlv_impl, &tlv_context);
+        // bonded device with le device db index 0, see sm_le_device_index in mock.c
+        bd_addr_t identity_address = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+        sm_key_t irk;
+        memset(irk, 0x77, sizeof(irk));
+        le_device_db_init();
+        (void) le_device_db_add(BD_ADDR_TYPE_LE_PUBLIC, identity_address, irk);
+
+        setup_peer_database(database_hash_a);
+        gatt_client_init();
+        gatt_client_mtu_enable_auto_negotiation(0);
+        hci_setup_le_connection(con_handle);
+        gatt_client_discovery_enable_cache(&packet_handler);
+        att_set_write_callback(&att_write_callback);
+        database_changed = false;
+        service_changed_configuration = 0;
+    }
+
+    void teardown(void){
+        att_set_write_callback(NULL);
+        mock_set_encryption_key_size(0);
+        btstack_tlv_set_instance(NULL, NULL);
+        mock_btstack_tlv_deinit(&tlv_context);
+    }
+
+    // @returns number of ATT requests
+    uint32_t discover(void){
+        gatt_client_database_init(&database, services, sizeof(services) / sizeof(gatt_client_service_t),
+                                  characteristics, sizeof(characteristics) / sizeof(gatt_client_characteristic_t),
+                                  descriptors, sizeof(descriptors) / sizeof(gatt_client_characteristic_descriptor_t));
+        discovery_complete = false;
+        discovery_att_status = ATT_ERROR_SUCCESS;
+        uint32_t num_requests = mock_att_get_num_requests();
+        uint8_t status = gatt_client_discovery_start(&discovery, &packet_handler, con_handle, &database);
+        CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+        CHECK_TRUE(discovery_complete);
+        CHECK_EQUAL(ATT_ERROR_SUCCESS, discovery_att_status);
+        check_database(true);
+        return mock_att_get_num_requests() - num_requests;
+    }
+};
+
+TEST(GATTClientDiscoveryCache, reconnect_with_same_database_hash){
+    uint32_t num_requests_full = discover();
+    CHECK_FALSE(discovery_from_cache);
+    CHECK_EQUAL(GATT_CLIENT_CHARACTERISTICS_CONFIGURATION_INDICATION, service_changed_configuration);
+    service_changed_configuration = 0;
+    uint32_t num_requests_cached = discover();
+    CHECK_TRUE(discovery_from_cache);
+    // Service Changed indication is enabled again for cached database
+    CHECK_EQUAL(GATT_CLIENT_CHARACTERISTICS_CONFIGURATION_INDICATION, service_changed_configuration);
+    // only Database Hash is read, Read By Type Request is repeated until end of database, then CCCD is written
+    CHECK_EQUAL(3, num_requests_cached);
+    printf("Reconnect:   %4u requests without cache, %4u requests with cache\n", (unsigned int) num_requests_full, (unsigned int) num_requests_cached);
+}
+
+TEST(GATTClientDiscoveryCache, reconnect_with_changed_database_hash){
+    (void) discover();
+    setup_peer_database(database_hash_b);
+    (void) discover();
+    CHECK_FALSE(discovery_from_cache);
+    // new hash has been stored
+    (void) discover();
+    CHECK_TRUE(discovery_from_cache);
+}
+
+TEST(GATTClientDiscoveryCache, service_changed_invalidates_cache){
+    (void) discover();
+    // indications are only accepted on encrypted connection to bonded device
+    mock_set_encryption_key_size(16);
+    uint8_t affected_handles[4] = { 0x10, 0x00, 0xff, 0xff };
+    mock_att_simulate_indication(service_changed_value_handle, affected_handles, sizeof(affected_handles));
+    CHECK_TRUE(database_changed);
+    CHECK_EQUAL(0x0010, database_changed_start_handle);
+    CHECK_EQUAL(0xffff, database_changed_end_handle);
+    (void) discover();
+    CHECK_FALSE(discovery_from_cache);
+}
+
+TEST(GATTClientDiscoveryCache, other_indication_ignored){
+    (void) discover();
+    mock_set_encryption_key_size(16);
+    uint8_t value[4] = { 0x10, 0x00, 0xff, 0xff };
+    mock_att_simulate_indication(service_changed_value_handle + 3, value, sizeof(value));
+    CHECK_FALSE(database_changed);
+    (void) discover();
+    CHECK_TRUE(discovery_from_cache);
+}
+
+TEST(GATTClientDiscoveryCache, cache_of_other_identity_ignored){
+    (void) discover();
+    // le device db entry re-used for other device
+    bd_addr_t other_identity_address = { 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 };
+    sm_key_t irk;
+    memset(irk, 0x88, sizeof(irk));
+    le_device_db_remove(0);
+    CHECK_EQUAL(0, le_device_db_add(BD_ADDR_TYPE_LE_PUBLIC, other_identity_address, irk));
+    (void) discover();
+    CHECK_FALSE(discovery_from_cache);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -79,9 +79,15 @@ bool gap_authenticated(hci_con_handle_t con_handle){
 	UNUSED(con_handle);
 	return false;
 }
+static uint8_t mock_encryption_key_size;
+
+void mock_set_encryption_key_size(uint8_t encryption_key_size){
+	mock_encryption_key_size = encryption_key_size;
+}
+
 uint8_t gap_encryption_key_size(hci_con_handle_t con_handle){
 	UNUSED(con_handle);
-	return 0;
+	return mock_encryption_key_size;
 }
 bool gap_bonded(hci_con_handle_t con_handle){
 	UNUSED(con_handle);
@@ -178,8 +184,15 @@ void l2cap_request_can_send_fix_channel_now_event(uint16_t handle, uint16_t chan
 	att_packet_handler(HCI_EVENT_PACKET, 0, (uint8_t*)event, sizeof(event));
 }
 
+static uint32_t mock_att_num_requests;
+
+uint32_t mock_att_get_num_requests(void){
+	return mock_att_num_requests;
+}
+
 uint8_t l2cap_send_prepared_connectionless(uint16_t handle, uint16_t cid, uint16_t len){
 	att_connection_t att_connection;
+	mock_att_num_requests++;
 	att_init_connection(&att_connection);
 	uint8_t response_buffer[PREBUFFER_SIZE + TEST_MAX_MTU];
 	uint8_t * response = &response_buffer[PREBUFFER_SIZE];
@@ -190,6 +203,15 @@ uint8_t l2cap_send_prepared_connectionless(uint16_t handle, uint16_t cid, uint16
 	return ERROR_CODE_SUCCESS;
 }
 
+void mock_att_simulate_indication(uint16_t value_handle, const uint8_t * value, uint16_t value_len){
+	uint8_t pdu[TEST_MAX_MTU];
+	btstack_assert(value_len <= (TEST_MAX_MTU - 3));
+	pdu[0] = ATT_HANDLE_VALUE_INDICATION;
+	little_endian_store_16(pdu, 1, value_handle);
+	memcpy(&pdu[3], value, value_len);
+	att_packet_handler(ATT_DATA_PACKET, gatt_client_handle, pdu, 3 + value_len);
+}
+
 void sm_add_event_handler(btstack_packet_callback_registration_t * callback_handler){
 }
 
@@ -274,3 +296,97 @@ void l2cap_run(void){
 void btstack_run_loop_execute_on_main_thread(btstack_context_callback_registration_t * callback_registration){
 	callback_registration->callback(callback_registration->context);
 }
+
+#ifdef ENABLE_GATT_OVER_EATT
+
+// simulated peer for EATT bearers: requests are answered by mock_l2cap_ecbm_process, one response per bearer
+#define MOCK_EATT_MAX_CHANNELS 5
+#define MOCK_EATT_MTU 64
+
+static btstack_packet_handler_t mock_eatt_packet_handler;
+static hci_con_handle_t mock_eatt_con_handle;
+static uint8_t  mock_eatt_num_channels;
+static bool     mock_eatt_channels_opening;
+static uint8_t  mock_eatt_requests[MOCK_EATT_MAX_CHANNELS][MOCK_EATT_MTU];
+static uint16_t mock_eatt_requests_len[MOCK_EATT_MAX_CHANNELS];
+
+uint8_t l2cap_ecbm_create_channels(btstack_packet_handler_t packet_handler, hci_con_handle_t con_handle,
+                                   gap_security_level_t security_level,
+                                   uint16_t psm, uint8_t num_channels, uint16_t initial_credits, uint16_t receive_buffer_size,
+                                   uint8_t ** receive_buffers, uint16_t * out_local_cids){
+	UNUSED(security_level);
+	UNUSED(psm);
+	UNUSED(initial_credits);
+	UNUSED(receive_buffer_size);
+	UNUSED(receive_buffers);
+	btstack_assert(num_channels <= MOCK_EATT_MAX_CHANNELS);
+	mock_eatt_packet_handler = packet_handler;
+	mock_eatt_con_handle = con_handle;
+	mock_eatt_num_channels = num_channels;
+	mock_eatt_channels_opening = true;
+	uint8_t i;
+	for (i=0;i<num_channels;i++){
+		out_local_cids[i] = 0x40 + i;
+		mock_eatt_requests_len[i] = 0;
+	}
+	return ERROR_CODE_SUCCESS;
+}
+
+uint8_t l2cap_send(uint16_t local_cid, const uint8_t *data, uint16_t len){
+	uint16_t index = local_cid - 0x40;
+	btstack_assert(index < mock_eatt_num_channels);
+	btstack_assert(mock_eatt_requests_len[index] == 0);
+	btstack_assert(len <= MOCK_EATT_MTU);
+	memcpy(mock_eatt_requests[index], data, len);
+	mock_eatt_requests_len[index] = len;
+	mock_att_num_requests++;
+	return ERROR_CODE_SUCCESS;
+}
+
+// @return number of responses sent by peer
+uint8_t mock_l2cap_ecbm_process(void){
+	uint8_t i;
+	if (mock_eatt_channels_opening){
+		mock_eatt_channels_opening = false;
+		for (i=0;i<mock_eatt_num_channels;i++){
+			uint8_t event[23];
+			memset(event, 0, sizeof(event));
+			event[0] = L2CAP_EVENT_ECBM_CHANNEL_OPENED;
+			event[1] = sizeof(event) - 2;
+			little_endian_store_16(event, 10, mock_eatt_con_handle);
+			little_endian_store_16(event, 15, 0x40 + i);
+			little_endian_store_16(event, 17, 0x40 + i);
+			little_endian_store_16(event, 19, MOCK_EATT_MTU);
+			little_endian_store_16(event, 21, MOCK_EATT_MTU);
+			(*mock_eatt_packet_handler)(HCI_EVENT_PACKET, 0, event, sizeof(event));
+		}
+		return 0;
+	}
+
+	// collect requests sent before this connection event
+	uint8_t  requests[MOCK_EATT_MAX_CHANNELS][MOCK_EATT_MTU];
+	uint16_t requests_len[MOCK_EATT_MAX_CHANNELS];
+	for (i=0;i<mock_eatt_num_channels;i++){
+		requests_len[i] = mock_eatt_requests_len[i];
+		memcpy(requests[i], mock_eatt_requests[i], requests_len[i]);
+		mock_eatt_requests_len[i] = 0;
+	}
+
+	uint8_t num_responses = 0;
+	for (i=0;i<mock_eatt_num_channels;i++){
+		if (requests_len[i] == 0) continue;
+		att_connection_t att_connection;
+		att_init_connection(&att_connection);
+		att_connection.mtu = MOCK_EATT_MTU;
+		att_connection.max_mtu = MOCK_EATT_MTU;
+		uint8_t response_buffer[PREBUFFER_SIZE + MOCK_EATT_MTU];
+		uint8_t * response = &response_buffer[PREBUFFER_SIZE];
+		uint16_t response_len = att_handle_request(&att_connection, requests[i], requests_len[i], response);
+		if (response_len > 0){
+			num_responses++;
+			(*mock_eatt_packet_handler)(L2CAP_DATA_PACKET, 0x40 + i, response, response_len);
+		}
+	}
+	return num_responses;
+}
+#endif
@@ -36,6 +36,9 @@ extern "C" void mock_call_att_packet_handler(uint8_t packet_type, uint16_t chann
 extern "C" void mock_l2cap_set_max_mtu(uint16_t mtu);
 extern "C" void hci_setup_classic_connection(uint16_t con_handle);
 extern "C" void set_cmac_ready(int ready);
+extern "C" void mock_process_main_thread_callbacks(void);
+extern "C" uint32_t mock_l2cap_get_num_packets_sent(void);
+extern "C" uint32_t mock_l2cap_get_num_bytes_sent(void);
 
 static uint8_t att_request[255];
 static uint16_t att_write_request(uint16_t request_type, uint16_t attribute_handle, uint16_t value_length, const uint8_t * value){
@@ -666,6 +669,145 @@ TEST(ATT_SERVER, att_server_register_service_handler) {
     att_server_register_service_handler(&test_service);
 }   
 
+TEST(ATT_SERVER, att_server_notify_aggregated){
+    static uint8_t value[] = {0x55, 0x66};
+    uint16_t value_handle = gatt_server_get_value_handle_for_characteristic_with_uuid16(0, 0xffff, ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL);
+    att_server_notification_stats_t stats;
+    uint8_t status;
+
+    // invalid con handle
+    status = att_server_notify_aggregated(0x50, value_handle, &value[0], 1);
+    CHECK_EQUAL(ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER, status);
+    status = att_server_set_multiple_notifications_supported(0x50, true);
+    CHECK_EQUAL(ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER, status);
+    status = att_server_get_notification_stats(0x50, &stats);
+    CHECK_EQUAL(ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER, status);
+
+    att_server_set_multiple_notifications_supported(att_con_handle, true);
+    att_server_get_notification_stats(att_con_handle, &stats);
+    att_server_notification_stats_t stats_before = stats;
+
+    // same attribute is coalesced, nothing is sent before the run loop gets back
+    uint32_t packets_before = mock_l2cap_get_num_packets_sent();
+    status = att_server_notify_aggregated(att_con_handle, value_handle, &value[0], 1);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    status = att_server_notify_aggregated(att_con_handle, value_handle, &value[0], 2);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    status = att_server_notify_aggregated(att_con_handle, value_handle + 3, &value[0], 2);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    CHECK_EQUAL(packets_before, mock_l2cap_get_num_packets_sent());
+
+    // both values fit into a single Multiple Handle Value Notification
+    mock_process_main_thread_callbacks();
+    CHECK_EQUAL(packets_before + 1, mock_l2cap_get_num_packets_sent());
+    att_server_get_notification_stats(att_con_handle, &stats);
+    CHECK_EQUAL(3, stats.num_values_queued     - stats_before.num_values_queued);
+    CHECK_EQUAL(1, stats.num_values_coalesced  - stats_before.num_values_coalesced);
+    CHECK_EQUAL(1, stats.num_pdus_sent         - stats_before.num_pdus_sent);
+    CHECK_EQUAL(1 + 6 + 6, stats.num_bytes_sent - stats_before.num_bytes_sent);
+
+    // without support for Multiple Handle Value Notifications, values are sent individually
+    att_server_set_multiple_notifications_supported(att_con_handle, false);
+    packets_before = mock_l2cap_get_num_packets_sent();
+    att_server_notify_aggregated(att_con_handle, value_handle, &value[0], 1);
+    att_server_notify_aggregated(att_con_handle, value_handle + 3, &value[0], 1);
+    mock_process_main_thread_callbacks();
+    CHECK_EQUAL(packets_before + 2, mock_l2cap_get_num_packets_sent());
+
+    // L2CAP cannot send, values are queued until queue is full
+    l2cap_can_send_fixed_channel_packet_now_set_status(0);
+    static uint8_t large_value[ATT_SERVER_NOTIFICATION_AGGREGATION_BUFFER_SIZE];
+    status = att_server_notify_aggregated(att_con_handle, value_handle, large_value, sizeof(large_value) - 4);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    status = att_server_notify_aggregated(att_con_handle, value_handle + 3, &value[0], 1);
+    CHECK_EQUAL(ERROR_CODE_MEMORY_CAPACITY_EXCEEDED, status);
+
+    // replacing the queued value in a full queue uses the space of the old value
+    att_server_get_notification_stats(att_con_handle, &stats_before);
+    large_value[0] = 0x11;
+    status = att_server_notify_aggregated(att_con_handle, value_handle, large_value, sizeof(large_value) - 4);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    att_server_get_notification_stats(att_con_handle, &stats);
+    CHECK_EQUAL(1, stats.num_values_coalesced - stats_before.num_values_coalesced);
+
+    // replacement that does not fit keeps the queued value
+    large_value[0] = 0x22;
+    status = att_server_notify_aggregated(att_con_handle, value_handle, large_value, sizeof(large_value) - 3);
+    CHECK_EQUAL(ERROR_CODE_MEMORY_CAPACITY_EXCEEDED, status);
+    att_server_get_notification_stats(att_con_handle, &stats);
+    CHECK_EQUAL(1, stats.num_values_coalesced - stats_before.num_values_coalesced);
+    CHECK_EQUAL(1, stats.num_values_queued    - stats_before.num_values_queued);
+    mock_process_main_thread_callbacks();
+
+    // queue is sent when L2CAP is ready again
+    packets_before = mock_l2cap_get_num_packets_sent();
+    l2cap_can_send_fixed_channel_packet_now_set_status(1);
+    uint8_t can_send_now_event[] = { L2CAP_EVENT_CAN_SEND_NOW, 2, 1, 0};
+    mock_call_att_server_packet_handler(HCI_EVENT_PACKET, 0, can_send_now_event, sizeof(can_send_now_event));
+    CHECK_EQUAL(packets_before + 1, mock_l2cap_get_num_packets_sent());
+    att_server_get_notification_stats(att_con_handle, &stats);
+    CHECK_EQUAL(1, stats.num_pdus_sent - stats_before.num_pdus_sent);
+}
+
+// synthetic sensor load: every connection event, each of the notifiable characteristics is updated several times
+static void att_server_notification_load(hci_con_handle_t con_handle, bool aggregate, uint32_t * out_num_pdus, uint32_t * out_num_bytes){
+    static const uint16_t uuids[] = {
+            ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL_STATE,
+            ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_POWER_STATE,
+            ORG_BLUETOOTH_CHARACTERISTIC_BLOOD_PRESSURE_FEATURE,
+            ORG_BLUETOOTH_CHARACTERISTIC_BODY_SENSOR_LOCATION,
+            ORG_BLUETOOTH_CHARACTERISTIC_CGM_SESSION_RUN_TIME,
+    };
+    const uint16_t num_connection_events = 1000;
+    const uint16_t updates_per_characteristic = 4;
+    uint8_t value[2];
+
+    uint32_t packets_before = mock_l2cap_get_num_packets_sent();
+    uint32_t bytes_before   = mock_l2cap_get_num_bytes_sent();
+    uint16_t i;
+    for (i = 0; i < num_connection_events; i++){
+        uint16_t j;
+        for (j = 0; j < updates_per_characteristic; j++){
+            uint16_t k;
+            for (k = 0; k < (sizeof(uuids) / sizeof(uint16_t)); k++){
+                uint16_t value_handle = gatt_server_get_value_handle_for_characteristic_with_uuid16(0, 0xffff, uuids[k]);
+                little_endian_store_16(value, 0, i);
+                if (aggregate){
+                    att_server_notify_aggregated(con_handle, value_handle, value, sizeof(value));
+                } else {
+                    att_server_notify(con_handle, value_handle, value, sizeof(value));
+                }
+            }
+        }
+        mock_process_main_thread_callbacks();
+    }
+    uint32_t num_pdus  = mock_l2cap_get_num_packets_sent() - packets_before;
+    // ATT PDU + L2CAP Basic Header + ACL Header
+    uint32_t num_bytes = mock_l2cap_get_num_bytes_sent() - bytes_before + (num_pdus * (4 + 4));
+    // 7.5 ms connection interval
+    printf("%-10s: %5u PDUs/s, %6u bytes/s on air\n", aggregate ? "aggregated" : "direct",
+           (unsigned int) (num_pdus * 1000 / (num_connection_events * 75 / 10)),
+           (unsigned int) (num_bytes * 1000 / (num_connection_events * 75 / 10)));
+    *out_num_pdus  = num_pdus;
+    *out_num_bytes = num_bytes;
+}
+
+TEST(ATT_SERVER, att_server_notify_aggregated_load){
+    uint32_t direct_pdus;
+    uint32_t direct_bytes;
+    uint32_t aggregated_pdus;
+    uint32_t aggregated_bytes;
+
+    att_server_notification_load(att_con_handle, false, &direct_pdus, &direct_bytes);
+    att_server_set_multiple_notifications_supported(att_con_handle, true);
+    att_server_notification_load(att_con_handle, true, &aggregated_pdus, &aggregated_bytes);
+
+    // 20 updates per connection event collapse into 5 values, 3 fit into a 23 byte MTU
+    CHECK_EQUAL(20000, direct_pdus);
+    CHECK_EQUAL(2000, aggregated_pdus);
+    CHECK_TRUE(aggregated_bytes < direct_bytes);
+}
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
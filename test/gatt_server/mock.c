@@ -22,6 +22,9 @@ static uint16_t max_mtu = 23;
 static uint8_t  l2cap_stack_buffer[HCI_INCOMING_PRE_BUFFER_SIZE + 8 + ATT_DEFAULT_MTU];	// pre buffer + HCI Header + L2CAP header
 static uint16_t gatt_client_handle = 0x40;
 static hci_connection_t hci_connection;
+static btstack_linked_list_t     main_thread_callbacks;
+static uint32_t mock_l2cap_num_packets_sent;
+static uint32_t mock_l2cap_num_bytes_sent;
 
 uint16_t get_gatt_client_handle(void){
 	return gatt_client_handle;
@@ -198,8 +201,18 @@ void l2cap_request_can_send_fix_channel_now_event(uint16_t handle, uint16_t chan
     att_server_packet_handler(HCI_EVENT_PACKET, 0, (uint8_t*)event, sizeof(event));
 }
 
+uint32_t mock_l2cap_get_num_packets_sent(void){
+    return mock_l2cap_num_packets_sent;
+}
+
+uint32_t mock_l2cap_get_num_bytes_sent(void){
+    return mock_l2cap_num_bytes_sent;
+}
+
 uint8_t l2cap_send_prepared_connectionless(uint16_t handle, uint16_t cid, uint16_t len){
 	att_connection_t att_connection;
+    mock_l2cap_num_packets_sent++;
+    mock_l2cap_num_bytes_sent += len;
     hci_setup_le_connection(handle);
 	uint8_t response[max_mtu];
 	uint16_t response_len = att_handle_request(&att_connection, l2cap_get_outgoing_buffer(), len, &response[0]);
@@ -236,6 +249,17 @@ irk_lookup_state_t sm_identity_resolving_state(hci_con_handle_t con_handle){
 void sm_request_pairing(hci_con_handle_t con_handle){
 }
 
+void btstack_run_loop_execute_on_main_thread(btstack_context_callback_registration_t * callback_registration){
+    btstack_linked_list_add_tail(&main_thread_callbacks, (btstack_linked_item_t *) callback_registration);
+}
+
+void mock_process_main_thread_callbacks(void){
+    while (btstack_linked_list_empty(&main_thread_callbacks) == false){
+        btstack_context_callback_registration_t * callback_registration = (btstack_context_callback_registration_t *) btstack_linked_list_pop(&main_thread_callbacks);
+        (*callback_registration->callback)(callback_registration->context);
+    }
+}
+
 void btstack_run_loop_set_timer(btstack_timer_source_t *a, uint32_t timeout_in_ms){
 }
 
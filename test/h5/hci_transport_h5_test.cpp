@@ -0,0 +1,470 @@
+// *****************************************************************************
+//
+// HCI H5 Transport Test
+//
+// H5 transport connected via simulated SLIP/UART lines to a simulated controller
+// with configurable sliding window and bit error rate. Time is simulated.
+//
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_linked_list.h"
+#include "btstack_run_loop.h"
+#include "btstack_slip.h"
+#include "btstack_uart.h"
+#include "btstack_util.h"
+#include "hci.h"
+#include "hci_transport.h"
+#include "hci_transport_h5.h"
+
+#define BAUDRATE          3000000
+#define ACL_PAYLOAD_SIZE  (HCI_ACL_PAYLOAD_SIZE)
+#define NUM_PACKETS       200
+#define MAX_SLIP_FRAME    (2 * (4 + HCI_OUTGOING_PACKET_BUFFER_SIZE + 2) + 2)
+#define MAX_PEER_FRAMES   16
+// time until controller acknowledges a received packet
+#define PEER_ACK_DELAY_US 1000
+#define SIMULATION_LIMIT_US (60 * 1000000ULL)
+
+// simulated time
+static uint64_t sim_time_us;
+
+// simulated run loop timers
+static btstack_linked_list_t timers;
+
+extern "C" void btstack_run_loop_set_timer_handler(btstack_timer_source_t * timer, void (*process)(btstack_timer_source_t * timer)){
+    timer->process = process;
+}
+
+extern "C" void btstack_run_loop_set_timer(btstack_timer_source_t * timer, uint32_t timeout_in_ms){
+    timer->timeout = (uint32_t) (sim_time_us / 1000) + timeout_in_ms;
+}
+
+extern "C" void btstack_run_loop_add_timer(btstack_timer_source_t * timer){
+    btstack_linked_list_remove(&timers, (btstack_linked_item_t *) timer);
+    btstack_linked_list_add(&timers, (btstack_linked_item_t *) timer);
+}
+
+extern "C" int btstack_run_loop_remove_timer(btstack_timer_source_t * timer){
+    return btstack_linked_list_remove(&timers, (btstack_linked_item_t *) timer) ? 1 : 0;
+}
+
+static btstack_timer_source_t * next_timer(void){
+    btstack_timer_source_t * next = NULL;
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &timers);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        btstack_timer_source_t * timer = (btstack_timer_source_t *) btstack_linked_list_iterator_next(&it);
+        if ((next == NULL) || (timer->timeout < next->timeout)){
+            next = timer;
+        }
+    }
+    return next;
+}
+
+// simulated line: SLIP encoded frames with bit errors, sent one after the other
+typedef struct {
+    uint8_t  data[MAX_SLIP_FRAME];
+    uint16_t len;
+    uint64_t ready_us;
+} slip_frame_t;
+
+static uint32_t bit_error_rate_ppm;
+static uint32_t random_state;
+
+static uint32_t random_next(void){
+    random_state = random_state * 1103515245u + 12345u;
+    return random_state >> 8;
+}
+
+static void slip_encode(slip_frame_t * slip_frame, const uint8_t * frame, uint16_t len){
+    btstack_slip_encoder_start(frame, len);
+    slip_frame->len = 0;
+    while (btstack_slip_encoder_has_data()){
+        slip_frame->data[slip_frame->len++] = btstack_slip_encoder_get_byte();
+    }
+    // flip bits
+    if (bit_error_rate_ppm == 0) return;
+    uint16_t i;
+    for (i = 0; i < (slip_frame->len * 8); i++){
+        if ((random_next() % 1000000u) < bit_error_rate_ppm){
+            slip_frame->data[i / 8] ^= 1 << (i & 7);
+        }
+    }
+}
+
+static uint16_t slip_decode(const slip_frame_t * slip_frame, uint8_t * buffer, uint16_t max_size){
+    btstack_slip_decoder_init(buffer, max_size);
+    uint16_t i;
+    for (i = 0; i < slip_frame->len; i++){
+        btstack_slip_decoder_process(slip_frame->data[i]);
+        uint16_t frame_size = btstack_slip_decoder_frame_size();
+        if (frame_size > 0){
+            return frame_size;
+        }
+    }
+    return 0;
+}
+
+static uint64_t transmission_time_us(const slip_frame_t * slip_frame){
+    // 8N1
+    return ((uint64_t) slip_frame->len * 10u * 1000000u) / BAUDRATE;
+}
+
+// CRC-CCITT as used for H5 Data Integrity Check
+static uint16_t crc16_ccitt(const uint8_t * data, uint16_t len){
+    uint16_t crc = 0xffff;
+    uint16_t i;
+    for (i = 0; i < len; i++){
+        crc ^= data[i];
+        int bit;
+        for (bit = 0; bit < 8; bit++){
+            crc = (crc & 1) ? ((crc >> 1) ^ 0x8408) : (crc >> 1);
+        }
+    }
+    // transmitted MSB first
+    uint16_t reversed = 0;
+    int bit;
+    for (bit = 0; bit < 16; bit++){
+        reversed = (reversed << 1) | ((crc >> bit) & 1);
+    }
+    return reversed;
+}
+
+// simulated controller
+static uint8_t  peer_window_size;
+static uint8_t  peer_ack_nr;
+static uint32_t peer_packets_received;
+static uint32_t peer_packets_dropped;
+static bool     peer_data_valid;
+
+static slip_frame_t peer_frames[MAX_PEER_FRAMES];
+static uint16_t     peer_frames_head;
+static uint16_t     peer_frames_count;
+static uint64_t     peer_tx_done_us;
+
+static void peer_start_next_frame(void){
+    slip_frame_t * slip_frame = &peer_frames[peer_frames_head];
+    peer_tx_done_us = btstack_max(sim_time_us, slip_frame->ready_us) + transmission_time_us(slip_frame);
+}
+
+static void peer_send_frame(uint8_t seq_ack_flags, uint8_t packet_type, const uint8_t * payload, uint16_t payload_len, uint32_t delay_us){
+    uint8_t frame[4 + 3];
+    frame[0] = seq_ack_flags;
+    frame[1] = packet_type | ((payload_len & 0x0f) << 4);
+    frame[2] = payload_len >> 4;
+    frame[3] = 0xff - (frame[0] + frame[1] + frame[2]);
+    memcpy(&frame[4], payload, payload_len);
+    CHECK_TRUE(peer_frames_count < MAX_PEER_FRAMES);
+    slip_frame_t * slip_frame = &peer_frames[(peer_frames_head + peer_frames_count) % MAX_PEER_FRAMES];
+    slip_encode(slip_frame, frame, 4 + payload_len);
+    slip_frame->ready_us = sim_time_us + delay_us;
+    peer_frames_count++;
+    if (peer_frames_count == 1){
+        peer_start_next_frame();
+    }
+}
+
+static void peer_process_frame(const uint8_t * frame, uint16_t frame_size){
+    if (frame_size < 4) return;
+    uint8_t header_checksum = frame[0] + frame[1] + frame[2] + frame[3];
+    if (header_checksum != 0xff) return;
+    bool     dic_present = (frame[0] & 0x40) != 0;
+    bool     reliable    = (frame[0] & 0x80) != 0;
+    uint8_t  seq_nr      = frame[0] & 0x07;
+    uint8_t  packet_type = frame[1] & 0x0f;
+    uint16_t payload_len = (frame[1] >> 4) | (frame[2] << 4);
+    if ((4u + payload_len + (dic_present ? 2u : 0u)) != frame_size) return;
+    const uint8_t * payload = &frame[4];
+    if (dic_present && (big_endian_read_16(frame, 4 + payload_len) != crc16_ccitt(frame, 4 + payload_len))) return;
+
+    // link control
+    if (packet_type == 0x0f){
+        static const uint8_t sync[]          = { 0x01, 0x7e };
+        static const uint8_t sync_response[] = { 0x02, 0x7d };
+        static const uint8_t config[]        = { 0x03, 0xfc };
+        if (memcmp(payload, sync, sizeof(sync)) == 0){
+            peer_send_frame(0, 0x0f, sync_response, sizeof(sync_response), 0);
+        }
+        if (memcmp(payload, config, sizeof(config)) == 0){
+            // sliding window, no OOF flow control, data integrity check
+            uint8_t config_response[] = { 0x04, 0x7b, (uint8_t) (peer_window_size | 0x10) };
+            peer_send_frame(0, 0x0f, config_response, sizeof(config_response), 0);
+            peer_ack_nr = 0;
+        }
+        return;
+    }
+
+    if (!reliable) return;
+
+    // drop out-of-sequence packets, ack expected seq nr
+    if (seq_nr == peer_ack_nr){
+        // ACL packets carry running packet number
+        uint32_t packet_number = little_endian_read_32(payload, 4);
+        if ((packet_type != HCI_ACL_DATA_PACKET) || (packet_number != peer_packets_received)){
+            peer_data_valid = false;
+        }
+        peer_packets_received++;
+        peer_ack_nr = (peer_ack_nr + 1) & 0x07;
+    } else {
+        peer_packets_dropped++;
+    }
+    peer_send_frame(peer_ack_nr << 3, 0x00, NULL, 0, PEER_ACK_DELAY_US);
+}
+
+// simulated UART with SLIP support
+static void (*uart_frame_received)(uint16_t frame_size);
+static void (*uart_frame_sent)(void);
+static uint8_t *     uart_receive_buffer;
+static uint16_t      uart_receive_len;
+static slip_frame_t  uart_tx_frame;
+static bool          uart_tx_active;
+static uint64_t      uart_tx_done_us;
+static uint32_t      uart_frames_sent;
+
+static int uart_init(const btstack_uart_config_t * uart_config){
+    return 0;
+}
+
+static int uart_open(void){
+    return 0;
+}
+
+static int uart_close(void){
+    return 0;
+}
+
+static int uart_set_baudrate(uint32_t baudrate){
+    return 0;
+}
+
+static int uart_set_parity(int parity){
+    return 0;
+}
+
+static void uart_set_frame_received(void (*frame_handler)(uint16_t frame_size)){
+    uart_frame_received = frame_handler;
+}
+
+static void uart_set_frame_sent(void (*frame_handler)(void)){
+    uart_frame_sent = frame_handler;
+}
+
+static void uart_receive_frame(uint8_t * buffer, uint16_t len){
+    uart_receive_buffer = buffer;
+    uart_receive_len = len;
+}
+
+static void uart_send_frame(const uint8_t * frame, uint16_t length){
+    CHECK_FALSE(uart_tx_active);
+    slip_encode(&uart_tx_frame, frame, length);
+    uart_tx_active = true;
+    uart_tx_done_us = sim_time_us + transmission_time_us(&uart_tx_frame);
+    uart_frames_sent++;
+}
+
+static const btstack_uart_t uart_slip = {
+    &uart_init,
+    &uart_open,
+    &uart_close,
+    NULL,
+    NULL,
+    &uart_set_baudrate,
+    &uart_set_parity,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    &uart_set_frame_received,
+    &uart_set_frame_sent,
+    &uart_receive_frame,
+    &uart_send_frame,
+};
+
+// simulated HCI layer with single outgoing packet buffer
+static const hci_transport_t * transport;
+static uint8_t  hci_packet_buffer[HCI_OUTGOING_PRE_BUFFER_SIZE + HCI_OUTGOING_PACKET_BUFFER_SIZE + 2];
+static bool     hci_packet_buffer_reserved;
+static bool     hci_link_active;
+static uint32_t hci_packets_sent;
+static uint32_t hci_packets_to_send;
+
+static void packet_handler(uint8_t packet_type, uint8_t * packet, uint16_t size){
+    if (packet_type != HCI_EVENT_PACKET) return;
+    if (packet[0] != HCI_EVENT_TRANSPORT_PACKET_SENT) return;
+    hci_link_active = true;
+    hci_packet_buffer_reserved = false;
+}
+
+static void hci_run(void){
+    if (!hci_link_active) return;
+    if (hci_packet_buffer_reserved) return;
+    if (hci_packets_sent >= hci_packets_to_send) return;
+    if (!transport->can_send_packet_now(HCI_ACL_DATA_PACKET)) return;
+
+    uint8_t * packet = &hci_packet_buffer[HCI_OUTGOING_PRE_BUFFER_SIZE];
+    little_endian_store_16(packet, 0, 0x0001);
+    little_endian_store_16(packet, 2, ACL_PAYLOAD_SIZE);
+    memset(&packet[4], (uint8_t) hci_packets_sent, ACL_PAYLOAD_SIZE);
+    little_endian_store_32(packet, 4, hci_packets_sent);
+    hci_packets_sent++;
+    hci_packet_buffer_reserved = true;
+    int res = transport->send_packet(HCI_ACL_DATA_PACKET, packet, 4 + ACL_PAYLOAD_SIZE);
+    CHECK_EQUAL(0, res);
+}
+
+// run simulation until link is active or all packets have been received by controller and lines are idle
+static void simulate(bool until_link_active){
+    while (sim_time_us < SIMULATION_LIMIT_US){
+        if (until_link_active && hci_link_active) break;
+        hci_run();
+        bool done = (peer_packets_received == hci_packets_to_send) && !hci_packet_buffer_reserved;
+        if (done && !uart_tx_active && (peer_frames_count == 0)) break;
+
+        // find next event
+        uint64_t next_us = UINT64_MAX;
+        if (uart_tx_active){
+            next_us = uart_tx_done_us;
+        }
+        if ((peer_frames_count > 0) && (peer_tx_done_us < next_us)){
+            next_us = peer_tx_done_us;
+        }
+        btstack_timer_source_t * timer = next_timer();
+        uint64_t timer_us = UINT64_MAX;
+        if (timer != NULL){
+            timer_us = (uint64_t) timer->timeout * 1000u;
+            if (timer_us < next_us){
+                next_us = timer_us;
+            }
+        }
+        if (next_us == UINT64_MAX) break;
+        if (next_us > sim_time_us){
+            sim_time_us = next_us;
+        }
+
+        // host frame received by controller
+        if (uart_tx_active && (uart_tx_done_us <= sim_time_us)){
+            uart_tx_active = false;
+            static uint8_t frame[4 + HCI_OUTGOING_PACKET_BUFFER_SIZE + 2];
+            uint16_t frame_size = slip_decode(&uart_tx_frame, frame, sizeof(frame));
+            peer_process_frame(frame, frame_size);
+            (*uart_frame_sent)();
+            continue;
+        }
+
+        // controller frame received by host
+        if ((peer_frames_count > 0) && (peer_tx_done_us <= sim_time_us)){
+            slip_frame_t * slip_frame = &peer_frames[peer_frames_head];
+            peer_frames_head = (peer_frames_head + 1) % MAX_PEER_FRAMES;
+            peer_frames_count--;
+            if (peer_frames_count > 0){
+                peer_start_next_frame();
+            }
+            uint16_t frame_size = slip_decode(slip_frame, uart_receive_buffer, uart_receive_len);
+            if (frame_size > 0){
+                (*uart_frame_received)(frame_size);
+            }
+            continue;
+        }
+
+        // timer
+        if ((timer != NULL) && (timer_us <= sim_time_us)){
+            btstack_run_loop_remove_timer(timer);
+            (*timer->process)(timer);
+        }
+    }
+}
+
+static hci_transport_config_uart_t config = {
+    HCI_TRANSPORT_CONFIG_UART,
+    BAUDRATE,
+    0,
+    1,
+    NULL,
+    0,
+};
+
+// returns throughput in bytes/s
+static uint32_t transfer(uint8_t window_size, uint32_t error_rate_ppm){
+    sim_time_us = 0;
+    timers = NULL;
+    random_state = 0x12345678;
+    peer_window_size = window_size;
+    peer_ack_nr = 0;
+    peer_packets_received = 0;
+    peer_packets_dropped = 0;
+    peer_data_valid = true;
+    peer_frames_head = 0;
+    peer_frames_count = 0;
+    uart_tx_active = false;
+    uart_frames_sent = 0;
+    hci_link_active = false;
+    hci_packet_buffer_reserved = false;
+    hci_packets_sent = 0;
+    hci_packets_to_send = NUM_PACKETS;
+
+    // link establishment without errors
+    bit_error_rate_ppm = 0;
+    transport = hci_transport_h5_instance(&uart_slip);
+    transport->register_packet_handler(&packet_handler);
+    transport->init(&config);
+    CHECK_EQUAL(0, transport->open());
+    simulate(true);
+    CHECK_TRUE(hci_link_active);
+
+    bit_error_rate_ppm = error_rate_ppm;
+    uint64_t start_us = sim_time_us;
+    uint32_t start_frames = uart_frames_sent;
+    simulate(false);
+    uint64_t duration_us = sim_time_us - start_us;
+
+    CHECK_EQUAL(NUM_PACKETS, peer_packets_received);
+    CHECK_TRUE(peer_data_valid);
+    CHECK_FALSE(hci_packet_buffer_reserved);
+
+    uint32_t bytes_per_second = (uint32_t) (((uint64_t) NUM_PACKETS * ACL_PAYLOAD_SIZE * 1000000u) / duration_us);
+    printf("H5 window %u, bit errors %4u ppm: %6u bytes/s, %4u frames sent, %3u dropped by controller\n",
+           window_size, (unsigned int) error_rate_ppm, (unsigned int) bytes_per_second,
+           (unsigned int) (uart_frames_sent - start_frames), (unsigned int) peer_packets_dropped);
+    return bytes_per_second;
+}
+
+TEST_GROUP(H5){
+    void setup(void){
+    }
+};
+
+TEST(H5, SlidingWindow){
+    uint32_t throughput_window_1 = transfer(1, 0);
+    uint32_t throughput_window_2 = transfer(2, 0);
+    uint32_t throughput_window_4 = transfer(4, 0);
+    uint32_t throughput_window_7 = transfer(7, 0);
+    CHECK_TRUE(throughput_window_2 > throughput_window_1);
+    CHECK_TRUE(throughput_window_4 >= throughput_window_2);
+    CHECK_TRUE(throughput_window_7 >= throughput_window_4);
+}
+
+TEST(H5, SlidingWindowWithBitErrors){
+    const uint8_t  window_sizes[] = { 1, 4, 7 };
+    const uint32_t error_rates_ppm[] = { 1, 10, 50 };
+    uint16_t i;
+    uint16_t j;
+    for (i = 0; i < sizeof(window_sizes); i++){
+        for (j = 0; j < (sizeof(error_rates_ppm) / sizeof(uint32_t)); j++){
+            transfer(window_sizes[i], error_rates_ppm[j]);
+        }
+    }
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -40,6 +40,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "CppUTest/TestHarness.h"
 #include "CppUTest/CommandLineTestRunner.h"
@@ -651,6 +652,104 @@ TEST(HFPParser, custom_command_hf_with_assignment){
     hfp_at_parser_test_dump_line_buffer();
 }
 
+typedef struct {
+    const char *  line;
+    int           is_handsfree;
+    hfp_command_t command;
+} hfp_at_parser_test_command_t;
+
+static const hfp_at_parser_test_command_t hfp_at_parser_test_commands[] = {
+    { "AT+BAC=1,2\r",        0, HFP_CMD_AVAILABLE_CODECS },
+    { "AT+BCC\r",            0, HFP_CMD_TRIGGER_CODEC_CONNECTION_SETUP },
+    { "AT+BCS=2\r",          0, HFP_CMD_HF_CONFIRMED_CODEC },
+    { "AT+BIA=1,1,1\r",      0, HFP_CMD_ENABLE_INDIVIDUAL_AG_INDICATOR_STATUS_UPDATE },
+    { "AT+BIEV=2,1\r",       0, HFP_CMD_HF_INDICATOR_STATUS },
+    { "AT+BIND=1,2\r",       0, HFP_CMD_LIST_GENERIC_STATUS_INDICATORS },
+    { "AT+BIND=?\r",         0, HFP_CMD_RETRIEVE_GENERIC_STATUS_INDICATORS },
+    { "AT+BIND?\r",          0, HFP_CMD_RETRIEVE_GENERIC_STATUS_INDICATORS_STATE },
+    { "AT+BINP=1\r",         0, HFP_CMD_HF_REQUEST_PHONE_NUMBER },
+    { "AT+BLDN\r",           0, HFP_CMD_REDIAL_LAST_NUMBER },
+    { "AT+BRSF=438\r",       0, HFP_CMD_SUPPORTED_FEATURES },
+    { "AT+BTRH=0\r",         0, HFP_CMD_RESPONSE_AND_HOLD_COMMAND },
+    { "AT+BTRH?\r",          0, HFP_CMD_RESPONSE_AND_HOLD_QUERY },
+    { "AT+BVRA=1\r",         0, HFP_CMD_HF_ACTIVATE_VOICE_RECOGNITION },
+    { "AT+CCWA=1\r",         0, HFP_CMD_ENABLE_CALL_WAITING_NOTIFICATION },
+    { "AT+CHLD=1\r",         0, HFP_CMD_CALL_HOLD },
+    { "AT+CHLD=?\r",         0, HFP_CMD_SUPPORT_CALL_HOLD_AND_MULTIPARTY_SERVICES },
+    { "AT+CHUP\r",           0, HFP_CMD_HANG_UP_CALL },
+    { "AT+CIND=?\r",         0, HFP_CMD_RETRIEVE_AG_INDICATORS },
+    { "AT+CIND?\r",          0, HFP_CMD_RETRIEVE_AG_INDICATORS_STATUS },
+    { "AT+CLCC\r",           0, HFP_CMD_LIST_CURRENT_CALLS },
+    { "AT+CLIP=1\r",         0, HFP_CMD_ENABLE_CLIP },
+    { "AT+CMEE=1\r",         0, HFP_CMD_ENABLE_EXTENDED_AUDIO_GATEWAY_ERROR },
+    { "AT+CMER=3,0,0,1\r",   0, HFP_CMD_ENABLE_INDICATOR_STATUS_UPDATE },
+    { "AT+CNUM\r",           0, HFP_CMD_GET_SUBSCRIBER_NUMBER_INFORMATION },
+    { "AT+COPS=3,0\r",       0, HFP_CMD_QUERY_OPERATOR_SELECTION_NAME_FORMAT },
+    { "AT+COPS?\r",          0, HFP_CMD_QUERY_OPERATOR_SELECTION_NAME },
+    { "AT+NREC=0\r",         0, HFP_CMD_TURN_OFF_EC_AND_NR },
+    { "AT+VGM=8\r",          0, HFP_CMD_SET_MICROPHONE_GAIN },
+    { "AT+VGS=8\r",          0, HFP_CMD_SET_SPEAKER_GAIN },
+    { "AT+VTS=1\r",          0, HFP_CMD_TRANSMIT_DTMF_CODES },
+    { "ATA\r",               0, HFP_CMD_CALL_ANSWERED },
+    { "ATD1234567;\r",       0, HFP_CMD_CALL_PHONE_NUMBER },
+    { "AT+XYZ=1\r",          0, HFP_CMD_UNKNOWN },
+    { "AT+AAA=1\r",          0, HFP_CMD_UNKNOWN },
+    { "AT+BRS=1\r",          0, HFP_CMD_UNKNOWN },
+    { "AT+BRSFX=1\r",        0, HFP_CMD_UNKNOWN },
+    { "\r\n+BCS:2\r\n",       1, HFP_CMD_AG_SUGGESTED_CODEC },
+    { "\r\n+BIND: 1,1\r\n",   1, HFP_CMD_SET_GENERIC_STATUS_INDICATOR_STATUS },
+    { "\r\n+BRSF: 1007\r\n",  1, HFP_CMD_SUPPORTED_FEATURES },
+    { "\r\n+BSIR: 1\r\n",     1, HFP_CMD_CHANGE_IN_BAND_RING_TONE_SETTING },
+    { "\r\n+BTRH: 0\r\n",     1, HFP_CMD_RESPONSE_AND_HOLD_STATUS },
+    { "\r\n+BVRA: 1\r\n",     1, HFP_CMD_AG_ACTIVATE_VOICE_RECOGNITION },
+    { "\r\n+CHLD: (1,1x,2,2x,3)\r\n", 1, HFP_CMD_SUPPORT_CALL_HOLD_AND_MULTIPARTY_SERVICES },
+    { "\r\n+CIEV: 2,1\r\n",   1, HFP_CMD_TRANSFER_AG_INDICATOR_STATUS },
+    { "\r\n+CME ERROR: 3\r\n",1, HFP_CMD_EXTENDED_AUDIO_GATEWAY_ERROR },
+    { "\r\n+COPS: 0,0,\"Operator\"\r\n", 1, HFP_CMD_QUERY_OPERATOR_SELECTION_NAME },
+    { "\r\n+VGM: 8\r\n",      1, HFP_CMD_SET_MICROPHONE_GAIN },
+    { "\r\n+VGM=8\r\n",       1, HFP_CMD_SET_MICROPHONE_GAIN },
+    { "\r\n+VGS: 8\r\n",      1, HFP_CMD_SET_SPEAKER_GAIN },
+    { "\r\n+VGS=8\r\n",       1, HFP_CMD_SET_SPEAKER_GAIN },
+    { "\r\nERROR\r\n",        1, HFP_CMD_ERROR },
+    { "\r\nOK\r\n",           1, HFP_CMD_OK },
+    { "\r\nRING\r\n",         1, HFP_CMD_RING },
+    { "\r\n+XYZ: 1\r\n",      1, HFP_CMD_UNKNOWN },
+    { "\r\nO\r\n",            1, HFP_CMD_NONE },
+    { "\r\nOKAY\r\n",         1, HFP_CMD_NONE },
+};
+
+static void hfp_at_parser_test_parse_command(const hfp_at_parser_test_command_t * command){
+    if (command->is_handsfree){
+        parse_hf(command->line);
+    } else {
+        parse_ag(command->line);
+    }
+}
+
+TEST(HFPParser, command_lookup){
+    uint16_t i;
+    for (i = 0; i < sizeof(hfp_at_parser_test_commands) / sizeof(hfp_at_parser_test_command_t); i++){
+        context.command = HFP_CMD_NONE;
+        hfp_at_parser_test_parse_command(&hfp_at_parser_test_commands[i]);
+        CHECK_EQUAL(hfp_at_parser_test_commands[i].command, context.command);
+    }
+}
+
+TEST(HFPParser, command_lookup_benchmark){
+    const uint32_t num_iterations = 10000;
+    const uint16_t num_commands = sizeof(hfp_at_parser_test_commands) / sizeof(hfp_at_parser_test_command_t);
+    uint32_t i;
+    clock_t start = clock();
+    for (i = 0; i < num_iterations; i++){
+        uint16_t j;
+        for (j = 0; j < num_commands; j++){
+            hfp_at_parser_test_parse_command(&hfp_at_parser_test_commands[j]);
+        }
+    }
+    clock_t ticks = clock() - start;
+    printf("AT parser: %.1f ns/line\n", (double) ticks * 1e9 / CLOCKS_PER_SEC / (num_iterations * num_commands));
+}
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
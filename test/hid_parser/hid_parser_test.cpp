@@ -10,10 +10,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "CppUTest/TestHarness.h"
 #include "CppUTest/CommandLineTestRunner.h"
 
+#include "bluetooth.h"
 #include "btstack_hid_parser.h"
 #include "hci_dump_posix_fs.h"
 #include "hci_dump_posix_stdout.h"
@@ -584,6 +586,127 @@ TEST(HID, GetReportSize){
     CHECK_EQUAL(8, report_size);
 }
 
+// compile descriptor into report table and compare decoded fields with parser
+static void expect_report_table_matches_parser(const uint8_t * descriptor, uint16_t descriptor_len, uint8_t report_id, const uint8_t * report, uint16_t report_len){
+    static btstack_hid_report_field_t fields[32];
+    btstack_hid_report_table_t table;
+    btstack_hid_report_table_init(&table, fields, 32);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, btstack_hid_report_table_compile(&table, descriptor, descriptor_len, HID_REPORT_TYPE_INPUT, report_id));
+
+    btstack_hid_parser_t parser;
+    btstack_hid_parser_init(&parser, descriptor, descriptor_len, HID_REPORT_TYPE_INPUT, report, report_len);
+    btstack_hid_report_iterator_t iterator;
+    btstack_hid_report_iterator_init(&iterator, &table, report, report_len);
+    while (btstack_hid_parser_has_more(&parser)){
+        CHECK_TRUE(btstack_hid_report_iterator_has_more(&iterator));
+        uint16_t usage_page;
+        uint16_t usage;
+        int32_t value;
+        btstack_hid_parser_get_field(&parser, &usage_page, &usage, &value);
+        uint16_t table_usage_page;
+        uint16_t table_usage;
+        int32_t table_value;
+        btstack_hid_report_iterator_get_field(&iterator, &table_usage_page, &table_usage, &table_value);
+        CHECK_EQUAL(usage_page, table_usage_page);
+        CHECK_EQUAL(usage, table_usage);
+        CHECK_EQUAL(value, table_value);
+    }
+    CHECK_FALSE(btstack_hid_report_iterator_has_more(&iterator));
+}
+
+TEST(HID, ReportTable){
+    expect_report_table_matches_parser(mouse_descriptor_without_report_id, sizeof(mouse_descriptor_without_report_id), 0, mouse_report_without_id_positive_xy, sizeof(mouse_report_without_id_positive_xy));
+    expect_report_table_matches_parser(mouse_descriptor_without_report_id, sizeof(mouse_descriptor_without_report_id), 0, mouse_report_without_id_negative_xy, sizeof(mouse_report_without_id_negative_xy));
+    expect_report_table_matches_parser(mouse_descriptor_with_report_id, sizeof(mouse_descriptor_with_report_id), 1, mouse_report_with_id_1, sizeof(mouse_report_with_id_1));
+    expect_report_table_matches_parser(hid_descriptor_keyboard_boot_mode, sizeof(hid_descriptor_keyboard_boot_mode), 0, keyboard_report1, sizeof(keyboard_report1));
+    expect_report_table_matches_parser(combo_descriptor_with_report_ids, sizeof(combo_descriptor_with_report_ids), 1, combo_report1, sizeof(combo_report1));
+    expect_report_table_matches_parser(combo_descriptor_with_report_ids, sizeof(combo_descriptor_with_report_ids), 2, combo_report2, sizeof(combo_report2));
+    expect_report_table_matches_parser(tank_mouse_descriptor, sizeof(tank_mouse_descriptor), 3, tank_mouse_report, sizeof(tank_mouse_report));
+    expect_report_table_matches_parser(xbox_wireless_descriptor, sizeof(xbox_wireless_descriptor), 1, xbox_wireless_report, sizeof(xbox_wireless_report));
+}
+
+TEST(HID, ReportTableBootKeyboard){
+    btstack_hid_report_field_t fields[4];
+    btstack_hid_report_table_t table;
+    btstack_hid_report_table_init(&table, fields, 4);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, btstack_hid_report_table_compile(&table, hid_descriptor_keyboard_boot_mode, sizeof(hid_descriptor_keyboard_boot_mode), HID_REPORT_TYPE_INPUT, 0));
+    // modifier bits and key code array
+    CHECK_EQUAL(2, table.num_fields);
+    CHECK_EQUAL(0, fields[0].bit_offset);
+    CHECK_EQUAL(8, fields[0].report_count);
+    CHECK_EQUAL(16, fields[1].bit_offset);
+    CHECK_EQUAL(6, fields[1].report_count);
+
+    // report for other report id
+    btstack_hid_report_iterator_t iterator;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, btstack_hid_report_table_compile(&table, combo_descriptor_with_report_ids, sizeof(combo_descriptor_with_report_ids), HID_REPORT_TYPE_INPUT, 2));
+    btstack_hid_report_iterator_init(&iterator, &table, combo_report1, sizeof(combo_report1));
+    CHECK_FALSE(btstack_hid_report_iterator_has_more(&iterator));
+
+    // truncated report
+    btstack_hid_report_iterator_init(&iterator, &table, combo_report2, 4);
+    uint16_t num_fields = 0;
+    while (btstack_hid_report_iterator_has_more(&iterator)){
+        uint16_t usage_page;
+        uint16_t usage;
+        int32_t value;
+        btstack_hid_report_iterator_get_field(&iterator, &usage_page, &usage, &value);
+        num_fields++;
+    }
+    CHECK_EQUAL(9, num_fields);
+
+    // table too small
+    btstack_hid_report_table_init(&table, fields, 2);
+    CHECK_EQUAL(ERROR_CODE_MEMORY_CAPACITY_EXCEEDED, btstack_hid_report_table_compile(&table, xbox_wireless_descriptor, sizeof(xbox_wireless_descriptor), HID_REPORT_TYPE_INPUT, 1));
+}
+
+#define NUM_BENCHMARK_REPORTS 100000
+
+static int32_t benchmark_sum;
+
+static void benchmark_report(const char * name, const uint8_t * descriptor, uint16_t descriptor_len, uint8_t report_id, const uint8_t * report, uint16_t report_len){
+    uint16_t usage_page;
+    uint16_t usage;
+    int32_t value;
+    uint32_t i;
+
+    clock_t start = clock();
+    for (i = 0; i < NUM_BENCHMARK_REPORTS; i++){
+        btstack_hid_parser_t parser;
+        btstack_hid_parser_init(&parser, descriptor, descriptor_len, HID_REPORT_TYPE_INPUT, report, report_len);
+        while (btstack_hid_parser_has_more(&parser)){
+            btstack_hid_parser_get_field(&parser, &usage_page, &usage, &value);
+            benchmark_sum += value;
+        }
+    }
+    clock_t parser_ticks = clock() - start;
+
+    static btstack_hid_report_field_t fields[32];
+    btstack_hid_report_table_t table;
+    btstack_hid_report_table_init(&table, fields, 32);
+    btstack_hid_report_table_compile(&table, descriptor, descriptor_len, HID_REPORT_TYPE_INPUT, report_id);
+    start = clock();
+    for (i = 0; i < NUM_BENCHMARK_REPORTS; i++){
+        btstack_hid_report_iterator_t iterator;
+        btstack_hid_report_iterator_init(&iterator, &table, report, report_len);
+        while (btstack_hid_report_iterator_has_more(&iterator)){
+            btstack_hid_report_iterator_get_field(&iterator, &usage_page, &usage, &value);
+            benchmark_sum += value;
+        }
+    }
+    clock_t table_ticks = clock() - start;
+
+    printf("%-15s parser %6.1f ns/report, table %6.1f ns/report\n", name,
+           (double) parser_ticks * 1e9 / CLOCKS_PER_SEC / NUM_BENCHMARK_REPORTS,
+           (double) table_ticks  * 1e9 / CLOCKS_PER_SEC / NUM_BENCHMARK_REPORTS);
+}
+
+TEST(HID, ReportTableBenchmark){
+    benchmark_report("Mouse",         mouse_descriptor_with_report_id, sizeof(mouse_descriptor_with_report_id), 1, mouse_report_with_id_1, sizeof(mouse_report_with_id_1));
+    benchmark_report("Boot Keyboard", hid_descriptor_keyboard_boot_mode, sizeof(hid_descriptor_keyboard_boot_mode), 0, keyboard_report1, sizeof(keyboard_report1));
+    benchmark_report("Combo",         combo_descriptor_with_report_ids, sizeof(combo_descriptor_with_report_ids), 2, combo_report2, sizeof(combo_report2));
+    benchmark_report("Xbox Wireless", xbox_wireless_descriptor, sizeof(xbox_wireless_descriptor), 1, xbox_wireless_report, sizeof(xbox_wireless_report));
+}
 
 int main (int argc, const char * argv[]){
 #if 1
@@ -14,6 +14,7 @@
 
 // BTstack features that can be enabled
 #define ENABLE_BLE
+#define ENABLE_CLASSIC
 #define ENABLE_LOG_ERROR
 #define ENABLE_LOG_INFO
 #define ENABLE_PRINTF_HEXDUMP
@@ -21,6 +22,7 @@
 #define ENABLE_LE_CENTRAL
 #define ENABLE_LE_PERIPHERAL
 #define ENABLE_L2CAP_LE_CREDIT_BASED_FLOW_CONTROL_MODE
+#define ENABLE_L2CAP_ENHANCED_RETRANSMISSION_MODE
 
 // for ready-to-use hci channels
 #define FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
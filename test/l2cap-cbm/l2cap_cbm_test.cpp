@@ -17,9 +17,14 @@ const hci_transport_t * mock_hci_transport_mock_get_instance(void);
 
 // mock_hci_transport.c
 #include <stddef.h>
-static uint8_t  mock_hci_transport_outgoing_packet_buffer[HCI_ACL_PAYLOAD_SIZE];
+static uint8_t  mock_hci_transport_outgoing_packet_buffer[HCI_ACL_HEADER_SIZE + HCI_ACL_PAYLOAD_SIZE];
 static uint16_t mock_hci_transport_outgoing_packet_size;
 static uint8_t  mock_hci_transport_outgoing_packet_type;
+// L2CAP payload of all outgoing ACL packets
+static uint8_t  mock_hci_transport_l2cap_payload[1000];
+static uint16_t mock_hci_transport_l2cap_payload_len;
+static uint16_t mock_hci_transport_num_acl_packets;
+static uint32_t mock_hci_transport_num_bytes_copied;
 
 static void (*mock_hci_transport_packet_handler)(uint8_t packet_type, uint8_t * packet, uint16_t size);
 static void mock_hci_transport_register_packet_handler(void (*packet_handler)(uint8_t packet_type, uint8_t * packet, uint16_t size)){
@@ -29,6 +34,15 @@ static int mock_hci_transport_send_packet(uint8_t packet_type, uint8_t *packet,
     mock_hci_transport_outgoing_packet_type = packet_type;
     mock_hci_transport_outgoing_packet_size = size;
     memcpy(mock_hci_transport_outgoing_packet_buffer, packet, size);
+    mock_hci_transport_num_bytes_copied += size;
+    if ((packet_type == HCI_ACL_DATA_PACKET) && (size > 8)){
+        uint16_t l2cap_payload_len = size - 8;
+        if ((mock_hci_transport_l2cap_payload_len + l2cap_payload_len) <= sizeof(mock_hci_transport_l2cap_payload)){
+            memcpy(&mock_hci_transport_l2cap_payload[mock_hci_transport_l2cap_payload_len], &packet[8], l2cap_payload_len);
+        }
+        mock_hci_transport_l2cap_payload_len += l2cap_payload_len;
+        mock_hci_transport_num_acl_packets++;
+    }
     return 0;
 }
 const hci_transport_t * mock_hci_transport_mock_get_instance(void){
@@ -69,6 +83,7 @@ void mock_hci_transport_receive_packet(uint8_t packet_type, const uint8_t * pack
 
 #define TEST_PACKET_SIZE       100
 #define HCI_CON_HANDLE_TEST_LE 0x0005
+#define HCI_CON_HANDLE_TEST_CLASSIC 0x0003
 #define TEST_PSM 0x1001
 
 static bool l2cap_channel_accept_incoming;
@@ -78,6 +93,9 @@ static uint16_t l2cap_cid;
 static bool l2cap_channel_opened;
 static btstack_packet_callback_registration_t l2cap_event_callback_registration;
 
+// btstack_util.c
+extern "C" uint32_t btstack_iovec_copy_num_bytes;
+
 const uint8_t le_data_channel_conn_request_1[] = {
         0x05, 0x20, 0x12, 0x00, 0x0e, 0x00, 0x05, 0x00, 0x14, 0x01, 0x0a, 0x00, 0x01, 0x10, 0x41, 0x00,
         0x64, 0x00, 0x30, 0x00, 0xff, 0xff
@@ -97,6 +115,47 @@ const uint8_t le_data_channel_data_1[] = {
         0x05, 0x20, 0x04, 0x00, 0x00, 0x00, 0x41, 0x00
 };
 
+const uint8_t le_data_channel_data_hallo[] = {
+        0x05, 0x00, 0x0b, 0x00, 0x07, 0x00, 0x41, 0x00, 0x05, 0x00, 0x68, 0x61, 0x6c, 0x6c, 0x6f
+};
+
+// extended features: ERTM
+const uint8_t classic_information_response_extended_features[] = {
+        0x03, 0x20, 0x10, 0x00, 0x0c, 0x00, 0x01, 0x00, 0x0b, 0x01, 0x08, 0x00, 0x02, 0x00, 0x00, 0x00,
+        0x08, 0x00, 0x00, 0x00
+};
+
+// remote cid 0x0040, local cid 0x0041
+const uint8_t classic_ertm_conn_response[] = {
+        0x03, 0x20, 0x10, 0x00, 0x0c, 0x00, 0x01, 0x00, 0x03, 0x02, 0x08, 0x00, 0x40, 0x00, 0x41, 0x00,
+        0x00, 0x00, 0x00, 0x00
+};
+
+const uint8_t classic_ertm_config_response[] = {
+        0x03, 0x20, 0x0e, 0x00, 0x0a, 0x00, 0x01, 0x00, 0x05, 0x03, 0x06, 0x00, 0x41, 0x00, 0x00, 0x00,
+        0x00, 0x00
+};
+
+// ERTM with tx window 8 and MPS 20, MTU 100, no FCS
+const uint8_t classic_ertm_config_request[] = {
+        0x03, 0x20, 0x1e, 0x00, 0x1a, 0x00, 0x01, 0x00, 0x04, 0x10, 0x16, 0x00, 0x41, 0x00, 0x00, 0x00,
+        0x04, 0x09, 0x03, 0x08, 0x02, 0xd0, 0x07, 0xe0, 0x2e, 0x14, 0x00, 0x01, 0x02, 0x64, 0x00, 0x05,
+        0x01, 0x00
+};
+
+static void mock_hci_transport_reset_outgoing_l2cap_payload(void){
+    mock_hci_transport_l2cap_payload_len = 0;
+}
+
+// report all outgoing ACL packets as completed to free Controller buffers
+static void mock_hci_transport_complete_acl_packets(void){
+    uint8_t event[] = { HCI_EVENT_NUMBER_OF_COMPLETED_PACKETS, 5, 1, 0, 0, 0, 0};
+    little_endian_store_16(event, 3, HCI_CON_HANDLE_TEST_LE);
+    little_endian_store_16(event, 5, mock_hci_transport_num_acl_packets);
+    mock_hci_transport_num_acl_packets = 0;
+    mock_hci_transport_receive_packet(HCI_EVENT_PACKET, (const uint8_t *) event, sizeof(event));
+}
+
 static void fix_boundary_flags(uint8_t * packet, uint16_t size){
     uint8_t acl_flags = packet[1] >> 4;
     if (acl_flags == 0){
@@ -138,6 +197,9 @@ static void l2cap_channel_packet_handler(uint8_t packet_type, uint16_t channel,
                 case L2CAP_EVENT_CBM_CHANNEL_OPENED:
                     l2cap_channel_opened = true;
                     break;
+                case L2CAP_EVENT_CHANNEL_OPENED:
+                    l2cap_channel_opened = l2cap_event_channel_opened_get_status(packet) == ERROR_CODE_SUCCESS;
+                    break;
                 default:
                     break;
             }
@@ -160,6 +222,10 @@ TEST_GROUP(L2CAP_CHANNELS){
         l2cap_register_fixed_channel(&l2cap_channel_packet_handler, L2CAP_CID_ATTRIBUTE_PROTOCOL);
         hci_dump_init(hci_dump_posix_stdout_get_instance());
         l2cap_channel_opened = false;
+        mock_hci_transport_l2cap_payload_len = 0;
+        mock_hci_transport_num_acl_packets = 0;
+        mock_hci_transport_num_bytes_copied = 0;
+        btstack_iovec_copy_num_bytes = 0;
     }
     void teardown(void){
         l2cap_remove_event_handler(&l2cap_event_callback_registration);
@@ -292,6 +358,221 @@ TEST(L2CAP_CHANNELS, incoming_decline){
     // TODO: verify data
 }
 
+static void open_outgoing_channel(void){
+    hci_setup_test_connections_fuzz();
+    l2cap_cbm_create_channel(&l2cap_channel_packet_handler, HCI_CON_HANDLE_TEST_LE, TEST_PSM, data_channel_buffer,
+                            sizeof(data_channel_buffer), L2CAP_LE_AUTOMATIC_CREDITS, LEVEL_0, &l2cap_cid);
+    mock_hci_transport_receive_packet(HCI_ACL_DATA_PACKET, le_data_channel_conn_response_1, sizeof(le_data_channel_conn_response_1));
+    CHECK(l2cap_channel_opened);
+    mock_hci_transport_complete_acl_packets();
+}
+
+static void open_outgoing_ertm_channel(void){
+    static uint8_t ertm_buffer[1000];
+    l2cap_ertm_config_t ertm_config = {
+            1,      // ertm mandatory
+            2,      // max transmit
+            2000,   // retransmission timeout ms
+            12000,  // monitor timeout ms
+            100,    // local mtu
+            4,      // num tx buffers
+            4,      // num rx buffers
+            0,      // no FCS
+    };
+    bd_addr_t address = { 0x66, 0x55, 0x44, 0x33, 0x00, HCI_CON_HANDLE_TEST_CLASSIC };
+    hci_setup_test_connections_fuzz();
+    gap_set_security_level(LEVEL_0);
+    uint8_t status = l2cap_ertm_create_channel(&l2cap_channel_packet_handler, address, TEST_PSM, &ertm_config,
+                                               ertm_buffer, sizeof(ertm_buffer), &l2cap_cid);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    // trigger information request
+    mock_hci_transport_complete_acl_packets();
+    mock_hci_transport_receive_packet(HCI_ACL_DATA_PACKET, classic_information_response_extended_features, sizeof(classic_information_response_extended_features));
+    mock_hci_transport_receive_packet(HCI_ACL_DATA_PACKET, classic_ertm_conn_response, sizeof(classic_ertm_conn_response));
+    mock_hci_transport_receive_packet(HCI_ACL_DATA_PACKET, classic_ertm_config_response, sizeof(classic_ertm_config_response));
+    mock_hci_transport_receive_packet(HCI_ACL_DATA_PACKET, classic_ertm_config_request, sizeof(classic_ertm_config_request));
+    CHECK(l2cap_channel_opened);
+}
+
+TEST(L2CAP_CHANNELS, fixed_channel_iovec){
+    hci_setup_test_connections_fuzz();
+    btstack_iovec_t iov[2];
+    iov[0].data = (const uint8_t *) "hal";
+    iov[0].len  = 3;
+    iov[1].data = (const uint8_t *) "lo";
+    iov[1].len  = 2;
+    uint8_t status = l2cap_send_connectionless_iovec(HCI_CON_HANDLE_TEST_LE, L2CAP_CID_ATTRIBUTE_PROTOCOL, iov, 2);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    CHECK_EQUAL(13, mock_hci_transport_outgoing_packet_size);
+    MEMCMP_EQUAL("hallo", &mock_hci_transport_outgoing_packet_buffer[8], 5);
+}
+
+TEST(L2CAP_CHANNELS, outgoing_iovec){
+    open_outgoing_channel();
+    btstack_iovec_t iov[2];
+    iov[0].data = (const uint8_t *) "hal";
+    iov[0].len  = 3;
+    iov[1].data = (const uint8_t *) "lo";
+    iov[1].len  = 2;
+    uint8_t status = l2cap_send_iovec(l2cap_cid, iov, 2);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    // same packet as for contiguous buffer
+    CHECK_EQUAL(sizeof(le_data_channel_data_hallo), mock_hci_transport_outgoing_packet_size);
+    MEMCMP_EQUAL(le_data_channel_data_hallo, mock_hci_transport_outgoing_packet_buffer, sizeof(le_data_channel_data_hallo));
+}
+
+TEST(L2CAP_CHANNELS, outgoing_iovec_invalid){
+    open_outgoing_channel();
+    btstack_iovec_t iov[L2CAP_MAX_NUM_IOVEC + 1];
+    memset(iov, 0, sizeof(iov));
+    CHECK_EQUAL(ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS, l2cap_send_iovec(l2cap_cid, iov, 0));
+    CHECK_EQUAL(ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS, l2cap_send_iovec(l2cap_cid, iov, L2CAP_MAX_NUM_IOVEC + 1));
+    // exceeds remote MTU
+    iov[0].data = data_channel_buffer;
+    iov[0].len  = TEST_PACKET_SIZE;
+    iov[1].data = data_channel_buffer;
+    iov[1].len  = 1;
+    CHECK_EQUAL(L2CAP_DATA_LEN_EXCEEDS_REMOTE_MTU, l2cap_send_iovec(l2cap_cid, iov, 2));
+}
+
+TEST(L2CAP_CHANNELS, outgoing_iovec_segmented){
+    open_outgoing_channel();
+    // SDU larger than remote MPS, buffer boundaries differ from PDU boundaries
+    uint8_t sdu[TEST_PACKET_SIZE];
+    uint16_t i;
+    for (i = 0; i < sizeof(sdu); i++){
+        sdu[i] = (uint8_t) i;
+    }
+    btstack_iovec_t iov[3];
+    iov[0].data = &sdu[0];
+    iov[0].len  = 5;
+    iov[1].data = &sdu[5];
+    iov[1].len  = 60;
+    iov[2].data = &sdu[65];
+    iov[2].len  = sizeof(sdu) - 65;
+    mock_hci_transport_reset_outgoing_l2cap_payload();
+    uint8_t status = l2cap_send_iovec(l2cap_cid, iov, 3);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    // 3 PDUs, first one with SDU length
+    CHECK_EQUAL(3, mock_hci_transport_num_acl_packets);
+    CHECK_EQUAL(2 + sizeof(sdu), mock_hci_transport_l2cap_payload_len);
+    CHECK_EQUAL(sizeof(sdu), little_endian_read_16(mock_hci_transport_l2cap_payload, 0));
+    MEMCMP_EQUAL(sdu, &mock_hci_transport_l2cap_payload[2], sizeof(sdu));
+}
+
+TEST(L2CAP_CHANNELS, outgoing_ertm_iovec_segmented){
+    open_outgoing_ertm_channel();
+    // SDU larger than remote MPS of 20, I-frames 2 and 3 start within the second and third buffer
+    uint8_t sdu[40];
+    uint16_t i;
+    for (i = 0; i < sizeof(sdu); i++){
+        sdu[i] = (uint8_t) i;
+    }
+    btstack_iovec_t iov[3];
+    iov[0].data = &sdu[0];
+    iov[0].len  = 5;
+    iov[1].data = &sdu[5];
+    iov[1].len  = 25;
+    iov[2].data = &sdu[30];
+    iov[2].len  = sizeof(sdu) - 30;
+    mock_hci_transport_reset_outgoing_l2cap_payload();
+    mock_hci_transport_num_acl_packets = 0;
+    uint8_t status = l2cap_send_iovec(l2cap_cid, iov, 3);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    // start, continuation and end I-frame, each with control field, first one with SDU length
+    CHECK_EQUAL(3, mock_hci_transport_num_acl_packets);
+    CHECK_EQUAL(2 + 2 + 18 + 2 + 20 + 2 + 2, mock_hci_transport_l2cap_payload_len);
+    const uint8_t * frame = mock_hci_transport_l2cap_payload;
+    CHECK_EQUAL(0x4000, little_endian_read_16(frame, 0));
+    CHECK_EQUAL(sizeof(sdu), little_endian_read_16(frame, 2));
+    MEMCMP_EQUAL(&sdu[0], &frame[4], 18);
+    frame += 4 + 18;
+    CHECK_EQUAL(0xc002, little_endian_read_16(frame, 0));
+    MEMCMP_EQUAL(&sdu[18], &frame[2], 20);
+    frame += 2 + 20;
+    CHECK_EQUAL(0x8004, little_endian_read_16(frame, 0));
+    MEMCMP_EQUAL(&sdu[38], &frame[2], 2);
+}
+
+// protocol header + payload, e.g. RTP header and media payload of an application
+// AVDTP source and BNEP already assembled their packets in the outgoing buffer, they copy as much with l2cap_send_iovec
+#define BENCHMARK_HEADER_SIZE  12
+#define BENCHMARK_PAYLOAD_SIZE 80
+#define BENCHMARK_NUM_SDUS     1000
+
+typedef struct {
+    uint32_t application;
+    uint32_t l2cap;
+    uint32_t transport;
+} benchmark_bytes_copied_t;
+
+static void benchmark_bytes_copied_start(void){
+    btstack_iovec_copy_num_bytes = 0;
+    mock_hci_transport_num_bytes_copied = 0;
+}
+
+static void benchmark_bytes_copied_stop(benchmark_bytes_copied_t * bytes_copied){
+    bytes_copied->l2cap     = btstack_iovec_copy_num_bytes;
+    bytes_copied->transport = mock_hci_transport_num_bytes_copied;
+}
+
+static void benchmark_bytes_copied_print(const char * name, const benchmark_bytes_copied_t * bytes_copied){
+    uint32_t payload_bytes = BENCHMARK_NUM_SDUS * BENCHMARK_PAYLOAD_SIZE;
+    uint32_t total = bytes_copied->application + bytes_copied->l2cap + bytes_copied->transport;
+    printf("%s: %u.%02u bytes copied per payload byte (application %u, l2cap %u, transport %u)\n", name,
+           total / payload_bytes, ((total * 100) / payload_bytes) % 100,
+           bytes_copied->application, bytes_copied->l2cap, bytes_copied->transport);
+}
+
+TEST(L2CAP_CHANNELS, benchmark_bytes_copied){
+    open_outgoing_channel();
+    uint8_t header[BENCHMARK_HEADER_SIZE];
+    uint8_t payload[BENCHMARK_PAYLOAD_SIZE];
+    uint8_t staging_buffer[BENCHMARK_HEADER_SIZE + BENCHMARK_PAYLOAD_SIZE];
+    memset(header, 0x11, sizeof(header));
+    memset(payload, 0x22, sizeof(payload));
+
+    // assemble header and payload in contiguous buffer first, then send
+    benchmark_bytes_copied_t bytes_copied_staging = { 0 };
+    uint32_t i;
+    benchmark_bytes_copied_start();
+    for (i = 0; i < BENCHMARK_NUM_SDUS; i++){
+        mock_hci_transport_reset_outgoing_l2cap_payload();
+        memcpy(&staging_buffer[0], header, sizeof(header));
+        memcpy(&staging_buffer[sizeof(header)], payload, sizeof(payload));
+        bytes_copied_staging.application += sizeof(staging_buffer);
+        CHECK_EQUAL(ERROR_CODE_SUCCESS, l2cap_send(l2cap_cid, staging_buffer, sizeof(staging_buffer)));
+        mock_hci_transport_complete_acl_packets();
+    }
+    benchmark_bytes_copied_stop(&bytes_copied_staging);
+
+    // gather header and payload
+    benchmark_bytes_copied_t bytes_copied_iovec = { 0 };
+    btstack_iovec_t iov[2];
+    iov[0].data = header;
+    iov[0].len  = sizeof(header);
+    iov[1].data = payload;
+    iov[1].len  = sizeof(payload);
+    benchmark_bytes_copied_start();
+    for (i = 0; i < BENCHMARK_NUM_SDUS; i++){
+        mock_hci_transport_reset_outgoing_l2cap_payload();
+        CHECK_EQUAL(ERROR_CODE_SUCCESS, l2cap_send_iovec(l2cap_cid, iov, 2));
+        mock_hci_transport_complete_acl_packets();
+    }
+    benchmark_bytes_copied_stop(&bytes_copied_iovec);
+    MEMCMP_EQUAL(header, &mock_hci_transport_l2cap_payload[2], sizeof(header));
+    MEMCMP_EQUAL(payload, &mock_hci_transport_l2cap_payload[2 + sizeof(header)], sizeof(payload));
+
+    printf("%u SDUs, %u bytes header + %u bytes payload\n", BENCHMARK_NUM_SDUS, BENCHMARK_HEADER_SIZE, BENCHMARK_PAYLOAD_SIZE);
+    benchmark_bytes_copied_print("staging", &bytes_copied_staging);
+    benchmark_bytes_copied_print("iovec  ", &bytes_copied_iovec);
+
+    // L2CAP copies each SDU byte once in both cases, the staging copy is saved
+    CHECK_EQUAL(BENCHMARK_NUM_SDUS * sizeof(staging_buffer), bytes_copied_staging.l2cap);
+    CHECK_EQUAL(BENCHMARK_NUM_SDUS * sizeof(staging_buffer), bytes_copied_iovec.l2cap);
+    CHECK_EQUAL(bytes_copied_staging.transport, bytes_copied_iovec.transport);
+}
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL MATTHIAS
+ * RINGWALD OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at 
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+ 
+// *****************************************************************************
+//
+// LC3 multi-channel benchmark: encode and decode all channels of a frame per call,
+// optionally spread across worker threads
+//
+// *****************************************************************************
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "btstack_util.h"
+#include "btstack_debug.h"
+#include "bluetooth.h"
+
+#include "btstack_lc3.h"
+#include "btstack_lc3_google.h"
+#include "btstack_parallel_posix.h"
+
+#define MAX_NUM_CHANNELS      BTSTACK_LC3_GOOGLE_MAX_CHANNELS
+#define SAMPLE_RATE           48000
+#define SAMPLES_PER_FRAME     480
+#define OCTETS_PER_FRAME      100
+#define DEFAULT_NUM_FRAMES    1000
+#define PI                    3.14159265358979323846
+
+static int16_t pcm_in[SAMPLES_PER_FRAME * MAX_NUM_CHANNELS];
+static int16_t pcm_out[SAMPLES_PER_FRAME * MAX_NUM_CHANNELS];
+static uint8_t lc3_frames[OCTETS_PER_FRAME * MAX_NUM_CHANNELS];
+static uint8_t bec_detect[MAX_NUM_CHANNELS];
+
+static btstack_lc3_encoder_google_t encoder_contexts[MAX_NUM_CHANNELS];
+static btstack_lc3_decoder_google_t decoder_contexts[MAX_NUM_CHANNELS];
+
+static double get_time_s(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + ((double) now.tv_nsec / 1000000000.0);
+}
+
+static void show_usage(const char * path){
+    printf("Usage: %s num_channels num_workers [num_frames]\n", path);
+    printf("- num_channels: 1..%u\n", MAX_NUM_CHANNELS);
+    printf("- num_workers:  additional worker threads, 0 = single-threaded\n");
+    printf("\n\n");
+}
+
+static void report(const char * name, uint8_t num_channels, uint8_t num_workers, uint32_t num_frames, double duration_s){
+    double channel_frames_per_s = ((double) num_frames * num_channels) / duration_s;
+    printf("%s: %u channels x %u frames in %.3f s -> %.0f channel frames/s, %.0f channel frames/s per core, %.1f x realtime\n",
+           name, num_channels, num_frames, duration_s, channel_frames_per_s, channel_frames_per_s / (num_workers + 1),
+           ((double) num_frames / 100.0) / duration_s);
+}
+
+int main (int argc, const char * argv[]){
+    if (argc < 3){
+        show_usage(argv[0]);
+        return -1;
+    }
+    uint8_t  num_channels = (uint8_t) atoi(argv[1]);
+    uint8_t  num_workers  = (uint8_t) atoi(argv[2]);
+    uint32_t num_frames   = (argc > 3) ? (uint32_t) atoi(argv[3]) : DEFAULT_NUM_FRAMES;
+    if ((num_channels == 0) || (num_channels > MAX_NUM_CHANNELS)){
+        show_usage(argv[0]);
+        return -1;
+    }
+
+    // setup codecs
+    uint8_t channel;
+    for (channel = 0; channel < num_channels; channel++){
+        const btstack_lc3_encoder_t * lc3_encoder = btstack_lc3_encoder_google_init_instance(&encoder_contexts[channel]);
+        lc3_encoder->configure(&encoder_contexts[channel], SAMPLE_RATE, BTSTACK_LC3_FRAME_DURATION_10000US, OCTETS_PER_FRAME);
+        const btstack_lc3_decoder_t * lc3_decoder = btstack_lc3_decoder_google_init_instance(&decoder_contexts[channel]);
+        lc3_decoder->configure(&decoder_contexts[channel], SAMPLE_RATE, BTSTACK_LC3_FRAME_DURATION_10000US, OCTETS_PER_FRAME);
+    }
+
+    // interleaved sine with different frequency per channel
+    uint16_t i;
+    for (i = 0; i < SAMPLES_PER_FRAME; i++){
+        for (channel = 0; channel < num_channels; channel++){
+            double phase = (2.0 * PI * (440.0 * (channel + 1)) * i) / SAMPLE_RATE;
+            pcm_in[i * num_channels + channel] = (int16_t) (16000.0 * sin(phase));
+        }
+    }
+
+    if (num_workers > 0){
+        btstack_parallel_posix_init(num_workers);
+        btstack_lc3_google_set_parallel_for(&btstack_parallel_posix_for);
+    }
+
+    printf("LC3 %u Hz, 10 ms, %u octets per frame, %u worker threads\n", SAMPLE_RATE, OCTETS_PER_FRAME, num_workers);
+
+    // encode
+    uint32_t frame;
+    double start_s = get_time_s();
+    for (frame = 0; frame < num_frames; frame++){
+        uint8_t status = btstack_lc3_encoder_google_encode_channels_signed_16(encoder_contexts, num_channels, pcm_in, num_channels,
+                                                                              lc3_frames, OCTETS_PER_FRAME);
+        btstack_assert(status == ERROR_CODE_SUCCESS);
+        UNUSED(status);
+    }
+    report("Encode", num_channels, num_workers, num_frames, get_time_s() - start_s);
+
+    // decode
+    start_s = get_time_s();
+    for (frame = 0; frame < num_frames; frame++){
+        uint8_t status = btstack_lc3_decoder_google_decode_channels_signed_16(decoder_contexts, num_channels, lc3_frames, OCTETS_PER_FRAME,
+                                                                              NULL, pcm_out, num_channels, bec_detect);
+        btstack_assert(status == ERROR_CODE_SUCCESS);
+        UNUSED(status);
+    }
+    report("Decode", num_channels, num_workers, num_frames, get_time_s() - start_s);
+
+    if (num_workers > 0){
+        btstack_lc3_google_set_parallel_for(NULL);
+        btstack_parallel_posix_deinit();
+    }
+    return 0;
+}
@@ -0,0 +1,473 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "bluetooth_data_types.h"
+#include "btstack_event.h"
+#include "btstack_run_loop.h"
+#include "btstack_util.h"
+#include "gap.h"
+#include "hci.h"
+#include "mesh/adv_bearer.h"
+
+#define NUM_NETWORK_PDUS           200
+#define NETWORK_TRANSMIT_COUNT     3
+#define NETWORK_TRANSMIT_INTERVAL  20
+#define MAX_ADVERTISING_SETS       8
+
+// simulated time and single timer used by adv bearer
+static uint32_t sim_time_ms;
+static btstack_timer_source_t * sim_timer;
+static uint32_t sim_timer_deadline_ms;
+
+uint32_t btstack_run_loop_get_time_ms(void){
+    return sim_time_ms;
+}
+void btstack_run_loop_set_timer(btstack_timer_source_t * ts, uint32_t timeout_in_ms){
+    ts->timeout = sim_time_ms + timeout_in_ms;
+}
+void btstack_run_loop_set_timer_handler(btstack_timer_source_t * ts, void (*process)(btstack_timer_source_t *_ts)){
+    ts->process = process;
+}
+void btstack_run_loop_add_timer(btstack_timer_source_t * ts){
+    sim_timer = ts;
+    sim_timer_deadline_ms = ts->timeout;
+}
+int btstack_run_loop_remove_timer(btstack_timer_source_t * ts){
+    if (sim_timer != ts) return 0;
+    sim_timer = NULL;
+    return 1;
+}
+
+// HCI
+static btstack_packet_callback_registration_t * hci_event_handler;
+void hci_add_event_handler(btstack_packet_callback_registration_t * callback_handler){
+    hci_event_handler = callback_handler;
+}
+static HCI_STATE sim_hci_state;
+HCI_STATE hci_get_state(void){
+    return sim_hci_state;
+}
+
+// own address configured via gap_random_address_set_mode
+static uint8_t sim_own_address_type;
+static const bd_addr_t sim_own_address = { 0xC0, 0x11, 0x22, 0x33, 0x44, 0x55 };
+void gap_le_get_own_address(uint8_t * addr_type, bd_addr_t addr){
+    *addr_type = sim_own_address_type;
+    memcpy(addr, sim_own_address, 6);
+}
+
+// legacy advertising
+static uint32_t num_legacy_advertisements;
+void gap_advertisements_set_params(uint16_t adv_int_min, uint16_t adv_int_max, uint8_t adv_type,
+    uint8_t direct_address_typ, bd_addr_t direct_address, uint8_t channel_map, uint8_t filter_policy){
+    UNUSED(adv_int_min);
+    UNUSED(adv_int_max);
+    UNUSED(adv_type);
+    UNUSED(direct_address_typ);
+    (void) direct_address;
+    UNUSED(channel_map);
+    UNUSED(filter_policy);
+}
+void gap_advertisements_set_data(uint8_t advertising_data_length, uint8_t * advertising_data){
+    UNUSED(advertising_data_length);
+    UNUSED(advertising_data);
+}
+void gap_advertisements_enable(int enabled){
+    if (enabled){
+        num_legacy_advertisements++;
+    }
+}
+
+// extended advertising, controller terminates set after requested number of advertising events
+typedef struct {
+    le_advertising_set_t * storage;
+    le_extended_advertising_parameters_t params;
+    const uint8_t * data;
+    uint16_t data_len;
+    bool     random_address_set;
+    bool     active;
+    uint8_t  num_events;
+    uint32_t end_ms;
+} sim_advertising_set_t;
+
+static bool                  extended_advertising_supported;
+static sim_advertising_set_t sim_advertising_sets[MAX_ADVERTISING_SETS + 1];
+static uint8_t               sim_num_advertising_sets;
+static uint8_t               sim_num_active_sets;
+static uint8_t               sim_max_active_sets;
+static uint8_t               sim_started_types[NUM_NETWORK_PDUS * 2];
+static uint16_t              sim_num_started;
+
+bool gap_extended_advertising_supported(void){
+    return extended_advertising_supported;
+}
+uint8_t gap_extended_advertising_setup(le_advertising_set_t * storage, const le_extended_advertising_parameters_t * advertising_parameters, uint8_t * out_advertising_handle){
+    if (sim_num_advertising_sets == MAX_ADVERTISING_SETS) return ERROR_CODE_MEMORY_CAPACITY_EXCEEDED;
+    sim_num_advertising_sets++;
+    sim_advertising_set_t * advertising_set = &sim_advertising_sets[sim_num_advertising_sets];
+    memset(advertising_set, 0, sizeof(sim_advertising_set_t));
+    advertising_set->storage = storage;
+    advertising_set->params = *advertising_parameters;
+    *out_advertising_handle = sim_num_advertising_sets;
+    return ERROR_CODE_SUCCESS;
+}
+uint8_t gap_extended_advertising_set_params(uint8_t advertising_handle, const le_extended_advertising_parameters_t * advertising_parameters){
+    CHECK_FALSE(sim_advertising_sets[advertising_handle].active);
+    sim_advertising_sets[advertising_handle].params = *advertising_parameters;
+    return ERROR_CODE_SUCCESS;
+}
+uint8_t gap_extended_advertising_get_params(uint8_t advertising_handle, le_extended_advertising_parameters_t * advertising_parameters){
+    *advertising_parameters = sim_advertising_sets[advertising_handle].params;
+    return ERROR_CODE_SUCCESS;
+}
+uint8_t gap_extended_advertising_set_adv_data(uint8_t advertising_handle, uint16_t advertising_data_length, const uint8_t * advertising_data){
+    CHECK_FALSE(sim_advertising_sets[advertising_handle].active);
+    sim_advertising_sets[advertising_handle].data = advertising_data;
+    sim_advertising_sets[advertising_handle].data_len = advertising_data_length;
+    return ERROR_CODE_SUCCESS;
+}
+uint8_t gap_extended_advertising_set_random_address(uint8_t advertising_handle, bd_addr_t random_address){
+    MEMCMP_EQUAL(sim_own_address, random_address, 6);
+    sim_advertising_sets[advertising_handle].random_address_set = true;
+    return ERROR_CODE_SUCCESS;
+}
+uint8_t gap_extended_advertising_stop(uint8_t advertising_handle){
+    sim_advertising_set_t * advertising_set = &sim_advertising_sets[advertising_handle];
+    if (advertising_set->active){
+        advertising_set->active = false;
+        sim_num_active_sets--;
+    }
+    return ERROR_CODE_SUCCESS;
+}
+uint8_t gap_extended_advertising_start(uint8_t advertising_handle, uint16_t timeout, uint8_t num_extended_advertising_events){
+    UNUSED(timeout);
+    sim_advertising_set_t * advertising_set = &sim_advertising_sets[advertising_handle];
+    CHECK_FALSE(advertising_set->active);
+    CHECK_TRUE(num_extended_advertising_events > 0);
+    uint32_t interval_ms = advertising_set->params.primary_advertising_interval_min * 625 / 1000;
+    advertising_set->active = true;
+    advertising_set->num_events = num_extended_advertising_events;
+    advertising_set->end_ms = sim_time_ms + (num_extended_advertising_events * interval_ms);
+    sim_num_active_sets++;
+    sim_max_active_sets = btstack_max(sim_max_active_sets, sim_num_active_sets);
+    sim_started_types[sim_num_started++] = advertising_set->data[1];
+    return ERROR_CODE_SUCCESS;
+}
+
+static void sim_emit_event(uint8_t * packet, uint16_t size){
+    (*hci_event_handler->callback)(HCI_EVENT_PACKET, 0, packet, size);
+}
+
+static void sim_advertising_set_terminated(uint8_t advertising_handle){
+    sim_advertising_set_t * advertising_set = &sim_advertising_sets[advertising_handle];
+    advertising_set->active = false;
+    sim_num_active_sets--;
+    uint8_t event[] = { HCI_EVENT_LE_META, 5, HCI_SUBEVENT_LE_ADVERTISING_SET_TERMINATED, 0x43, advertising_handle, 0, 0, advertising_set->num_events };
+    sim_emit_event(event, sizeof(event));
+}
+
+static void sim_emit_hci_state(HCI_STATE state){
+    sim_hci_state = state;
+    uint8_t event[] = { BTSTACK_EVENT_STATE, 1, (uint8_t) state };
+    sim_emit_event(event, sizeof(event));
+}
+
+// Controller rejects parameters, e.g. as it does not support as many advertising sets
+static void sim_advertising_set_installed(uint8_t advertising_handle, uint8_t status){
+    uint8_t event[] = { HCI_EVENT_META_GAP, 4, GAP_SUBEVENT_ADVERTISING_SET_INSTALLED, advertising_handle, status, 0 };
+    sim_emit_event(event, sizeof(event));
+}
+
+// HCI Set Extended Advertising Data or Enable failed
+static void sim_advertising_set_command_failed(uint8_t advertising_handle, uint16_t opcode, uint8_t status){
+    sim_advertising_set_t * advertising_set = &sim_advertising_sets[advertising_handle];
+    if (advertising_set->active){
+        advertising_set->active = false;
+        sim_num_active_sets--;
+    }
+    uint8_t event[] = { HCI_EVENT_META_GAP, 5, GAP_SUBEVENT_ADVERTISING_SET_COMMAND_FAILED, advertising_handle, 0, 0, status };
+    little_endian_store_16(event, 4, opcode);
+    sim_emit_event(event, sizeof(event));
+}
+
+// advance simulated time to next timeout or advertising set termination
+static void sim_step(void){
+    uint8_t next_handle = 0;
+    uint32_t next_ms = 0xffffffffu;
+    if (sim_timer != NULL){
+        next_ms = sim_timer_deadline_ms;
+    }
+    uint8_t i;
+    for (i = 1; i <= sim_num_advertising_sets; i++){
+        if (sim_advertising_sets[i].active == false) continue;
+        if (sim_advertising_sets[i].end_ms >= next_ms) continue;
+        next_ms = sim_advertising_sets[i].end_ms;
+        next_handle = i;
+    }
+    CHECK_TRUE(next_ms != 0xffffffffu);
+    sim_time_ms = btstack_max(sim_time_ms, next_ms);
+    if (next_handle != 0){
+        sim_advertising_set_terminated(next_handle);
+    } else {
+        btstack_timer_source_t * ts = sim_timer;
+        sim_timer = NULL;
+        (*ts->process)(ts);
+    }
+}
+
+// clients
+static const uint8_t network_pdu[] = { 0x68, 0xca, 0xba, 0xcd, 0xe3, 0xb5, 0x0c, 0x2b, 0x9a, 0x0e, 0x95, 0x4f, 0x2c, 0x7b, 0x6d, 0x74, 0x8f, 0x6d, 0x9c, 0x4b };
+static const uint8_t beacon[]      = { 0x01, 0x00, 0x3e, 0xca, 0xff, 0x67, 0x2f, 0x67, 0x33, 0x70, 0x2b, 0x12, 0x34, 0x56, 0x78, 0x8f, 0x6d, 0x9c, 0x4b, 0x12, 0x34, 0x56 };
+static const uint8_t pb_adv_pdu[]  = { 0x00, 0x00, 0x00, 0x01, 0x00, 0x03, 0x00 };
+
+static uint16_t num_network_pdus_to_send;
+static uint16_t num_network_pdus_sent;
+static uint8_t  network_transmit_interval_ms;
+static uint16_t num_beacons_to_send;
+
+static void network_packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    if (hci_event_mesh_meta_get_subevent_code(packet) != MESH_SUBEVENT_CAN_SEND_NOW) return;
+    if (num_network_pdus_sent == num_network_pdus_to_send) return;
+    adv_bearer_send_network_pdu(network_pdu, sizeof(network_pdu), NETWORK_TRANSMIT_COUNT, network_transmit_interval_ms);
+    num_network_pdus_sent++;
+    if (num_network_pdus_sent < num_network_pdus_to_send){
+        adv_bearer_request_can_send_now_for_network_pdu();
+    }
+}
+
+static void beacon_packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    if (hci_event_mesh_meta_get_subevent_code(packet) != MESH_SUBEVENT_CAN_SEND_NOW) return;
+    if (num_beacons_to_send == 0) return;
+    adv_bearer_send_beacon(beacon, sizeof(beacon));
+    num_beacons_to_send--;
+    if (num_beacons_to_send > 0){
+        adv_bearer_request_can_send_now_for_beacon();
+    }
+}
+
+static void provisioning_packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    if (hci_event_mesh_meta_get_subevent_code(packet) != MESH_SUBEVENT_CAN_SEND_NOW) return;
+    adv_bearer_send_provisioning_pdu(pb_adv_pdu, sizeof(pb_adv_pdu));
+}
+
+static void setup_adv_bearer(bool extended_advertising){
+    sim_time_ms = 1000;
+    sim_timer = NULL;
+    sim_num_advertising_sets = 0;
+    sim_num_active_sets = 0;
+    sim_max_active_sets = 0;
+    sim_num_started = 0;
+    num_legacy_advertisements = 0;
+    num_network_pdus_sent = 0;
+    num_network_pdus_to_send = 0;
+    num_beacons_to_send = 0;
+    network_transmit_interval_ms = NETWORK_TRANSMIT_INTERVAL;
+    extended_advertising_supported = extended_advertising;
+
+    adv_bearer_init();
+    adv_bearer_register_for_network_pdu(&network_packet_handler);
+    adv_bearer_register_for_beacon(&beacon_packet_handler);
+    adv_bearer_register_for_provisioning_pdu(&provisioning_packet_handler);
+
+    sim_emit_hci_state(HCI_STATE_WORKING);
+}
+
+static void send_network_pdus(uint16_t num_pdus){
+    num_network_pdus_to_send = num_pdus;
+    adv_bearer_request_can_send_now_for_network_pdu();
+}
+
+static void run_until_sent(uint32_t num_pdus){
+    adv_bearer_statistics_t statistics;
+    while (true){
+        adv_bearer_get_statistics(&statistics);
+        if (statistics.pdus_sent == num_pdus) break;
+        sim_step();
+    }
+}
+
+TEST_GROUP(AdvBearer){
+    void setup(void){
+        sim_own_address_type = BD_ADDR_TYPE_LE_PUBLIC;
+    }
+};
+
+TEST(AdvBearer, ExtendedAdvertisingParallel){
+    setup_adv_bearer(true);
+    CHECK_EQUAL(MESH_ADV_BEARER_NUM_ADVERTISING_SETS, sim_num_advertising_sets);
+    send_network_pdus(20);
+    run_until_sent(20);
+    CHECK_EQUAL(20, num_network_pdus_sent);
+    CHECK_EQUAL(MESH_ADV_BEARER_NUM_ADVERTISING_SETS, sim_max_active_sets);
+    CHECK_EQUAL(0, num_legacy_advertisements);
+
+    adv_bearer_statistics_t statistics;
+    adv_bearer_get_statistics(&statistics);
+    CHECK_EQUAL(0, statistics.pdus_dropped);
+    // 20 ms interval matches default parameters
+    CHECK_EQUAL(0, statistics.parameter_updates);
+}
+
+TEST(AdvBearer, LegacyAdvertising){
+    setup_adv_bearer(false);
+    CHECK_EQUAL(0, sim_num_advertising_sets);
+    send_network_pdus(5);
+    run_until_sent(5);
+    CHECK_EQUAL(5, num_network_pdus_sent);
+    CHECK_EQUAL(5 * NETWORK_TRANSMIT_COUNT, num_legacy_advertisements);
+}
+
+TEST(AdvBearer, Priority){
+    setup_adv_bearer(true);
+    // fill advertising sets and queue with network pdus, then request provisioning pdu
+    num_network_pdus_to_send = MESH_ADV_BEARER_QUEUE_SIZE;
+    adv_bearer_request_can_send_now_for_network_pdu();
+    CHECK_EQUAL(MESH_ADV_BEARER_QUEUE_SIZE, num_network_pdus_sent);
+    CHECK_EQUAL(MESH_ADV_BEARER_NUM_ADVERTISING_SETS, sim_num_started);
+    adv_bearer_request_can_send_now_for_provisioning_pdu();
+    // provisioning pdu overtakes queued network pdus on first set that becomes available
+    sim_step();
+    CHECK_EQUAL(MESH_ADV_BEARER_NUM_ADVERTISING_SETS + 1, sim_num_started);
+    CHECK_EQUAL(BLUETOOTH_DATA_TYPE_PB_ADV, sim_started_types[MESH_ADV_BEARER_NUM_ADVERTISING_SETS]);
+    run_until_sent(MESH_ADV_BEARER_QUEUE_SIZE + 1);
+}
+
+TEST(AdvBearer, ParameterUpdatesBatched){
+    setup_adv_bearer(true);
+    // beacons use 100 ms interval, network pdus 20 ms
+    num_beacons_to_send = 10;
+    adv_bearer_request_can_send_now_for_beacon();
+    send_network_pdus(40);
+    run_until_sent(50);
+    adv_bearer_statistics_t statistics;
+    adv_bearer_get_statistics(&statistics);
+    // sets with matching interval are reused
+    CHECK_TRUE(statistics.parameter_updates < 20);
+}
+
+TEST(AdvBearer, QueueFull){
+    setup_adv_bearer(false);
+    uint16_t i;
+    for (i = 0; i < MESH_ADV_BEARER_QUEUE_SIZE + 2; i++){
+        adv_bearer_send_network_pdu(network_pdu, sizeof(network_pdu), NETWORK_TRANSMIT_COUNT, NETWORK_TRANSMIT_INTERVAL);
+    }
+    adv_bearer_statistics_t statistics;
+    adv_bearer_get_statistics(&statistics);
+    CHECK_EQUAL(2, statistics.pdus_dropped);
+    run_until_sent(MESH_ADV_BEARER_QUEUE_SIZE);
+}
+
+TEST(AdvBearer, OwnAddressTypeRandom){
+    sim_own_address_type = BD_ADDR_TYPE_LE_RANDOM;
+    setup_adv_bearer(true);
+    uint8_t i;
+    for (i = 1; i <= sim_num_advertising_sets; i++){
+        CHECK_EQUAL(BD_ADDR_TYPE_LE_RANDOM, sim_advertising_sets[i].params.own_address_type);
+        CHECK_TRUE(sim_advertising_sets[i].random_address_set);
+    }
+}
+
+TEST(AdvBearer, ParametersRejected){
+    setup_adv_bearer(true);
+    // Controller supports only two advertising sets besides the legacy one
+    uint8_t i;
+    for (i = 3; i <= MESH_ADV_BEARER_NUM_ADVERTISING_SETS; i++){
+        sim_advertising_set_installed(i, ERROR_CODE_MEMORY_CAPACITY_EXCEEDED);
+    }
+    send_network_pdus(20);
+    run_until_sent(20);
+    CHECK_EQUAL(2, sim_max_active_sets);
+    CHECK_EQUAL(0, num_legacy_advertisements);
+
+    adv_bearer_statistics_t statistics;
+    adv_bearer_get_statistics(&statistics);
+    CHECK_EQUAL(0, statistics.pdus_dropped);
+}
+
+TEST(AdvBearer, AllParametersRejected){
+    setup_adv_bearer(true);
+    uint8_t i;
+    for (i = 1; i <= MESH_ADV_BEARER_NUM_ADVERTISING_SETS; i++){
+        sim_advertising_set_installed(i, ERROR_CODE_UNSUPPORTED_FEATURE_OR_PARAMETER_VALUE);
+    }
+    // fall back to legacy advertising
+    send_network_pdus(5);
+    run_until_sent(5);
+    CHECK_EQUAL(0, sim_max_active_sets);
+    CHECK_EQUAL(5 * NETWORK_TRANSMIT_COUNT, num_legacy_advertisements);
+}
+
+TEST(AdvBearer, CommandFailed){
+    setup_adv_bearer(true);
+    send_network_pdus(1);
+    CHECK_EQUAL(1, sim_num_active_sets);
+    sim_advertising_set_command_failed(1, HCI_OPCODE_HCI_LE_SET_EXTENDED_ADVERTISING_ENABLE, ERROR_CODE_UNSPECIFIED_ERROR);
+    CHECK_EQUAL(0, sim_num_active_sets);
+
+    // message is dropped, set is released and used again
+    adv_bearer_statistics_t statistics;
+    adv_bearer_get_statistics(&statistics);
+    CHECK_EQUAL(1, statistics.pdus_dropped);
+    send_network_pdus(1 + MESH_ADV_BEARER_NUM_ADVERTISING_SETS);
+    CHECK_EQUAL(MESH_ADV_BEARER_NUM_ADVERTISING_SETS, sim_num_active_sets);
+    run_until_sent(MESH_ADV_BEARER_NUM_ADVERTISING_SETS);
+}
+
+TEST(AdvBearer, PowerCycle){
+    setup_adv_bearer(true);
+    num_network_pdus_to_send = MESH_ADV_BEARER_QUEUE_SIZE;
+    adv_bearer_request_can_send_now_for_network_pdu();
+    CHECK_EQUAL(MESH_ADV_BEARER_NUM_ADVERTISING_SETS, sim_num_active_sets);
+
+    // messages in advertising sets are lost, queued messages are kept
+    sim_emit_hci_state(HCI_STATE_HALTING);
+    sim_emit_hci_state(HCI_STATE_OFF);
+    CHECK_EQUAL(0, sim_num_active_sets);
+    adv_bearer_statistics_t statistics;
+    adv_bearer_get_statistics(&statistics);
+    CHECK_EQUAL(MESH_ADV_BEARER_NUM_ADVERTISING_SETS, statistics.pdus_dropped);
+
+    // advertising sets stay registered with HCI
+    sim_emit_hci_state(HCI_STATE_WORKING);
+    CHECK_EQUAL(MESH_ADV_BEARER_NUM_ADVERTISING_SETS, sim_num_advertising_sets);
+    run_until_sent(MESH_ADV_BEARER_QUEUE_SIZE - MESH_ADV_BEARER_NUM_ADVERTISING_SETS);
+    CHECK_EQUAL(0, num_legacy_advertisements);
+}
+
+static void benchmark(bool extended_advertising, uint8_t transmit_interval_ms){
+    setup_adv_bearer(extended_advertising);
+    network_transmit_interval_ms = transmit_interval_ms;
+    send_network_pdus(NUM_NETWORK_PDUS);
+    run_until_sent(NUM_NETWORK_PDUS);
+    adv_bearer_statistics_t statistics;
+    adv_bearer_get_statistics(&statistics);
+    printf("%-21s interval %3u ms: %4u PDUs/s, queue latency avg %5u ms, max %5u ms, %u parameter updates\n",
+           extended_advertising ? "Extended Advertising:" : "Legacy Advertising:",
+           transmit_interval_ms, (unsigned int) statistics.pdus_per_second,
+           (unsigned int) statistics.queue_latency_avg_ms, (unsigned int) statistics.queue_latency_max_ms,
+           (unsigned int) statistics.parameter_updates);
+}
+
+TEST(AdvBearer, Benchmark){
+    printf("Relay %u network PDUs with %u transmissions, %u advertising sets, queue size %u\n",
+           NUM_NETWORK_PDUS, NETWORK_TRANSMIT_COUNT, MESH_ADV_BEARER_NUM_ADVERTISING_SETS, MESH_ADV_BEARER_QUEUE_SIZE);
+    benchmark(false, 20);
+    benchmark(true, 20);
+    benchmark(true, 50);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
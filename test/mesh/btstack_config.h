@@ -43,6 +43,14 @@
 // allow for one NetKey update
 #define MAX_NR_MESH_NETWORK_KEYS      (MAX_NR_MESH_SUBNETS+1)
 
+// decrypt several incoming access messages in parallel
+#define MESH_UPPER_TRANSPORT_NUM_DECRYPT_CONTEXTS 4
+#ifndef MESH_ACCESS_OPCODE_TABLE_SIZE
+#define MESH_ACCESS_OPCODE_TABLE_SIZE 512
+#endif
+#define MESH_ADV_BEARER_NUM_ADVERTISING_SETS 4
+#define MESH_ADV_BEARER_QUEUE_SIZE 8
+
 #define NVM_NUM_LINK_KEYS 2
 
 #endif
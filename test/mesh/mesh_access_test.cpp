@@ -0,0 +1,351 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_util.h"
+#include "mesh/adv_bearer.h"
+#include "mesh/gatt_bearer.h"
+#include "mesh/mesh.h"
+#include "mesh/mesh_access.h"
+#include "mesh/mesh_foundation.h"
+#include "mesh/mesh_network.h"
+#include "mesh/mesh_node.h"
+#include "mesh/mesh_upper_transport.h"
+#include "mock.h"
+
+// synthetic composition: lighting fixture with many elements, each with SIG and vendor models
+#define NUM_ELEMENTS              32
+#define NUM_MODELS_PER_ELEMENT    3
+#define PRIMARY_ELEMENT_ADDRESS   0x0100
+#define GROUP_ADDRESS             0xC001
+#define VENDOR_COMPANY_ID         0x0059
+#define APPKEY_INDEX              0x0001
+#define NUM_BENCHMARK_MESSAGES    20000
+
+// bearers
+void adv_bearer_register_for_network_pdu(btstack_packet_handler_t packet_handler){
+    UNUSED(packet_handler);
+}
+void adv_bearer_request_can_send_now_for_network_pdu(void){
+}
+void adv_bearer_send_network_pdu(const uint8_t * network_pdu, uint16_t size, uint8_t count, uint16_t interval){
+    UNUSED(network_pdu);
+    UNUSED(size);
+    UNUSED(count);
+    UNUSED(interval);
+}
+void gatt_bearer_register_for_network_pdu(btstack_packet_handler_t packet_handler){
+    UNUSED(packet_handler);
+}
+void gatt_bearer_register_for_mesh_proxy_configuration(btstack_packet_handler_t packet_handler){
+    UNUSED(packet_handler);
+}
+void gatt_bearer_request_can_send_now_for_network_pdu(void){
+}
+void gatt_bearer_send_network_pdu(const uint8_t * network_pdu, uint16_t size){
+    UNUSED(network_pdu);
+    UNUSED(size);
+}
+
+// upper transport
+static void (*access_message_handler)(mesh_transport_callback_type_t callback_type, mesh_transport_status_t status, mesh_pdu_t * pdu);
+static uint32_t num_processed_pdus;
+
+void mesh_upper_transport_register_access_message_handler(void (*callback)(mesh_transport_callback_type_t callback_type, mesh_transport_status_t status, mesh_pdu_t * pdu)){
+    access_message_handler = callback;
+}
+void mesh_upper_transport_message_processed_by_higher_layer(mesh_pdu_t * pdu){
+    UNUSED(pdu);
+    num_processed_pdus++;
+}
+void mesh_upper_transport_send_access_pdu(mesh_pdu_t * pdu){
+    UNUSED(pdu);
+}
+void mesh_upper_transport_request_to_send(btstack_context_callback_registration_t * request){
+    UNUSED(request);
+}
+void mesh_upper_transport_pdu_free(mesh_pdu_t * pdu){
+    UNUSED(pdu);
+}
+uint8_t mesh_upper_transport_setup_access_pdu_header(mesh_pdu_t * pdu, uint16_t netkey_index, uint16_t appkey_index, uint8_t ttl, uint16_t src, uint16_t dest, uint8_t szmic){
+    UNUSED(pdu);
+    UNUSED(netkey_index);
+    UNUSED(appkey_index);
+    UNUSED(ttl);
+    UNUSED(src);
+    UNUSED(dest);
+    UNUSED(szmic);
+    return 0;
+}
+void mesh_upper_transport_message_init(mesh_upper_transport_builder_t * builder, mesh_pdu_type_t pdu_type){
+    UNUSED(builder);
+    UNUSED(pdu_type);
+}
+void mesh_upper_transport_message_add_data(mesh_upper_transport_builder_t * builder, const uint8_t * data, uint16_t data_len){
+    UNUSED(builder);
+    UNUSED(data);
+    UNUSED(data_len);
+}
+void mesh_upper_transport_message_add_uint8(mesh_upper_transport_builder_t * builder, uint8_t value){
+    UNUSED(builder);
+    UNUSED(value);
+}
+void mesh_upper_transport_message_add_uint16(mesh_upper_transport_builder_t * builder, uint16_t value){
+    UNUSED(builder);
+    UNUSED(value);
+}
+void mesh_upper_transport_message_add_uint24(mesh_upper_transport_builder_t * builder, uint32_t value){
+    UNUSED(builder);
+    UNUSED(value);
+}
+void mesh_upper_transport_message_add_uint32(mesh_upper_transport_builder_t * builder, uint32_t value){
+    UNUSED(builder);
+    UNUSED(value);
+}
+mesh_upper_transport_pdu_t * mesh_upper_transport_message_finalize(mesh_upper_transport_builder_t * builder){
+    UNUSED(builder);
+    return NULL;
+}
+
+// appkey bindings, usually provided by mesh.c
+int mesh_model_contains_appkey(mesh_model_t * mesh_model, uint16_t appkey_index){
+    uint16_t i;
+    for (i = 0; i < MAX_NR_MESH_APPKEYS_PER_MODEL; i++){
+        if (mesh_model->appkey_indices[i] == appkey_index) return 1;
+    }
+    return 0;
+}
+
+// models
+static mesh_element_t elements[NUM_ELEMENTS - 1];
+static mesh_model_t   models[NUM_ELEMENTS][NUM_MODELS_PER_ELEMENT];
+
+static mesh_model_t * received_model;
+static uint32_t       received_opcode;
+static uint32_t       num_received_messages;
+
+static void model_handler(mesh_model_t * mesh_model, mesh_pdu_t * pdu){
+    mesh_access_parser_state_t parser;
+    mesh_access_parser_init(&parser, pdu);
+    received_model  = mesh_model;
+    received_opcode = parser.opcode;
+    num_received_messages++;
+    mesh_access_message_processed(pdu);
+}
+
+// Generic OnOff Server
+static const mesh_operation_t onoff_server_operations[] = {
+    { 0x8201, 0, model_handler },
+    { 0x8202, 2, model_handler },
+    { 0x8203, 2, model_handler },
+    { 0, 0, NULL }
+};
+
+// Generic Level Server
+static const mesh_operation_t level_server_operations[] = {
+    { 0x8205, 0, model_handler },
+    { 0x8206, 3, model_handler },
+    { 0x8207, 3, model_handler },
+    { 0x8209, 5, model_handler },
+    { 0x820A, 5, model_handler },
+    { 0x820B, 3, model_handler },
+    { 0x820C, 3, model_handler },
+    { 0, 0, NULL }
+};
+
+// Vendor model
+static const mesh_operation_t vendor_operations[] = {
+    { 0xC10059, 0, model_handler },
+    { 0xC20059, 1, model_handler },
+    { 0xC30059, 1, model_handler },
+    { 0xC40059, 4, model_handler },
+    { 0, 0, NULL }
+};
+
+static mesh_access_pdu_t pdu;
+
+static void setup_composition(void){
+    static bool composition_ready = false;
+    if (composition_ready) return;
+    composition_ready = true;
+
+    mesh_node_init();
+    mesh_node_primary_element_address_set(PRIMARY_ELEMENT_ADDRESS);
+    uint16_t i;
+    for (i = 0; i < (NUM_ELEMENTS - 1); i++){
+        mesh_node_add_element(&elements[i]);
+    }
+    for (i = 0; i < NUM_ELEMENTS; i++){
+        mesh_element_t * element = mesh_node_element_for_index(i);
+        models[i][0].model_identifier = mesh_model_get_model_identifier_bluetooth_sig(0x1000);
+        models[i][0].operations = onoff_server_operations;
+        models[i][1].model_identifier = mesh_model_get_model_identifier_bluetooth_sig(0x1002);
+        models[i][1].operations = level_server_operations;
+        models[i][2].model_identifier = mesh_model_get_model_identifier(VENDOR_COMPANY_ID, 0x0001);
+        models[i][2].operations = vendor_operations;
+        uint16_t j;
+        for (j = 0; j < NUM_MODELS_PER_ELEMENT; j++){
+            mesh_element_add_model(element, &models[i][j]);
+            models[i][j].appkey_indices[0] = APPKEY_INDEX;
+        }
+    }
+}
+
+static void setup_pdu(uint16_t dst, const uint8_t * data, uint16_t len){
+    memset(&pdu, 0, sizeof(pdu));
+    pdu.pdu_header.pdu_type = MESH_PDU_TYPE_ACCESS;
+    pdu.src = 0x0001;
+    pdu.dst = dst;
+    pdu.appkey_index = APPKEY_INDEX;
+    pdu.len = len;
+    memcpy(pdu.data, data, len);
+}
+
+static void receive_pdu(uint16_t dst, const uint8_t * data, uint16_t len){
+    setup_pdu(dst, data, len);
+    (*access_message_handler)(MESH_TRANSPORT_PDU_RECEIVED, MESH_TRANSPORT_STATUS_SUCCESS, (mesh_pdu_t *) &pdu);
+}
+
+// same test binary is built with and without opcode table, compare benchmark output of both
+#ifdef ENABLE_MESH_ACCESS_OPCODE_TABLE
+#define DISPATCH_NAME "opcode table"
+#else
+#define DISPATCH_NAME "linear scan"
+#endif
+
+static double benchmark_us(uint16_t dst, const uint8_t * data, uint16_t len){
+    clock_t start = clock();
+    uint32_t n;
+    for (n = 0; n < NUM_BENCHMARK_MESSAGES; n++){
+        receive_pdu(dst, data, len);
+    }
+    return ((double) (clock() - start)) * 1000000.0 / CLOCKS_PER_SEC / NUM_BENCHMARK_MESSAGES;
+}
+
+TEST_GROUP(MeshAccessDispatch){
+    void setup(void){
+        mock_init();
+        mesh_access_init();
+        setup_composition();
+        uint16_t i;
+        for (i = 0; i < NUM_ELEMENTS; i++){
+            uint16_t j;
+            for (j = 0; j < NUM_MODELS_PER_ELEMENT; j++){
+                memset(models[i][j].subscriptions, 0, sizeof(models[i][j].subscriptions));
+            }
+        }
+        received_model = NULL;
+        received_opcode = 0;
+        num_received_messages = 0;
+        num_processed_pdus = 0;
+    }
+};
+
+TEST(MeshAccessDispatch, Unicast){
+    const uint8_t generic_level_get[] = { 0x82, 0x05 };
+    uint16_t i;
+    for (i = 0; i < NUM_ELEMENTS; i++){
+        receive_pdu(PRIMARY_ELEMENT_ADDRESS + i, generic_level_get, sizeof(generic_level_get));
+        CHECK_EQUAL(i + 1U, num_received_messages);
+        POINTERS_EQUAL(&models[i][1], received_model);
+        CHECK_EQUAL(0x8205, received_opcode);
+    }
+    CHECK_EQUAL(NUM_ELEMENTS, num_processed_pdus);
+}
+
+TEST(MeshAccessDispatch, UnicastVendor){
+    const uint8_t vendor_get[] = { 0xC1, 0x59, 0x00 };
+    receive_pdu(PRIMARY_ELEMENT_ADDRESS + 7, vendor_get, sizeof(vendor_get));
+    CHECK_EQUAL(1, num_received_messages);
+    POINTERS_EQUAL(&models[7][2], received_model);
+    CHECK_EQUAL(0xC10059, received_opcode);
+}
+
+TEST(MeshAccessDispatch, UnknownOpcode){
+    const uint8_t unknown[] = { 0x82, 0x04 };
+    receive_pdu(PRIMARY_ELEMENT_ADDRESS + 3, unknown, sizeof(unknown));
+    CHECK_EQUAL(0, num_received_messages);
+    CHECK_EQUAL(1, num_processed_pdus);
+}
+
+TEST(MeshAccessDispatch, MinimumLength){
+    const uint8_t generic_onoff_set_short[] = { 0x82, 0x02, 0x01 };
+    const uint8_t generic_onoff_set[] = { 0x82, 0x02, 0x01, 0x00 };
+    receive_pdu(PRIMARY_ELEMENT_ADDRESS + 1, generic_onoff_set_short, sizeof(generic_onoff_set_short));
+    CHECK_EQUAL(0, num_received_messages);
+    receive_pdu(PRIMARY_ELEMENT_ADDRESS + 1, generic_onoff_set, sizeof(generic_onoff_set));
+    CHECK_EQUAL(1, num_received_messages);
+    POINTERS_EQUAL(&models[1][0], received_model);
+}
+
+TEST(MeshAccessDispatch, AppKeyNotBound){
+    const uint8_t generic_onoff_get[] = { 0x82, 0x01 };
+    setup_pdu(PRIMARY_ELEMENT_ADDRESS + 2, generic_onoff_get, sizeof(generic_onoff_get));
+    pdu.appkey_index = APPKEY_INDEX + 1;
+    (*access_message_handler)(MESH_TRANSPORT_PDU_RECEIVED, MESH_TRANSPORT_STATUS_SUCCESS, (mesh_pdu_t *) &pdu);
+    CHECK_EQUAL(0, num_received_messages);
+    CHECK_EQUAL(1, num_processed_pdus);
+}
+
+TEST(MeshAccessDispatch, Group){
+    const uint8_t generic_onoff_get[] = { 0x82, 0x01 };
+    // subscribe OnOff Server on every fourth element, Level Server on all elements
+    uint16_t i;
+    for (i = 0; i < NUM_ELEMENTS; i++){
+        if ((i % 4) == 0){
+            models[i][0].subscriptions[0] = GROUP_ADDRESS;
+        }
+        models[i][1].subscriptions[0] = GROUP_ADDRESS;
+    }
+    receive_pdu(GROUP_ADDRESS, generic_onoff_get, sizeof(generic_onoff_get));
+    CHECK_EQUAL(NUM_ELEMENTS / 4, num_received_messages);
+    POINTERS_EQUAL(&models[NUM_ELEMENTS - 4][0], received_model);
+    CHECK_EQUAL(1, num_processed_pdus);
+
+    // unsubscribe
+    models[NUM_ELEMENTS - 4][0].subscriptions[0] = MESH_ADDRESS_UNSASSIGNED;
+    receive_pdu(GROUP_ADDRESS, generic_onoff_get, sizeof(generic_onoff_get));
+    CHECK_EQUAL((NUM_ELEMENTS / 4) + ((NUM_ELEMENTS / 4) - 1), num_received_messages);
+    POINTERS_EQUAL(&models[NUM_ELEMENTS - 8][0], received_model);
+}
+
+TEST(MeshAccessDispatch, AllNodes){
+    const uint8_t vendor_set[] = { 0xC2, 0x59, 0x00, 0x01 };
+    receive_pdu(MESH_ADDRESS_ALL_NODES, vendor_set, sizeof(vendor_set));
+    CHECK_EQUAL(1, num_received_messages);
+    POINTERS_EQUAL(&models[0][2], received_model);
+}
+
+TEST(MeshAccessDispatch, Benchmark){
+    const uint8_t vendor_set[] = { 0xC4, 0x59, 0x00, 0x01, 0x02, 0x03, 0x04 };
+    const uint8_t generic_level_delta_set[] = { 0x82, 0x09, 0x10, 0x00, 0x00, 0x00, 0x01 };
+    uint16_t unicast_address = PRIMARY_ELEMENT_ADDRESS + NUM_ELEMENTS - 1;
+
+    // all models subscribed to group address, e.g. all lights in a room
+    uint16_t i;
+    for (i = 0; i < NUM_ELEMENTS; i++){
+        uint16_t j;
+        for (j = 0; j < NUM_MODELS_PER_ELEMENT; j++){
+            models[i][j].subscriptions[MAX_NR_MESH_SUBSCRIPTION_PER_MODEL - 1] = GROUP_ADDRESS;
+        }
+    }
+
+    double unicast_us = benchmark_us(unicast_address, vendor_set, sizeof(vendor_set));
+    CHECK_EQUAL(NUM_BENCHMARK_MESSAGES, num_received_messages);
+    POINTERS_EQUAL(&models[NUM_ELEMENTS - 1][2], received_model);
+
+    num_received_messages = 0;
+    double group_us = benchmark_us(GROUP_ADDRESS, generic_level_delta_set, sizeof(generic_level_delta_set));
+    CHECK_EQUAL(NUM_BENCHMARK_MESSAGES * NUM_ELEMENTS, num_received_messages);
+
+    printf("Dispatch with %u elements x %u models, %s\n", NUM_ELEMENTS, NUM_MODELS_PER_ELEMENT, DISPATCH_NAME);
+    printf("- unicast: %6.3f us\n", unicast_us);
+    printf("- group:   %6.3f us\n", group_us);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -267,11 +267,16 @@ static void test_proxy_server_callback_handler(mesh_network_callback_type_t call
     }
 }
 
+static int sent_upper_transport_pdus_success;
+
 static void test_upper_transport_access_message_handler(mesh_transport_callback_type_t callback_type, mesh_transport_status_t status, mesh_pdu_t * pdu){
     UNUSED(status);
 
     // free sent pdus
     if (callback_type == MESH_TRANSPORT_PDU_SENT) {
+        if (status == MESH_TRANSPORT_STATUS_SUCCESS){
+            sent_upper_transport_pdus_success++;
+        }
         mesh_upper_transport_pdu_free(pdu);
         return;
     }
@@ -994,6 +999,47 @@ TEST(MessageTest, Message21Send){
     test_send_access_message(netkey_index, appkey_index, ttl, src, dest, szmic, message21_upper_transport_pdu, 1, message21_lower_transport_pdus, message21_network_pdus);
 }
 
+// AppKeys with same AID as test application key
+#define NUM_DECOY_APPLICATION_KEYS 8
+static mesh_transport_key_t decoy_application_keys[NUM_DECOY_APPLICATION_KEYS];
+
+static uint32_t test_receive_count_aes128_operations(char ** network_pdus, char ** lower_transport_pdus, char * access_pdu){
+    uint32_t num_operations = mock_get_num_aes128_operations();
+    recv_upper_transport_pdu_len = 0;
+    test_receive_network_pdus(1, network_pdus, lower_transport_pdus, access_pdu);
+    return mock_get_num_aes128_operations() - num_operations;
+}
+
+TEST(MessageTest, AppKeyCollisionCachedKey){
+    // decoy keys are tried before the valid key
+    mesh_transport_key_remove(&test_application_key);
+    int i;
+    for (i = 0; i < NUM_DECOY_APPLICATION_KEYS; i++){
+        mesh_transport_key_t * key = &decoy_application_keys[i];
+        memset(key, 0, sizeof(mesh_transport_key_t));
+        key->internal_index = 1 + i;
+        key->netkey_index = 0;
+        key->appkey_index = 1 + i;
+        key->aid = 0x26;
+        key->akf = 1;
+        memset(key->key, 0x10 + i, 16);
+        mesh_transport_key_add(key);
+    }
+    mesh_transport_key_add(&test_application_key);
+
+    load_network_key_nid_68();
+    mesh_set_iv_index(0x12345677);
+    uint32_t first_message  = test_receive_count_aes128_operations(message20_network_pdus, message20_lower_transport_pdus, message20_upper_transport_pdu);
+    uint32_t cached_message = test_receive_count_aes128_operations(message21_network_pdus, message21_lower_transport_pdus, message21_upper_transport_pdu);
+    printf("AES128 operations with %u colliding AppKeys: first message %u, with cached AppKey %u\n",
+           NUM_DECOY_APPLICATION_KEYS, (unsigned int) first_message, (unsigned int) cached_message);
+    CHECK_TRUE(cached_message < first_message);
+
+    for (i = 0; i < NUM_DECOY_APPLICATION_KEYS; i++){
+        mesh_transport_key_remove(&decoy_application_keys[i]);
+    }
+}
+
 // Message 22
 char * message22_network_pdus[] = {
     (char *) "e8d85caecef1e3ed31f3fdcf88a411135fea55df730b6b28e255",
@@ -1113,6 +1159,107 @@ char * proxy_config_lower_transport_pdus[] = {
     (char *) "0000",
 };
 char * proxy_config_upper_transport_pdu = (char *) "ea0a00576f726c64";
+// Segmented messages to several unicast destinations in parallel
+static void test_send_segmented_access_message(uint16_t dest, uint16_t payload_len){
+    uint8_t payload[32];
+    memset(payload, 0x55, sizeof(payload));
+    mesh_upper_transport_builder_t builder;
+    mesh_upper_transport_message_init(&builder, MESH_PDU_TYPE_UPPER_SEGMENTED_ACCESS);
+    mesh_upper_transport_message_add_data(&builder, payload, payload_len);
+    mesh_pdu_t * pdu = (mesh_pdu_t *) mesh_upper_transport_message_finalize(&builder);
+    mesh_upper_transport_setup_access_pdu_header(pdu, 0, 0, 4, 0x0003, dest, 0);
+    mesh_upper_transport_send_access_pdu(pdu);
+}
+
+// @return number of network pdus sent
+static int test_send_pending_network_pdus(void){
+    int num_network_pdus = 0;
+    int i;
+    for (i = 0; i < 1000; i++){
+        mock_process_hci_cmd();
+        if (outgoing_gatt_network_pdu_len != 0){
+            outgoing_gatt_network_pdu_len = 0;
+            gatt_bearer_emit_sent();
+        }
+        if (outgoing_adv_network_pdu_len != 0){
+            outgoing_adv_network_pdu_len = 0;
+            num_network_pdus++;
+            adv_bearer_emit_sent();
+        }
+    }
+    return num_network_pdus;
+}
+
+static void test_receive_segment_acknowledgment(uint16_t src, uint32_t seq, uint32_t seq_zero, uint32_t block_ack){
+    uint8_t lower_transport_pdu[7];
+    lower_transport_pdu[0] = 0;
+    big_endian_store_16(lower_transport_pdu, 1, (seq_zero & 0x1fff) << 2);
+    big_endian_store_32(lower_transport_pdu, 3, block_ack);
+    mesh_network_pdu_t * network_pdu = mesh_network_pdu_get();
+    mesh_network_setup_pdu(network_pdu, 0, 0x68, 1, 0, seq, src, 0x0003, lower_transport_pdu, sizeof(lower_transport_pdu));
+    mesh_lower_transport_received_message(MESH_NETWORK_PDU_RECEIVED, network_pdu);
+}
+
+#define NUM_PARALLEL_DESTINATIONS 4
+
+TEST(MessageTest, SegmentedParallelDestinations){
+    load_network_key_nid_68();
+    mesh_set_iv_index(0x12345678);
+    mesh_sequence_number_set(0x100);
+    sent_upper_transport_pdus_success = 0;
+
+    // 2 segments per message, all messages wait for acknowledgement at the same time
+    int i;
+    for (i = 0; i < NUM_PARALLEL_DESTINATIONS; i++){
+        test_send_segmented_access_message(0x1201 + i, 20);
+        CHECK_EQUAL(2, test_send_pending_network_pdus());
+    }
+
+    // acknowledgements in reverse order
+    for (i = NUM_PARALLEL_DESTINATIONS - 1; i >= 0; i--){
+        test_receive_segment_acknowledgment(0x1201 + i, 1, 0x100 + (2 * i), 0x03);
+    }
+    CHECK_EQUAL(0, test_send_pending_network_pdus());
+    CHECK_EQUAL(NUM_PARALLEL_DESTINATIONS, sent_upper_transport_pdus_success);
+
+    for (i = 0; i < NUM_PARALLEL_DESTINATIONS; i++){
+        const mesh_lower_transport_destination_stats_t * stats = mesh_lower_transport_get_destination_stats(0x1201 + i);
+        CHECK_TRUE(stats != NULL);
+        CHECK_EQUAL(1, stats->messages_sent);
+        CHECK_EQUAL(0, stats->messages_failed);
+        CHECK_EQUAL(2, stats->segments_sent);
+        CHECK_EQUAL(0, stats->segments_retransmitted);
+        CHECK_EQUAL(1, stats->acks_received);
+    }
+    POINTERS_EQUAL(NULL, mesh_lower_transport_get_destination_stats(0x1301));
+}
+
+TEST(MessageTest, SegmentedPartialAckRetransmit){
+    load_network_key_nid_68();
+    mesh_set_iv_index(0x12345678);
+    mesh_sequence_number_set(0x200);
+    sent_upper_transport_pdus_success = 0;
+
+    // 3 segments
+    test_send_segmented_access_message(0x1201, 30);
+    CHECK_EQUAL(3, test_send_pending_network_pdus());
+
+    // second segment missing: retransmitted without waiting for segment transmission timer
+    test_receive_segment_acknowledgment(0x1201, 1, 0x200, 0x05);
+    CHECK_EQUAL(1, test_send_pending_network_pdus());
+    test_receive_segment_acknowledgment(0x1201, 2, 0x200, 0x07);
+    CHECK_EQUAL(0, test_send_pending_network_pdus());
+    CHECK_EQUAL(1, sent_upper_transport_pdus_success);
+
+    const mesh_lower_transport_destination_stats_t * stats = mesh_lower_transport_get_destination_stats(0x1201);
+    CHECK_TRUE(stats != NULL);
+    CHECK_EQUAL(1, stats->messages_sent);
+    CHECK_EQUAL(4, stats->segments_sent);
+    CHECK_EQUAL(1, stats->segments_retransmitted);
+    CHECK_EQUAL(2, stats->acks_received);
+    CHECK_TRUE(stats->ack_latency_ms > 0);
+}
+
 TEST(MessageTest, ProxyConfigReceive){
     mesh_set_iv_index(0x12345678);
     load_network_key_nid_10();
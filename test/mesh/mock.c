@@ -19,6 +19,7 @@ static uint16_t packet_buffer_len = 0;
 static uint8_t aes128_cyphertext[16];
 
 static int report_aes128;
+static uint32_t aes128_operations;
 static int report_random;
 
 static uint32_t lfsr_random;
@@ -140,6 +141,7 @@ uint8_t hci_send_cmd(const hci_cmd_t *cmd, ...){
  		reverse_128(plaintext_flipped, plaintext);
 	    aes128_calc_cyphertext(key, plaintext, aes128_cyphertext);
 	    report_aes128 = 1;
+	    aes128_operations++;
 #ifdef ENABLE_AES128_LOGGER
 	    printf("AES128 Operation\n");
 	    printf("Key:    "); printf_hexdump(key, 16);
@@ -153,6 +155,10 @@ uint8_t hci_send_cmd(const hci_cmd_t *cmd, ...){
 	return 0;
 }
 
+uint32_t mock_get_num_aes128_operations(void){
+    return aes128_operations;
+}
+
 void hci_add_event_handler(btstack_packet_callback_registration_t * callback_handler){
     btstack_linked_list_add_tail(&event_packet_handlers, (btstack_linked_item_t*) callback_handler);
 }
@@ -185,6 +191,12 @@ void * btstack_run_loop_get_timer_context(btstack_timer_source_t * ts){
     UNUSED(ts);
 	return timer_context;
 }
+static uint32_t time_ms;
+uint32_t btstack_run_loop_get_time_ms(void){
+    // advance simulated time with each request
+    time_ms += 10;
+    return time_ms;
+}
 void hci_halting_defer(void){
 }
 
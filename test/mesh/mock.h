@@ -51,6 +51,7 @@ void mock_clear_packet_buffer(void);
 void mock_simulate_hci_event(uint8_t * packet, uint16_t size);
 int mock_process_hci_cmd(void);
 void mock_simulate_hci_state_working(void);
+uint32_t mock_get_num_aes128_operations(void);
 
 #ifdef __cplusplus
 } /* end of extern "C" */
@@ -0,0 +1,208 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_defines.h"
+#include "btstack_event.h"
+#include "btstack_util.h"
+#include "classic/obex.h"
+#include "classic/goep_client.h"
+#include "classic/pbap_client.h"
+
+#define GOEP_CID 0x0042
+
+static btstack_packet_handler_t goep_packet_handler;
+static uint32_t time_ms;
+static uint16_t num_requests;
+static uint32_t data_bytes;
+static uint16_t num_data_packets;
+static uint8_t  connected_status;
+static bool     operation_complete;
+
+// mock hci_dump.c
+extern "C" void hci_dump_log(int log_level, const char * format, ...){}
+
+// mock btstack_run_loop.c
+extern "C" uint32_t btstack_run_loop_get_time_ms(void){
+    return time_ms;
+}
+
+// mock goep_client.c
+extern "C" uint8_t goep_client_create_connection(btstack_packet_handler_t handler, bd_addr_t addr, uint16_t uuid, uint16_t * out_cid){
+    goep_packet_handler = handler;
+    *out_cid = GOEP_CID;
+    return ERROR_CODE_SUCCESS;
+}
+extern "C" uint8_t goep_client_disconnect(uint16_t goep_cid){
+    return ERROR_CODE_SUCCESS;
+}
+extern "C" int goep_client_execute(uint16_t goep_cid){
+    num_requests++;
+    return 0;
+}
+extern "C" uint32_t goep_client_get_pbap_supported_features(uint16_t goep_cid){
+    return PBAP_FEATURES_NOT_PRESENT;
+}
+extern "C" bool goep_client_version_20_or_higher(uint16_t goep_cid){
+    return false;
+}
+extern "C" void goep_client_header_add_application_parameters(uint16_t goep_cid, const uint8_t * data, uint16_t length){}
+extern "C" void goep_client_header_add_challenge_response(uint16_t goep_cid, const uint8_t * data, uint16_t length){}
+extern "C" void goep_client_header_add_name(uint16_t goep_cid, const char * name){}
+extern "C" void goep_client_header_add_name_prefix(uint16_t goep_cid, const char * name, uint16_t name_len){}
+extern "C" void goep_client_header_add_srm_enable(uint16_t goep_cid){}
+extern "C" void goep_client_header_add_target(uint16_t goep_cid, const uint8_t * target, uint16_t length){}
+extern "C" void goep_client_header_add_type(uint16_t goep_cid, const char * type){}
+extern "C" void goep_client_request_can_send_now(uint16_t goep_cid){}
+extern "C" void goep_client_request_create_abort(uint16_t goep_cid){}
+extern "C" void goep_client_request_create_connect(uint16_t goep_cid, uint8_t obex_version_number, uint8_t flags, uint16_t maximum_obex_packet_length){}
+extern "C" void goep_client_request_create_disconnect(uint16_t goep_cid){}
+extern "C" void goep_client_request_create_get(uint16_t goep_cid){}
+extern "C" void goep_client_request_create_set_path(uint16_t goep_cid, uint8_t flags){}
+extern "C" void goep_client_set_connection_id(uint16_t goep_cid, uint32_t connection_id){}
+
+static void pbap_client_packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    switch (packet_type){
+        case PBAP_DATA_PACKET:
+            data_bytes += size;
+            num_data_packets++;
+            break;
+        case HCI_EVENT_PACKET:
+            if (hci_event_packet_get_type(packet) != HCI_EVENT_PBAP_META) break;
+            switch (hci_event_pbap_meta_get_subevent_code(packet)){
+                case PBAP_SUBEVENT_CONNECTION_OPENED:
+                    connected_status = pbap_subevent_connection_opened_get_status(packet);
+                    break;
+                case PBAP_SUBEVENT_OPERATION_COMPLETED:
+                    operation_complete = true;
+                    break;
+                default:
+                    break;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void goep_emit_subevent(uint8_t subevent_code){
+    uint8_t event[] = { HCI_EVENT_GOEP_META, 3, subevent_code, 0, 0};
+    little_endian_store_16(event, 3, GOEP_CID);
+    goep_packet_handler(HCI_EVENT_PACKET, 0, event, sizeof(event));
+}
+
+static void goep_emit_connection_opened(void){
+    uint8_t event[] = { HCI_EVENT_GOEP_META, 13, GOEP_SUBEVENT_CONNECTION_OPENED, 0, 0, ERROR_CODE_SUCCESS, 1, 2, 3, 4, 5, 6, 0x01, 0x00, 0};
+    little_endian_store_16(event, 3, GOEP_CID);
+    goep_packet_handler(HCI_EVENT_PACKET, 0, event, sizeof(event));
+}
+
+static void goep_receive(const uint8_t * response, uint16_t len){
+    uint8_t buffer[100];
+    memcpy(buffer, response, len);
+    goep_packet_handler(GOEP_DATA_PACKET, GOEP_CID, buffer, len);
+}
+
+// response code, body header with body_len bytes
+static void goep_receive_body(uint8_t response_code, uint8_t header_id, uint16_t body_len){
+    uint8_t buffer[100];
+    uint16_t len = 3 + 3 + body_len;
+    buffer[0] = response_code;
+    big_endian_store_16(buffer, 1, len);
+    buffer[3] = header_id;
+    big_endian_store_16(buffer, 4, 3 + body_len);
+    memset(&buffer[6], 'V', body_len);
+    goep_packet_handler(GOEP_DATA_PACKET, GOEP_CID, buffer, len);
+}
+
+TEST_GROUP(PBAP_CLIENT){
+    uint16_t pbap_cid;
+    bd_addr_t addr;
+
+    void setup(void){
+        time_ms = 1000;
+        num_requests = 0;
+        data_bytes = 0;
+        num_data_packets = 0;
+        connected_status = 0xff;
+        operation_complete = false;
+        memset(addr, 0, sizeof(addr));
+        pbap_client_init();
+    }
+    void teardown(void){
+        pbap_client_deinit();
+    }
+    void connect(void){
+        CHECK_EQUAL(ERROR_CODE_SUCCESS, pbap_connect(&pbap_client_packet_handler, addr, &pbap_cid));
+        goep_emit_connection_opened();
+        goep_emit_subevent(GOEP_SUBEVENT_CAN_SEND_NOW);
+        // connect response: version, flags, maximum packet length
+        const uint8_t connect_response[] = { OBEX_RESP_SUCCESS, 0x00, 0x07, OBEX_VERSION, 0x00, 0x04, 0x00 };
+        goep_receive(connect_response, sizeof(connect_response));
+        CHECK_EQUAL(ERROR_CODE_SUCCESS, connected_status);
+    }
+};
+
+TEST(PBAP_CLIENT, StatisticsNotConnected){
+    uint32_t bytes_received;
+    uint32_t bytes_per_second;
+    CHECK_EQUAL(ERROR_CODE_COMMAND_DISALLOWED, pbap_get_transfer_statistics(pbap_cid, &bytes_received, &bytes_per_second));
+}
+
+TEST(PBAP_CLIENT, StatisticsPullPhonebook){
+    uint32_t bytes_received = 0xffff;
+    uint32_t bytes_per_second = 0xffff;
+    connect();
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, pbap_get_transfer_statistics(pbap_cid, &bytes_received, &bytes_per_second));
+    CHECK_EQUAL(0, bytes_received);
+    CHECK_EQUAL(0, bytes_per_second);
+
+    // pull phonebook in three chunks over 500 ms
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, pbap_pull_phonebook(pbap_cid, "telecom/pb.vcf"));
+    goep_emit_subevent(GOEP_SUBEVENT_CAN_SEND_NOW);
+    time_ms += 100;
+    goep_receive_body(OBEX_RESP_CONTINUE, OBEX_HEADER_BODY, 40);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, pbap_get_transfer_statistics(pbap_cid, &bytes_received, &bytes_per_second));
+    CHECK_EQUAL(40, bytes_received);
+    CHECK_EQUAL(400, bytes_per_second);
+
+    goep_emit_subevent(GOEP_SUBEVENT_CAN_SEND_NOW);
+    time_ms += 200;
+    goep_receive_body(OBEX_RESP_CONTINUE, OBEX_HEADER_BODY, 50);
+    goep_emit_subevent(GOEP_SUBEVENT_CAN_SEND_NOW);
+    time_ms += 200;
+    goep_receive_body(OBEX_RESP_SUCCESS, OBEX_HEADER_END_OF_BODY, 60);
+    CHECK(operation_complete);
+    CHECK_EQUAL(4, num_requests);
+    CHECK_EQUAL(3, num_data_packets);
+    CHECK_EQUAL(150, data_bytes);
+
+    // statistics stay available after the operation completed
+    time_ms += 1000;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, pbap_get_transfer_statistics(pbap_cid, &bytes_received, &bytes_per_second));
+    CHECK_EQUAL(150, bytes_received);
+    CHECK_EQUAL(300, bytes_per_second);
+}
+
+TEST(PBAP_CLIENT, StatisticsResetOnNextPull){
+    uint32_t bytes_received;
+    uint32_t bytes_per_second;
+    connect();
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, pbap_pull_phonebook(pbap_cid, "telecom/pb.vcf"));
+    goep_emit_subevent(GOEP_SUBEVENT_CAN_SEND_NOW);
+    time_ms += 100;
+    goep_receive_body(OBEX_RESP_SUCCESS, OBEX_HEADER_END_OF_BODY, 80);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, pbap_get_transfer_statistics(pbap_cid, &bytes_received, &bytes_per_second));
+    CHECK_EQUAL(80, bytes_received);
+
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, pbap_pull_phonebook(pbap_cid, "telecom/ich.vcf"));
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, pbap_get_transfer_statistics(pbap_cid, &bytes_received, &bytes_per_second));
+    CHECK_EQUAL(0, bytes_received);
+    CHECK_EQUAL(0, bytes_per_second);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -0,0 +1,89 @@
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_parallel_posix.h"
+#include "btstack_util.h"
+#include "btstack_config.h"
+#include "btstack_debug.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#define NUM_ITEMS 64
+
+typedef struct {
+    uint8_t counts[NUM_ITEMS];
+} job_t;
+
+static void job_work(void * context, uint16_t first_item, uint16_t num_items){
+    job_t * job = (job_t *) context;
+    uint16_t i;
+    for (i = first_item; i < first_item + num_items; i++){
+        job->counts[i]++;
+    }
+}
+
+static void check_counts(const job_t * job, uint8_t expected){
+    uint16_t i;
+    for (i = 0; i < NUM_ITEMS; i++){
+        CHECK_EQUAL(expected, job->counts[i]);
+    }
+}
+
+TEST_GROUP(PARALLEL_POSIX){
+    void teardown(void){
+        btstack_parallel_posix_deinit();
+    }
+};
+
+TEST(PARALLEL_POSIX, NoWorkers){
+    job_t job;
+    memset(&job, 0, sizeof(job));
+    btstack_parallel_posix_for(NUM_ITEMS, &job_work, &job);
+    check_counts(&job, 1);
+}
+
+TEST(PARALLEL_POSIX, AllItemsOnce){
+    CHECK_EQUAL(0, btstack_parallel_posix_init(3));
+    job_t job;
+    memset(&job, 0, sizeof(job));
+    btstack_parallel_posix_for(NUM_ITEMS, &job_work, &job);
+    check_counts(&job, 1);
+    btstack_parallel_posix_for(NUM_ITEMS, &job_work, &job);
+    check_counts(&job, 2);
+}
+
+TEST(PARALLEL_POSIX, FewerItemsThanWorkers){
+    CHECK_EQUAL(0, btstack_parallel_posix_init(7));
+    job_t job;
+    memset(&job, 0, sizeof(job));
+    btstack_parallel_posix_for(3, &job_work, &job);
+    CHECK_EQUAL(1, job.counts[0]);
+    CHECK_EQUAL(1, job.counts[1]);
+    CHECK_EQUAL(1, job.counts[2]);
+    CHECK_EQUAL(0, job.counts[3]);
+}
+
+TEST(PARALLEL_POSIX, Reinit){
+    job_t first_job;
+    memset(&first_job, 0, sizeof(first_job));
+    CHECK_EQUAL(0, btstack_parallel_posix_init(3));
+    btstack_parallel_posix_for(NUM_ITEMS, &job_work, &first_job);
+    btstack_parallel_posix_deinit();
+
+    // new workers must not pick up the job of the previous instance
+    CHECK_EQUAL(0, btstack_parallel_posix_init(3));
+    usleep(10000);
+    check_counts(&first_job, 1);
+
+    job_t second_job;
+    memset(&second_job, 0, sizeof(second_job));
+    btstack_parallel_posix_for(NUM_ITEMS, &job_work, &second_job);
+    check_counts(&second_job, 1);
+    check_counts(&first_job, 1);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at 
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "run_loop_posix_benchmark.c"
+
+/*
+ *  run_loop_posix_benchmark.c
+ *
+ *  Contention benchmark for btstack_run_loop_execute_on_main_thread:
+ *  several producer threads submit callbacks as fast as possible into the POSIX run loop
+ */
+
+// enable POSIX functions (needed for -std=c99)
+#define _POSIX_C_SOURCE 200809
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "btstack_run_loop.h"
+#include "btstack_run_loop_posix.h"
+#include "btstack_util.h"
+
+#define MAX_PRODUCERS                   16
+#define REGISTRATIONS_PER_PRODUCER      32
+#define DEFAULT_CALLBACKS_PER_PRODUCER  200000
+
+typedef struct {
+    pthread_t thread;
+    uint32_t  num_callbacks;
+    btstack_context_callback_registration_t registrations[REGISTRATIONS_PER_PRODUCER];
+    volatile uint8_t pending[REGISTRATIONS_PER_PRODUCER];
+} producer_t;
+
+static producer_t producers[MAX_PRODUCERS];
+static uint32_t   num_producers;
+static uint32_t   callbacks_expected;
+static uint32_t   callbacks_executed;
+static btstack_linked_item_t stale_item;
+
+static double get_time_s(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + ((double) now.tv_nsec / 1000000000.0);
+}
+
+// runs on main thread
+static void callback_handler(void * context){
+    volatile uint8_t * pending = (volatile uint8_t *) context;
+    __atomic_store_n(pending, 0, __ATOMIC_RELEASE);
+    callbacks_executed++;
+    if (callbacks_executed == callbacks_expected){
+        btstack_run_loop_trigger_exit();
+    }
+}
+
+static void * producer_thread(void * context){
+    producer_t * producer = (producer_t *) context;
+    uint32_t i;
+    for (i = 0; i < producer->num_callbacks; i++){
+        uint32_t index = i % REGISTRATIONS_PER_PRODUCER;
+        // wait until registration has been executed
+        while (__atomic_load_n(&producer->pending[index], __ATOMIC_ACQUIRE) != 0){
+            sched_yield();
+        }
+        producer->pending[index] = 1;
+        btstack_run_loop_execute_on_main_thread(&producer->registrations[index]);
+    }
+    return NULL;
+}
+
+int main(int argc, const char * argv[]){
+    num_producers = 4;
+    uint32_t callbacks_per_producer = DEFAULT_CALLBACKS_PER_PRODUCER;
+    if (argc > 1){
+        num_producers = btstack_min(MAX_PRODUCERS, (uint32_t) atoi(argv[1]));
+    }
+    if (argc > 2){
+        callbacks_per_producer = (uint32_t) atoi(argv[2]);
+    }
+
+    btstack_run_loop_init(btstack_run_loop_posix_get_instance());
+
+    callbacks_expected = num_producers * callbacks_per_producer;
+    if (callbacks_expected == 0){
+        printf("No callbacks to execute, usage: %s [num producers] [callbacks per producer]\n", argv[0]);
+        return 0;
+    }
+    uint32_t i;
+    for (i = 0; i < num_producers; i++){
+        producer_t * producer = &producers[i];
+        memset(producer, 0, sizeof(producer_t));
+        producer->num_callbacks = callbacks_per_producer;
+        uint32_t j;
+        for (j = 0; j < REGISTRATIONS_PER_PRODUCER; j++){
+            producer->registrations[j].callback = &callback_handler;
+            producer->registrations[j].context  = (void *) &producer->pending[j];
+            // item left over from previous use must not prevent execution
+            producer->registrations[j].item = &stale_item;
+        }
+    }
+
+    double start_s = get_time_s();
+    for (i = 0; i < num_producers; i++){
+        pthread_create(&producers[i].thread, NULL, &producer_thread, &producers[i]);
+    }
+    btstack_run_loop_execute();
+    double duration_s = get_time_s() - start_s;
+
+    for (i = 0; i < num_producers; i++){
+        pthread_join(producers[i].thread, NULL);
+    }
+
+    printf("%u producers, %u callbacks in %.3f s -> %.0f callbacks/s\n",
+           num_producers, callbacks_executed, duration_s, (double) callbacks_executed / duration_s);
+    return 0;
+}
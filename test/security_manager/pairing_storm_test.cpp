@@ -0,0 +1,174 @@
+// *****************************************************************************
+//
+// Pairing storm: DHKey calculation for many LE Secure Connections pairings with
+// software ECC on the main thread vs. ECC worker threads
+//
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_crypto.h"
+#include "btstack_crypto_ecc_worker_posix.h"
+#include "btstack_run_loop.h"
+#include "btstack_run_loop_posix.h"
+#include "btstack_util.h"
+#include "uECC.h"
+
+#define NUM_CONNECTIONS   16
+#define RADIO_INTERVAL_MS 1
+
+static const uint8_t scenario_num_workers[] = { 0, 1, 2, 4 };
+#define NUM_SCENARIOS (sizeof(scenario_num_workers) / sizeof(uint8_t))
+
+typedef struct {
+    uint32_t duration_ms;
+    uint32_t max_radio_delay_ms;
+    uint16_t num_dhkeys_valid;
+} scenario_result_t;
+
+static uint8_t local_public_key[64];
+static uint8_t local_private_key[32];
+static uint8_t peer_public_keys[NUM_CONNECTIONS][64];
+static uint8_t expected_dhkeys[NUM_CONNECTIONS][32];
+
+static btstack_crypto_ecc_p256_t requests[NUM_CONNECTIONS];
+static uint8_t dhkeys[NUM_CONNECTIONS][32];
+
+static scenario_result_t scenario_results[NUM_SCENARIOS];
+static uint8_t  scenario_index;
+static uint32_t scenario_start_ms;
+static uint16_t scenario_num_dhkeys;
+
+// periodic timer, its delay shows how long the run loop was blocked
+static btstack_timer_source_t radio_timer;
+static uint32_t radio_deadline_ms;
+
+static btstack_timer_source_t scenario_timer;
+
+static int test_rng(uint8_t * buffer, unsigned size){
+    while (size > 0){
+        *buffer++ = (uint8_t) rand();
+        size--;
+    }
+    return 1;
+}
+
+// as in btstack_crypto after key generation
+static int no_rng(uint8_t * buffer, unsigned size){
+    UNUSED(buffer);
+    UNUSED(size);
+    return 0;
+}
+
+static void radio_timer_start(void){
+    radio_deadline_ms = btstack_run_loop_get_time_ms() + RADIO_INTERVAL_MS;
+    btstack_run_loop_set_timer(&radio_timer, RADIO_INTERVAL_MS);
+    btstack_run_loop_add_timer(&radio_timer);
+}
+
+static void radio_timer_check_delay(void){
+    uint32_t now = btstack_run_loop_get_time_ms();
+    if (now > radio_deadline_ms){
+        scenario_result_t * result = &scenario_results[scenario_index];
+        result->max_radio_delay_ms = btstack_max(result->max_radio_delay_ms, now - radio_deadline_ms);
+    }
+}
+
+static void radio_timer_handler(btstack_timer_source_t * ts){
+    UNUSED(ts);
+    radio_timer_check_delay();
+    radio_timer_start();
+}
+
+static void scenario_start(btstack_timer_source_t * ts);
+
+static void dhkey_calculated(void * arg){
+    uint16_t connection = (uint16_t) (uintptr_t) arg;
+    scenario_result_t * result = &scenario_results[scenario_index];
+    if (memcmp(dhkeys[connection], expected_dhkeys[connection], 32) == 0){
+        result->num_dhkeys_valid++;
+    }
+    scenario_num_dhkeys++;
+    if (scenario_num_dhkeys < NUM_CONNECTIONS) return;
+
+    // storm over
+    result->duration_ms = btstack_run_loop_get_time_ms() - scenario_start_ms;
+    radio_timer_check_delay();
+    btstack_run_loop_remove_timer(&radio_timer);
+    btstack_crypto_ecc_worker_posix_deinit();
+    scenario_index++;
+    if (scenario_index == NUM_SCENARIOS){
+        btstack_run_loop_trigger_exit();
+        return;
+    }
+    btstack_run_loop_set_timer_handler(&scenario_timer, &scenario_start);
+    btstack_run_loop_set_timer(&scenario_timer, 10);
+    btstack_run_loop_add_timer(&scenario_timer);
+}
+
+static void scenario_start(btstack_timer_source_t * ts){
+    UNUSED(ts);
+    uint8_t num_workers = scenario_num_workers[scenario_index];
+    if (num_workers > 0){
+        btstack_crypto_ecc_worker_posix_init(num_workers);
+    }
+    memset(dhkeys, 0, sizeof(dhkeys));
+    scenario_num_dhkeys = 0;
+    radio_timer_start();
+
+    // all peers send their public key at the same time
+    scenario_start_ms = btstack_run_loop_get_time_ms();
+    uint16_t i;
+    for (i = 0; i < NUM_CONNECTIONS; i++){
+        btstack_crypto_ecc_p256_calculate_dhkey(&requests[i], peer_public_keys[i], dhkeys[i], &dhkey_calculated, (void *) (uintptr_t) i);
+    }
+}
+
+TEST_GROUP(PairingStorm){
+    void setup(void){
+        btstack_run_loop_init(btstack_run_loop_posix_get_instance());
+        btstack_crypto_init();
+
+        // local key pair and peers with expected DHKeys
+        uECC_set_rng(&test_rng);
+        CHECK_EQUAL(1, uECC_make_key(local_public_key, local_private_key));
+        btstack_crypto_ecc_p256_set_key(local_public_key, local_private_key);
+        uint16_t i;
+        for (i = 0; i < NUM_CONNECTIONS; i++){
+            uint8_t peer_private_key[32];
+            CHECK_EQUAL(1, uECC_make_key(peer_public_keys[i], peer_private_key));
+            CHECK_EQUAL(1, uECC_shared_secret(local_public_key, peer_private_key, expected_dhkeys[i]));
+        }
+        uECC_set_rng(&no_rng);
+        radio_timer.process = &radio_timer_handler;
+    }
+};
+
+TEST(PairingStorm, DHKeyOnMainThreadVsWorkers){
+    scenario_index = 0;
+    memset(scenario_results, 0, sizeof(scenario_results));
+    btstack_run_loop_set_timer_handler(&scenario_timer, &scenario_start);
+    btstack_run_loop_set_timer(&scenario_timer, 10);
+    btstack_run_loop_add_timer(&scenario_timer);
+    btstack_run_loop_execute();
+
+    CHECK_EQUAL(NUM_SCENARIOS, scenario_index);
+    uint8_t i;
+    for (i = 0; i < NUM_SCENARIOS; i++){
+        const scenario_result_t * result = &scenario_results[i];
+        printf("%u DHKeys, %u workers: %4u ms total, run loop blocked up to %4u ms\n", NUM_CONNECTIONS,
+               scenario_num_workers[i], (unsigned int) result->duration_ms, (unsigned int) result->max_radio_delay_ms);
+        CHECK_EQUAL(NUM_CONNECTIONS, result->num_dhkeys_valid);
+    }
+    CHECK_TRUE(btstack_crypto_idle() != 0);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
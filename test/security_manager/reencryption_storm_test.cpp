@@ -0,0 +1,454 @@
+// *****************************************************************************
+//
+// Re-encryption storm: many bonded devices reconnect at the same time and
+// request encryption. Measures time from LTK Request to Encryption Change
+// with a simulated Controller and run loop.
+//
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "ble/le_device_db.h"
+#include "ble/sm.h"
+#include "btstack_crypto.h"
+#include "btstack_event.h"
+#include "btstack_run_loop.h"
+#include "btstack_util.h"
+#include "hci.h"
+#include "hci_cmd.h"
+#include "hci_dump.h"
+#include "l2cap.h"
+
+#define NUM_CONNECTIONS         50
+#define HCI_COMMAND_LATENCY_MS  1
+// LL_ENC_REQ / LL_ENC_RSP / LL_START_ENC_REQ / LL_START_ENC_RSP over two connection events
+#define ENCRYPTION_SETUP_MS     60
+#define CON_HANDLE_BASE         0x0040
+
+// simulated run loop
+static uint32_t sim_time_ms;
+
+static void sim_run_loop_init(void){
+    btstack_run_loop_base_init();
+}
+static void sim_run_loop_set_timer(btstack_timer_source_t * ts, uint32_t timeout_in_ms){
+    ts->timeout = sim_time_ms + timeout_in_ms;
+}
+static uint32_t sim_run_loop_get_time_ms(void){
+    return sim_time_ms;
+}
+static void sim_run_loop_execute_on_main_thread(btstack_context_callback_registration_t * callback_registration){
+    btstack_run_loop_base_add_callback(callback_registration);
+}
+
+static const btstack_run_loop_t sim_run_loop = {
+    &sim_run_loop_init,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    &sim_run_loop_set_timer,
+    &btstack_run_loop_base_add_timer,
+    &btstack_run_loop_base_remove_timer,
+    NULL,
+    NULL,
+    &sim_run_loop_get_time_ms,
+    NULL,
+    &sim_run_loop_execute_on_main_thread,
+    NULL,
+};
+
+// process callbacks and timers, advance time to next timer
+static bool sim_step(void){
+    btstack_run_loop_base_execute_callbacks();
+    int32_t timeout = btstack_run_loop_base_get_time_until_timeout(sim_time_ms);
+    if (timeout < 0) return false;
+    sim_time_ms += (uint32_t) timeout;
+    btstack_run_loop_base_process_timers(sim_time_ms);
+    return true;
+}
+
+// HCI connections
+static hci_connection_t      hci_connections[NUM_CONNECTIONS];
+static btstack_linked_list_t hci_connection_list;
+
+hci_connection_t * hci_connection_for_handle(hci_con_handle_t con_handle){
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_connection_list);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        hci_connection_t * connection = (hci_connection_t *) btstack_linked_list_iterator_next(&it);
+        if (connection->con_handle == con_handle) return connection;
+    }
+    return NULL;
+}
+hci_connection_t * hci_connection_for_bd_addr_and_type(const bd_addr_t addr, bd_addr_type_t addr_type){
+    (void) addr;
+    UNUSED(addr_type);
+    return NULL;
+}
+void hci_connections_get_iterator(btstack_linked_list_iterator_t * it){
+    btstack_linked_list_iterator_init(it, &hci_connection_list);
+}
+
+// simulated Controller: single HCI command credit, events are delivered after a delay
+typedef struct {
+    btstack_timer_source_t timer;
+    uint8_t  packet[40];
+    uint16_t size;
+    bool     returns_credit;
+} sim_event_t;
+
+static sim_event_t                              sim_events[NUM_CONNECTIONS * 4];
+static btstack_linked_list_t                    hci_event_handlers;
+static btstack_packet_handler_t                 sm_pdu_handler;
+static bool                                     hci_command_pending;
+
+static uint32_t ltk_request_ms[NUM_CONNECTIONS];
+static uint32_t encrypted_ms[NUM_CONNECTIONS];
+static uint16_t num_encrypted;
+static uint16_t num_hci_commands;
+
+static void sim_dispatch_event(uint8_t * packet, uint16_t size){
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_event_handlers);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        btstack_packet_callback_registration_t * callback = (btstack_packet_callback_registration_t *) btstack_linked_list_iterator_next(&it);
+        (*callback->callback)(HCI_EVENT_PACKET, 0, packet, size);
+    }
+}
+
+static void sim_event_handler(btstack_timer_source_t * ts){
+    sim_event_t * event = (sim_event_t *) ts;
+    if (event->returns_credit){
+        hci_command_pending = false;
+    }
+    if (event->packet[0] == HCI_EVENT_ENCRYPTION_CHANGE){
+        uint16_t index = little_endian_read_16(event->packet, 3) - CON_HANDLE_BASE;
+        encrypted_ms[index] = sim_time_ms;
+        num_encrypted++;
+    }
+    event->size = 0;
+    sim_dispatch_event(event->packet, sizeof(event->packet));
+}
+
+static void sim_schedule_event(const uint8_t * packet, uint16_t size, uint32_t delay_ms, bool returns_credit){
+    uint16_t i;
+    for (i = 0; i < (sizeof(sim_events) / sizeof(sim_event_t)); i++){
+        sim_event_t * event = &sim_events[i];
+        if (event->size != 0) continue;
+        memset(event->packet, 0, sizeof(event->packet));
+        memcpy(event->packet, packet, size);
+        event->size = size;
+        event->returns_credit = returns_credit;
+        btstack_run_loop_set_timer_handler(&event->timer, &sim_event_handler);
+        btstack_run_loop_set_timer(&event->timer, delay_ms);
+        btstack_run_loop_add_timer(&event->timer);
+        return;
+    }
+    FAIL("sim event pool exhausted");
+}
+
+static void sim_command_complete(uint16_t opcode, const uint8_t * return_params, uint8_t return_params_len){
+    uint8_t packet[20];
+    packet[0] = HCI_EVENT_COMMAND_COMPLETE;
+    packet[1] = 3 + return_params_len;
+    packet[2] = 1;
+    little_endian_store_16(packet, 3, opcode);
+    memcpy(&packet[5], return_params, return_params_len);
+    sim_schedule_event(packet, 5 + return_params_len, HCI_COMMAND_LATENCY_MS, true);
+}
+
+static void sim_command_status(uint16_t opcode){
+    uint8_t packet[] = { HCI_EVENT_COMMAND_STATUS, 4, ERROR_CODE_SUCCESS, 1, 0, 0 };
+    little_endian_store_16(packet, 4, opcode);
+    sim_schedule_event(packet, sizeof(packet), HCI_COMMAND_LATENCY_MS, true);
+}
+
+static void sim_encryption_change(hci_con_handle_t con_handle){
+    uint8_t packet[] = { HCI_EVENT_ENCRYPTION_CHANGE, 4, ERROR_CODE_SUCCESS, 0, 0, 1 };
+    little_endian_store_16(packet, 3, con_handle);
+    sim_schedule_event(packet, sizeof(packet), HCI_COMMAND_LATENCY_MS + ENCRYPTION_SETUP_MS, false);
+}
+
+bool hci_can_send_command_packet_now(void){
+    return hci_command_pending == false;
+}
+
+uint8_t hci_send_cmd(const hci_cmd_t * cmd, ...){
+    CHECK_FALSE(hci_command_pending);
+    hci_command_pending = true;
+    num_hci_commands++;
+
+    uint8_t packet[80];
+    va_list argptr;
+    va_start(argptr, cmd);
+    uint16_t len = hci_cmd_create_from_template(packet, cmd, argptr);
+    va_end(argptr);
+    UNUSED(len);
+
+    uint8_t return_params[9];
+    memset(return_params, 0, sizeof(return_params));
+    hci_con_handle_t con_handle = little_endian_read_16(packet, 3);
+    if (cmd->opcode == hci_le_rand.opcode){
+        uint8_t i;
+        for (i = 1; i < 9; i++){
+            return_params[i] = (uint8_t) rand();
+        }
+        sim_command_complete(cmd->opcode, return_params, 9);
+    } else if (cmd->opcode == hci_le_long_term_key_request_reply.opcode){
+        little_endian_store_16(return_params, 1, con_handle);
+        sim_command_complete(cmd->opcode, return_params, 3);
+        sim_encryption_change(con_handle);
+    } else if (cmd->opcode == hci_le_start_encryption.opcode){
+        sim_command_status(cmd->opcode);
+        sim_encryption_change(con_handle);
+    } else {
+        sim_command_complete(cmd->opcode, return_params, 1);
+    }
+    return ERROR_CODE_SUCCESS;
+}
+
+void hci_add_event_handler(btstack_packet_callback_registration_t * callback_handler){
+    btstack_linked_list_add_tail(&hci_event_handlers, (btstack_linked_item_t *) callback_handler);
+}
+HCI_STATE hci_get_state(void){
+    return HCI_STATE_WORKING;
+}
+void hci_halting_defer(void){
+}
+uint16_t hci_get_manufacturer(void){
+    return 0xffff;
+}
+bool hci_non_flushable_packet_boundary_flag_supported(void){
+    return true;
+}
+void hci_disconnect_security_block(hci_con_handle_t con_handle){
+    UNUSED(con_handle);
+}
+void hci_le_set_own_address_type(uint8_t own_address_type){
+    UNUSED(own_address_type);
+}
+void hci_le_random_address_set(const bd_addr_t random_address){
+    (void) random_address;
+}
+void hci_le_advertisements_set_params(uint16_t adv_int_min, uint16_t adv_int_max, uint8_t adv_type,
+    uint8_t direct_address_typ, bd_addr_t direct_address, uint8_t channel_map, uint8_t filter_policy){
+    UNUSED(adv_int_min);
+    UNUSED(adv_int_max);
+    UNUSED(adv_type);
+    UNUSED(direct_address_typ);
+    (void) direct_address;
+    UNUSED(channel_map);
+    UNUSED(filter_policy);
+}
+void gap_local_bd_addr(bd_addr_t address_buffer){
+    memset(address_buffer, 0x11, 6);
+}
+void gap_le_get_own_address(uint8_t * addr_type, bd_addr_t addr){
+    *addr_type = BD_ADDR_TYPE_LE_PUBLIC;
+    gap_local_bd_addr(addr);
+}
+void gap_le_get_own_advertisements_address(uint8_t * addr_type, bd_addr_t addr){
+    gap_le_get_own_address(addr_type, addr);
+}
+void gap_le_get_own_connection_address(uint8_t * addr_type, bd_addr_t addr){
+    gap_le_get_own_address(addr_type, addr);
+}
+
+// L2CAP
+void l2cap_register_fixed_channel(btstack_packet_handler_t packet_handler, uint16_t channel_id){
+    UNUSED(channel_id);
+    sm_pdu_handler = packet_handler;
+}
+bool l2cap_can_send_fixed_channel_packet_now(uint16_t con_handle, uint16_t channel_id){
+    UNUSED(con_handle);
+    UNUSED(channel_id);
+    return true;
+}
+void l2cap_request_can_send_fix_channel_now_event(hci_con_handle_t con_handle, uint16_t channel_id){
+    UNUSED(con_handle);
+    UNUSED(channel_id);
+}
+uint8_t l2cap_send_connectionless(hci_con_handle_t con_handle, uint16_t cid, uint8_t * data, uint16_t len){
+    UNUSED(con_handle);
+    UNUSED(cid);
+    UNUSED(data);
+    UNUSED(len);
+    return ERROR_CODE_SUCCESS;
+}
+
+// scenario
+static btstack_packet_callback_registration_t sm_event_callback_registration;
+static uint16_t num_reencryptions_complete;
+
+static void sm_event_handler(uint8_t packet_type, uint16_t channel, uint8_t * packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    if (hci_event_packet_get_type(packet) != SM_EVENT_REENCRYPTION_COMPLETE) return;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, sm_event_reencryption_complete_get_status(packet));
+    num_reencryptions_complete++;
+}
+
+static void connect(uint16_t index, uint8_t role){
+    hci_connection_t * connection = &hci_connections[index];
+    memset(connection, 0, sizeof(hci_connection_t));
+    connection->con_handle = CON_HANDLE_BASE + index;
+    connection->address_type = BD_ADDR_TYPE_LE_PUBLIC;
+    connection->address[0] = 0xC0;
+    connection->address[5] = (uint8_t) index;
+    btstack_linked_list_add_tail(&hci_connection_list, (btstack_linked_item_t *) connection);
+
+    uint8_t event[36];
+    memset(event, 0, sizeof(event));
+    event[0] = HCI_EVENT_META_GAP;
+    event[1] = sizeof(event) - 2;
+    event[2] = GAP_SUBEVENT_LE_CONNECTION_COMPLETE;
+    event[3] = ERROR_CODE_SUCCESS;
+    little_endian_store_16(event, 4, connection->con_handle);
+    event[6] = role;
+    event[7] = connection->address_type;
+    reverse_bd_addr(connection->address, &event[8]);
+    little_endian_store_16(event, 26, 24);
+    little_endian_store_16(event, 30, 72);
+    sim_dispatch_event(event, sizeof(event));
+}
+
+static void ltk_request(uint16_t index, uint16_t ediv, const uint8_t * rand_value){
+    uint8_t event[15];
+    event[0] = HCI_EVENT_LE_META;
+    event[1] = sizeof(event) - 2;
+    event[2] = HCI_SUBEVENT_LE_LONG_TERM_KEY_REQUEST;
+    little_endian_store_16(event, 3, CON_HANDLE_BASE + index);
+    reverse_64(rand_value, &event[5]);
+    little_endian_store_16(event, 13, ediv);
+    ltk_request_ms[index] = sim_time_ms;
+    sim_dispatch_event(event, sizeof(event));
+}
+
+static void run_until_encrypted(uint16_t num_connections){
+    while (num_encrypted < num_connections){
+        CHECK_TRUE(sim_step());
+    }
+    // let SM process pending work
+    while (btstack_crypto_idle() == 0){
+        CHECK_TRUE(sim_step());
+    }
+}
+
+static void report(const char * name, uint16_t num_connections){
+    uint32_t sum_ms = 0;
+    uint32_t max_ms = 0;
+    uint16_t i;
+    for (i = 0; i < num_connections; i++){
+        uint32_t duration_ms = encrypted_ms[i] - ltk_request_ms[i];
+        sum_ms += duration_ms;
+        max_ms = btstack_max(max_ms, duration_ms);
+    }
+    printf("%s, %u connections: time-to-encrypted avg %4u ms, max %4u ms, %u HCI commands\n", name, num_connections,
+           (unsigned int) (sum_ms / num_connections), (unsigned int) max_ms, num_hci_commands);
+}
+
+TEST_GROUP(ReencryptionStorm){
+    void setup(void){
+        sim_time_ms = 1000;
+        hci_connection_list = NULL;
+        hci_event_handlers = NULL;
+        hci_command_pending = false;
+        num_encrypted = 0;
+        num_reencryptions_complete = 0;
+        memset(sim_events, 0, sizeof(sim_events));
+
+        btstack_run_loop_init(&sim_run_loop);
+        btstack_crypto_init();
+        le_device_db_init();
+        sm_init();
+        sm_event_callback_registration.callback = &sm_event_handler;
+        sm_add_event_handler(&sm_event_callback_registration);
+
+        uint8_t event[] = { BTSTACK_EVENT_STATE, 1, HCI_STATE_WORKING };
+        sim_dispatch_event(event, sizeof(event));
+        // wait for derived keys and EC key
+        while (btstack_crypto_idle() == 0){
+            CHECK_TRUE(sim_step());
+        }
+        while (sim_step()){
+        }
+        num_hci_commands = 0;
+    }
+    void teardown(void){
+        sm_remove_event_handler(&sm_event_callback_registration);
+        sm_deinit();
+        btstack_crypto_deinit();
+        btstack_run_loop_deinit();
+    }
+};
+
+// Peripheral: LTK is reconstructed from EDIV and Rand for legacy bonds
+TEST(ReencryptionStorm, PeripheralLegacyReconstruction){
+    sm_allow_ltk_reconstruction_without_le_device_db_entry(1);
+    uint16_t i;
+    for (i = 0; i < NUM_CONNECTIONS; i++){
+        connect(i, HCI_ROLE_SLAVE);
+    }
+    while (sim_step()){
+    }
+    num_hci_commands = 0;
+
+    // all centrals start encryption at the same time
+    for (i = 0; i < NUM_CONNECTIONS; i++){
+        uint8_t rand_value[8] = { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0x0f };
+        rand_value[0] = (uint8_t) i;
+        ltk_request(i, 0x1000 + i, rand_value);
+    }
+    run_until_encrypted(NUM_CONNECTIONS);
+    CHECK_EQUAL(NUM_CONNECTIONS, num_reencryptions_complete);
+    report("Peripheral, legacy LTK reconstruction", NUM_CONNECTIONS);
+}
+
+// Central: LTK, EDIV and Rand from LE Device DB
+TEST(ReencryptionStorm, CentralStoredLtk){
+    uint16_t num_connections = le_device_db_max_count();
+    uint16_t i;
+    for (i = 0; i < num_connections; i++){
+        bd_addr_t address = { 0xC0, 0, 0, 0, 0, 0 };
+        address[5] = (uint8_t) i;
+        sm_key_t irk;
+        memset(irk, 0, sizeof(irk));
+        int index = le_device_db_add(BD_ADDR_TYPE_LE_PUBLIC, address, irk);
+        CHECK_TRUE(index >= 0);
+        sm_key_t ltk;
+        memset(ltk, (uint8_t) (0x10 + i), sizeof(ltk));
+        uint8_t rand_value[8] = { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0x0f };
+        le_device_db_encryption_set(index, 0x1000 + i, rand_value, ltk, 16, 0, 0, 0);
+    }
+    for (i = 0; i < num_connections; i++){
+        connect(i, HCI_ROLE_MASTER);
+    }
+    while (sim_step()){
+    }
+    num_hci_commands = 0;
+
+    // application requests security on all connections
+    for (i = 0; i < num_connections; i++){
+        ltk_request_ms[i] = sim_time_ms;
+        sm_request_pairing(CON_HANDLE_BASE + i);
+    }
+    run_until_encrypted(num_connections);
+    CHECK_EQUAL(num_connections, num_reencryptions_complete);
+    report("Central, stored LTK", num_connections);
+
+    for (i = 0; i < num_connections; i++){
+        le_device_db_remove(i);
+    }
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
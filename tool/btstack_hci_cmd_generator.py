@@ -0,0 +1,329 @@
+#!/usr/bin/env python3
+
+import re
+import os
+import sys
+
+program_info = '''
+BTstack HCI Command Serializer Generator for BTstack
+Copyright 2024, BlueKitchen GmbH
+'''
+
+copyright = """/*
+ * Copyright (C) 2024 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at 
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+"""
+
+hfile_header_begin = """
+
+/**
+ * HCI Command Serializer
+ *
+ * Fixed-layout serializers for all HCI Commands in hci_cmd.c. In contrast to hci_cmd_create_from_template,
+ * the parameters are type-checked by the compiler and no format string is interpreted at runtime.
+ *
+ * Note: Don't edit this file. It is generated by tool/btstack_hci_cmd_generator.py
+ *
+ */
+
+#ifndef HCI_CMD_SERIALIZER_H
+#define HCI_CMD_SERIALIZER_H
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+#include "bluetooth.h"
+#include "btstack_util.h"
+#include "hci_cmd.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/* API_START */
+
+"""
+
+hfile_header_end = """
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+
+#endif // HCI_CMD_SERIALIZER_H
+"""
+
+function_template = '''/**
+ * @brief Create {command_name} command
+ * @param hci_cmd_buffer
+{param_docs} * @return size of command
+ * @note: format {format}
+ */
+static inline uint16_t {fn_name}(uint8_t * hci_cmd_buffer{params}){{
+    little_endian_store_16(hci_cmd_buffer, 0, {opcode});
+{code}}}
+
+'''
+
+param_types = {
+    '1' : 'uint8_t',
+    '2' : 'uint16_t',
+    '3' : 'uint32_t',
+    '4' : 'uint32_t',
+    'H' : 'hci_con_handle_t',
+    'B' : 'const bd_addr_t',
+    'D' : 'const uint8_t *',
+    'E' : 'const uint8_t *',
+    'N' : 'const char *',
+    'P' : 'const uint8_t *',
+    'K' : 'const uint8_t *',
+    'A' : 'const uint8_t *',
+    'Q' : 'const uint8_t *',
+    'J' : 'uint8_t',
+    'V' : 'const uint8_t *',
+    'a' : 'uint8_t',
+    'b' : 'uint8_t',
+}
+
+array_param_types = {
+    '1' : 'const uint8_t *',
+    '2' : 'const uint16_t *',
+}
+
+# fixed size fields: size, code with {pos} and {name}
+param_writes = {
+    '1' : (1,  'hci_cmd_buffer[{pos}] = {name};'),
+    '2' : (2,  'little_endian_store_16(hci_cmd_buffer, {pos}, {name});'),
+    'H' : (2,  'little_endian_store_16(hci_cmd_buffer, {pos}, {name});'),
+    '3' : (3,  'little_endian_store_24(hci_cmd_buffer, {pos}, {name});'),
+    '4' : (4,  'little_endian_store_32(hci_cmd_buffer, {pos}, {name});'),
+    'B' : (6,  'reverse_bd_addr({name}, &hci_cmd_buffer[{pos}]);'),
+    'D' : (8,  '(void)memcpy(&hci_cmd_buffer[{pos}], {name}, 8);'),
+    'E' : (240,'(void)memcpy(&hci_cmd_buffer[{pos}], {name}, 240);'),
+    'P' : (16, '(void)memcpy(&hci_cmd_buffer[{pos}], {name}, 16);'),
+    'K' : (16, 'reverse_128({name}, &hci_cmd_buffer[{pos}]);'),
+    'A' : (31, '(void)memcpy(&hci_cmd_buffer[{pos}], {name}, 31);'),
+    'Q' : (32, 'reverse_256({name}, &hci_cmd_buffer[{pos}]);'),
+    'J' : (1,  'hci_cmd_buffer[{pos}] = {name};'),
+    'a' : (1,  'hci_cmd_buffer[{pos}] = {name};'),
+    'b' : (1,  'hci_cmd_buffer[{pos}] = {name};'),
+}
+
+def parse_commands(path):
+    commands = []
+    params = []
+    command_name = None
+    if_zero_level = 0
+    if_level = 0
+    with open (path, 'rt') as fin:
+        for line in fin:
+            # skip commands in '#if 0' blocks
+            if re.match(r'\s*#if', line):
+                if_level += 1
+                if if_zero_level == 0 and re.match(r'\s*#if\s+0', line):
+                    if_zero_level = if_level
+                continue
+            if re.match(r'\s*#endif', line):
+                if if_zero_level == if_level:
+                    if_zero_level = 0
+                if_level -= 1
+                continue
+            if if_zero_level > 0:
+                continue
+
+            parts = re.match(r'.*@param\s*(\w*)', line)
+            if parts:
+                params.append(parts.groups()[0].lower())
+                continue
+
+            declaration = re.match(r'const\s+hci_cmd_t\s+(\w+)[\s=]+', line)
+            if declaration:
+                command_name = declaration.groups()[0]
+                continue
+
+            definition = re.match(r'\s*(HCI_OPCODE_\w+|0x[0-9A-Fa-f]+)\s*,\s*"([\w\[\]]*)"', line)
+            if definition and command_name is not None:
+                (opcode, format) = definition.groups()
+                commands.append((command_name, opcode, format, params))
+                command_name = None
+                params = []
+    return commands
+
+# names that cannot be used as C/C++ parameter names
+reserved_names = ['auto', 'class', 'default', 'delete', 'new', 'private', 'public', 'register', 'this']
+
+def is_valid_name(name):
+    return re.match(r'^[a-z_]\w*$', name) is not None and name not in reserved_names
+
+def param_names_for_command(format, params):
+    num_fields = len(format.replace('[', '').replace(']', ''))
+    if len(params) != num_fields or not all(map(is_valid_name, params)):
+        params = ['arg%u' % (i + 1) for i in range(num_fields)]
+    # avoid duplicate names
+    names = []
+    for param in params:
+        name = param
+        counter = 2
+        while name in names:
+            name = '%s_%u' % (param, counter)
+            counter += 1
+        names.append(name)
+    return names
+
+def create_function(command_name, opcode, format, params):
+    names = param_names_for_command(format, params)
+    fn_name = 'hci_cmd_create_' + command_name[len('hci_'):]
+    param_list = ''
+    param_docs = ''
+    lines = []
+    # position is either a number or 'pos' after the first variable size field
+    pos = 3
+    pos_is_number = True
+    in_array = False
+    array_count_name = None
+    array_count_is_bitfield = False
+    array_fields = []
+    name_index = 0
+
+    def pos_expr(offset):
+        if pos_is_number:
+            return '%u' % (pos + offset)
+        if offset == 0:
+            return 'pos'
+        return 'pos + %u' % offset
+
+    for f in format:
+        if f == '[':
+            in_array = True
+            array_fields = []
+            continue
+        if f == ']':
+            in_array = False
+            # emit array loop
+            if pos_is_number:
+                lines.append('uint16_t pos = %u;' % pos)
+                pos_is_number = False
+            if array_count_is_bitfield:
+                lines.append('uint8_t num_elements = (uint8_t) count_set_bits_uint32(%s);' % array_count_name)
+            else:
+                lines.append('uint8_t num_elements = %s;' % array_count_name)
+            lines.append('uint8_t i;')
+            lines.append('for (i = 0; i < num_elements; i++){')
+            for (field_type, name) in array_fields:
+                if field_type == '1':
+                    lines.append('    hci_cmd_buffer[pos++] = %s[i];' % name)
+                else:
+                    lines.append('    little_endian_store_16(hci_cmd_buffer, pos, %s[i]);' % name)
+                    lines.append('    pos += 2;')
+            lines.append('}')
+            continue
+
+        name = names[name_index]
+        name_index += 1
+
+        if in_array:
+            param_list += ', %s %s' % (array_param_types[f], name)
+            param_docs += ' * @param %s array\n' % name
+            array_fields.append((f, name))
+            continue
+
+        param_list += ', %s %s' % (param_types[f], name)
+        param_docs += ' * @param %s\n' % name
+
+        if f in param_writes:
+            (size, code) = param_writes[f]
+            lines.append(code.format(pos=pos_expr(0), name=name))
+            if f == 'J':
+                length_name = name
+            if f in 'ab':
+                array_count_name = name
+                array_count_is_bitfield = f == 'b'
+            if pos_is_number:
+                pos += size
+            else:
+                lines.append('pos += %u;' % size)
+        elif f == 'N':
+            lines.append('uint16_t %s_len = (uint16_t) strlen(%s);' % (name, name))
+            lines.append('if (%s_len > 248u) {' % name)
+            lines.append('    %s_len = 248u;' % name)
+            lines.append('}')
+            lines.append('(void)memcpy(&hci_cmd_buffer[%s], %s, %s_len);' % (pos_expr(0), name, name))
+            lines.append('memset(&hci_cmd_buffer[%s + %s_len], 0, 248u - %s_len);' % (pos_expr(0), name, name))
+            if pos_is_number:
+                pos += 248
+            else:
+                lines.append('pos += 248;')
+        elif f == 'V':
+            if pos_is_number:
+                lines.append('uint16_t pos = %u;' % pos)
+                pos_is_number = False
+            lines.append('(void)memcpy(&hci_cmd_buffer[pos], %s, %s);' % (name, length_name))
+            lines.append('pos += %s;' % length_name)
+        else:
+            raise Exception('unsupported format %s in %s' % (f, command_name))
+
+    if pos_is_number:
+        lines.append('hci_cmd_buffer[2] = %u;' % (pos - 3))
+        lines.append('return %u;' % pos)
+    else:
+        lines.append('hci_cmd_buffer[2] = (uint8_t) (pos - 3u);')
+        lines.append('return pos;')
+
+    code = ''.join('    %s\n' % line for line in lines)
+    return function_template.format(command_name=command_name.upper(), param_docs=param_docs, format=format,
+                                    fn_name=fn_name, params=param_list, opcode=opcode, code=code)
+
+def create_serializers(commands, gen_path):
+    with open(gen_path, 'wt') as fout:
+        fout.write(copyright)
+        fout.write(hfile_header_begin)
+        for (command_name, opcode, format, params) in commands:
+            fout.write(create_function(command_name, opcode, format, params))
+        fout.write(hfile_header_end)
+
+btstack_root = os.path.abspath(os.path.dirname(sys.argv[0]) + '/..')
+hci_cmd_path = btstack_root + '/src/hci_cmd.c'
+gen_path = btstack_root + '/src/hci_cmd_serializer.h'
+
+print(program_info)
+
+commands = parse_commands(hci_cmd_path)
+create_serializers(commands, gen_path)
+print('%u commands' % len(commands))
+
+# done
+print('Done!')
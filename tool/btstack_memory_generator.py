@@ -108,6 +108,12 @@ void btstack_memory_init(void);
  */
 void btstack_memory_deinit(void);
 
+/**
+ * @brief Log usage statistics of BTstack memory arenas
+ * @note only available with HAVE_MALLOC and ENABLE_BTSTACK_MEMORY_ARENA
+ */
+void btstack_memory_log_usage(void);
+
 /* API_END */
 """
 
@@ -130,6 +136,7 @@ cfile_header_begin = """
  *
  *  @note code generated by tool/btstack_memory_generator.py
  *  @note returnes buffers are initialized with 0
+ *  @note with HAVE_MALLOC and ENABLE_BTSTACK_MEMORY_ARENA, buffers are allocated from one memory arena per type
  *
  */
 
@@ -144,7 +151,7 @@ void * test_malloc(size_t size);
 #define malloc test_malloc
 #endif
 
-#ifdef HAVE_MALLOC
+#if defined(HAVE_MALLOC) && !defined(ENABLE_BTSTACK_MEMORY_ARENA)
 typedef struct btstack_memory_buffer {
     struct btstack_memory_buffer * next;
     struct btstack_memory_buffer * prev;
@@ -186,18 +193,6 @@ static void btstack_memory_tracking_remove(btstack_memory_buffer_t * buffer){
     btstack_memory_malloc_counter--;
 }
 #endif
-
-void btstack_memory_deinit(void){
-#ifdef HAVE_MALLOC
-    while (btstack_memory_malloc_buffers != NULL){
-        btstack_memory_buffer_t * buffer = btstack_memory_malloc_buffers;
-        btstack_memory_malloc_buffers = buffer->next;
-        free(buffer);
-        btstack_memory_malloc_counter--;
-    }
-    btstack_assert(btstack_memory_malloc_counter == 0);
-#endif
-}
 """
 
 header_template = """STRUCT_NAME_t * btstack_memory_STRUCT_NAME_get(void);
@@ -235,6 +230,18 @@ void btstack_memory_STRUCT_NAME_free(STRUCT_NAME_t *STRUCT_NAME){
     UNUSED(STRUCT_NAME);
 };
 #endif
+#elif defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+static btstack_memory_arena_t STRUCT_NAME_arena;
+STRUCT_NAME_t * btstack_memory_STRUCT_NAME_get(void){
+    void * buffer = btstack_memory_arena_get(&STRUCT_NAME_arena);
+    if (buffer){
+        memset(buffer, 0, sizeof(STRUCT_TYPE));
+    }
+    return (STRUCT_NAME_t *) buffer;
+}
+void btstack_memory_STRUCT_NAME_free(STRUCT_NAME_t *STRUCT_NAME){
+    btstack_memory_arena_free(&STRUCT_NAME_arena, STRUCT_NAME);
+}
 #elif defined(HAVE_MALLOC)
 
 typedef struct {
@@ -263,7 +270,7 @@ void btstack_memory_STRUCT_NAME_free(STRUCT_NAME_t *STRUCT_NAME){
 init_header = '''
 // init
 void btstack_memory_init(void){
-#ifdef HAVE_MALLOC
+#if defined(HAVE_MALLOC) && !defined(ENABLE_BTSTACK_MEMORY_ARENA)
     // assert that there is no unexpected padding for combined buffer
     btstack_assert(sizeof(test_buffer_t) == sizeof(btstack_memory_buffer_t) + sizeof(void *));
 #endif
@@ -272,8 +279,37 @@ void btstack_memory_init(void){
 
 init_template = """#if POOL_COUNT > 0
     btstack_memory_pool_create(&STRUCT_NAME_pool, STRUCT_NAME_storage, POOL_COUNT, sizeof(STRUCT_TYPE));
+#endif
+#if !defined(POOL_COUNT) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_init(&STRUCT_NAME_arena, "STRUCT_NAME", sizeof(STRUCT_TYPE));
 #endif"""
 
+deinit_header = '''
+// deinit
+void btstack_memory_deinit(void){
+#if defined(HAVE_MALLOC) && !defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    while (btstack_memory_malloc_buffers != NULL){
+        btstack_memory_buffer_t * buffer = btstack_memory_malloc_buffers;
+        btstack_memory_malloc_buffers = buffer->next;
+        free(buffer);
+        btstack_memory_malloc_counter--;
+    }
+    btstack_assert(btstack_memory_malloc_counter == 0);
+#endif
+'''
+
+deinit_template = """#if !defined(POOL_COUNT) && defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arena_deinit(&STRUCT_NAME_arena);
+#endif"""
+
+log_usage = '''
+void btstack_memory_log_usage(void){
+#if defined(HAVE_MALLOC) && defined(ENABLE_BTSTACK_MEMORY_ARENA)
+    btstack_memory_arenas_log_usage();
+#endif
+}
+'''
+
 list_of_structs = [
     ["hci_connection"],
     ["l2cap_service", "l2cap_channel"],
@@ -352,6 +388,12 @@ add_structs(f, code_template)
 f.write(init_header)
 add_structs(f, init_template)
 writeln(f, "}")
+
+f.write(deinit_header)
+add_structs(f, deinit_template)
+writeln(f, "}")
+
+f.write(log_usage)
 f.close();
     
 # also generate test code
@@ -384,6 +426,9 @@ TEST_GROUP(btstack_memory){
         btstack_memory_init();
         simulate_no_memory = 0;
     }
+    void teardown(void){
+        btstack_memory_deinit();
+    }
 };
 
 #ifdef HAVE_MALLOC
@@ -1040,6 +1040,47 @@ def listHandles(fout):
         fout.write(define)
         fout.write('\n')
 
+def parseByteSequence(line):
+    # bytes of a profile_data line, ignoring braces and comments
+    line = line.split('//')[0].replace('{', '').replace('}', '')
+    return [int(token, 0) for token in line.split(',') if token.strip() != '']
+
+def writeIndex(fout, profile_data):
+    # offsets of all attributes relative to first attribute, i.e. after ATT DB version
+    offsets = []
+    handles = []
+    pos = 1
+    while pos + 1 < len(profile_data):
+        size = profile_data[pos] | (profile_data[pos+1] << 8)
+        if size == 0:
+            break
+        offsets.append(pos - 1)
+        handles.append(profile_data[pos+4] | (profile_data[pos+5] << 8))
+        pos += size
+    # binary search on handle requires attributes sorted by handle
+    if handles != sorted(handles):
+        print("WARNING: attribute handles not in ascending order, skipping ATT DB index")
+        return
+    # end marker
+    offsets.append(pos - 1)
+    if offsets[-1] > 0xffff:
+        print("WARNING: ATT DB larger than 64 kB, skipping ATT DB index")
+        return
+    fout.write('\n')
+    fout.write('#ifdef ENABLE_ATT_DB_INDEX\n')
+    fout.write('// ATT DB index: number of attributes, followed by offset of each attribute and of END marker\n')
+    fout.write('// offsets are relative to the first attribute and sorted by handle, see att_set_db_index\n')
+    fout.write('const uint16_t profile_data_index[] =\n')
+    fout.write('{\n')
+    write_indent(fout)
+    fout.write('%u,\n' % len(handles))
+    for i in range(0, len(offsets), 8):
+        write_indent(fout)
+        fout.write(' '.join(['0x%04x,' % offset for offset in offsets[i:i+8]]))
+        fout.write('\n')
+    fout.write('};\n')
+    fout.write('#endif\n')
+
 def getFile( fileName ):
     for d in include_paths:
         fullFile = os.path.normpath(d + os.sep + fileName) # because Windows exists
@@ -1106,11 +1147,20 @@ try:
     db_hash_sequence.reverse()
     db_hash_string = ', '.join(db_hash_sequence) + ', '
 
-    # pass 2: insert GATT Database Hash
+    # pass 2: insert GATT Database Hash and collect final profile data for index
     fout = open (filename, 'w')
     ftemp.seek(0)
+    profile_data = None
     for line in ftemp:
-        fout.write(line.replace('THE-DATABASE-HASH', db_hash_string))
+        line = line.replace('THE-DATABASE-HASH', db_hash_string)
+        fout.write(line)
+        if line.startswith('const uint8_t profile_data[]'):
+            profile_data = []
+        elif line.startswith('};') and profile_data is not None:
+            writeIndex(fout, profile_data)
+            profile_data = None
+        elif profile_data is not None:
+            profile_data.extend(parseByteSequence(line))
     fout.close()
     ftemp.close()
 